@@ -153,6 +153,85 @@ int32_t MX25LM51245G_AutoPollingMemReady(OSPI_HandleTypeDef *Ctx, MX25LM51245G_I
   return MX25LM51245G_OK;
 }
 
+/**
+  * @brief  Start polling WIP(Write In Progress) bit become to 0, the status
+  *         match interrupt signals the memory is ready
+  *         SPI/OPI;
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate
+  * @retval error status
+  */
+int32_t MX25LM51245G_AutoPollingMemReady_IT(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                            MX25LM51245G_Transfer_t Rate)
+{
+  OSPI_RegularCmdTypeDef  s_command = {0};
+  OSPI_AutoPollingTypeDef s_config = {0};
+
+  /* SPI mode and DTR transfer not supported by memory */
+  if ((Mode == MX25LM51245G_SPI_MODE) && (Rate == MX25LM51245G_DTR_TRANSFER))
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  /* Configure automatic polling mode to wait for memory ready */
+  s_command.OperationType      = HAL_OSPI_OPTYPE_COMMON_CFG;
+#if defined (OCTOSPI_CR_MSEL)
+  s_command.FlashSelect        = HAL_OSPI_FLASH_SELECT_IO_7_0;
+#else
+  s_command.FlashId            = HAL_OSPI_FLASH_ID_1;
+#endif /* defined (OCTOSPI_CR_MSEL) */
+  s_command.InstructionMode    = (Mode == MX25LM51245G_SPI_MODE)
+                                 ? HAL_OSPI_INSTRUCTION_1_LINE
+                                 : HAL_OSPI_INSTRUCTION_8_LINES;
+  s_command.InstructionDtrMode = (Rate == MX25LM51245G_DTR_TRANSFER)
+                                 ? HAL_OSPI_INSTRUCTION_DTR_ENABLE
+                                 : HAL_OSPI_INSTRUCTION_DTR_DISABLE;
+  s_command.InstructionSize    = (Mode == MX25LM51245G_SPI_MODE)
+                                 ? HAL_OSPI_INSTRUCTION_8_BITS
+                                 : HAL_OSPI_INSTRUCTION_16_BITS;
+  s_command.Instruction        = (Mode == MX25LM51245G_SPI_MODE)
+                                 ? MX25LM51245G_READ_STATUS_REG_CMD
+                                 : MX25LM51245G_OCTA_READ_STATUS_REG_CMD;
+  s_command.AddressMode        = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_ADDRESS_NONE : HAL_OSPI_ADDRESS_8_LINES;
+  s_command.AddressDtrMode     = (Rate == MX25LM51245G_DTR_TRANSFER)
+                                 ? HAL_OSPI_ADDRESS_DTR_ENABLE
+                                 : HAL_OSPI_ADDRESS_DTR_DISABLE;
+  s_command.AddressSize        = HAL_OSPI_ADDRESS_32_BITS;
+  s_command.Address            = 0U;
+  s_command.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
+  s_command.DataMode           = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_DATA_1_LINE : HAL_OSPI_DATA_8_LINES;
+  s_command.DataDtrMode        = (Rate == MX25LM51245G_DTR_TRANSFER)
+                                 ? HAL_OSPI_DATA_DTR_ENABLE
+                                 : HAL_OSPI_DATA_DTR_DISABLE;
+  s_command.DummyCycles        = (Mode == MX25LM51245G_SPI_MODE)
+                                 ? 0U
+                                 : ((Rate == MX25LM51245G_DTR_TRANSFER)
+                                    ? DUMMY_CYCLES_REG_OCTAL_DTR
+                                    : DUMMY_CYCLES_REG_OCTAL);
+  s_command.NbData             = (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U;
+  s_command.DQSMode            = (Rate == MX25LM51245G_DTR_TRANSFER) ? HAL_OSPI_DQS_ENABLE : HAL_OSPI_DQS_DISABLE;
+  s_command.SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
+
+  s_config.Match         = 0U;
+  s_config.Mask          = MX25LM51245G_SR_WIP;
+  s_config.MatchMode     = HAL_OSPI_MATCH_MODE_AND;
+  s_config.Interval      = MX25LM51245G_AUTOPOLLING_INTERVAL_TIME;
+  s_config.AutomaticStop = HAL_OSPI_AUTOMATIC_STOP_ENABLE;
+
+  if (HAL_OSPI_Command(Ctx, &s_command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  if (HAL_OSPI_AutoPolling_IT(Ctx, &s_config) != HAL_OK)
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  return MX25LM51245G_OK;
+}
+
 /* Read/Write Array Commands (3/4 Byte Address Command Set) *********************/
 /**
   * @brief  Reads an amount of data from the OSPI memory on STR mode.
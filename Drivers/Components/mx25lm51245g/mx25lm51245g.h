@@ -306,6 +306,8 @@ typedef enum
 int32_t MX25LM51245G_GetFlashInfo(MX25LM51245G_Info_t *pInfo);
 int32_t MX25LM51245G_AutoPollingMemReady(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
                                          MX25LM51245G_Transfer_t Rate);
+int32_t MX25LM51245G_AutoPollingMemReady_IT(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                            MX25LM51245G_Transfer_t Rate);
 
 /* Read/Write Array Commands **************************************************/
 int32_t MX25LM51245G_ReadSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file    mx25lm51245g_conf.h
+  * @author  MCD Application Team
+  * @brief   MX25LM51245G OctoSPI memory configuration file for host builds
+  *          with the mx25lm51245g_sim.c simulated memory.
+  *          This file should be copied to the application folder and renamed
+  *          to mx25lm51245g_conf.h
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MX25LM51245G_CONF_H
+#define MX25LM51245G_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+/* Stand-in for the HAL handle, not used by the simulated memory */
+typedef struct
+{
+  void     *Instance;
+  uint32_t  State;
+} OSPI_HandleTypeDef;
+
+#define CONF_OSPI_ODS                MX25LM51245G_CR_ODS_24   /* MX25LM51245G Output Driver Strength */
+
+#define DUMMY_CYCLES_READ            8U
+#define DUMMY_CYCLES_READ_OCTAL      6U
+#define DUMMY_CYCLES_READ_OCTAL_DTR  6U
+#define DUMMY_CYCLES_REG_OCTAL       4U
+#define DUMMY_CYCLES_REG_OCTAL_DTR   5U
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MX25LM51245G_CONF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,1928 @@
+/**
+  ******************************************************************************
+  * @file    mx25lm51245g_sim.c
+  * @author  MCD Application Team
+  * @brief   This file includes a simulated MX25LM51245G memory implementing
+  *          the component functions, so that the OSPI NOR stack can be run
+  *          and benchmarked on a host.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This file is meant for host builds. It is linked in place of
+     mx25lm51245g.c and implements the same MX25LM51245G_* functions over a
+     64 MB image of the memory array. mx25lm51245g_conf_sim.h is to be used
+     as mx25lm51245g_conf.h: it declares a stand-in OSPI_HandleTypeDef, whose
+     content is not used by the simulator.
+
+   - MX25LM51245G_SIM_Init() maps the image: a file, created erased if it does
+     not exist, so that its content is kept from one run to the next, or a RAM
+     buffer when no file name is given.
+
+   - The memory is modeled as seen through the OSPI peripheral:
+       (++) Commands are decoded only in the interface mode of the memory (SPI,
+            STR OPI or DTR OPI, switched through the configuration register 2).
+            Commands sent in another mode, while the memory is busy, or
+            program/erase commands without write enable are ignored, as by
+            the memory, and counted in the Ignored statistic.
+       (++) Programs only clear bits and wrap within the 256 bytes page.
+            Erases are done on aligned 4K subsectors, 64K sectors or the whole
+            array.
+       (++) Program and erase set WIP for the time given by the timing model.
+            MX25LM51245G_AutoPollingMemReady() advances the simulated time to
+            the end of the operation, MX25LM51245G_SIM_Wait() advances it by
+            a given time.
+       (++) Suspend stops the operation in progress after the suspend latency
+            and sets PSB or ESB, reads and (during an erase suspend) programs
+            of other blocks are then possible. Resume restarts it with its
+            remaining time.
+       (++) A software reset, enabled by the previous command, interrupts the
+            operation in progress: it is left partly done.
+       (++) Memory mapped mode is entered by the component functions and left
+            with MX25LM51245G_SIM_Abort(), in place of HAL_OSPI_Abort(). Reads
+            are done with MX25LM51245G_SIM_ReadMemoryMapped(), other commands
+            fail meanwhile as with the HAL.
+       (++) MX25LM51245G_AutoPollingMemReady_IT() starts the status match
+            polling, MX25LM51245G_SIM_StatusMatch() tells when the interrupt
+            would fire. The polling does not take simulated time, other
+            commands fail until the match or MX25LM51245G_SIM_Abort().
+
+   - The timing model charges the transfer of each command on the OSPI bus
+     (instruction, address, dummy cycles and data at the configured clock, one
+     bit per cycle in SPI, one byte per cycle in STR OPI, two in DTR OPI) and
+     the operation times of MX25LM51245G_SIM_Timing_t, by default the maximum
+     times of the component.
+
+   - MX25LM51245G_SIM_InjectFault() makes a later program or erase fail
+     halfway: with MX25LM51245G_SIM_FAULT_POWER_LOSS, all commands then fail
+     until MX25LM51245G_SIM_PowerOn(); with MX25LM51245G_SIM_FAULT_FAIL, the
+     memory sets P_FAIL or E_FAIL in the security register.
+
+   - MX25LM51245G_SIM_GetStats() reports the simulated time, the bus and wait
+     times, and the number of reads, programs, erases, suspends and ignored
+     commands. MX25LM51245G_SIM_GetEraseCount() returns the erase cycles of a
+     4K subsector.
+------------------------------------------------------------------------------*/
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Includes ------------------------------------------------------------------*/
+#include "mx25lm51245g_sim.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup Components
+  * @{
+  */
+
+/** @addtogroup MX25LM51245G
+  * @{
+  */
+
+/** @defgroup MX25LM51245G_SIM_Private_Defines MX25LM51245G_SIM Private Defines
+  * @{
+  */
+/* Command decoding */
+#define SIM_ACCEPTED          0
+#define SIM_IGNORED           1
+
+/* Interface modes */
+#define SIM_SPI               0U
+#define SIM_SOPI              1U
+#define SIM_DOPI              2U
+
+/* Operations setting WIP */
+#define SIM_OP_NONE           0U
+#define SIM_OP_PROGRAM        1U
+#define SIM_OP_ERASE          2U
+#define SIM_OP_REGISTER       3U
+#define SIM_OP_SUSPEND        4U
+#define SIM_OP_RESET          5U
+
+/* Registers written by SIM_OP_REGISTER */
+#define SIM_REG_SR            0U
+#define SIM_REG_CR            1U
+
+/* Status match polling */
+#define SIM_POLL_NONE         0U
+#define SIM_POLL_ARMED        1U
+#define SIM_POLL_NO_MATCH     2U   /* Memory in another mode, never ready */
+
+/* Configuration register 2 addresses */
+#define SIM_CR2_NBR           5U
+
+#define SIM_SUBSECTOR_NBR     (MX25LM51245G_FLASH_SIZE / MX25LM51245G_SUBSECTOR_4K)
+#define SIM_ID                {0xC2U, 0x85U, 0x3AU}
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Private_Types MX25LM51245G_SIM Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t Type;
+  uint32_t Address;
+  uint32_t Size;
+  uint32_t Fault;
+  uint64_t Start;
+  uint64_t End;
+  uint64_t Duration;
+  uint8_t  Data[MX25LM51245G_PAGE_SIZE];  /* Page program data, 0xFF where not sent */
+} SIM_Op_t;
+
+typedef struct
+{
+  uint8_t                   *pImage;
+  int                        File;        /* Image file, -1 for a RAM image */
+  uint32_t                   Interface;
+  uint8_t                    Sr;
+  uint8_t                    Cr;
+  uint8_t                    Secr;
+  uint8_t                    Cr2[SIM_CR2_NBR];
+  uint32_t                   PoweredOff;
+  uint32_t                   PowerDown;
+  uint32_t                   MemoryMapped;
+  uint32_t                   Polling;
+  uint32_t                   MappedInterface;
+  uint32_t                   ResetEnabled;
+  uint32_t                   ResetArmed;
+  uint64_t                   Time;        /* ns */
+  SIM_Op_t                   Active;
+  SIM_Op_t                   Suspended;
+  uint64_t                   Remaining;   /* Time left to the suspended operation */
+  uint32_t                   FaultType;
+  uint32_t                   FaultCountdown;
+  MX25LM51245G_SIM_Timing_t  Timing;
+  MX25LM51245G_SIM_Stats_t   Stats;
+  uint32_t                   EraseCount[SIM_SUBSECTOR_NBR];
+} SIM_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Private_FunctionPrototypes MX25LM51245G_SIM Private FunctionPrototypes
+  * @{
+  */
+static int32_t  SIM_Command(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
+static void     SIM_Bus(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint32_t AddressSize,
+                        uint32_t Dummy, uint32_t Size);
+static void     SIM_Update(void);
+static void     SIM_Start(uint32_t Type, uint32_t Address, uint32_t Size, uint32_t Time);
+static void     SIM_Apply(const SIM_Op_t *pOp, uint32_t Size);
+static void     SIM_Complete(void);
+static void     SIM_Interrupt(void);
+static int32_t  SIM_ReadArray(uint8_t *pData, uint32_t ReadAddr, uint32_t Size, int32_t Status, uint32_t Interface);
+static int32_t  SIM_Program(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint32_t AddressSize,
+                            const uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
+static void     SIM_ReadRegister(int32_t Status, MX25LM51245G_Transfer_t Rate, uint8_t Register, uint8_t *Value);
+static uint32_t SIM_Cr2Index(uint32_t Address);
+static uint32_t SIM_Interface(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
+static void     SIM_SetInterface(void);
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Private_Variables MX25LM51245G_SIM Private Variables
+  * @{
+  */
+static SIM_Ctx_t SimCtx = {.File = -1};
+
+static const uint32_t SimCr2Address[SIM_CR2_NBR] =
+{
+  MX25LM51245G_CR2_REG1_ADDR,
+  MX25LM51245G_CR2_REG2_ADDR,
+  MX25LM51245G_CR2_REG3_ADDR,
+  MX25LM51245G_CR2_REG4_ADDR,
+  MX25LM51245G_CR2_REG5_ADDR
+};
+/**
+  * @}
+  */
+
+/** @addtogroup MX25LM51245G_SIM_Exported_Functions
+  * @{
+  */
+/**
+  * @brief  Map the memory image and power the memory on, in SPI mode.
+  * @param  pFileName Image file, NULL for an erased RAM image
+  * @retval Component status
+  */
+int32_t MX25LM51245G_SIM_Init(const char *pFileName)
+{
+  int32_t ret = MX25LM51245G_OK;
+  struct stat info;
+  void *image;
+
+  (void)MX25LM51245G_SIM_DeInit();
+
+  if (pFileName == NULL)
+  {
+    SimCtx.pImage = (uint8_t *)malloc(MX25LM51245G_FLASH_SIZE);
+    if (SimCtx.pImage == NULL)
+    {
+      ret = MX25LM51245G_ERROR;
+    }
+    else
+    {
+      (void)memset(SimCtx.pImage, 0xFF, MX25LM51245G_FLASH_SIZE);
+    }
+  }
+  else
+  {
+    SimCtx.File = open(pFileName, O_RDWR | O_CREAT, 0644);
+    if ((SimCtx.File < 0) || (fstat(SimCtx.File, &info) != 0) ||
+        ((info.st_size != 0) && (info.st_size != (off_t)MX25LM51245G_FLASH_SIZE)) ||
+        ((info.st_size == 0) && (ftruncate(SimCtx.File, (off_t)MX25LM51245G_FLASH_SIZE) != 0)))
+    {
+      ret = MX25LM51245G_ERROR;
+    }
+    else
+    {
+      image = mmap(NULL, MX25LM51245G_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, SimCtx.File, 0);
+      if (image == MAP_FAILED)
+      {
+        ret = MX25LM51245G_ERROR;
+      }
+      else
+      {
+        SimCtx.pImage = (uint8_t *)image;
+        if (info.st_size == 0)
+        {
+          (void)memset(SimCtx.pImage, 0xFF, MX25LM51245G_FLASH_SIZE);
+        }
+      }
+    }
+    if ((ret != MX25LM51245G_OK) && (SimCtx.File >= 0))
+    {
+      (void)close(SimCtx.File);
+      SimCtx.File = -1;
+    }
+  }
+
+  if (ret == MX25LM51245G_OK)
+  {
+    SimCtx.Timing.BusClock           = MX25LM51245G_SIM_BUS_CLOCK;
+    SimCtx.Timing.PageProgramTime    = MX25LM51245G_SIM_PAGE_PROG_MAX_TIME;
+    SimCtx.Timing.SubsectorEraseTime = MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME * 1000U;
+    SimCtx.Timing.SectorEraseTime    = MX25LM51245G_SECTOR_ERASE_MAX_TIME * 1000U;
+    SimCtx.Timing.ChipEraseTime      = MX25LM51245G_BULK_ERASE_MAX_TIME * 1000U;
+    SimCtx.Timing.WriteRegTime       = MX25LM51245G_WRITE_REG_MAX_TIME * 1000U;
+    SimCtx.Timing.SuspendTime        = MX25LM51245G_SIM_SUSPEND_MAX_TIME;
+    SimCtx.Timing.ResumeTime         = MX25LM51245G_SIM_RESUME_TIME;
+    SimCtx.Timing.ResetTime          = MX25LM51245G_RESET_MAX_TIME * 1000U;
+    SimCtx.Time                      = 0U;
+    SimCtx.Sr                        = 0U;
+    SimCtx.Cr                        = 0U;
+    SimCtx.FaultType                 = (uint32_t)MX25LM51245G_SIM_FAULT_NONE;
+    SimCtx.FaultCountdown            = 0U;
+    SimCtx.Active.Type               = SIM_OP_NONE;
+    SimCtx.Suspended.Type            = SIM_OP_NONE;
+    (void)memset(SimCtx.Cr2, 0, sizeof(SimCtx.Cr2));
+    SimCtx.Cr2[SIM_CR2_NBR - 1U]     = 0xFFU;  /* DEFSOPI and DEFDOPI are active low */
+    (void)memset(SimCtx.EraseCount, 0, sizeof(SimCtx.EraseCount));
+    MX25LM51245G_SIM_PowerOn();
+    MX25LM51245G_SIM_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Unmap the memory image. An image file keeps the memory content.
+  * @retval Component status
+  */
+int32_t MX25LM51245G_SIM_DeInit(void)
+{
+  int32_t ret = MX25LM51245G_OK;
+
+  if (SimCtx.pImage != NULL)
+  {
+    if (SimCtx.File >= 0)
+    {
+      if (munmap(SimCtx.pImage, MX25LM51245G_FLASH_SIZE) != 0)
+      {
+        ret = MX25LM51245G_ERROR;
+      }
+      (void)close(SimCtx.File);
+      SimCtx.File = -1;
+    }
+    else
+    {
+      free(SimCtx.pImage);
+    }
+    SimCtx.pImage = NULL;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the memory array, e.g. to check or preset its content.
+  * @retval MX25LM51245G_FLASH_SIZE bytes image, NULL when not initialized
+  */
+uint8_t *MX25LM51245G_SIM_GetImage(void)
+{
+  return SimCtx.pImage;
+}
+
+/**
+  * @brief  Get the timing model.
+  * @param  pTiming Timing model
+  */
+void MX25LM51245G_SIM_GetTiming(MX25LM51245G_SIM_Timing_t *pTiming)
+{
+  if (pTiming != NULL)
+  {
+    *pTiming = SimCtx.Timing;
+  }
+}
+
+/**
+  * @brief  Set the timing model, e.g. with typical instead of maximum times.
+  *         It applies to the operations started afterwards.
+  * @param  pTiming Timing model
+  */
+void MX25LM51245G_SIM_SetTiming(const MX25LM51245G_SIM_Timing_t *pTiming)
+{
+  if ((pTiming != NULL) && (pTiming->BusClock != 0U))
+  {
+    SimCtx.Timing = *pTiming;
+  }
+}
+
+/**
+  * @brief  Get the simulated time.
+  * @retval Time in ns since MX25LM51245G_SIM_Init()
+  */
+uint64_t MX25LM51245G_SIM_GetTime(void)
+{
+  return SimCtx.Time;
+}
+
+/**
+  * @brief  Advance the simulated time, as spent by the host doing other work.
+  * @param  Time Time in us
+  */
+void MX25LM51245G_SIM_Wait(uint32_t Time)
+{
+  SimCtx.Time += (uint64_t)Time * 1000U;
+  SIM_Update();
+}
+
+/**
+  * @brief  Inject a fault in a later program or erase operation.
+  * @param  Fault     Fault type
+  * @param  Operation 1 for the next program or erase, 2 for the one after it,
+  *                   and so on; 0 cancels the fault
+  * @retval Component status
+  */
+int32_t MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_Fault_t Fault, uint32_t Operation)
+{
+  int32_t ret = MX25LM51245G_OK;
+
+  if (Fault > MX25LM51245G_SIM_FAULT_FAIL)
+  {
+    ret = MX25LM51245G_ERROR;
+  }
+  else
+  {
+    SimCtx.FaultType      = (uint32_t)Fault;
+    SimCtx.FaultCountdown = (Fault == MX25LM51245G_SIM_FAULT_NONE) ? 0U : Operation;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Power the memory on, after a power loss fault or to simulate a
+  *         power cycle. Volatile registers get their reset values and an
+  *         operation in progress is left partly done.
+  */
+void MX25LM51245G_SIM_PowerOn(void)
+{
+  if (SimCtx.PoweredOff == 0U)
+  {
+    SIM_Interrupt();
+  }
+  SimCtx.PoweredOff   = 0U;
+  SimCtx.PowerDown    = 0U;
+  SimCtx.MemoryMapped = 0U;
+  SimCtx.Polling      = SIM_POLL_NONE;
+  SimCtx.ResetEnabled = 0U;
+  SimCtx.ResetArmed   = 0U;
+  SimCtx.Sr          &= MX25LM51245G_SR_PB;
+  SimCtx.Secr        &= (uint8_t)~(MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB |
+                                   MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL);
+  SimCtx.Active.Type    = SIM_OP_NONE;
+  SimCtx.Suspended.Type = SIM_OP_NONE;
+  SIM_SetInterface();
+}
+
+/**
+  * @brief  Read the memory in memory mapped mode.
+  * @param  pData    Destination
+  * @param  ReadAddr Memory address
+  * @param  Size     Number of bytes
+  * @retval Component status, MX25LM51245G_ERROR when not in memory mapped mode
+  */
+int32_t MX25LM51245G_SIM_ReadMemoryMapped(uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  MX25LM51245G_Interface_t mode;
+  MX25LM51245G_Transfer_t rate;
+
+  if ((SimCtx.pImage != NULL) && (SimCtx.PoweredOff == 0U) && (SimCtx.MemoryMapped != 0U) && (pData != NULL))
+  {
+    mode = (SimCtx.MappedInterface == SIM_SPI) ? MX25LM51245G_SPI_MODE : MX25LM51245G_OPI_MODE;
+    rate = (SimCtx.MappedInterface == SIM_DOPI) ? MX25LM51245G_DTR_TRANSFER : MX25LM51245G_STR_TRANSFER;
+    SIM_Update();
+    SIM_Bus(mode, rate, 4U, (SimCtx.MappedInterface == SIM_SPI) ? DUMMY_CYCLES_READ
+                            : ((SimCtx.MappedInterface == SIM_DOPI) ? DUMMY_CYCLES_READ_OCTAL_DTR
+                               : DUMMY_CYCLES_READ_OCTAL), Size);
+    ret = SIM_ReadArray(pData, ReadAddr, Size, SIM_ACCEPTED, SimCtx.MappedInterface);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Leave memory mapped mode or stop the status match polling, as
+  *         HAL_OSPI_Abort() does.
+  */
+void MX25LM51245G_SIM_Abort(void)
+{
+  SimCtx.MemoryMapped = 0U;
+  SimCtx.Polling      = SIM_POLL_NONE;
+}
+
+/**
+  * @brief  Check the status match of the polling started by
+  *         MX25LM51245G_AutoPollingMemReady_IT(), in place of the interrupt.
+  *         The polling stops on the match.
+  * @retval 1 when the memory is ready, 0 otherwise or when not polling
+  */
+uint32_t MX25LM51245G_SIM_StatusMatch(void)
+{
+  uint32_t ret = 0U;
+
+  if (SimCtx.Polling == SIM_POLL_ARMED)
+  {
+    SIM_Update();
+    if ((SimCtx.PoweredOff == 0U) && (SimCtx.Active.Type == SIM_OP_NONE))
+    {
+      SimCtx.Polling = SIM_POLL_NONE;
+      ret = 1U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the erase cycles of a 4K subsector.
+  * @param  Address Memory address in the subsector
+  * @retval Erase count
+  */
+uint32_t MX25LM51245G_SIM_GetEraseCount(uint32_t Address)
+{
+  return SimCtx.EraseCount[(Address % MX25LM51245G_FLASH_SIZE) / MX25LM51245G_SUBSECTOR_4K];
+}
+
+/**
+  * @brief  Get the statistics.
+  * @param  pStats Statistics
+  */
+void MX25LM51245G_SIM_GetStats(MX25LM51245G_SIM_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    SimCtx.Stats.Time = SimCtx.Time;
+    *pStats = SimCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the statistics counters, the simulated time goes on.
+  */
+void MX25LM51245G_SIM_ResetStats(void)
+{
+  (void)memset(&SimCtx.Stats, 0, sizeof(SimCtx.Stats));
+}
+
+/**
+  * @brief  Get Flash information
+  * @param  pInfo pointer to information structure
+  * @retval error status
+  */
+int32_t MX25LM51245G_GetFlashInfo(MX25LM51245G_Info_t *pInfo)
+{
+  pInfo->FlashSize              = MX25LM51245G_FLASH_SIZE;
+  pInfo->EraseSectorSize        = MX25LM51245G_SECTOR_64K;
+  pInfo->EraseSectorsNumber     = (MX25LM51245G_FLASH_SIZE / MX25LM51245G_SECTOR_64K);
+  pInfo->EraseSubSectorSize     = MX25LM51245G_SUBSECTOR_4K;
+  pInfo->EraseSubSectorNumber   = (MX25LM51245G_FLASH_SIZE / MX25LM51245G_SUBSECTOR_4K);
+  pInfo->EraseSubSector1Size    = MX25LM51245G_SUBSECTOR_4K;
+  pInfo->EraseSubSector1Number  = (MX25LM51245G_FLASH_SIZE / MX25LM51245G_SUBSECTOR_4K);
+  pInfo->ProgPageSize           = MX25LM51245G_PAGE_SIZE;
+  pInfo->ProgPagesNumber        = (MX25LM51245G_FLASH_SIZE / MX25LM51245G_PAGE_SIZE);
+
+  return MX25LM51245G_OK;
+}
+
+/**
+  * @brief  Wait for the end of the operation in progress, advancing the
+  *         simulated time.
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate
+  * @retval error status, MX25LM51245G_ERROR when the memory does not answer
+  */
+int32_t MX25LM51245G_AutoPollingMemReady(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                         MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret;
+  uint64_t start = SimCtx.Time;
+
+  (void)Ctx;
+
+  ret = SIM_Command(Mode, Rate);
+  if (ret != MX25LM51245G_ERROR)
+  {
+    SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+            : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+            (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+
+    /* A memory in another mode never reports ready: the polling times out */
+    if (ret == SIM_IGNORED)
+    {
+      ret = MX25LM51245G_ERROR;
+    }
+    while ((ret != MX25LM51245G_ERROR) && (SimCtx.Active.Type != SIM_OP_NONE))
+    {
+      if ((SimCtx.Active.Fault == (uint32_t)MX25LM51245G_SIM_FAULT_POWER_LOSS) &&
+          (SimCtx.Time < (SimCtx.Active.Start + (SimCtx.Active.Duration / 2U))))
+      {
+        SimCtx.Time = SimCtx.Active.Start + (SimCtx.Active.Duration / 2U);
+      }
+      else if (SimCtx.Time < SimCtx.Active.End)
+      {
+        SimCtx.Time = SimCtx.Active.End;
+      }
+      else
+      {
+        /* Due */
+      }
+      SIM_Update();
+      if (SimCtx.PoweredOff != 0U)
+      {
+        ret = MX25LM51245G_ERROR;
+      }
+    }
+    ret = (ret == MX25LM51245G_ERROR) ? MX25LM51245G_ERROR : MX25LM51245G_OK;
+    SimCtx.Stats.WaitTime += SimCtx.Time - start;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start polling the end of the operation in progress. The match is
+  *         checked with MX25LM51245G_SIM_StatusMatch(), other commands fail
+  *         until then or until MX25LM51245G_SIM_Abort().
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate
+  * @retval error status
+  */
+int32_t MX25LM51245G_AutoPollingMemReady_IT(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                            MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret;
+
+  (void)Ctx;
+
+  ret = SIM_Command(Mode, Rate);
+  if (ret != MX25LM51245G_ERROR)
+  {
+    SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+            : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+            (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+    SimCtx.Polling = (ret == SIM_ACCEPTED) ? SIM_POLL_ARMED : SIM_POLL_NO_MATCH;
+    ret = MX25LM51245G_OK;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads an amount of data from the OSPI memory on STR mode.
+  *         SPI/OPI; 1-1-1/8-8-8
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  AddressSize Address size
+  * @param  pData Pointer to data to be read
+  * @param  ReadAddr Read start address
+  * @param  Size Size of data to read
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_ReadSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                             MX25LM51245G_AddressSize_t AddressSize, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  uint32_t address = (AddressSize == MX25LM51245G_3BYTES_SIZE) ? (ReadAddr & 0x00FFFFFFU) : ReadAddr;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_OPI_MODE) || (AddressSize != MX25LM51245G_3BYTES_SIZE))
+  {
+    ret = SIM_Command(Mode, MX25LM51245G_STR_TRANSFER);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, MX25LM51245G_STR_TRANSFER, (AddressSize == MX25LM51245G_3BYTES_SIZE) ? 3U : 4U,
+              (Mode == MX25LM51245G_SPI_MODE) ? DUMMY_CYCLES_READ : DUMMY_CYCLES_READ_OCTAL, Size);
+      ret = SIM_ReadArray(pData, address, Size, ret, SIM_Interface(Mode, MX25LM51245G_STR_TRANSFER));
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads an amount of data from the OSPI memory on DTR mode.
+  *         OPI
+  * @param  Ctx Component object pointer
+  * @param  pData Pointer to data to be read
+  * @param  ReadAddr Read start address
+  * @param  Size Size of data to read
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  int32_t ret;
+
+  (void)Ctx;
+
+  ret = SIM_Command(MX25LM51245G_OPI_MODE, MX25LM51245G_DTR_TRANSFER);
+  if (ret != MX25LM51245G_ERROR)
+  {
+    SIM_Bus(MX25LM51245G_OPI_MODE, MX25LM51245G_DTR_TRANSFER, 4U, DUMMY_CYCLES_READ_OCTAL_DTR, Size);
+    ret = SIM_ReadArray(pData, ReadAddr, Size, ret, SIM_DOPI);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Writes an amount of data to the OSPI memory.
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  AddressSize Address size
+  * @param  pData Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size Size of data to write. Range 1 ~ 256
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_PageProgram(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                 MX25LM51245G_AddressSize_t AddressSize, uint8_t *pData, uint32_t WriteAddr,
+                                 uint32_t Size)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_OPI_MODE) || (AddressSize != MX25LM51245G_3BYTES_SIZE))
+  {
+    ret = SIM_Program(Mode, MX25LM51245G_STR_TRANSFER, (AddressSize == MX25LM51245G_3BYTES_SIZE) ? 3U : 4U,
+                      pData, WriteAddr, Size);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Writes an amount of data to the OSPI memory on DTR mode.
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  pData Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size Size of data to write. Range 1 ~ 256
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_PageProgramDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+{
+  (void)Ctx;
+
+  return SIM_Program(MX25LM51245G_OPI_MODE, MX25LM51245G_DTR_TRANSFER, 4U, pData, WriteAddr, Size);
+}
+
+/**
+  * @brief  Erases the specified block of the OSPI memory.
+  *         MX25LM51245G support 4K, 64K size block erase commands.
+  *         SPI/OPI; 1-1-0/8-8-0
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  AddressSize Address size
+  * @param  BlockAddress Block address to erase
+  * @param  BlockSize Block size to erase
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_BlockErase(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate,
+                                MX25LM51245G_AddressSize_t AddressSize, uint32_t BlockAddress,
+                                MX25LM51245G_Erase_t BlockSize)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  uint32_t size = (BlockSize == MX25LM51245G_ERASE_64K) ? MX25LM51245G_SECTOR_64K : MX25LM51245G_SUBSECTOR_4K;
+  uint32_t address = (AddressSize == MX25LM51245G_3BYTES_SIZE) ? (BlockAddress & 0x00FFFFFFU) : BlockAddress;
+
+  (void)Ctx;
+
+  if (((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER)) &&
+      ((Mode != MX25LM51245G_OPI_MODE) || (AddressSize != MX25LM51245G_3BYTES_SIZE)))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (AddressSize == MX25LM51245G_3BYTES_SIZE) ? 3U : 4U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && (SimCtx.Suspended.Type == SIM_OP_NONE) &&
+          ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        SIM_Start(SIM_OP_ERASE, (address % MX25LM51245G_FLASH_SIZE) & ~(size - 1U), size,
+                  (size == MX25LM51245G_SECTOR_64K) ? SimCtx.Timing.SectorEraseTime : SimCtx.Timing.SubsectorEraseTime);
+        if (size == MX25LM51245G_SECTOR_64K)
+        {
+          SimCtx.Stats.Erases64K++;
+        }
+        else
+        {
+          SimCtx.Stats.Erases4K++;
+        }
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Whole chip erase.
+  *         SPI/OPI; 1-0-0/8-0-0
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate
+  * @retval error status
+  */
+int32_t MX25LM51245G_ChipErase(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && (SimCtx.Suspended.Type == SIM_OP_NONE) &&
+          ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        SIM_Start(SIM_OP_ERASE, 0U, MX25LM51245G_FLASH_SIZE, SimCtx.Timing.ChipEraseTime);
+        SimCtx.Stats.ChipErases++;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads an amount of data from the OSPI memory on STR mode.
+  *         SPI/OPI; 1-1-1/8-8-8
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  AddressSize Address size
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_EnableSTRMemoryMappedMode(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                               MX25LM51245G_AddressSize_t AddressSize)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if (((Mode != MX25LM51245G_OPI_MODE) || (AddressSize != MX25LM51245G_3BYTES_SIZE)) &&
+      (SimCtx.pImage != NULL) && (SimCtx.PoweredOff == 0U) && (SimCtx.MemoryMapped == 0U) &&
+      (SimCtx.Polling == SIM_POLL_NONE))
+  {
+    SimCtx.MemoryMapped    = 1U;
+    SimCtx.MappedInterface = SIM_Interface(Mode, MX25LM51245G_STR_TRANSFER);
+    ret = MX25LM51245G_OK;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reads an amount of data from the OSPI memory on DTR mode.
+  *         OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @retval OSPI memory status
+  */
+int32_t MX25LM51245G_EnableDTRMemoryMappedMode(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode == MX25LM51245G_OPI_MODE) && (SimCtx.pImage != NULL) && (SimCtx.PoweredOff == 0U) &&
+      (SimCtx.MemoryMapped == 0U) && (SimCtx.Polling == SIM_POLL_NONE))
+  {
+    SimCtx.MemoryMapped    = 1U;
+    SimCtx.MappedInterface = SIM_DOPI;
+    ret = MX25LM51245G_OK;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash suspend program or erase command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_Suspend(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) &&
+          ((SimCtx.Active.Type == SIM_OP_PROGRAM) || (SimCtx.Active.Type == SIM_OP_ERASE)))
+      {
+        SimCtx.Suspended = SimCtx.Active;
+        SimCtx.Remaining = SimCtx.Active.End - SimCtx.Time;
+        SimCtx.Secr     |= (SimCtx.Active.Type == SIM_OP_PROGRAM) ? MX25LM51245G_SECR_PSB : MX25LM51245G_SECR_ESB;
+        SIM_Start(SIM_OP_SUSPEND, 0U, 0U, SimCtx.Timing.SuspendTime);
+        SimCtx.Stats.Suspends++;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash resume program or erase command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_Resume(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && (SimCtx.Suspended.Type != SIM_OP_NONE))
+      {
+        SimCtx.Active         = SimCtx.Suspended;
+        SimCtx.Active.End     = SimCtx.Time + SimCtx.Remaining + ((uint64_t)SimCtx.Timing.ResumeTime * 1000U);
+        SimCtx.Active.Start   = (SimCtx.Active.End > SimCtx.Active.Duration) ? (SimCtx.Active.End - SimCtx.Active.Duration) : 0U;
+        SimCtx.Suspended.Type = SIM_OP_NONE;
+        SimCtx.Secr          &= (uint8_t)~(MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB);
+        SimCtx.Sr            |= MX25LM51245G_SR_WIP;
+        SimCtx.Stats.Resumes++;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash enable write command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteEnable(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE))
+      {
+        SimCtx.Sr |= MX25LM51245G_SR_WEL;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash disable write command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteDisable(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE))
+      {
+        SimCtx.Sr &= (uint8_t)~MX25LM51245G_SR_WEL;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read Flash Status register value
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value Status register value pointer, 2 bytes in DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadStatusRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                        MX25LM51245G_Transfer_t Rate, uint8_t *Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+              (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+      SIM_ReadRegister(ret, Rate, SimCtx.Sr, Value);
+      SimCtx.Stats.StatusReads++;
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write Flash Status register
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value Value to write to Status register
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteStatusRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                         MX25LM51245G_Transfer_t Rate, uint8_t Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, 0U, (Mode == MX25LM51245G_SPI_MODE) ? 2U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U));
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        SIM_Start(SIM_OP_REGISTER, SIM_REG_SR, 1U, SimCtx.Timing.WriteRegTime);
+        SimCtx.Active.Data[0] = Value;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write Flash configuration register
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value Value to write to configuration register
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteCfgRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                      MX25LM51245G_Transfer_t Rate, uint8_t Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, 0U, (Mode == MX25LM51245G_SPI_MODE) ? 2U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U));
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        SIM_Start(SIM_OP_REGISTER, SIM_REG_CR, 1U, SimCtx.Timing.WriteRegTime);
+        SimCtx.Active.Data[0] = Value;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read Flash configuration register value
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value configuration register value pointer, 2 bytes in DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadCfgRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                     MX25LM51245G_Transfer_t Rate, uint8_t *Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+              (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+      SIM_ReadRegister(ret, Rate, SimCtx.Cr, Value);
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write Flash configuration register 2
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  WriteAddr configuration register 2 address
+  * @param  Value Value to write to configuration register
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteCfg2Register(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                       MX25LM51245G_Transfer_t Rate, uint32_t WriteAddr, uint8_t Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  uint32_t index = SIM_Cr2Index(WriteAddr);
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 4U, 0U, (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        /* The new interface mode applies to the next command */
+        if (index < SIM_CR2_NBR)
+        {
+          SimCtx.Cr2[index] = Value;
+        }
+        if (index == 0U)
+        {
+          SimCtx.Interface = ((Value & MX25LM51245G_CR2_DOPI) != 0U) ? SIM_DOPI
+                             : (((Value & MX25LM51245G_CR2_SOPI) != 0U) ? SIM_SOPI : SIM_SPI);
+        }
+        SimCtx.Sr &= (uint8_t)~MX25LM51245G_SR_WEL;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read Flash configuration register 2 value
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  ReadAddr Configuration register 2 address
+  * @param  Value Configuration register 2 value pointer, 2 bytes in DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadCfg2Register(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                      MX25LM51245G_Transfer_t Rate, uint32_t ReadAddr, uint8_t *Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  uint32_t index = SIM_Cr2Index(ReadAddr);
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+              (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+      SIM_ReadRegister(ret, Rate, (index < SIM_CR2_NBR) ? SimCtx.Cr2[index] : 0U, Value);
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write Security register
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value Value to write to Security register
+  * @retval error status
+  */
+int32_t MX25LM51245G_WriteSecurityRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                           MX25LM51245G_Transfer_t Rate, uint8_t Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U))
+      {
+        /* Only the lock-down bit can be set, once */
+        SimCtx.Secr |= (uint8_t)(Value & MX25LM51245G_SECR_LDSO);
+        SimCtx.Sr   &= (uint8_t)~MX25LM51245G_SR_WEL;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read Security register value
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  Value Security register value pointer, 2 bytes in DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadSecurityRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                          MX25LM51245G_Transfer_t Rate, uint8_t *Value)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL),
+              (Rate == MX25LM51245G_DTR_TRANSFER) ? 2U : 1U);
+      SIM_ReadRegister(ret, Rate, SimCtx.Secr, Value);
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read Flash 3 Byte IDs.
+  *         Manufacturer ID, Memory type, Memory density
+  *         SPI/OPI; 1-0-1/1-0-8
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  ID 3 bytes IDs pointer
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadID(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate,
+                            uint8_t *ID)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+  static const uint8_t id[3] = SIM_ID;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, (Mode == MX25LM51245G_SPI_MODE) ? 0U : 4U, (Mode == MX25LM51245G_SPI_MODE) ? 0U
+              : ((Rate == MX25LM51245G_DTR_TRANSFER) ? DUMMY_CYCLES_REG_OCTAL_DTR : DUMMY_CYCLES_REG_OCTAL), 3U);
+      if (ret != SIM_ACCEPTED)
+      {
+        (void)memset(ID, 0xFF, 3U);
+      }
+      else if (Rate == MX25LM51245G_DTR_TRANSFER)
+      {
+        /* Each byte is output twice in DTR */
+        ID[0] = id[0];
+        ID[1] = id[0];
+        ID[2] = id[1];
+      }
+      else
+      {
+        (void)memcpy(ID, id, 3U);
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash reset enable command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ResetEnable(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if (ret == SIM_ACCEPTED)
+      {
+        SimCtx.ResetEnabled = 1U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash reset memory command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_ResetMemory(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.ResetArmed != 0U))
+      {
+        MX25LM51245G_SIM_PowerOn();
+        SIM_Start(SIM_OP_RESET, 0U, 0U, SimCtx.Timing.ResetTime);
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash no operation command. It also releases the memory from deep
+  *         power down.
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_NoOperation(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      SimCtx.PowerDown = 0U;
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Flash enter deep power-down command
+  *         SPI/OPI
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface select
+  * @param  Rate Transfer rate STR or DTR
+  * @retval error status
+  */
+int32_t MX25LM51245G_EnterPowerDown(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode,
+                                    MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = MX25LM51245G_ERROR;
+
+  (void)Ctx;
+
+  if ((Mode != MX25LM51245G_SPI_MODE) || (Rate != MX25LM51245G_DTR_TRANSFER))
+  {
+    ret = SIM_Command(Mode, Rate);
+    if (ret != MX25LM51245G_ERROR)
+    {
+      SIM_Bus(Mode, Rate, 0U, 0U, 0U);
+      if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE))
+      {
+        SimCtx.PowerDown = 1U;
+      }
+      else
+      {
+        SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+      }
+      ret = MX25LM51245G_OK;
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Private_Functions MX25LM51245G_SIM Private Functions
+  * @{
+  */
+/**
+  * @brief  Send a command to the memory.
+  * @param  Mode Interface mode of the command
+  * @param  Rate Transfer rate of the command
+  * @retval SIM_ACCEPTED when decoded by the memory, SIM_IGNORED when sent in
+  *         another mode or in deep power down, MX25LM51245G_ERROR when the
+  *         peripheral cannot send it (powered off, memory mapped mode, status
+  *         match polling)
+  */
+static int32_t SIM_Command(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  int32_t ret = SIM_ACCEPTED;
+
+  if ((SimCtx.pImage == NULL) || (SimCtx.PoweredOff != 0U) || (SimCtx.MemoryMapped != 0U) ||
+      (SimCtx.Polling != SIM_POLL_NONE))
+  {
+    ret = MX25LM51245G_ERROR;
+  }
+  else
+  {
+    SIM_Update();
+    SimCtx.Stats.Commands++;
+    if ((SimCtx.PowerDown != 0U) || (SIM_Interface(Mode, Rate) != SimCtx.Interface))
+    {
+      ret = SIM_IGNORED;
+      SimCtx.Stats.Ignored++;
+    }
+    else
+    {
+      /* A reset is enabled by the command just before it */
+      SimCtx.ResetArmed   = SimCtx.ResetEnabled;
+      SimCtx.ResetEnabled = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Charge the transfer of a command on the OSPI bus.
+  * @param  Mode        Interface mode
+  * @param  Rate        Transfer rate
+  * @param  AddressSize Address bytes
+  * @param  Dummy       Dummy cycles
+  * @param  Size        Data bytes
+  */
+static void SIM_Bus(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint32_t AddressSize,
+                    uint32_t Dummy, uint32_t Size)
+{
+  uint64_t half;
+  uint64_t time;
+
+  /* Half clock cycles: instruction, address, dummy cycles and data */
+  if (Mode == MX25LM51245G_SPI_MODE)
+  {
+    half = 2U * (8U + (8U * (uint64_t)AddressSize) + Dummy + (8U * (uint64_t)Size));
+  }
+  else if (Rate == MX25LM51245G_STR_TRANSFER)
+  {
+    half = 2U * (2U + (uint64_t)AddressSize + Dummy + (uint64_t)Size);
+  }
+  else
+  {
+    half = 2U + (uint64_t)AddressSize + (2U * (uint64_t)Dummy) + (uint64_t)Size;
+  }
+
+  time = ((half * 500000000U) + SimCtx.Timing.BusClock - 1U) / SimCtx.Timing.BusClock;
+  SimCtx.Time          += time;
+  SimCtx.Stats.BusTime += time;
+  SIM_Update();
+}
+
+/**
+  * @brief  Bring the operation in progress up to the simulated time.
+  */
+static void SIM_Update(void)
+{
+  if (SimCtx.Active.Type != SIM_OP_NONE)
+  {
+    if ((SimCtx.Active.Fault == (uint32_t)MX25LM51245G_SIM_FAULT_POWER_LOSS) &&
+        (SimCtx.Time >= (SimCtx.Active.Start + (SimCtx.Active.Duration / 2U))))
+    {
+      SIM_Apply(&SimCtx.Active, SimCtx.Active.Size / 2U);
+      SimCtx.Active.Type    = SIM_OP_NONE;
+      SimCtx.Suspended.Type = SIM_OP_NONE;
+      SimCtx.PoweredOff     = 1U;
+    }
+    else if (SimCtx.Time >= SimCtx.Active.End)
+    {
+      SIM_Complete();
+    }
+    else
+    {
+      /* In progress */
+    }
+  }
+}
+
+/**
+  * @brief  Start an operation setting WIP.
+  * @param  Type    Operation
+  * @param  Address Start address, or register
+  * @param  Size    Bytes programmed or erased
+  * @param  Time    Duration in us
+  */
+static void SIM_Start(uint32_t Type, uint32_t Address, uint32_t Size, uint32_t Time)
+{
+  uint32_t subsector;
+
+  SimCtx.Active.Type     = Type;
+  SimCtx.Active.Address  = Address;
+  SimCtx.Active.Size     = Size;
+  SimCtx.Active.Fault    = (uint32_t)MX25LM51245G_SIM_FAULT_NONE;
+  SimCtx.Active.Duration = (uint64_t)Time * 1000U;
+  SimCtx.Active.Start    = SimCtx.Time;
+  SimCtx.Active.End      = SimCtx.Time + SimCtx.Active.Duration;
+  SimCtx.Sr             |= MX25LM51245G_SR_WIP;
+
+  if ((Type == SIM_OP_PROGRAM) || (Type == SIM_OP_ERASE))
+  {
+    SimCtx.Secr &= (uint8_t)~(MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL);
+    if (SimCtx.FaultCountdown != 0U)
+    {
+      SimCtx.FaultCountdown--;
+      if (SimCtx.FaultCountdown == 0U)
+      {
+        SimCtx.Active.Fault = SimCtx.FaultType;
+      }
+    }
+  }
+
+  if (Type == SIM_OP_ERASE)
+  {
+    for (subsector = Address / MX25LM51245G_SUBSECTOR_4K; subsector < ((Address + Size) / MX25LM51245G_SUBSECTOR_4K);
+         subsector++)
+    {
+      SimCtx.EraseCount[subsector]++;
+    }
+  }
+}
+
+/**
+  * @brief  Apply the first bytes of a program or erase to the memory array.
+  * @param  pOp  Operation
+  * @param  Size Bytes done
+  */
+static void SIM_Apply(const SIM_Op_t *pOp, uint32_t Size)
+{
+  uint32_t i;
+
+  if (pOp->Type == SIM_OP_PROGRAM)
+  {
+    for (i = 0U; i < Size; i++)
+    {
+      SimCtx.pImage[pOp->Address + i] &= pOp->Data[i];
+    }
+  }
+  else if (pOp->Type == SIM_OP_ERASE)
+  {
+    (void)memset(&SimCtx.pImage[pOp->Address], 0xFF, Size);
+  }
+  else
+  {
+    /* No array change */
+  }
+}
+
+/**
+  * @brief  End the operation in progress.
+  */
+static void SIM_Complete(void)
+{
+  SIM_Op_t *op = &SimCtx.Active;
+
+  if ((op->Type == SIM_OP_PROGRAM) || (op->Type == SIM_OP_ERASE))
+  {
+    if (op->Fault == (uint32_t)MX25LM51245G_SIM_FAULT_FAIL)
+    {
+      SIM_Apply(op, op->Size / 2U);
+      SimCtx.Secr |= (op->Type == SIM_OP_PROGRAM) ? MX25LM51245G_SECR_P_FAIL : MX25LM51245G_SECR_E_FAIL;
+    }
+    else
+    {
+      SIM_Apply(op, op->Size);
+    }
+    SimCtx.Sr &= (uint8_t)~MX25LM51245G_SR_WEL;
+  }
+  else if (op->Type == SIM_OP_REGISTER)
+  {
+    if (op->Address == SIM_REG_SR)
+    {
+      SimCtx.Sr = (uint8_t)((SimCtx.Sr & ~MX25LM51245G_SR_PB) | (op->Data[0] & MX25LM51245G_SR_PB));
+    }
+    else
+    {
+      SimCtx.Cr = op->Data[0];
+    }
+    SimCtx.Sr &= (uint8_t)~MX25LM51245G_SR_WEL;
+  }
+  else
+  {
+    /* Suspend latency or reset recovery */
+  }
+
+  op->Type   = SIM_OP_NONE;
+  SimCtx.Sr &= (uint8_t)~MX25LM51245G_SR_WIP;
+}
+
+/**
+  * @brief  Interrupt the operations in progress or suspended, leaving them
+  *         done in proportion of their elapsed time.
+  */
+static void SIM_Interrupt(void)
+{
+  uint64_t done;
+
+  if (SimCtx.Active.Type != SIM_OP_NONE)
+  {
+    done = SimCtx.Time - SimCtx.Active.Start;
+    SIM_Apply(&SimCtx.Active, (SimCtx.Active.Duration == 0U) ? SimCtx.Active.Size
+              : (uint32_t)(((uint64_t)SimCtx.Active.Size * done) / SimCtx.Active.Duration));
+  }
+  if (SimCtx.Suspended.Type != SIM_OP_NONE)
+  {
+    done = SimCtx.Suspended.Duration - SimCtx.Remaining;
+    SIM_Apply(&SimCtx.Suspended, (SimCtx.Suspended.Duration == 0U) ? SimCtx.Suspended.Size
+              : (uint32_t)(((uint64_t)SimCtx.Suspended.Size * done) / SimCtx.Suspended.Duration));
+  }
+}
+
+/**
+  * @brief  Read the memory array, wrapping at its end.
+  * @param  pData     Destination
+  * @param  ReadAddr  Memory address
+  * @param  Size      Number of bytes
+  * @param  Status    Command decoding status
+  * @param  Interface Interface mode of the read
+  * @retval Component status
+  */
+static int32_t SIM_ReadArray(uint8_t *pData, uint32_t ReadAddr, uint32_t Size, int32_t Status, uint32_t Interface)
+{
+  uint32_t address = ReadAddr % MX25LM51245G_FLASH_SIZE;
+  uint32_t length;
+  uint32_t done = 0U;
+
+  /* Nothing is output by a memory busy or in another mode */
+  if ((Status != SIM_ACCEPTED) || (Interface != SimCtx.Interface) || (SimCtx.Active.Type != SIM_OP_NONE))
+  {
+    (void)memset(pData, 0xFF, Size);
+    SimCtx.Stats.Ignored += (Status == SIM_ACCEPTED) ? 1U : 0U;
+  }
+  else
+  {
+    while (done < Size)
+    {
+      length = MX25LM51245G_FLASH_SIZE - address;
+      length = (length < (Size - done)) ? length : (Size - done);
+      (void)memcpy(&pData[done], &SimCtx.pImage[address], length);
+      done   += length;
+      address = 0U;
+    }
+    SimCtx.Stats.Reads++;
+    SimCtx.Stats.ReadBytes += Size;
+  }
+
+  return MX25LM51245G_OK;
+}
+
+/**
+  * @brief  Page program, the data wrapping within the page.
+  * @param  Mode        Interface mode
+  * @param  Rate        Transfer rate
+  * @param  AddressSize Address bytes
+  * @param  pData       Data
+  * @param  WriteAddr   Memory address
+  * @param  Size        Number of bytes, the last 256 ones are kept
+  * @retval Component status
+  */
+static int32_t SIM_Program(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint32_t AddressSize,
+                           const uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+{
+  int32_t ret;
+  uint32_t address = ((AddressSize == 3U) ? (WriteAddr & 0x00FFFFFFU) : WriteAddr) % MX25LM51245G_FLASH_SIZE;
+  uint32_t page = address & ~(MX25LM51245G_PAGE_SIZE - 1U);
+  uint32_t suspended = SimCtx.Suspended.Address & ~(MX25LM51245G_SUBSECTOR_4K - 1U);
+  uint32_t i;
+
+  ret = SIM_Command(Mode, Rate);
+  if (ret != MX25LM51245G_ERROR)
+  {
+    SIM_Bus(Mode, Rate, AddressSize, 0U, Size);
+
+    /* Programs are possible during an erase suspend, out of the erased block */
+    if ((ret == SIM_ACCEPTED) && (SimCtx.Active.Type == SIM_OP_NONE) && ((SimCtx.Sr & MX25LM51245G_SR_WEL) != 0U) &&
+        (Size != 0U) && ((SimCtx.Suspended.Type == SIM_OP_NONE) ||
+                         ((SimCtx.Suspended.Type == SIM_OP_ERASE) &&
+                          ((page < suspended) || (page >= (SimCtx.Suspended.Address + SimCtx.Suspended.Size))))))
+    {
+      SIM_Start(SIM_OP_PROGRAM, page, MX25LM51245G_PAGE_SIZE, SimCtx.Timing.PageProgramTime);
+      (void)memset(SimCtx.Active.Data, 0xFF, MX25LM51245G_PAGE_SIZE);
+      for (i = 0U; i < Size; i++)
+      {
+        SimCtx.Active.Data[(address + i) % MX25LM51245G_PAGE_SIZE] = pData[i];
+      }
+      SimCtx.Stats.Programs++;
+      SimCtx.Stats.ProgramBytes += (Size < MX25LM51245G_PAGE_SIZE) ? Size : MX25LM51245G_PAGE_SIZE;
+    }
+    else
+    {
+      SimCtx.Stats.Ignored += (ret == SIM_ACCEPTED) ? 1U : 0U;
+    }
+    ret = MX25LM51245G_OK;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Output a register value: one byte, or the byte twice in DTR.
+  * @param  Status   Command decoding status
+  * @param  Rate     Transfer rate
+  * @param  Register Register value
+  * @param  Value    Destination
+  */
+static void SIM_ReadRegister(int32_t Status, MX25LM51245G_Transfer_t Rate, uint8_t Register, uint8_t *Value)
+{
+  uint8_t value = (Status == SIM_ACCEPTED) ? Register : 0xFFU;
+
+  Value[0] = value;
+  if (Rate == MX25LM51245G_DTR_TRANSFER)
+  {
+    Value[1] = value;
+  }
+}
+
+/**
+  * @brief  Get the index of a configuration register 2 address.
+  * @param  Address Register address
+  * @retval Index, SIM_CR2_NBR when not modeled
+  */
+static uint32_t SIM_Cr2Index(uint32_t Address)
+{
+  uint32_t index = 0U;
+
+  while ((index < SIM_CR2_NBR) && (SimCr2Address[index] != Address))
+  {
+    index++;
+  }
+
+  return index;
+}
+
+/**
+  * @brief  Get the interface mode of a command.
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate
+  * @retval SIM_SPI, SIM_SOPI or SIM_DOPI
+  */
+static uint32_t SIM_Interface(MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate)
+{
+  uint32_t ret = SIM_SPI;
+
+  if (Mode == MX25LM51245G_OPI_MODE)
+  {
+    ret = (Rate == MX25LM51245G_DTR_TRANSFER) ? SIM_DOPI : SIM_SOPI;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reset the volatile configuration register 2 and set the interface
+  *         mode selected for power on.
+  */
+static void SIM_SetInterface(void)
+{
+  uint8_t reg5 = SimCtx.Cr2[SIM_CR2_NBR - 1U];
+
+  (void)memset(SimCtx.Cr2, 0, SIM_CR2_NBR - 1U);
+  if ((reg5 & MX25LM51245G_CR2_DEFDOPI) == 0U)
+  {
+    SimCtx.Cr2[0]    = MX25LM51245G_CR2_DOPI;
+    SimCtx.Interface = SIM_DOPI;
+  }
+  else if ((reg5 & MX25LM51245G_CR2_DEFSOPI) == 0U)
+  {
+    SimCtx.Cr2[0]    = MX25LM51245G_CR2_SOPI;
+    SimCtx.Interface = SIM_SOPI;
+  }
+  else
+  {
+    SimCtx.Interface = SIM_SPI;
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,158 @@
+/**
+  ******************************************************************************
+  * @file    mx25lm51245g_sim.h
+  * @author  MCD Application Team
+  * @brief   This file contains all the functions prototypes for the
+  *          mx25lm51245g_sim.c simulated memory.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MX25LM51245G_SIM_H
+#define MX25LM51245G_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mx25lm51245g.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup Components
+  * @{
+  */
+
+/** @addtogroup MX25LM51245G
+  * @{
+  */
+
+/** @defgroup MX25LM51245G_SIM_Exported_Constants MX25LM51245G_SIM Exported Constants
+  * @{
+  */
+/**
+  * @brief  Default timings not given by the component, in us
+  */
+#define MX25LM51245G_SIM_PAGE_PROG_MAX_TIME       750U     /* 256 bytes page program           */
+#define MX25LM51245G_SIM_SUSPEND_MAX_TIME         20U      /* Program/erase suspend latency    */
+#define MX25LM51245G_SIM_RESUME_TIME              20U      /* Lost on each resume              */
+
+/**
+  * @brief  Default OSPI clock: 120 MHz / ClockPrescaler 3 as set by BSP_OSPI_NOR_Init()
+  */
+#define MX25LM51245G_SIM_BUS_CLOCK                40000000U
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Exported_Types MX25LM51245G_SIM Exported Types
+  * @{
+  */
+/**
+  * @brief  Timing model. Operation times are in us, defaults are the
+  *         MX25LM51245G_*_MAX_TIME values.
+  */
+typedef struct
+{
+  uint32_t BusClock;            /*!< OSPI clock in Hz, for the command and data transfers  */
+  uint32_t PageProgramTime;     /*!< Page program                                          */
+  uint32_t SubsectorEraseTime;  /*!< 4K subsector erase                                    */
+  uint32_t SectorEraseTime;     /*!< 64K sector erase                                      */
+  uint32_t ChipEraseTime;       /*!< Bulk erase                                            */
+  uint32_t WriteRegTime;        /*!< Status and configuration register write               */
+  uint32_t SuspendTime;         /*!< Program/erase suspend latency                         */
+  uint32_t ResumeTime;          /*!< Added to the remaining time on each resume            */
+  uint32_t ResetTime;           /*!< Software reset recovery                               */
+} MX25LM51245G_SIM_Timing_t;
+
+/**
+  * @brief  Injected faults, applied to a later program or erase operation
+  */
+typedef enum
+{
+  MX25LM51245G_SIM_FAULT_NONE = 0,          /*!< No fault                                           */
+  MX25LM51245G_SIM_FAULT_POWER_LOSS,        /*!< Power lost halfway, see MX25LM51245G_SIM_PowerOn() */
+  MX25LM51245G_SIM_FAULT_FAIL               /*!< Half done, P_FAIL or E_FAIL set                    */
+} MX25LM51245G_SIM_Fault_t;
+
+/**
+  * @brief  Statistics. Times are in ns of simulated time.
+  */
+typedef struct
+{
+  uint64_t Time;            /*!< Simulated time                                             */
+  uint64_t BusTime;         /*!< Time spent transferring commands and data                  */
+  uint64_t WaitTime;        /*!< Time spent in MX25LM51245G_AutoPollingMemReady()           */
+  uint32_t Commands;        /*!< Commands sent                                              */
+  uint32_t Reads;           /*!< Array reads, indirect and memory mapped                    */
+  uint32_t ReadBytes;       /*!< Bytes read from the array                                  */
+  uint32_t Programs;        /*!< Page programs                                              */
+  uint32_t ProgramBytes;    /*!< Bytes programmed                                           */
+  uint32_t Erases4K;        /*!< 4K subsector erases                                        */
+  uint32_t Erases64K;       /*!< 64K sector erases                                          */
+  uint32_t ChipErases;      /*!< Bulk erases                                                */
+  uint32_t StatusReads;     /*!< Status register reads                                      */
+  uint32_t Suspends;        /*!< Program/erase suspends                                     */
+  uint32_t Resumes;         /*!< Program/erase resumes                                      */
+  uint32_t Ignored;         /*!< Commands ignored by the memory: wrong interface mode, busy,
+                                 write not enabled, nothing to suspend or resume            */
+} MX25LM51245G_SIM_Stats_t;
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_SIM_Exported_Functions MX25LM51245G_SIM Exported Functions
+  * @{
+  */
+int32_t  MX25LM51245G_SIM_Init(const char *pFileName);
+int32_t  MX25LM51245G_SIM_DeInit(void);
+uint8_t *MX25LM51245G_SIM_GetImage(void);
+void     MX25LM51245G_SIM_GetTiming(MX25LM51245G_SIM_Timing_t *pTiming);
+void     MX25LM51245G_SIM_SetTiming(const MX25LM51245G_SIM_Timing_t *pTiming);
+uint64_t MX25LM51245G_SIM_GetTime(void);
+void     MX25LM51245G_SIM_Wait(uint32_t Time);
+int32_t  MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_Fault_t Fault, uint32_t Operation);
+void     MX25LM51245G_SIM_PowerOn(void);
+int32_t  MX25LM51245G_SIM_ReadMemoryMapped(uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+void     MX25LM51245G_SIM_Abort(void);
+uint32_t MX25LM51245G_SIM_StatusMatch(void);
+uint32_t MX25LM51245G_SIM_GetEraseCount(uint32_t Address);
+void     MX25LM51245G_SIM_GetStats(MX25LM51245G_SIM_Stats_t *pStats);
+void     MX25LM51245G_SIM_ResetStats(void);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MX25LM51245G_SIM_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -57,6 +57,24 @@ ST7789H2_Drv_t   ST7789H2_Driver =
   ST7789H2_GetXSize,
   ST7789H2_GetYSize,
 };
+
+/* Panel registers tracked in ST7789H2_Shadow_t.Valid */
+#define ST7789H2_SHADOW_MADCTL   0x01U
+#define ST7789H2_SHADOW_CASET    0x02U
+#define ST7789H2_SHADOW_RASET    0x04U
+
+/* Display to panel memory mapping, indexed by orientation */
+static const ST7789H2_Transform_t ST7789H2_Transform[4] =
+{
+  /* Portrait: MY = 0, MX = 0, MV = 0, bitmaps with MY = 1 */
+  {0x00U, 0x00U, 0xEFU,  0xEFU,  0x13FU, 0x00U, 0x80U},
+  /* Landscape: MY = 1, MX = 0, MV = 1, bitmaps with MX = 1 */
+  {0x50U, 0x00U, 0x13FU, 0xEFU,  0xEFU,  0xA0U, 0xE0U},
+  /* Portrait with 180 degrees rotation: MY = 1, MX = 1, MV = 0, bitmaps with MY = 0 */
+  {0x00U, 0x50U, 0xEFU,  0x13FU, 0xEFU,  0xC0U, 0x40U},
+  /* Landscape with 180 degrees rotation: MY = 0, MX = 1, MV = 1, bitmaps with MX = 0 */
+  {0x00U, 0x00U, 0xEFU,  0xEFU,  0xEFU,  0x60U, 0x20U}
+};
 /**
   * @}
   */
@@ -68,6 +86,10 @@ static int32_t ST7789H2_ReadRegWrap(void *handle, uint16_t Reg, uint8_t *pData,
 static int32_t ST7789H2_WriteRegWrap(void *handle, uint16_t Reg, uint8_t *pData, uint32_t Length);
 static int32_t ST7789H2_SendDataWrap(void *handle, uint8_t *pData, uint32_t Length);
 static void    ST7789H2_Delay(ST7789H2_Object_t *pObj, uint32_t Delay);
+static int32_t ST7789H2_SetRamArea(ST7789H2_Object_t *pObj, uint32_t XStart, uint32_t XEnd, uint32_t YStart, uint32_t YEnd);
+static int32_t ST7789H2_WriteColor(ST7789H2_Object_t *pObj, uint32_t Color, uint32_t Count);
+static int32_t ST7789H2_SetScrollDefinition(ST7789H2_Object_t *pObj, uint32_t Top, uint32_t Area);
+static int32_t ST7789H2_SetMadctl(ST7789H2_Object_t *pObj, uint8_t Madctl);
 /**
   * @}
   */
@@ -129,7 +151,11 @@ int32_t ST7789H2_Init(ST7789H2_Object_t *pObj, uint32_t ColorCoding, uint32_t Or
   int32_t ret = ST7789H2_OK;
   uint8_t parameter[28];
 
-  if (pObj->IsInitialized == 0U)
+  if (Orientation > ST7789H2_ORIENTATION_LANDSCAPE_ROT180)
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else if (pObj->IsInitialized == 0U)
   {
     /* Sleep In Command */
     parameter[1] = 0;
@@ -150,25 +176,12 @@ int32_t ST7789H2_Init(ST7789H2_Object_t *pObj, uint32_t ColorCoding, uint32_t Or
     /* Wait for 120ms */
     ST7789H2_Delay(pObj, 120);
 
+    /* Registers are back to their reset values */
+    (void)ST7789H2_InvalidateShadow(pObj);
+
     /* Memory access control */
-    if (Orientation == ST7789H2_ORIENTATION_PORTRAIT)
-    {
-      parameter[0] = 0x00; /* MY = 0, MX = 0, MV = 0 */
-    }
-    else if (Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
-    {
-      parameter[0] = 0xA0; /* MY = 1, MX = 0, MV = 1 */
-    }
-    else if (Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
-    {
-      parameter[0] = 0xC0; /* MY = 1, MX = 1, MV = 0 */
-    }
-    else /* Orientation == ST7789H2_ORIENTATION_LANDSCAPE_ROT180 */
-    {
-      parameter[0] = 0x60; /* MY = 0, MX = 1, MV = 1 */
-    }
-    parameter[1] = 0x00;
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    pObj->Transform = ST7789H2_Transform[Orientation];
+    ret += ST7789H2_SetMadctl(pObj, pObj->Transform.Madctl);
 
     /* Color mode 16bits/pixel */
     parameter[0] = (uint8_t) ColorCoding;
@@ -178,54 +191,9 @@ int32_t ST7789H2_Init(ST7789H2_Object_t *pObj, uint32_t ColorCoding, uint32_t Or
     parameter[0] = ST7789H2_DISPLAY_INVERSION_ON;
     ret += st7789h2_send_data(&pObj->Ctx, parameter, 1);
 
-    /* Set Column address CASET */
-    if (Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
-    {
-      parameter[0] = 0x00; /* XS[15:8] */
-      parameter[1] = 0x00;
-      parameter[2] = 0x50; /* XS[7:0] */
-      parameter[3] = 0x00;
-      parameter[4] = 0x01; /* XE[15:8] */
-      parameter[5] = 0x00;
-      parameter[6] = 0x3F; /* XE[7:0] */
-      parameter[7] = 0x00;
-    }
-    else
-    {
-      parameter[0] = 0x00; /* XS[15:8] */
-      parameter[1] = 0x00;
-      parameter[2] = 0x00; /* XS[7:0] */
-      parameter[3] = 0x00;
-      parameter[4] = 0x00; /* XE[15:8] */
-      parameter[5] = 0x00;
-      parameter[6] = 0xEF; /* XE[7:0] */
-      parameter[7] = 0x00;
-    }
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_CASET, parameter, 4);
-    /* Set Row address RASET */
-    if (Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
-    {
-      parameter[0] = 0x00; /* YS[15:8] */
-      parameter[1] = 0x00;
-      parameter[2] = 0x50; /* YS[7:0] */
-      parameter[3] = 0x00;
-      parameter[4] = 0x01; /* YE[15:8] */
-      parameter[5] = 0x00;
-      parameter[6] = 0x3F; /* YE[7:0] */
-      parameter[7] = 0x00;
-    }
-    else
-    {
-      parameter[0] = 0x00; /* YS[15:8] */
-      parameter[1] = 0x00;
-      parameter[2] = 0x00; /* YS[7:0] */
-      parameter[3] = 0x00;
-      parameter[4] = 0x00; /* YE[15:8] */
-      parameter[5] = 0x00;
-      parameter[6] = 0xEF; /* YE[7:0] */
-      parameter[7] = 0x00;
-    }
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_RASET, parameter, 4);
+    /* Set Column address CASET and Row address RASET */
+    ret += ST7789H2_SetRamArea(pObj, pObj->Transform.XOffset, pObj->Transform.XEnd,
+                               pObj->Transform.YOffset, pObj->Transform.YEnd);
 
     /*--------------- ST7789H2 Frame rate setting ----------------------------*/
     /* PORCH control setting */
@@ -351,6 +319,8 @@ int32_t ST7789H2_Init(ST7789H2_Object_t *pObj, uint32_t ColorCoding, uint32_t Or
 
     pObj->IsInitialized = 1U;
     pObj->Orientation   = Orientation;
+    pObj->ScrollTop     = 0U;
+    pObj->ScrollHeight  = 0U;
   }
 
   if (ret != ST7789H2_OK)
@@ -438,6 +408,9 @@ int32_t ST7789H2_DisplayOn(ST7789H2_Object_t *pObj)
   parameter[0] = ST7789H2_SLEEP_OUT;
   ret += st7789h2_send_data(&pObj->Ctx, parameter, 1);
 
+  /* Do not rely on register values kept during sleep */
+  (void)ST7789H2_InvalidateShadow(pObj);
+
   if (ret != ST7789H2_OK)
   {
     ret = ST7789H2_ERROR;
@@ -513,29 +486,31 @@ int32_t ST7789H2_GetBrightness(ST7789H2_Object_t *pObj, uint32_t *Brightness)
 int32_t ST7789H2_SetOrientation(ST7789H2_Object_t *pObj, uint32_t Orientation)
 {
   int32_t ret = ST7789H2_OK;
-  uint8_t   parameter[2];
 
-  /* Memory access control */
-  if (Orientation == ST7789H2_ORIENTATION_PORTRAIT)
+  if (Orientation > ST7789H2_ORIENTATION_LANDSCAPE_ROT180)
   {
-    parameter[0] = 0x00U; /* MY = 0, MX = 0, MV = 0 */
-  }
-  else if (Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
-  {
-    parameter[0] = 0xA0U; /* MY = 1, MX = 0, MV = 1 */
+    ret = ST7789H2_ERROR;
   }
-  else if (Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
+  else
   {
-    parameter[0] = 0xC0U; /* MY = 1, MX = 1, MV = 0 */
+    /* Memory access control */
+    pObj->Transform = ST7789H2_Transform[Orientation];
+    ret += ST7789H2_SetMadctl(pObj, pObj->Transform.Madctl);
+
+    /* Scroll area rows depend on the orientation, stop scrolling */
+    if (pObj->ScrollHeight != 0U)
+    {
+      ret += ST7789H2_SetScrollDefinition(pObj, 0U, ST7789H2_RAM_HEIGHT);
+      pObj->ScrollHeight = 0U;
+    }
+
+    pObj->Orientation = Orientation;
   }
-  else /* Orientation == ST7789H2_ORIENTATION_LANDSCAPE_ROT180 */
+
+  if (ret != ST7789H2_OK)
   {
-    parameter[0] = 0x60U; /* MY = 0, MX = 1, MV = 1 */
+    ret = ST7789H2_ERROR;
   }
-  parameter[1] = 0x00U;
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
-
-  pObj->Orientation = Orientation;
 
   return ret;
 }
@@ -564,58 +539,44 @@ int32_t ST7789H2_GetOrientation(ST7789H2_Object_t *pObj, uint32_t *Orientation)
   */
 int32_t ST7789H2_SetCursor(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos)
 {
-  int32_t ret = ST7789H2_OK;
-  uint8_t parameter[8];
+  int32_t ret;
 
-  /* CASET: Column Address Set */
-  if (pObj->Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
-  {
-    parameter[0] = (uint8_t)((Xpos + 0x50U) >> 8);  /* XS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t)(Xpos + 0x50U);         /* XS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x01;                            /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0x3F;                            /* XE[7:0] */
-    parameter[7] = 0x00;
-  }
-  else
+  ret  = ST7789H2_SetMadctl(pObj, pObj->Transform.Madctl);
+  ret += ST7789H2_SetRamArea(pObj, (Xpos + pObj->Transform.XOffset), pObj->Transform.XEnd,
+                             (Ypos + pObj->Transform.YOffset), pObj->Transform.YEnd);
+
+  if (ret != ST7789H2_OK)
   {
-    parameter[0] = (uint8_t)(Xpos >> 8);  /* XS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t) Xpos;        /* XS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x00;                  /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0xEF;                  /* XE[7:0] */
-    parameter[7] = 0x00;
+    ret = ST7789H2_ERROR;
   }
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_CASET, parameter, 4);
 
-  /* RASET: Row Address Set */
-  if (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
+  return ret;
+}
+
+/**
+  * @brief  Set the display window filled by ST7789H2_WritePixels().
+  * @param  pObj Pointer to component object.
+  * @param  Xpos X position on LCD.
+  * @param  Ypos Y position on LCD.
+  * @param  Width Width of the window.
+  * @param  Height Height of the window.
+  * @retval Component status.
+  */
+int32_t ST7789H2_SetWindow(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t  ret;
+  uint32_t xstart = Xpos + pObj->Transform.XOffset;
+  uint32_t ystart = Ypos + pObj->Transform.YOffset;
+
+  if ((Width == 0U) || (Height == 0U))
   {
-    parameter[0] = (uint8_t)((Ypos + 0x50U) >> 8);  /* YS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t)(Ypos + 0x50U);         /* YS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x01;                            /* YE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0x3F;                            /* YE[7:0] */
-    parameter[7] = 0x00;
+    ret = ST7789H2_ERROR;
   }
   else
   {
-    parameter[0] = (uint8_t)(Ypos >> 8);  /* YS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t) Ypos;        /* YS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x00;                  /* YE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0xEF;                  /* YE[7:0] */
-    parameter[7] = 0x00;
+    ret  = ST7789H2_SetMadctl(pObj, pObj->Transform.Madctl);
+    ret += ST7789H2_SetRamArea(pObj, xstart, (xstart + Width - 1U), ystart, (ystart + Height - 1U));
   }
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_RASET, parameter, 4);
 
   if (ret != ST7789H2_OK)
   {
@@ -626,163 +587,167 @@ int32_t ST7789H2_SetCursor(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos
 }
 
 /**
-  * @brief  Display a bitmap picture.
+  * @brief  Write pixels in the window set by ST7789H2_SetWindow().
+  *         Successive calls continue where the previous one stopped.
   * @param  pObj Pointer to component object.
-  * @param  Xpos X position on LCD.
-  * @param  Ypos Y position on LCD.
-  * @param  pBmp Pointer to bitmap.
+  * @param  pData Pointer on RGB565 pixels buffer.
+  * @param  Length Number of pixels.
   * @retval Component status.
   */
-int32_t ST7789H2_DrawBitmap(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+int32_t ST7789H2_WritePixels(ST7789H2_Object_t *pObj, uint8_t *pData, uint32_t Length)
 {
-  int32_t  ret = ST7789H2_OK;
-  uint8_t  parameter[8];
-  uint32_t index, size;
-  uint32_t width, height;
-  uint32_t Ystart, Ystop;
-
-  /* Read file size */
-  size = ((uint32_t)pBmp[5] << 24) | ((uint32_t)pBmp[4] << 16) | ((uint32_t)pBmp[3] << 8) | (uint32_t)pBmp[2];
-  /* Get bitmap data address offset */
-  index = ((uint32_t)pBmp[13] << 24) | ((uint32_t)pBmp[12] << 16) | ((uint32_t)pBmp[11] << 8) | (uint32_t)pBmp[10];
-  /* Get image width */
-  width = ((uint32_t)pBmp[21] << 24) | ((uint32_t)pBmp[20] << 16) | ((uint32_t)pBmp[19] << 8) | (uint32_t)pBmp[18];
-  width--;
-  /* Get image height */
-  height = ((uint32_t)pBmp[25] << 24) | ((uint32_t)pBmp[24] << 16) | ((uint32_t)pBmp[23] << 8) | (uint32_t)pBmp[22];
-  height--;
-  /* Get size of data */
-  size = size - index;
-  size = size / 2U;
+  int32_t ret = ST7789H2_OK;
 
-  /* Compute new Y start and stop values */
-  if (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT)
+  if (Length != 0U)
   {
-    Ystart = 319U - (Ypos + height);
-    Ystop  = 319U - Ypos;
-  }
-  else if (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
-  {
-    Ystart = 319U - (Ypos + 0x50U + height);
-    Ystop  = 319U - (Ypos + 0x50U);
+    if (pObj->IsRamWriteStarted == 0U)
+    {
+      /* Memory write restarts at the beginning of the window */
+      ret = st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM, pData, Length);
+      pObj->IsRamWriteStarted = 1U;
+    }
+    else
+    {
+      ret = st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM_CONTINUE, pData, Length);
+    }
   }
-  else
+
+  if (ret != ST7789H2_OK)
   {
-    Ystart = 239U - (Ypos + height);
-    Ystop  = 239U - Ypos;
+    ret = ST7789H2_ERROR;
   }
 
-  /* Set GRAM Area - Partial Display Control */
-  if (pObj->Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
+  return ret;
+}
+
+/**
+  * @brief  Define the vertical scroll area.
+  * @note   Hardware scrolling moves the panel rows, it is only available in
+  *         portrait orientations. The scroll area is reset by
+  *         ST7789H2_SetOrientation().
+  * @param  pObj Pointer to component object.
+  * @param  Ypos First row of the scroll area.
+  * @param  Height Number of rows of the scroll area, 0 to stop scrolling.
+  * @retval Component status.
+  */
+int32_t ST7789H2_SetScrollArea(ST7789H2_Object_t *pObj, uint32_t Ypos, uint32_t Height)
+{
+  int32_t  ret = ST7789H2_OK;
+  uint32_t top, area;
+
+  if (((pObj->Orientation != ST7789H2_ORIENTATION_PORTRAIT) && (pObj->Orientation != ST7789H2_ORIENTATION_PORTRAIT_ROT180)) ||
+      ((Ypos + Height) > ST7789H2_HEIGHT))
   {
-    parameter[0] = (uint8_t)((Xpos + 0x50U) >> 8);          /* XS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t)(Xpos + 0x50U);                 /* XS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = (uint8_t)((Xpos + width + 0x50U) >> 8);  /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = (uint8_t)(Xpos + width + 0x50U);         /* XE[7:0] */
-    parameter[7] = 0x00;
+    ret = ST7789H2_ERROR;
   }
   else
   {
-    parameter[0] = (uint8_t)(Xpos >> 8);            /* XS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = (uint8_t) Xpos;                  /* XS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = (uint8_t)((Xpos + width) >> 8);  /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = (uint8_t)(Xpos + width);         /* XE[7:0] */
-    parameter[7] = 0x00;
-  }
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_CASET, parameter, 4);
-  parameter[0] = (uint8_t)(Ystart >> 8);  /* YS[15:8] */
-  parameter[1] = 0x00;
-  parameter[2] = (uint8_t) Ystart;        /* YS[7:0] */
-  parameter[3] = 0x00;
-  parameter[4] = (uint8_t)(Ystop >> 8);   /* YE[15:8] */
-  parameter[5] = 0x00;
-  parameter[6] = (uint8_t) Ystop;         /* YE[7:0] */
-  parameter[7] = 0x00;
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_RASET, parameter, 4);
-  if ((pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT) || (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180))
-  {
-    /* Memory access control: Invert MY */
-    parameter[0] = (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT) ? 0x80U : 0x40U;
-    parameter[1] = 0x00U;
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    if (Height == 0U)
+    {
+      /* Whole panel memory scrolled by 0 lines */
+      top  = 0U;
+      area = ST7789H2_RAM_HEIGHT;
+    }
+    else if (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT)
+    {
+      top  = Ypos;
+      area = Height;
+    }
+    else
+    {
+      /* Rows are mirrored in panel memory: row Y is memory line 239 - Y */
+      top  = ST7789H2_HEIGHT - (Ypos + Height);
+      area = Height;
+    }
+    ret = ST7789H2_SetScrollDefinition(pObj, top, area);
+
+    pObj->ScrollTop    = top;
+    pObj->ScrollHeight = Height;
   }
-  else
+
+  if (ret != ST7789H2_OK)
   {
-    /* Memory access control: Invert MX */
-    parameter[0] = (pObj->Orientation == ST7789H2_ORIENTATION_LANDSCAPE) ? 0xE0U : 0x20U;
-    parameter[1] = 0x00U;
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    ret = ST7789H2_ERROR;
   }
 
-  /* Write GRAM */
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM, &pBmp[index], size);
+  return ret;
+}
+
+/**
+  * @brief  Scroll the area defined by ST7789H2_SetScrollArea().
+  * @param  pObj Pointer to component object.
+  * @param  Line Row of the scroll area, relative to its first row, displayed
+  *         on its first row. Rows above it are displayed after the last one.
+  * @retval Component status.
+  */
+int32_t ST7789H2_SetScrollStart(ST7789H2_Object_t *pObj, uint32_t Line)
+{
+  int32_t  ret = ST7789H2_OK;
+  uint8_t  parameter[4];
+  uint32_t start;
 
-  /* Restore GRAM Area - Partial Display Control */
-  if (pObj->Orientation == ST7789H2_ORIENTATION_LANDSCAPE)
+  if ((pObj->ScrollHeight == 0U) || (Line >= pObj->ScrollHeight))
   {
-    parameter[0] = 0x00; /* XS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = 0x50; /* XS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x01; /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0x3F; /* XE[7:0] */
-    parameter[7] = 0x00;
+    ret = ST7789H2_ERROR;
   }
   else
   {
-    parameter[0] = 0x00; /* XS[15:8] */
+    if ((pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180) && (Line != 0U))
+    {
+      /* Mirrored rows scroll the other way */
+      start = pObj->ScrollTop + (pObj->ScrollHeight - Line);
+    }
+    else
+    {
+      start = pObj->ScrollTop + Line;
+    }
+
+    /* VSCSAD: Vertical Scroll Start Address of RAM */
+    parameter[0] = (uint8_t)(start >> 8);  /* VSP[15:8] */
     parameter[1] = 0x00;
-    parameter[2] = 0x00; /* XS[7:0] */
+    parameter[2] = (uint8_t) start;        /* VSP[7:0] */
     parameter[3] = 0x00;
-    parameter[4] = 0x00; /* XE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0xEF; /* XE[7:0] */
-    parameter[7] = 0x00;
+    ret = st7789h2_write_reg(&pObj->Ctx, ST7789H2_VSCSAD, parameter, 2);
   }
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_CASET, parameter, 4);
-  if (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180)
+
+  if (ret != ST7789H2_OK)
   {
-    parameter[0] = 0x00; /* YS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = 0x50; /* YS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x01; /* YE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0x3F; /* YE[7:0] */
-    parameter[7] = 0x00;
+    ret = ST7789H2_ERROR;
   }
-  else
+
+  return ret;
+}
+
+/**
+  * @brief  Set the tearing effect output line.
+  * @note   With ST7789H2_TE_VBLANK the rising edge of the TE line marks the
+  *         beginning of the vertical blanking.
+  * @param  pObj Pointer to component object.
+  * @param  Mode ST7789H2_TE_OFF, ST7789H2_TE_VBLANK or ST7789H2_TE_VHBLANK.
+  * @retval Component status.
+  */
+int32_t ST7789H2_SetTearingEffect(ST7789H2_Object_t *pObj, uint32_t Mode)
+{
+  int32_t ret;
+  uint8_t parameter[2];
+
+  if (Mode == ST7789H2_TE_OFF)
   {
-    parameter[0] = 0x00; /* YS[15:8] */
-    parameter[1] = 0x00;
-    parameter[2] = 0x00; /* YS[7:0] */
-    parameter[3] = 0x00;
-    parameter[4] = 0x00; /* YE[15:8] */
-    parameter[5] = 0x00;
-    parameter[6] = 0xEF; /* YE[7:0] */
-    parameter[7] = 0x00;
+    /* Tearing Effect Line Off */
+    parameter[0] = ST7789H2_TE_LINE_OFF;
+    parameter[1] = 0x00U;
+    ret = st7789h2_send_data(&pObj->Ctx, parameter, 1);
   }
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_RASET, parameter, 4);
-  if ((pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT) || (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT_ROT180))
+  else if ((Mode == ST7789H2_TE_VBLANK) || (Mode == ST7789H2_TE_VHBLANK))
   {
-    /* Memory access control: Re-invert MY */
-    parameter[0] = (pObj->Orientation == ST7789H2_ORIENTATION_PORTRAIT) ? 0x00U : 0xC0U;
+    /* Tearing Effect Line On: TEM = 0 for V-blanking only, 1 for V and H-blanking */
+    parameter[0] = (uint8_t)((Mode == ST7789H2_TE_VBLANK) ? 0x00U : 0x01U);
     parameter[1] = 0x00U;
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    ret = st7789h2_write_reg(&pObj->Ctx, ST7789H2_TE_LINE_ON, parameter, 1);
   }
   else
   {
-    /* Memory access control: Re-invert MX */
-    parameter[0] = (pObj->Orientation == ST7789H2_ORIENTATION_LANDSCAPE) ? 0xA0U : 0x60U;
-    parameter[1] = 0x00U;
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    ret = ST7789H2_ERROR;
   }
 
   if (ret != ST7789H2_OK)
@@ -794,41 +759,76 @@ int32_t ST7789H2_DrawBitmap(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypo
 }
 
 /**
-  * @brief  Fill rectangle with RGB buffer.
+  * @brief  Forget the register values known by the driver, the next register
+  *         writes are all sent to the panel.
+  * @note   Call it when the panel is reset or written outside of the driver.
+  * @param  pObj Pointer to component object.
+  * @retval Component status.
+  */
+int32_t ST7789H2_InvalidateShadow(ST7789H2_Object_t *pObj)
+{
+  pObj->Shadow.Valid = 0U;
+
+  return ST7789H2_OK;
+}
+
+/**
+  * @brief  Get the number of register writes sent and skipped since the
+  *         component object was cleared.
+  * @param  pObj   Pointer to component object.
+  * @param  pStats Pointer to the register writes counters.
+  * @retval Component status.
+  */
+int32_t ST7789H2_GetShadowStats(ST7789H2_Object_t *pObj, ST7789H2_ShadowStats_t *pStats)
+{
+  *pStats = pObj->Shadow.Stats;
+
+  return ST7789H2_OK;
+}
+
+/**
+  * @brief  Display a bitmap picture.
   * @param  pObj Pointer to component object.
   * @param  Xpos X position on LCD.
   * @param  Ypos Y position on LCD.
-  * @param  pData Pointer on RGB pixels buffer.
-  * @param  Width Width of the rectangle.
-  * @param  Height Height of the rectangle.
+  * @param  pBmp Pointer to bitmap.
   * @retval Component status.
   */
-int32_t ST7789H2_FillRGBRect(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+int32_t ST7789H2_DrawBitmap(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
 {
   int32_t  ret = ST7789H2_OK;
-  uint8_t  buffer[480];
-  uint8_t *rect; 
-  uint32_t i, j;
+  uint32_t index, size;
+  uint32_t width, height;
+  uint32_t Xstart, Ystart;
 
-  rect = pData;
-  
-  for(i = 0; i < Height; i++)
-  {
-    /* Set Cursor */
-    ret += ST7789H2_SetCursor(pObj, Xpos, Ypos + i);
+  /* Read file size */
+  size = ((uint32_t)pBmp[5] << 24) | ((uint32_t)pBmp[4] << 16) | ((uint32_t)pBmp[3] << 8) | (uint32_t)pBmp[2];
+  /* Get bitmap data address offset */
+  index = ((uint32_t)pBmp[13] << 24) | ((uint32_t)pBmp[12] << 16) | ((uint32_t)pBmp[11] << 8) | (uint32_t)pBmp[10];
+  /* Get image width */
+  width = ((uint32_t)pBmp[21] << 24) | ((uint32_t)pBmp[20] << 16) | ((uint32_t)pBmp[19] << 8) | (uint32_t)pBmp[18];
+  width--;
+  /* Get image height */
+  height = ((uint32_t)pBmp[25] << 24) | ((uint32_t)pBmp[24] << 16) | ((uint32_t)pBmp[23] << 8) | (uint32_t)pBmp[22];
+  height--;
+  /* Get size of data */
+  size = size - index;
+  size = size / 2U;
 
-    /* Sent a complete line */
-    for(j = 0; j < Width; j++)
-    {
-      buffer[2U*j]      = *rect;
-      rect++;
-      buffer[(2U*j)+1U] = *rect;
-      rect++;
-    }
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM, buffer, Width);
-  }
+  /* Bitmap rows are stored bottom-up: write them with the row order inverted */
+  Xstart = Xpos + pObj->Transform.XOffset;
+  Ystart = pObj->Transform.BitmapYBase - (Ypos + height);
+
+  /* Set GRAM Area - Partial Display Control */
+  ret += ST7789H2_SetRamArea(pObj, Xstart, (Xstart + width), Ystart, (Ystart + height));
 
-  if(ret != ST7789H2_OK)
+  /* Memory access control: kept until the next drawing needs the default one */
+  ret += ST7789H2_SetMadctl(pObj, pObj->Transform.BitmapMadctl);
+
+  /* Write GRAM */
+  ret += ST7789H2_WritePixels(pObj, &pBmp[index], size);
+
+  if (ret != ST7789H2_OK)
   {
     ret = ST7789H2_ERROR;
   }
@@ -837,40 +837,26 @@ int32_t ST7789H2_FillRGBRect(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Yp
 }
 
 /**
-  * @brief  Display a horizontal line.
+  * @brief  Fill rectangle with RGB buffer.
   * @param  pObj Pointer to component object.
   * @param  Xpos X position on LCD.
   * @param  Ypos Y position on LCD.
-  * @param  Length Length of the line.
-  * @param  Color  Color of the line.
+  * @param  pData Pointer on RGB pixels buffer.
+  * @param  Width Width of the rectangle.
+  * @param  Height Height of the rectangle.
   * @retval Component status.
   */
-int32_t ST7789H2_DrawHLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+int32_t ST7789H2_FillRGBRect(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
 {
-  int32_t  ret = ST7789H2_OK;
-  uint8_t  parameter[2];
-  uint32_t i;
-
-  /* Set Cursor */
-  ret += ST7789H2_SetCursor(pObj, Xpos, Ypos);
+  int32_t ret = ST7789H2_OK;
 
-  /* Sent a complete line */
-  parameter[0] = (uint8_t)(Color & 0xFFU);
-  parameter[1] = (uint8_t)((Color >> 8) & 0xFFU);
-  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM, parameter, 1);
-  for (i = 1; i < Length; i++)
+  if ((Width != 0U) && (Height != 0U))
   {
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM_CONTINUE, parameter, 1);
+    /* Send the whole rectangle in a single window */
+    ret += ST7789H2_SetWindow(pObj, Xpos, Ypos, Width, Height);
+    ret += ST7789H2_WritePixels(pObj, pData, (Width * Height));
   }
 
-  /* Workaround for last pixel */
-  if ((Xpos + Length) == 240U)
-  {
-    /* Write last pixel */
-    ret += ST7789H2_SetCursor(pObj, (Xpos + Length - 1U), Ypos);
-    ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_WRITE_RAM, parameter, 1);
-  }
-  
   if (ret != ST7789H2_OK)
   {
     ret = ST7789H2_ERROR;
@@ -879,6 +865,20 @@ int32_t ST7789H2_DrawHLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos
   return ret;
 }
 
+/**
+  * @brief  Display a horizontal line.
+  * @param  pObj Pointer to component object.
+  * @param  Xpos X position on LCD.
+  * @param  Ypos Y position on LCD.
+  * @param  Length Length of the line.
+  * @param  Color  Color of the line.
+  * @retval Component status.
+  */
+int32_t ST7789H2_DrawHLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return ST7789H2_FillRect(pObj, Xpos, Ypos, Length, 1U, Color);
+}
+
 /**
   * @brief  Display a vertical line.
   * @param  pObj Pointer to component object.
@@ -890,21 +890,7 @@ int32_t ST7789H2_DrawHLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos
   */
 int32_t ST7789H2_DrawVLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
 {
-  int32_t  ret = ST7789H2_OK;
-  uint32_t i;
-
-  /* Sent a complete line */
-  for (i = 0; i < Length; i++)
-  {
-    ret += ST7789H2_SetPixel(pObj, Xpos, (Ypos + i), Color);
-  }
-
-  if (ret != ST7789H2_OK)
-  {
-    ret = ST7789H2_ERROR;
-  }
-
-  return ret;
+  return ST7789H2_FillRect(pObj, Xpos, Ypos, 1U, Length, Color);
 }
 
 /**
@@ -919,16 +905,18 @@ int32_t ST7789H2_DrawVLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos
   */
 int32_t ST7789H2_FillRect(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
 {
-  int32_t  ret = ST7789H2_OK;
-  uint32_t i;
+  int32_t ret = ST7789H2_OK;
 
-  for (i = 0U; i < Height; i++)
+  if ((Width != 0U) && (Height != 0U))
   {
-    if (ST7789H2_DrawHLine(pObj, Xpos, (i + Ypos), Width, Color) != ST7789H2_OK)
-    {
-      ret = ST7789H2_ERROR;
-      break;
-    }
+    /* Send the whole rectangle in a single window */
+    ret += ST7789H2_SetWindow(pObj, Xpos, Ypos, Width, Height);
+    ret += ST7789H2_WriteColor(pObj, Color, (Width * Height));
+  }
+
+  if (ret != ST7789H2_OK)
+  {
+    ret = ST7789H2_ERROR;
   }
 
   return ret;
@@ -1002,7 +990,7 @@ int32_t ST7789H2_GetXSize(ST7789H2_Object_t *pObj, uint32_t *XSize)
 {
   (void)pObj;
 
-  *XSize = 240;
+  *XSize = ST7789H2_WIDTH;
 
   return ST7789H2_OK;
 }
@@ -1017,7 +1005,7 @@ int32_t ST7789H2_GetYSize(ST7789H2_Object_t *pObj, uint32_t *YSize)
 {
   (void)pObj;
 
-  *YSize = 240;
+  *YSize = ST7789H2_HEIGHT;
 
   return ST7789H2_OK;
 }
@@ -1085,6 +1073,192 @@ static void ST7789H2_Delay(ST7789H2_Object_t *pObj, uint32_t Delay)
   {
   }
 }
+
+/**
+  * @brief  Set the panel memory area written by the next memory write.
+  *         The column and row address writes already held by the panel are
+  *         skipped: the memory write restarts at the area start anyway.
+  * @param  pObj   Pointer to component object.
+  * @param  XStart First column in panel memory.
+  * @param  XEnd   Last column in panel memory.
+  * @param  YStart First row in panel memory.
+  * @param  YEnd   Last row in panel memory.
+  * @retval Component status.
+  */
+static int32_t ST7789H2_SetRamArea(ST7789H2_Object_t *pObj, uint32_t XStart, uint32_t XEnd, uint32_t YStart, uint32_t YEnd)
+{
+  int32_t ret = ST7789H2_OK;
+  uint8_t parameter[8];
+
+  /* CASET: Column Address Set */
+  if (((pObj->Shadow.Valid & ST7789H2_SHADOW_CASET) == 0U) ||
+      (pObj->Shadow.XStart != XStart) || (pObj->Shadow.XEnd != XEnd))
+  {
+    parameter[0] = (uint8_t)(XStart >> 8);  /* XS[15:8] */
+    parameter[1] = 0x00;
+    parameter[2] = (uint8_t) XStart;        /* XS[7:0] */
+    parameter[3] = 0x00;
+    parameter[4] = (uint8_t)(XEnd >> 8);    /* XE[15:8] */
+    parameter[5] = 0x00;
+    parameter[6] = (uint8_t) XEnd;          /* XE[7:0] */
+    parameter[7] = 0x00;
+    if (st7789h2_write_reg(&pObj->Ctx, ST7789H2_CASET, parameter, 4) == ST7789H2_OK)
+    {
+      pObj->Shadow.XStart = XStart;
+      pObj->Shadow.XEnd   = XEnd;
+      pObj->Shadow.Valid |= ST7789H2_SHADOW_CASET;
+    }
+    else
+    {
+      pObj->Shadow.Valid &= ~ST7789H2_SHADOW_CASET;
+      ret = ST7789H2_ERROR;
+    }
+    pObj->Shadow.Stats.Sent++;
+  }
+  else
+  {
+    pObj->Shadow.Stats.Skipped++;
+  }
+
+  /* RASET: Row Address Set */
+  if (((pObj->Shadow.Valid & ST7789H2_SHADOW_RASET) == 0U) ||
+      (pObj->Shadow.YStart != YStart) || (pObj->Shadow.YEnd != YEnd))
+  {
+    parameter[0] = (uint8_t)(YStart >> 8);  /* YS[15:8] */
+    parameter[1] = 0x00;
+    parameter[2] = (uint8_t) YStart;        /* YS[7:0] */
+    parameter[3] = 0x00;
+    parameter[4] = (uint8_t)(YEnd >> 8);    /* YE[15:8] */
+    parameter[5] = 0x00;
+    parameter[6] = (uint8_t) YEnd;          /* YE[7:0] */
+    parameter[7] = 0x00;
+    if (st7789h2_write_reg(&pObj->Ctx, ST7789H2_RASET, parameter, 4) == ST7789H2_OK)
+    {
+      pObj->Shadow.YStart = YStart;
+      pObj->Shadow.YEnd   = YEnd;
+      pObj->Shadow.Valid |= ST7789H2_SHADOW_RASET;
+    }
+    else
+    {
+      pObj->Shadow.Valid &= ~ST7789H2_SHADOW_RASET;
+      ret = ST7789H2_ERROR;
+    }
+    pObj->Shadow.Stats.Sent++;
+  }
+  else
+  {
+    pObj->Shadow.Stats.Skipped++;
+  }
+
+  /* Next memory write starts at the beginning of the area */
+  pObj->IsRamWriteStarted = 0U;
+
+  return ret;
+}
+
+/**
+  * @brief  Set the vertical scroll area in panel memory lines, displayed
+  *         from its first line.
+  * @param  pObj Pointer to component object.
+  * @param  Top  First memory line of the scroll area.
+  * @param  Area Number of memory lines of the scroll area.
+  * @retval Component status.
+  */
+static int32_t ST7789H2_SetScrollDefinition(ST7789H2_Object_t *pObj, uint32_t Top, uint32_t Area)
+{
+  int32_t  ret = ST7789H2_OK;
+  uint8_t  parameter[12];
+  uint32_t bottom = ST7789H2_RAM_HEIGHT - (Top + Area);
+
+  /* VSCRDEF: Vertical Scrolling Definition */
+  parameter[0]  = (uint8_t)(Top >> 8);     /* TFA[15:8] */
+  parameter[1]  = 0x00;
+  parameter[2]  = (uint8_t) Top;           /* TFA[7:0] */
+  parameter[3]  = 0x00;
+  parameter[4]  = (uint8_t)(Area >> 8);    /* VSA[15:8] */
+  parameter[5]  = 0x00;
+  parameter[6]  = (uint8_t) Area;          /* VSA[7:0] */
+  parameter[7]  = 0x00;
+  parameter[8]  = (uint8_t)(bottom >> 8);  /* BFA[15:8] */
+  parameter[9]  = 0x00;
+  parameter[10] = (uint8_t) bottom;        /* BFA[7:0] */
+  parameter[11] = 0x00;
+  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_VSCRDEF, parameter, 6);
+
+  /* VSCSAD: Vertical Scroll Start Address of RAM */
+  parameter[0] = (uint8_t)(Top >> 8);      /* VSP[15:8] */
+  parameter[1] = 0x00;
+  parameter[2] = (uint8_t) Top;            /* VSP[7:0] */
+  parameter[3] = 0x00;
+  ret += st7789h2_write_reg(&pObj->Ctx, ST7789H2_VSCSAD, parameter, 2);
+
+  return ret;
+}
+
+/**
+  * @brief  Set the memory access control, unless already set.
+  * @param  pObj   Pointer to component object.
+  * @param  Madctl Memory access control value.
+  * @retval Component status.
+  */
+static int32_t ST7789H2_SetMadctl(ST7789H2_Object_t *pObj, uint8_t Madctl)
+{
+  int32_t ret = ST7789H2_OK;
+  uint8_t parameter[2];
+
+  if (((pObj->Shadow.Valid & ST7789H2_SHADOW_MADCTL) == 0U) || (pObj->Shadow.Madctl != Madctl))
+  {
+    parameter[0] = Madctl;
+    parameter[1] = 0x00U;
+    ret = st7789h2_write_reg(&pObj->Ctx, ST7789H2_MADCTL, parameter, 1);
+    if (ret == ST7789H2_OK)
+    {
+      pObj->Shadow.Madctl = Madctl;
+      pObj->Shadow.Valid |= ST7789H2_SHADOW_MADCTL;
+    }
+    else
+    {
+      pObj->Shadow.Valid &= ~ST7789H2_SHADOW_MADCTL;
+    }
+    pObj->Shadow.Stats.Sent++;
+  }
+  else
+  {
+    pObj->Shadow.Stats.Skipped++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write pixels of the same color in the current window.
+  * @param  pObj  Pointer to component object.
+  * @param  Color RGB565 color.
+  * @param  Count Number of pixels.
+  * @retval Component status.
+  */
+static int32_t ST7789H2_WriteColor(ST7789H2_Object_t *pObj, uint32_t Color, uint32_t Count)
+{
+  int32_t  ret = ST7789H2_OK;
+  uint8_t  buffer[2U * ST7789H2_WRITE_CHUNK_SIZE];
+  uint32_t i, size;
+
+  size = (Count < ST7789H2_WRITE_CHUNK_SIZE) ? Count : ST7789H2_WRITE_CHUNK_SIZE;
+  for (i = 0U; i < size; i++)
+  {
+    buffer[2U * i]        = (uint8_t)(Color & 0xFFU);
+    buffer[(2U * i) + 1U] = (uint8_t)((Color >> 8) & 0xFFU);
+  }
+
+  while ((Count != 0U) && (ret == ST7789H2_OK))
+  {
+    size   = (Count < ST7789H2_WRITE_CHUNK_SIZE) ? Count : ST7789H2_WRITE_CHUNK_SIZE;
+    ret    = ST7789H2_WritePixels(pObj, buffer, size);
+    Count -= size;
+  }
+
+  return ret;
+}
 /**
   * @}
   */
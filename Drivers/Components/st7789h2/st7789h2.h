@@ -64,12 +64,45 @@ typedef struct
   ST7789H2_GetTick_Func       GetTick;
 } ST7789H2_IO_t;
 
+typedef struct
+{
+  uint32_t              XOffset;        /* Panel memory column of display column 0       */
+  uint32_t              YOffset;        /* Panel memory row of display row 0             */
+  uint32_t              XEnd;           /* Panel memory column of the last display column */
+  uint32_t              YEnd;           /* Panel memory row of the last display row       */
+  uint32_t              BitmapYBase;    /* Bitmap row Y is panel memory row BitmapYBase - Y */
+  uint8_t               Madctl;         /* Memory access control for drawing             */
+  uint8_t               BitmapMadctl;   /* Memory access control for bottom-up bitmaps   */
+} ST7789H2_Transform_t;
+
+typedef struct
+{
+  uint32_t              Sent;           /* Register writes sent to the panel           */
+  uint32_t              Skipped;        /* Register writes skipped, value already held */
+} ST7789H2_ShadowStats_t;
+
+typedef struct
+{
+  uint32_t              Valid;          /* Registers holding a known value              */
+  uint8_t               Madctl;         /* Memory access control                       */
+  uint32_t              XStart;         /* Column address set: first column            */
+  uint32_t              XEnd;           /* Column address set: last column             */
+  uint32_t              YStart;         /* Row address set: first row                  */
+  uint32_t              YEnd;           /* Row address set: last row                   */
+  ST7789H2_ShadowStats_t Stats;
+} ST7789H2_Shadow_t;
+
 typedef struct
 {
   ST7789H2_IO_t         IO;
   ST7789H2_ctx_t        Ctx;
   uint8_t               IsInitialized;
   uint32_t              Orientation;
+  uint8_t               IsRamWriteStarted;
+  uint32_t              ScrollTop;     /* First panel memory line of the scroll area */
+  uint32_t              ScrollHeight;  /* Rows of the scroll area, 0 when not scrolling */
+  ST7789H2_Transform_t  Transform;     /* Display to panel memory mapping of the orientation */
+  ST7789H2_Shadow_t     Shadow;        /* Last values written to the panel registers */
 } ST7789H2_Object_t;
 
 typedef struct
@@ -118,6 +151,15 @@ typedef struct
 #define ST7789H2_FORMAT_RBG444                0x03U /* Pixel format chosen is RGB444 : 12 bpp (currently not supported)  */
 #define ST7789H2_FORMAT_RBG565                0x05U /* Pixel format chosen is RGB565 : 16 bpp */
 #define ST7789H2_FORMAT_RBG666                0x06U /* Pixel format chosen is RGB666 : 18 bpp (currently not supported)  */
+
+#define ST7789H2_WIDTH                        240U  /* Display width in pixels  */
+#define ST7789H2_HEIGHT                       240U  /* Display height in pixels */
+#define ST7789H2_WRITE_CHUNK_SIZE             240U  /* Pixels of a solid color sent per memory write */
+#define ST7789H2_RAM_HEIGHT                   320U  /* Panel memory lines */
+
+#define ST7789H2_TE_OFF                       0x00U /* Tearing effect output off */
+#define ST7789H2_TE_VBLANK                    0x01U /* Tearing effect output high during vertical blanking */
+#define ST7789H2_TE_VHBLANK                   0x02U /* Tearing effect output high during vertical and horizontal blanking */
 /**
   * @}
   */
@@ -144,6 +186,13 @@ int32_t ST7789H2_GetBrightness(ST7789H2_Object_t *pObj, uint32_t *Brightness);
 int32_t ST7789H2_SetOrientation(ST7789H2_Object_t *pObj, uint32_t Orientation);
 int32_t ST7789H2_GetOrientation(ST7789H2_Object_t *pObj, uint32_t *Orientation);
 int32_t ST7789H2_SetCursor(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos);
+int32_t ST7789H2_SetWindow(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t ST7789H2_WritePixels(ST7789H2_Object_t *pObj, uint8_t *pData, uint32_t Length);
+int32_t ST7789H2_SetScrollArea(ST7789H2_Object_t *pObj, uint32_t Ypos, uint32_t Height);
+int32_t ST7789H2_SetScrollStart(ST7789H2_Object_t *pObj, uint32_t Line);
+int32_t ST7789H2_SetTearingEffect(ST7789H2_Object_t *pObj, uint32_t Mode);
+int32_t ST7789H2_InvalidateShadow(ST7789H2_Object_t *pObj);
+int32_t ST7789H2_GetShadowStats(ST7789H2_Object_t *pObj, ST7789H2_ShadowStats_t *pStats);
 int32_t ST7789H2_DrawBitmap(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
 int32_t ST7789H2_FillRGBRect(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
 int32_t ST7789H2_DrawHLine(ST7789H2_Object_t *pObj, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
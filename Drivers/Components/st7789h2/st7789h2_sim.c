@@ -0,0 +1,576 @@
+/**
+  ******************************************************************************
+  * @file    st7789h2_sim.c
+  * @author  MCD Application Team
+  * @brief   This file includes a simulated bus for the ST7789H2 LCD driver,
+  *          modeling the panel memory so that the driver and the LCD
+  *          utilities can be run on a host.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This file is meant for host builds. ST7789H2_SIM_Init() fills a
+     ST7789H2_IO_t structure with simulated bus services, to be registered
+     with ST7789H2_RegisterBusIO() in place of the FMC ones:
+         ST7789H2_SIM_Init(&io);
+         ST7789H2_RegisterBusIO(&obj, &io);
+         ST7789H2_Init(&obj, ST7789H2_FORMAT_RBG565, Orientation);
+
+   - The bus is 16-bit wide as on the board: WriteReg() sends a command word
+     followed by data words, register parameters being in the low byte of
+     each data word; SendData() sends command words only. The simulated
+     panel interprets CASET, RASET, MADCTL (MY, MX and MV bits), RAMWR,
+     RAMWRC, RAMRD, VSCRDEF, VSCSAD and RDID1. The 240x320 panel memory is
+     displayed through the 240x240 panel, vertical scrolling applied. The
+     simulated tick advances by 1 ms on each GetTick() call, so that driver
+     delays return.
+
+   - ST7789H2_SIM_GetStats() reports the bus traffic: command and data words,
+     bytes, pixels written and, per command code, the number of commands
+     and bytes.
+
+   - ST7789H2_SIM_GetImage() copies the displayed image in RGB565, as seen on
+     the panel in its portrait orientation. ST7789H2_SIM_DumpPPM() writes it
+     in a binary PPM file, e.g. for golden image comparisons.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "st7789h2_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup Components
+  * @{
+  */
+
+/** @addtogroup ST7789H2
+  * @{
+  */
+
+/** @defgroup ST7789H2_SIM_Private_Defines ST7789H2_SIM Private Defines
+  * @{
+  */
+/* MADCTL bits */
+#define SIM_MADCTL_MY        0x80U  /* Row address order    */
+#define SIM_MADCTL_MX        0x40U  /* Column address order */
+#define SIM_MADCTL_MV        0x20U  /* Row/column exchange  */
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Private_Types ST7789H2_SIM Private Types
+  * @{
+  */
+typedef struct
+{
+  uint16_t              Ram[ST7789H2_RAM_HEIGHT][ST7789H2_SIM_RAM_WIDTH];
+  uint32_t              Madctl;
+  uint32_t              XStart;     /* CASET */
+  uint32_t              XEnd;
+  uint32_t              YStart;     /* RASET */
+  uint32_t              YEnd;
+  uint32_t              Column;     /* Memory access counters */
+  uint32_t              Row;
+  uint32_t              ScrollTop;  /* VSCRDEF TFA */
+  uint32_t              ScrollArea; /* VSCRDEF VSA */
+  uint32_t              ScrollStart;/* VSCSAD VSP  */
+  uint32_t              TearingEffect; /* TEON/TEOFF, ST7789H2_TE_xxx */
+  uint32_t              Tick;
+  ST7789H2_SIM_Stats_t  Stats;
+} SIM_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Private_FunctionPrototypes ST7789H2_SIM Private FunctionPrototypes
+  * @{
+  */
+static int32_t  SIM_IOInit(void);
+static int32_t  SIM_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint32_t Length);
+static int32_t  SIM_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint32_t Length);
+static int32_t  SIM_SendData(uint8_t *pData, uint32_t Length);
+static int32_t  SIM_GetTick(void);
+static void     SIM_Command(uint32_t Reg, uint32_t Length);
+static uint32_t SIM_Param(const uint8_t *pData, uint32_t Index);
+static uint16_t *SIM_Access(void);
+static uint32_t SIM_DisplayedLine(uint32_t Line);
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Private_Variables ST7789H2_SIM Private Variables
+  * @{
+  */
+static SIM_Ctx_t SimCtx;
+/**
+  * @}
+  */
+
+/** @addtogroup ST7789H2_SIM_Exported_Functions
+  * @{
+  */
+/**
+  * @brief  Reset the simulated panel and get its bus services.
+  * @param  pIO Bus services to register with ST7789H2_RegisterBusIO().
+  * @retval Component status.
+  */
+int32_t ST7789H2_SIM_Init(ST7789H2_IO_t *pIO)
+{
+  int32_t ret = ST7789H2_OK;
+
+  if (pIO == NULL)
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else
+  {
+    (void)memset(&SimCtx, 0, sizeof(SimCtx));
+    SimCtx.XEnd       = ST7789H2_SIM_RAM_WIDTH - 1U;
+    SimCtx.YEnd       = ST7789H2_RAM_HEIGHT - 1U;
+    SimCtx.ScrollArea = ST7789H2_RAM_HEIGHT;
+
+    pIO->Init     = SIM_IOInit;
+    pIO->DeInit   = SIM_IOInit;
+    pIO->Address  = 0U;
+    pIO->WriteReg = SIM_WriteReg;
+    pIO->ReadReg  = SIM_ReadReg;
+    pIO->SendData = SIM_SendData;
+    pIO->GetTick  = SIM_GetTick;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the bus traffic since the last reset.
+  * @param  pStats Bus traffic.
+  */
+void ST7789H2_SIM_GetStats(ST7789H2_SIM_Stats_t *pStats)
+{
+  *pStats = SimCtx.Stats;
+}
+
+/**
+  * @brief  Reset the bus traffic counters.
+  */
+void ST7789H2_SIM_ResetStats(void)
+{
+  (void)memset(&SimCtx.Stats, 0, sizeof(SimCtx.Stats));
+}
+
+/**
+  * @brief  Get the tearing effect output mode set by TEON/TEOFF.
+  * @retval ST7789H2_TE_OFF, ST7789H2_TE_VBLANK or ST7789H2_TE_VHBLANK.
+  */
+uint32_t ST7789H2_SIM_GetTearingEffect(void)
+{
+  return SimCtx.TearingEffect;
+}
+
+/**
+  * @brief  Get the displayed image.
+  * @param  pImage RGB565 image of ST7789H2_WIDTH x ST7789H2_HEIGHT pixels.
+  */
+void ST7789H2_SIM_GetImage(uint16_t *pImage)
+{
+  uint32_t y;
+
+  for (y = 0U; y < ST7789H2_HEIGHT; y++)
+  {
+    (void)memcpy(&pImage[y * ST7789H2_WIDTH], SimCtx.Ram[SIM_DisplayedLine(y)], 2U * ST7789H2_WIDTH);
+  }
+}
+
+/**
+  * @brief  Write the displayed image in a binary PPM file.
+  * @param  pFileName File name.
+  * @retval Component status.
+  */
+int32_t ST7789H2_SIM_DumpPPM(const char *pFileName)
+{
+  int32_t   ret = ST7789H2_OK;
+  FILE     *file;
+  uint8_t   rgb[3U * ST7789H2_WIDTH];
+  uint16_t *line;
+  uint32_t  x, y;
+
+  file = fopen(pFileName, "wb");
+  if (file == NULL)
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else
+  {
+    if (fprintf(file, "P6\n%u %u\n255\n", (unsigned int)ST7789H2_WIDTH, (unsigned int)ST7789H2_HEIGHT) < 0)
+    {
+      ret = ST7789H2_ERROR;
+    }
+    for (y = 0U; (y < ST7789H2_HEIGHT) && (ret == ST7789H2_OK); y++)
+    {
+      line = SimCtx.Ram[SIM_DisplayedLine(y)];
+      for (x = 0U; x < ST7789H2_WIDTH; x++)
+      {
+        /* RGB565 to RGB888, low bits replicated */
+        rgb[3U * x]        = (uint8_t)(((line[x] >> 8) & 0xF8U) | (line[x] >> 13));
+        rgb[(3U * x) + 1U] = (uint8_t)(((line[x] >> 3) & 0xFCU) | ((line[x] >> 9) & 0x03U));
+        rgb[(3U * x) + 2U] = (uint8_t)(((line[x] << 3) & 0xF8U) | ((line[x] >> 2) & 0x07U));
+      }
+      if (fwrite(rgb, 1U, sizeof(rgb), file) != sizeof(rgb))
+      {
+        ret = ST7789H2_ERROR;
+      }
+    }
+    if (fclose(file) != 0)
+    {
+      ret = ST7789H2_ERROR;
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Private_Functions ST7789H2_SIM Private Functions
+  * @{
+  */
+/**
+  * @brief  Simulated bus initialization.
+  * @retval Component status.
+  */
+static int32_t SIM_IOInit(void)
+{
+  return ST7789H2_OK;
+}
+
+/**
+  * @brief  Write a command and its data words.
+  * @param  DevAddr Device address on bus, unused.
+  * @param  Reg     Command.
+  * @param  pData   Data words.
+  * @param  Length  Number of data words.
+  * @retval Component status.
+  */
+static int32_t SIM_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint32_t Length)
+{
+  int32_t   ret = ST7789H2_OK;
+  uint32_t  i;
+  uint16_t *pixel;
+
+  (void)DevAddr;
+
+  if ((pData == NULL) || (Length == 0U))
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else
+  {
+    SIM_Command(Reg, Length);
+    SimCtx.Stats.DataWrites += Length;
+
+    switch (Reg & 0xFFU)
+    {
+      case ST7789H2_CASET:
+      case ST7789H2_RASET:
+        if (Length >= 4U)
+        {
+          if ((Reg & 0xFFU) == ST7789H2_CASET)
+          {
+            SimCtx.XStart = (SIM_Param(pData, 0U) << 8) | SIM_Param(pData, 1U);
+            SimCtx.XEnd   = (SIM_Param(pData, 2U) << 8) | SIM_Param(pData, 3U);
+          }
+          else
+          {
+            SimCtx.YStart = (SIM_Param(pData, 0U) << 8) | SIM_Param(pData, 1U);
+            SimCtx.YEnd   = (SIM_Param(pData, 2U) << 8) | SIM_Param(pData, 3U);
+          }
+          SimCtx.Stats.Windows++;
+        }
+        break;
+
+      case ST7789H2_MADCTL:
+        SimCtx.Madctl = SIM_Param(pData, 0U);
+        break;
+
+      case ST7789H2_VSCRDEF:
+        if (Length >= 6U)
+        {
+          SimCtx.ScrollTop  = (SIM_Param(pData, 0U) << 8) | SIM_Param(pData, 1U);
+          SimCtx.ScrollArea = (SIM_Param(pData, 2U) << 8) | SIM_Param(pData, 3U);
+        }
+        break;
+
+      case ST7789H2_VSCSAD:
+        if (Length >= 2U)
+        {
+          SimCtx.ScrollStart = (SIM_Param(pData, 0U) << 8) | SIM_Param(pData, 1U);
+        }
+        break;
+
+      case ST7789H2_TE_LINE_ON:
+        /* TEM = 0: V-blanking only, 1: V and H-blanking */
+        SimCtx.TearingEffect = ((SIM_Param(pData, 0U) & 0x01U) == 0U) ? ST7789H2_TE_VBLANK : ST7789H2_TE_VHBLANK;
+        break;
+
+      case ST7789H2_WRITE_RAM:
+      case ST7789H2_WRITE_RAM_CONTINUE:
+        if ((Reg & 0xFFU) == ST7789H2_WRITE_RAM)
+        {
+          /* Memory write restarts at the beginning of the window */
+          SimCtx.Column = SimCtx.XStart;
+          SimCtx.Row    = SimCtx.YStart;
+        }
+        for (i = 0U; i < Length; i++)
+        {
+          pixel = SIM_Access();
+          if (pixel != NULL)
+          {
+            *pixel = (uint16_t)((uint32_t)pData[2U * i] | ((uint32_t)pData[(2U * i) + 1U] << 8));
+            SimCtx.Stats.Pixels++;
+          }
+          else
+          {
+            SimCtx.Stats.Dropped++;
+          }
+        }
+        break;
+
+      default:
+        /* Other settings have no effect on the panel memory */
+        break;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write a command and read data words.
+  * @param  DevAddr Device address on bus, unused.
+  * @param  Reg     Command.
+  * @param  pData   Data words read.
+  * @param  Length  Number of data words.
+  * @retval Component status.
+  */
+static int32_t SIM_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint32_t Length)
+{
+  int32_t   ret = ST7789H2_OK;
+  uint8_t   bytes[3];
+  uint32_t  i, count = 3U;
+  uint16_t *pixel;
+
+  (void)DevAddr;
+
+  if ((pData == NULL) || (Length == 0U))
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else
+  {
+    SIM_Command(Reg, Length);
+    SimCtx.Stats.DataReads += Length;
+    (void)memset(pData, 0, 2U * Length);
+
+    if ((Reg & 0xFFU) == ST7789H2_READ_ID1)
+    {
+      /* Dummy word, then the ID */
+      if (Length >= 2U)
+      {
+        pData[2] = (uint8_t)ST7789H2_ID;
+      }
+    }
+    else if ((Reg & 0xFFU) == ST7789H2_READ_RAM)
+    {
+      /* Dummy word, then 8-bit R, G and B of each pixel, 2 per word, high
+         byte first */
+      SimCtx.Column = SimCtx.XStart;
+      SimCtx.Row    = SimCtx.YStart;
+      for (i = 2U; i < (2U * Length); i++)
+      {
+        if (count == 3U)
+        {
+          pixel    = SIM_Access();
+          bytes[0] = (pixel != NULL) ? (uint8_t)((*pixel >> 8) & 0xF8U) : 0U;
+          bytes[1] = (pixel != NULL) ? (uint8_t)((*pixel >> 3) & 0xFCU) : 0U;
+          bytes[2] = (pixel != NULL) ? (uint8_t)((*pixel << 3) & 0xF8U) : 0U;
+          count    = 0U;
+        }
+        pData[i ^ 1U] = bytes[count];
+        count++;
+      }
+    }
+    else
+    {
+      /* Other registers read as 0 */
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write command words.
+  * @param  pData  Command words.
+  * @param  Length Number of words.
+  * @retval Component status.
+  */
+static int32_t SIM_SendData(uint8_t *pData, uint32_t Length)
+{
+  int32_t  ret = ST7789H2_OK;
+  uint32_t i;
+
+  if ((pData == NULL) || (Length == 0U))
+  {
+    ret = ST7789H2_ERROR;
+  }
+  else
+  {
+    for (i = 0U; i < Length; i++)
+    {
+      /* Commands without parameter: sleep, display on/off, TE off... */
+      SIM_Command(pData[2U * i], 0U);
+      if (pData[2U * i] == ST7789H2_TE_LINE_OFF)
+      {
+        SimCtx.TearingEffect = ST7789H2_TE_OFF;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Simulated millisecond tick, advancing on each call.
+  * @retval Tick value.
+  */
+static int32_t SIM_GetTick(void)
+{
+  SimCtx.Tick++;
+
+  return (int32_t)SimCtx.Tick;
+}
+
+/**
+  * @brief  Account for a command and its data words.
+  * @param  Reg    Command.
+  * @param  Length Number of data words.
+  */
+static void SIM_Command(uint32_t Reg, uint32_t Length)
+{
+  SimCtx.Stats.Commands++;
+  SimCtx.Stats.Bytes += 2U * (1U + Length);
+  SimCtx.Stats.Op[Reg & 0xFFU].Count++;
+  SimCtx.Stats.Op[Reg & 0xFFU].Bytes += 2U * (1U + Length);
+}
+
+/**
+  * @brief  Get a register parameter: low byte of a data word.
+  * @param  pData Data words.
+  * @param  Index Parameter index.
+  * @retval Parameter value.
+  */
+static uint32_t SIM_Param(const uint8_t *pData, uint32_t Index)
+{
+  return pData[2U * Index];
+}
+
+/**
+  * @brief  Get the panel memory pixel at the access counters, then advance
+  *         the counters in the column/row window.
+  * @retval Pixel address, NULL if outside of the panel memory.
+  */
+static uint16_t *SIM_Access(void)
+{
+  uint16_t *pixel = NULL;
+  uint32_t  column = SimCtx.Column;
+  uint32_t  row    = SimCtx.Row;
+  uint32_t  swap;
+
+  if ((SimCtx.Madctl & SIM_MADCTL_MV) != 0U)
+  {
+    /* Columns address the memory lines */
+    swap   = column;
+    column = row;
+    row    = swap;
+  }
+  if ((row < ST7789H2_RAM_HEIGHT) && (column < ST7789H2_SIM_RAM_WIDTH))
+  {
+    if ((SimCtx.Madctl & SIM_MADCTL_MY) != 0U)
+    {
+      row = ST7789H2_RAM_HEIGHT - 1U - row;
+    }
+    if ((SimCtx.Madctl & SIM_MADCTL_MX) != 0U)
+    {
+      column = ST7789H2_SIM_RAM_WIDTH - 1U - column;
+    }
+    pixel = &SimCtx.Ram[row][column];
+  }
+
+  /* Column first, then row, wrapping at the end of the window */
+  if (SimCtx.Column >= SimCtx.XEnd)
+  {
+    SimCtx.Column = SimCtx.XStart;
+    SimCtx.Row    = (SimCtx.Row >= SimCtx.YEnd) ? SimCtx.YStart : (SimCtx.Row + 1U);
+  }
+  else
+  {
+    SimCtx.Column++;
+  }
+
+  return pixel;
+}
+
+/**
+  * @brief  Get the panel memory line displayed on a panel line, vertical
+  *         scrolling applied.
+  * @param  Line Panel line.
+  * @retval Memory line.
+  */
+static uint32_t SIM_DisplayedLine(uint32_t Line)
+{
+  uint32_t ret = Line;
+
+  if ((Line >= SimCtx.ScrollTop) && (Line < (SimCtx.ScrollTop + SimCtx.ScrollArea)) &&
+      (SimCtx.ScrollStart >= SimCtx.ScrollTop) && (SimCtx.ScrollStart < (SimCtx.ScrollTop + SimCtx.ScrollArea)))
+  {
+    ret = SimCtx.ScrollTop + (((SimCtx.ScrollStart - SimCtx.ScrollTop) + (Line - SimCtx.ScrollTop)) % SimCtx.ScrollArea);
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,113 @@
+/**
+  ******************************************************************************
+  * @file    st7789h2_sim.h
+  * @author  MCD Application Team
+  * @brief   This file contains all the functions prototypes for the
+  *          st7789h2_sim.c simulated bus.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7789H2_SIM_H
+#define ST7789H2_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "st7789h2.h"
+
+/** @addtogroup BSP
+  * @{
+  */
+
+/** @addtogroup Components
+  * @{
+  */
+
+/** @addtogroup ST7789H2
+  * @{
+  */
+
+/** @defgroup ST7789H2_SIM_Exported_Types ST7789H2_SIM Exported Types
+  * @{
+  */
+/**
+  * @brief  Bus traffic of a command
+  */
+typedef struct
+{
+  uint32_t Count;  /*!< Times the command was sent                 */
+  uint32_t Bytes;  /*!< Bus bytes: command word and data words     */
+} ST7789H2_SIM_Op_t;
+
+/**
+  * @brief  Bus traffic
+  */
+typedef struct
+{
+  uint32_t          Commands;     /*!< Command words written                          */
+  uint32_t          DataWrites;   /*!< Data words written                             */
+  uint32_t          DataReads;    /*!< Data words read                                */
+  uint32_t          Bytes;        /*!< Bus bytes, 2 per word                          */
+  uint32_t          Pixels;       /*!< Pixels written in the panel memory             */
+  uint32_t          Dropped;      /*!< Pixels written outside of the panel memory     */
+  uint32_t          Windows;      /*!< Column or row address settings                 */
+  ST7789H2_SIM_Op_t Op[256];      /*!< Traffic per command code                       */
+} ST7789H2_SIM_Stats_t;
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Exported_Constants ST7789H2_SIM Exported Constants
+  * @{
+  */
+#define ST7789H2_SIM_RAM_WIDTH   240U  /* Panel memory columns */
+/**
+  * @}
+  */
+
+/** @defgroup ST7789H2_SIM_Exported_Functions ST7789H2_SIM Exported Functions
+  * @{
+  */
+int32_t  ST7789H2_SIM_Init(ST7789H2_IO_t *pIO);
+void     ST7789H2_SIM_GetStats(ST7789H2_SIM_Stats_t *pStats);
+void     ST7789H2_SIM_ResetStats(void);
+uint32_t ST7789H2_SIM_GetTearingEffect(void);
+void     ST7789H2_SIM_GetImage(uint16_t *pImage);
+int32_t  ST7789H2_SIM_DumpPPM(const char *pFileName);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ST7789H2_SIM_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
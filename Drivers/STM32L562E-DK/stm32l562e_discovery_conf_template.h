@@ -50,6 +50,15 @@ extern "C" {
 /* SD card interrupt priority */
 #define BSP_SD_IT_PRIORITY          0x07UL  /* Default is lowest priority level */
 
+/* LCD DMA interrupt priority */
+#define BSP_LCD_DMA_IT_PRIORITY     0x07UL  /* Default is lowest priority level */
+
+/* LCD tearing effect interrupt priority */
+#define BSP_LCD_TE_IT_PRIORITY      0x07UL  /* Default is lowest priority level */
+
+/* OSPI NOR status match interrupt priority */
+#define BSP_OSPI_NOR_IT_PRIORITY    0x07UL  /* Default is lowest priority level */
+
 /* Bus frequencies */
 #define BUS_I2C1_FREQUENCY          100000UL  /* Frequency of I2C1 = 100 KHz */
 #define BUS_SPI1_BAUDRATE           5000000UL /* Baud rate of SPI1 = 5 Mbps */
@@ -35,6 +35,37 @@
        o Call BSP_LCD_DrawBitmap() to draw a bitmap.
        o Call BSP_LCD_FillRect() to draw a rectangle.
        o Call BSP_LCD_FillRGBRect() to draw a rectangle with RGB buffer.
+       o Call BSP_LCD_SetWindow() then BSP_LCD_WritePixels() one or several
+         times to stream an RGB565 buffer into a rectangle of the LCD.
+       o Call BSP_LCD_SetScrollArea() to define rows scrolled by the panel,
+         then BSP_LCD_SetScrollStart() to scroll them without rewriting any
+         pixel (portrait orientations only).
+
+    + Asynchronous transfers:
+       o Call BSP_LCD_DMA_Init() to configure the memory-to-memory DMA writing
+         the LCD data address, and call BSP_LCD_DMA_IRQHandler() from the
+         DMA2_Channel3 interrupt handler.
+       o BSP_LCD_DMA_SetWindow() opens a window and starts a memory write,
+         BSP_LCD_DMA_Transfer() starts sending pixels to it and returns
+         immediately. The end of the transfer is reported by the
+         BSP_LCD_DMA_TransferCpltCallback() and BSP_LCD_DMA_ErrorCallback()
+         weak callbacks.
+       o These services are the transfer engine of the UTIL_LCD_ASYNC queue
+         (Utilities/lcd/stm32_lcd_async.c): override the callbacks to call
+         UTIL_LCD_ASYNC_TransferCplt() and UTIL_LCD_ASYNC_TransferError().
+       o Other LCD services must not be called while a transfer is running.
+
+    + Tearing effect synchronization:
+       o Call BSP_LCD_TE_Init() to enable the panel TE output, pulsed at the
+         beginning of each vertical blanking, and to configure the TE pin in
+         polling or EXTI mode. In EXTI mode, call BSP_LCD_TE_IRQHandler()
+         from the EXTI2 interrupt handler; BSP_LCD_TE_Callback() is called
+         on each TE rising edge.
+       o BSP_LCD_TE_Wait() returns on the next TE rising edge and
+         BSP_LCD_TE_GetTick() returns the CPU cycle counter. They are the
+         synchronization services of the UTIL_LCD_PRESENT frame presenter
+         (Utilities/lcd/stm32_lcd_present.c), which schedules the frame
+         buffer flush with respect to the panel refresh.
 
     + De-initialization steps:
        o De-initialize the LCD using the BSP_LCD_DeInit() function.
@@ -81,11 +112,21 @@
 #define LCD_BACKLIGHT_GPIO_PORT           GPIOE
 #define LCD_BACKLIGHT_GPIO_PIN            GPIO_PIN_1
 #define LCD_BACKLIGHT_GPIO_CLOCK_ENABLE() __HAL_RCC_GPIOE_CLK_ENABLE()
+#define LCD_TE_GPIO_PORT                  GPIOF
+#define LCD_TE_GPIO_PIN                   GPIO_PIN_2
+#define LCD_TE_GPIO_CLOCK_ENABLE()        __HAL_RCC_GPIOF_CLK_ENABLE()
+#define LCD_TE_EXTI_LINE                  EXTI_LINE_2
+#define LCD_TE_EXTI_IRQn                  EXTI2_IRQn
+#define LCD_TE_TIMEOUT                    100U /* ms, several refresh periods */
 
 #define LCD_REGISTER_ADDR FMC_BANK1_1
 #define LCD_DATA_ADDR     (FMC_BANK1_1 | 0x00000002UL)
 
 #define LCD_FMC_ADDRESS   1U
+
+#define LCD_DMA_CHANNEL             DMA2_Channel3
+#define LCD_DMA_IRQn                DMA2_Channel3_IRQn
+#define LCD_DMA_MAX_LENGTH          0xFFFFU
 /**
   * @}
   */
@@ -96,6 +137,9 @@
 #if (USE_HAL_SRAM_REGISTER_CALLBACKS == 1)
 static uint32_t Lcd_IsSramMspCbValid[LCD_INSTANCES_NBR] = {0};
 #endif
+static EXTI_HandleTypeDef hlcd_te_exti[LCD_INSTANCES_NBR];
+static uint32_t           Lcd_TeMode[LCD_INSTANCES_NBR] = {LCD_TE_MODE_POLLING};
+static volatile uint32_t  Lcd_TeCount[LCD_INSTANCES_NBR] = {0};
 /**
   * @}
   */
@@ -104,6 +148,7 @@ static uint32_t Lcd_IsSramMspCbValid[LCD_INSTANCES_NBR] = {0};
   * @{
   */
 SRAM_HandleTypeDef hlcd_sram[LCD_INSTANCES_NBR] = {0};
+DMA_HandleTypeDef  hlcd_dma[LCD_INSTANCES_NBR]  = {0};
 
 void      *Lcd_CompObj[LCD_INSTANCES_NBR] = {NULL};
 LCD_Drv_t *Lcd_Drv[LCD_INSTANCES_NBR] = {NULL};
@@ -126,6 +171,9 @@ static int32_t LCD_FMC_Send(uint8_t *pData, uint32_t Length);
 static int32_t LCD_FMC_GetTick(void);
 static void    FMC_MspInit(SRAM_HandleTypeDef *hSram);
 static void    FMC_MspDeInit(SRAM_HandleTypeDef *hSram);
+static void    LCD_DMA_XferCpltCallback(DMA_HandleTypeDef *hDma);
+static void    LCD_DMA_XferErrorCallback(DMA_HandleTypeDef *hDma);
+static void    LCD_TE_EXTI_Callback(void);
 /**
   * @}
   */
@@ -592,6 +640,464 @@ int32_t BSP_LCD_GetFormat(uint32_t Instance, uint32_t *Format)
   return status;  
 }
 
+/**
+  * @brief  Set the LCD window filled by BSP_LCD_WritePixels().
+  * @param  Instance LCD Instance.
+  * @param  Xpos X position.
+  * @param  Ypos Y position.
+  * @param  Width Width of the window.
+  * @param  Height Height of the window.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_SetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Set window on LCD */
+    if (ST7789H2_SetWindow((ST7789H2_Object_t *)Lcd_CompObj[Instance], Xpos, Ypos, Width, Height) < 0)
+    {
+      status = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Write RGB565 pixels in the LCD window set by BSP_LCD_SetWindow().
+  *         Successive calls continue where the previous one stopped.
+  * @param  Instance LCD Instance.
+  * @param  pData Pointer on RGB565 pixels buffer.
+  * @param  Length Number of pixels.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_WritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Write pixels on LCD */
+    if (ST7789H2_WritePixels((ST7789H2_Object_t *)Lcd_CompObj[Instance], pData, Length) < 0)
+    {
+      status = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Define the LCD vertical scroll area (portrait orientations only).
+  * @param  Instance LCD Instance.
+  * @param  Ypos First row of the scroll area.
+  * @param  Height Number of rows of the scroll area, 0 to stop scrolling.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_SetScrollArea(uint32_t Instance, uint32_t Ypos, uint32_t Height)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Set scroll area on LCD */
+    if (ST7789H2_SetScrollArea((ST7789H2_Object_t *)Lcd_CompObj[Instance], Ypos, Height) < 0)
+    {
+      status = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Scroll the area defined by BSP_LCD_SetScrollArea().
+  * @param  Instance LCD Instance.
+  * @param  Line Row of the scroll area, relative to its first row, displayed
+  *         on its first row.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_SetScrollStart(uint32_t Instance, uint32_t Line)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Set scroll start on LCD */
+    if (ST7789H2_SetScrollStart((ST7789H2_Object_t *)Lcd_CompObj[Instance], Line) < 0)
+    {
+      status = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Initialize the DMA used for asynchronous transfers to the LCD.
+  * @param  Instance LCD Instance.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_DMA_Init(uint32_t Instance)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+
+    /* Source is the pixels buffer, destination is the LCD data address */
+    hlcd_dma[Instance].Instance                 = LCD_DMA_CHANNEL;
+    hlcd_dma[Instance].Init.Request             = DMA_REQUEST_MEM2MEM;
+    hlcd_dma[Instance].Init.Direction           = DMA_MEMORY_TO_MEMORY;
+    hlcd_dma[Instance].Init.PeriphInc           = DMA_PINC_ENABLE;
+    hlcd_dma[Instance].Init.MemInc              = DMA_MINC_DISABLE;
+    hlcd_dma[Instance].Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hlcd_dma[Instance].Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    hlcd_dma[Instance].Init.Mode                = DMA_NORMAL;
+    hlcd_dma[Instance].Init.Priority            = DMA_PRIORITY_MEDIUM;
+
+    if (HAL_DMA_Init(&hlcd_dma[Instance]) != HAL_OK)
+    {
+      status = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (HAL_DMA_RegisterCallback(&hlcd_dma[Instance], HAL_DMA_XFER_CPLT_CB_ID, LCD_DMA_XferCpltCallback) != HAL_OK)
+    {
+      status = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if (HAL_DMA_RegisterCallback(&hlcd_dma[Instance], HAL_DMA_XFER_ERROR_CB_ID, LCD_DMA_XferErrorCallback) != HAL_OK)
+    {
+      status = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+    {
+      HAL_NVIC_SetPriority(LCD_DMA_IRQn, BSP_LCD_DMA_IT_PRIORITY, 0);
+      HAL_NVIC_EnableIRQ(LCD_DMA_IRQn);
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  De-initialize the DMA used for asynchronous transfers to the LCD.
+  * @param  Instance LCD Instance.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_DMA_DeInit(uint32_t Instance)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    HAL_NVIC_DisableIRQ(LCD_DMA_IRQn);
+
+    if (HAL_DMA_DeInit(&hlcd_dma[Instance]) != HAL_OK)
+    {
+      status = BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Set the LCD window and start a memory write for DMA transfers.
+  * @param  Instance LCD Instance.
+  * @param  Xpos X position.
+  * @param  Ypos Y position.
+  * @param  Width Width of the window.
+  * @param  Height Height of the window.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_DMA_SetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t status;
+
+  status = BSP_LCD_SetWindow(Instance, Xpos, Ypos, Width, Height);
+
+  if (status == BSP_ERROR_NONE)
+  {
+    /* Memory write command, pixels are then written at the data address */
+    *(uint16_t *)LCD_REGISTER_ADDR = ST7789H2_WRITE_RAM;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Start a DMA transfer of RGB565 pixels to the LCD window.
+  * @param  Instance LCD Instance.
+  * @param  pData Pointer on RGB565 pixels buffer, halfword aligned.
+  * @param  Length Number of pixels, up to 65535.
+  * @param  Increment 0 to send Length times the first pixel (solid fill).
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_DMA_Transfer(uint32_t Instance, uint8_t *pData, uint32_t Length, uint32_t Increment)
+{
+  int32_t  status = BSP_ERROR_NONE;
+  uint32_t source_inc;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (pData == NULL) || (Length == 0U) || (Length > LCD_DMA_MAX_LENGTH))
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    /* Source increment is changed while the channel is disabled */
+    source_inc = (Increment != 0U) ? DMA_PINC_ENABLE : DMA_PINC_DISABLE;
+    if (hlcd_dma[Instance].Init.PeriphInc != source_inc)
+    {
+      hlcd_dma[Instance].Init.PeriphInc = source_inc;
+      MODIFY_REG(hlcd_dma[Instance].Instance->CCR, DMA_CCR_PINC, source_inc);
+    }
+
+    if (HAL_DMA_Start_IT(&hlcd_dma[Instance], (uint32_t)pData, LCD_DATA_ADDR, Length) != HAL_OK)
+    {
+      status = BSP_ERROR_BUS_DMA_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  LCD DMA transfer complete callback.
+  * @param  Instance LCD Instance.
+  * @retval None.
+  */
+__weak void BSP_LCD_DMA_TransferCpltCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+}
+
+/**
+  * @brief  LCD DMA transfer error callback.
+  * @param  Instance LCD Instance.
+  * @retval None.
+  */
+__weak void BSP_LCD_DMA_ErrorCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+}
+
+/**
+  * @brief  LCD DMA interrupt handler.
+  * @param  Instance LCD Instance.
+  * @retval None.
+  */
+void BSP_LCD_DMA_IRQHandler(uint32_t Instance)
+{
+  HAL_DMA_IRQHandler(&hlcd_dma[Instance]);
+}
+
+/**
+  * @brief  Enable the LCD tearing effect output and configure the TE pin.
+  * @note   The TE line is pulsed at the beginning of each vertical blanking.
+  *         The CPU cycle counter is started as time base of BSP_LCD_TE_GetTick().
+  * @param  Instance LCD Instance.
+  * @param  Mode LCD_TE_MODE_POLLING or LCD_TE_MODE_EXTI.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_TE_Init(uint32_t Instance, uint32_t Mode)
+{
+  int32_t          status = BSP_ERROR_NONE;
+  GPIO_InitTypeDef gpio_init_structure;
+
+  if ((Instance >= LCD_INSTANCES_NBR) || (Mode > LCD_TE_MODE_EXTI))
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else if (ST7789H2_SetTearingEffect((ST7789H2_Object_t *)Lcd_CompObj[Instance], ST7789H2_TE_VBLANK) < 0)
+  {
+    status = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    LCD_TE_GPIO_CLOCK_ENABLE();
+
+    gpio_init_structure.Pin   = LCD_TE_GPIO_PIN;
+    gpio_init_structure.Pull  = GPIO_NOPULL;
+    gpio_init_structure.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio_init_structure.Mode  = (Mode == LCD_TE_MODE_EXTI) ? GPIO_MODE_IT_RISING : GPIO_MODE_INPUT;
+    HAL_GPIO_Init(LCD_TE_GPIO_PORT, &gpio_init_structure);
+
+    if (Mode == LCD_TE_MODE_EXTI)
+    {
+      if (HAL_EXTI_GetHandle(&hlcd_te_exti[Instance], LCD_TE_EXTI_LINE) != HAL_OK)
+      {
+        status = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else if (HAL_EXTI_RegisterCallback(&hlcd_te_exti[Instance], HAL_EXTI_RISING_CB_ID, LCD_TE_EXTI_Callback) != HAL_OK)
+      {
+        status = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        HAL_NVIC_SetPriority(LCD_TE_EXTI_IRQn, BSP_LCD_TE_IT_PRIORITY, 0);
+        HAL_NVIC_EnableIRQ(LCD_TE_EXTI_IRQn);
+      }
+    }
+
+    /* Cycle counter used as time base */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Lcd_TeMode[Instance] = Mode;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Disable the LCD tearing effect output and release the TE pin.
+  * @param  Instance LCD Instance.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_TE_DeInit(uint32_t Instance)
+{
+  int32_t status = BSP_ERROR_NONE;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    if (Lcd_TeMode[Instance] == LCD_TE_MODE_EXTI)
+    {
+      HAL_NVIC_DisableIRQ(LCD_TE_EXTI_IRQn);
+    }
+    HAL_GPIO_DeInit(LCD_TE_GPIO_PORT, LCD_TE_GPIO_PIN);
+    Lcd_TeMode[Instance] = LCD_TE_MODE_POLLING;
+
+    if (ST7789H2_SetTearingEffect((ST7789H2_Object_t *)Lcd_CompObj[Instance], ST7789H2_TE_OFF) < 0)
+    {
+      status = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Wait for the next LCD tearing effect rising edge, i.e. the
+  *         beginning of the next vertical blanking.
+  * @param  Instance LCD Instance.
+  * @retval BSP status.
+  */
+int32_t BSP_LCD_TE_Wait(uint32_t Instance)
+{
+  int32_t  status = BSP_ERROR_NONE;
+  uint32_t tickstart;
+  uint32_t count;
+
+  if (Instance >= LCD_INSTANCES_NBR)
+  {
+    status = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    tickstart = HAL_GetTick();
+
+    if (Lcd_TeMode[Instance] == LCD_TE_MODE_EXTI)
+    {
+      /* Wait for the edge counted by the EXTI callback */
+      count = Lcd_TeCount[Instance];
+      while ((Lcd_TeCount[Instance] == count) && (status == BSP_ERROR_NONE))
+      {
+        if ((HAL_GetTick() - tickstart) > LCD_TE_TIMEOUT)
+        {
+          status = BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+    }
+    else
+    {
+      /* Wait for the TE line to be low, then high */
+      while ((HAL_GPIO_ReadPin(LCD_TE_GPIO_PORT, LCD_TE_GPIO_PIN) != GPIO_PIN_RESET) && (status == BSP_ERROR_NONE))
+      {
+        if ((HAL_GetTick() - tickstart) > LCD_TE_TIMEOUT)
+        {
+          status = BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+      while ((HAL_GPIO_ReadPin(LCD_TE_GPIO_PORT, LCD_TE_GPIO_PIN) == GPIO_PIN_RESET) && (status == BSP_ERROR_NONE))
+      {
+        if ((HAL_GetTick() - tickstart) > LCD_TE_TIMEOUT)
+        {
+          status = BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Get the time base of the tearing effect synchronization.
+  * @param  Instance LCD Instance.
+  * @retval CPU cycle counter.
+  */
+uint32_t BSP_LCD_TE_GetTick(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+
+  return DWT->CYCCNT;
+}
+
+/**
+  * @brief  LCD tearing effect callback, called on each TE rising edge in EXTI mode.
+  * @param  Instance LCD Instance.
+  * @retval None.
+  */
+__weak void BSP_LCD_TE_Callback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+}
+
+/**
+  * @brief  LCD tearing effect interrupt handler.
+  * @param  Instance LCD Instance.
+  * @retval None.
+  */
+void BSP_LCD_TE_IRQHandler(uint32_t Instance)
+{
+  HAL_EXTI_IRQHandler(&hlcd_te_exti[Instance]);
+}
+
 /**
   * @brief  MX FMC BANK1 initialization.
   * @param  hSram SRAM handle.
@@ -1110,6 +1616,43 @@ static void FMC_MspDeInit(SRAM_HandleTypeDef *hSram)
   /* Disable FMC clock */
   __HAL_RCC_FMC_CLK_DISABLE();
 }
+
+/**
+  * @brief  LCD DMA transfer complete callback.
+  * @param  hDma DMA handle.
+  * @retval None
+  */
+static void LCD_DMA_XferCpltCallback(DMA_HandleTypeDef *hDma)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hDma);
+
+  BSP_LCD_DMA_TransferCpltCallback(0);
+}
+
+/**
+  * @brief  LCD DMA transfer error callback.
+  * @param  hDma DMA handle.
+  * @retval None
+  */
+static void LCD_DMA_XferErrorCallback(DMA_HandleTypeDef *hDma)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(hDma);
+
+  BSP_LCD_DMA_ErrorCallback(0);
+}
+
+/**
+  * @brief  LCD tearing effect EXTI line callback.
+  * @retval None
+  */
+static void LCD_TE_EXTI_Callback(void)
+{
+  Lcd_TeCount[0]++;
+
+  BSP_LCD_TE_Callback(0);
+}
 /**
   * @}
   */
@@ -50,6 +50,20 @@ extern "C" {
 /* LCD instances */
 #define LCD_INSTANCES_NBR 1U
 
+/* LCD DMA interrupt priority, for configuration files not defining it */
+#ifndef BSP_LCD_DMA_IT_PRIORITY
+#define BSP_LCD_DMA_IT_PRIORITY 0x07UL
+#endif
+
+/* LCD tearing effect interrupt priority, for configuration files not defining it */
+#ifndef BSP_LCD_TE_IT_PRIORITY
+#define BSP_LCD_TE_IT_PRIORITY 0x07UL
+#endif
+
+/* LCD tearing effect line modes */
+#define LCD_TE_MODE_POLLING               0U
+#define LCD_TE_MODE_EXTI                  1U
+
 /* LCD orientations */
 #define LCD_ORIENTATION_PORTRAIT          0U
 #define LCD_ORIENTATION_LANDSCAPE         1U
@@ -105,6 +119,7 @@ typedef struct
   * @{
   */
 extern SRAM_HandleTypeDef hlcd_sram[LCD_INSTANCES_NBR];
+extern DMA_HandleTypeDef  hlcd_dma[LCD_INSTANCES_NBR];
 
 extern void      *Lcd_CompObj[LCD_INSTANCES_NBR];
 extern LCD_Drv_t *Lcd_Drv[LCD_INSTANCES_NBR];
@@ -132,6 +147,25 @@ int32_t  BSP_LCD_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint3
 int32_t  BSP_LCD_ReadPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
 int32_t  BSP_LCD_WritePixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
 int32_t  BSP_LCD_GetFormat(uint32_t Instance, uint32_t *Format);
+int32_t  BSP_LCD_SetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t  BSP_LCD_WritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length);
+int32_t  BSP_LCD_SetScrollArea(uint32_t Instance, uint32_t Ypos, uint32_t Height);
+int32_t  BSP_LCD_SetScrollStart(uint32_t Instance, uint32_t Line);
+
+int32_t  BSP_LCD_DMA_Init(uint32_t Instance);
+int32_t  BSP_LCD_DMA_DeInit(uint32_t Instance);
+int32_t  BSP_LCD_DMA_SetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t  BSP_LCD_DMA_Transfer(uint32_t Instance, uint8_t *pData, uint32_t Length, uint32_t Increment);
+void     BSP_LCD_DMA_TransferCpltCallback(uint32_t Instance);
+void     BSP_LCD_DMA_ErrorCallback(uint32_t Instance);
+void     BSP_LCD_DMA_IRQHandler(uint32_t Instance);
+
+int32_t  BSP_LCD_TE_Init(uint32_t Instance, uint32_t Mode);
+int32_t  BSP_LCD_TE_DeInit(uint32_t Instance);
+int32_t  BSP_LCD_TE_Wait(uint32_t Instance);
+uint32_t BSP_LCD_TE_GetTick(uint32_t Instance);
+void     BSP_LCD_TE_Callback(uint32_t Instance);
+void     BSP_LCD_TE_IRQHandler(uint32_t Instance);
 
 #if (USE_HAL_SRAM_REGISTER_CALLBACKS == 1)
 int32_t  BSP_LCD_RegisterDefaultMspCallbacks(uint32_t Instance);
@@ -46,6 +46,14 @@
             - SPI : instruction, address and data on one line
             - STR OPI : instruction, address and data on eight lines with sampling on one edge of clock
             - DTR OPI : instruction, address and data on eight lines with sampling on both edgaes of clock
+       (++) Pages can be programmed without waiting for the end of programming: call
+            BSP_OSPI_NOR_IT_Init() and BSP_OSPI_NOR_IRQHandler() from the OCTOSPI1 interrupt
+            handler, then BSP_OSPI_NOR_Write_IT() programs one page and returns, the end of
+            programming is detected by the status match interrupt and reported by the
+            BSP_OSPI_NOR_WriteCpltCallback() weak callback. BSP_OSPI_NOR_SuspendWrite() stops
+            the polling and suspends the program (or erase) in progress so that the memory
+            can be read, BSP_OSPI_NOR_ResumeWrite() resumes it and restarts the polling.
+            While the polling runs, the other services fail with the peripheral busy.
 
   @endverbatim
   ******************************************************************************
@@ -112,6 +120,10 @@ static int32_t OSPI_NOR_ResetMemory  (uint32_t Instance);
 static int32_t OSPI_NOR_EnterDOPIMode(uint32_t Instance);
 static int32_t OSPI_NOR_EnterSOPIMode(uint32_t Instance);
 static int32_t OSPI_NOR_ExitOPIMode  (uint32_t Instance);
+#if (USE_HAL_OSPI_REGISTER_CALLBACKS == 1)
+static void    OSPI_NOR_StatusMatchCallback(OSPI_HandleTypeDef *hospi);
+static void    OSPI_NOR_ErrorCallback      (OSPI_HandleTypeDef *hospi);
+#endif /* (USE_HAL_OSPI_REGISTER_CALLBACKS == 1) */
 /**
   * @}
   */
@@ -861,6 +873,10 @@ int32_t BSP_OSPI_NOR_SuspendErase(uint32_t Instance)
     ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   else if(MX25LM51245G_Suspend(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }/* Wait for the suspend latency, the memory cannot be accessed before */
+  else if(MX25LM51245G_AutoPollingMemReady(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
   {
     ret = BSP_ERROR_COMPONENT_FAILURE;
   }
@@ -976,6 +992,233 @@ int32_t BSP_OSPI_NOR_LeaveDeepPowerDown(uint32_t Instance)
   /* Return BSP status */
   return ret;
 }
+
+/**
+  * @brief  Initializes the status match interrupt used by BSP_OSPI_NOR_Write_IT().
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_IT_Init(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+#if (USE_HAL_OSPI_REGISTER_CALLBACKS == 1)
+    if(HAL_OSPI_RegisterCallback(&hospi_nor[Instance], HAL_OSPI_STATUS_MATCH_CB_ID, OSPI_NOR_StatusMatchCallback) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else if(HAL_OSPI_RegisterCallback(&hospi_nor[Instance], HAL_OSPI_ERROR_CB_ID, OSPI_NOR_ErrorCallback) != HAL_OK)
+    {
+      ret = BSP_ERROR_PERIPH_FAILURE;
+    }
+    else
+#endif /* (USE_HAL_OSPI_REGISTER_CALLBACKS == 1) */
+    {
+      HAL_NVIC_SetPriority(OCTOSPI1_IRQn, BSP_OSPI_NOR_IT_PRIORITY, 0);
+      HAL_NVIC_EnableIRQ(OCTOSPI1_IRQn);
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  De-initializes the status match interrupt.
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_IT_DeInit(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    HAL_NVIC_DisableIRQ(OCTOSPI1_IRQn);
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Programs a page of the OSPI memory and starts the status match polling.
+  *         The memory must be ready. The end of programming is reported by
+  *         BSP_OSPI_NOR_WriteCpltCallback().
+  * @param  Instance  OSPI instance
+  * @param  pData     Pointer to data to be written
+  * @param  WriteAddr Write start address
+  * @param  Size      Size of data to write, within the page of WriteAddr
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_Write_IT(uint32_t Instance, uint8_t* pData, uint32_t WriteAddr, uint32_t Size)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported and the data fit in the page */
+  if((Instance >= OSPI_NOR_INSTANCES_NUMBER) || (Size == 0U) ||
+     (((WriteAddr % MX25LM51245G_PAGE_SIZE) + Size) > MX25LM51245G_PAGE_SIZE))
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }/* Enable write operations */
+  else if(MX25LM51245G_WriteEnable(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    if(Ospi_Nor_Ctx[Instance].TransferRate == BSP_OSPI_NOR_STR_TRANSFER)
+    {
+      /* Issue page program command */
+      if(MX25LM51245G_PageProgram(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, MX25LM51245G_4BYTES_SIZE, pData, WriteAddr, Size) != MX25LM51245G_OK)
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+    }
+    else
+    {
+      /* Issue page program command */
+      if(MX25LM51245G_PageProgramDTR(&hospi_nor[Instance], pData, WriteAddr, Size) != MX25LM51245G_OK)
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+    }
+
+    /* Configure automatic polling mode with interrupt to detect the end of program */
+    if((ret == BSP_ERROR_NONE) &&
+       (MX25LM51245G_AutoPollingMemReady_IT(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK))
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Stops the status match polling and suspends the program or erase in
+  *         progress. The memory can then be read until BSP_OSPI_NOR_ResumeWrite().
+  *         An operation already completed is not reported by the callback.
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_SuspendWrite(uint32_t Instance)
+{
+  int32_t ret;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if(HAL_OSPI_Abort(&hospi_nor[Instance]) != HAL_OK)
+  {
+    ret = BSP_ERROR_PERIPH_FAILURE;
+  }/* Ignored by the memory when the operation is already completed */
+  else if(MX25LM51245G_Suspend(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }/* Wait for the suspend latency */
+  else if(MX25LM51245G_AutoPollingMemReady(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
+  {
+    ret = BSP_ERROR_COMPONENT_FAILURE;
+  }
+  else
+  {
+    ret = BSP_ERROR_NONE;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  Resumes the operation suspended by BSP_OSPI_NOR_SuspendWrite(), if any,
+  *         and restarts the status match polling: the end of the operation is
+  *         then reported by BSP_OSPI_NOR_WriteCpltCallback().
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_ResumeWrite(uint32_t Instance)
+{
+  int32_t ret;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+    ret = BSP_OSPI_NOR_GetStatus(Instance);
+
+    if(ret == BSP_ERROR_OSPI_SUSPENDED)
+    {
+      if(MX25LM51245G_Resume(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
+      {
+        ret = BSP_ERROR_COMPONENT_FAILURE;
+      }
+      else
+      {
+        ret = BSP_ERROR_NONE;
+      }
+    }
+
+    if((ret == BSP_ERROR_NONE) &&
+       (MX25LM51245G_AutoPollingMemReady_IT(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK))
+    {
+      ret = BSP_ERROR_COMPONENT_FAILURE;
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
+/**
+  * @brief  OSPI NOR write complete callback, the memory is ready.
+  * @param  Instance  OSPI instance
+  * @retval None
+  */
+__weak void BSP_OSPI_NOR_WriteCpltCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+}
+
+/**
+  * @brief  OSPI NOR error callback.
+  * @param  Instance  OSPI instance
+  * @retval None
+  */
+__weak void BSP_OSPI_NOR_ErrorCallback(uint32_t Instance)
+{
+  /* Prevent unused argument(s) compilation warning */
+  UNUSED(Instance);
+}
+
+/**
+  * @brief  OSPI NOR interrupt handler.
+  * @param  Instance  OSPI instance
+  * @retval None
+  */
+void BSP_OSPI_NOR_IRQHandler(uint32_t Instance)
+{
+  HAL_OSPI_IRQHandler(&hospi_nor[Instance]);
+}
 /**
   * @}
   */
@@ -1367,6 +1610,60 @@ static int32_t OSPI_NOR_ExitOPIMode (uint32_t Instance)
   return ret;
 }
 
+#if (USE_HAL_OSPI_REGISTER_CALLBACKS == 1)
+/**
+  * @brief  OSPI status match callback.
+  * @param  hospi OSPI handle
+  * @retval None
+  */
+static void OSPI_NOR_StatusMatchCallback(OSPI_HandleTypeDef *hospi)
+{
+  if(hospi->Instance == OCTOSPI1)
+  {
+    BSP_OSPI_NOR_WriteCpltCallback(0);
+  }
+}
+
+/**
+  * @brief  OSPI error callback.
+  * @param  hospi OSPI handle
+  * @retval None
+  */
+static void OSPI_NOR_ErrorCallback(OSPI_HandleTypeDef *hospi)
+{
+  if(hospi->Instance == OCTOSPI1)
+  {
+    BSP_OSPI_NOR_ErrorCallback(0);
+  }
+}
+#else /* (USE_HAL_OSPI_REGISTER_CALLBACKS == 1) */
+/**
+  * @brief  OSPI status match callback.
+  * @param  hospi OSPI handle
+  * @retval None
+  */
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi)
+{
+  if(hospi->Instance == OCTOSPI1)
+  {
+    BSP_OSPI_NOR_WriteCpltCallback(0);
+  }
+}
+
+/**
+  * @brief  OSPI error callback.
+  * @param  hospi OSPI handle
+  * @retval None
+  */
+void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi)
+{
+  if(hospi->Instance == OCTOSPI1)
+  {
+    BSP_OSPI_NOR_ErrorCallback(0);
+  }
+}
+#endif /* (USE_HAL_OSPI_REGISTER_CALLBACKS == 1) */
+
 /**
   * @}
   */
@@ -176,6 +176,11 @@ typedef struct
   */
 #define OSPI_NOR_INSTANCES_NUMBER         1U
 
+/* OSPI NOR status match interrupt priority, for configuration files not defining it */
+#ifndef BSP_OSPI_NOR_IT_PRIORITY
+#define BSP_OSPI_NOR_IT_PRIORITY          0x07UL
+#endif
+
 /* Definition for OSPI modes */
 #define BSP_OSPI_NOR_SPI_MODE             (BSP_OSPI_NOR_Interface_t)MX25LM51245G_SPI_MODE      /* 1 Cmd Line, 1 Address Line and 1 Data Line    */
 #define BSP_OSPI_NOR_OPI_MODE             (BSP_OSPI_NOR_Interface_t)MX25LM51245G_OPI_MODE      /* 8 Cmd Lines, 8 Address Lines and 8 Data Lines */
@@ -231,6 +236,15 @@ int32_t BSP_OSPI_NOR_ResumeErase                 (uint32_t Instance);
 int32_t BSP_OSPI_NOR_EnterDeepPowerDown          (uint32_t Instance);
 int32_t BSP_OSPI_NOR_LeaveDeepPowerDown          (uint32_t Instance);
 
+int32_t BSP_OSPI_NOR_IT_Init                     (uint32_t Instance);
+int32_t BSP_OSPI_NOR_IT_DeInit                   (uint32_t Instance);
+int32_t BSP_OSPI_NOR_Write_IT                    (uint32_t Instance, uint8_t* pData, uint32_t WriteAddr, uint32_t Size);
+int32_t BSP_OSPI_NOR_SuspendWrite                (uint32_t Instance);
+int32_t BSP_OSPI_NOR_ResumeWrite                 (uint32_t Instance);
+void    BSP_OSPI_NOR_WriteCpltCallback           (uint32_t Instance);
+void    BSP_OSPI_NOR_ErrorCallback               (uint32_t Instance);
+void    BSP_OSPI_NOR_IRQHandler                  (uint32_t Instance);
+
 /* These functions can be modified in case the current settings
    need to be changed for specific application needs */
 HAL_StatusTypeDef MX_OSPI_NOR_Init(OSPI_HandleTypeDef *hospi, MX_OSPI_InitTypeDef *Init);
@@ -0,0 +1,183 @@
+/**
+  ******************************************************************************
+  * @file    bench_lcd.c
+  * @author  MCD Application Team
+  * @brief   Host runner of the stm32_lcd_bench.c drawing benchmark, over the
+  *          ST7789H2 driver and its simulated bus, in the 4 orientations.
+  *          Prints the CSV results of UTIL_LCD_BENCH_Run().
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+#include "stm32_lcd_bench.h"
+#include "st7789h2_sim.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define ITERATIONS  3U
+
+/* Private variables ---------------------------------------------------------*/
+static ST7789H2_Object_t Lcd;
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  return ST7789H2_DrawBitmap(&Lcd, Xpos, Ypos, pBmp);
+}
+
+static int32_t FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  (void)Instance;
+  return ST7789H2_FillRGBRect(&Lcd, Xpos, Ypos, pData, Width, Height);
+}
+
+static int32_t DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawHLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawVLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_FillRect(&Lcd, Xpos, Ypos, Width, Height, Color);
+}
+
+static int32_t GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  return ST7789H2_GetPixel(&Lcd, Xpos, Ypos, pColor);
+}
+
+static int32_t SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_SetPixel(&Lcd, Xpos, Ypos, Color);
+}
+
+static int32_t GetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  return ST7789H2_GetXSize(&Lcd, pXSize);
+}
+
+static int32_t GetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  return ST7789H2_GetYSize(&Lcd, pYSize);
+}
+
+static int32_t SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t GetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t LcdDriver =
+{
+  DrawBitmap,
+  FillRGBRect,
+  DrawHLine,
+  DrawVLine,
+  FillRect,
+  GetPixel,
+  SetPixel,
+  GetXSize,
+  GetYSize,
+  SetLayer,
+  GetFormat
+};
+
+/* Restart the simulated panel in the given orientation */
+static int32_t SetOrientation(uint32_t Orientation)
+{
+  ST7789H2_IO_t io;
+  int32_t       ret;
+
+  (void)memset(&Lcd, 0, sizeof(Lcd));
+  ret = ST7789H2_SIM_Init(&io);
+  if (ret == ST7789H2_OK)
+  {
+    ret = ST7789H2_RegisterBusIO(&Lcd, &io);
+  }
+  if (ret == ST7789H2_OK)
+  {
+    ret = ST7789H2_Init(&Lcd, ST7789H2_FORMAT_RBG565, Orientation);
+  }
+
+  return ret;
+}
+
+static void GetBus(UTIL_LCD_BENCH_Bus_t *pBus)
+{
+  ST7789H2_SIM_Stats_t stats;
+
+  ST7789H2_SIM_GetStats(&stats);
+  pBus->Commands   = stats.Commands;
+  pBus->DataWrites = stats.DataWrites;
+  pBus->DataReads  = stats.DataReads;
+}
+
+static uint32_t GetTime(void)
+{
+  return (uint32_t)(((unsigned long long)clock() * 1000000ULL) / (unsigned long long)CLOCKS_PER_SEC);
+}
+
+static void Output(const char *pLine)
+{
+  (void)fputs(pLine, stdout);
+}
+
+int main(void)
+{
+  UTIL_LCD_BENCH_Init_t init;
+  int32_t               ret;
+
+  (void)memset(&init, 0, sizeof(init));
+  init.pDrv           = &LcdDriver;
+  init.Orientations   = 4U;
+  init.SetOrientation = SetOrientation;
+  init.GetBus         = GetBus;
+  init.GetTime        = GetTime;
+  init.Output         = Output;
+  init.Iterations     = ITERATIONS;
+
+  ret = SetOrientation(ST7789H2_ORIENTATION_PORTRAIT);
+  if (ret == ST7789H2_OK)
+  {
+    ret = UTIL_LCD_BENCH_Run(&init);
+  }
+
+  return (ret == 0) ? 0 : 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
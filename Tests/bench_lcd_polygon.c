@@ -0,0 +1,461 @@
+/**
+  ******************************************************************************
+  * @file    bench_lcd_polygon.c
+  * @author  MCD Application Team
+  * @brief   Host span-count benchmark of the stm32_lcd.c polygon, circle and
+  *          ellipse fills. For each shape, prints one CSV line with the driver
+  *          calls, the minimum number of spans (one per row interval), the
+  *          pixels drawn, the overdrawn pixels and the host time per fill.
+  *          Polygons are also filled by a copy of the original triangle fan
+  *          UTIL_LCD_FillPolygon(), whose calls, pixels, overdraw and time
+  *          are printed in the ref_ columns (empty for circles and ellipses).
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define DISPLAY_WIDTH   240U
+#define DISPLAY_HEIGHT  240U
+#define REPEAT          200U
+
+/* Private types -------------------------------------------------------------*/
+typedef enum
+{
+  SHAPE_POLYGON,
+  SHAPE_CIRCLE,
+  SHAPE_ELLIPSE
+} Shape_t;
+
+typedef struct
+{
+  const char *pName;
+  Shape_t     Shape;
+  uint32_t    Rule;
+  const Point *pPoints;
+  uint32_t    PointCount;
+  int32_t     Radius1;
+  int32_t     Radius2;
+} Case_t;
+
+typedef struct
+{
+  int32_t x1;
+  int32_t y1;
+  int32_t x2;
+  int32_t y2;
+  int32_t x3;
+  int32_t y3;
+} Triangle_t;
+
+typedef struct
+{
+  uint32_t Calls;
+  uint32_t Pixels;
+  uint32_t Overdraw;
+  double   Time;
+} Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t  Drawn[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+static uint32_t Calls;
+static uint32_t Pixels;
+static uint32_t Overdraw;
+static uint32_t Counting;
+
+static const Point Square[]  = {{20, 20}, {220, 20}, {220, 220}, {20, 220}};
+static const Point Star[]    = {{120, 10}, {185, 225}, {15, 90}, {225, 90}, {55, 225}};
+static const Point Concave[] = {{5, 5}, {235, 5}, {235, 235}, {120, 30}, {5, 235}};
+static Point Gon40[40];
+static Point Random12[12];
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  uint32_t i;
+
+  (void)Instance;
+  (void)Color;
+
+  if (Counting != 0U)
+  {
+    Calls++;
+    for (i = 0U; (i < Length) && ((Xpos + i) < DISPLAY_WIDTH) && (Ypos < DISPLAY_HEIGHT); i++)
+    {
+      Overdraw += (Drawn[Ypos][Xpos + i] != 0U) ? 1U : 0U;
+      Drawn[Ypos][Xpos + i] = 1U;
+      Pixels++;
+    }
+  }
+
+  return 0;
+}
+
+static int32_t SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return DrawHLine(Instance, Xpos, Ypos, 1U, Color);
+}
+
+static int32_t DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  uint32_t i;
+
+  for (i = 0U; i < Length; i++)
+  {
+    (void)SetPixel(Instance, Xpos, Ypos + i, Color);
+  }
+  return 0;
+}
+
+static int32_t FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  uint32_t i;
+
+  for (i = 0U; i < Height; i++)
+  {
+    (void)DrawHLine(Instance, Xpos, Ypos + i, Width, Color);
+  }
+  return 0;
+}
+
+static int32_t GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  (void)Instance;
+  *XSize = DISPLAY_WIDTH;
+  return 0;
+}
+
+static int32_t GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  (void)Instance;
+  *YSize = DISPLAY_HEIGHT;
+  return 0;
+}
+
+static int32_t SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  (void)Instance;
+  *Format = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t BenchDriver =
+{
+  NULL,
+  NULL,
+  DrawHLine,
+  DrawVLine,
+  FillRect,
+  NULL,
+  SetPixel,
+  GetXSize,
+  GetYSize,
+  SetLayer,
+  GetFormat
+};
+
+/*
+ * Original polygon fill, before the scanline fill: a fan of 3 triangles per
+ * edge around the bounding box center, each triangle drawn as one
+ * Bresenham line per pixel of its first edge, each line pixel by pixel.
+ */
+static void RefDrawLine(int32_t Xpos1, int32_t Ypos1, int32_t Xpos2, int32_t Ypos2)
+{
+  int32_t deltax, deltay, x, y, xinc1, xinc2, yinc1, yinc2, den, num, numadd, numpixels, curpixel;
+
+  deltax = abs(Xpos2 - Xpos1);
+  deltay = abs(Ypos2 - Ypos1);
+  x = Xpos1;
+  y = Ypos1;
+  xinc1 = (Xpos2 >= Xpos1) ? 1 : -1;
+  xinc2 = xinc1;
+  yinc1 = (Ypos2 >= Ypos1) ? 1 : -1;
+  yinc2 = yinc1;
+
+  if (deltax >= deltay)
+  {
+    xinc1 = 0;
+    yinc2 = 0;
+    den = deltax;
+    num = deltax / 2;
+    numadd = deltay;
+    numpixels = deltax;
+  }
+  else
+  {
+    xinc2 = 0;
+    yinc1 = 0;
+    den = deltay;
+    num = deltay / 2;
+    numadd = deltax;
+    numpixels = deltay;
+  }
+
+  for (curpixel = 0; curpixel <= numpixels; curpixel++)
+  {
+    UTIL_LCD_SetPixel((uint32_t)x, (uint32_t)y, 0xFFFFFFFFU);
+    num += numadd;
+    if (num >= den)
+    {
+      num -= den;
+      x += xinc1;
+      y += yinc1;
+    }
+    x += xinc2;
+    y += yinc2;
+  }
+}
+
+static void RefFillTriangle(const Triangle_t *pPositions)
+{
+  int32_t deltax, deltay, x, y, xinc1, xinc2, yinc1, yinc2, den, num, numadd, numpixels, curpixel;
+
+  deltax = abs(pPositions->x2 - pPositions->x1);
+  deltay = abs(pPositions->y2 - pPositions->y1);
+  x = pPositions->x1;
+  y = pPositions->y1;
+  xinc1 = (pPositions->x2 >= pPositions->x1) ? 1 : -1;
+  xinc2 = xinc1;
+  yinc1 = (pPositions->y2 >= pPositions->y1) ? 1 : -1;
+  yinc2 = yinc1;
+
+  if (deltax >= deltay)
+  {
+    xinc1 = 0;
+    yinc2 = 0;
+    den = deltax;
+    num = deltax / 2;
+    numadd = deltay;
+    numpixels = deltax;
+  }
+  else
+  {
+    xinc2 = 0;
+    yinc1 = 0;
+    den = deltay;
+    num = deltay / 2;
+    numadd = deltax;
+    numpixels = deltay;
+  }
+
+  for (curpixel = 0; curpixel <= numpixels; curpixel++)
+  {
+    RefDrawLine(x, y, pPositions->x3, pPositions->y3);
+    num += numadd;
+    if (num >= den)
+    {
+      num -= den;
+      x += xinc1;
+      y += yinc1;
+    }
+    x += xinc2;
+    y += yinc2;
+  }
+}
+
+static void RefFillPolygon(const Point *pPoints, uint32_t PointCount)
+{
+  int32_t    left, right, top, bottom, x_center, y_center, x, y, x2 = 0, y2 = 0;
+  uint32_t   i;
+  Triangle_t positions;
+
+  if (PointCount >= 2U)
+  {
+    left = right = pPoints[0].X;
+    top = bottom = pPoints[0].Y;
+    for (i = 1U; i < PointCount; i++)
+    {
+      left   = (pPoints[i].X < left)   ? pPoints[i].X : left;
+      right  = (pPoints[i].X > right)  ? pPoints[i].X : right;
+      top    = (pPoints[i].Y < top)    ? pPoints[i].Y : top;
+      bottom = (pPoints[i].Y > bottom) ? pPoints[i].Y : bottom;
+    }
+    x_center = (left + right) / 2;
+    y_center = (bottom + top) / 2;
+
+    /* Edges i-1 to i, then the closing edge from the last point to the first */
+    for (i = 1U; i <= PointCount; i++)
+    {
+      x  = (i < PointCount) ? pPoints[i - 1U].X : pPoints[0].X;
+      y  = (i < PointCount) ? pPoints[i - 1U].Y : pPoints[0].Y;
+      x2 = (i < PointCount) ? pPoints[i].X : x2;
+      y2 = (i < PointCount) ? pPoints[i].Y : y2;
+
+      positions.x1 = x;
+      positions.y1 = y;
+      positions.x2 = x2;
+      positions.y2 = y2;
+      positions.x3 = x_center;
+      positions.y3 = y_center;
+      RefFillTriangle(&positions);
+
+      positions.x2 = x_center;
+      positions.y2 = y_center;
+      positions.x3 = x2;
+      positions.y3 = y2;
+      RefFillTriangle(&positions);
+
+      positions.x1 = x_center;
+      positions.y1 = y_center;
+      positions.x2 = x2;
+      positions.y2 = y2;
+      positions.x3 = x;
+      positions.y3 = y;
+      RefFillTriangle(&positions);
+    }
+  }
+}
+
+static void Draw(const Case_t *pCase, uint32_t Reference)
+{
+  switch (pCase->Shape)
+  {
+  case SHAPE_CIRCLE:
+    UTIL_LCD_FillCircle(120U, 120U, (uint32_t)pCase->Radius1, 0xFFFFFFFFU);
+    break;
+  case SHAPE_ELLIPSE:
+    UTIL_LCD_FillEllipse(120, 120, pCase->Radius1, pCase->Radius2, 0xFFFFFFFFU);
+    break;
+  case SHAPE_POLYGON:
+  default:
+    if (Reference != 0U)
+    {
+      RefFillPolygon(pCase->pPoints, pCase->PointCount);
+    }
+    else
+    {
+      UTIL_LCD_FillPolygonEx((pPoint)pCase->pPoints, pCase->PointCount, pCase->Rule, 0xFFFFFFFFU);
+    }
+    break;
+  }
+}
+
+/* Count the driver calls and pixels of one fill, then time it */
+static void Measure(const Case_t *pCase, uint32_t Reference, Result_t *pResult)
+{
+  uint32_t i;
+  clock_t  start;
+
+  (void)memset(Drawn, 0, sizeof(Drawn));
+  Calls    = 0U;
+  Pixels   = 0U;
+  Overdraw = 0U;
+  Counting = 1U;
+  Draw(pCase, Reference);
+  Counting = 0U;
+  pResult->Calls    = Calls;
+  pResult->Pixels   = Pixels;
+  pResult->Overdraw = Overdraw;
+
+  start = clock();
+  for (i = 0U; i < REPEAT; i++)
+  {
+    Draw(pCase, Reference);
+  }
+  pResult->Time = ((double)(clock() - start) * 1000000.0) / ((double)CLOCKS_PER_SEC * REPEAT);
+}
+
+static void Run(const Case_t *pCase)
+{
+  uint32_t x, y, spans = 0U;
+  Result_t result, ref;
+
+  Measure(pCase, 0U, &result);
+
+  /* Minimum: one span per interval of each row */
+  for (y = 0U; y < DISPLAY_HEIGHT; y++)
+  {
+    for (x = 0U; x < DISPLAY_WIDTH; x++)
+    {
+      if ((Drawn[y][x] != 0U) && ((x == 0U) || (Drawn[y][x - 1U] == 0U)))
+      {
+        spans++;
+      }
+    }
+  }
+
+  (void)printf("polygon,%s,%s,%lu,%lu,%lu,%lu,%lu,%.2f", pCase->pName,
+               (pCase->Rule == UTIL_LCD_FILL_RULE_EVENODD) ? "evenodd" : "nonzero",
+               (unsigned long)pCase->PointCount, (unsigned long)result.Calls, (unsigned long)spans,
+               (unsigned long)result.Pixels, (unsigned long)result.Overdraw, result.Time);
+  if (pCase->Shape == SHAPE_POLYGON)
+  {
+    Measure(pCase, 1U, &ref);
+    (void)printf(",%lu,%lu,%lu,%.2f\n", (unsigned long)ref.Calls, (unsigned long)ref.Pixels,
+                 (unsigned long)ref.Overdraw, ref.Time);
+  }
+  else
+  {
+    (void)printf(",,,,\n");
+  }
+}
+
+int main(void)
+{
+  static const int8_t cosine[40] =
+  {
+    100, 98, 95, 89, 80, 70, 58, 45, 30, 15,  0,-15,-30,-45,-58,-70,-80,-89,-95,-98,
+   -100,-98,-95,-89,-80,-70,-58,-45,-30,-15,  0, 15, 30, 45, 58, 70, 80, 89, 95, 98
+  };
+  Case_t cases[] =
+  {
+    {"square",   SHAPE_POLYGON, UTIL_LCD_FILL_RULE_NONZERO, Square,   4U,  0,  0},
+    {"star",     SHAPE_POLYGON, UTIL_LCD_FILL_RULE_NONZERO, Star,     5U,  0,  0},
+    {"star",     SHAPE_POLYGON, UTIL_LCD_FILL_RULE_EVENODD, Star,     5U,  0,  0},
+    {"concave",  SHAPE_POLYGON, UTIL_LCD_FILL_RULE_NONZERO, Concave,  5U,  0,  0},
+    {"random12", SHAPE_POLYGON, UTIL_LCD_FILL_RULE_EVENODD, Random12, 12U, 0,  0},
+    {"40-gon",   SHAPE_POLYGON, UTIL_LCD_FILL_RULE_NONZERO, Gon40,    40U, 0,  0},
+    {"circle",   SHAPE_CIRCLE,  UTIL_LCD_FILL_RULE_NONZERO, NULL,     0U,  100, 0},
+    {"circle",   SHAPE_CIRCLE,  UTIL_LCD_FILL_RULE_NONZERO, NULL,     0U,  10, 0},
+    {"ellipse",  SHAPE_ELLIPSE, UTIL_LCD_FILL_RULE_NONZERO, NULL,     0U,  110, 60},
+  };
+  uint32_t i;
+
+  for (i = 0U; i < 40U; i++)
+  {
+    Gon40[i].X = (int16_t)(120 + cosine[i]);
+    Gon40[i].Y = (int16_t)(120 + cosine[(i + 30U) % 40U]);
+  }
+  srand(12U);
+  for (i = 0U; i < 12U; i++)
+  {
+    Random12[i].X = (int16_t)(rand() % (int32_t)DISPLAY_WIDTH);
+    Random12[i].Y = (int16_t)(rand() % (int32_t)DISPLAY_HEIGHT);
+  }
+
+  UTIL_LCD_SetFuncDriver(&BenchDriver);
+
+  (void)printf("bench,shape,rule,points,calls,min_spans,pixels,overdraw,time_us,"
+               "ref_calls,ref_pixels,ref_overdraw,ref_time_us\n");
+  for (i = 0U; i < (sizeof(cases) / sizeof(cases[0])); i++)
+  {
+    Run(&cases[i]);
+  }
+
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,207 @@
+/**
+  ******************************************************************************
+  * @file    bench_nor_cache.c
+  * @author  MCD Application Team
+  * @brief   Host runner of the stm32_nor_cache_bench.c read cache benchmark,
+  *          over the MX25LM51245G component functions and its simulated
+  *          memory, in DTR OPI mode as set by BSP_OSPI_NOR_Init().
+  *          Prints the CSV results of UTIL_NOR_CACHE_BENCH_Run(), timed in
+  *          simulated memory bus time.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_cache.h"
+#include "stm32_nor_cache_bench.h"
+#include "mx25lm51245g_sim.h"
+#include <stdio.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_ADDRESS   0x00200000U  /* Aligned on UTIL_NOR_CACHE_BENCH_AREA_SIZE */
+#define FLASH_OK        0            /* BSP_ERROR_NONE                */
+#define FLASH_ERROR     (-5)         /* BSP_ERROR_COMPONENT_FAILURE   */
+#define FLASH_SUSPENDED (-20)        /* BSP_ERROR_OSPI_SUSPENDED      */
+#define MODE            MX25LM51245G_OPI_MODE
+#define RATE            MX25LM51245G_DTR_TRANSFER
+
+/* Private variables ---------------------------------------------------------*/
+static OSPI_HandleTypeDef Ospi;
+
+/* Private functions ---------------------------------------------------------*/
+/* Flash services as BSP_OSPI_NOR_xxx() runs them on the component */
+static int32_t FlashRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return (MX25LM51245G_ReadDTR(&Ospi, pData, Address, Size) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashWrite(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t  ret = FLASH_OK;
+  uint32_t size;
+
+  (void)Instance;
+  while ((Size != 0U) && (ret == FLASH_OK))
+  {
+    size = MX25LM51245G_PAGE_SIZE - (Address % MX25LM51245G_PAGE_SIZE);
+    size = (size > Size) ? Size : size;
+    if ((MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_PageProgramDTR(&Ospi, pData, Address, size) != MX25LM51245G_OK) ||
+        (MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK))
+    {
+      ret = FLASH_ERROR;
+    }
+    Address += size;
+    pData   += size;
+    Size    -= size;
+  }
+
+  return ret;
+}
+
+/* BSP_OSPI_NOR_Erase_Block() takes an erase type instead of a size */
+static int32_t FlashErase(uint32_t Instance, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return ((MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_BlockErase(&Ospi, MODE, RATE, MX25LM51245G_4BYTES_SIZE, Address,
+                                   (Size == 65536U) ? MX25LM51245G_ERASE_64K : MX25LM51245G_ERASE_4K) == MX25LM51245G_OK)) ?
+         FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashGetStatus(uint32_t Instance)
+{
+  int32_t ret;
+  uint8_t reg[2];
+
+  (void)Instance;
+  if ((MX25LM51245G_ReadSecurityRegister(&Ospi, MODE, RATE, reg) != MX25LM51245G_OK) ||
+      ((reg[0] & (MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL)) != 0U))
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & (MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB)) != 0U)
+  {
+    ret = FLASH_SUSPENDED;
+  }
+  else if (MX25LM51245G_ReadStatusRegister(&Ospi, MODE, RATE, reg) != MX25LM51245G_OK)
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    ret = ((reg[0] & MX25LM51245G_SR_WIP) != 0U) ? UTIL_NOR_CACHE_FLASH_BUSY : FLASH_OK;
+  }
+
+  return ret;
+}
+
+static int32_t FlashEnableMapped(uint32_t Instance)
+{
+  (void)Instance;
+  return (MX25LM51245G_EnableMemoryMappedModeDTR(&Ospi, MODE) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashDisableMapped(uint32_t Instance)
+{
+  (void)Instance;
+  MX25LM51245G_SIM_Abort();
+  return FLASH_OK;
+}
+
+static int32_t FlashReadMapped(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return (MX25LM51245G_SIM_ReadMemoryMapped(pData, Address, Size) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static const UTIL_NOR_CACHE_Flash_t Flash =
+{
+  FlashRead,
+  FlashWrite,
+  FlashErase,
+  FlashGetStatus,
+  FlashEnableMapped,
+  FlashDisableMapped,
+  FlashReadMapped,
+  NULL,
+  NULL
+};
+
+/* Switch the memory from SPI to DTR OPI mode, as OSPI_NOR_EnterDOPIMode() */
+static int32_t EnterDOPIMode(void)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  if ((MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG3_ADDR,
+                                      MX25LM51245G_CR2_DC_6_CYCLES) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG1_ADDR,
+                                      MX25LM51245G_CR2_DOPI) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    MX25LM51245G_SIM_Wait(MX25LM51245G_WRITE_REG_MAX_TIME * 1000U);
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_ReadCfg2Register(&Ospi, MODE, RATE, MX25LM51245G_CR2_REG1_ADDR, reg) != MX25LM51245G_OK) ||
+        (reg[0] != MX25LM51245G_CR2_DOPI))
+    {
+      ret = FLASH_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+static uint32_t GetTime(void)
+{
+  return (uint32_t)(MX25LM51245G_SIM_GetTime() / 1000U);
+}
+
+static void Output(const char *pLine)
+{
+  (void)fputs(pLine, stdout);
+}
+
+int main(void)
+{
+  UTIL_NOR_CACHE_BENCH_Init_t init;
+  int32_t                     ret;
+
+  init.pFlash     = &Flash;
+  init.Instance   = 0U;
+  init.Address    = BENCH_ADDRESS;
+  init.GetTime    = GetTime;
+  init.Output     = Output;
+  init.Iterations = 0U;
+
+  ret = MX25LM51245G_SIM_Init(NULL);
+  if (ret == MX25LM51245G_OK)
+  {
+    ret = EnterDOPIMode();
+  }
+  if (ret == FLASH_OK)
+  {
+    ret = UTIL_NOR_CACHE_BENCH_Run(&init);
+  }
+  (void)MX25LM51245G_SIM_DeInit();
+
+  return (ret == 0) ? 0 : 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
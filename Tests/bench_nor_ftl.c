@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * @file    bench_nor_ftl.c
+  * @author  MCD Application Team
+  * @brief   Host write amplification and wear benchmark of the stm32_nor_ftl.c
+  *          flash translation layer over the RAM flash of nor_ftl_ram.c. Runs
+  *          the workload of test_nor_ftl.c: 20000 writes, 90% of them on 10%
+  *          of the logical pages, UTIL_NOR_FTL_Background() run until idle
+  *          every 8 writes; then the same without background steps. For each
+  *          workload, prints one CSV line with the statistics, the write
+  *          amplification FlashWrites / HostWrites and the erase count spread
+  *          MaxEraseCount - MinEraseCount.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nor_ftl_ram.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BLOCKS          16U
+#define CAPACITY        UTIL_NOR_FTL_CAPACITY(BLOCKS)
+#define WRITES          20000U
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  const char *pName;
+  uint32_t    HotPercent;       /* Percent of the writes on the first 10% of the pages */
+  uint32_t    BackgroundEvery;  /* Writes between background runs, 0 for none */
+} Workload_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t              Flash[BLOCKS * UTIL_NOR_FTL_BLOCK_SIZE];
+static uint32_t             Map[CAPACITY];
+static UTIL_NOR_FTL_Block_t Blocks[BLOCKS];
+
+static const Workload_t Workloads[] =
+{
+  {"hot_cold_bg8",   90U, 8U},
+  {"hot_cold_no_bg", 90U, 0U}
+};
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t Run(const Workload_t *pWorkload)
+{
+  int32_t  ret;
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t n, page;
+  UTIL_NOR_FTL_Init_t  init;
+  UTIL_NOR_FTL_Stats_t stats;
+
+  (void)memset(Flash, 0, sizeof(Flash));
+  init.pFlash       = &NorFtlRam;
+  init.Instance     = 0U;
+  init.Address      = 0U;
+  init.BlockCount   = BLOCKS;
+  init.LogicalPages = CAPACITY;
+  init.pMap         = Map;
+  init.pBlocks      = Blocks;
+  ret = NorFtlRam_Init(Flash, sizeof(Flash));
+  if (ret == UTIL_NOR_FTL_OK)
+  {
+    ret = UTIL_NOR_FTL_Init(&init);
+  }
+  if (ret == UTIL_NOR_FTL_OK)
+  {
+    ret = UTIL_NOR_FTL_Format();
+  }
+  UTIL_NOR_FTL_ResetStats();
+
+  srand(1U);
+  for (n = 0U; (n < WRITES) && (ret == UTIL_NOR_FTL_OK); n++)
+  {
+    page = (((uint32_t)rand() % 100U) < pWorkload->HotPercent) ? ((uint32_t)rand() % (CAPACITY / 10U))
+           : ((uint32_t)rand() % CAPACITY);
+    (void)memset(data, (int)(n & 0xFFU), sizeof(data));
+    ret = UTIL_NOR_FTL_Write(page, data);
+    if ((pWorkload->BackgroundEvery != 0U) && ((n % pWorkload->BackgroundEvery) == 0U))
+    {
+      while ((ret == UTIL_NOR_FTL_OK) && (UTIL_NOR_FTL_Background() == UTIL_NOR_FTL_OK))
+      {
+      }
+    }
+  }
+
+  if (ret == UTIL_NOR_FTL_OK)
+  {
+    UTIL_NOR_FTL_GetStats(&stats);
+    (void)printf("%s,%u,%u,%.3f,%u,%u,%u,%u,%u,%u\n", pWorkload->pName, (unsigned int)stats.HostWrites,
+                 (unsigned int)stats.FlashWrites, (double)stats.FlashWrites / (double)stats.HostWrites,
+                 (unsigned int)stats.Erases, (unsigned int)stats.GcRuns, (unsigned int)stats.WlRuns,
+                 (unsigned int)stats.MinEraseCount, (unsigned int)stats.MaxEraseCount,
+                 (unsigned int)(stats.MaxEraseCount - stats.MinEraseCount));
+  }
+  else
+  {
+    (void)printf("%s: write %u failed\n", pWorkload->pName, (unsigned int)n);
+  }
+
+  return ret;
+}
+
+int main(void)
+{
+  int32_t  ret = UTIL_NOR_FTL_OK;
+  uint32_t i;
+
+  (void)printf("workload,host_writes,flash_writes,write_amplification,erases,gc_runs,wl_runs,"
+               "min_erase_count,max_erase_count,erase_spread\n");
+  for (i = 0U; (i < (sizeof(Workloads) / sizeof(Workloads[0]))) && (ret == UTIL_NOR_FTL_OK); i++)
+  {
+    ret = Run(&Workloads[i]);
+  }
+
+  return (ret == UTIL_NOR_FTL_OK) ? 0 : 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
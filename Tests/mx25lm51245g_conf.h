@@ -0,0 +1,25 @@
+/**
+  ******************************************************************************
+  * @file    mx25lm51245g_conf.h
+  * @author  MCD Application Team
+  * @brief   MX25LM51245G OctoSPI memory configuration file of the host tests
+  *          and benchmarks: the configuration of the mx25lm51245g_sim.c
+  *          simulated memory.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Recursive inclusion is prevented by mx25lm51245g_conf_sim.h */
+#include "mx25lm51245g_conf_sim.h"
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,205 @@
+/**
+  ******************************************************************************
+  * @file    nor_ftl_ram.c
+  * @author  MCD Application Team
+  * @brief   Flash held in RAM for the host tests and benchmarks of the
+  *          stm32_nor_ftl.c flash translation layer. It keeps the NOR
+  *          semantics: programs only clear bits, a program setting a bit
+  *          back to 1 is counted as a violation and fails, erases are done on
+  *          aligned UTIL_NOR_FTL_BLOCK_SIZE blocks. NorFtlRam_PowerCut()
+  *          interrupts a later program or erase halfway, to check power loss
+  *          recovery.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nor_ftl_ram.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  uint8_t           *pMemory;
+  uint32_t           Size;
+  uint32_t           PowerCut;    /* Operations left before the power cut, 0 when disabled */
+  uint32_t           PoweredOff;
+  NorFtlRam_Stats_t  Stats;
+} NorFtlRam_Ctx_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static int32_t  RamRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size);
+static int32_t  RamWrite(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size);
+static int32_t  RamErase(uint32_t Instance, uint32_t Address);
+static uint32_t RamPowerCut(void);
+
+/* Private variables ---------------------------------------------------------*/
+static NorFtlRam_Ctx_t RamCtx;
+
+/* Exported variables --------------------------------------------------------*/
+const UTIL_NOR_FTL_Flash_t NorFtlRam =
+{
+  RamRead,
+  RamWrite,
+  RamErase
+};
+
+/* Exported functions --------------------------------------------------------*/
+/* Initialize the RAM flash. Its content is kept, so that a flash image can be
+   mounted again after a simulated power cut. Size is a multiple of
+   UTIL_NOR_FTL_BLOCK_SIZE. */
+int32_t NorFtlRam_Init(uint8_t *pMemory, uint32_t Size)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+
+  if ((pMemory == NULL) || (Size == 0U) || ((Size % UTIL_NOR_FTL_BLOCK_SIZE) != 0U))
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    RamCtx.pMemory    = pMemory;
+    RamCtx.Size       = Size;
+    RamCtx.PowerCut   = 0U;
+    RamCtx.PoweredOff = 0U;
+    (void)memset(&RamCtx.Stats, 0, sizeof(RamCtx.Stats));
+  }
+
+  return ret;
+}
+
+/* Schedule a power cut: the given program or erase operation, counting from 1,
+   is done halfway, then all operations fail until the next call. 0 restores
+   the power. */
+void NorFtlRam_PowerCut(uint32_t Operations)
+{
+  RamCtx.PowerCut   = Operations;
+  RamCtx.PoweredOff = 0U;
+}
+
+void NorFtlRam_GetStats(NorFtlRam_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = RamCtx.Stats;
+  }
+}
+
+/* Private functions ---------------------------------------------------------*/
+/* Count a program or erase operation against the scheduled power cut, 1 when
+   the operation is interrupted */
+static uint32_t RamPowerCut(void)
+{
+  uint32_t ret = 0U;
+
+  if (RamCtx.PowerCut != 0U)
+  {
+    RamCtx.PowerCut--;
+    if (RamCtx.PowerCut == 0U)
+    {
+      RamCtx.PoweredOff = 1U;
+      ret = 1U;
+    }
+  }
+
+  return ret;
+}
+
+/* Read, -1 on a range error or when powered off */
+static int32_t RamRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t ret = 0;
+
+  (void)Instance;
+
+  if ((RamCtx.PoweredOff != 0U) || (Address > RamCtx.Size) || (Size > (RamCtx.Size - Address)))
+  {
+    ret = -1;
+  }
+  else
+  {
+    (void)memcpy(pData, &RamCtx.pMemory[Address], Size);
+    RamCtx.Stats.Reads++;
+    RamCtx.Stats.ReadBytes += Size;
+  }
+
+  return ret;
+}
+
+/* Program, the data is ANDed with the flash content. -1 on a range error, a
+   0 to 1 transition or a power cut. */
+static int32_t RamWrite(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t ret = 0;
+  uint32_t length = Size;
+  uint32_t violation = 0U;
+  uint32_t i;
+
+  (void)Instance;
+
+  if ((RamCtx.PoweredOff != 0U) || (Address > RamCtx.Size) || (Size > (RamCtx.Size - Address)))
+  {
+    ret = -1;
+  }
+  else
+  {
+    if (RamPowerCut() != 0U)
+    {
+      length = Size / 2U;
+      ret = -1;
+    }
+    for (i = 0U; i < length; i++)
+    {
+      violation |= (uint32_t)pData[i] & ~(uint32_t)RamCtx.pMemory[Address + i];
+      RamCtx.pMemory[Address + i] &= pData[i];
+    }
+    if (violation != 0U)
+    {
+      RamCtx.Stats.Violations++;
+      ret = -1;
+    }
+    RamCtx.Stats.Programs++;
+    RamCtx.Stats.ProgramBytes += length;
+  }
+
+  return ret;
+}
+
+/* Erase of a UTIL_NOR_FTL_BLOCK_SIZE block. -1 on a range or alignment error
+   or a power cut. */
+static int32_t RamErase(uint32_t Instance, uint32_t Address)
+{
+  int32_t ret = 0;
+  uint32_t length = UTIL_NOR_FTL_BLOCK_SIZE;
+
+  (void)Instance;
+
+  if ((RamCtx.PoweredOff != 0U) || ((Address % UTIL_NOR_FTL_BLOCK_SIZE) != 0U) || (Address >= RamCtx.Size))
+  {
+    ret = -1;
+  }
+  else
+  {
+    if (RamPowerCut() != 0U)
+    {
+      length = UTIL_NOR_FTL_BLOCK_SIZE / 2U;
+      ret = -1;
+    }
+    (void)memset(&RamCtx.pMemory[Address], 0xFF, length);
+    RamCtx.Stats.Erases++;
+  }
+
+  return ret;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    nor_ftl_ram.h
+  * @author  MCD Application Team
+  * @brief   Flash held in RAM for the host tests and benchmarks of the
+  *          stm32_nor_ftl.c flash translation layer.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NOR_FTL_RAM_H
+#define NOR_FTL_RAM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_ftl.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* RAM flash statistics */
+typedef struct
+{
+  uint32_t Reads;         /* Read operations                                    */
+  uint32_t Programs;      /* Program operations                                 */
+  uint32_t Erases;        /* Erase operations                                   */
+  uint32_t ReadBytes;     /* Bytes read                                         */
+  uint32_t ProgramBytes;  /* Bytes programmed                                   */
+  uint32_t Violations;    /* Programs rejected for turning a 0 bit back to 1    */
+} NorFtlRam_Stats_t;
+
+/* Exported variables --------------------------------------------------------*/
+/* Flash services of the RAM flash, for UTIL_NOR_FTL_Init_t.pFlash */
+extern const UTIL_NOR_FTL_Flash_t NorFtlRam;
+
+/* Exported functions --------------------------------------------------------*/
+int32_t NorFtlRam_Init(uint8_t *pMemory, uint32_t Size);
+void    NorFtlRam_PowerCut(uint32_t Operations);
+void    NorFtlRam_GetStats(NorFtlRam_Stats_t *pStats);
+
+#endif /* NOR_FTL_RAM_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    test.h
+  * @author  MCD Application Team
+  * @brief   Checks shared by the host tests of the utilities and components.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_H
+#define TEST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+/* Number of failed checks, defined by TEST_MAIN in each test */
+extern uint32_t TestFailures;
+
+/* Record a failed check with its location, the test goes on */
+#define TEST_CHECK(cond)                                                      \
+  do                                                                          \
+  {                                                                           \
+    if (!(cond))                                                              \
+    {                                                                         \
+      (void)printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);   \
+      TestFailures++;                                                         \
+    }                                                                         \
+  } while (0)
+
+/* Check two integers, printing both values on failure */
+#define TEST_CHECK_EQ(actual, expected)                                       \
+  do                                                                          \
+  {                                                                           \
+    long long test_a = (long long)(actual);                                   \
+    long long test_e = (long long)(expected);                                 \
+    if (test_a != test_e)                                                     \
+    {                                                                         \
+      (void)printf("%s:%d: check failed: %s == %lld, expected %s == %lld\n",  \
+                   __FILE__, __LINE__, #actual, test_a, #expected, test_e);   \
+      TestFailures++;                                                         \
+    }                                                                         \
+  } while (0)
+
+/* Define the failure counter and the test result of a test program */
+#define TEST_MAIN                                                             \
+  uint32_t TestFailures = 0U
+
+#define TEST_RESULT(name)                                                     \
+  ((void)printf("%s: %s\n", (name), (TestFailures == 0U) ? "PASS" : "FAIL"),  \
+   (TestFailures == 0U) ? 0 : 1)
+
+#endif /* TEST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
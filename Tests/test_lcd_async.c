@@ -0,0 +1,314 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_async.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_async.c transfer queue on the simulated
+  *          transfer engine: queued jobs, completion order, full queue and
+  *          transfer errors.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_async.h"
+#include "test.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define IMAGE_WIDTH   32U
+#define IMAGE_HEIGHT  24U
+#define MAX_CALLS     32U
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Image[IMAGE_WIDTH * IMAGE_HEIGHT];
+static uint16_t Expected[IMAGE_WIDTH * IMAGE_HEIGHT];
+static uint16_t Pixels[10U * 6U];
+static uint8_t  Bitmap[54U + (4U * 8U)];
+
+static uint32_t CallFence[MAX_CALLS];
+static int32_t  CallStatus[MAX_CALLS];
+static uint32_t CallCount;
+
+/* Private functions ---------------------------------------------------------*/
+static void Callback(uint32_t Fence, int32_t Status, void *pContext)
+{
+  (void)pContext;
+
+  if (CallCount < MAX_CALLS)
+  {
+    CallFence[CallCount]  = Fence;
+    CallStatus[CallCount] = Status;
+  }
+  CallCount++;
+}
+
+static void ExpectRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint16_t Color)
+{
+  uint32_t i, j;
+
+  for (j = 0U; j < Height; j++)
+  {
+    for (i = 0U; i < Width; i++)
+    {
+      Expected[((Ypos + j) * IMAGE_WIDTH) + Xpos + i] = Color;
+    }
+  }
+}
+
+/* 3x4 bottom-up 16 bpp bitmap, rows padded to 8 bytes */
+static void MakeBitmap(void)
+{
+  uint32_t x, y;
+  uint16_t value;
+
+  (void)memset(Bitmap, 0, sizeof(Bitmap));
+  Bitmap[0]  = 'B';
+  Bitmap[1]  = 'M';
+  Bitmap[10] = 54U;
+  Bitmap[18] = 3U;
+  Bitmap[22] = 4U;
+  Bitmap[28] = 16U;
+  for (y = 0U; y < 4U; y++)
+  {
+    for (x = 0U; x < 3U; x++)
+    {
+      value = (uint16_t)(0x5000U + (y * 16U) + x);
+      Bitmap[54U + (y * 8U) + (2U * x)]      = (uint8_t)(value & 0xFFU);
+      Bitmap[54U + (y * 8U) + (2U * x) + 1U] = (uint8_t)(value >> 8);
+    }
+  }
+}
+
+/* Expect the first Rows display rows of the bitmap at Xpos, Ypos */
+static void ExpectBitmap(uint32_t Xpos, uint32_t Ypos, uint32_t Rows)
+{
+  uint32_t x, y;
+
+  for (y = 0U; y < Rows; y++)
+  {
+    for (x = 0U; x < 3U; x++)
+    {
+      Expected[((Ypos + y) * IMAGE_WIDTH) + Xpos + x] = (uint16_t)(0x5000U + ((3U - y) * 16U) + x);
+    }
+  }
+}
+
+static void Reset(void)
+{
+  (void)memset(Image, 0, sizeof(Image));
+  (void)memset(Expected, 0, sizeof(Expected));
+  CallCount = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_SimInit(Image, IMAGE_WIDTH, IMAGE_HEIGHT), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_Init(0U, &UTIL_LCD_ASYNC_SimEngine), UTIL_LCD_ASYNC_OK);
+  UTIL_LCD_ASYNC_ResetStats();
+}
+
+/* Jobs of all kinds are queued, then drawn in order on completion */
+static void TestQueuedJobs(void)
+{
+  uint32_t fence[4], i, x, y;
+  UTIL_LCD_ASYNC_Stats_t stats;
+
+  Reset();
+
+  for (i = 0U; i < (10U * 6U); i++)
+  {
+    Pixels[i] = (uint16_t)(0x100U + i);
+  }
+  MakeBitmap();
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 0U, IMAGE_WIDTH, IMAGE_HEIGHT, 0x1111U, Callback, NULL, &fence[0]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRGBRect(3U, 4U, (uint8_t *)Pixels, 10U, 6U, Callback, NULL, &fence[1]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(5U, 5U, 4U, 4U, 0x2222U, Callback, NULL, &fence[2]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_DrawBitmap(20U, 10U, Bitmap, Callback, NULL, &fence[3]), UTIL_LCD_ASYNC_OK);
+
+  /* Nothing completes before the engine runs */
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_IsComplete(fence[0]), 0U);
+  TEST_CHECK_EQ(CallCount, 0U);
+
+  /* The first job is one transfer */
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_SimStep(), 1U);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_IsComplete(fence[0]), 1U);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_IsComplete(fence[1]), 0U);
+  TEST_CHECK_EQ(CallCount, 1U);
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_Wait(fence[3]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_SimStep(), 0U);
+
+  ExpectRect(0U, 0U, IMAGE_WIDTH, IMAGE_HEIGHT, 0x1111U);
+  for (y = 0U; y < 6U; y++)
+  {
+    for (x = 0U; x < 10U; x++)
+    {
+      Expected[((4U + y) * IMAGE_WIDTH) + 3U + x] = Pixels[(y * 10U) + x];
+    }
+  }
+  ExpectRect(5U, 5U, 4U, 4U, 0x2222U);
+  ExpectBitmap(20U, 10U, 4U);
+  TEST_CHECK(memcmp(Image, Expected, sizeof(Image)) == 0);
+
+  /* Callbacks in fence order, all successful */
+  TEST_CHECK_EQ(CallCount, 4U);
+  for (i = 0U; i < 4U; i++)
+  {
+    TEST_CHECK_EQ(CallFence[i], fence[i]);
+    TEST_CHECK_EQ(CallStatus[i], UTIL_LCD_ASYNC_OK);
+  }
+
+  /* One transfer per rect, one per row of the padded bitmap */
+  UTIL_LCD_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.JobCount, 4U);
+  TEST_CHECK_EQ(stats.TransferCount, 1U + 1U + 1U + 4U);
+  TEST_CHECK_EQ(stats.ErrorCount, 0U);
+}
+
+/* Submissions beyond the queue size are refused until jobs complete */
+static void TestQueueFull(void)
+{
+  uint32_t fence, i, busy = 0U;
+
+  Reset();
+
+  for (i = 0U; i < (UTIL_LCD_ASYNC_QUEUE_SIZE + 4U); i++)
+  {
+    if (UTIL_LCD_ASYNC_FillRect(i, 0U, 1U, 1U, i, Callback, NULL, &fence) == UTIL_LCD_ASYNC_BUSY)
+    {
+      busy++;
+    }
+  }
+  TEST_CHECK_EQ(busy, 4U);
+
+  /* One completion frees one slot */
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_SimStep(), 1U);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 1U, 1U, 1U, 0x3333U, Callback, NULL, &fence), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(1U, 1U, 1U, 1U, 0x3333U, Callback, NULL, &fence), UTIL_LCD_ASYNC_BUSY);
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_WaitAll(), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_IsComplete(fence), 1U);
+  TEST_CHECK_EQ(CallCount, UTIL_LCD_ASYNC_QUEUE_SIZE + 1U);
+  TEST_CHECK_EQ(Image[(UTIL_LCD_ASYNC_QUEUE_SIZE - 1U)], UTIL_LCD_ASYNC_QUEUE_SIZE - 1U);
+  TEST_CHECK_EQ(Image[IMAGE_WIDTH], 0x3333U);
+}
+
+/* A job whose window is refused ends with an error, the next one runs */
+static void TestWindowError(void)
+{
+  uint32_t fence[2];
+  UTIL_LCD_ASYNC_Stats_t stats;
+
+  Reset();
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(IMAGE_WIDTH - 2U, 0U, 4U, 1U, 0x4444U, Callback, NULL, &fence[0]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_IsComplete(fence[0]), 1U);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 0U, 2U, 2U, 0x5555U, Callback, NULL, &fence[1]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_Wait(fence[1]), UTIL_LCD_ASYNC_ERROR);
+
+  /* The error is reported once */
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_WaitAll(), UTIL_LCD_ASYNC_OK);
+
+  ExpectRect(0U, 0U, 2U, 2U, 0x5555U);
+  TEST_CHECK(memcmp(Image, Expected, sizeof(Image)) == 0);
+  TEST_CHECK_EQ(CallCount, 2U);
+  TEST_CHECK_EQ(CallStatus[0], UTIL_LCD_ASYNC_ERROR);
+  TEST_CHECK_EQ(CallStatus[1], UTIL_LCD_ASYNC_OK);
+
+  UTIL_LCD_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.JobCount, 2U);
+  TEST_CHECK_EQ(stats.ErrorCount, 1U);
+}
+
+/* A DMA transfer error stops its job, the queued jobs still run */
+static void TestTransferError(void)
+{
+  uint32_t fence[3];
+  UTIL_LCD_ASYNC_Stats_t stats;
+
+  Reset();
+  MakeBitmap();
+
+  /* Third row of the bitmap fails: the first two rows are drawn */
+  UTIL_LCD_ASYNC_SimInjectError(1U + 3U);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 0U, IMAGE_WIDTH, 2U, 0x7777U, Callback, NULL, &fence[0]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_DrawBitmap(4U, 8U, Bitmap, Callback, NULL, &fence[1]), UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 20U, 3U, 3U, 0x8888U, Callback, NULL, &fence[2]), UTIL_LCD_ASYNC_OK);
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_Wait(fence[1]), UTIL_LCD_ASYNC_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_Wait(fence[2]), UTIL_LCD_ASYNC_OK);
+
+  ExpectRect(0U, 0U, IMAGE_WIDTH, 2U, 0x7777U);
+  ExpectBitmap(4U, 8U, 2U);
+  ExpectRect(0U, 20U, 3U, 3U, 0x8888U);
+  TEST_CHECK(memcmp(Image, Expected, sizeof(Image)) == 0);
+
+  TEST_CHECK_EQ(CallCount, 3U);
+  TEST_CHECK_EQ(CallStatus[0], UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(CallStatus[1], UTIL_LCD_ASYNC_ERROR);
+  TEST_CHECK_EQ(CallStatus[2], UTIL_LCD_ASYNC_OK);
+  TEST_CHECK_EQ(CallFence[1], fence[1]);
+
+  UTIL_LCD_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.JobCount, 3U);
+  TEST_CHECK_EQ(stats.ErrorCount, 1U);
+  UTIL_LCD_ASYNC_SimGetStats(&stats);
+  TEST_CHECK_EQ(stats.ErrorCount, 1U);
+}
+
+/* A callback can queue the next job from the completion context */
+static uint32_t ChainCount;
+static void ChainCallback(uint32_t Fence, int32_t Status, void *pContext)
+{
+  (void)Fence;
+  (void)pContext;
+
+  TEST_CHECK_EQ(Status, UTIL_LCD_ASYNC_OK);
+  if (ChainCount < 4U)
+  {
+    ChainCount++;
+    TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(ChainCount, 0U, 1U, 1U, 0x9000U + ChainCount, ChainCallback, NULL, NULL),
+                  UTIL_LCD_ASYNC_OK);
+  }
+}
+
+static void TestChainedJobs(void)
+{
+  uint32_t i;
+
+  Reset();
+  ChainCount = 0U;
+
+  TEST_CHECK_EQ(UTIL_LCD_ASYNC_FillRect(0U, 0U, 1U, 1U, 0x9000U, ChainCallback, NULL, NULL), UTIL_LCD_ASYNC_OK);
+  while (UTIL_LCD_ASYNC_SimStep() != 0U)
+  {
+  }
+
+  TEST_CHECK_EQ(ChainCount, 4U);
+  for (i = 0U; i <= 4U; i++)
+  {
+    TEST_CHECK_EQ(Image[i], 0x9000U + i);
+  }
+}
+
+int main(void)
+{
+  TestQueuedJobs();
+  TestQueueFull();
+  TestWindowError();
+  TestTransferError();
+  TestChainedJobs();
+
+  return TEST_RESULT("test_lcd_async");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
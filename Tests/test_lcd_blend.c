@@ -0,0 +1,310 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_blend.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_fb.c compositing services. Random
+  *          UTIL_LCD_FB_BlendRect(), BlendBitmap() and BlendMask() calls, at
+  *          odd widths, unaligned starts and clipped positions, in full and
+  *          banded buffers, are compared exactly with a per-field scalar
+  *          blend at the same 33 alpha levels, and within 1 LSB of the 5-bit
+  *          fields with an exact 8-bit alpha blend.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd_fb.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define WIDTH           61U   /* Odd: rows alternate between aligned and unaligned starts */
+#define HEIGHT          24U
+#define BAND            7U
+#define CASES           300U
+
+/* Private types -------------------------------------------------------------*/
+typedef enum
+{
+  SERVICE_RECT,
+  SERVICE_BITMAP,
+  SERVICE_MASK
+} Service_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t FrameBuffer[WIDTH * HEIGHT];
+static uint16_t Image[WIDTH * HEIGHT];       /* Memory target, not flushed to */
+static uint16_t Model[WIDTH * HEIGHT];       /* Scalar blend of the whole display */
+static uint8_t  BlendAlpha[WIDTH * HEIGHT];  /* 8-bit alpha of the last blend of each pixel */
+static uint16_t Before[WIDTH * HEIGHT];      /* Pixels before the last blend */
+static uint16_t Foreground[WIDTH * HEIGHT];  /* Color of the last blend */
+static uint8_t  Source[4U * WIDTH * HEIGHT]; /* ARGB8888 bitmap or A8 mask */
+static uint32_t BandYpos, BandHeight;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t ToRGB565(uint32_t Color)
+{
+  return (((Color >> 8) & 0xF800U) | ((Color >> 5) & 0x07E0U) | ((Color >> 3) & 0x001FU));
+}
+
+/* Alpha values around the 33 level steps, 0 and 255 included */
+static uint32_t RandomAlpha(void)
+{
+  static const uint8_t edges[] = {0U, 1U, 3U, 4U, 5U, 124U, 128U, 131U, 251U, 252U, 254U, 255U};
+
+  return ((rand() % 2) == 0) ? edges[(uint32_t)rand() % sizeof(edges)] : ((uint32_t)rand() & 0xFFU);
+}
+
+/* (Fg * a + Bg * (32 - a)) >> 5 on each field */
+static uint16_t RefBlend(uint32_t Bg, uint32_t Fg, uint32_t Alpha8)
+{
+  uint32_t a = (Alpha8 + 4U) >> 3;
+  uint32_t r, g, b;
+
+  r = ((((Fg >> 11) & 0x1FU) * a) + (((Bg >> 11) & 0x1FU) * (32U - a))) >> 5;
+  g = ((((Fg >> 5) & 0x3FU) * a) + (((Bg >> 5) & 0x3FU) * (32U - a))) >> 5;
+  b = (((Fg & 0x1FU) * a) + ((Bg & 0x1FU) * (32U - a))) >> 5;
+
+  return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+/* Distance of a field to (Fg * Alpha + Bg * (255 - Alpha)) / 255, rounded */
+static uint32_t FieldError(uint32_t Result, uint32_t Bg, uint32_t Fg, uint32_t Alpha8, uint32_t Shift, uint32_t Mask)
+{
+  uint32_t exact = ((((Fg >> Shift) & Mask) * Alpha8) + (((Bg >> Shift) & Mask) * (255U - Alpha8)) + 127U) / 255U;
+  uint32_t field = (Result >> Shift) & Mask;
+
+  return (field > exact) ? (field - exact) : (exact - field);
+}
+
+/* Blend of the model, clipped as the frame buffer clips to its band */
+static void RefPixel(uint32_t X, uint32_t Y, uint32_t Fg, uint32_t Alpha8)
+{
+  uint32_t i = (Y * WIDTH) + X;
+
+  if ((X < WIDTH) && (Y < HEIGHT) && (Y >= BandYpos) && (Y < (BandYpos + BandHeight)))
+  {
+    Before[i]     = Model[i];
+    Foreground[i] = (uint16_t)Fg;
+    BlendAlpha[i] = (uint8_t)Alpha8;
+    Model[i]      = RefBlend(Model[i], Fg, Alpha8);
+  }
+}
+
+static void SetBand(uint32_t Ypos)
+{
+  uint32_t rows = ((HEIGHT - Ypos) < BandHeight) ? (HEIGHT - Ypos) : BandHeight;
+
+  TEST_CHECK_EQ(UTIL_LCD_FB_SetBand(Ypos), UTIL_LCD_FB_OK);
+  BandYpos = Ypos;
+  (void)memcpy(FrameBuffer, &Model[Ypos * WIDTH], rows * WIDTH * sizeof(uint16_t));
+  (void)memcpy(Before, Model, sizeof(Before));
+  (void)memset(BlendAlpha, 0, sizeof(BlendAlpha));
+}
+
+static void Setup(uint32_t Band)
+{
+  UTIL_LCD_FB_Init_t init;
+  uint32_t           i;
+
+  init.pBuffer    = FrameBuffer;
+  init.Width      = WIDTH;
+  init.Height     = HEIGHT;
+  init.BandHeight = Band;
+  init.Instance   = 0U;
+  init.pTarget    = &UTIL_LCD_FB_MemTarget;
+  TEST_CHECK_EQ(UTIL_LCD_FB_Init(&init), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_MemTargetInit(Image, WIDTH, HEIGHT), UTIL_LCD_FB_OK);
+  BandHeight = Band;
+
+  for (i = 0U; i < (WIDTH * HEIGHT); i++)
+  {
+    Model[i] = (uint16_t)rand();
+  }
+  SetBand(0U);
+}
+
+/* Compare the band with the model, and with the exact 8-bit blend */
+static void CheckBand(const char *pName, uint32_t Case)
+{
+  uint32_t x, y, i, wrong = 0U, far = 0U;
+
+  for (y = BandYpos; (y < (BandYpos + BandHeight)) && (y < HEIGHT); y++)
+  {
+    for (x = 0U; x < WIDTH; x++)
+    {
+      i = (y * WIDTH) + x;
+      if (FrameBuffer[((y - BandYpos) * WIDTH) + x] != Model[i])
+      {
+        wrong++;
+      }
+      /* One LSB of the 5-bit fields, two of the 6-bit green field */
+      if ((FieldError(Model[i], Before[i], Foreground[i], BlendAlpha[i], 11U, 0x1FU) > 1U) ||
+          (FieldError(Model[i], Before[i], Foreground[i], BlendAlpha[i], 5U, 0x3FU) > 2U) ||
+          (FieldError(Model[i], Before[i], Foreground[i], BlendAlpha[i], 0U, 0x1FU) > 1U))
+      {
+        far++;
+      }
+    }
+  }
+  if ((wrong != 0U) || (far != 0U))
+  {
+    (void)printf("%s, band %u at %u, case %u: %u pixels differ, %u off by more than 1 LSB\n", pName,
+                 (unsigned int)BandHeight, (unsigned int)BandYpos, (unsigned int)Case,
+                 (unsigned int)wrong, (unsigned int)far);
+    TestFailures++;
+  }
+}
+
+static void RandomCase(Service_t Service)
+{
+  uint32_t xpos, ypos, width, height, color, alpha, coverage, x, y, i, run;
+
+  /* Odd and even starts and widths, partly out of the display */
+  xpos   = (uint32_t)rand() % (WIDTH + 4U);
+  ypos   = (uint32_t)rand() % (HEIGHT + 2U);
+  width  = 1U + ((uint32_t)rand() % WIDTH);
+  height = 1U + ((uint32_t)rand() % 9U);
+  color  = (RandomAlpha() << 24) | ((uint32_t)rand() & 0xFFFFFFU);
+
+  switch (Service)
+  {
+    case SERVICE_RECT:
+      TEST_CHECK_EQ(UTIL_LCD_FB_BlendRect(xpos, ypos, width, height, color), UTIL_LCD_FB_OK);
+      for (y = ypos; y < (ypos + height); y++)
+      {
+        for (x = xpos; x < (xpos + width); x++)
+        {
+          RefPixel(x, y, ToRGB565(color), color >> 24);
+        }
+      }
+      break;
+
+    case SERVICE_BITMAP:
+      for (i = 0U; i < (width * height); i++)
+      {
+        Source[4U * i]        = (uint8_t)rand();
+        Source[(4U * i) + 1U] = (uint8_t)rand();
+        Source[(4U * i) + 2U] = (uint8_t)rand();
+        Source[(4U * i) + 3U] = (uint8_t)RandomAlpha();
+      }
+      TEST_CHECK_EQ(UTIL_LCD_FB_BlendBitmap(xpos, ypos, Source, width, height), UTIL_LCD_FB_OK);
+      for (y = 0U; y < height; y++)
+      {
+        for (x = 0U; x < width; x++)
+        {
+          i = 4U * ((y * width) + x);
+          color = (uint32_t)Source[i] | ((uint32_t)Source[i + 1U] << 8) | ((uint32_t)Source[i + 2U] << 16);
+          RefPixel(xpos + x, ypos + y, ToRGB565(color), Source[i + 3U]);
+        }
+      }
+      break;
+
+    case SERVICE_MASK:
+    default:
+      /* Runs of empty, full and partial coverage, as in glyphs */
+      for (i = 0U; i < (width * height); i += run)
+      {
+        coverage = ((rand() % 3) == 0) ? 0U : (((rand() % 2) == 0) ? 255U : ((uint32_t)rand() & 0xFFU));
+        for (run = 0U; (run < (1U + ((uint32_t)rand() % 9U))) && ((i + run) < (width * height)); run++)
+        {
+          Source[i + run] = (uint8_t)coverage;
+        }
+      }
+      TEST_CHECK_EQ(UTIL_LCD_FB_BlendMask(xpos, ypos, Source, width, height, color), UTIL_LCD_FB_OK);
+      alpha = color >> 24;
+      for (y = 0U; y < height; y++)
+      {
+        for (x = 0U; x < width; x++)
+        {
+          coverage = Source[(y * width) + x];
+          RefPixel(xpos + x, ypos + y, ToRGB565(color), ((coverage * alpha) + 255U) >> 8);
+        }
+      }
+      break;
+  }
+}
+
+static void TestRandom(const char *pName, Service_t Service)
+{
+  uint32_t n, band;
+
+  for (band = 0U; band < 2U; band++)
+  {
+    srand(1U + (uint32_t)Service);
+    Setup((band == 0U) ? HEIGHT : BAND);
+    for (n = 0U; (n < CASES) && (TestFailures == 0U); n++)
+    {
+      if (BandHeight != HEIGHT)
+      {
+        SetBand(BAND * ((uint32_t)rand() % ((HEIGHT + BAND - 1U) / BAND)));
+      }
+      RandomCase(Service);
+      CheckBand(pName, n);
+    }
+  }
+}
+
+/* Alpha 0 leaves the buffer clean, alpha 255 stores the color */
+static void TestOpaqueTransparent(void)
+{
+  static const uint8_t full[WIDTH] =
+  {
+    255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U,
+    255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U,
+    255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U,
+    255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U, 255U
+  };
+  static const uint8_t empty[WIDTH] = {0U};
+  UTIL_LCD_FB_Rect_t rects[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+  uint32_t           x;
+
+  srand(7U);
+  Setup(HEIGHT);
+  (void)memcpy(Image, FrameBuffer, sizeof(Image));
+
+  TEST_CHECK_EQ(UTIL_LCD_FB_BlendRect(0U, 0U, WIDTH, HEIGHT, 0x00FFFFFFU), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_BlendMask(3U, 2U, full, WIDTH, 1U, 0x00FFFFFFU), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(memcmp(Image, FrameBuffer, sizeof(Image)), 0);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 0U);
+
+  /* An empty mask touches no pixel but is still reported dirty */
+  TEST_CHECK_EQ(UTIL_LCD_FB_BlendMask(0U, 1U, empty, WIDTH, 1U, 0xFF00FF00U), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(memcmp(Image, FrameBuffer, sizeof(Image)), 0);
+
+  /* Opaque rows from an odd start and of odd length */
+  TEST_CHECK_EQ(UTIL_LCD_FB_BlendRect(1U, 3U, WIDTH - 2U, 1U, 0xFF123456U), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_BlendMask(1U, 4U, full, WIDTH - 2U, 1U, 0xFFABCDEFU), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(FrameBuffer[3U * WIDTH], Image[3U * WIDTH]);
+  TEST_CHECK_EQ(FrameBuffer[(4U * WIDTH) - 1U], Image[(4U * WIDTH) - 1U]);
+  for (x = 1U; x < (WIDTH - 1U); x++)
+  {
+    TEST_CHECK_EQ(FrameBuffer[(3U * WIDTH) + x], ToRGB565(0x123456U));
+    TEST_CHECK_EQ(FrameBuffer[(4U * WIDTH) + x], ToRGB565(0xABCDEFU));
+  }
+}
+
+int main(void)
+{
+  TestOpaqueTransparent();
+  TestRandom("BlendRect", SERVICE_RECT);
+  TestRandom("BlendBitmap", SERVICE_BITMAP);
+  TestRandom("BlendMask", SERVICE_MASK);
+
+  return TEST_RESULT("test_lcd_blend");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
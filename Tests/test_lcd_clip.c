@@ -0,0 +1,863 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_clip.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd.c clipping rectangles stack: push and
+  *          pop, nested intersection, empty clip, and clipped drawing in
+  *          portrait and landscape frame buffers and in the 4 orientations of
+  *          the ST7789H2 driver over its simulated bus. Each driver call must
+  *          lie in the clipping rectangle, and the clipped image must be the
+  *          unclipped one inside the rectangle and untouched outside.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_fb.h"
+#include "st7789h2_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define MAX_SIZE        320U
+#define PANEL_SIZE      240U
+#define BACKGROUND      0xFF123456U
+#define BACKGROUND_565  ((uint16_t)(((0x12U >> 3) << 11) | ((0x34U >> 2) << 5) | (0x56U >> 3)))
+#define BITMAP_WIDTH    40U
+#define BITMAP_HEIGHT   30U
+#define BITMAP_OFFSET   54U
+#define SCENES          150U
+#define MIN(a, b)       (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)       (((a) > (b)) ? (a) : (b))
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Reference[MAX_SIZE * MAX_SIZE];
+static uint16_t FrameBuffer[MAX_SIZE * MAX_SIZE];
+static uint16_t Image[PANEL_SIZE * PANEL_SIZE];
+static uint8_t  Bitmap[BITMAP_OFFSET + (BITMAP_WIDTH * BITMAP_HEIGHT * 2U)];
+static uint32_t Width, Height;
+
+static ST7789H2_Object_t     Lcd;
+static const LCD_UTILS_Drv_t *pTarget;   /* Driver checked by CheckDriver */
+static UTIL_LCD_ClipRect_t   Clip;       /* Rectangle enforced by CheckDriver */
+static uint32_t              Calls;
+static uint32_t              Violations;
+
+/* Memory display in RGB565 or ARGB8888, whole bitmaps counted only */
+static uint32_t MemImage[PANEL_SIZE * PANEL_SIZE];
+static uint32_t MemFormat, MemBitmaps;
+static uint8_t  DepthBitmap[BITMAP_OFFSET + (4U * PANEL_SIZE * 40U)];
+
+/* Private functions ---------------------------------------------------------*/
+/* Record a driver call drawing out of the clipping rectangle, or nothing */
+static void CheckArea(uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H)
+{
+  Calls++;
+  if ((W == 0U) || (H == 0U) || (Xpos < Clip.X0) || (Ypos < Clip.Y0) ||
+      ((Xpos + W) > Clip.X1) || ((Ypos + H) > Clip.Y1))
+  {
+    if (Violations == 0U)
+    {
+      (void)printf("draw %u,%u %ux%u out of clip %u,%u-%u,%u\n", (unsigned int)Xpos, (unsigned int)Ypos,
+                   (unsigned int)W, (unsigned int)H, (unsigned int)Clip.X0, (unsigned int)Clip.Y0,
+                   (unsigned int)Clip.X1, (unsigned int)Clip.Y1);
+    }
+    Violations++;
+  }
+}
+
+static int32_t CheckDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  int32_t height = (int32_t)((uint32_t)pBmp[22] | ((uint32_t)pBmp[23] << 8) | ((uint32_t)pBmp[24] << 16) |
+                             ((uint32_t)pBmp[25] << 24));
+
+  CheckArea(Xpos, Ypos, pBmp[18], (uint32_t)((height < 0) ? -height : height));
+  return pTarget->DrawBitmap(Instance, Xpos, Ypos, pBmp);
+}
+
+static int32_t CheckFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  CheckArea(Xpos, Ypos, W, H);
+  return pTarget->FillRGBRect(Instance, Xpos, Ypos, pData, W, H);
+}
+
+static int32_t CheckDrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  CheckArea(Xpos, Ypos, Length, 1U);
+  return pTarget->DrawHLine(Instance, Xpos, Ypos, Length, Color);
+}
+
+static int32_t CheckDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  CheckArea(Xpos, Ypos, 1U, Length);
+  return pTarget->DrawVLine(Instance, Xpos, Ypos, Length, Color);
+}
+
+static int32_t CheckFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  CheckArea(Xpos, Ypos, W, H);
+  return pTarget->FillRect(Instance, Xpos, Ypos, W, H, Color);
+}
+
+static int32_t CheckGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  return pTarget->GetPixel(Instance, Xpos, Ypos, pColor);
+}
+
+static int32_t CheckSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  CheckArea(Xpos, Ypos, 1U, 1U);
+  return pTarget->SetPixel(Instance, Xpos, Ypos, Color);
+}
+
+static int32_t CheckGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  return pTarget->GetXSize(Instance, pXSize);
+}
+
+static int32_t CheckGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  return pTarget->GetYSize(Instance, pYSize);
+}
+
+static int32_t CheckSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  return pTarget->SetLayer(Instance, Layer);
+}
+
+static int32_t CheckGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  return pTarget->GetFormat(Instance, pFormat);
+}
+
+static const LCD_UTILS_Drv_t CheckDriver =
+{
+  CheckDrawBitmap,
+  CheckFillRGBRect,
+  CheckDrawHLine,
+  CheckDrawVLine,
+  CheckFillRect,
+  CheckGetPixel,
+  CheckSetPixel,
+  CheckGetXSize,
+  CheckGetYSize,
+  CheckSetLayer,
+  CheckGetFormat
+};
+
+/* ST7789H2 driver adaptation, as in the BSP */
+static int32_t LcdDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  return ST7789H2_DrawBitmap(&Lcd, Xpos, Ypos, pBmp);
+}
+
+static int32_t LcdFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  (void)Instance;
+  return ST7789H2_FillRGBRect(&Lcd, Xpos, Ypos, pData, W, H);
+}
+
+static int32_t LcdDrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawHLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t LcdDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawVLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t LcdFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_FillRect(&Lcd, Xpos, Ypos, W, H, Color);
+}
+
+static int32_t LcdGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  return ST7789H2_GetPixel(&Lcd, Xpos, Ypos, pColor);
+}
+
+static int32_t LcdSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_SetPixel(&Lcd, Xpos, Ypos, Color);
+}
+
+static int32_t LcdGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  return ST7789H2_GetXSize(&Lcd, pXSize);
+}
+
+static int32_t LcdGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  return ST7789H2_GetYSize(&Lcd, pYSize);
+}
+
+static int32_t LcdSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t LcdGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t LcdDriver =
+{
+  LcdDrawBitmap,
+  LcdFillRGBRect,
+  LcdDrawHLine,
+  LcdDrawVLine,
+  LcdFillRect,
+  LcdGetPixel,
+  LcdSetPixel,
+  LcdGetXSize,
+  LcdGetYSize,
+  LcdSetLayer,
+  LcdGetFormat
+};
+
+static int32_t MemDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)pBmp;
+  MemBitmaps++;
+  return 0;
+}
+
+static int32_t MemFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  uint32_t i, j, k, bytes = (MemFormat == LCD_PIXEL_FORMAT_RGB565) ? 2U : 4U, color;
+
+  (void)Instance;
+  for (j = 0U; j < H; j++)
+  {
+    for (i = 0U; i < W; i++)
+    {
+      color = 0U;
+      for (k = 0U; k < bytes; k++)
+      {
+        color |= (uint32_t)pData[(((j * W) + i) * bytes) + k] << (8U * k);
+      }
+      MemImage[((Ypos + j) * Width) + Xpos + i] = color;
+    }
+  }
+  return 0;
+}
+
+static int32_t MemFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  uint32_t i, j;
+
+  (void)Instance;
+  for (j = 0U; j < H; j++)
+  {
+    for (i = 0U; i < W; i++)
+    {
+      MemImage[((Ypos + j) * Width) + Xpos + i] = Color;
+    }
+  }
+  return 0;
+}
+
+static int32_t MemDrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+static int32_t MemDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+}
+
+static int32_t MemGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  *pColor = MemImage[(Ypos * Width) + Xpos];
+  return 0;
+}
+
+static int32_t MemSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+static int32_t MemGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  *pXSize = Width;
+  return 0;
+}
+
+static int32_t MemGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  *pYSize = Height;
+  return 0;
+}
+
+static int32_t MemSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t MemGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = MemFormat;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t MemDriver =
+{
+  MemDrawBitmap,
+  MemFillRGBRect,
+  MemDrawHLine,
+  MemDrawVLine,
+  MemFillRect,
+  MemGetPixel,
+  MemSetPixel,
+  MemGetXSize,
+  MemGetYSize,
+  MemSetLayer,
+  MemGetFormat
+};
+
+/* 16 bpp bottom-up BMP of pseudo-random pixels */
+static void MakeBitmap(void)
+{
+  uint32_t i, size = sizeof(Bitmap);
+  uint16_t value;
+
+  (void)memset(Bitmap, 0, BITMAP_OFFSET);
+  Bitmap[0]  = (uint8_t)'B';
+  Bitmap[1]  = (uint8_t)'M';
+  (void)memcpy(&Bitmap[2], &size, 4U);
+  Bitmap[10] = (uint8_t)BITMAP_OFFSET;
+  Bitmap[14] = 40U;
+  Bitmap[18] = (uint8_t)BITMAP_WIDTH;
+  Bitmap[22] = (uint8_t)BITMAP_HEIGHT;
+  Bitmap[26] = 1U;
+  Bitmap[28] = 16U;
+  for (i = 0U; i < (BITMAP_WIDTH * BITMAP_HEIGHT); i++)
+  {
+    value = (uint16_t)((i * 2654435761U) >> 7);
+    Bitmap[BITMAP_OFFSET + (2U * i)]      = (uint8_t)(value & 0xFFU);
+    Bitmap[BITMAP_OFFSET + (2U * i) + 1U] = (uint8_t)(value >> 8);
+  }
+}
+
+/* Every primitive, shifted by Xoffset, Yoffset, partly out of the display */
+static void DrawScene(int32_t Xoffset, int32_t Yoffset)
+{
+  uint32_t ox = (uint32_t)(Xoffset + 40), oy = (uint32_t)(Yoffset + 40);
+  Point pts[5];
+
+  pts[0].X = (int16_t)(Xoffset + 20);  pts[0].Y = (int16_t)(Yoffset + 200);
+  pts[1].X = (int16_t)(Xoffset + 200); pts[1].Y = (int16_t)(Yoffset + 120);
+  pts[2].X = (int16_t)(Xoffset + 230); pts[2].Y = (int16_t)(Yoffset + 230);
+  pts[3].X = (int16_t)(Xoffset + 100); pts[3].Y = (int16_t)(Yoffset + 260);
+  pts[4].X = (int16_t)(Xoffset + 60);  pts[4].Y = (int16_t)(Yoffset + 150);
+
+  UTIL_LCD_FillRect(ox - 30U, oy - 30U, 50U, 30U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_DrawHLine(0U, oy + 60U, Width, UTIL_LCD_COLOR_BLUE);
+  UTIL_LCD_DrawVLine(ox + 80U, 0U, Height, UTIL_LCD_COLOR_GREEN);
+  UTIL_LCD_FillCircle(ox + 140U, oy + 140U, 60U, UTIL_LCD_COLOR_YELLOW);
+  UTIL_LCD_DrawCircle(ox + 20U, oy + 140U, 70U, UTIL_LCD_COLOR_CYAN);
+  UTIL_LCD_DrawEllipse(Xoffset + 100, Yoffset + 50, 90, 30, UTIL_LCD_COLOR_ORANGE);
+  UTIL_LCD_FillEllipse(Xoffset + (int32_t)Width - 20, Yoffset + 20, 40, 25, UTIL_LCD_COLOR_MAGENTA);
+  UTIL_LCD_DrawLine(0U, 0U, Width - 1U, Height - 1U, UTIL_LCD_COLOR_WHITE);
+  UTIL_LCD_DrawLine(Width - 1U, 0U, 0U, Height - 1U, UTIL_LCD_COLOR_GRAY);
+  UTIL_LCD_DrawRect(ox - 35U, oy - 35U, Width - 10U, Height - 10U, UTIL_LCD_COLOR_BROWN);
+  UTIL_LCD_FillPolygon(pts, 5U, UTIL_LCD_COLOR_DARKGREEN);
+  UTIL_LCD_DrawPolygon(pts, 5U, UTIL_LCD_COLOR_LIGHTRED);
+  UTIL_LCD_SetFont(&Font16);
+  UTIL_LCD_SetTextColor(UTIL_LCD_COLOR_BLACK);
+  UTIL_LCD_SetBackColor(UTIL_LCD_COLOR_LIGHTGRAY);
+  UTIL_LCD_DisplayStringAt(ox - 35U, oy + 20U, (uint8_t *)"Clipped text run", LEFT_MODE);
+  UTIL_LCD_DisplayChar(ox + 160U, oy + 170U, (uint8_t)'Q');
+  UTIL_LCD_SetPixel(ox - 37U, oy - 37U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_SetPixel(Width - 1U, Height - 1U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_SetPixel(0U, 0U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_DrawBitmap(ox + 110U, oy - 10U, Bitmap);
+  UTIL_LCD_DrawBitmap(Width - 25U, Height - 12U, Bitmap);
+}
+
+static void InitFrameBuffer(uint16_t *pBuffer)
+{
+  UTIL_LCD_FB_Init_t init;
+
+  init.pBuffer    = pBuffer;
+  init.Width      = Width;
+  init.Height     = Height;
+  init.BandHeight = Height;
+  init.Instance   = 0U;
+  init.pTarget    = NULL;
+  TEST_CHECK_EQ(UTIL_LCD_FB_Init(&init), UTIL_LCD_FB_OK);
+  pTarget = &UTIL_LCD_FB_Driver;
+  UTIL_LCD_SetFuncDriver(&CheckDriver);
+  UTIL_LCD_GetClipRect(&Clip);
+  Violations = 0U;
+}
+
+static void InitPanel(uint32_t Orientation)
+{
+  ST7789H2_IO_t io;
+
+  (void)memset(&Lcd, 0, sizeof(Lcd));
+  TEST_CHECK_EQ(ST7789H2_SIM_Init(&io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_RegisterBusIO(&Lcd, &io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_Init(&Lcd, ST7789H2_FORMAT_RBG565, Orientation), ST7789H2_OK);
+  pTarget = &LcdDriver;
+  UTIL_LCD_SetFuncDriver(&CheckDriver);
+  UTIL_LCD_GetClipRect(&Clip);
+  Violations = 0U;
+}
+
+/* Panel pixel showing the user pixel (X, Y) in Orientation */
+static uint32_t PanelIndex(uint32_t Orientation, uint32_t X, uint32_t Y)
+{
+  uint32_t index;
+
+  switch (Orientation)
+  {
+    case ST7789H2_ORIENTATION_LANDSCAPE:
+      index = ((PANEL_SIZE - 1U - X) * PANEL_SIZE) + Y;
+      break;
+    case ST7789H2_ORIENTATION_PORTRAIT_ROT180:
+      index = ((PANEL_SIZE - 1U - Y) * PANEL_SIZE) + (PANEL_SIZE - 1U - X);
+      break;
+    case ST7789H2_ORIENTATION_LANDSCAPE_ROT180:
+      index = (X * PANEL_SIZE) + (PANEL_SIZE - 1U - Y);
+      break;
+    default:
+      index = (Y * PANEL_SIZE) + X;
+      break;
+  }
+
+  return index;
+}
+
+/* Random area, from the whole display to areas partly or fully out of it */
+static void RandomArea(uint32_t Kind, uint32_t *pX, uint32_t *pY, uint32_t *pW, uint32_t *pH)
+{
+  switch (Kind % 6U)
+  {
+    case 0U:
+      *pX = 0U; *pY = 0U; *pW = Width; *pH = Height;
+      break;
+    case 1U:
+      *pX = 0U; *pY = 0U; *pW = 1U + ((uint32_t)rand() % Width); *pH = 1U + ((uint32_t)rand() % Height);
+      break;
+    case 2U:
+      *pX = (uint32_t)rand() % Width; *pY = (uint32_t)rand() % Height; *pW = Width - *pX; *pH = Height - *pY;
+      break;
+    case 3U:
+      *pX = (uint32_t)rand() % Width; *pY = (uint32_t)rand() % Height; *pW = 1U; *pH = Height;
+      break;
+    case 4U:
+      *pX = (uint32_t)rand() % Width; *pY = (uint32_t)rand() % Height;
+      *pW = (uint32_t)rand() % 400U;  *pH = (uint32_t)rand() % 400U;
+      break;
+    default:
+      *pX = (uint32_t)rand() % 400U; *pY = (uint32_t)rand() % 400U;
+      *pW = (uint32_t)rand() % 100U; *pH = (uint32_t)rand() % 100U;
+      break;
+  }
+}
+
+/* Pixels of pImage (Width x Height, through Index) differing from the
+   reference inside the clip, or from the background outside */
+static uint32_t CountWrongPixels(const uint16_t *pImage, uint32_t Orientation, uint32_t Panel)
+{
+  uint32_t x, y, index, inside, bad = 0U;
+  uint16_t expected;
+
+  for (y = 0U; y < Height; y++)
+  {
+    for (x = 0U; x < Width; x++)
+    {
+      inside   = ((x >= Clip.X0) && (x < Clip.X1) && (y >= Clip.Y0) && (y < Clip.Y1)) ? 1U : 0U;
+      expected = (inside != 0U) ? Reference[(y * Width) + x] : BACKGROUND_565;
+      index    = (Panel != 0U) ? PanelIndex(Orientation, x, y) : ((y * Width) + x);
+      bad     += (pImage[index] != expected) ? 1U : 0U;
+    }
+  }
+
+  return bad;
+}
+
+static void TestPushPop(void)
+{
+  UTIL_LCD_ClipRect_t clip;
+  uint32_t i;
+
+  Width  = 240U;
+  Height = 240U;
+  InitFrameBuffer(FrameBuffer);
+
+  /* Whole display after SetFuncDriver */
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 0U);
+  TEST_CHECK_EQ(clip.Y0, 0U);
+  TEST_CHECK_EQ(clip.X1, 240U);
+  TEST_CHECK_EQ(clip.Y1, 240U);
+
+  /* Nested areas intersect, clamped to the display */
+  TEST_CHECK_EQ(UTIL_LCD_PushClipRect(10U, 20U, 100U, 100U), UTIL_LCD_OK);
+  TEST_CHECK_EQ(UTIL_LCD_PushClipRect(50U, 0U, 400U, 60U), UTIL_LCD_OK);
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 50U);
+  TEST_CHECK_EQ(clip.Y0, 20U);
+  TEST_CHECK_EQ(clip.X1, 110U);
+  TEST_CHECK_EQ(clip.Y1, 60U);
+  TEST_CHECK_EQ(UTIL_LCD_PushClipRect(200U, 100U, 400U, 400U), UTIL_LCD_OK);
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK(((clip.X1 - clip.X0) * (clip.Y1 - clip.Y0)) == 0U);
+
+  /* Pop restores each level */
+  UTIL_LCD_PopClipRect();
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 50U);
+  TEST_CHECK_EQ(clip.Y1, 60U);
+  UTIL_LCD_PopClipRect();
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 10U);
+  TEST_CHECK_EQ(clip.Y0, 20U);
+  TEST_CHECK_EQ(clip.X1, 110U);
+  TEST_CHECK_EQ(clip.Y1, 120U);
+  UTIL_LCD_PopClipRect();
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X1, 240U);
+  TEST_CHECK_EQ(clip.Y1, 240U);
+
+  /* Pop of an empty stack keeps the display */
+  UTIL_LCD_PopClipRect();
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 0U);
+  TEST_CHECK_EQ(clip.X1, 240U);
+
+  /* Overflow fails and leaves the clip unchanged */
+  for (i = 0U; i < UTIL_LCD_CLIP_STACK_DEPTH; i++)
+  {
+    TEST_CHECK_EQ(UTIL_LCD_PushClipRect(i, i, 100U, 100U), UTIL_LCD_OK);
+  }
+  TEST_CHECK_EQ(UTIL_LCD_PushClipRect(0U, 0U, 1U, 1U), UTIL_LCD_ERROR);
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, UTIL_LCD_CLIP_STACK_DEPTH - 1U);
+  TEST_CHECK_EQ(clip.X1, 100U);
+
+  /* Reset empties the stack */
+  UTIL_LCD_ResetClipRect();
+  UTIL_LCD_GetClipRect(&clip);
+  TEST_CHECK_EQ(clip.X0, 0U);
+  TEST_CHECK_EQ(clip.X1, 240U);
+  TEST_CHECK_EQ(UTIL_LCD_PushClipRect(0U, 0U, 10U, 10U), UTIL_LCD_OK);
+  UTIL_LCD_ResetClipRect();
+}
+
+static void TestEmptyClip(void)
+{
+  static const uint32_t areas[4][4] =
+  {
+    {10U, 10U, 0U, 50U},      /* Zero width          */
+    {10U, 10U, 50U, 0U},      /* Zero height         */
+    {300U, 10U, 50U, 50U},    /* Out of the display  */
+    {200U, 200U, 10U, 10U},   /* Disjoint from outer */
+  };
+  uint32_t i, x;
+
+  Width  = 240U;
+  Height = 240U;
+  for (i = 0U; i < 4U; i++)
+  {
+    InitFrameBuffer(FrameBuffer);
+    UTIL_LCD_Clear(BACKGROUND);
+    TEST_CHECK_EQ(UTIL_LCD_PushClipRect(0U, 0U, 100U, 100U), UTIL_LCD_OK);
+    TEST_CHECK_EQ(UTIL_LCD_PushClipRect(areas[i][0], areas[i][1], areas[i][2], areas[i][3]), UTIL_LCD_OK);
+    UTIL_LCD_GetClipRect(&Clip);
+    Calls = 0U;
+    DrawScene(0, 0);
+    UTIL_LCD_Clear(UTIL_LCD_COLOR_WHITE);
+
+    /* No driver call, no pixel */
+    TEST_CHECK_EQ(Calls, 0U);
+    TEST_CHECK_EQ(Violations, 0U);
+    for (x = 0U; (x < (Width * Height)) && (FrameBuffer[x] == BACKGROUND_565); x++)
+    {
+    }
+    TEST_CHECK_EQ(x, Width * Height);
+
+    /* Popping it makes drawing visible again */
+    UTIL_LCD_PopClipRect();
+    UTIL_LCD_GetClipRect(&Clip);
+    UTIL_LCD_SetPixel(5U, 5U, UTIL_LCD_COLOR_WHITE);
+    TEST_CHECK_EQ(FrameBuffer[(5U * Width) + 5U], 0xFFFFU);
+    TEST_CHECK_EQ(Violations, 0U);
+    UTIL_LCD_ResetClipRect();
+  }
+}
+
+/* Random clips, single or nested, over portrait and landscape frame buffers */
+static void TestFrameBuffers(void)
+{
+  static const uint32_t sizes[3][2] = {{240U, 240U}, {320U, 240U}, {240U, 320U}};
+  uint32_t s, t, x, y, w, h, bad;
+  int32_t  ox, oy;
+
+  srand(7U);
+  for (s = 0U; s < 3U; s++)
+  {
+    Width  = sizes[s][0];
+    Height = sizes[s][1];
+    for (t = 0U; t < SCENES; t++)
+    {
+      ox = ((t % 3U) == 0U) ? 0 : ((rand() % 80) - 40);
+      oy = ((t % 3U) == 0U) ? 0 : ((rand() % 80) - 40);
+
+      InitFrameBuffer(Reference);
+      UTIL_LCD_Clear(BACKGROUND);
+      DrawScene(ox, oy);
+
+      InitFrameBuffer(FrameBuffer);
+      UTIL_LCD_Clear(BACKGROUND);
+      if ((t % 2U) != 0U)
+      {
+        RandomArea(t / 2U, &x, &y, &w, &h);
+        TEST_CHECK_EQ(UTIL_LCD_PushClipRect(x, y, w, h), UTIL_LCD_OK);
+      }
+      RandomArea(t, &x, &y, &w, &h);
+      TEST_CHECK_EQ(UTIL_LCD_PushClipRect(x, y, w, h), UTIL_LCD_OK);
+      UTIL_LCD_GetClipRect(&Clip);
+      DrawScene(ox, oy);
+      TEST_CHECK_EQ(Violations, 0U);
+
+      bad = CountWrongPixels(FrameBuffer, 0U, 0U);
+      if (bad != 0U)
+      {
+        (void)printf("%ux%u scene %u: clip %u,%u-%u,%u, %u wrong pixels\n", (unsigned int)Width, (unsigned int)Height,
+                     (unsigned int)t, (unsigned int)Clip.X0, (unsigned int)Clip.Y0, (unsigned int)Clip.X1,
+                     (unsigned int)Clip.Y1, (unsigned int)bad);
+        TestFailures++;
+      }
+      UTIL_LCD_ResetClipRect();
+    }
+  }
+}
+
+/* Clips are in display coordinates, whatever the panel orientation */
+static void TestOrientations(void)
+{
+  uint32_t orientation, t, x, y, w, h, bad;
+  ST7789H2_SIM_Stats_t stats;
+
+  srand(11U);
+  Width  = PANEL_SIZE;
+  Height = PANEL_SIZE;
+  for (orientation = ST7789H2_ORIENTATION_PORTRAIT; orientation <= ST7789H2_ORIENTATION_LANDSCAPE_ROT180; orientation++)
+  {
+    for (t = 0U; t < 12U; t++)
+    {
+      InitFrameBuffer(Reference);
+      UTIL_LCD_Clear(BACKGROUND);
+      DrawScene(0, 0);
+
+      InitPanel(orientation);
+      UTIL_LCD_Clear(BACKGROUND);
+      RandomArea(t, &x, &y, &w, &h);
+      TEST_CHECK_EQ(UTIL_LCD_PushClipRect(x, y, w, h), UTIL_LCD_OK);
+      RandomArea(t + 1U, &x, &y, &w, &h);
+      TEST_CHECK_EQ(UTIL_LCD_PushClipRect(x, y, w, h), UTIL_LCD_OK);
+      UTIL_LCD_GetClipRect(&Clip);
+      ST7789H2_SIM_ResetStats();
+      DrawScene(0, 0);
+      TEST_CHECK_EQ(Violations, 0U);
+
+      ST7789H2_SIM_GetStats(&stats);
+      TEST_CHECK_EQ(stats.Dropped, 0U);
+      ST7789H2_SIM_GetImage(Image);
+      bad = CountWrongPixels(Image, orientation, 1U);
+      if (bad != 0U)
+      {
+        (void)printf("orientation %u scene %u: clip %u,%u-%u,%u, %u wrong pixels\n", (unsigned int)orientation,
+                     (unsigned int)t, (unsigned int)Clip.X0, (unsigned int)Clip.Y0, (unsigned int)Clip.X1,
+                     (unsigned int)Clip.Y1, (unsigned int)bad);
+        TestFailures++;
+      }
+      UTIL_LCD_ResetClipRect();
+    }
+  }
+}
+
+/* Pixel (X, Y) of a 16, 24 or 32 bpp BMP as expected on a display of Format */
+static uint32_t BitmapPixel(const uint8_t *pBmp, uint32_t BmpWidth, uint32_t BmpHeight, uint32_t TopDown,
+                            uint32_t X, uint32_t Y, uint32_t Format)
+{
+  uint32_t bpp = pBmp[28], bytes = pBmp[28] / 8U, value = 0U, k, r, g, b, argb;
+  uint32_t row = (TopDown != 0U) ? Y : (BmpHeight - 1U - Y);
+
+  for (k = 0U; k < bytes; k++)
+  {
+    value |= (uint32_t)pBmp[BITMAP_OFFSET + (row * (((BmpWidth * bytes) + 3U) & ~3U)) + (X * bytes) + k] << (8U * k);
+  }
+
+  if (bpp == 16U)
+  {
+    r    = ((((value >> 11) & 0x1FU) * 255U) + 15U) / 31U;
+    g    = ((((value >> 5) & 0x3FU) * 255U) + 31U) / 63U;
+    b    = (((value & 0x1FU) * 255U) + 15U) / 31U;
+    argb = 0xFF000000U | (r << 16) | (g << 8) | b;
+  }
+  else
+  {
+    argb = (bpp == 24U) ? (0xFF000000U | value) : value;
+  }
+
+  if ((Format == LCD_PIXEL_FORMAT_RGB565) && (bpp == 16U))
+  {
+    argb = value;
+  }
+  else if (Format == LCD_PIXEL_FORMAT_RGB565)
+  {
+    argb = (((argb >> 19) & 0x1FU) << 11) | (((argb >> 10) & 0x3FU) << 5) | ((argb >> 3) & 0x1FU);
+  }
+  else
+  {
+    /* ARGB8888 display */
+  }
+
+  return argb;
+}
+
+/* Partly visible bitmaps of another depth than the display are converted,
+   palette ones are not drawn, whole ones are left to the driver */
+static void TestBitmapDepths(void)
+{
+  static const uint32_t depths[4] = {8U, 16U, 24U, 32U};
+  uint32_t t, i, x, y, x0, y0, x1, y1, bpp, width, height, top_down, bad, inside, whole, drawn;
+  uint32_t cx, cy, cw, ch, expected;
+
+  srand(13U);
+  Width  = PANEL_SIZE;
+  Height = PANEL_SIZE;
+  for (t = 0U; t < 400U; t++)
+  {
+    MemFormat = ((t % 2U) == 0U) ? LCD_PIXEL_FORMAT_RGB565 : LCD_PIXEL_FORMAT_ARGB8888;
+    bpp       = depths[(uint32_t)rand() % 4U];
+    width     = ((t % 3U) == 0U) ? (150U + ((uint32_t)rand() % 91U)) : (1U + ((uint32_t)rand() % 37U));
+    height    = 1U + ((uint32_t)rand() % 40U);
+
+    (void)memset(DepthBitmap, 0, BITMAP_OFFSET);
+    DepthBitmap[0]  = (uint8_t)'B';
+    DepthBitmap[1]  = (uint8_t)'M';
+    DepthBitmap[10] = (uint8_t)BITMAP_OFFSET;
+    DepthBitmap[14] = 40U;
+    DepthBitmap[18] = (uint8_t)width;
+    DepthBitmap[22] = (uint8_t)height;
+    DepthBitmap[26] = 1U;
+    DepthBitmap[28] = (uint8_t)bpp;
+    top_down = ((t % 4U) < 2U) ? 1U : 0U;
+    if (top_down != 0U)
+    {
+      /* Top-down rows */
+      DepthBitmap[22] = (uint8_t)(256U - height);
+      DepthBitmap[23] = 0xFFU;
+      DepthBitmap[24] = 0xFFU;
+      DepthBitmap[25] = 0xFFU;
+    }
+    for (i = BITMAP_OFFSET; i < sizeof(DepthBitmap); i++)
+    {
+      DepthBitmap[i] = (uint8_t)rand();
+    }
+
+    pTarget = &MemDriver;
+    UTIL_LCD_SetFuncDriver(&CheckDriver);
+    for (i = 0U; i < (Width * Height); i++)
+    {
+      MemImage[i] = 0xA5A5A5A5U;
+    }
+    if ((t % 5U) != 0U)
+    {
+      RandomArea((uint32_t)rand(), &cx, &cy, &cw, &ch);
+      TEST_CHECK_EQ(UTIL_LCD_PushClipRect(cx, cy, cw, ch), UTIL_LCD_OK);
+    }
+    UTIL_LCD_GetClipRect(&Clip);
+    Violations = 0U;
+    MemBitmaps = 0U;
+    x = (uint32_t)rand() % (Width + 10U);
+    y = (uint32_t)rand() % (Height + 10U);
+    UTIL_LCD_DrawBitmap(x, y, DepthBitmap);
+    TEST_CHECK_EQ(Violations, 0U);
+
+    /* Visible part of the bitmap */
+    x0    = MAX(x, Clip.X0);
+    y0    = MAX(y, Clip.Y0);
+    x1    = MIN(x + width, Clip.X1);
+    y1    = MIN(y + height, Clip.Y1);
+    whole = ((x0 == x) && (y0 == y) && (x1 == (x + width)) && (y1 == (y + height))) ? 1U : 0U;
+    drawn = ((x0 < x1) && (y0 < y1) && (whole == 0U) && (bpp != 8U)) ? 1U : 0U;
+    TEST_CHECK_EQ(MemBitmaps, whole);
+
+    bad = 0U;
+    for (i = 0U; i < (Width * Height); i++)
+    {
+      inside   = (((i % Width) >= x0) && ((i % Width) < x1) && ((i / Width) >= y0) && ((i / Width) < y1)) ? 1U : 0U;
+      expected = ((drawn != 0U) && (inside != 0U)) ?
+                 BitmapPixel(DepthBitmap, width, height, top_down, (i % Width) - x, (i / Width) - y, MemFormat) :
+                 0xA5A5A5A5U;
+      bad     += (MemImage[i] != expected) ? 1U : 0U;
+    }
+    if (bad != 0U)
+    {
+      (void)printf("%u bpp %ux%u at %u,%u, clip %u,%u-%u,%u: %u wrong pixels\n", (unsigned int)bpp,
+                   (unsigned int)width, (unsigned int)height, (unsigned int)x, (unsigned int)y, (unsigned int)Clip.X0,
+                   (unsigned int)Clip.Y0, (unsigned int)Clip.X1, (unsigned int)Clip.Y1, (unsigned int)bad);
+      TestFailures++;
+    }
+    UTIL_LCD_ResetClipRect();
+  }
+}
+
+int main(void)
+{
+  MakeBitmap();
+  TestPushPop();
+  TestEmptyClip();
+  TestFrameBuffers();
+  TestOrientations();
+  TestBitmapDepths();
+
+  return TEST_RESULT("test_lcd_clip");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,926 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_dl.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_dl.c display list recorder: scenes
+  *          recorded through the UTIL_LCD_DL driver and replayed into a memory
+  *          driver must give the image of a direct draw, as a whole or clipped.
+  *          The run length encoding of the RGB rectangles, the areas returned
+  *          by UTIL_LCD_DL_Diff() for unchanged and edited scenes, the replay
+  *          of cached lists and the recording errors are checked.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_dl.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define IMAGE_SIZE      (320U * 320U)
+#define LIST_SIZE       65536U
+#define BACKGROUND      0xFF123456U
+#define UNTOUCHED       0xA5A5U     /* Memory driver pixel never drawn */
+#define SCENES          40U
+#define EDITS           300U
+#define MAX_OPS         20U
+#define MAX_RECTS       4U
+#define BMP_HEADER      54U
+
+/* Private types -------------------------------------------------------------*/
+/* Drawing of the scenes, through the UTIL_LCD services */
+typedef enum
+{
+  OP_FILL = 0,
+  OP_HLINE,
+  OP_VLINE,
+  OP_PIXEL,
+  OP_TEXT,
+  OP_CIRCLE,
+  OP_BITMAP,
+  OP_COUNT
+} OpType_t;
+
+typedef struct
+{
+  OpType_t Type;
+  uint32_t X;
+  uint32_t Y;
+  uint32_t W;
+  uint32_t H;
+  uint32_t Color;
+} Op_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Reference[IMAGE_SIZE];
+static uint16_t Image[IMAGE_SIZE];
+static uint16_t *Target = Image;   /* Image drawn by the memory driver */
+static uint32_t Width, Height;
+static uint32_t Calls;             /* Memory driver calls            */
+static uint32_t RgbCalls;          /* FillRGBRect calls among them   */
+static uint32_t Guard;             /* Count the pixels out of GuardRect */
+static UTIL_LCD_DL_Rect_t GuardRect;
+static uint32_t Outside;
+
+static UTIL_LCD_DL_t Lists[3];
+static uint8_t  ListBuffers[3][LIST_SIZE];
+static uint16_t CacheBuffer[IMAGE_SIZE + (IMAGE_SIZE / 16U) + 1U];
+static uint8_t  Pixels[2U * IMAGE_SIZE];
+
+/* Bitmaps: bottom-up with padded rows, and top-down */
+static uint8_t  Bitmaps[2][BMP_HEADER + (2U * 40U * 24U)];
+static uint8_t  *Texts[3] = {(uint8_t *)"Display", (uint8_t *)"list", (uint8_t *)"W0#"};
+
+/* Private functions ---------------------------------------------------------*/
+static void Put16(uint8_t *p, uint32_t Value)
+{
+  p[0] = (uint8_t)Value;
+  p[1] = (uint8_t)(Value >> 8);
+}
+
+static void Put32(uint8_t *p, uint32_t Value)
+{
+  Put16(p, Value);
+  Put16(&p[2], Value >> 16);
+}
+
+static uint32_t Get16(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t Get32(const uint8_t *p)
+{
+  return Get16(p) | (Get16(&p[2]) << 16);
+}
+
+/* Memory driver drawing into Target, as a panel driver would */
+static void Plot(uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  if ((Xpos < Width) && (Ypos < Height))
+  {
+    if ((Guard != 0U) &&
+        ((Xpos < GuardRect.Xpos) || (Xpos >= (GuardRect.Xpos + GuardRect.Width)) ||
+         (Ypos < GuardRect.Ypos) || (Ypos >= (GuardRect.Ypos + GuardRect.Height))))
+    {
+      Outside++;
+    }
+    Target[(Ypos * Width) + Xpos] = (uint16_t)Color;
+  }
+}
+
+static int32_t MemDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  int32_t  ret = -1;
+  uint32_t index  = Get32(&pBmp[10]);
+  uint32_t width  = Get32(&pBmp[18]);
+  uint32_t height = Get32(&pBmp[22]);
+  uint32_t stride = ((width * 2U) + 3U) & ~3U;
+  uint32_t top_down = 0U, row, x, y;
+
+  (void)Instance;
+  Calls++;
+  if ((height & 0x80000000U) != 0U)
+  {
+    height   = (uint32_t)(-(int32_t)height);
+    top_down = 1U;
+  }
+  if (Get16(&pBmp[28]) == 16U)
+  {
+    for (y = 0U; y < height; y++)
+    {
+      row = (top_down != 0U) ? y : (height - 1U - y);
+      for (x = 0U; x < width; x++)
+      {
+        Plot(Xpos + x, Ypos + y, Get16(&pBmp[index + (row * stride) + (2U * x)]));
+      }
+    }
+    ret = 0;
+  }
+
+  return ret;
+}
+
+static int32_t MemFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  Calls++;
+  RgbCalls++;
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      Plot(Xpos + x, Ypos + y, Get16(&pData[2U * ((y * W) + x)]));
+    }
+  }
+
+  return 0;
+}
+
+static int32_t MemFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  Calls++;
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      Plot(Xpos + x, Ypos + y, Color);
+    }
+  }
+
+  return 0;
+}
+
+static int32_t MemDrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+static int32_t MemDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+}
+
+static int32_t MemGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  *pColor = Target[(Ypos * Width) + Xpos];
+  return 0;
+}
+
+static int32_t MemSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+static int32_t MemGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  *pXSize = Width;
+  return 0;
+}
+
+static int32_t MemGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  *pYSize = Height;
+  return 0;
+}
+
+static int32_t MemSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t MemGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t MemDriver =
+{
+  MemDrawBitmap,
+  MemFillRGBRect,
+  MemDrawHLine,
+  MemDrawVLine,
+  MemFillRect,
+  MemGetPixel,
+  MemSetPixel,
+  MemGetXSize,
+  MemGetYSize,
+  MemSetLayer,
+  MemGetFormat
+};
+
+/* 16 bpp BMP file, row padding filled with a marker never drawn */
+static void MakeBitmap(uint8_t *pBmp, uint32_t W, uint32_t H, uint32_t TopDown, uint32_t Bpp, uint32_t Seed)
+{
+  uint32_t stride = ((W * 2U) + 3U) & ~3U;
+  uint32_t x, y;
+
+  (void)memset(pBmp, 0, BMP_HEADER);
+  pBmp[0] = (uint8_t)'B';
+  pBmp[1] = (uint8_t)'M';
+  Put32(&pBmp[2], BMP_HEADER + (stride * H));
+  Put32(&pBmp[10], BMP_HEADER);
+  Put32(&pBmp[14], 40U);
+  Put32(&pBmp[18], W);
+  Put32(&pBmp[22], (TopDown != 0U) ? (uint32_t)(-(int32_t)H) : H);
+  Put16(&pBmp[26], 1U);
+  Put16(&pBmp[28], Bpp);
+  (void)memset(&pBmp[BMP_HEADER], 0xEE, stride * H);
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      Put16(&pBmp[BMP_HEADER + (y * stride) + (2U * x)], (Seed + (x * 31U) + (y * 977U)) & 0xFFFFU);
+    }
+  }
+}
+
+static void DrawOp(const Op_t *pOp)
+{
+  switch (pOp->Type)
+  {
+    case OP_FILL:
+      UTIL_LCD_FillRect(pOp->X, pOp->Y, pOp->W, pOp->H, pOp->Color);
+      break;
+
+    case OP_HLINE:
+      UTIL_LCD_DrawHLine(pOp->X, pOp->Y, pOp->W, pOp->Color);
+      break;
+
+    case OP_VLINE:
+      UTIL_LCD_DrawVLine(pOp->X, pOp->Y, pOp->H, pOp->Color);
+      break;
+
+    case OP_PIXEL:
+      UTIL_LCD_SetPixel(pOp->X, pOp->Y, pOp->Color);
+      break;
+
+    case OP_TEXT:
+      UTIL_LCD_SetFont(&Font12);
+      UTIL_LCD_SetTextColor(pOp->Color);
+      UTIL_LCD_SetBackColor(UTIL_LCD_COLOR_LIGHTGRAY);
+      UTIL_LCD_DisplayStringAt(pOp->X, pOp->Y, Texts[pOp->W % 3U], LEFT_MODE);
+      break;
+
+    case OP_CIRCLE:
+      UTIL_LCD_FillCircle(pOp->X, pOp->Y, 1U + (pOp->W % 30U), pOp->Color);
+      break;
+
+    case OP_BITMAP:
+    default:
+      UTIL_LCD_DrawBitmap(pOp->X, pOp->Y, Bitmaps[pOp->W % 2U]);
+      break;
+  }
+}
+
+/* Random primitive, partly out of the display for the rectangles and bitmaps */
+static void RandomOp(Op_t *pOp)
+{
+  pOp->Type  = (OpType_t)((uint32_t)rand() % (uint32_t)OP_COUNT);
+  pOp->X     = (uint32_t)rand() % (Width - 24U);
+  pOp->Y     = (uint32_t)rand() % (Height - 16U);
+  pOp->W     = 1U + ((uint32_t)rand() % 80U);
+  pOp->H     = 1U + ((uint32_t)rand() % 60U);
+  pOp->Color = 0xFF000000U | (uint32_t)rand();
+  if ((pOp->Type == OP_BITMAP) && (((uint32_t)rand() % 2U) != 0U))
+  {
+    /* Bitmap crossing the right edge, sent as RGB rectangles by the utility */
+    pOp->X = Width - 10U;
+  }
+}
+
+static void RandomOps(Op_t *pOps, uint32_t Count)
+{
+  uint32_t i;
+
+  for (i = 0U; i < Count; i++)
+  {
+    RandomOp(&pOps[i]);
+  }
+}
+
+/* Scene on the background, or the primitives only */
+static void DrawOps(const Op_t *pOps, uint32_t Count, uint32_t Background)
+{
+  uint32_t i;
+
+  if (Background != 0U)
+  {
+    UTIL_LCD_Clear(BACKGROUND);
+  }
+  for (i = 0U; i < Count; i++)
+  {
+    DrawOp(&pOps[i]);
+  }
+}
+
+static int32_t RecordOps(UTIL_LCD_DL_t *pList, const Op_t *pOps, uint32_t Count, uint32_t Background)
+{
+  TEST_CHECK_EQ(UTIL_LCD_DL_Begin(pList), UTIL_LCD_DL_OK);
+  UTIL_LCD_SetFuncDriver(&UTIL_LCD_DL_Driver);
+  DrawOps(pOps, Count, Background);
+  return UTIL_LCD_DL_End();
+}
+
+static void DrawReference(const Op_t *pOps, uint32_t Count, uint32_t Background)
+{
+  Target = Reference;
+  UTIL_LCD_SetFuncDriver(&MemDriver);
+  DrawOps(pOps, Count, Background);
+  Target = Image;
+}
+
+/* Display area drawn by a primitive, from a list recording it alone */
+static void OpBounds(const Op_t *pOp, UTIL_LCD_DL_Rect_t *pRect)
+{
+  TEST_CHECK_EQ(RecordOps(&Lists[2], pOp, 1U, 0U), UTIL_LCD_DL_OK);
+  *pRect = Lists[2].Bounds;
+}
+
+static void InitLists(uint32_t W, uint32_t H)
+{
+  uint32_t i;
+
+  Width  = W;
+  Height = H;
+  for (i = 0U; i < 3U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_LCD_DL_Init(&Lists[i], ListBuffers[i], LIST_SIZE, Width, Height), UTIL_LCD_DL_OK);
+  }
+}
+
+static void FillImage(uint16_t *pImage, uint16_t Color)
+{
+  uint32_t i;
+
+  for (i = 0U; i < (Width * Height); i++)
+  {
+    pImage[i] = Color;
+  }
+}
+
+static uint32_t Inside(const UTIL_LCD_DL_Rect_t *pRect, uint32_t Xpos, uint32_t Ypos)
+{
+  return ((Xpos >= pRect->Xpos) && (Xpos < (pRect->Xpos + pRect->Width)) &&
+          (Ypos >= pRect->Ypos) && (Ypos < (pRect->Ypos + pRect->Height))) ? 1U : 0U;
+}
+
+/* Pixels of Image differing from Reference in a rectangle, or not UNTOUCHED
+   out of it; NULL for the whole image */
+static uint32_t CountWrongPixels(const UTIL_LCD_DL_Rect_t *pClip)
+{
+  uint32_t x, y, i, bad = 0U;
+
+  for (y = 0U; y < Height; y++)
+  {
+    for (x = 0U; x < Width; x++)
+    {
+      i = (y * Width) + x;
+      if ((pClip == NULL) || (Inside(pClip, x, y) != 0U))
+      {
+        bad += (Image[i] != Reference[i]) ? 1U : 0U;
+      }
+      else
+      {
+        bad += (Image[i] != UNTOUCHED) ? 1U : 0U;
+      }
+    }
+  }
+
+  return bad;
+}
+
+static void RandomRect(UTIL_LCD_DL_Rect_t *pRect)
+{
+  pRect->Xpos   = (uint32_t)rand() % Width;
+  pRect->Ypos   = (uint32_t)rand() % Height;
+  pRect->Width  = 1U + ((uint32_t)rand() % (Width - pRect->Xpos));
+  pRect->Height = 1U + ((uint32_t)rand() % (Height - pRect->Ypos));
+}
+
+/* Random scenes replayed as a whole and clipped, against a direct draw */
+static void TestReplay(void)
+{
+  static const uint32_t sizes[3][2] = {{240U, 240U}, {320U, 240U}, {200U, 320U}};
+  UTIL_LCD_DL_Rect_t clip;
+  Op_t     ops[MAX_OPS];
+  uint32_t s, t, c;
+
+  for (s = 0U; s < 3U; s++)
+  {
+    InitLists(sizes[s][0], sizes[s][1]);
+    for (t = 0U; t < SCENES; t++)
+    {
+      srand(100U + t);
+      RandomOps(ops, MAX_OPS);
+      TEST_CHECK_EQ(RecordOps(&Lists[0], ops, MAX_OPS, 1U), UTIL_LCD_DL_OK);
+      TEST_CHECK(Lists[0].Count > MAX_OPS);
+      TEST_CHECK_EQ(Lists[0].Bounds.Width, Width);
+      TEST_CHECK_EQ(Lists[0].Bounds.Height, Height);
+      DrawReference(ops, MAX_OPS, 1U);
+
+      FillImage(Image, UNTOUCHED);
+      TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, NULL), UTIL_LCD_DL_OK);
+      TEST_CHECK_EQ(CountWrongPixels(NULL), 0U);
+
+      for (c = 0U; c < 4U; c++)
+      {
+        RandomRect(&clip);
+        FillImage(Image, UNTOUCHED);
+        TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, &clip), UTIL_LCD_DL_OK);
+        TEST_CHECK_EQ(CountWrongPixels(&clip), 0U);
+      }
+    }
+  }
+}
+
+/* RGB rectangles: encoded size and decoding, whole and from any pixel */
+static void TestRle(void)
+{
+  UTIL_LCD_DL_Rect_t clip;
+  uint32_t i, n, run, color, length, c;
+
+  /* Wider than the replay pixel buffer */
+  InitLists(2100U, 40U);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Begin(&Lists[0]), UTIL_LCD_DL_OK);
+  Target = Reference;
+  FillImage(Reference, UNTOUCHED);
+
+  /* A single color: runs of at most 128 pixels */
+  for (i = 0U; i < (37U * 11U); i++)
+  {
+    Put16(&Pixels[2U * i], 0x1234U);
+  }
+  length = Lists[0].Length;
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRGBRect(0U, 3U, 2U, Pixels, 37U, 11U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].Length - length, 13U + (4U * 3U));
+  (void)MemFillRGBRect(0U, 3U, 2U, Pixels, 37U, 11U);
+
+  /* No two neighbours alike: literals of at most 128 pixels */
+  for (i = 0U; i < (37U * 11U); i++)
+  {
+    Put16(&Pixels[2U * i], i);
+  }
+  length = Lists[0].Length;
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRGBRect(0U, 50U, 5U, Pixels, 37U, 11U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].Length - length, 13U + 4U + (2U * 37U * 11U));
+  (void)MemFillRGBRect(0U, 50U, 5U, Pixels, 37U, 11U);
+
+  /* Runs of 128 and 129 pixels, then a pair and literals */
+  for (i = 0U; i < 128U; i++)
+  {
+    Put16(&Pixels[2U * i], 0xAAAAU);
+  }
+  for (; i < 257U; i++)
+  {
+    Put16(&Pixels[2U * i], 0x5555U);
+  }
+  Put16(&Pixels[2U * 257U], 7U);
+  Put16(&Pixels[2U * 258U], 7U);
+  Put16(&Pixels[2U * 259U], 8U);
+  Put16(&Pixels[2U * 260U], 9U);
+  length = Lists[0].Length;
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRGBRect(0U, 100U, 30U, Pixels, 261U, 1U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].Length - length, 13U + 3U + 3U + 3U + 3U + 5U);
+  (void)MemFillRGBRect(0U, 100U, 30U, Pixels, 261U, 1U);
+
+  /* Random runs and literals, rows longer than the pixel buffer */
+  srand(11U);
+  for (i = 0U; i < (2050U * 3U); i += n)
+  {
+    n     = 1U + ((uint32_t)rand() % (((rand() % 3) == 0) ? 300U : 3U));
+    color = (uint32_t)rand() & 0xFFFFU;
+    for (run = 0U; (run < n) && ((i + run) < (2050U * 3U)); run++)
+    {
+      Put16(&Pixels[2U * (i + run)], ((rand() % 4) == 0) ? ((uint32_t)rand() & 0xFFFFU) : color);
+    }
+  }
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRGBRect(0U, 20U, 20U, Pixels, 2050U, 3U), UTIL_LCD_DL_OK);
+  (void)MemFillRGBRect(0U, 20U, 20U, Pixels, 2050U, 3U);
+  TEST_CHECK_EQ(UTIL_LCD_DL_End(), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].Count, 4U);
+  Target = Image;
+
+  FillImage(Image, UNTOUCHED);
+  RgbCalls = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, NULL), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(CountWrongPixels(NULL), 0U);
+  TEST_CHECK_EQ(RgbCalls, 3U + (3U * 2U));
+
+  for (c = 0U; c < 50U; c++)
+  {
+    RandomRect(&clip);
+    FillImage(Image, UNTOUCHED);
+    TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, &clip), UTIL_LCD_DL_OK);
+    TEST_CHECK_EQ(CountWrongPixels(&clip), 0U);
+  }
+}
+
+/* Replay of the new list in the areas returned by UTIL_LCD_DL_Diff(), over
+   the image of the old one, must give the image of the new one */
+static uint32_t Update(const Op_t *pOld, uint32_t OldCount, const Op_t *pNew, uint32_t NewCount,
+                       UTIL_LCD_DL_Rect_t *pRects, uint32_t MaxRects)
+{
+  uint32_t i, count;
+
+  TEST_CHECK_EQ(RecordOps(&Lists[0], pOld, OldCount, 1U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(RecordOps(&Lists[1], pNew, NewCount, 1U), UTIL_LCD_DL_OK);
+  DrawReference(pOld, OldCount, 1U);
+  (void)memcpy(Image, Reference, Width * Height * sizeof(uint16_t));
+  DrawReference(pNew, NewCount, 1U);
+
+  count = UTIL_LCD_DL_Diff(&Lists[0], &Lists[1], pRects, MaxRects);
+  TEST_CHECK(count <= MaxRects);
+  Outside = 0U;
+  for (i = 0U; i < count; i++)
+  {
+    TEST_CHECK(((pRects[i].Xpos + pRects[i].Width) <= Width) && ((pRects[i].Ypos + pRects[i].Height) <= Height));
+    Guard     = 1U;
+    GuardRect = pRects[i];
+    TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[1], &MemDriver, 0U, &pRects[i]), UTIL_LCD_DL_OK);
+    Guard     = 0U;
+  }
+  TEST_CHECK_EQ(Outside, 0U);
+  TEST_CHECK_EQ(CountWrongPixels(NULL), 0U);
+
+  return count;
+}
+
+static void CheckRect(const UTIL_LCD_DL_Rect_t *pRect, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H)
+{
+  TEST_CHECK_EQ(pRect->Xpos, Xpos);
+  TEST_CHECK_EQ(pRect->Ypos, Ypos);
+  TEST_CHECK_EQ(pRect->Width, W);
+  TEST_CHECK_EQ(pRect->Height, H);
+}
+
+/* Widgets: a box and its label each */
+static void TestDiffWidgets(void)
+{
+  UTIL_LCD_DL_Rect_t rects[MAX_RECTS], box;
+  Op_t     ops[MAX_OPS], edit[MAX_OPS + 1U], lines[MAX_OPS + 1U];
+  uint32_t i;
+
+  InitLists(240U, 240U);
+  for (i = 0U; i < 6U; i++)
+  {
+    ops[2U * i].Type        = OP_FILL;
+    ops[2U * i].X           = 10U + ((i % 3U) * 70U);
+    ops[2U * i].Y           = 10U + ((i / 3U) * 60U);
+    ops[2U * i].W           = 60U;
+    ops[2U * i].H           = 40U;
+    ops[2U * i].Color       = UTIL_LCD_COLOR_DARKBLUE + (i * 0x10U);
+    ops[(2U * i) + 1U]      = ops[2U * i];
+    ops[(2U * i) + 1U].Type = OP_TEXT;
+    ops[(2U * i) + 1U].X   += 2U;
+    ops[(2U * i) + 1U].Y   += 2U;
+    ops[(2U * i) + 1U].W    = 2U;
+    ops[(2U * i) + 1U].Color = UTIL_LCD_COLOR_BLACK;
+  }
+
+  /* Same scene: nothing to redraw */
+  TEST_CHECK_EQ(Update(ops, 12U, ops, 12U, rects, MAX_RECTS), 0U);
+
+  /* New color of a box: its label is redrawn too, inside the same box */
+  (void)memcpy(edit, ops, sizeof(ops));
+  edit[8].Color = UTIL_LCD_COLOR_ORANGE;
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 12U, rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], 80U, 70U, 60U, 40U);
+
+  /* Moved box: old and new areas, merged when a single rectangle is allowed */
+  (void)memcpy(edit, ops, sizeof(ops));
+  edit[2].X += 5U;
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 12U, rects, MAX_RECTS), 2U);
+  CheckRect(&rects[0], 80U, 10U, 60U, 40U);
+  CheckRect(&rects[1], 85U, 10U, 60U, 40U);
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 12U, rects, 1U), 1U);
+  CheckRect(&rects[0], 80U, 10U, 65U, 40U);
+
+  /* First and last boxes changed: every command between them is redrawn,
+     merged in the rectangles growing the least */
+  (void)memcpy(edit, ops, sizeof(ops));
+  edit[0].Color  = UTIL_LCD_COLOR_RED;
+  edit[10].Color = UTIL_LCD_COLOR_RED;
+  TEST_CHECK(Update(ops, 12U, edit, 12U, rects, 2U) <= 2U);
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 12U, rects, 1U), 1U);
+  CheckRect(&rects[0], 10U, 10U, 200U, 100U);
+
+  /* Commands differing in their op code only: no common trailing command */
+  (void)memcpy(edit, ops, sizeof(ops));
+  edit[12]      = ops[0];
+  edit[12].Type = OP_HLINE;
+  edit[12].X    = 20U;
+  edit[12].Y    = 180U;
+  edit[12].W    = 50U;
+  edit[12].H    = 50U;
+  (void)memcpy(lines, edit, sizeof(lines));
+  lines[12].Type = OP_VLINE;
+  TEST_CHECK_EQ(Update(edit, 13U, lines, 13U, rects, MAX_RECTS), 2U);
+  CheckRect(&rects[0], 20U, 180U, 50U, 1U);
+  CheckRect(&rects[1], 20U, 180U, 1U, 50U);
+
+  /* Command appended, inserted at the start, removed in the middle */
+  (void)memcpy(edit, ops, sizeof(ops));
+  edit[12]      = ops[0];
+  edit[12].Type = OP_PIXEL;
+  edit[12].X    = 239U;
+  edit[12].Y    = 239U;
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 13U, rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], 239U, 239U, 1U, 1U);
+
+  edit[0] = edit[12];
+  edit[0].Type = OP_FILL;
+  edit[0].X = 200U;
+  edit[0].Y = 150U;
+  edit[0].W = 30U;
+  edit[0].H = 70U;
+  (void)memcpy(&edit[1], ops, sizeof(ops));
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 13U, rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], 200U, 150U, 30U, 70U);
+
+  (void)memcpy(edit, ops, 5U * sizeof(Op_t));
+  (void)memcpy(&edit[5], &ops[6], 6U * sizeof(Op_t));
+  OpBounds(&ops[5], &box);
+  TEST_CHECK_EQ(Update(ops, 12U, edit, 11U, rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], box.Xpos, box.Ypos, box.Width, box.Height);
+}
+
+/* Random edits of random scenes: the areas stay within the edited primitives */
+static void TestDiffEdits(void)
+{
+  UTIL_LCD_DL_Rect_t rects[MAX_RECTS], old_box, new_box;
+  Op_t     ops[MAX_OPS], edit[MAX_OPS];
+  uint32_t t, i, n, k, count, kind, x0, y0, x1, y1;
+
+  InitLists(240U, 240U);
+  srand(7U);
+  for (t = 0U; t < EDITS; t++)
+  {
+    n = 2U + ((uint32_t)rand() % (MAX_OPS - 2U));
+    RandomOps(ops, n);
+    (void)memcpy(edit, ops, sizeof(ops));
+    k    = (uint32_t)rand() % n;
+    kind = (uint32_t)rand() % 4U;
+    (void)memset(&old_box, 0, sizeof(old_box));
+    (void)memset(&new_box, 0, sizeof(new_box));
+
+    if (kind == 0U)
+    {
+      /* Primitive replaced */
+      RandomOp(&edit[k]);
+      if ((t % 2U) == 0U)
+      {
+        /* Same primitive elsewhere or in another color */
+        edit[k]      = ops[k];
+        edit[k].X   += (uint32_t)rand() % 3U;
+        edit[k].Color ^= (uint32_t)rand() & 0xFFFFU;
+      }
+      OpBounds(&ops[k], &old_box);
+      OpBounds(&edit[k], &new_box);
+      count = Update(ops, n, edit, n, rects, 1U + ((uint32_t)rand() % MAX_RECTS));
+    }
+    else if (kind == 1U)
+    {
+      /* Primitive inserted */
+      (void)memmove(&edit[k + 1U], &ops[k], (n - 1U - k) * sizeof(Op_t));
+      RandomOp(&edit[k]);
+      OpBounds(&edit[k], &new_box);
+      count = Update(ops, n - 1U, edit, n, rects, 1U + ((uint32_t)rand() % MAX_RECTS));
+    }
+    else if (kind == 2U)
+    {
+      /* Primitive removed */
+      (void)memmove(&edit[k], &ops[k + 1U], (n - k - 1U) * sizeof(Op_t));
+      OpBounds(&ops[k], &old_box);
+      count = Update(ops, n, edit, n - 1U, rects, 1U + ((uint32_t)rand() % MAX_RECTS));
+    }
+    else
+    {
+      /* Two primitives replaced: only the result is checked */
+      RandomOp(&edit[k]);
+      RandomOp(&edit[(uint32_t)rand() % n]);
+      (void)Update(ops, n, edit, n, rects, 1U + ((uint32_t)rand() % MAX_RECTS));
+      count = 0U;
+    }
+
+    /* Bounding box of the edited areas */
+    x0 = Width;
+    y0 = Height;
+    x1 = 0U;
+    y1 = 0U;
+    if (old_box.Width != 0U)
+    {
+      x0 = old_box.Xpos;
+      y0 = old_box.Ypos;
+      x1 = old_box.Xpos + old_box.Width;
+      y1 = old_box.Ypos + old_box.Height;
+    }
+    if (new_box.Width != 0U)
+    {
+      x0 = (new_box.Xpos < x0) ? new_box.Xpos : x0;
+      y0 = (new_box.Ypos < y0) ? new_box.Ypos : y0;
+      x1 = ((new_box.Xpos + new_box.Width) > x1) ? (new_box.Xpos + new_box.Width) : x1;
+      y1 = ((new_box.Ypos + new_box.Height) > y1) ? (new_box.Ypos + new_box.Height) : y1;
+    }
+    for (i = 0U; i < count; i++)
+    {
+      TEST_CHECK((rects[i].Xpos >= x0) && (rects[i].Ypos >= y0) &&
+                 ((rects[i].Xpos + rects[i].Width) <= x1) && ((rects[i].Ypos + rects[i].Height) <= y1));
+    }
+  }
+}
+
+/* Cached lists replay the image of their commands */
+static void TestCache(void)
+{
+  static const UTIL_LCD_DL_Rect_t clips[3] = {{0U, 37U, 240U, 50U}, {13U, 29U, 101U, 77U}, {239U, 0U, 1U, 240U}};
+  UTIL_LCD_DL_Rect_t clip;
+  Op_t     ops[MAX_OPS + 2U];
+  uint32_t size, c;
+
+  InitLists(240U, 240U);
+
+  /* Scene on a background: one rectangle for whole rows */
+  srand(21U);
+  RandomOps(ops, MAX_OPS);
+  TEST_CHECK_EQ(RecordOps(&Lists[0], ops, MAX_OPS, 1U), UTIL_LCD_DL_OK);
+  DrawReference(ops, MAX_OPS, 1U);
+  size = UTIL_LCD_DL_GetCacheSize(&Lists[0]);
+  TEST_CHECK_EQ(size, (2U * 240U * 240U) + ((240U * 240U) / 8U));
+  TEST_CHECK_EQ(UTIL_LCD_DL_Cache(&Lists[0], (uint8_t *)CacheBuffer, size - 1U), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Cache(&Lists[0], &((uint8_t *)CacheBuffer)[1], size), UTIL_LCD_DL_ERROR);
+  TEST_CHECK(Lists[0].pCache == NULL);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Cache(&Lists[0], (uint8_t *)CacheBuffer, size), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].CacheFull, 1U);
+
+  FillImage(Image, UNTOUCHED);
+  Calls    = 0U;
+  RgbCalls = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, NULL), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Calls, 1U);
+  TEST_CHECK_EQ(RgbCalls, 1U);
+  TEST_CHECK_EQ(CountWrongPixels(NULL), 0U);
+
+  for (c = 0U; c < 3U; c++)
+  {
+    FillImage(Image, UNTOUCHED);
+    Calls = 0U;
+    TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, &clips[c]), UTIL_LCD_DL_OK);
+    TEST_CHECK_EQ(Calls, (clips[c].Width == Width) ? 1U : clips[c].Height);
+    TEST_CHECK_EQ(CountWrongPixels(&clips[c]), 0U);
+  }
+
+  /* Recording again drops the cache */
+  TEST_CHECK_EQ(RecordOps(&Lists[0], ops, MAX_OPS, 1U), UTIL_LCD_DL_OK);
+  TEST_CHECK(Lists[0].pCache == NULL);
+
+  /* Sparse primitives: only the drawn pixels are sent */
+  ops[MAX_OPS]          = ops[0];
+  ops[MAX_OPS].Type     = OP_PIXEL;
+  ops[MAX_OPS].X        = 1U;
+  ops[MAX_OPS].Y        = 2U;
+  ops[MAX_OPS + 1U]     = ops[MAX_OPS];
+  ops[MAX_OPS + 1U].X   = 238U;
+  ops[MAX_OPS + 1U].Y   = 237U;
+  for (c = 0U; c < 4U; c++)
+  {
+    srand(30U + c);
+    RandomOps(ops, 3U);
+    (void)memcpy(&ops[3], &ops[MAX_OPS], 2U * sizeof(Op_t));
+    TEST_CHECK_EQ(RecordOps(&Lists[0], ops, 5U, 0U), UTIL_LCD_DL_OK);
+    FillImage(Reference, UNTOUCHED);
+    DrawReference(ops, 5U, 0U);
+    TEST_CHECK_EQ(UTIL_LCD_DL_Cache(&Lists[0], (uint8_t *)CacheBuffer, sizeof(CacheBuffer)), UTIL_LCD_DL_OK);
+    TEST_CHECK_EQ(Lists[0].CacheFull, 0U);
+
+    FillImage(Image, UNTOUCHED);
+    TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, NULL), UTIL_LCD_DL_OK);
+    TEST_CHECK_EQ(CountWrongPixels(NULL), 0U);
+
+    RandomRect(&clip);
+    FillImage(Image, UNTOUCHED);
+    TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[0], &MemDriver, 0U, &clip), UTIL_LCD_DL_OK);
+    TEST_CHECK_EQ(CountWrongPixels(&clip), 0U);
+  }
+}
+
+/* Incomplete lists are reported and fully redrawn */
+static void TestErrors(void)
+{
+  UTIL_LCD_DL_Rect_t rects[MAX_RECTS];
+  uint32_t value, i;
+  Op_t     op;
+
+  InitLists(240U, 240U);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Init(&Lists[2], ListBuffers[2], LIST_SIZE, 0x10000U, 240U), UTIL_LCD_DL_ERROR);
+
+  /* Nothing drawn, nothing recorded */
+  TEST_CHECK_EQ(UTIL_LCD_DL_Begin(&Lists[0]), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRect(0U, 10U, 10U, 0U, 5U, 0U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(UTIL_LCD_DL_GetPixel(0U, 10U, 10U, &value), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_DL_End(), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(Lists[0].Count, 0U);
+  TEST_CHECK_EQ(Lists[0].Length, 0U);
+
+  /* Buffer overflow: the partial command is dropped */
+  TEST_CHECK_EQ(UTIL_LCD_DL_Init(&Lists[1], ListBuffers[1], 60U, Width, Height), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Begin(&Lists[1]), UTIL_LCD_DL_OK);
+  for (i = 0U; i < 6U; i++)
+  {
+    (void)UTIL_LCD_DL_FillRect(0U, i, i, 10U, 10U, i);
+  }
+  TEST_CHECK_EQ(UTIL_LCD_DL_End(), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(Lists[1].Error, 1U);
+  TEST_CHECK_EQ(Lists[1].Count, 5U);
+  TEST_CHECK_EQ(Lists[1].Length, 5U * 11U);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Replay(&Lists[1], &MemDriver, 0U, NULL), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Cache(&Lists[1], (uint8_t *)CacheBuffer, sizeof(CacheBuffer)), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Diff(&Lists[0], &Lists[1], rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], 0U, 0U, Width, Height);
+
+  /* Fields out of the 16-bit range */
+  TEST_CHECK_EQ(UTIL_LCD_DL_Begin(&Lists[1]), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(UTIL_LCD_DL_FillRect(0U, 0x10000U, 0U, 1U, 1U, 0U), UTIL_LCD_DL_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_DL_End(), UTIL_LCD_DL_ERROR);
+
+  /* Bitmaps other than RGB565 cannot be recorded */
+  MakeBitmap(Bitmaps[1], 8U, 8U, 0U, 24U, 0U);
+  op.Type  = OP_BITMAP;
+  op.X     = 10U;
+  op.Y     = 10U;
+  op.W     = 1U;
+  op.H     = 1U;
+  op.Color = 0U;
+  TEST_CHECK_EQ(RecordOps(&Lists[1], &op, 1U, 1U), UTIL_LCD_DL_ERROR);
+  MakeBitmap(Bitmaps[1], 23U, 24U, 1U, 16U, 0x4321U);
+
+  /* Other display size */
+  TEST_CHECK_EQ(UTIL_LCD_DL_Init(&Lists[1], ListBuffers[1], LIST_SIZE, Width, Height - 1U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(RecordOps(&Lists[1], &op, 0U, 1U), UTIL_LCD_DL_OK);
+  TEST_CHECK_EQ(UTIL_LCD_DL_Diff(&Lists[0], &Lists[1], rects, MAX_RECTS), 1U);
+  CheckRect(&rects[0], 0U, 0U, Width, Height - 1U);
+}
+
+int main(void)
+{
+  MakeBitmap(Bitmaps[0], 13U, 17U, 0U, 16U, 0x1234U);
+  MakeBitmap(Bitmaps[1], 23U, 24U, 1U, 16U, 0x4321U);
+
+  TestReplay();
+  TestRle();
+  TestDiffWidgets();
+  TestDiffEdits();
+  TestCache();
+  TestErrors();
+
+  return TEST_RESULT("test_lcd_dl");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
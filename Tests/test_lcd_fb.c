@@ -0,0 +1,451 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_fb.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_fb.c off-screen frame buffer flushed to
+  *          its memory target: scenes drawn through the frame buffer must
+  *          give the image of a direct draw, in full and banded buffers, with
+  *          fewer target windows than direct driver calls. Dirty rectangle
+  *          merging, the flushed windows and their command counts, and the
+  *          regions kept on a failed flush are checked.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_fb.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define MAX_SIZE        320U
+#define BACKGROUND      0xFF123456U
+#define UNTOUCHED       0xA5A5U     /* Memory target pixel never flushed */
+#define SCENES          60U
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Reference[MAX_SIZE * MAX_SIZE];
+static uint16_t FrameBuffer[MAX_SIZE * MAX_SIZE];
+static uint16_t Image[MAX_SIZE * MAX_SIZE];
+static uint32_t Width, Height;
+static uint32_t DirectCalls;   /* Driver calls of the direct draw, one window each on a panel */
+static uint32_t FailWindows;   /* SetWindow calls failing before the target recovers */
+
+/* Private functions ---------------------------------------------------------*/
+/* Direct draw into Reference, as a panel driver would, counting its calls */
+static int32_t RefFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  DirectCalls++;
+  for (y = Ypos; (y < (Ypos + H)) && (y < Height); y++)
+  {
+    for (x = Xpos; (x < (Xpos + W)) && (x < Width); x++)
+    {
+      Reference[(y * Width) + x] = (uint16_t)Color;
+    }
+  }
+
+  return 0;
+}
+
+static int32_t RefDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)pBmp;
+  (void)printf("unexpected DrawBitmap\n");
+  TestFailures++;
+  return -1;
+}
+
+static int32_t RefFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  DirectCalls++;
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      if (((Xpos + x) < Width) && ((Ypos + y) < Height))
+      {
+        Reference[((Ypos + y) * Width) + Xpos + x] =
+          (uint16_t)((uint32_t)pData[2U * ((y * W) + x)] | ((uint32_t)pData[(2U * ((y * W) + x)) + 1U] << 8));
+      }
+    }
+  }
+
+  return 0;
+}
+
+static int32_t RefDrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return RefFillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+static int32_t RefDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return RefFillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+}
+
+static int32_t RefGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  *pColor = Reference[(Ypos * Width) + Xpos];
+  return 0;
+}
+
+static int32_t RefSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return RefFillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+static int32_t RefGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  *pXSize = Width;
+  return 0;
+}
+
+static int32_t RefGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  *pYSize = Height;
+  return 0;
+}
+
+static int32_t RefSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t RefGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t RefDriver =
+{
+  RefDrawBitmap,
+  RefFillRGBRect,
+  RefDrawHLine,
+  RefDrawVLine,
+  RefFillRect,
+  RefGetPixel,
+  RefSetPixel,
+  RefGetXSize,
+  RefGetYSize,
+  RefSetLayer,
+  RefGetFormat
+};
+
+/* Memory target whose first FailWindows windows fail, as an aborted bus transfer */
+static int32_t FailSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H)
+{
+  int32_t ret;
+
+  if (FailWindows != 0U)
+  {
+    FailWindows--;
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    ret = UTIL_LCD_FB_MemTarget.SetWindow(Instance, Xpos, Ypos, W, H);
+  }
+
+  return ret;
+}
+
+static int32_t FailWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  return UTIL_LCD_FB_MemTarget.WritePixels(Instance, pData, Length);
+}
+
+static const UTIL_LCD_FB_Target_t FailTarget =
+{
+  FailSetWindow,
+  FailWritePixels
+};
+
+/* A few primitives at random places, text runs included */
+static void DrawScene(uint32_t Seed)
+{
+  uint32_t x, y;
+  Point    pts[4];
+
+  srand(Seed);
+  x = (uint32_t)rand() % Width;
+  y = (uint32_t)rand() % Height;
+  pts[0].X = (int16_t)x;                            pts[0].Y = (int16_t)y;
+  pts[1].X = (int16_t)((uint32_t)rand() % Width);   pts[1].Y = (int16_t)((uint32_t)rand() % Height);
+  pts[2].X = (int16_t)((uint32_t)rand() % Width);   pts[2].Y = (int16_t)((uint32_t)rand() % Height);
+  pts[3].X = (int16_t)((uint32_t)rand() % Width);   pts[3].Y = (int16_t)((uint32_t)rand() % Height);
+
+  UTIL_LCD_FillRect(x / 2U, y / 2U, 1U + ((uint32_t)rand() % 80U), 1U + ((uint32_t)rand() % 80U), 0xFF000000U | (uint32_t)rand());
+  UTIL_LCD_DrawLine(x, y, (uint32_t)rand() % Width, (uint32_t)rand() % Height, UTIL_LCD_COLOR_WHITE);
+  UTIL_LCD_FillCircle(x, y, 1U + ((uint32_t)rand() % 40U), UTIL_LCD_COLOR_YELLOW);
+  UTIL_LCD_DrawCircle((uint32_t)rand() % Width, (uint32_t)rand() % Height, 1U + ((uint32_t)rand() % 60U), UTIL_LCD_COLOR_CYAN);
+  UTIL_LCD_FillPolygon(pts, 4U, UTIL_LCD_COLOR_DARKGREEN);
+  UTIL_LCD_DrawRect((uint32_t)rand() % Width, (uint32_t)rand() % Height, 1U + ((uint32_t)rand() % 100U),
+                    1U + ((uint32_t)rand() % 100U), UTIL_LCD_COLOR_BROWN);
+  UTIL_LCD_SetFont(&Font16);
+  UTIL_LCD_SetTextColor(UTIL_LCD_COLOR_BLACK);
+  UTIL_LCD_SetBackColor(UTIL_LCD_COLOR_LIGHTGRAY);
+  UTIL_LCD_DisplayStringAt((uint32_t)rand() % (Width / 2U), (uint32_t)rand() % (Height - 16U), (uint8_t *)"Frame buffer", LEFT_MODE);
+  UTIL_LCD_SetPixel(Width - 1U, Height - 1U, UTIL_LCD_COLOR_RED);
+}
+
+static void InitFrameBuffer(uint32_t BandHeight, const UTIL_LCD_FB_Target_t *pTarget)
+{
+  UTIL_LCD_FB_Init_t init;
+
+  init.pBuffer    = FrameBuffer;
+  init.Width      = Width;
+  init.Height     = Height;
+  init.BandHeight = BandHeight;
+  init.Instance   = 0U;
+  init.pTarget    = pTarget;
+  TEST_CHECK_EQ(UTIL_LCD_FB_Init(&init), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_MemTargetInit(Image, Width, Height), UTIL_LCD_FB_OK);
+  UTIL_LCD_SetFuncDriver(&UTIL_LCD_FB_Driver);
+}
+
+static void DrawReference(uint32_t Seed)
+{
+  UTIL_LCD_SetFuncDriver(&RefDriver);
+  UTIL_LCD_Clear(BACKGROUND);
+  DirectCalls = 0U;
+  DrawScene(Seed);
+}
+
+static uint32_t CountWrongPixels(void)
+{
+  uint32_t i, bad = 0U;
+
+  for (i = 0U; i < (Width * Height); i++)
+  {
+    bad += (Image[i] != Reference[i]) ? 1U : 0U;
+  }
+
+  return bad;
+}
+
+/* Merging of the dirty rectangles and command counts of the flush */
+static void TestDirtyRects(void)
+{
+  UTIL_LCD_FB_Rect_t  rects[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+  UTIL_LCD_FB_Stats_t stats, mem;
+  uint32_t i, k, n, x, y, covered, area;
+
+  Width  = 240U;
+  Height = 240U;
+  InitFrameBuffer(Height, &UTIL_LCD_FB_MemTarget);
+
+  /* Full screen clear: one window, one write */
+  UTIL_LCD_Clear(BACKGROUND);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 1U);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+  UTIL_LCD_FB_MemTargetGetStats(&mem);
+  TEST_CHECK_EQ(mem.RegionCount, 1U);
+  TEST_CHECK_EQ(mem.WriteCount, 1U);
+  TEST_CHECK_EQ(mem.PixelCount, Width * Height);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 0U);
+
+  /* Touching rectangles merge into their bounding box */
+  TEST_CHECK_EQ(UTIL_LCD_FB_MemTargetInit(Image, Width, Height), UTIL_LCD_FB_OK);
+  UTIL_LCD_FillRect(10U, 10U, 20U, 10U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_FillRect(30U, 10U, 20U, 10U, UTIL_LCD_COLOR_RED);
+  UTIL_LCD_FillRect(10U, 20U, 40U, 5U, UTIL_LCD_COLOR_RED);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 1U);
+  TEST_CHECK_EQ(rects[0].Xpos, 10U);
+  TEST_CHECK_EQ(rects[0].Ypos, 10U);
+  TEST_CHECK_EQ(rects[0].Width, 40U);
+  TEST_CHECK_EQ(rects[0].Height, 15U);
+
+  /* Far apart rectangles are kept, each flushed in its window, row by row */
+  UTIL_LCD_FillRect(200U, 200U, 8U, 4U, UTIL_LCD_COLOR_BLUE);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 2U);
+  UTIL_LCD_FB_ResetStats();
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+  UTIL_LCD_FB_GetStats(&stats);
+  UTIL_LCD_FB_MemTargetGetStats(&mem);
+  TEST_CHECK_EQ(stats.FlushCount, 1U);
+  TEST_CHECK_EQ(stats.RegionCount, 2U);
+  TEST_CHECK_EQ(stats.WriteCount, 15U + 4U);
+  TEST_CHECK_EQ(stats.PixelCount, (40U * 15U) + (8U * 4U));
+  TEST_CHECK_EQ(mem.RegionCount, stats.RegionCount);
+  TEST_CHECK_EQ(mem.WriteCount, stats.WriteCount);
+  TEST_CHECK_EQ(mem.PixelCount, stats.PixelCount);
+
+  /* More rectangles than the list holds: merged, every pixel still covered */
+  srand(3U);
+  area = 0U;
+  for (i = 0U; i < (4U * UTIL_LCD_FB_MAX_DIRTY_RECTS); i++)
+  {
+    UTIL_LCD_SetPixel((i * 29U) % Width, (i * 53U) % Height, UTIL_LCD_COLOR_WHITE);
+  }
+  n = UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS);
+  TEST_CHECK(n <= UTIL_LCD_FB_MAX_DIRTY_RECTS);
+  for (i = 0U; i < (4U * UTIL_LCD_FB_MAX_DIRTY_RECTS); i++)
+  {
+    x       = (i * 29U) % Width;
+    y       = (i * 53U) % Height;
+    covered = 0U;
+    for (k = 0U; k < n; k++)
+    {
+      covered |= ((x >= rects[k].Xpos) && (x < (rects[k].Xpos + rects[k].Width)) &&
+                  (y >= rects[k].Ypos) && (y < (rects[k].Ypos + rects[k].Height))) ? 1U : 0U;
+    }
+    area += covered;
+  }
+  TEST_CHECK_EQ(area, 4U * UTIL_LCD_FB_MAX_DIRTY_RECTS);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+  for (i = 0U; i < (4U * UTIL_LCD_FB_MAX_DIRTY_RECTS); i++)
+  {
+    TEST_CHECK_EQ(Image[(((i * 53U) % Height) * Width) + ((i * 29U) % Width)], 0xFFFFU);
+  }
+}
+
+/* Only the flushed windows reach the target */
+static void TestFlushedWindows(void)
+{
+  UTIL_LCD_FB_Rect_t rects[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+  uint32_t           x, y, inside, bad = 0U;
+
+  Width  = 240U;
+  Height = 240U;
+  InitFrameBuffer(Height, &UTIL_LCD_FB_MemTarget);
+  UTIL_LCD_Clear(BACKGROUND);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+
+  for (x = 0U; x < (Width * Height); x++)
+  {
+    Image[x] = UNTOUCHED;
+  }
+  UTIL_LCD_FillRect(50U, 60U, 30U, 20U, UTIL_LCD_COLOR_GREEN);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+  for (y = 0U; y < Height; y++)
+  {
+    for (x = 0U; x < Width; x++)
+    {
+      inside = ((x >= 50U) && (x < 80U) && (y >= 60U) && (y < 80U)) ? 1U : 0U;
+      bad   += ((inside != 0U) ? (Image[(y * Width) + x] != FrameBuffer[(y * Width) + x]) :
+                                 (Image[(y * Width) + x] != UNTOUCHED)) ? 1U : 0U;
+    }
+  }
+  TEST_CHECK_EQ(bad, 0U);
+
+  /* The last band runs past the display: nothing is flushed below it */
+  InitFrameBuffer(17U, &UTIL_LCD_FB_MemTarget);
+  TEST_CHECK_EQ(UTIL_LCD_FB_SetBand(238U), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Invalidate(0U, 230U, Width, 40U), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 1U);
+  TEST_CHECK_EQ(rects[0].Ypos, 238U);
+  TEST_CHECK_EQ(rects[0].Height, 2U);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+}
+
+/* A failed flush keeps the regions, sent again by the next one */
+static void TestFlushError(void)
+{
+  UTIL_LCD_FB_Rect_t rects[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+
+  Width  = 240U;
+  Height = 240U;
+  InitFrameBuffer(Height, &FailTarget);
+  DrawReference(5U);
+  UTIL_LCD_SetFuncDriver(&UTIL_LCD_FB_Driver);
+  UTIL_LCD_Clear(BACKGROUND);
+  DrawScene(5U);
+
+  FailWindows = 1U;
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_ERROR);
+  TEST_CHECK(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS) != 0U);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS), 0U);
+  TEST_CHECK_EQ(CountWrongPixels(), 0U);
+}
+
+/* Random scenes, full and banded buffers, against a direct draw */
+static void TestScenes(void)
+{
+  static const uint32_t sizes[3][2] = {{240U, 240U}, {320U, 240U}, {240U, 320U}};
+  static const uint32_t bands[3] = {0U, 40U, 17U};   /* 0 for a full buffer */
+  UTIL_LCD_FB_Stats_t mem;
+  uint32_t s, b, t, y, bad, band;
+
+  for (s = 0U; s < 3U; s++)
+  {
+    Width  = sizes[s][0];
+    Height = sizes[s][1];
+    for (b = 0U; b < 3U; b++)
+    {
+      band = (bands[b] == 0U) ? Height : bands[b];
+      for (t = 0U; t < SCENES; t++)
+      {
+        DrawReference(100U + t);
+
+        InitFrameBuffer(band, &UTIL_LCD_FB_MemTarget);
+        for (y = 0U; y < Height; y += band)
+        {
+          TEST_CHECK_EQ(UTIL_LCD_FB_SetBand(y), UTIL_LCD_FB_OK);
+          UTIL_LCD_Clear(BACKGROUND);
+          DrawScene(100U + t);
+          TEST_CHECK_EQ(UTIL_LCD_FB_Flush(), UTIL_LCD_FB_OK);
+        }
+
+        bad = CountWrongPixels();
+        UTIL_LCD_FB_MemTargetGetStats(&mem);
+        if (bad != 0U)
+        {
+          (void)printf("%ux%u band %u scene %u: %u wrong pixels\n", (unsigned int)Width, (unsigned int)Height,
+                       (unsigned int)band, (unsigned int)t, (unsigned int)bad);
+          TestFailures++;
+        }
+
+        /* At most the dirty list per band, far fewer windows than direct calls */
+        TEST_CHECK(mem.RegionCount <= (UTIL_LCD_FB_MAX_DIRTY_RECTS * ((Height + band - 1U) / band)));
+        if (band == Height)
+        {
+          TEST_CHECK_EQ(mem.RegionCount, 1U);
+          TEST_CHECK((4U * mem.RegionCount) < DirectCalls);
+        }
+      }
+    }
+  }
+}
+
+int main(void)
+{
+  TestDirtyRects();
+  TestFlushedWindows();
+  TestFlushError();
+  TestScenes();
+
+  return TEST_RESULT("test_lcd_fb");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
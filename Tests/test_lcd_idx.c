@@ -0,0 +1,458 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_idx.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_idx.c indexed frame buffer: the flush
+  *          of random dirty areas is compared with an independent expansion
+  *          of the L8 and AL44 pixel values, AL44 entries being blended over
+  *          CLUT entry 0, and the writes must fill UTIL_LCD_IDX_LINE_SIZE
+  *          pixels whatever the area width.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_idx.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#ifndef TEST_NAME
+  #define TEST_NAME     "test_lcd_idx"
+#endif
+#define WIDTH           200U
+#define HEIGHT          90U
+#define UNTOUCHED       0xA5A5U     /* Panel pixel never written */
+#define TRIALS          60U
+#define MIN(a, b)       (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)       (((a) > (b)) ? (a) : (b))
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t X0;
+  uint32_t Y0;
+  uint32_t X1;
+  uint32_t Y1;
+} Box_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint8_t  Buffer[WIDTH * HEIGHT];
+static uint16_t Panel[WIDTH * HEIGHT];
+static uint16_t Previous[WIDTH * HEIGHT];
+static uint32_t Clut[UTIL_LCD_IDX_CLUT_SIZE];
+
+/* Recording target: one window, pixels streamed row after row */
+static Box_t    Window;
+static uint32_t Cursor, Windows, Writes, ShortWrites, Overflows, FailWindow, FailWrite;
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t PanelSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H)
+{
+  int32_t ret = 0;
+
+  (void)Instance;
+  if (FailWindow != 0U)
+  {
+    ret = -1;
+  }
+  else
+  {
+    Window.X0 = Xpos;
+    Window.Y0 = Ypos;
+    Window.X1 = Xpos + W;
+    Window.Y1 = Ypos + H;
+    Cursor    = 0U;
+    Windows++;
+  }
+
+  return ret;
+}
+
+static int32_t PanelWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  uint32_t i, w = Window.X1 - Window.X0;
+  int32_t  ret = 0;
+
+  (void)Instance;
+  Writes++;
+  ShortWrites += (Length != UTIL_LCD_IDX_LINE_SIZE) ? 1U : 0U;
+  if (FailWrite != 0U)
+  {
+    ret = -1;
+  }
+  for (i = 0U; i < Length; i++)
+  {
+    if (Cursor < (w * (Window.Y1 - Window.Y0)))
+    {
+      Panel[((Window.Y0 + (Cursor / w)) * WIDTH) + Window.X0 + (Cursor % w)] =
+        (uint16_t)((uint32_t)pData[2U * i] | ((uint32_t)pData[(2U * i) + 1U] << 8));
+    }
+    else
+    {
+      Overflows++;
+    }
+    Cursor++;
+  }
+
+  return ret;
+}
+
+static const UTIL_LCD_FB_Target_t PanelTarget =
+{
+  PanelSetWindow,
+  PanelWritePixels
+};
+
+static uint32_t ToRgb565(uint32_t Argb)
+{
+  return (((Argb >> 19) & 0x1FU) << 11) | (((Argb >> 10) & 0x3FU) << 5) | ((Argb >> 3) & 0x1FU);
+}
+
+/* Expected RGB565 pixel of a value: CLUT entry, or AL44 blend over entry 0 */
+static uint16_t Expand(uint32_t Format, uint8_t Value)
+{
+  static const uint32_t shift[3] = {11U, 5U, 0U};
+  static const uint32_t mask[3]  = {0x1FU, 0x3FU, 0x1FU};
+  uint32_t fg, bg, alpha, i, color = 0U;
+  double   field;
+
+  if (Format == LCD_PIXEL_FORMAT_L8)
+  {
+    color = ToRgb565(Clut[Value]);
+  }
+  else
+  {
+    fg    = ToRgb565(Clut[Value & 0x0FU]);
+    bg    = ToRgb565(Clut[0]);
+    alpha = (uint32_t)Value >> 4;
+    for (i = 0U; i < 3U; i++)
+    {
+      field  = (((double)((fg >> shift[i]) & mask[i]) * (double)alpha) +
+                ((double)((bg >> shift[i]) & mask[i]) * (double)(15U - alpha))) / 15.0;
+      color |= (uint32_t)floor(field + 0.5) << shift[i];
+    }
+  }
+
+  return (uint16_t)color;
+}
+
+static void InitIdx(uint32_t Format)
+{
+  UTIL_LCD_IDX_Init_t init;
+  uint32_t            i;
+
+  init.pBuffer  = Buffer;
+  init.Width    = WIDTH;
+  init.Height   = HEIGHT;
+  init.Format   = Format;
+  init.Instance = 0U;
+  init.pTarget  = &PanelTarget;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Init(&init), UTIL_LCD_IDX_OK);
+
+  /* Gray levels after init, 16 of them for AL44 */
+  for (i = 0U; i < UTIL_LCD_IDX_CLUT_SIZE; i++)
+  {
+    Clut[i] = ((Format == LCD_PIXEL_FORMAT_L8) ? i : ((i & 0x0FU) * 0x11U)) * 0x010101U;
+  }
+  for (i = 0U; i < (WIDTH * HEIGHT); i++)
+  {
+    Panel[i] = UNTOUCHED;
+  }
+  FailWindow = 0U;
+  FailWrite  = 0U;
+  UTIL_LCD_SetFuncDriver(&UTIL_LCD_IDX_Driver);
+}
+
+/* Flush, then check the window, the pixels sent and the writes */
+static void CheckFlush(uint32_t Format, const Box_t *pDirty)
+{
+  UTIL_LCD_FB_Stats_t stats;
+  uint32_t            x, y, area, bad = 0U;
+  uint16_t            expected;
+
+  (void)memcpy(Previous, Panel, sizeof(Panel));
+  Windows     = 0U;
+  Writes      = 0U;
+  ShortWrites = 0U;
+  Overflows   = 0U;
+  UTIL_LCD_IDX_ResetStats();
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Flush(), UTIL_LCD_IDX_OK);
+  UTIL_LCD_IDX_GetStats(&stats);
+  TEST_CHECK_EQ(stats.FlushCount, 1U);
+
+  if (pDirty == NULL)
+  {
+    TEST_CHECK_EQ(Windows, 0U);
+    TEST_CHECK_EQ(Writes, 0U);
+    TEST_CHECK_EQ(stats.RegionCount, 0U);
+  }
+  else
+  {
+    area = (pDirty->X1 - pDirty->X0) * (pDirty->Y1 - pDirty->Y0);
+    TEST_CHECK_EQ(Windows, 1U);
+    TEST_CHECK_EQ(Window.X0, pDirty->X0);
+    TEST_CHECK_EQ(Window.Y0, pDirty->Y0);
+    TEST_CHECK_EQ(Window.X1, pDirty->X1);
+    TEST_CHECK_EQ(Window.Y1, pDirty->Y1);
+    TEST_CHECK_EQ(Cursor, area);
+    TEST_CHECK_EQ(Overflows, 0U);
+
+    /* Full line buffers, the last one excepted */
+    TEST_CHECK_EQ(Writes, (area + UTIL_LCD_IDX_LINE_SIZE - 1U) / UTIL_LCD_IDX_LINE_SIZE);
+    TEST_CHECK_EQ(ShortWrites, ((area % UTIL_LCD_IDX_LINE_SIZE) != 0U) ? 1U : 0U);
+    TEST_CHECK_EQ(stats.RegionCount, 1U);
+    TEST_CHECK_EQ(stats.WriteCount, Writes);
+    TEST_CHECK_EQ(stats.PixelCount, area);
+
+    for (y = 0U; y < HEIGHT; y++)
+    {
+      for (x = 0U; x < WIDTH; x++)
+      {
+        if ((x >= pDirty->X0) && (x < pDirty->X1) && (y >= pDirty->Y0) && (y < pDirty->Y1))
+        {
+          expected = Expand(Format, Buffer[(y * WIDTH) + x]);
+        }
+        else
+        {
+          expected = Previous[(y * WIDTH) + x];
+        }
+        bad += (Panel[(y * WIDTH) + x] != expected) ? 1U : 0U;
+      }
+    }
+    TEST_CHECK_EQ(bad, 0U);
+  }
+}
+
+static void AddBox(Box_t *pBox, uint32_t *pEmpty, uint32_t X0, uint32_t Y0, uint32_t X1, uint32_t Y1)
+{
+  if (*pEmpty != 0U)
+  {
+    pBox->X0 = X0;
+    pBox->Y0 = Y0;
+    pBox->X1 = X1;
+    pBox->Y1 = Y1;
+    *pEmpty  = 0U;
+  }
+  else
+  {
+    pBox->X0 = MIN(pBox->X0, X0);
+    pBox->Y0 = MIN(pBox->Y0, Y0);
+    pBox->X1 = MAX(pBox->X1, X1);
+    pBox->Y1 = MAX(pBox->Y1, Y1);
+  }
+}
+
+/* Random values under random invalidated areas, possibly past the edges */
+static void TestFlush(uint32_t Format)
+{
+  Box_t    dirty;
+  uint32_t trial, i, n, x, y, w, h, empty;
+
+  InitIdx(Format);
+  for (i = 0U; i < (WIDTH * HEIGHT); i++)
+  {
+    Buffer[i] = (uint8_t)rand();
+  }
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Invalidate(0U, 0U, WIDTH, HEIGHT), UTIL_LCD_IDX_OK);
+  dirty.X0 = 0U;
+  dirty.Y0 = 0U;
+  dirty.X1 = WIDTH;
+  dirty.Y1 = HEIGHT;
+  CheckFlush(Format, &dirty);
+  CheckFlush(Format, NULL);
+
+  for (trial = 0U; trial < TRIALS; trial++)
+  {
+    /* New palette, every entry used by AL44 */
+    if ((trial % 4U) == 0U)
+    {
+      n = ((uint32_t)rand() % 16U) + 1U;
+      i = (uint32_t)rand() % (UTIL_LCD_IDX_CLUT_SIZE - n);
+      i = (Format == LCD_PIXEL_FORMAT_AL44) ? (i % (16U - (n % 16U))) : i;
+      for (x = 0U; x < n; x++)
+      {
+        Clut[i + x] = 0xFF000000U | (((uint32_t)rand() << 8) ^ (uint32_t)rand());
+      }
+      TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(&Clut[i], i, n), UTIL_LCD_IDX_OK);
+    }
+    for (i = 0U; i < (WIDTH * HEIGHT); i++)
+    {
+      Buffer[i] = (uint8_t)rand();
+    }
+
+    /* Whole screen after a palette change */
+    empty = ((trial % 4U) == 0U) ? 0U : 1U;
+    dirty.X0 = 0U;
+    dirty.Y0 = 0U;
+    dirty.X1 = WIDTH;
+    dirty.Y1 = HEIGHT;
+    n = (uint32_t)rand() % 4U;
+    for (i = 0U; i < n; i++)
+    {
+      x = (uint32_t)rand() % (WIDTH + 10U);
+      y = (uint32_t)rand() % (HEIGHT + 10U);
+      w = (uint32_t)rand() % 80U;
+      h = (uint32_t)rand() % 40U;
+      TEST_CHECK_EQ(UTIL_LCD_IDX_Invalidate(x, y, w, h), UTIL_LCD_IDX_OK);
+      if ((x < WIDTH) && (y < HEIGHT) && (w != 0U) && (h != 0U))
+      {
+        AddBox(&dirty, &empty, x, y, MIN(x + w, WIDTH), MIN(y + h, HEIGHT));
+      }
+    }
+    CheckFlush(Format, (empty != 0U) ? NULL : &dirty);
+  }
+}
+
+/* Values written through the LCD utility, the low byte of each color */
+static void TestDraw(void)
+{
+  static uint8_t bmp[54U + (8U * 3U)];
+  Box_t    dirty;
+  uint32_t i, x, y, color, empty = 1U;
+  uint8_t  value;
+
+  InitIdx(LCD_PIXEL_FORMAT_AL44);
+  (void)memset(Buffer, 0, sizeof(Buffer));
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Flush(), UTIL_LCD_IDX_OK);
+
+  UTIL_LCD_FillRect(10U, 5U, 30U, 4U, 0xF3U);
+  AddBox(&dirty, &empty, 10U, 5U, 40U, 9U);
+  UTIL_LCD_DrawHLine(WIDTH - 5U, 20U, 50U, 0x7AU);
+  AddBox(&dirty, &empty, WIDTH - 5U, 20U, WIDTH, 21U);
+  UTIL_LCD_DrawVLine(3U, HEIGHT - 2U, 10U, 0x11U);
+  AddBox(&dirty, &empty, 3U, HEIGHT - 2U, 4U, HEIGHT);
+  UTIL_LCD_SetPixel(WIDTH - 1U, 0U, 0x2CU);
+  AddBox(&dirty, &empty, WIDTH - 1U, 0U, WIDTH, 1U);
+  TEST_CHECK_EQ(Buffer[10U + (5U * WIDTH)], 0xF3U);
+  TEST_CHECK_EQ(Buffer[39U + (8U * WIDTH)], 0xF3U);
+  TEST_CHECK_EQ(Buffer[40U + (8U * WIDTH)], 0U);
+  TEST_CHECK_EQ(Buffer[(WIDTH - 1U) + (20U * WIDTH)], 0x7AU);
+  TEST_CHECK_EQ(Buffer[3U + ((HEIGHT - 1U) * WIDTH)], 0x11U);
+  UTIL_LCD_GetPixel(WIDTH - 1U, 0U, &color);
+  TEST_CHECK_EQ(color, 0x2CU);
+  CheckFlush(LCD_PIXEL_FORMAT_AL44, &dirty);
+
+  /* 8 bpp bottom-up bitmap of 5x3 pixels, rows padded to 8 bytes, past the right edge */
+  (void)memset(bmp, 0, sizeof(bmp));
+  bmp[0]  = 'B';
+  bmp[1]  = 'M';
+  bmp[10] = 54U;
+  bmp[18] = 5U;
+  bmp[22] = 3U;
+  bmp[28] = 8U;
+  for (i = 0U; i < 24U; i++)
+  {
+    bmp[54U + i] = (uint8_t)(0x40U + i);
+  }
+  TEST_CHECK_EQ(UTIL_LCD_IDX_DrawBitmap(0U, WIDTH - 3U, 30U, bmp), UTIL_LCD_IDX_OK);
+  for (y = 0U; y < 3U; y++)
+  {
+    for (x = 0U; x < 3U; x++)
+    {
+      value = (uint8_t)(0x40U + ((2U - y) * 8U) + x);
+      TEST_CHECK_EQ(Buffer[((30U + y) * WIDTH) + (WIDTH - 3U) + x], value);
+    }
+  }
+  empty = 1U;
+  AddBox(&dirty, &empty, WIDTH - 3U, 30U, WIDTH, 33U);
+  CheckFlush(LCD_PIXEL_FORMAT_AL44, &dirty);
+  bmp[28] = 24U;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_DrawBitmap(0U, 0U, 0U, bmp), UTIL_LCD_IDX_ERROR);
+  CheckFlush(LCD_PIXEL_FORMAT_AL44, NULL);
+}
+
+/* AL44 folding: alpha 15 is the entry, alpha 0 the background */
+static void TestFolding(void)
+{
+  static const uint32_t colors[16] =
+  {
+    0xFF102030U, 0xFFFFFFFFU, 0xFF000000U, 0xFFFF0000U, 0xFF00FF00U, 0xFF0000FFU, 0xFF808080U, 0xFF7F7F7FU,
+    0xFF123456U, 0xFFFEDCBAU, 0xFF0F0F0FU, 0xFFF0F0F0U, 0xFF00FFFFU, 0xFFFF00FFU, 0xFFFFFF00U, 0xFF405060U
+  };
+  Box_t    dirty = {0U, 0U, 16U, 16U};
+  uint32_t i;
+
+  InitIdx(LCD_PIXEL_FORMAT_AL44);
+  (void)memcpy(Clut, colors, sizeof(colors));
+  TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(colors, 0U, 16U), UTIL_LCD_IDX_OK);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Flush(), UTIL_LCD_IDX_OK);
+
+  /* Every pixel value in a 16x16 block */
+  for (i = 0U; i < 256U; i++)
+  {
+    Buffer[((i / 16U) * WIDTH) + (i % 16U)] = (uint8_t)i;
+  }
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Invalidate(0U, 0U, 16U, 16U), UTIL_LCD_IDX_OK);
+  CheckFlush(LCD_PIXEL_FORMAT_AL44, &dirty);
+  for (i = 0U; i < 16U; i++)
+  {
+    TEST_CHECK_EQ(Panel[(15U * WIDTH) + i], ToRgb565(colors[i]));
+    TEST_CHECK_EQ(Panel[i], ToRgb565(colors[0]));
+  }
+}
+
+/* Rejected configurations and target errors */
+static void TestErrors(void)
+{
+  UTIL_LCD_IDX_Init_t init;
+
+  init.pBuffer  = Buffer;
+  init.Width    = WIDTH;
+  init.Height   = HEIGHT;
+  init.Format   = LCD_PIXEL_FORMAT_RGB565;
+  init.Instance = 0U;
+  init.pTarget  = &PanelTarget;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Init(NULL), UTIL_LCD_IDX_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Init(&init), UTIL_LCD_IDX_ERROR);
+  init.Format = LCD_PIXEL_FORMAT_L8;
+  init.Width  = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Init(&init), UTIL_LCD_IDX_ERROR);
+  init.Width   = WIDTH;
+  init.pBuffer = NULL;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Init(&init), UTIL_LCD_IDX_ERROR);
+
+  InitIdx(LCD_PIXEL_FORMAT_L8);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(Clut, 255U, 2U), UTIL_LCD_IDX_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(Clut, 256U, 0U), UTIL_LCD_IDX_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(NULL, 0U, 1U), UTIL_LCD_IDX_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_IDX_SetClut(Clut, 255U, 1U), UTIL_LCD_IDX_OK);
+
+  FailWindow = 1U;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Flush(), UTIL_LCD_IDX_ERROR);
+  FailWindow = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Invalidate(0U, 0U, 1U, 1U), UTIL_LCD_IDX_OK);
+  FailWrite = 1U;
+  TEST_CHECK_EQ(UTIL_LCD_IDX_Flush(), UTIL_LCD_IDX_ERROR);
+  FailWrite = 0U;
+}
+
+int main(void)
+{
+  srand(1U);
+
+  TestFlush(LCD_PIXEL_FORMAT_L8);
+  TestFlush(LCD_PIXEL_FORMAT_AL44);
+  TestDraw();
+  TestFolding();
+  TestErrors();
+
+  return TEST_RESULT(TEST_NAME);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,738 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_img.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_img.c streaming BMP decoder: images of
+  *          every supported format, bottom-up and top-down, uncompressed or
+  *          RLE4/RLE8 coded with delta and escape codes, are built from known
+  *          pixels and must be drawn with the RGB565 colors of the reference,
+  *          from memory and through a chunked reader. Also built with the
+  *          smallest chunk and a one row buffer, see the Makefile.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_img.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#ifndef TEST_NAME
+  #define TEST_NAME     "test_lcd_img"
+#endif
+#define WIDTH           640U
+#define HEIGHT          200U
+#define XPOS            3U
+#define YPOS            2U
+#define UNTOUCHED       0xA5A5U     /* Display pixel never drawn */
+#define FILE_ADDRESS    0x00100000U
+#define FILE_MAX        (1024U + (4U * WIDTH * HEIGHT))
+#define INSTANCE        2U
+#define RLE_STREAMS     30U
+
+#define MIN(X, Y)       (((X) < (Y)) ? (X) : (Y))
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t BitCount;
+  uint32_t Compression;
+  uint32_t Rgb555;     /* BI_BITFIELDS masks of RGB555, else of RGB565 or BGR888 */
+} Format_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Image[WIDTH * HEIGHT];
+static uint16_t Expected[WIDTH * HEIGHT];   /* Decoded image, rows from the top */
+static uint8_t  Indexes[WIDTH * HEIGHT];    /* Palette indexes, rows from the top */
+static uint16_t Palette[256];               /* Palette in RGB565 */
+static uint8_t  File[FILE_MAX];
+static uint32_t FileSize;
+static uint32_t RgbCalls, OtherCalls;
+static uint32_t Reads, BytesRead, BigReads, OutOfFile;
+static uint32_t FailRead;                   /* Reads left before the reader fails, 0 for none */
+
+/* Private functions ---------------------------------------------------------*/
+/* Display: RGB565 memory, only FillRGBRect() is expected from the decoder */
+static int32_t MemFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  RgbCalls++;
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      Image[((Ypos + y) * WIDTH) + Xpos + x] =
+        (uint16_t)((uint32_t)pData[2U * ((y * W) + x)] | ((uint32_t)pData[(2U * ((y * W) + x)) + 1U] << 8));
+    }
+  }
+
+  return 0;
+}
+
+static int32_t MemDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)pBmp;
+  OtherCalls++;
+  return -1;
+}
+
+static int32_t MemFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)W;
+  (void)H;
+  (void)Color;
+  OtherCalls++;
+  return -1;
+}
+
+static int32_t MemDrawLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+static int32_t MemGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  *pColor = Image[(Ypos * WIDTH) + Xpos];
+  return 0;
+}
+
+static int32_t MemSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+static int32_t MemGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  *pXSize = WIDTH;
+  return 0;
+}
+
+static int32_t MemGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  *pYSize = HEIGHT;
+  return 0;
+}
+
+static int32_t MemSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t MemGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t MemDriver =
+{
+  MemDrawBitmap,
+  MemFillRGBRect,
+  MemDrawLine,
+  MemDrawLine,
+  MemFillRect,
+  MemGetPixel,
+  MemSetPixel,
+  MemGetXSize,
+  MemGetYSize,
+  MemSetLayer,
+  MemGetFormat
+};
+
+/* Image in an external memory, read with the BSP_OSPI_NOR_Read() signature */
+static int32_t FileRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t ret = 0;
+
+  Reads++;
+  BytesRead += Size;
+  BigReads  += (Size > UTIL_LCD_IMG_CHUNK_SIZE) ? 1U : 0U;
+  if ((Instance != INSTANCE) || (Address < FILE_ADDRESS) || ((Address - FILE_ADDRESS) > FileSize) ||
+      (Size > (FileSize - (Address - FILE_ADDRESS))))
+  {
+    OutOfFile++;
+    ret = -1;
+  }
+  else if ((FailRead != 0U) && (--FailRead == 0U))
+  {
+    ret = -1;
+  }
+  else
+  {
+    (void)memcpy(pData, &File[Address - FILE_ADDRESS], Size);
+  }
+
+  return ret;
+}
+
+/* BMP file writer */
+static void Put8(uint32_t Value)
+{
+  File[FileSize++] = (uint8_t)Value;
+}
+
+static void Put16(uint32_t Value)
+{
+  Put8(Value);
+  Put8(Value >> 8);
+}
+
+static void Put32(uint32_t Value)
+{
+  Put16(Value);
+  Put16(Value >> 16);
+}
+
+static void Set32(uint32_t Offset, uint32_t Value)
+{
+  File[Offset]      = (uint8_t)Value;
+  File[Offset + 1U] = (uint8_t)(Value >> 8);
+  File[Offset + 2U] = (uint8_t)(Value >> 16);
+  File[Offset + 3U] = (uint8_t)(Value >> 24);
+}
+
+static uint16_t Rgb565(uint32_t R, uint32_t G, uint32_t B)
+{
+  return (uint16_t)(((R >> 3) << 11) | ((G >> 2) << 5) | (B >> 3));
+}
+
+/* Headers, masks and a random palette of Entries colors; biClrUsed is left
+   to 0 for a full palette */
+static void BeginFile(uint32_t W, uint32_t H, uint32_t TopDown, const Format_t *pFormat, uint32_t Entries)
+{
+  uint32_t i, r, g, b;
+
+  FileSize = 0U;
+  Put16(0x4D42U);
+  Put32(0U);                        /* File size, set by EndFile()  */
+  Put32(0U);
+  Put32(0U);                        /* Pixel data offset            */
+  Put32(40U);
+  Put32(W);
+  Put32((TopDown != 0U) ? (uint32_t)(-(int32_t)H) : H);
+  Put16(1U);
+  Put16(pFormat->BitCount);
+  Put32(pFormat->Compression);
+  Put32(0U);                        /* Image size, set by EndFile() */
+  Put32(2835U);
+  Put32(2835U);
+  Put32(((pFormat->BitCount <= 8U) && (Entries == (1UL << pFormat->BitCount))) ? 0U : Entries);
+  Put32(0U);
+
+  if (pFormat->Compression == UTIL_LCD_IMG_BI_BITFIELDS)
+  {
+    if (pFormat->BitCount == 32U)
+    {
+      Put32(0xFF0000U);
+      Put32(0xFF00U);
+      Put32(0xFFU);
+    }
+    else
+    {
+      Put32((pFormat->Rgb555 != 0U) ? 0x7C00U : 0xF800U);
+      Put32((pFormat->Rgb555 != 0U) ? 0x03E0U : 0x07E0U);
+      Put32(0x001FU);
+    }
+  }
+
+  for (i = 0U; i < Entries; i++)
+  {
+    b = (uint32_t)rand() & 0xFFU;
+    g = (uint32_t)rand() & 0xFFU;
+    r = (uint32_t)rand() & 0xFFU;
+    Put8(b);
+    Put8(g);
+    Put8(r);
+    Put8(0U);
+    Palette[i] = Rgb565(r, g, b);
+  }
+
+  /* Pixel data offset */
+  Set32(10U, FileSize);
+}
+
+static void EndFile(void)
+{
+  Set32(2U, FileSize);
+  Set32(34U, FileSize - (File[10] | ((uint32_t)File[11] << 8)));
+}
+
+/* Uncompressed pixel data of random pixels, rows padded to 32 bits */
+static void PutPixels(uint32_t W, uint32_t H, uint32_t TopDown, const Format_t *pFormat, uint32_t Entries)
+{
+  uint32_t row, y, x, start, bits = 0U, nbits = 0U, v, r, g, b;
+
+  for (row = 0U; row < H; row++)
+  {
+    y     = (TopDown != 0U) ? row : (H - 1U - row);
+    start = FileSize;
+    for (x = 0U; x < W; x++)
+    {
+      switch (pFormat->BitCount)
+      {
+        case 1U:
+        case 4U:
+        case 8U:
+          v = (uint32_t)rand() % Entries;
+          Expected[(y * W) + x] = Palette[v];
+          bits   = (bits << pFormat->BitCount) | v;
+          nbits += pFormat->BitCount;
+          if (nbits == 8U)
+          {
+            Put8(bits);
+            bits  = 0U;
+            nbits = 0U;
+          }
+          break;
+
+        case 16U:
+          v = (uint32_t)rand() & 0xFFFFU;
+          if (pFormat->Rgb555 != 0U)
+          {
+            /* 5-bit green stretched to 6 bits */
+            v &= 0x7FFFU;
+            g  = (v >> 5) & 0x1FU;
+            Expected[(y * W) + x] = (uint16_t)(((v >> 10) << 11) | (((g << 1) | (g >> 4)) << 5) | (v & 0x1FU));
+          }
+          else
+          {
+            Expected[(y * W) + x] = (uint16_t)v;
+          }
+          Put16(v);
+          break;
+
+        default:
+          b = (uint32_t)rand() & 0xFFU;
+          g = (uint32_t)rand() & 0xFFU;
+          r = (uint32_t)rand() & 0xFFU;
+          Expected[(y * W) + x] = Rgb565(r, g, b);
+          Put8(b);
+          Put8(g);
+          Put8(r);
+          if (pFormat->BitCount == 32U)
+          {
+            Put8((uint32_t)rand());
+          }
+          break;
+      }
+    }
+    if (nbits != 0U)
+    {
+      Put8(bits << (8U - nbits));
+      bits  = 0U;
+      nbits = 0U;
+    }
+    while (((FileSize - start) % 4U) != 0U)
+    {
+      Put8(0xEEU);
+    }
+  }
+}
+
+/* RLE coded pixel data of random runs, absolute runs, deltas and early ends
+   of line and of bitmap. Pixels not coded take the first palette color. */
+static void PutRle(uint32_t W, uint32_t H, uint32_t Rle4, uint32_t Entries)
+{
+  uint32_t x = 0U, row = 0U, end = 0U, action, n, i, v0, v1, dy, data = 0U;
+
+  (void)memset(Indexes, 0, W * H);
+  while ((row < H) && (end == 0U))
+  {
+    action = (uint32_t)rand() % 16U;
+    if ((x >= W) || (action == 0U))
+    {
+      /* End of line */
+      Put8(0U);
+      Put8(0U);
+      row++;
+      x = 0U;
+    }
+    else if ((action == 1U) && (((uint32_t)rand() % 4U) == 0U))
+    {
+      /* End of bitmap before the last row */
+      Put8(0U);
+      Put8(1U);
+      end = 1U;
+    }
+    else if (action <= 3U)
+    {
+      /* Delta, possibly to a later row */
+      n  = (uint32_t)rand() % (W - x + 1U);
+      dy = (uint32_t)rand() % MIN(3U, H - row);
+      Put8(0U);
+      Put8(2U);
+      Put8(n);
+      Put8(dy);
+      x   += n;
+      row += dy;
+    }
+    else if (action <= 9U)
+    {
+      /* Encoded run, possibly past the row end */
+      n  = 1U + ((uint32_t)rand() % MIN(255U, (W - x) + 2U));
+      v0 = (uint32_t)rand() % Entries;
+      v1 = (uint32_t)rand() % Entries;
+      Put8(n);
+      Put8((Rle4 != 0U) ? ((v0 << 4) | v1) : v0);
+      for (i = 0U; i < n; i++)
+      {
+        if ((x + i) < W)
+        {
+          Indexes[((H - 1U - row) * W) + x + i] = (uint8_t)(((Rle4 != 0U) && ((i & 1U) != 0U)) ? v1 : v0);
+        }
+      }
+      x += n;
+    }
+    else
+    {
+      /* Absolute run of at least 3 indexes, padded to 16 bits */
+      n = 3U + ((uint32_t)rand() % MIN(253U, (W - x) + 1U));
+      Put8(0U);
+      Put8(n);
+      for (i = 0U; i < n; i++)
+      {
+        v0 = (uint32_t)rand() % Entries;
+        if ((x + i) < W)
+        {
+          Indexes[((H - 1U - row) * W) + x + i] = (uint8_t)v0;
+        }
+        if (Rle4 == 0U)
+        {
+          Put8(v0);
+        }
+        else if ((i & 1U) == 0U)
+        {
+          data = v0 << 4;
+        }
+        else
+        {
+          Put8(data | v0);
+        }
+      }
+      if ((Rle4 != 0U) && ((n & 1U) != 0U))
+      {
+        Put8(data);
+      }
+      if ((((Rle4 != 0U) ? ((n + 1U) / 2U) : n) & 1U) != 0U)
+      {
+        Put8(0U);
+      }
+      x += n;
+    }
+  }
+  if (end == 0U)
+  {
+    Put8(0U);
+    Put8(1U);
+  }
+
+  for (i = 0U; i < (W * H); i++)
+  {
+    Expected[i] = Palette[Indexes[i]];
+  }
+}
+
+/* Draw the file from memory and through the reader, check the image */
+static void CheckDraw(uint32_t W, uint32_t H)
+{
+  UTIL_LCD_IMG_Source_t src;
+  uint32_t pass, x, y, band, bad;
+
+  for (pass = 0U; pass < 2U; pass++)
+  {
+    src.Read     = (pass == 0U) ? NULL : FileRead;
+    src.Instance = INSTANCE;
+    src.Address  = FILE_ADDRESS;
+    src.pData    = File;
+
+    for (x = 0U; x < (WIDTH * HEIGHT); x++)
+    {
+      Image[x] = UNTOUCHED;
+    }
+    RgbCalls  = 0U;
+    Reads     = 0U;
+    BytesRead = 0U;
+    TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, XPOS, YPOS), UTIL_LCD_IMG_OK);
+
+    bad = 0U;
+    for (y = 0U; y < HEIGHT; y++)
+    {
+      for (x = 0U; x < WIDTH; x++)
+      {
+        if ((x >= XPOS) && (x < (XPOS + W)) && (y >= YPOS) && (y < (YPOS + H)))
+        {
+          bad += (Image[(y * WIDTH) + x] != Expected[((y - YPOS) * W) + x - XPOS]) ? 1U : 0U;
+        }
+        else
+        {
+          bad += (Image[(y * WIDTH) + x] != UNTOUCHED) ? 1U : 0U;
+        }
+      }
+    }
+    TEST_CHECK_EQ(bad, 0U);
+
+    /* One rectangle per band of rows, the image read once */
+    band = UTIL_LCD_IMG_BUFFER_SIZE / W;
+    TEST_CHECK_EQ(RgbCalls, (H + band - 1U) / band);
+    if (pass != 0U)
+    {
+      TEST_CHECK(BytesRead <= (FileSize + 54U + UTIL_LCD_IMG_CHUNK_SIZE));
+    }
+  }
+  TEST_CHECK_EQ(OtherCalls, 0U);
+  TEST_CHECK_EQ(BigReads, 0U);
+  TEST_CHECK_EQ(OutOfFile, 0U);
+}
+
+static void CheckInfo(uint32_t W, uint32_t H, const Format_t *pFormat, uint32_t Entries)
+{
+  UTIL_LCD_IMG_Source_t src = {FileRead, INSTANCE, FILE_ADDRESS, NULL};
+  UTIL_LCD_IMG_Info_t   info;
+
+  TEST_CHECK_EQ(UTIL_LCD_IMG_GetInfo(&src, &info), UTIL_LCD_IMG_OK);
+  TEST_CHECK_EQ(info.Width, W);
+  TEST_CHECK_EQ(info.Height, H);
+  TEST_CHECK_EQ(info.BitCount, pFormat->BitCount);
+  TEST_CHECK_EQ(info.Compression, pFormat->Compression);
+  TEST_CHECK_EQ(info.PaletteSize, Entries);
+}
+
+/* Every uncompressed format, both row orders */
+static void TestFormats(void)
+{
+  static const Format_t formats[] =
+  {
+    {1U,  UTIL_LCD_IMG_BI_RGB,       0U},
+    {4U,  UTIL_LCD_IMG_BI_RGB,       0U},
+    {8U,  UTIL_LCD_IMG_BI_RGB,       0U},
+    {16U, UTIL_LCD_IMG_BI_RGB,       0U},
+    {16U, UTIL_LCD_IMG_BI_BITFIELDS, 0U},
+    {16U, UTIL_LCD_IMG_BI_BITFIELDS, 1U},
+    {24U, UTIL_LCD_IMG_BI_RGB,       0U},
+    {32U, UTIL_LCD_IMG_BI_RGB,       0U},
+    {32U, UTIL_LCD_IMG_BI_BITFIELDS, 0U}
+  };
+  static const uint32_t widths[]  = {1U, 3U, 7U, 33U, MIN(UTIL_LCD_IMG_BUFFER_SIZE, WIDTH - XPOS)};
+  static const uint32_t heights[] = {1U, 5U, HEIGHT - YPOS};
+  uint32_t f, w, h, top_down, entries;
+
+  srand(1U);
+  for (f = 0U; f < (sizeof(formats) / sizeof(formats[0])); f++)
+  {
+    for (w = 0U; w < (sizeof(widths) / sizeof(widths[0])); w++)
+    {
+      for (h = 0U; h < (sizeof(heights) / sizeof(heights[0])); h++)
+      {
+        for (top_down = 0U; top_down < 2U; top_down++)
+        {
+          if (widths[w] > UTIL_LCD_IMG_BUFFER_SIZE)
+          {
+            continue;
+          }
+          entries = 0U;
+          if (formats[f].BitCount <= 8U)
+          {
+            /* Full palette, or fewer colors in biClrUsed */
+            entries = 1UL << formats[f].BitCount;
+            entries = ((h % 2U) != 0U) ? (entries - (entries / 4U)) : entries;
+          }
+          BeginFile(widths[w], heights[h], top_down, &formats[f], entries);
+          PutPixels(widths[w], heights[h], top_down, &formats[f], entries);
+          EndFile();
+          CheckInfo(widths[w], heights[h], &formats[f], entries);
+          CheckDraw(widths[w], heights[h]);
+        }
+      }
+    }
+  }
+}
+
+/* RLE images: a hand coded one, then random streams */
+static void TestRle(void)
+{
+  static const Format_t rle8 = {8U, UTIL_LCD_IMG_BI_RLE8, 0U};
+  static const Format_t rle4 = {4U, UTIL_LCD_IMG_BI_RLE4, 0U};
+  static const uint8_t  coded[] =
+  {
+    0x03U, 0x01U,                             /* Row 3: 3 x 1                  */
+    0x00U, 0x02U, 0x01U, 0x01U,               /* Delta 1 right, 1 down         */
+    0x02U, 0x05U, 0x00U, 0x00U,               /* Row 2 from column 4: 2 x 5    */
+    0x00U, 0x03U, 0x07U, 0x08U, 0x09U, 0x00U, /* Row 1: absolute 7 8 9, padded */
+    0x00U, 0x01U                              /* End of bitmap: row 0 is empty */
+  };
+  static const uint8_t  decoded[4][6] =
+  {
+    {0U, 0U, 0U, 0U, 0U, 0U},
+    {7U, 8U, 9U, 0U, 0U, 0U},
+    {0U, 0U, 0U, 0U, 5U, 5U},
+    {1U, 1U, 1U, 0U, 0U, 0U}
+  };
+  static const uint32_t widths[]  = {1U, 8U, 33U, MIN(UTIL_LCD_IMG_BUFFER_SIZE, 200U)};
+  static const uint32_t heights[] = {1U, 9U, 40U};
+  uint32_t i, w, h, t, rle;
+
+  srand(2U);
+  BeginFile(6U, 4U, 0U, &rle8, 256U);
+  for (i = 0U; i < sizeof(coded); i++)
+  {
+    Put8(coded[i]);
+  }
+  EndFile();
+  for (i = 0U; i < 24U; i++)
+  {
+    Expected[i] = Palette[decoded[i / 6U][i % 6U]];
+  }
+  CheckDraw(6U, 4U);
+
+  for (rle = 0U; rle < 2U; rle++)
+  {
+    for (w = 0U; w < (sizeof(widths) / sizeof(widths[0])); w++)
+    {
+      for (h = 0U; h < (sizeof(heights) / sizeof(heights[0])); h++)
+      {
+        for (t = 0U; t < RLE_STREAMS; t++)
+        {
+          if (widths[w] > UTIL_LCD_IMG_BUFFER_SIZE)
+          {
+            continue;
+          }
+          BeginFile(widths[w], heights[h], 0U, (rle == 0U) ? &rle8 : &rle4, (rle == 0U) ? 256U : 16U);
+          PutRle(widths[w], heights[h], rle, (rle == 0U) ? 256U : 16U);
+          EndFile();
+          CheckInfo(widths[w], heights[h], (rle == 0U) ? &rle8 : &rle4, (rle == 0U) ? 256U : 16U);
+          CheckDraw(widths[w], heights[h]);
+        }
+      }
+    }
+  }
+}
+
+/* Images rejected, and errors of the source */
+static void TestErrors(void)
+{
+  static const Format_t rgb16 = {16U, UTIL_LCD_IMG_BI_RGB, 0U};
+  static const Format_t rle8  = {8U, UTIL_LCD_IMG_BI_RLE8, 0U};
+  UTIL_LCD_IMG_Source_t src = {FileRead, INSTANCE, FILE_ADDRESS, NULL};
+  UTIL_LCD_IMG_Source_t none = {NULL, 0U, 0U, NULL};
+  UTIL_LCD_IMG_Info_t   info;
+
+  srand(3U);
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(NULL, 0U, 0U), UTIL_LCD_IMG_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&none, 0U, 0U), UTIL_LCD_IMG_ERROR);
+
+  BeginFile(8U, 8U, 0U, &rgb16, 0U);
+  PutPixels(8U, 8U, 0U, &rgb16, 0U);
+  EndFile();
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_OK);
+
+  /* Headers not supported */
+  File[0] = (uint8_t)'P';
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[0] = (uint8_t)'B';
+  File[26] = 2U;                                                /* Planes       */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[26] = 1U;
+  File[28] = 2U;                                                /* Bit count    */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[28] = 16U;
+  File[30] = 4U;                                                /* BI_JPEG      */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[30] = (uint8_t)UTIL_LCD_IMG_BI_BITFIELDS;                /* Masks: pixels */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[30] = (uint8_t)UTIL_LCD_IMG_BI_RLE8;                     /* 16 bpp RLE8  */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[30] = (uint8_t)UTIL_LCD_IMG_BI_RGB;
+  File[14] = 12U;                                               /* OS/2 header  */
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  File[14] = 40U;
+
+  /* Wider than the rows buffer: the headers are still read */
+  BeginFile(UTIL_LCD_IMG_BUFFER_SIZE + 1U, 2U, 0U, &rgb16, 0U);
+  PutPixels(UTIL_LCD_IMG_BUFFER_SIZE + 1U, 2U, 0U, &rgb16, 0U);
+  EndFile();
+  TEST_CHECK_EQ(UTIL_LCD_IMG_GetInfo(&src, &info), UTIL_LCD_IMG_OK);
+  TEST_CHECK_EQ(info.Width, UTIL_LCD_IMG_BUFFER_SIZE + 1U);
+  RgbCalls = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+  TEST_CHECK_EQ(RgbCalls, 0U);
+
+  /* RLE images are bottom-up only */
+  BeginFile(8U, 8U, 1U, &rle8, 256U);
+  PutRle(8U, 8U, 0U, 256U);
+  EndFile();
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_NOT_SUPPORTED);
+
+  /* File size not past the pixel data offset */
+  BeginFile(8U, 8U, 0U, &rgb16, 0U);
+  PutPixels(8U, 8U, 0U, &rgb16, 0U);
+  EndFile();
+  Set32(2U, 54U);
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_ERROR);
+
+  /* Truncated pixel data: an error, nothing read past the file */
+  Set32(2U, FileSize - 20U);
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_ERROR);
+  BeginFile(16U, 16U, 0U, &rle8, 256U);
+  PutRle(16U, 16U, 0U, 256U);
+  FileSize -= 8U;
+  EndFile();
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_ERROR);
+  TEST_CHECK_EQ(OutOfFile, 0U);
+
+  /* Reader failing on its last read, then on its first one */
+  BeginFile(33U, 40U, 0U, &rgb16, 0U);
+  PutPixels(33U, 40U, 0U, &rgb16, 0U);
+  EndFile();
+  Reads = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_OK);
+  FailRead = Reads;
+  RgbCalls = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_IMG_Draw(&src, 0U, 0U), UTIL_LCD_IMG_ERROR);
+  TEST_CHECK(RgbCalls < ((40U + (UTIL_LCD_IMG_BUFFER_SIZE / 33U) - 1U) / (UTIL_LCD_IMG_BUFFER_SIZE / 33U)));
+  FailRead = 1U;
+  TEST_CHECK_EQ(UTIL_LCD_IMG_GetInfo(&src, &info), UTIL_LCD_IMG_ERROR);
+  FailRead = 0U;
+  TEST_CHECK_EQ(OutOfFile, 0U);
+}
+
+int main(void)
+{
+  UTIL_LCD_SetFuncDriver(&MemDriver);
+
+  TestFormats();
+  TestRle();
+  TestErrors();
+
+  return TEST_RESULT(TEST_NAME);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
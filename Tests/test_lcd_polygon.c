@@ -0,0 +1,538 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_polygon.c
+  * @author  MCD Application Team
+  * @brief   Host pixel-exact test of the stm32_lcd.c polygon, circle and
+  *          ellipse fills: each pixel is compared with an exact pixel centre
+  *          test, and each row must be drawn with one span per interval and
+  *          no overdraw.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+#include "test.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define DISPLAY_WIDTH   200
+#define DISPLAY_HEIGHT  150
+#define MAX_POINTS      64
+#define TABLE_POINTS    32  /* UTIL_LCD_POLY_MAX_POINTS default */
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint8_t  Drawn[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+static uint32_t Calls;
+static uint32_t Overdraw;
+static uint32_t OutOfDisplay;
+static uint32_t VLineCalls;
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Counting driver: every pixel drawn is counted, the fills are expected to
+   draw horizontal lines only */
+static int32_t DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  uint32_t i;
+
+  (void)Instance;
+  (void)Color;
+
+  Calls++;
+  if (((Xpos + Length) > (uint32_t)DISPLAY_WIDTH) || (Ypos >= (uint32_t)DISPLAY_HEIGHT))
+  {
+    OutOfDisplay++;
+  }
+  else
+  {
+    for (i = 0U; i < Length; i++)
+    {
+      if (Drawn[Ypos][Xpos + i] != 0U)
+      {
+        Overdraw++;
+      }
+      Drawn[Ypos][Xpos + i]++;
+    }
+  }
+
+  return 0;
+}
+
+static int32_t Unexpected(void)
+{
+  Calls++;
+  OutOfDisplay++;
+  return 0;
+}
+
+static int32_t DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance; (void)Xpos; (void)Ypos; (void)Length; (void)Color;
+  return Unexpected();
+}
+
+static int32_t FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  (void)Instance; (void)Xpos; (void)Ypos; (void)Width; (void)Height; (void)Color;
+  return Unexpected();
+}
+
+/* Single pixels, not expected from the fills either */
+static int32_t SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  (void)Instance;
+  (void)Color;
+
+  Calls++;
+  if ((Xpos < (uint32_t)DISPLAY_WIDTH) && (Ypos < (uint32_t)DISPLAY_HEIGHT))
+  {
+    Drawn[Ypos][Xpos]++;
+  }
+  return 0;
+}
+
+static int32_t GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  (void)Instance;
+  *XSize = DISPLAY_WIDTH;
+  return 0;
+}
+
+static int32_t GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  (void)Instance;
+  *YSize = DISPLAY_HEIGHT;
+  return 0;
+}
+
+static int32_t SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  (void)Instance;
+  *Format = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t CountDriver =
+{
+  NULL,
+  NULL,
+  DrawHLine,
+  DrawVLine,
+  FillRect,
+  NULL,
+  SetPixel,
+  GetXSize,
+  GetYSize,
+  SetLayer,
+  GetFormat
+};
+
+/* Outline driver: the circle outlines are drawn with horizontal lines in
+   their flat octants and vertical lines in their steep ones */
+static int32_t OutlineDrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  uint32_t i;
+
+  (void)Instance;
+  (void)Color;
+
+  Calls++;
+  VLineCalls++;
+  if ((Xpos >= (uint32_t)DISPLAY_WIDTH) || ((Ypos + Length) > (uint32_t)DISPLAY_HEIGHT))
+  {
+    OutOfDisplay++;
+  }
+  else
+  {
+    for (i = 0U; i < Length; i++)
+    {
+      if (Drawn[Ypos + i][Xpos] != 0U)
+      {
+        Overdraw++;
+      }
+      Drawn[Ypos + i][Xpos]++;
+    }
+  }
+
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t OutlineDriver =
+{
+  NULL,
+  NULL,
+  DrawHLine,
+  OutlineDrawVLine,
+  FillRect,
+  NULL,
+  SetPixel,
+  GetXSize,
+  GetYSize,
+  SetLayer,
+  GetFormat
+};
+
+static void Clear(void)
+{
+  (void)memset(Drawn, 0, sizeof(Drawn));
+  Calls        = 0U;
+  Overdraw     = 0U;
+  OutOfDisplay = 0U;
+  VLineCalls   = 0U;
+}
+
+/* Midpoint circle of the original pixel by pixel UTIL_LCD_DrawCircle() */
+static void RefCircle(uint8_t Outline[DISPLAY_HEIGHT][DISPLAY_WIDTH], int32_t Xpos, int32_t Ypos, int32_t Radius)
+{
+  int32_t decision = 3 - (Radius * 2), current_x = 0, current_y = Radius;
+
+  (void)memset(Outline, 0, (size_t)DISPLAY_HEIGHT * DISPLAY_WIDTH);
+  while (current_x <= current_y)
+  {
+    Outline[Ypos - current_y][Xpos + current_x] = 1U;
+    Outline[Ypos - current_y][Xpos - current_x] = 1U;
+    Outline[Ypos - current_x][Xpos + current_y] = 1U;
+    Outline[Ypos - current_x][Xpos - current_y] = 1U;
+    Outline[Ypos + current_y][Xpos + current_x] = 1U;
+    Outline[Ypos + current_y][Xpos - current_x] = 1U;
+    Outline[Ypos + current_x][Xpos + current_y] = 1U;
+    Outline[Ypos + current_x][Xpos - current_y] = 1U;
+    if (decision < 0)
+    {
+      decision += (current_x * 4) + 6;
+    }
+    else
+    {
+      decision += ((current_x - current_y) * 4) + 10;
+      current_y--;
+    }
+    current_x++;
+  }
+}
+
+/* Exact pixel centre test in doubled coordinates: the centre is inside when
+   it is on or right of an odd number of edges (even-odd) or of edges with a
+   non-zero winding sum (non-zero), edges including their top end only */
+static int32_t RefInside(const Point *pPoints, int32_t PointCount, uint32_t Rule, int32_t Xpos, int32_t Ypos)
+{
+  int64_t cx = (2 * (int64_t)Xpos) + 1, cy = (2 * (int64_t)Ypos) + 1;
+  int64_t ax, ay, bx, by, num, lhs;
+  int32_t i, winding = 0, crossings = 0, direction, right;
+
+  for (i = 0; i < PointCount; i++)
+  {
+    ax = 2 * (int64_t)pPoints[i].X;
+    ay = 2 * (int64_t)pPoints[i].Y;
+    bx = 2 * (int64_t)pPoints[(i + 1) % PointCount].X;
+    by = 2 * (int64_t)pPoints[(i + 1) % PointCount].Y;
+
+    if ((ay <= cy) && (by > cy))
+    {
+      direction = 1;
+    }
+    else if ((by <= cy) && (ay > cy))
+    {
+      direction = -1;
+    }
+    else
+    {
+      continue;
+    }
+
+    /* Edge X at cy is ax + num / (by - ay) */
+    num = (bx - ax) * (cy - ay);
+    lhs = (cx - ax) * (by - ay);
+    right = ((by - ay) > 0) ? (lhs >= num) : (lhs <= num);
+    if (right != 0)
+    {
+      crossings ^= 1;
+      winding += direction;
+    }
+  }
+
+  return (Rule == UTIL_LCD_FILL_RULE_EVENODD) ? crossings : ((winding != 0) ? 1 : 0);
+}
+
+/* Compare the drawn pixels with the reference, count the reference spans */
+static void CheckPolygon(const Point *pPoints, int32_t PointCount, uint32_t Rule, const char *pName)
+{
+  int32_t  x, y, inside, previous;
+  uint32_t wrong = 0U, spans = 0U;
+
+  Clear();
+  UTIL_LCD_FillPolygonEx((pPoint)pPoints, (uint32_t)PointCount, Rule, 0xFFFFFFFFU);
+
+  for (y = 0; y < DISPLAY_HEIGHT; y++)
+  {
+    previous = 0;
+    for (x = 0; x < DISPLAY_WIDTH; x++)
+    {
+      inside = RefInside(pPoints, PointCount, Rule, x, y);
+      if (inside != ((Drawn[y][x] != 0U) ? 1 : 0))
+      {
+        wrong++;
+      }
+      if ((inside != 0) && (previous == 0))
+      {
+        spans++;
+      }
+      previous = inside;
+    }
+  }
+
+  if ((wrong != 0U) || (Overdraw != 0U) || (OutOfDisplay != 0U) || (Calls != spans))
+  {
+    (void)printf("%s rule %lu points %ld: %lu wrong pixels, %lu overdrawn, %lu out, %lu spans for %lu\n",
+                 pName, (unsigned long)Rule, (long)PointCount, (unsigned long)wrong, (unsigned long)Overdraw,
+                 (unsigned long)OutOfDisplay, (unsigned long)Calls, (unsigned long)spans);
+  }
+  TEST_CHECK_EQ(wrong, 0U);
+  TEST_CHECK_EQ(Overdraw, 0U);
+  TEST_CHECK_EQ(OutOfDisplay, 0U);
+  TEST_CHECK_EQ(Calls, spans);
+}
+
+static void TestFixedPolygons(void)
+{
+  static const Point square[]  = {{10, 10}, {50, 10}, {50, 40}, {10, 40}};
+  static const Point star[]    = {{100, 10}, {120, 70}, {70, 30}, {130, 30}, {80, 70}};
+  static const Point concave[] = {{5, 5}, {190, 5}, {190, 140}, {100, 20}, {5, 140}};
+  static const Point clipped[] = {{-50, -30}, {250, 20}, {150, 200}, {-10, 120}};
+  static const Point thin[]    = {{3, 100}, {197, 101}, {60, 149}};
+  static const Point empty[]   = {{10, 10}, {50, 10}, {30, 10}};
+  uint32_t rule;
+
+  for (rule = 0U; rule < 2U; rule++)
+  {
+    CheckPolygon(square, 4, rule, "square");
+    CheckPolygon(star, 5, rule, "star");
+    CheckPolygon(concave, 5, rule, "concave");
+    CheckPolygon(clipped, 4, rule, "clipped");
+    CheckPolygon(thin, 3, rule, "thin");
+    CheckPolygon(empty, 3, rule, "empty");
+  }
+
+  /* Polygons touching each other share no pixel */
+  Clear();
+  UTIL_LCD_FillPolygon((pPoint)square, 4U, 0xFFFFFFFFU);
+  {
+    static const Point right[] = {{50, 10}, {90, 25}, {50, 40}};
+    UTIL_LCD_FillPolygon((pPoint)right, 3U, 0xFFFFFFFFU);
+  }
+  TEST_CHECK_EQ(Overdraw, 0U);
+}
+
+/* Polygons with more points than the edge table, filled by the fallback */
+static void TestLargePolygons(void)
+{
+  static Point points[MAX_POINTS];
+  int32_t  i, n;
+  uint32_t rule;
+
+  TEST_CHECK(MAX_POINTS > TABLE_POINTS);
+
+  /* Star of 48 points, self-intersecting for the even-odd rule */
+  n = 48;
+  for (i = 0; i < n; i++)
+  {
+    int32_t k = (i * 19) % n;
+    points[i].X = (int16_t)(100 + ((k < (n / 2)) ? (k * 3) : ((n - k) * -3)));
+    points[i].Y = (int16_t)(10 + ((k * 5) % 130));
+  }
+  for (rule = 0U; rule < 2U; rule++)
+  {
+    CheckPolygon(points, n, rule, "large star");
+  }
+
+  /* Regular 40-gon */
+  n = 40;
+  for (i = 0; i < n; i++)
+  {
+    static const int8_t cosine[40] =
+    {
+      60, 59, 57, 53, 48, 42, 35, 27, 18,  9,  0, -9, -18, -27, -35, -42, -48, -53, -57, -59,
+     -60,-59,-57,-53,-48,-42,-35,-27,-18, -9,  0,  9,  18,  27,  35,  42,  48,  53,  57,  59
+    };
+    points[i].X = (int16_t)(100 + cosine[i]);
+    points[i].Y = (int16_t)(75 + cosine[(i + 30) % 40]);
+  }
+  for (rule = 0U; rule < 2U; rule++)
+  {
+    CheckPolygon(points, n, rule, "40-gon");
+  }
+
+  /* Random polygons around the table size, partly out of the display */
+  srand(6U);
+  for (i = 0; i < 200; i++)
+  {
+    int32_t k;
+    n = (int32_t)TABLE_POINTS - 4 + (rand() % 36);
+    for (k = 0; k < n; k++)
+    {
+      points[k].X = (int16_t)((rand() % 260) - 30);
+      points[k].Y = (int16_t)((rand() % 210) - 30);
+    }
+    CheckPolygon(points, n, (uint32_t)(rand() % 2), "random large");
+  }
+}
+
+static void TestRandomPolygons(void)
+{
+  Point   points[12];
+  int32_t i, k, n;
+
+  srand(1U);
+  for (i = 0; i < 2000; i++)
+  {
+    n = 3 + (rand() % 10);
+    for (k = 0; k < n; k++)
+    {
+      points[k].X = (int16_t)((rand() % 260) - 30);
+      points[k].Y = (int16_t)((rand() % 210) - 30);
+    }
+    CheckPolygon(points, n, (uint32_t)(rand() % 2), "random");
+  }
+}
+
+/* Circles cover their outline, one span per row. Outlines draw the pixels
+   of the midpoint circle, each once, with horizontal and vertical lines. */
+static void TestCircles(void)
+{
+  static uint8_t fill[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+  static uint8_t outline[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+  uint32_t radius, calls, overdraw, missing, wrong, rows;
+  int32_t  x, y, any;
+
+  for (radius = 1U; radius < 60U; radius++)
+  {
+    Clear();
+    UTIL_LCD_FillCircle(100U, 75U, radius, 0xFFFFFFFFU);
+    calls    = Calls;
+    overdraw = Overdraw;
+    (void)memcpy(fill, Drawn, sizeof(fill));
+    TEST_CHECK_EQ(OutOfDisplay, 0U);
+
+    Clear();
+    UTIL_LCD_SetFuncDriver(&OutlineDriver);
+    UTIL_LCD_DrawCircle(100U, 75U, radius, 0xFFFFFFFFU);
+    UTIL_LCD_SetFuncDriver(&CountDriver);
+    RefCircle(outline, 100, 75, (int32_t)radius);
+    missing = 0U;
+    wrong   = 0U;
+    rows    = 0U;
+    for (y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+      any = 0;
+      for (x = 0; x < DISPLAY_WIDTH; x++)
+      {
+        any |= (fill[y][x] != 0U) ? 1 : 0;
+        if ((Drawn[y][x] != 0U) && (fill[y][x] == 0U))
+        {
+          missing++;
+        }
+        if ((Drawn[y][x] != 0U) != (outline[y][x] != 0U))
+        {
+          wrong++;
+        }
+      }
+      rows += (uint32_t)any;
+    }
+
+    TEST_CHECK_EQ(overdraw, 0U);
+    TEST_CHECK_EQ(calls, rows);
+    TEST_CHECK_EQ(missing, 0U);
+    TEST_CHECK_EQ(wrong, 0U);
+    TEST_CHECK_EQ(Overdraw, 0U);
+    TEST_CHECK_EQ(OutOfDisplay, 0U);
+    TEST_CHECK(VLineCalls != 0U);
+  }
+}
+
+/* Ellipses: pixels with (dx/a)^2 + (dy/b)^2 <= 1, one span per row */
+static void TestEllipses(void)
+{
+  int32_t a, b, x, y;
+  int64_t dx, dy;
+  uint32_t wrong, inside;
+
+  for (a = 0; a < 40; a += 3)
+  {
+    for (b = 0; b < 40; b += 4)
+    {
+      Clear();
+      UTIL_LCD_FillEllipse(100, 75, a, b, 0xFFFFFFFFU);
+      TEST_CHECK_EQ(Overdraw, 0U);
+      TEST_CHECK_EQ(Calls, (2 * b) + 1);
+
+      wrong = 0U;
+      for (y = 0; y < DISPLAY_HEIGHT; y++)
+      {
+        for (x = 0; x < DISPLAY_WIDTH; x++)
+        {
+          dx = x - 100;
+          dy = y - 75;
+          if (a == 0)
+          {
+            inside = ((dx == 0) && (llabs(dy) <= b)) ? 1U : 0U;
+          }
+          else if (b == 0)
+          {
+            inside = ((dy == 0) && (llabs(dx) <= a)) ? 1U : 0U;
+          }
+          else
+          {
+            inside = (((dx * dx * b * b) + (dy * dy * a * a)) <= ((int64_t)a * a * b * b)) ? 1U : 0U;
+          }
+          if (inside != ((Drawn[y][x] != 0U) ? 1U : 0U))
+          {
+            wrong++;
+          }
+        }
+      }
+      TEST_CHECK_EQ(wrong, 0U);
+    }
+  }
+
+  /* Partly out of the display: clipped before the driver */
+  Clear();
+  UTIL_LCD_FillCircle(5U, 5U, 30U, 0xFFFFFFFFU);
+  UTIL_LCD_FillEllipse(-10, 140, 50, 30, 0xFFFFFFFFU);
+  UTIL_LCD_FillEllipse(190, 10, 40, 40, 0xFFFFFFFFU);
+  TEST_CHECK_EQ(OutOfDisplay, 0U);
+}
+
+int main(void)
+{
+  UTIL_LCD_SetFuncDriver(&CountDriver);
+
+  TestFixedPolygons();
+  TestRandomPolygons();
+  TestLargePolygons();
+  TestCircles();
+  TestEllipses();
+
+  return TEST_RESULT("test_lcd_polygon");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
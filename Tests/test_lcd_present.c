@@ -0,0 +1,308 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_present.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_present.c tearing effect synchronized
+  *          presenter over its simulated TE signal and bus, and of the panel
+  *          TE output settings of the ST7789H2 driver over its simulated bus.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_fb.h"
+#include "stm32_lcd_present.h"
+#include "st7789h2_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define DISPLAY_WIDTH    240U
+#define DISPLAY_HEIGHT   240U
+#define PERIOD           16667U  /* Refresh period, in ticks    */
+#define LINES_PER_FRAME  344U    /* Lines scanned, blanking included */
+#define FIRST_LINE       24U     /* Lines scanned before the display */
+#define FRAMES           400U
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t FrameBuffer[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+static uint16_t Image[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+static uint32_t FailWrites;   /* WritePixels calls passing before the transfer fails */
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Random(uint32_t Range)
+{
+  return (uint32_t)rand() % Range;
+}
+
+/* Simulated panel whose transfer fails after FailWrites rows, as an aborted bus transfer */
+static int32_t FailWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  int32_t ret = -1;
+
+  if (FailWrites != 0U)
+  {
+    FailWrites--;
+    ret = UTIL_LCD_PRESENT_SimTarget.WritePixels(Instance, pData, Length);
+  }
+
+  return ret;
+}
+
+static int32_t FailSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  return UTIL_LCD_PRESENT_SimTarget.SetWindow(Instance, Xpos, Ypos, Width, Height);
+}
+
+static const UTIL_LCD_FB_Target_t FailTarget =
+{
+  FailSetWindow,
+  FailWritePixels
+};
+
+/* Draw 1 to 3 random rectangles, a quarter of them full-width bands */
+static void DrawRandomFrame(void)
+{
+  uint32_t n, k, x, y, w, h;
+
+  n = 1U + Random(3U);
+  for (k = 0U; k < n; k++)
+  {
+    w = 1U + Random(DISPLAY_WIDTH);
+    h = 1U + Random(DISPLAY_HEIGHT);
+    if (Random(4U) == 0U)
+    {
+      w = DISPLAY_WIDTH;
+      h = 1U + Random(60U);
+    }
+    x = Random(DISPLAY_WIDTH + 1U - w);
+    y = Random(DISPLAY_HEIGHT + 1U - h);
+    UTIL_LCD_FillRect(x, y, w, h, 0xFF000000U | (uint32_t)rand());
+  }
+}
+
+/* Presenter over the simulated panel, flushing through pTarget */
+static void Setup(uint32_t Order, uint32_t PixelCost, uint32_t WindowCost, uint32_t Guess,
+                  const UTIL_LCD_FB_Target_t *pTarget)
+{
+  UTIL_LCD_FB_Init_t         fb_init;
+  UTIL_LCD_PRESENT_SimInit_t sim_init;
+  UTIL_LCD_PRESENT_Init_t    init;
+
+  fb_init.pBuffer    = FrameBuffer;
+  fb_init.Width      = DISPLAY_WIDTH;
+  fb_init.Height     = DISPLAY_HEIGHT;
+  fb_init.BandHeight = DISPLAY_HEIGHT;
+  fb_init.Instance   = 0U;
+  fb_init.pTarget    = pTarget;
+
+  sim_init.pImage        = Image;
+  sim_init.Width         = DISPLAY_WIDTH;
+  sim_init.Height        = DISPLAY_HEIGHT;
+  sim_init.ScanOrder     = Order;
+  sim_init.Period        = PERIOD;
+  sim_init.LinesPerFrame = LINES_PER_FRAME;
+  sim_init.FirstLine     = FIRST_LINE;
+  sim_init.PixelCost     = PixelCost;
+  sim_init.WindowCost    = WindowCost;
+
+  init.Instance      = 0U;
+  init.Width         = DISPLAY_WIDTH;
+  init.Height        = DISPLAY_HEIGHT;
+  init.ScanOrder     = Order;
+  init.LinesPerFrame = LINES_PER_FRAME;
+  init.FirstLine     = FIRST_LINE;
+  init.PixelCost     = Guess;
+  init.WindowCost    = WindowCost;
+  init.pSync         = &UTIL_LCD_PRESENT_SimSync;
+
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_SimInit(&sim_init), UTIL_LCD_PRESENT_OK);
+  TEST_CHECK_EQ(UTIL_LCD_FB_Init(&fb_init), UTIL_LCD_FB_OK);
+  UTIL_LCD_SetFuncDriver(&UTIL_LCD_FB_Driver);
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_Init(&init), UTIL_LCD_PRESENT_OK);
+}
+
+/*
+ * Present random frames at random times over a panel scanning in Order, with
+ * a bus of PixelCost / WindowCost and an initial cost estimate of Guess.
+ * Checks the displayed image, the frame and missed refresh counts, and when
+ * the bus cost is known, that no flush predicted tear-free is displayed torn.
+ */
+static void RunPresenter(uint32_t Order, uint32_t PixelCost, uint32_t WindowCost, uint32_t Guess)
+{
+  UTIL_LCD_PRESENT_Stats_t    stats, stats0;
+  UTIL_LCD_PRESENT_SimStats_t sim, sim0;
+  uint32_t frame, refresh, last_refresh = 0U, missed = 0U, unexpected = 0U;
+
+  Setup(Order, PixelCost, WindowCost, Guess, &UTIL_LCD_PRESENT_SimTarget);
+
+  /* The refresh period is measured on the TE signal at init */
+  UTIL_LCD_PRESENT_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Period, PERIOD);
+
+  for (frame = 0U; frame < FRAMES; frame++)
+  {
+    DrawRandomFrame();
+    UTIL_LCD_PRESENT_SimAdvance(Random(PERIOD + (PERIOD / 2U)));
+
+    UTIL_LCD_PRESENT_SimGetStats(&sim0);
+    UTIL_LCD_PRESENT_GetStats(&stats0);
+    refresh = (sim0.Time / PERIOD) + 1U;
+    if (frame > 0U)
+    {
+      missed += refresh - last_refresh - 1U;
+    }
+    last_refresh = refresh;
+
+    TEST_CHECK_EQ(UTIL_LCD_PRESENT_Frame(), UTIL_LCD_PRESENT_OK);
+
+    UTIL_LCD_PRESENT_GetStats(&stats);
+    UTIL_LCD_PRESENT_SimGetStats(&sim);
+    if ((stats.TornFrames == stats0.TornFrames) && (sim.TornFlushes != sim0.TornFlushes))
+    {
+      unexpected++;
+    }
+    if (memcmp(FrameBuffer, Image, sizeof(Image)) != 0)
+    {
+      (void)printf("order %u: image mismatch at frame %u\n", (unsigned int)Order, (unsigned int)frame);
+      TestFailures++;
+      break;
+    }
+  }
+
+  UTIL_LCD_PRESENT_GetStats(&stats);
+  UTIL_LCD_PRESENT_SimGetStats(&sim);
+  TEST_CHECK_EQ(stats.FrameCount, FRAMES);
+  TEST_CHECK_EQ(stats.MissedFrames, missed);
+  TEST_CHECK_EQ(sim.FlushCount, FRAMES);
+  TEST_CHECK(stats.MaxFlushTime >= stats.LastFlushTime);
+  if (Guess == PixelCost)
+  {
+    TEST_CHECK_EQ(unexpected, 0U);
+  }
+  else
+  {
+    /* Only a few first frames may tear while the bus cost is learned */
+    TEST_CHECK(unexpected <= (FRAMES / 50U));
+    TEST_CHECK((100U * stats.PixelCost) >= ((100U - UTIL_LCD_PRESENT_MARGIN) * PixelCost));
+    TEST_CHECK((100U * stats.PixelCost) <= ((100U + UTIL_LCD_PRESENT_MARGIN) * PixelCost));
+  }
+}
+
+static void TestPresenter(void)
+{
+  uint32_t order;
+
+  srand(1U);
+  for (order = UTIL_LCD_PRESENT_SCAN_TOP_DOWN; order <= UTIL_LCD_PRESENT_SCAN_RIGHT_LEFT; order++)
+  {
+    RunPresenter(order, 26U, 2U, 26U);
+    RunPresenter(order, 128U, 2U, 128U);
+    RunPresenter(order, 60U, 5U, 60U);
+    RunPresenter(order, 128U, 2U, 40U);
+  }
+}
+
+/* A failed flush is reported, keeps its regions and is not learned from */
+static void TestFlushError(void)
+{
+  UTIL_LCD_PRESENT_Stats_t stats0, stats;
+  uint32_t                 frame;
+
+  srand(2U);
+  Setup(UTIL_LCD_PRESENT_SCAN_TOP_DOWN, 128U, 2U, 40U, &FailTarget);
+  FailWrites = 0xFFFFFFFFU;
+  for (frame = 0U; frame < 20U; frame++)
+  {
+    DrawRandomFrame();
+    TEST_CHECK_EQ(UTIL_LCD_PRESENT_Frame(), UTIL_LCD_PRESENT_OK);
+  }
+  UTIL_LCD_PRESENT_GetStats(&stats0);
+
+  /* One row sent out of 100: the flush time is far below the bus cost */
+  FailWrites = 1U;
+  UTIL_LCD_FillRect(10U, 10U, 100U, 100U, 0xFF00FF00U);
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_Frame(), UTIL_LCD_PRESENT_ERROR);
+  UTIL_LCD_PRESENT_GetStats(&stats);
+  TEST_CHECK_EQ(stats.PixelCost, stats0.PixelCost);
+
+  FailWrites = 0xFFFFFFFFU;
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_Frame(), UTIL_LCD_PRESENT_OK);
+  TEST_CHECK_EQ(memcmp(FrameBuffer, Image, sizeof(Image)), 0);
+  UTIL_LCD_PRESENT_GetStats(&stats);
+  TEST_CHECK((100U * stats.PixelCost) >= ((100U - UTIL_LCD_PRESENT_MARGIN) * 128U));
+}
+
+static void TestInitErrors(void)
+{
+  UTIL_LCD_PRESENT_Init_t init;
+
+  (void)memset(&init, 0, sizeof(init));
+  init.Width         = DISPLAY_WIDTH;
+  init.Height        = DISPLAY_HEIGHT;
+  init.ScanOrder     = UTIL_LCD_PRESENT_SCAN_RIGHT_LEFT + 1U;
+  init.LinesPerFrame = LINES_PER_FRAME;
+  init.FirstLine     = FIRST_LINE;
+  init.pSync         = &UTIL_LCD_PRESENT_SimSync;
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_Init(&init), UTIL_LCD_PRESENT_ERROR);
+
+  init.ScanOrder = UTIL_LCD_PRESENT_SCAN_TOP_DOWN;
+  init.pSync     = NULL;
+  TEST_CHECK_EQ(UTIL_LCD_PRESENT_Init(&init), UTIL_LCD_PRESENT_ERROR);
+}
+
+/* Panel TE output, as set by BSP_LCD_TE_Init() and BSP_LCD_TE_DeInit() */
+static void TestPanelTearingEffect(void)
+{
+  ST7789H2_Object_t    obj;
+  ST7789H2_IO_t        io;
+  ST7789H2_SIM_Stats_t stats;
+
+  (void)memset(&obj, 0, sizeof(obj));
+  TEST_CHECK_EQ(ST7789H2_SIM_Init(&io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_RegisterBusIO(&obj, &io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_Init(&obj, ST7789H2_FORMAT_RBG565, ST7789H2_ORIENTATION_PORTRAIT), ST7789H2_OK);
+
+  ST7789H2_SIM_ResetStats();
+  TEST_CHECK_EQ(ST7789H2_SetTearingEffect(&obj, ST7789H2_TE_VBLANK), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_SIM_GetTearingEffect(), ST7789H2_TE_VBLANK);
+  TEST_CHECK_EQ(ST7789H2_SetTearingEffect(&obj, ST7789H2_TE_VHBLANK), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_SIM_GetTearingEffect(), ST7789H2_TE_VHBLANK);
+  TEST_CHECK_EQ(ST7789H2_SetTearingEffect(&obj, ST7789H2_TE_OFF), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_SIM_GetTearingEffect(), ST7789H2_TE_OFF);
+  TEST_CHECK_EQ(ST7789H2_SetTearingEffect(&obj, ST7789H2_TE_VHBLANK + 1U), ST7789H2_ERROR);
+
+  /* TEON with its mode parameter, TEOFF alone, nothing else on the bus */
+  ST7789H2_SIM_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Op[ST7789H2_TE_LINE_ON].Count, 2U);
+  TEST_CHECK_EQ(stats.Op[ST7789H2_TE_LINE_ON].Bytes, 8U);
+  TEST_CHECK_EQ(stats.Op[ST7789H2_TE_LINE_OFF].Count, 1U);
+  TEST_CHECK_EQ(stats.Op[ST7789H2_TE_LINE_OFF].Bytes, 2U);
+  TEST_CHECK_EQ(stats.Commands, 3U);
+}
+
+int main(void)
+{
+  TestPresenter();
+  TestFlushError();
+  TestInitErrors();
+  TestPanelTearingEffect();
+
+  return TEST_RESULT("test_lcd_present");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
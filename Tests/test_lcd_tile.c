@@ -0,0 +1,545 @@
+/**
+  ******************************************************************************
+  * @file    test_lcd_tile.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_lcd_tile.c tile map and sprite engine:
+  *          random frames of cell changes, tile loads and sprite moves, shows
+  *          and image changes are rendered into a memory display and compared
+  *          with a naive composition of the whole map. The cells sent must be
+  *          the ones touched by the frame, in one rectangle per run of
+  *          adjacent cells fitting in the composition buffer.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "stm32_lcd_tile.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define WIDTH           320U
+#define HEIGHT          240U
+#define UNTOUCHED       0xA5A5U     /* Display pixel never drawn */
+#define COLOR_KEY       0xF81FU
+#define MAX_CELLS       1024U
+#define MAX_TILES       12U
+#define MAX_TILE_SIZE   (32U * 32U)
+#define FRAMES          300U
+#define MIN(a, b)       (((a) < (b)) ? (a) : (b))
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Xpos;
+  uint32_t Ypos;
+  uint32_t TileWidth;
+  uint32_t TileHeight;
+  uint32_t Columns;
+  uint32_t Rows;
+} Config_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint16_t Display[WIDTH * HEIGHT];
+static uint16_t Expected[WIDTH * HEIGHT];
+static UTIL_LCD_TILE_Map_t Map;
+static uint16_t Cells[MAX_CELLS];
+static uint16_t Tiles[MAX_TILES * MAX_TILE_SIZE];
+static uint16_t TileData[MAX_TILE_SIZE];
+
+/* Model of the map: tile of each cell, cells expected to be drawn */
+static uint16_t ModelCells[MAX_CELLS];
+static uint16_t ModelTiles[MAX_TILES * MAX_TILE_SIZE];
+static uint8_t  Dirty[MAX_CELLS];
+static UTIL_LCD_TILE_Sprite_t ModelSprites[UTIL_LCD_TILE_MAX_SPRITES];
+
+/* Sprite images: sizes and RGB565 pixels, partly transparent */
+static const uint32_t SpriteSizes[4][2] = {{16U, 16U}, {7U, 23U}, {40U, 9U}, {1U, 1U}};
+static uint16_t SpriteData[4][40U * 23U];
+
+/* Driver calls, checked when the whole map is on the display */
+static uint32_t Writes, MisalignedWrites, Fits;
+
+/* Private functions ---------------------------------------------------------*/
+/* Display: RGB565 memory, only FillRGBRect() is expected from the renderer */
+static int32_t MemFillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t W, uint32_t H)
+{
+  uint32_t x, y;
+
+  (void)Instance;
+  Writes++;
+
+  /* Whole cells of a row */
+  if ((Fits != 0U) && ((((Xpos - Map.Xpos) % Map.TileWidth) != 0U) || (((Ypos - Map.Ypos) % Map.TileHeight) != 0U) ||
+      (H != MIN(Map.TileHeight, HEIGHT - Ypos)) || (W > (UTIL_LCD_TILE_BUFFER_SIZE / Map.TileHeight))))
+  {
+    MisalignedWrites++;
+  }
+
+  for (y = 0U; y < H; y++)
+  {
+    for (x = 0U; x < W; x++)
+    {
+      Display[((Ypos + y) * WIDTH) + Xpos + x] =
+        (uint16_t)((uint32_t)pData[2U * ((y * W) + x)] | ((uint32_t)pData[(2U * ((y * W) + x)) + 1U] << 8));
+    }
+  }
+
+  return 0;
+}
+
+static int32_t MemDrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)pBmp;
+  MisalignedWrites++;
+  return -1;
+}
+
+static int32_t MemFillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t W, uint32_t H, uint32_t Color)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+  (void)W;
+  (void)H;
+  (void)Color;
+  MisalignedWrites++;
+  return -1;
+}
+
+static int32_t MemDrawLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+static int32_t MemGetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  *pColor = Display[(Ypos * WIDTH) + Xpos];
+  return 0;
+}
+
+static int32_t MemSetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return MemFillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+static int32_t MemGetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  *pXSize = WIDTH;
+  return 0;
+}
+
+static int32_t MemGetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  *pYSize = HEIGHT;
+  return 0;
+}
+
+static int32_t MemSetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t MemGetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+static const LCD_UTILS_Drv_t MemDriver =
+{
+  MemDrawBitmap,
+  MemFillRGBRect,
+  MemDrawLine,
+  MemDrawLine,
+  MemFillRect,
+  MemGetPixel,
+  MemSetPixel,
+  MemGetXSize,
+  MemGetYSize,
+  MemSetLayer,
+  MemGetFormat
+};
+
+/* Model: cells covered by an area of the map are drawn by the next render */
+static void MarkArea(int32_t Xpos, int32_t Ypos, uint32_t W, uint32_t H)
+{
+  int32_t  x, y;
+  uint32_t w = Map.Columns * Map.TileWidth, h = Map.Rows * Map.TileHeight;
+
+  for (y = Ypos; y < (Ypos + (int32_t)H); y++)
+  {
+    for (x = Xpos; x < (Xpos + (int32_t)W); x++)
+    {
+      if ((x >= 0) && (y >= 0) && ((uint32_t)x < w) && ((uint32_t)y < h))
+      {
+        Dirty[(((uint32_t)y / Map.TileHeight) * Map.Columns) + ((uint32_t)x / Map.TileWidth)] = 1U;
+      }
+    }
+  }
+}
+
+static void MarkSprite(const UTIL_LCD_TILE_Sprite_t *pSprite)
+{
+  if ((pSprite->Visible != 0U) && (pSprite->pData != NULL))
+  {
+    MarkArea(pSprite->X, pSprite->Y, pSprite->Width, pSprite->Height);
+  }
+}
+
+/* Naive composition of the whole map, clipped to the display */
+static void Compose(void)
+{
+  const UTIL_LCD_TILE_Sprite_t *pSprite;
+  uint32_t mx, my, id, tile;
+  uint16_t color, pixel;
+
+  for (my = 0U; my < (Map.Rows * Map.TileHeight); my++)
+  {
+    for (mx = 0U; mx < (Map.Columns * Map.TileWidth); mx++)
+    {
+      tile  = ModelCells[((my / Map.TileHeight) * Map.Columns) + (mx / Map.TileWidth)];
+      color = ModelTiles[(tile * Map.TileWidth * Map.TileHeight) + ((my % Map.TileHeight) * Map.TileWidth) +
+                         (mx % Map.TileWidth)];
+      for (id = 0U; id < UTIL_LCD_TILE_MAX_SPRITES; id++)
+      {
+        pSprite = &ModelSprites[id];
+        if ((pSprite->Visible != 0U) && (pSprite->pData != NULL) &&
+            ((int32_t)mx >= pSprite->X) && ((int32_t)mx < (pSprite->X + (int32_t)pSprite->Width)) &&
+            ((int32_t)my >= pSprite->Y) && ((int32_t)my < (pSprite->Y + (int32_t)pSprite->Height)))
+        {
+          pixel = pSprite->pData[(((int32_t)my - pSprite->Y) * (int32_t)pSprite->Width) + ((int32_t)mx - pSprite->X)];
+          color = (pixel != pSprite->ColorKey) ? pixel : color;
+        }
+      }
+      if (((Map.Xpos + mx) < WIDTH) && ((Map.Ypos + my) < HEIGHT))
+      {
+        Expected[((Map.Ypos + my) * WIDTH) + Map.Xpos + mx] = color;
+      }
+    }
+  }
+}
+
+/* Render a frame, check the image and the cells sent */
+static void RenderFrame(void)
+{
+  uint32_t i, row, column, run, run_max, tiles = 0U, writes = 0U, bad = 0U;
+
+  run_max = UTIL_LCD_TILE_BUFFER_SIZE / (Map.TileWidth * Map.TileHeight);
+  for (row = 0U; row < Map.Rows; row++)
+  {
+    run = 0U;
+    for (column = 0U; column <= Map.Columns; column++)
+    {
+      if ((column < Map.Columns) && (Dirty[(row * Map.Columns) + column] != 0U))
+      {
+        tiles++;
+        run++;
+      }
+      else
+      {
+        writes += (run + run_max - 1U) / run_max;
+        run     = 0U;
+      }
+    }
+  }
+
+  Writes = 0U;
+  UTIL_LCD_TILE_Render(&Map);
+  TEST_CHECK_EQ(Map.TilesDrawn, tiles);
+  TEST_CHECK_EQ(Map.Writes, writes);
+  TEST_CHECK((Fits == 0U) || (Writes == writes));
+  TEST_CHECK_EQ(MisalignedWrites, 0U);
+  (void)memset(Dirty, 0, sizeof(Dirty));
+
+  Compose();
+  for (i = 0U; i < (WIDTH * HEIGHT); i++)
+  {
+    bad += (Display[i] != Expected[i]) ? 1U : 0U;
+  }
+  TEST_CHECK_EQ(bad, 0U);
+}
+
+static void RandomTile(void)
+{
+  uint32_t i;
+
+  for (i = 0U; i < (Map.TileWidth * Map.TileHeight); i++)
+  {
+    TileData[i] = (uint16_t)rand();
+  }
+}
+
+/* Random frames on a map */
+static void TestMap(const Config_t *pConfig)
+{
+  uint32_t i, frame, n, op, id, index, column, row, cells, size, tile_size, visible;
+  int32_t  x, y, map_w, map_h;
+  UTIL_LCD_TILE_Sprite_t *pSprite;
+
+  (void)memset(&Map, 0, sizeof(Map));
+  Map.Xpos       = pConfig->Xpos;
+  Map.Ypos       = pConfig->Ypos;
+  Map.TileWidth  = pConfig->TileWidth;
+  Map.TileHeight = pConfig->TileHeight;
+  Map.Columns    = pConfig->Columns;
+  Map.Rows       = pConfig->Rows;
+  Map.pCells     = Cells;
+  Map.pTiles     = Tiles;
+  Map.TileCount  = MAX_TILES;
+  cells     = Map.Columns * Map.Rows;
+  tile_size = Map.TileWidth * Map.TileHeight;
+  map_w     = (int32_t)(Map.Columns * Map.TileWidth);
+  map_h     = (int32_t)(Map.Rows * Map.TileHeight);
+  Fits      = (((Map.Xpos + (uint32_t)map_w) <= WIDTH) && ((Map.Ypos + (uint32_t)map_h) <= HEIGHT)) ? 1U : 0U;
+
+  for (i = 0U; i < cells; i++)
+  {
+    Cells[i]      = (uint16_t)((uint32_t)rand() % MAX_TILES);
+    ModelCells[i] = Cells[i];
+  }
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_OK);
+  for (i = 0U; i < MAX_TILES; i++)
+  {
+    RandomTile();
+    TEST_CHECK_EQ(UTIL_LCD_TILE_LoadTile(&Map, i, TileData), UTIL_LCD_TILE_OK);
+    (void)memcpy(&ModelTiles[i * tile_size], TileData, tile_size * sizeof(uint16_t));
+  }
+  (void)memset(ModelSprites, 0, sizeof(ModelSprites));
+  (void)memset(Dirty, 1, cells);
+  for (i = 0U; i < (WIDTH * HEIGHT); i++)
+  {
+    Display[i]  = UNTOUCHED;
+    Expected[i] = UNTOUCHED;
+  }
+  RenderFrame();
+
+  /* Nothing changed, nothing sent */
+  RenderFrame();
+  TEST_CHECK_EQ(Map.TilesDrawn, 0U);
+
+  for (frame = 0U; frame < FRAMES; frame++)
+  {
+    n = (uint32_t)rand() % 4U;
+    for (i = 0U; i < n; i++)
+    {
+      op      = (uint32_t)rand() % 16U;
+      id      = (uint32_t)rand() % UTIL_LCD_TILE_MAX_SPRITES;
+      pSprite = &ModelSprites[id];
+
+      if (op < 3U)
+      {
+        /* Cell change, possibly to the same tile */
+        column = (uint32_t)rand() % Map.Columns;
+        row    = (uint32_t)rand() % Map.Rows;
+        index  = (uint32_t)rand() % MAX_TILES;
+        TEST_CHECK_EQ(UTIL_LCD_TILE_SetCell(&Map, column, row, index), UTIL_LCD_TILE_OK);
+        if (ModelCells[(row * Map.Columns) + column] != index)
+        {
+          ModelCells[(row * Map.Columns) + column] = (uint16_t)index;
+          Dirty[(row * Map.Columns) + column]      = 1U;
+        }
+      }
+      else if (op == 3U)
+      {
+        /* Tile reloaded */
+        index = (uint32_t)rand() % MAX_TILES;
+        RandomTile();
+        TEST_CHECK_EQ(UTIL_LCD_TILE_LoadTile(&Map, index, TileData), UTIL_LCD_TILE_OK);
+        (void)memcpy(&ModelTiles[index * tile_size], TileData, tile_size * sizeof(uint16_t));
+        for (column = 0U; column < cells; column++)
+        {
+          Dirty[column] |= (ModelCells[column] == index) ? 1U : 0U;
+        }
+      }
+      else if (op < 6U)
+      {
+        /* New sprite image */
+        size = (uint32_t)rand() % 4U;
+        TEST_CHECK_EQ(UTIL_LCD_TILE_SetSprite(&Map, id, SpriteData[size], SpriteSizes[size][0], SpriteSizes[size][1],
+                                              COLOR_KEY), UTIL_LCD_TILE_OK);
+        MarkSprite(pSprite);
+        pSprite->pData    = SpriteData[size];
+        pSprite->Width    = SpriteSizes[size][0];
+        pSprite->Height   = SpriteSizes[size][1];
+        pSprite->ColorKey = COLOR_KEY;
+        MarkSprite(pSprite);
+      }
+      else if (op < 8U)
+      {
+        /* Sprite shown or hidden, an error without an image */
+        visible = (uint32_t)rand() % 2U;
+        if (pSprite->pData == NULL)
+        {
+          TEST_CHECK_EQ(UTIL_LCD_TILE_ShowSprite(&Map, id, visible), UTIL_LCD_TILE_ERROR);
+        }
+        else
+        {
+          TEST_CHECK_EQ(UTIL_LCD_TILE_ShowSprite(&Map, id, visible), UTIL_LCD_TILE_OK);
+          if (pSprite->Visible != visible)
+          {
+            pSprite->Visible = 1U;
+            MarkSprite(pSprite);
+            pSprite->Visible = (uint8_t)visible;
+          }
+        }
+      }
+      else if (op == 15U)
+      {
+        if (((uint32_t)rand() % 8U) == 0U)
+        {
+          UTIL_LCD_TILE_Invalidate(&Map);
+          (void)memset(Dirty, 1, cells);
+        }
+      }
+      else
+      {
+        /* Small steps, or a jump anywhere around the map */
+        if ((op < 13U) && (pSprite->pData != NULL))
+        {
+          x = pSprite->X + (int32_t)((uint32_t)rand() % 7U) - 3;
+          y = pSprite->Y + (int32_t)((uint32_t)rand() % 7U) - 3;
+        }
+        else
+        {
+          x = (int32_t)((uint32_t)rand() % (uint32_t)(map_w + 60)) - 45;
+          y = (int32_t)((uint32_t)rand() % (uint32_t)(map_h + 60)) - 30;
+        }
+        TEST_CHECK_EQ(UTIL_LCD_TILE_MoveSprite(&Map, id, x, y), UTIL_LCD_TILE_OK);
+        if ((pSprite->X != x) || (pSprite->Y != y))
+        {
+          MarkSprite(pSprite);
+          pSprite->X = x;
+          pSprite->Y = y;
+          MarkSprite(pSprite);
+        }
+      }
+    }
+    RenderFrame();
+  }
+}
+
+/* A 16x16 sprite moving by one pixel redraws the cells it covers only */
+static void TestSpriteCost(void)
+{
+  static const Config_t config = {0U, 0U, 16U, 16U, 15U, 10U};
+  uint32_t step;
+
+  TestMap(&config);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_OK);
+  UTIL_LCD_TILE_Render(&Map);
+
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetSprite(&Map, 0U, SpriteData[0], 16U, 16U, COLOR_KEY), UTIL_LCD_TILE_OK);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_MoveSprite(&Map, 0U, 40, 40), UTIL_LCD_TILE_OK);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_ShowSprite(&Map, 0U, 1U), UTIL_LCD_TILE_OK);
+  UTIL_LCD_TILE_Render(&Map);
+  TEST_CHECK_EQ(Map.TilesDrawn, 4U);
+  for (step = 1U; step <= 16U; step++)
+  {
+    TEST_CHECK_EQ(UTIL_LCD_TILE_MoveSprite(&Map, 0U, 40 + (int32_t)step, 40), UTIL_LCD_TILE_OK);
+    UTIL_LCD_TILE_Render(&Map);
+    TEST_CHECK(Map.TilesDrawn <= 6U);
+    TEST_CHECK(Map.Writes <= 2U);
+  }
+}
+
+/* Configurations rejected */
+static void TestErrors(void)
+{
+  uint32_t i;
+
+  (void)memset(&Map, 0, sizeof(Map));
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(NULL), UTIL_LCD_TILE_ERROR);
+  Map.TileWidth  = 8U;
+  Map.TileHeight = 8U;
+  Map.Columns    = 4U;
+  Map.Rows       = 4U;
+  Map.pCells     = Cells;
+  Map.pTiles     = Tiles;
+  Map.TileCount  = 2U;
+  for (i = 0U; i < 16U; i++)
+  {
+    Cells[i] = 1U;
+  }
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_OK);
+  Cells[5] = 2U;
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_ERROR);
+  Cells[5] = 1U;
+  Map.TileWidth = (UTIL_LCD_TILE_BUFFER_SIZE / 8U) + 1U;
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_ERROR);
+  Map.TileWidth = 8U;
+  Map.TileCount = 0U;
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_ERROR);
+  Map.TileCount = 2U;
+  TEST_CHECK_EQ(UTIL_LCD_TILE_Init(&Map), UTIL_LCD_TILE_OK);
+
+  TEST_CHECK_EQ(UTIL_LCD_TILE_LoadTile(&Map, 2U, TileData), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_LoadTile(&Map, 0U, NULL), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetCell(&Map, 4U, 0U, 0U), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetCell(&Map, 0U, 4U, 0U), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetCell(&Map, 0U, 0U, 2U), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetSprite(&Map, UTIL_LCD_TILE_MAX_SPRITES, SpriteData[0], 16U, 16U, 0U),
+                UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_SetSprite(&Map, 0U, NULL, 16U, 16U, 0U), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_MoveSprite(&Map, UTIL_LCD_TILE_MAX_SPRITES, 0, 0), UTIL_LCD_TILE_ERROR);
+  TEST_CHECK_EQ(UTIL_LCD_TILE_ShowSprite(&Map, 0U, 1U), UTIL_LCD_TILE_ERROR);
+}
+
+int main(void)
+{
+  /* Tile sizes giving runs of 16, 8, 4 and 1 cells, a map past the display */
+  static const Config_t configs[] =
+  {
+    {5U,   3U,   8U,  8U, 30U, 25U},
+    {0U,   0U,  12U, 10U, 26U, 24U},
+    {17U, 11U,  16U, 16U, 18U, 13U},
+    {0U,   0U,  32U, 32U, 10U,  7U},
+    {250U, 190U, 16U, 16U,  8U,  6U}
+  };
+  uint32_t i, k;
+
+  srand(1U);
+  for (k = 0U; k < 4U; k++)
+  {
+    for (i = 0U; i < (SpriteSizes[k][0] * SpriteSizes[k][1]); i++)
+    {
+      SpriteData[k][i] = (((uint32_t)rand() % 3U) == 0U) ? COLOR_KEY : (uint16_t)rand();
+    }
+  }
+  SpriteData[3][0] = 0x1234U;
+  UTIL_LCD_SetFuncDriver(&MemDriver);
+
+  for (i = 0U; i < (sizeof(configs) / sizeof(configs[0])); i++)
+  {
+    TestMap(&configs[i]);
+  }
+  TestSpriteCost();
+  TestErrors();
+
+  return TEST_RESULT("test_lcd_tile");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
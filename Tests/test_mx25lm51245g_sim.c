@@ -0,0 +1,575 @@
+/**
+  ******************************************************************************
+  * @file    test_mx25lm51245g_sim.c
+  * @author  MCD Application Team
+  * @brief   Host test of the mx25lm51245g_sim.c simulated memory: write enable
+  *          and busy gating, page wrap, 4K/64K/bulk erases, suspend and resume
+  *          status bits, SPI/STR OPI/DTR OPI command decoding, operation times
+  *          charged from the MX25LM51245G_*_MAX_TIME constants, and injected
+  *          power losses and failures interrupting programs and erases.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "mx25lm51245g_sim.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define SPI             MX25LM51245G_SPI_MODE
+#define OPI             MX25LM51245G_OPI_MODE
+#define STR             MX25LM51245G_STR_TRANSFER
+#define DTR             MX25LM51245G_DTR_TRANSFER
+#define ADDR4           MX25LM51245G_4BYTES_SIZE
+#define PAGE            MX25LM51245G_PAGE_SIZE
+#define SUBSECTOR       MX25LM51245G_SUBSECTOR_4K
+#define SECTOR          MX25LM51245G_SECTOR_64K
+#define BASE            0x00340000U  /* Aligned on a 64K sector */
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static OSPI_HandleTypeDef Ospi;
+static uint8_t            Buffer[SECTOR];
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t ReadSr(void)
+{
+  uint8_t reg[2] = {0U, 0U};
+
+  TEST_CHECK_EQ(MX25LM51245G_ReadStatusRegister(&Ospi, SPI, STR, reg), MX25LM51245G_OK);
+
+  return reg[0];
+}
+
+static uint8_t ReadSecr(void)
+{
+  uint8_t reg[2] = {0U, 0U};
+
+  TEST_CHECK_EQ(MX25LM51245G_ReadSecurityRegister(&Ospi, SPI, STR, reg), MX25LM51245G_OK);
+
+  return reg[0];
+}
+
+static uint32_t Ignored(void)
+{
+  MX25LM51245G_SIM_Stats_t stats;
+
+  MX25LM51245G_SIM_GetStats(&stats);
+
+  return stats.Ignored;
+}
+
+static void Program(uint32_t Address, const uint8_t *pData, uint32_t Size)
+{
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, (uint8_t *)pData, Address, Size), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+}
+
+static void Erase(uint32_t Address, MX25LM51245G_Erase_t Type)
+{
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, Address, Type), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+}
+
+/* Number of bytes equal to Value from Address */
+static uint32_t CountBytes(uint32_t Address, uint32_t Size, uint8_t Value)
+{
+  const uint8_t *image = MX25LM51245G_SIM_GetImage();
+  uint32_t       i, count = 0U;
+
+  for (i = 0U; i < Size; i++)
+  {
+    count += (image[Address + i] == Value) ? 1U : 0U;
+  }
+
+  return count;
+}
+
+/* Program and erase only with the write enable latch set, and not while busy */
+static void TestWriteEnable(void)
+{
+  uint8_t  data[16];
+  uint8_t  id[3];
+  uint32_t ignored;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  (void)memset(data, 0x5A, sizeof(data));
+
+  /* No write enable */
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE, MX25LM51245G_ERASE_4K), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ChipErase(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSr() & (MX25LM51245G_SR_WIP | MX25LM51245G_SR_WEL), 0U);
+  TEST_CHECK_EQ(Ignored(), ignored + 3U);
+  TEST_CHECK_EQ(CountBytes(BASE, sizeof(data), 0xFFU), sizeof(data));
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE), 0U);
+
+  /* Write enable, then disable */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSr(), MX25LM51245G_SR_WEL);
+  TEST_CHECK_EQ(MX25LM51245G_WriteDisable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSr(), 0U);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Ignored(), ignored + 4U);
+
+  /* WIP during the program, WEL cleared at its end */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSr(), MX25LM51245G_SR_WIP | MX25LM51245G_SR_WEL);
+
+  /* Busy: write enable, programs, erases and reads ignored, nothing output */
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE + PAGE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE + SECTOR, MX25LM51245G_ERASE_4K), MX25LM51245G_OK);
+  (void)memset(Buffer, 0, sizeof(data));
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Buffer[0], 0xFFU);
+  TEST_CHECK_EQ(Ignored(), ignored + 4U);
+  TEST_CHECK_EQ(CountBytes(BASE, sizeof(data), 0xFFU), sizeof(data));
+
+  /* Other commands are still decoded */
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, SPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSr(), 0U);
+  TEST_CHECK_EQ(CountBytes(BASE, sizeof(data), 0x5AU), sizeof(data));
+  TEST_CHECK_EQ(CountBytes(BASE + PAGE, sizeof(data), 0xFFU), sizeof(data));
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + SECTOR), 0U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK(memcmp(Buffer, data, sizeof(data)) == 0);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Programs only clear bits and wrap within the page */
+static void TestPageWrap(void)
+{
+  uint8_t       data[300];
+  const uint8_t *image;
+  uint32_t      i, bad = 0U;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  image = MX25LM51245G_SIM_GetImage();
+  for (i = 0U; i < sizeof(data); i++)
+  {
+    data[i] = (uint8_t)(i * 7U);
+  }
+
+  /* 16 bytes from offset 250: 6 bytes to the end of the page, 10 at its start */
+  Program(BASE + 250U, data, 16U);
+  for (i = 0U; i < 16U; i++)
+  {
+    bad += (image[BASE + ((250U + i) % PAGE)] != data[i]) ? 1U : 0U;
+  }
+  TEST_CHECK_EQ(bad, 0U);
+  TEST_CHECK_EQ(CountBytes(BASE + 10U, 240U, 0xFFU), 240U);
+  TEST_CHECK_EQ(CountBytes(BASE + PAGE, PAGE, 0xFFU), PAGE);
+
+  /* More than a page: the last 256 bytes are kept */
+  Program(BASE + (2U * PAGE) + 100U, data, sizeof(data));
+  for (i = sizeof(data) - PAGE; i < sizeof(data); i++)
+  {
+    bad += (image[BASE + (2U * PAGE) + ((100U + i) % PAGE)] != data[i]) ? 1U : 0U;
+  }
+  TEST_CHECK_EQ(bad, 0U);
+  TEST_CHECK_EQ(CountBytes(BASE + (3U * PAGE), PAGE, 0xFFU), PAGE);
+
+  /* Program ANDed with the content */
+  data[0] = 0xF0U;
+  Program(BASE + (4U * PAGE), data, 1U);
+  data[0] = 0x3CU;
+  Program(BASE + (4U * PAGE), data, 1U);
+  TEST_CHECK_EQ(image[BASE + (4U * PAGE)], 0x30U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Aligned 4K subsector, 64K sector and bulk erases */
+static void TestErase(void)
+{
+  uint8_t                 *image;
+  MX25LM51245G_SIM_Stats_t stats;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  image = MX25LM51245G_SIM_GetImage();
+  (void)memset(&image[BASE - SECTOR], 0x00, 3U * SECTOR);
+
+  /* 4K, address within the subsector */
+  Erase(BASE + (3U * SUBSECTOR) + 1234U, MX25LM51245G_ERASE_4K);
+  TEST_CHECK_EQ(CountBytes(BASE + (3U * SUBSECTOR), SUBSECTOR, 0xFFU), SUBSECTOR);
+  TEST_CHECK_EQ(CountBytes(BASE, 3U * SUBSECTOR, 0x00U), 3U * SUBSECTOR);
+  TEST_CHECK_EQ(CountBytes(BASE + (4U * SUBSECTOR), SECTOR - (4U * SUBSECTOR), 0x00U), SECTOR - (4U * SUBSECTOR));
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + (3U * SUBSECTOR)), 1U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + (4U * SUBSECTOR)), 0U);
+
+  /* 64K, address within the sector */
+  Erase(BASE + SECTOR - 1U, MX25LM51245G_ERASE_64K);
+  TEST_CHECK_EQ(CountBytes(BASE, SECTOR, 0xFFU), SECTOR);
+  TEST_CHECK_EQ(CountBytes(BASE - SECTOR, SECTOR, 0x00U), SECTOR);
+  TEST_CHECK_EQ(CountBytes(BASE + SECTOR, SECTOR, 0x00U), SECTOR);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE), 1U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + (3U * SUBSECTOR)), 2U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + SECTOR - 1U), 1U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + SECTOR), 0U);
+
+  /* Bulk */
+  image[0] = 0x00U;
+  image[MX25LM51245G_FLASH_SIZE - 1U] = 0x00U;
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ChipErase(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(image[0], 0xFFU);
+  TEST_CHECK_EQ(image[MX25LM51245G_FLASH_SIZE - 1U], 0xFFU);
+  TEST_CHECK_EQ(CountBytes(BASE - SECTOR, 3U * SECTOR, 0xFFU), 3U * SECTOR);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(0U), 1U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + (3U * SUBSECTOR)), 3U);
+
+  MX25LM51245G_SIM_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Erases4K, 1U);
+  TEST_CHECK_EQ(stats.Erases64K, 1U);
+  TEST_CHECK_EQ(stats.ChipErases, 1U);
+  TEST_CHECK_EQ(stats.Ignored, 0U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Suspend and resume of an erase and of a program */
+static void TestSuspend(void)
+{
+  uint8_t  data[PAGE];
+  uint64_t start, suspended, resumed, remaining;
+  uint32_t ignored;
+  uint8_t  *image;
+  MX25LM51245G_SIM_Stats_t stats;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  image = MX25LM51245G_SIM_GetImage();
+  (void)memset(&image[BASE], 0x00, 2U * SUBSECTOR);
+  (void)memset(data, 0x96, sizeof(data));
+
+  /* Nothing to suspend or resume */
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_Suspend(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_Resume(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Ignored(), ignored + 2U);
+
+  /* Erase suspended after 100 ms: ESB set, WIP for the suspend latency */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE, MX25LM51245G_ERASE_4K), MX25LM51245G_OK);
+  start = MX25LM51245G_SIM_GetTime();
+  MX25LM51245G_SIM_Wait(100000U);
+  TEST_CHECK_EQ(MX25LM51245G_Suspend(&Ospi, SPI, STR), MX25LM51245G_OK);
+  suspended = MX25LM51245G_SIM_GetTime();
+  remaining = start + (MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME * 1000000ULL) - suspended;
+  TEST_CHECK_EQ(ReadSecr() & (MX25LM51245G_SECR_ESB | MX25LM51245G_SECR_PSB), MX25LM51245G_SECR_ESB);
+  TEST_CHECK_EQ(ReadSr() & MX25LM51245G_SR_WIP, MX25LM51245G_SR_WIP);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetTime(), suspended + (MX25LM51245G_SIM_SUSPEND_MAX_TIME * 1000U));
+  TEST_CHECK_EQ(ReadSr() & MX25LM51245G_SR_WIP, 0U);
+  TEST_CHECK_EQ(ReadSecr() & MX25LM51245G_SECR_ESB, MX25LM51245G_SECR_ESB);
+
+  /* Reads and programs of other blocks, not of the suspended one; no other erase */
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE + SUBSECTOR, 16U), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Buffer[0], 0x00U);
+  Program(BASE + (2U * SUBSECTOR), data, sizeof(data));
+  TEST_CHECK_EQ(CountBytes(BASE + (2U * SUBSECTOR), PAGE, 0x96U), PAGE);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE + PAGE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE + SUBSECTOR, MX25LM51245G_ERASE_4K),
+                MX25LM51245G_OK);
+  TEST_CHECK_EQ(Ignored(), ignored + 2U);
+  TEST_CHECK_EQ(MX25LM51245G_WriteDisable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(CountBytes(BASE, SUBSECTOR, 0x00U), SUBSECTOR);
+
+  /* Resume: ESB cleared, the erase ends after its remaining time plus the resume time */
+  TEST_CHECK_EQ(MX25LM51245G_Resume(&Ospi, SPI, STR), MX25LM51245G_OK);
+  resumed = MX25LM51245G_SIM_GetTime();
+  TEST_CHECK_EQ(ReadSecr() & MX25LM51245G_SECR_ESB, 0U);
+  TEST_CHECK_EQ(ReadSr() & MX25LM51245G_SR_WIP, MX25LM51245G_SR_WIP);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetTime(), resumed + remaining + (MX25LM51245G_SIM_RESUME_TIME * 1000U));
+  TEST_CHECK_EQ(CountBytes(BASE, SUBSECTOR, 0xFFU), SUBSECTOR);
+  TEST_CHECK_EQ(CountBytes(BASE + SUBSECTOR, SUBSECTOR, 0x00U), SUBSECTOR);
+
+  /* Program suspend: PSB, no program meanwhile */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_Suspend(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSecr() & (MX25LM51245G_SECR_ESB | MX25LM51245G_SECR_PSB), MX25LM51245G_SECR_PSB);
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE + (3U * SUBSECTOR), sizeof(data)),
+                MX25LM51245G_OK);
+  TEST_CHECK_EQ(Ignored(), ignored + 1U);
+  TEST_CHECK_EQ(MX25LM51245G_WriteDisable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(image[BASE], 0xFFU);
+  TEST_CHECK_EQ(MX25LM51245G_Resume(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(ReadSecr() & MX25LM51245G_SECR_PSB, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(CountBytes(BASE, PAGE, 0x96U), PAGE);
+  TEST_CHECK_EQ(CountBytes(BASE + (3U * SUBSECTOR), PAGE, 0xFFU), PAGE);
+
+  MX25LM51245G_SIM_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Suspends, 2U);
+  TEST_CHECK_EQ(stats.Resumes, 2U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Commands decoded only in the interface mode of the memory */
+static void TestModes(void)
+{
+  uint8_t  id[3];
+  uint8_t  reg[2];
+  uint8_t  data[4] = {0x11U, 0x22U, 0x33U, 0x44U};
+  uint32_t ignored;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+
+  /* SPI after power on */
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, OPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xFFU);
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, OPI, DTR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xFFU);
+  TEST_CHECK_EQ(Ignored(), ignored + 2U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, SPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+  TEST_CHECK_EQ(id[1], 0x85U);
+  TEST_CHECK_EQ(id[2], 0x3AU);
+
+  /* No SPI command in DTR, no OPI command with 3 address bytes */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, DTR), MX25LM51245G_ERROR);
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, OPI, MX25LM51245G_3BYTES_SIZE, Buffer, BASE, 4U), MX25LM51245G_ERROR);
+
+  /* STR OPI */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_WriteCfg2Register(&Ospi, SPI, STR, MX25LM51245G_CR2_REG1_ADDR, MX25LM51245G_CR2_SOPI),
+                MX25LM51245G_OK);
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, SPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xFFU);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, OPI, DTR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Ignored(), ignored + 2U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, OPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, OPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, OPI, ADDR4, data, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, OPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, OPI, ADDR4, Buffer, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK(memcmp(Buffer, data, sizeof(data)) == 0);
+
+  /* DTR OPI: registers and ID bytes output twice */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, OPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_WriteCfg2Register(&Ospi, OPI, STR, MX25LM51245G_CR2_REG1_ADDR, MX25LM51245G_CR2_DOPI),
+                MX25LM51245G_OK);
+  ignored = Ignored();
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, OPI, ADDR4, Buffer, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Buffer[0], 0xFFU);
+  TEST_CHECK_EQ(Ignored(), ignored + 1U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, OPI, DTR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+  TEST_CHECK_EQ(id[1], 0xC2U);
+  TEST_CHECK_EQ(id[2], 0x85U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadCfg2Register(&Ospi, OPI, DTR, MX25LM51245G_CR2_REG1_ADDR, reg), MX25LM51245G_OK);
+  TEST_CHECK_EQ(reg[0], MX25LM51245G_CR2_DOPI);
+  TEST_CHECK_EQ(reg[1], MX25LM51245G_CR2_DOPI);
+  TEST_CHECK_EQ(MX25LM51245G_ReadDTR(&Ospi, Buffer, BASE, sizeof(data)), MX25LM51245G_OK);
+  TEST_CHECK(memcmp(Buffer, data, sizeof(data)) == 0);
+
+  /* Power on in SPI, or in DTR OPI once selected in the configuration register 2 */
+  MX25LM51245G_SIM_PowerOn();
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, SPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_WriteCfg2Register(&Ospi, SPI, STR, MX25LM51245G_CR2_REG5_ADDR,
+                                               (uint8_t)~MX25LM51245G_CR2_DEFDOPI), MX25LM51245G_OK);
+  MX25LM51245G_SIM_PowerOn();
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, SPI, STR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xFFU);
+  TEST_CHECK_EQ(MX25LM51245G_ReadID(&Ospi, OPI, DTR, id), MX25LM51245G_OK);
+  TEST_CHECK_EQ(id[0], 0xC2U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Time to complete an operation started by the last command */
+static uint64_t OperationTime(void)
+{
+  uint64_t start = MX25LM51245G_SIM_GetTime();
+
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+
+  return MX25LM51245G_SIM_GetTime() - start;
+}
+
+/* Bus transfers at the bus clock, operations timed by the *_MAX_TIME constants */
+static void TestTiming(void)
+{
+  uint8_t  data[PAGE];
+  uint64_t start;
+  MX25LM51245G_SIM_Timing_t timing;
+  MX25LM51245G_SIM_Stats_t  stats;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  (void)memset(data, 0x00, sizeof(data));
+
+  MX25LM51245G_SIM_GetTiming(&timing);
+  TEST_CHECK_EQ(timing.BusClock, MX25LM51245G_SIM_BUS_CLOCK);
+  TEST_CHECK_EQ(timing.PageProgramTime, MX25LM51245G_SIM_PAGE_PROG_MAX_TIME);
+  TEST_CHECK_EQ(timing.SubsectorEraseTime, MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME * 1000U);
+  TEST_CHECK_EQ(timing.SectorEraseTime, MX25LM51245G_SECTOR_ERASE_MAX_TIME * 1000U);
+  TEST_CHECK_EQ(timing.ChipEraseTime, MX25LM51245G_BULK_ERASE_MAX_TIME * 1000U);
+  TEST_CHECK_EQ(timing.WriteRegTime, MX25LM51245G_WRITE_REG_MAX_TIME * 1000U);
+  TEST_CHECK_EQ(timing.SuspendTime, MX25LM51245G_SIM_SUSPEND_MAX_TIME);
+  TEST_CHECK_EQ(timing.ResumeTime, MX25LM51245G_SIM_RESUME_TIME);
+  TEST_CHECK_EQ(timing.ResetTime, MX25LM51245G_RESET_MAX_TIME * 1000U);
+
+  /* SPI read of a page: 8 + 32 + 8 dummy + 2048 data cycles at 40 MHz */
+  start = MX25LM51245G_SIM_GetTime();
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE, PAGE), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetTime() - start, 52400U);
+
+  /* Operations */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, PAGE), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_SIM_PAGE_PROG_MAX_TIME * 1000ULL);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE, MX25LM51245G_ERASE_4K), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME * 1000000ULL);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE, MX25LM51245G_ERASE_64K), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_SECTOR_ERASE_MAX_TIME * 1000000ULL);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ChipErase(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_BULK_ERASE_MAX_TIME * 1000000ULL);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_WriteStatusRegister(&Ospi, SPI, STR, 0U), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_WRITE_REG_MAX_TIME * 1000000ULL);
+  TEST_CHECK_EQ(MX25LM51245G_ResetEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ResetMemory(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), MX25LM51245G_RESET_MAX_TIME * 1000000ULL);
+
+  /* Time spent by the host during the program, a status read of 16 SPI
+     cycles, then the time left waited in the polling */
+  MX25LM51245G_SIM_ResetStats();
+  start = MX25LM51245G_SIM_GetTime();
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_PageProgram(&Ospi, SPI, ADDR4, data, BASE, PAGE), MX25LM51245G_OK);
+  MX25LM51245G_SIM_Wait(500U);
+  TEST_CHECK_EQ(ReadSr() & MX25LM51245G_SR_WIP, MX25LM51245G_SR_WIP);
+  TEST_CHECK_EQ(OperationTime(), ((MX25LM51245G_SIM_PAGE_PROG_MAX_TIME - 500U) * 1000ULL) - 400U);
+  MX25LM51245G_SIM_GetStats(&stats);
+  /* The polling command itself is in both the bus and the wait times */
+  TEST_CHECK_EQ(stats.Time - start, (stats.BusTime + stats.WaitTime + 500000U) - 400U);
+
+  /* Typical times */
+  timing.SubsectorEraseTime = 45000U;
+  MX25LM51245G_SIM_SetTiming(&timing);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE, MX25LM51245G_ERASE_4K), MX25LM51245G_OK);
+  TEST_CHECK_EQ(OperationTime(), 45000000U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Programs and erases interrupted by injected faults or a software reset */
+static void TestFaults(void)
+{
+  uint8_t  data[PAGE];
+  uint8_t  *image;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  image = MX25LM51245G_SIM_GetImage();
+  (void)memset(&image[BASE], 0x00, 4U * SUBSECTOR);
+  (void)memset(data, 0x00, sizeof(data));
+
+  /* Power lost halfway through the second erase */
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_POWER_LOSS, 2U), MX25LM51245G_OK);
+  Erase(BASE, MX25LM51245G_ERASE_4K);
+  TEST_CHECK_EQ(CountBytes(BASE, SUBSECTOR, 0xFFU), SUBSECTOR);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE + SUBSECTOR, MX25LM51245G_ERASE_4K),
+                MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_ERROR);
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE, 16U), MX25LM51245G_ERROR);
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_ERROR);
+  TEST_CHECK_EQ(CountBytes(BASE + SUBSECTOR, SUBSECTOR / 2U, 0xFFU), SUBSECTOR / 2U);
+  TEST_CHECK_EQ(CountBytes(BASE + SUBSECTOR + (SUBSECTOR / 2U), SUBSECTOR / 2U, 0x00U), SUBSECTOR / 2U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BASE + SUBSECTOR), 1U);
+  MX25LM51245G_SIM_PowerOn();
+  TEST_CHECK_EQ(ReadSr(), 0U);
+  TEST_CHECK_EQ(MX25LM51245G_ReadSTR(&Ospi, SPI, ADDR4, Buffer, BASE + SUBSECTOR, SUBSECTOR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(Buffer[(SUBSECTOR / 2U) - 1U], 0xFFU);
+  TEST_CHECK_EQ(Buffer[SUBSECTOR / 2U], 0x00U);
+
+  /* Erase failure: E_FAIL, half erased, cleared by the next operation */
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_FAIL, 1U), MX25LM51245G_OK);
+  Erase(BASE + (2U * SUBSECTOR), MX25LM51245G_ERASE_4K);
+  TEST_CHECK_EQ(ReadSecr() & (MX25LM51245G_SECR_E_FAIL | MX25LM51245G_SECR_P_FAIL), MX25LM51245G_SECR_E_FAIL);
+  TEST_CHECK_EQ(CountBytes(BASE + (2U * SUBSECTOR), SUBSECTOR, 0xFFU), SUBSECTOR / 2U);
+  Erase(BASE + (2U * SUBSECTOR), MX25LM51245G_ERASE_4K);
+  TEST_CHECK_EQ(ReadSecr() & MX25LM51245G_SECR_E_FAIL, 0U);
+  TEST_CHECK_EQ(CountBytes(BASE + (2U * SUBSECTOR), SUBSECTOR, 0xFFU), SUBSECTOR);
+
+  /* Program failure: P_FAIL, half the page programmed */
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_FAIL, 1U), MX25LM51245G_OK);
+  Program(BASE, data, sizeof(data));
+  TEST_CHECK_EQ(ReadSecr() & (MX25LM51245G_SECR_E_FAIL | MX25LM51245G_SECR_P_FAIL), MX25LM51245G_SECR_P_FAIL);
+  TEST_CHECK_EQ(CountBytes(BASE, PAGE, 0x00U), PAGE / 2U);
+
+  /* Fault cancelled */
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_POWER_LOSS, 1U), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_NONE, 1U), MX25LM51245G_OK);
+  Program(BASE, data, sizeof(data));
+  TEST_CHECK_EQ(CountBytes(BASE, PAGE, 0x00U), PAGE);
+
+  /* Software reset a quarter through an erase: a quarter erased */
+  TEST_CHECK_EQ(MX25LM51245G_WriteEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_BlockErase(&Ospi, SPI, STR, ADDR4, BASE + (3U * SUBSECTOR), MX25LM51245G_ERASE_4K),
+                MX25LM51245G_OK);
+  MX25LM51245G_SIM_Wait(MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME * 1000U / 4U);
+  TEST_CHECK_EQ(MX25LM51245G_ResetEnable(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_ResetMemory(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, SPI, STR), MX25LM51245G_OK);
+  TEST_CHECK_EQ(CountBytes(BASE + (3U * SUBSECTOR), SUBSECTOR / 4U, 0xFFU), SUBSECTOR / 4U);
+  TEST_CHECK_EQ(CountBytes(BASE + (3U * SUBSECTOR) + (SUBSECTOR / 4U), (3U * SUBSECTOR) / 4U, 0x00U),
+                (3U * SUBSECTOR) / 4U);
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault((MX25LM51245G_SIM_Fault_t)3, 1U), MX25LM51245G_ERROR);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+int main(void)
+{
+  TestWriteEnable();
+  TestPageWrap();
+  TestErase();
+  TestSuspend();
+  TestModes();
+  TestTiming();
+  TestFaults();
+
+  return TEST_RESULT("test_mx25lm51245g_sim");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
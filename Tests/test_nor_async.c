@@ -0,0 +1,508 @@
+/**
+  ******************************************************************************
+  * @file    test_nor_async.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_nor_async.c write queue over the
+  *          MX25LM51245G component functions and its simulated memory, in DTR
+  *          OPI mode, with an engine doing what BSP_OSPI_NOR_Write_IT(),
+  *          BSP_OSPI_NOR_SuspendWrite() and BSP_OSPI_NOR_ResumeWrite() do. The
+  *          OCTOSPI1 status match interrupt is raised from the Idle hook and
+  *          on unmasking, when MX25LM51245G_SIM_StatusMatch() reports the
+  *          memory ready. Checks the fence ordering and the completion
+  *          callbacks, reads merging the queued writes, the
+  *          UTIL_NOR_ASYNC_MAX_SUSPENDS bound and the jobs failed by the OSPI
+  *          error callback.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_nor_async.h"
+#include "mx25lm51245g_sim.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BASE            0x00200000U  /* Test area address                */
+#define AREA            4096U        /* Test area size                   */
+#define IDLE_TIME       10U          /* us of simulated time per Idle    */
+#define MAX_JOBS        32U
+#define FLASH_OK        0            /* BSP_ERROR_NONE                   */
+#define FLASH_ERROR     (-5)         /* BSP_ERROR_COMPONENT_FAILURE      */
+#define FLASH_PARAM     (-2)         /* BSP_ERROR_WRONG_PARAM            */
+#define FLASH_SUSPENDED (-20)        /* BSP_ERROR_OSPI_SUSPENDED         */
+#define MODE            MX25LM51245G_OPI_MODE
+#define RATE            MX25LM51245G_DTR_TRANSFER
+
+/* Private types -------------------------------------------------------------*/
+/* Write job, passed as context of its completion callback */
+typedef struct
+{
+  uint32_t Address;
+  uint8_t  Data[3U * MX25LM51245G_PAGE_SIZE];
+  uint32_t Size;
+  uint32_t Chain;     /* Queue one more job from the callback */
+} Job_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static OSPI_HandleTypeDef Ospi;
+static uint32_t           Locked;         /* Interrupt masked by the Lock hook  */
+static uint32_t           LockedIdles;    /* Idle calls with the interrupt masked */
+static Job_t              Jobs[MAX_JOBS];
+static Job_t              Chained;
+static uint32_t           Calls;          /* Completion callbacks               */
+static uint32_t           CallFence[MAX_JOBS];
+static int32_t            CallStatus[MAX_JOBS];
+static uint32_t           CallContent;    /* Callbacks of jobs found programmed */
+static uint32_t           CallComplete;   /* Callbacks of jobs found complete   */
+static uint8_t            Expected[AREA];
+static uint8_t            Buffer[AREA];
+
+/* Private function prototypes -----------------------------------------------*/
+static void Interrupt(void);
+
+/* Private functions ---------------------------------------------------------*/
+/* Engine as BSP_OSPI_NOR_xxx() runs it on the component. HAL_OSPI_Abort() is
+   MX25LM51245G_SIM_Abort(). */
+static int32_t NorRead(uint32_t Instance, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  (void)Instance;
+  return (MX25LM51245G_ReadDTR(&Ospi, pData, ReadAddr, Size) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t NorWriteIT(uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size)
+{
+  int32_t ret = FLASH_OK;
+
+  (void)Instance;
+  if ((Size == 0U) || (((WriteAddr % MX25LM51245G_PAGE_SIZE) + Size) > MX25LM51245G_PAGE_SIZE))
+  {
+    ret = FLASH_PARAM;
+  }
+  else if ((MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+           (MX25LM51245G_PageProgramDTR(&Ospi, pData, WriteAddr, Size) != MX25LM51245G_OK) ||
+           (MX25LM51245G_AutoPollingMemReady_IT(&Ospi, MODE, RATE) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    /* Programming */
+  }
+
+  return ret;
+}
+
+static int32_t NorGetStatus(void)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  if (MX25LM51245G_ReadSecurityRegister(&Ospi, MODE, RATE, reg) != MX25LM51245G_OK)
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & (MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL)) != 0U)
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & (MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB)) != 0U)
+  {
+    ret = FLASH_SUSPENDED;
+  }
+  else
+  {
+    /* The busy state is not needed here */
+  }
+
+  return ret;
+}
+
+static int32_t NorSuspendWrite(uint32_t Instance)
+{
+  (void)Instance;
+  MX25LM51245G_SIM_Abort();
+  return ((MX25LM51245G_Suspend(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) == MX25LM51245G_OK)) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t NorResumeWrite(uint32_t Instance)
+{
+  int32_t ret;
+
+  (void)Instance;
+  ret = NorGetStatus();
+  if (ret == FLASH_SUSPENDED)
+  {
+    ret = (MX25LM51245G_Resume(&Ospi, MODE, RATE) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+  }
+  if ((ret == FLASH_OK) && (MX25LM51245G_AutoPollingMemReady_IT(&Ospi, MODE, RATE) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+
+  return ret;
+}
+
+static void NorLock(uint32_t Instance)
+{
+  (void)Instance;
+  Locked = 1U;
+}
+
+/* A status match pending while masked fires on unmasking */
+static void NorUnlock(uint32_t Instance)
+{
+  (void)Instance;
+  Locked = 0U;
+  Interrupt();
+}
+
+static void NorIdle(uint32_t Instance)
+{
+  (void)Instance;
+  LockedIdles += Locked;
+  MX25LM51245G_SIM_Wait(IDLE_TIME);
+  Interrupt();
+}
+
+static const UTIL_NOR_ASYNC_Engine_t Engine =
+{
+  NorRead,
+  NorWriteIT,
+  NorSuspendWrite,
+  NorResumeWrite,
+  NorLock,
+  NorUnlock,
+  NorIdle
+};
+
+/* OCTOSPI1 interrupt: the status match reaches BSP_OSPI_NOR_WriteCpltCallback() */
+static void Interrupt(void)
+{
+  if ((Locked == 0U) && (MX25LM51245G_SIM_StatusMatch() != 0U))
+  {
+    UTIL_NOR_ASYNC_WriteCplt();
+  }
+}
+
+/* Completion callback: jobs complete in fence order, programmed */
+static void Callback(uint32_t Fence, int32_t Status, void *pContext)
+{
+  const Job_t   *job   = (const Job_t *)pContext;
+  const uint8_t *image = MX25LM51245G_SIM_GetImage();
+  uint32_t       i, same = 1U;
+
+  if (Calls < MAX_JOBS)
+  {
+    CallFence[Calls]  = Fence;
+    CallStatus[Calls] = Status;
+  }
+  Calls++;
+
+  for (i = 0U; i < job->Size; i++)
+  {
+    same &= ((image[job->Address + i] & job->Data[i]) == image[job->Address + i]) ? 1U : 0U;
+  }
+  CallContent  += same;
+  CallComplete += ((UTIL_NOR_ASYNC_IsComplete(Fence) != 0U) && (UTIL_NOR_ASYNC_IsComplete(Fence + 1U) == 0U)) ? 1U : 0U;
+
+  if (job->Chain != 0U)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ASYNC_Write(Chained.Address, Chained.Data, Chained.Size, Callback, &Chained, NULL),
+                  UTIL_NOR_ASYNC_OK);
+  }
+}
+
+/* Switch the memory from SPI to DTR OPI mode, as OSPI_NOR_EnterDOPIMode() */
+static int32_t EnterDOPIMode(void)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  if ((MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG3_ADDR,
+                                      MX25LM51245G_CR2_DC_6_CYCLES) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG1_ADDR,
+                                      MX25LM51245G_CR2_DOPI) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    MX25LM51245G_SIM_Wait(MX25LM51245G_WRITE_REG_MAX_TIME * 1000U);
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_ReadCfg2Register(&Ospi, MODE, RATE, MX25LM51245G_CR2_REG1_ADDR, reg) != MX25LM51245G_OK) ||
+        (reg[0] != MX25LM51245G_CR2_DOPI))
+    {
+      ret = FLASH_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+static void Setup(void)
+{
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  TEST_CHECK_EQ(EnterDOPIMode(), FLASH_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Init(0U, &Engine), UTIL_NOR_ASYNC_OK);
+  MX25LM51245G_SIM_ResetStats();
+  (void)memset(Jobs, 0, sizeof(Jobs));
+  (void)memset(&Chained, 0, sizeof(Chained));
+  (void)memset(Expected, 0xFF, sizeof(Expected));
+  Locked       = 0U;
+  LockedIdles  = 0U;
+  Calls        = 0U;
+  CallContent  = 0U;
+  CallComplete = 0U;
+}
+
+/* Prepare a job of the test area, and the content expected after it */
+static Job_t *MakeJob(Job_t *pJob, uint32_t Offset, uint32_t Size, uint8_t Seed)
+{
+  uint32_t i;
+
+  pJob->Address = BASE + Offset;
+  pJob->Size    = Size;
+  pJob->Chain   = 0U;
+  for (i = 0U; i < Size; i++)
+  {
+    pJob->Data[i]         = (uint8_t)(Seed + (i * 29U));
+    Expected[Offset + i] &= pJob->Data[i];
+  }
+
+  return pJob;
+}
+
+static int32_t Queue(Job_t *pJob, uint32_t *pFence)
+{
+  return UTIL_NOR_ASYNC_Write(pJob->Address, pJob->Data, pJob->Size, Callback, pJob, pFence);
+}
+
+static uint32_t AreaMatches(void)
+{
+  return (memcmp(&MX25LM51245G_SIM_GetImage()[BASE], Expected, AREA) == 0) ? 1U : 0U;
+}
+
+/* Jobs of one byte to three pages, unaligned: fences increase, waits return
+   in order and callbacks come in fence order, each job programmed */
+static void TestFences(void)
+{
+  static const uint32_t offsets[] = {0U, 300U, 1024U, 1500U, 3000U};
+  static const uint32_t sizes[]   = {1U, 500U, 256U, 768U, 10U};
+  static const uint32_t pages[]   = {1U, 3U, 1U, 4U, 1U};
+  uint32_t fence[5], i, bytes = 0U, count = 0U;
+  UTIL_NOR_ASYNC_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup();
+  for (i = 0U; i < 5U; i++)
+  {
+    TEST_CHECK_EQ(Queue(MakeJob(&Jobs[i], offsets[i], sizes[i], (uint8_t)(i * 17U)), &fence[i]), UTIL_NOR_ASYNC_OK);
+    TEST_CHECK_EQ(fence[i], i + 1U);
+    bytes += sizes[i];
+    count += pages[i];
+  }
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_IsComplete(fence[0]), 0U);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Wait(fence[4] + 1U), UTIL_NOR_ASYNC_ERROR);
+
+  /* The wait returns with the earlier jobs done, before the next multi page job */
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Wait(fence[2]), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_IsComplete(fence[0]) + UTIL_NOR_ASYNC_IsComplete(fence[1]), 2U);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_IsComplete(fence[3]), 0U);
+  TEST_CHECK_EQ(Calls, 3U);
+
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_WaitAll(), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Calls, 5U);
+  for (i = 0U; i < 5U; i++)
+  {
+    TEST_CHECK_EQ(CallFence[i], fence[i]);
+    TEST_CHECK_EQ(CallStatus[i], UTIL_NOR_ASYNC_OK);
+  }
+  TEST_CHECK_EQ(CallContent, 5U);
+  TEST_CHECK_EQ(CallComplete, 5U);
+  TEST_CHECK_EQ(AreaMatches(), 1U);
+
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.JobCount, 5U);
+  TEST_CHECK_EQ(stats.PageCount, count);
+  TEST_CHECK_EQ(stats.ByteCount, bytes);
+  TEST_CHECK_EQ(stats.ErrorCount, 0U);
+  TEST_CHECK_EQ(sim.Programs, count);
+  TEST_CHECK_EQ(sim.ProgramBytes, bytes);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(LockedIdles, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* A full queue rejects the next job, a callback can queue one */
+static void TestQueueFull(void)
+{
+  uint32_t i, fence;
+
+  Setup();
+  for (i = 0U; i < UTIL_NOR_ASYNC_QUEUE_SIZE; i++)
+  {
+    TEST_CHECK_EQ(Queue(MakeJob(&Jobs[i], i * 16U, 16U, (uint8_t)i), &fence), UTIL_NOR_ASYNC_OK);
+  }
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[i], 2048U, 16U, 0x55U), &fence), UTIL_NOR_ASYNC_BUSY);
+  TEST_CHECK_EQ(fence, UTIL_NOR_ASYNC_QUEUE_SIZE);
+
+  /* The rejected job is not written: only the chained one lands there */
+  (void)memset(&Expected[2048], 0xFF, 16U);
+  Jobs[UTIL_NOR_ASYNC_QUEUE_SIZE - 1U].Chain = 1U;
+  (void)MakeJob(&Chained, 2048U, 16U, 0xA5U);
+
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_WaitAll(), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_WaitAll(), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Calls, UTIL_NOR_ASYNC_QUEUE_SIZE + 1U);
+  TEST_CHECK_EQ(CallFence[UTIL_NOR_ASYNC_QUEUE_SIZE], UTIL_NOR_ASYNC_QUEUE_SIZE + 1U);
+  TEST_CHECK_EQ(CallContent, UTIL_NOR_ASYNC_QUEUE_SIZE + 1U);
+  TEST_CHECK_EQ(AreaMatches(), 1U);
+  TEST_CHECK_EQ(LockedIdles, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Reads return what the memory will hold: the queued data, overlapping jobs
+   ANDed, merged in what is programmed so far */
+static void TestMerge(void)
+{
+  uint32_t fence, reads = 0U, bad = 0U;
+  UTIL_NOR_ASYNC_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup();
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[0], 100U, 600U, 0x3CU), NULL), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[1], 400U, 200U, 0xC3U), NULL), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[2], 3000U, 100U, 0x81U), &fence), UTIL_NOR_ASYNC_OK);
+
+  /* Nothing programmed yet: the data come from the queue */
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Read(BASE, Buffer, AREA), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK(memcmp(Buffer, Expected, AREA) == 0);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetImage()[BASE + 100U], 0xFFU);
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.MergeCount, 1U);
+  TEST_CHECK_EQ(stats.SuspendCount, 1U);
+
+  /* No queued data in the range */
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Read(BASE + 3500U, Buffer, 500U), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK(memcmp(Buffer, &Expected[3500], 500U) == 0);
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.MergeCount, 1U);
+
+  /* Same result at every step of the programming */
+  while (UTIL_NOR_ASYNC_IsComplete(fence) == 0U)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ASYNC_Read(BASE, Buffer, AREA), UTIL_NOR_ASYNC_OK);
+    bad += (memcmp(Buffer, Expected, AREA) != 0) ? 1U : 0U;
+    reads++;
+    NorIdle(0U);
+  }
+  TEST_CHECK_EQ(bad, 0U);
+  TEST_CHECK(reads > 1U);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_WaitAll(), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(AreaMatches(), 1U);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Read(BASE, Buffer, AREA), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK(memcmp(Buffer, Expected, AREA) == 0);
+
+  /* Each suspend is resumed, the memory sees every command */
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.ReadCount, reads + 3U);
+  /* The last read may wait for the end of the writes, without merging */
+  TEST_CHECK((stats.MergeCount == reads) || (stats.MergeCount == (reads + 1U)));
+  TEST_CHECK_EQ(sim.Suspends, stats.SuspendCount);
+  TEST_CHECK_EQ(sim.Resumes, stats.SuspendCount);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(Calls, 3U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Back to back reads suspend each page program UTIL_NOR_ASYNC_MAX_SUSPENDS
+   times, then wait for its end: the job completes without waiting for it */
+static void TestMaxSuspends(void)
+{
+  uint32_t fence, n, bad = 0U;
+  UTIL_NOR_ASYNC_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup();
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[0], 0U, 2U * MX25LM51245G_PAGE_SIZE, 0x42U), &fence), UTIL_NOR_ASYNC_OK);
+  for (n = 0U; n < (3U * UTIL_NOR_ASYNC_MAX_SUSPENDS); n++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ASYNC_Read(BASE, Buffer, 2U * MX25LM51245G_PAGE_SIZE), UTIL_NOR_ASYNC_OK);
+    bad += (memcmp(Buffer, Expected, 2U * MX25LM51245G_PAGE_SIZE) != 0) ? 1U : 0U;
+  }
+  TEST_CHECK_EQ(bad, 0U);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_IsComplete(fence), 1U);
+  TEST_CHECK_EQ(Calls, 1U);
+  TEST_CHECK_EQ(AreaMatches(), 1U);
+
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.SuspendCount, 2U * UTIL_NOR_ASYNC_MAX_SUSPENDS);
+  TEST_CHECK_EQ(stats.WaitCount, 2U);
+  TEST_CHECK_EQ(sim.Suspends, 2U * UTIL_NOR_ASYNC_MAX_SUSPENDS);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(LockedIdles, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* An OSPI error completes the running job with an error, reported once by the
+   wait, and the next job runs */
+static void TestError(void)
+{
+  uint32_t fence[2];
+  UTIL_NOR_ASYNC_Stats_t stats;
+
+  Setup();
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[0], 0U, 16U, 0x11U), &fence[0]), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Queue(MakeJob(&Jobs[1], 512U, 16U, 0x22U), &fence[1]), UTIL_NOR_ASYNC_OK);
+
+  /* The HAL aborts the polling, then BSP_OSPI_NOR_ErrorCallback() */
+  MX25LM51245G_SIM_Abort();
+  TEST_CHECK_EQ(MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE), MX25LM51245G_OK);
+  UTIL_NOR_ASYNC_WriteError();
+  TEST_CHECK_EQ(Calls, 1U);
+  TEST_CHECK_EQ(CallFence[0], fence[0]);
+  TEST_CHECK_EQ(CallStatus[0], UTIL_NOR_ASYNC_ERROR);
+
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Wait(fence[0]), UTIL_NOR_ASYNC_ERROR);
+  TEST_CHECK_EQ(UTIL_NOR_ASYNC_Wait(fence[1]), UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(Calls, 2U);
+  TEST_CHECK_EQ(CallStatus[1], UTIL_NOR_ASYNC_OK);
+  TEST_CHECK_EQ(CallContent, 2U);
+
+  UTIL_NOR_ASYNC_GetStats(&stats);
+  TEST_CHECK_EQ(stats.JobCount, 2U);
+  TEST_CHECK_EQ(stats.ErrorCount, 1U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+int main(void)
+{
+  TestFences();
+  TestQueueFull();
+  TestMerge();
+  TestMaxSuspends();
+  TestError();
+
+  return TEST_RESULT("test_nor_async");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
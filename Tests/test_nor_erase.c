@@ -0,0 +1,529 @@
+/**
+  ******************************************************************************
+  * @file    test_nor_erase.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_nor_erase.c erase scheduler over the
+  *          MX25LM51245G component functions and its simulated memory, in DTR
+  *          OPI mode, with flash services doing what BSP_OSPI_NOR_Read(),
+  *          BSP_OSPI_NOR_Write(), BSP_OSPI_NOR_Erase_Block(),
+  *          BSP_OSPI_NOR_GetStatus(), BSP_OSPI_NOR_SuspendErase() and
+  *          BSP_OSPI_NOR_ResumeErase() do. The mutex, delay and tick hooks are
+  *          stubs on the simulated time. Checks the pool depth and its
+  *          low-water mark, the reads and writes suspending an erase, the
+  *          choice between 4K and 64K erases, the failed erases and the
+  *          stalled allocations.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_nor_erase.h"
+#include "mx25lm51245g_sim.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define AREA_ADDR       0x00400000U  /* Managed area, on a 64K sector       */
+#define BLOCKS          32U          /* Two 64K sectors                     */
+#define SECTOR_BLOCKS   (UTIL_NOR_ERASE_SECTOR_SIZE / UTIL_NOR_ERASE_BLOCK_SIZE)
+#define FLASH_OK        0            /* BSP_ERROR_NONE                      */
+#define FLASH_ERROR     (-5)         /* BSP_ERROR_COMPONENT_FAILURE         */
+#define FLASH_SUSPENDED (-20)        /* BSP_ERROR_OSPI_SUSPENDED            */
+#define MODE            MX25LM51245G_OPI_MODE
+#define RATE            MX25LM51245G_DTR_TRANSFER
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static OSPI_HandleTypeDef    Ospi;
+static uint8_t               States[BLOCKS];
+static uint32_t              Locked;       /* Mutex owned                        */
+static uint32_t              LockErrors;   /* Mutex taken twice, sleeps owning it */
+static uint32_t              Delays;       /* Delay calls                        */
+static UTIL_NOR_ERASE_Init_t Init;
+static uint8_t               Data[UTIL_NOR_ERASE_BLOCK_SIZE];
+static uint8_t               Buffer[UTIL_NOR_ERASE_BLOCK_SIZE];
+
+/* Private functions ---------------------------------------------------------*/
+/* Flash services as BSP_OSPI_NOR_xxx() runs them on the component */
+static int32_t FlashRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return (MX25LM51245G_ReadDTR(&Ospi, pData, Address, Size) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashWrite(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t  ret = FLASH_OK;
+  uint32_t size;
+
+  (void)Instance;
+  while ((Size != 0U) && (ret == FLASH_OK))
+  {
+    size = MX25LM51245G_PAGE_SIZE - (Address % MX25LM51245G_PAGE_SIZE);
+    size = (size > Size) ? Size : size;
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_PageProgramDTR(&Ospi, pData, Address, size) != MX25LM51245G_OK) ||
+        (MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK))
+    {
+      ret = FLASH_ERROR;
+    }
+    Address += size;
+    pData   += size;
+    Size    -= size;
+  }
+
+  return ret;
+}
+
+/* The wrapper of the utility notes over BSP_OSPI_NOR_Erase_Block() */
+static int32_t FlashErase(uint32_t Instance, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_BlockErase(&Ospi, MODE, RATE, MX25LM51245G_4BYTES_SIZE, Address,
+                                   (Size == UTIL_NOR_ERASE_SECTOR_SIZE) ? MX25LM51245G_ERASE_64K
+                                   : MX25LM51245G_ERASE_4K) == MX25LM51245G_OK)) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashGetStatus(uint32_t Instance)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  (void)Instance;
+  if (MX25LM51245G_ReadSecurityRegister(&Ospi, MODE, RATE, reg) != MX25LM51245G_OK)
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & (MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL)) != 0U)
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & (MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB)) != 0U)
+  {
+    ret = FLASH_SUSPENDED;
+  }
+  else if (MX25LM51245G_ReadStatusRegister(&Ospi, MODE, RATE, reg) != MX25LM51245G_OK)
+  {
+    ret = FLASH_ERROR;
+  }
+  else if ((reg[0] & MX25LM51245G_SR_WIP) != 0U)
+  {
+    ret = UTIL_NOR_ERASE_FLASH_BUSY;
+  }
+  else
+  {
+    /* Ready */
+  }
+
+  return ret;
+}
+
+static int32_t FlashSuspend(uint32_t Instance)
+{
+  return ((FlashGetStatus(Instance) == UTIL_NOR_ERASE_FLASH_BUSY) &&
+          (MX25LM51245G_Suspend(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (FlashGetStatus(Instance) == FLASH_SUSPENDED)) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashResume(uint32_t Instance)
+{
+  return ((FlashGetStatus(Instance) == FLASH_SUSPENDED) &&
+          (MX25LM51245G_Resume(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (FlashGetStatus(Instance) == UTIL_NOR_ERASE_FLASH_BUSY)) ? FLASH_OK : FLASH_ERROR;
+}
+
+/* Mutex, osDelay() and tick stubs: the delay runs the simulated time */
+static void Lock(uint32_t Instance)
+{
+  (void)Instance;
+  LockErrors += Locked;
+  Locked = 1U;
+}
+
+static void Unlock(uint32_t Instance)
+{
+  (void)Instance;
+  LockErrors += 1U - Locked;
+  Locked = 0U;
+}
+
+static void Delay(uint32_t Delay)
+{
+  LockErrors += Locked;
+  Delays++;
+  MX25LM51245G_SIM_Wait(Delay * 1000U);
+}
+
+static uint32_t GetTick(void)
+{
+  return (uint32_t)(MX25LM51245G_SIM_GetTime() / 1000000U);
+}
+
+static const UTIL_NOR_ERASE_Flash_t Flash =
+{
+  FlashRead,
+  FlashWrite,
+  FlashErase,
+  FlashGetStatus,
+  FlashSuspend,
+  FlashResume,
+  Lock,
+  Unlock,
+  Delay,
+  GetTick
+};
+
+/* Switch the memory from SPI to DTR OPI mode, as OSPI_NOR_EnterDOPIMode() */
+static int32_t EnterDOPIMode(void)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  if ((MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG3_ADDR,
+                                      MX25LM51245G_CR2_DC_6_CYCLES) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG1_ADDR,
+                                      MX25LM51245G_CR2_DOPI) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    MX25LM51245G_SIM_Wait(MX25LM51245G_WRITE_REG_MAX_TIME * 1000U);
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_ReadCfg2Register(&Ospi, MODE, RATE, MX25LM51245G_CR2_REG1_ADDR, reg) != MX25LM51245G_OK) ||
+        (reg[0] != MX25LM51245G_CR2_DOPI))
+    {
+      ret = FLASH_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+static uint32_t BlockAddress(uint32_t Block)
+{
+  return AREA_ADDR + (Block * UTIL_NOR_ERASE_BLOCK_SIZE);
+}
+
+/* Bytes of a block which differ from a value, in the memory image */
+static uint32_t CountNot(uint32_t Block, uint8_t Value)
+{
+  const uint8_t *image = &MX25LM51245G_SIM_GetImage()[BlockAddress(Block)];
+  uint32_t       i, count = 0U;
+
+  for (i = 0U; i < UTIL_NOR_ERASE_BLOCK_SIZE; i++)
+  {
+    count += (image[i] != Value) ? 1U : 0U;
+  }
+
+  return count;
+}
+
+/* Fill the whole area with data, then hand it to the scheduler: all used */
+static void Setup(uint32_t PoolDepth)
+{
+  uint32_t block;
+
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  TEST_CHECK_EQ(EnterDOPIMode(), FLASH_OK);
+  (void)memset(Data, 0x00, sizeof(Data));
+  for (block = 0U; block < BLOCKS; block++)
+  {
+    TEST_CHECK_EQ(FlashWrite(0U, Data, BlockAddress(block), UTIL_NOR_ERASE_BLOCK_SIZE), FLASH_OK);
+  }
+
+  Init.pFlash     = &Flash;
+  Init.Instance   = 0U;
+  Init.Address    = AREA_ADDR;
+  Init.BlockCount = BLOCKS;
+  Init.PoolDepth  = PoolDepth;
+  Init.pStates    = States;
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Init(&Init), UTIL_NOR_ERASE_OK);
+  MX25LM51245G_SIM_ResetStats();
+  Locked     = 0U;
+  LockErrors = 0U;
+  Delays     = 0U;
+}
+
+/* The erase thread body, until there is nothing to erase */
+static void RunErases(void)
+{
+  while (UTIL_NOR_ERASE_Process() == UTIL_NOR_ERASE_OK)
+  {
+    Delay(UTIL_NOR_ERASE_POLL_PERIOD);
+  }
+}
+
+/* The pool is filled up to its depth, allocations lower the low-water mark
+   and return erased blocks; an empty pool stalls the allocation on a 4K
+   erase */
+static void TestPool(void)
+{
+  uint32_t block, address[5], i, tick;
+  UTIL_NOR_ERASE_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup(4U);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Process(), UTIL_NOR_ERASE_IDLE);
+  for (block = 0U; block < BLOCKS; block += 3U)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(block), UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  }
+  RunErases();
+
+  /* 11 blocks released, 4 erased */
+  UTIL_NOR_ERASE_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.PoolDepth, 4U);
+  TEST_CHECK_EQ(stats.DirtyBlocks, 7U);
+  TEST_CHECK_EQ(stats.Erases4K, 4U);
+  TEST_CHECK_EQ(stats.Erases64K, 0U);
+  TEST_CHECK_EQ(stats.MinPoolDepth, 0U);
+  TEST_CHECK_EQ(sim.Erases4K, 4U);
+  TEST_CHECK(stats.EraseTime >= (4U * MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME));
+
+  /* Allocations from the pool, without erase */
+  UTIL_NOR_ERASE_ResetStats();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.MinPoolDepth, 4U);
+  for (i = 0U; i < 3U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[i]), UTIL_NOR_ERASE_OK);
+    TEST_CHECK_EQ(CountNot((address[i] - AREA_ADDR) / UTIL_NOR_ERASE_BLOCK_SIZE, 0xFFU), 0U);
+  }
+  TEST_CHECK((address[0] != address[1]) && (address[1] != address[2]) && (address[0] != address[2]));
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.PoolDepth, 1U);
+  TEST_CHECK_EQ(stats.MinPoolDepth, 1U);
+  TEST_CHECK_EQ(stats.Allocs, 3U);
+  TEST_CHECK_EQ(stats.Stalls, 0U);
+
+  /* Refilled, the low-water mark stays */
+  RunErases();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.PoolDepth, 4U);
+  TEST_CHECK_EQ(stats.MinPoolDepth, 1U);
+  TEST_CHECK_EQ(stats.DirtyBlocks, 4U);
+
+  /* Empty the pool, then stall on an erase */
+  for (i = 0U; i < 4U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[i]), UTIL_NOR_ERASE_OK);
+  }
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.MinPoolDepth, 0U);
+  TEST_CHECK_EQ(stats.Stalls, 0U);
+  tick = GetTick();
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[4]), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(CountNot((address[4] - AREA_ADDR) / UTIL_NOR_ERASE_BLOCK_SIZE, 0xFFU), 0U);
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Stalls, 1U);
+  TEST_CHECK_EQ(stats.Erases4K, 4U);
+  TEST_CHECK(stats.StallTime >= MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME);
+  TEST_CHECK(stats.StallTime <= (GetTick() - tick));
+  TEST_CHECK_EQ(stats.MaxStallTime, stats.StallTime);
+  TEST_CHECK_EQ(stats.DirtyBlocks, 3U);
+  TEST_CHECK(Delays > 0U);
+
+  /* Nothing left to erase: allocations fail */
+  for (i = 0U; i < 3U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[i]), UTIL_NOR_ERASE_OK);
+  }
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[0]), UTIL_NOR_ERASE_ERROR);
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Stalls, 5U);
+  TEST_CHECK_EQ(stats.Allocs, 11U);
+
+  /* A stall erases 4K even when a whole sector is released */
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS), UTIL_NOR_ERASE_SECTOR_SIZE), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address[0]), UTIL_NOR_ERASE_OK);
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Stalls, 6U);
+  TEST_CHECK_EQ(stats.Erases4K, 8U);
+  TEST_CHECK_EQ(stats.Erases64K, 0U);
+  TEST_CHECK(stats.MaxStallTime < MX25LM51245G_SECTOR_ERASE_MAX_TIME);
+
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(Locked + LockErrors, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* A sector with no used block is erased at once when its released blocks
+   take longer to erase one by one */
+static void TestGranularity(void)
+{
+  uint32_t block, address, i;
+  UTIL_NOR_ERASE_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup(0U);
+
+  /* A whole sector released, and 3 blocks of a sector with used blocks */
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS), UTIL_NOR_ERASE_SECTOR_SIZE), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(4U), 3U * UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  RunErases();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Erases64K, 1U);
+  TEST_CHECK_EQ(stats.Erases4K, 3U);
+  TEST_CHECK_EQ(stats.PoolDepth, SECTOR_BLOCKS + 3U);
+  TEST_CHECK_EQ(stats.DirtyBlocks, 0U);
+  for (block = 0U; block < BLOCKS; block++)
+  {
+    TEST_CHECK_EQ(CountNot(block, (((block >= 4U) && (block < 7U)) || (block >= SECTOR_BLOCKS)) ? 0xFFU : 0x00U), 0U);
+  }
+
+  /* 2 blocks released in an erased sector: 2 4K erases are shorter */
+  for (i = 0U; i < (3U + 2U); i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address), UTIL_NOR_ERASE_OK);
+  }
+  TEST_CHECK_EQ(address, BlockAddress(SECTOR_BLOCKS + 1U));
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS), 2U * UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  RunErases();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  TEST_CHECK_EQ(stats.Erases64K, 1U);
+  TEST_CHECK_EQ(stats.Erases4K, 5U);
+
+  /* 3 blocks released: one 64K erase is shorter */
+  for (i = 0U; i < 3U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address), UTIL_NOR_ERASE_OK);
+  }
+  TEST_CHECK_EQ(address, BlockAddress(SECTOR_BLOCKS + 4U));
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS + 2U), 3U * UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  RunErases();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.Erases64K, 2U);
+  TEST_CHECK_EQ(stats.Erases4K, 5U);
+  TEST_CHECK_EQ(stats.PoolDepth, SECTOR_BLOCKS);
+  TEST_CHECK_EQ(sim.Erases64K, stats.Erases64K);
+  TEST_CHECK_EQ(sim.Erases4K, stats.Erases4K);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BlockAddress(SECTOR_BLOCKS)), 3U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BlockAddress(SECTOR_BLOCKS + 2U)), 2U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(BlockAddress(0U)), 0U);
+
+  /* A failed erase leaves a bad block: its sector is then erased by 4K */
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(address, BlockAddress(SECTOR_BLOCKS + 5U));
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(address, UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_FAIL, 1U), MX25LM51245G_OK);
+  RunErases();
+  TEST_CHECK_EQ(States[SECTOR_BLOCKS + 5U], UTIL_NOR_ERASE_BAD);
+  for (i = 0U; i < 3U; i++)
+  {
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address), UTIL_NOR_ERASE_OK);
+  }
+  TEST_CHECK_EQ(address, BlockAddress(SECTOR_BLOCKS + 8U));
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS + 6U), 3U * UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  RunErases();
+  UTIL_NOR_ERASE_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.EraseErrors, 1U);
+  TEST_CHECK_EQ(stats.Erases64K, 2U);
+  TEST_CHECK_EQ(stats.Erases4K, 9U);
+  TEST_CHECK_EQ(stats.PoolDepth, SECTOR_BLOCKS - 1U);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(Locked + LockErrors, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/* Reads and writes during a 64K erase suspend it; the erase then completes
+   and the data written meanwhile are kept */
+static void TestSuspend(void)
+{
+  uint32_t block, i, address, polls = 0U;
+  UTIL_NOR_ERASE_Stats_t   stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  Setup(0U);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(0U), 2U * UTIL_NOR_ERASE_BLOCK_SIZE), UTIL_NOR_ERASE_OK);
+  RunErases();
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Alloc(&address), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(address, BlockAddress(0U));
+  UTIL_NOR_ERASE_ResetStats();
+  MX25LM51245G_SIM_ResetStats();
+
+  /* Start the erase of the second sector */
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Free(BlockAddress(SECTOR_BLOCKS), UTIL_NOR_ERASE_SECTOR_SIZE), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Process(), UTIL_NOR_ERASE_OK);
+  TEST_CHECK_EQ(FlashGetStatus(0U), UTIL_NOR_ERASE_FLASH_BUSY);
+
+  for (i = 0U; i < sizeof(Data); i++)
+  {
+    Data[i] = (uint8_t)((i * 7U) + 1U);
+  }
+  while (UTIL_NOR_ERASE_Process() == UTIL_NOR_ERASE_OK)
+  {
+    /* Write the allocated block and read it back, read a used block */
+    if (polls < 4U)
+    {
+      TEST_CHECK_EQ(UTIL_NOR_ERASE_Write(address + (polls * 1024U), &Data[polls * 1024U], 1024U), UTIL_NOR_ERASE_OK);
+    }
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Read(address, Buffer, sizeof(Buffer)), UTIL_NOR_ERASE_OK);
+    TEST_CHECK(memcmp(Buffer, Data, ((polls < 4U) ? (polls + 1U) : 4U) * 1024U) == 0);
+    TEST_CHECK_EQ(UTIL_NOR_ERASE_Read(BlockAddress(5U), Buffer, 16U), UTIL_NOR_ERASE_OK);
+    TEST_CHECK_EQ(Buffer[0] | Buffer[15], 0x00U);
+    polls++;
+    Delay(100U);
+  }
+  TEST_CHECK(polls >= 4U);
+
+  /* Only allocated blocks are written */
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Write(BlockAddress(1U), Data, 16U), UTIL_NOR_ERASE_ERROR);
+  TEST_CHECK_EQ(UTIL_NOR_ERASE_Write(BlockAddress(SECTOR_BLOCKS), Data, 16U), UTIL_NOR_ERASE_ERROR);
+
+  UTIL_NOR_ERASE_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(stats.Erases64K, 1U);
+  TEST_CHECK_EQ(stats.EraseErrors, 0U);
+  TEST_CHECK_EQ(stats.PoolDepth, SECTOR_BLOCKS + 1U);
+  TEST_CHECK_EQ(stats.Suspends, (2U * polls) + 4U);
+  TEST_CHECK_EQ(sim.Suspends, stats.Suspends);
+  TEST_CHECK_EQ(sim.Resumes, stats.Suspends);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK(stats.EraseTime >= MX25LM51245G_SECTOR_ERASE_MAX_TIME);
+
+  TEST_CHECK(memcmp(&MX25LM51245G_SIM_GetImage()[address], Data, sizeof(Data)) == 0);
+  for (block = SECTOR_BLOCKS; block < BLOCKS; block++)
+  {
+    TEST_CHECK_EQ(CountNot(block, 0xFFU), 0U);
+  }
+  TEST_CHECK_EQ(CountNot(1U, 0xFFU), 0U);
+  for (block = 2U; block < SECTOR_BLOCKS; block++)
+  {
+    TEST_CHECK_EQ(CountNot(block, 0x00U), 0U);
+  }
+  TEST_CHECK_EQ(Locked + LockErrors, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+int main(void)
+{
+  TestPool();
+  TestGranularity();
+  TestSuspend();
+
+  return TEST_RESULT("test_nor_erase");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
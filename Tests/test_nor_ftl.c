@@ -0,0 +1,250 @@
+/**
+  ******************************************************************************
+  * @file    test_nor_ftl.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_nor_ftl.c flash translation layer over the
+  *          RAM flash of nor_ftl_ram.c: content after random writes and
+  *          remounts, and power cuts at random program or erase operations,
+  *          after which the volume must mount with the last written data and
+  *          stay writable.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "nor_ftl_ram.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define BLOCKS          16U
+#define CAPACITY        UTIL_NOR_FTL_CAPACITY(BLOCKS)
+#define POWER_CUTS      400U
+#define WRITES_ON       (3U * UTIL_NOR_FTL_PAGES_PER_BLOCK)  /* Writes without cut after each mount */
+#define NO_PAGE         0xFFFFFFFFU
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static uint8_t              Flash[BLOCKS * UTIL_NOR_FTL_BLOCK_SIZE];
+static uint32_t             Map[CAPACITY];
+static UTIL_NOR_FTL_Block_t Blocks[BLOCKS];
+static uint32_t             Version[CAPACITY];  /* Last version written, 0 when never */
+static UTIL_NOR_FTL_Init_t  Init;
+
+/* Private functions ---------------------------------------------------------*/
+static void FillPage(uint8_t *pData, uint32_t LogicalPage, uint32_t Ver)
+{
+  uint32_t i;
+
+  for (i = 0U; i < UTIL_NOR_FTL_PAGE_SIZE; i++)
+  {
+    pData[i] = (uint8_t)((LogicalPage * 7U) + (Ver * 13U) + i);
+  }
+}
+
+/* Check all the pages. The page written when the power was cut may hold
+   either its previous or its new version. */
+static uint32_t CheckContent(uint32_t Pending, uint32_t PendingVersion)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint8_t  expected[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t page, bad = 0U;
+
+  for (page = 0U; (page < Init.LogicalPages) && (bad == 0U); page++)
+  {
+    if (UTIL_NOR_FTL_Read(page, data) != UTIL_NOR_FTL_OK)
+    {
+      (void)printf("page %u: read error\n", (unsigned int)page);
+      bad++;
+    }
+    else
+    {
+      if (Version[page] == 0U)
+      {
+        (void)memset(expected, 0xFF, sizeof(expected));
+      }
+      else
+      {
+        FillPage(expected, page, Version[page]);
+      }
+      if (memcmp(data, expected, sizeof(data)) != 0)
+      {
+        FillPage(expected, page, PendingVersion);
+        if ((page == Pending) && (memcmp(data, expected, sizeof(data)) == 0))
+        {
+          Version[page] = PendingVersion;
+        }
+        else
+        {
+          (void)printf("page %u: version %u expected\n", (unsigned int)page, (unsigned int)Version[page]);
+          bad++;
+        }
+      }
+    }
+  }
+
+  return bad;
+}
+
+static void Setup(uint32_t LogicalPages)
+{
+  (void)memset(Flash, 0, sizeof(Flash));
+  (void)memset(Version, 0, sizeof(Version));
+  TEST_CHECK_EQ(NorFtlRam_Init(Flash, sizeof(Flash)), UTIL_NOR_FTL_OK);
+
+  Init.pFlash       = &NorFtlRam;
+  Init.Instance     = 0U;
+  Init.Address      = 0U;
+  Init.BlockCount   = BLOCKS;
+  Init.LogicalPages = LogicalPages;
+  Init.pMap         = Map;
+  Init.pBlocks      = Blocks;
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Format(), UTIL_NOR_FTL_OK);
+}
+
+/* Random writes with background steps, then a remount */
+static void TestWriteMount(void)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t n, page, ver = 1U;
+  UTIL_NOR_FTL_Stats_t stats;
+  NorFtlRam_Stats_t    flash;
+
+  srand(1U);
+  Setup(CAPACITY);
+  for (n = 0U; (n < 20000U) && (TestFailures == 0U); n++)
+  {
+    /* 90% of the writes on 10% of the pages */
+    page = (((uint32_t)rand() % 10U) != 0U) ? ((uint32_t)rand() % (CAPACITY / 10U)) : ((uint32_t)rand() % CAPACITY);
+    FillPage(data, page, ver);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Write(page, data), UTIL_NOR_FTL_OK);
+    Version[page] = ver;
+    ver++;
+    if ((n % 8U) == 0U)
+    {
+      while (UTIL_NOR_FTL_Background() == UTIL_NOR_FTL_OK)
+      {
+      }
+    }
+  }
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+
+  UTIL_NOR_FTL_GetStats(&stats);
+  TEST_CHECK(stats.FlashWrites >= stats.HostWrites);
+  TEST_CHECK((stats.MaxEraseCount - stats.MinEraseCount) <= (UTIL_NOR_FTL_WL_THRESHOLD + 2U));
+
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Mount(), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+
+  NorFtlRam_GetStats(&flash);
+  TEST_CHECK_EQ(flash.Violations, 0U);
+}
+
+/*
+ * Fill LogicalPages, then repeat: cut the power at a random program or erase
+ * while writing random pages, remount, check the content, and check that
+ * the volume takes WRITES_ON more writes, enough to need garbage collection.
+ */
+static void TestPowerCuts(uint32_t Seed, uint32_t LogicalPages)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t cut, n, page = NO_PAGE, ver = 1U, pending = 0U, writes = 0U;
+  int32_t  ret;
+  UTIL_NOR_FTL_Stats_t stats;
+  NorFtlRam_Stats_t    flash;
+
+  srand(Seed);
+  Setup(LogicalPages);
+  for (page = 0U; page < LogicalPages; page++)
+  {
+    FillPage(data, page, ver);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Write(page, data), UTIL_NOR_FTL_OK);
+    Version[page] = ver;
+    ver++;
+  }
+
+  for (cut = 0U; (cut < POWER_CUTS) && (TestFailures == 0U); cut++)
+  {
+    /* Writes until the power cut */
+    NorFtlRam_PowerCut(1U + ((uint32_t)rand() % 40U));
+    do
+    {
+      page    = (uint32_t)rand() % LogicalPages;
+      pending = ver;
+      ver++;
+      FillPage(data, page, pending);
+      ret = UTIL_NOR_FTL_Write(page, data);
+      if (ret == UTIL_NOR_FTL_OK)
+      {
+        Version[page] = pending;
+        writes++;
+        if ((((uint32_t)rand() % 4U) == 0U) && (UTIL_NOR_FTL_Background() == UTIL_NOR_FTL_ERROR))
+        {
+          page = NO_PAGE;
+          ret  = UTIL_NOR_FTL_ERROR;
+        }
+      }
+    } while (ret == UTIL_NOR_FTL_OK);
+
+    /* Power back */
+    NorFtlRam_PowerCut(0U);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Mount(), UTIL_NOR_FTL_OK);
+    TEST_CHECK_EQ(CheckContent(page, pending), 0U);
+
+    /* Still writable */
+    for (n = 0U; (n < WRITES_ON) && (TestFailures == 0U); n++)
+    {
+      page = (uint32_t)rand() % LogicalPages;
+      FillPage(data, page, ver);
+      if (UTIL_NOR_FTL_Write(page, data) != UTIL_NOR_FTL_OK)
+      {
+        UTIL_NOR_FTL_GetStats(&stats);
+        (void)printf("seed %u, %u pages: write failed after %u power cuts and %u writes, %u free blocks\n",
+                     (unsigned int)Seed, (unsigned int)LogicalPages, (unsigned int)cut, (unsigned int)writes,
+                     (unsigned int)stats.FreeBlocks);
+        TestFailures++;
+      }
+      else
+      {
+        Version[page] = ver;
+        writes++;
+      }
+      ver++;
+    }
+  }
+
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+  NorFtlRam_GetStats(&flash);
+  TEST_CHECK_EQ(flash.Violations, 0U);
+}
+
+int main(void)
+{
+  uint32_t seed;
+
+  TestWriteMount();
+  for (seed = 1U; seed <= 4U; seed++)
+  {
+    TestPowerCuts(seed, CAPACITY / 2U);
+    TestPowerCuts(seed, CAPACITY);
+  }
+
+  return TEST_RESULT("test_nor_ftl");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,362 @@
+/**
+  ******************************************************************************
+  * @file    test_nor_ftl_ospi.c
+  * @author  MCD Application Team
+  * @brief   Host test of the stm32_nor_ftl.c flash translation layer over the
+  *          MX25LM51245G component functions and its simulated memory, in DTR
+  *          OPI mode, with flash services doing what BSP_OSPI_NOR_Read(),
+  *          BSP_OSPI_NOR_Write() and BSP_OSPI_NOR_Erase_Block() do: content
+  *          after random writes and remounts, no command ignored by the
+  *          memory, erases matching the erase counts of the memory, and power
+  *          losses at random program or erase operations.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_nor_ftl.h"
+#include "mx25lm51245g_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define PARTITION       0x00100000U  /* Partition address */
+#define BLOCKS          32U
+#define CAPACITY        UTIL_NOR_FTL_CAPACITY(BLOCKS)
+#define WRITES          6000U
+#define POWER_CUTS      100U
+#define WRITES_ON       (3U * UTIL_NOR_FTL_PAGES_PER_BLOCK)  /* Writes without cut after each mount */
+#define NO_PAGE         0xFFFFFFFFU
+#define FLASH_OK        0            /* BSP_ERROR_NONE                */
+#define FLASH_ERROR     (-5)         /* BSP_ERROR_COMPONENT_FAILURE   */
+#define MODE            MX25LM51245G_OPI_MODE
+#define RATE            MX25LM51245G_DTR_TRANSFER
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static OSPI_HandleTypeDef   Ospi;
+static uint32_t             Map[CAPACITY];
+static UTIL_NOR_FTL_Block_t Blocks[BLOCKS];
+static uint32_t             Version[CAPACITY];  /* Last version written, 0 when never */
+static UTIL_NOR_FTL_Init_t  Init;
+
+/* Private functions ---------------------------------------------------------*/
+/* Flash services as BSP_OSPI_NOR_xxx() runs them on the component */
+static int32_t FlashRead(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  (void)Instance;
+  return (MX25LM51245G_ReadDTR(&Ospi, pData, Address, Size) == MX25LM51245G_OK) ? FLASH_OK : FLASH_ERROR;
+}
+
+static int32_t FlashWrite(uint32_t Instance, uint8_t *pData, uint32_t Address, uint32_t Size)
+{
+  int32_t  ret = FLASH_OK;
+  uint32_t size;
+
+  (void)Instance;
+  while ((Size != 0U) && (ret == FLASH_OK))
+  {
+    size = MX25LM51245G_PAGE_SIZE - (Address % MX25LM51245G_PAGE_SIZE);
+    size = (size > Size) ? Size : size;
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_PageProgramDTR(&Ospi, pData, Address, size) != MX25LM51245G_OK) ||
+        (MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK))
+    {
+      ret = FLASH_ERROR;
+    }
+    Address += size;
+    pData   += size;
+    Size    -= size;
+  }
+
+  return ret;
+}
+
+/* The erase wrapper of the utility notes: BSP_OSPI_NOR_Erase_Block() polls
+   the memory before the erase, not after it */
+static int32_t FlashErase(uint32_t Instance, uint32_t Address)
+{
+  (void)Instance;
+  return ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_WriteEnable(&Ospi, MODE, RATE) == MX25LM51245G_OK) &&
+          (MX25LM51245G_BlockErase(&Ospi, MODE, RATE, MX25LM51245G_4BYTES_SIZE, Address,
+                                   MX25LM51245G_ERASE_4K) == MX25LM51245G_OK)) ? FLASH_OK : FLASH_ERROR;
+}
+
+static const UTIL_NOR_FTL_Flash_t Flash =
+{
+  FlashRead,
+  FlashWrite,
+  FlashErase
+};
+
+/* Switch the memory from SPI to DTR OPI mode, as OSPI_NOR_EnterDOPIMode() */
+static int32_t EnterDOPIMode(void)
+{
+  int32_t ret = FLASH_OK;
+  uint8_t reg[2];
+
+  if ((MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG3_ADDR,
+                                      MX25LM51245G_CR2_DC_6_CYCLES) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteEnable(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER) != MX25LM51245G_OK) ||
+      (MX25LM51245G_WriteCfg2Register(&Ospi, MX25LM51245G_SPI_MODE, MX25LM51245G_STR_TRANSFER, MX25LM51245G_CR2_REG1_ADDR,
+                                      MX25LM51245G_CR2_DOPI) != MX25LM51245G_OK))
+  {
+    ret = FLASH_ERROR;
+  }
+  else
+  {
+    MX25LM51245G_SIM_Wait(MX25LM51245G_WRITE_REG_MAX_TIME * 1000U);
+    if ((MX25LM51245G_AutoPollingMemReady(&Ospi, MODE, RATE) != MX25LM51245G_OK) ||
+        (MX25LM51245G_ReadCfg2Register(&Ospi, MODE, RATE, MX25LM51245G_CR2_REG1_ADDR, reg) != MX25LM51245G_OK) ||
+        (reg[0] != MX25LM51245G_CR2_DOPI))
+    {
+      ret = FLASH_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+static void FillPage(uint8_t *pData, uint32_t LogicalPage, uint32_t Ver)
+{
+  uint32_t i;
+
+  for (i = 0U; i < UTIL_NOR_FTL_PAGE_SIZE; i++)
+  {
+    pData[i] = (uint8_t)((LogicalPage * 7U) + (Ver * 13U) + i);
+  }
+}
+
+/* Check all the pages. The page written when the power was lost may hold
+   either its previous or its new version. */
+static uint32_t CheckContent(uint32_t Pending, uint32_t PendingVersion)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint8_t  expected[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t page, bad = 0U;
+
+  for (page = 0U; (page < CAPACITY) && (bad == 0U); page++)
+  {
+    if (UTIL_NOR_FTL_Read(page, data) != UTIL_NOR_FTL_OK)
+    {
+      (void)printf("page %u: read error\n", (unsigned int)page);
+      bad++;
+    }
+    else
+    {
+      if (Version[page] == 0U)
+      {
+        (void)memset(expected, 0xFF, sizeof(expected));
+      }
+      else
+      {
+        FillPage(expected, page, Version[page]);
+      }
+      if (memcmp(data, expected, sizeof(data)) != 0)
+      {
+        FillPage(expected, page, PendingVersion);
+        if ((page != Pending) || (memcmp(data, expected, sizeof(data)) != 0))
+        {
+          (void)printf("page %u: wrong content, version %u expected\n", (unsigned int)page,
+                       (unsigned int)Version[page]);
+          bad++;
+        }
+        else
+        {
+          Version[page] = PendingVersion;
+        }
+      }
+    }
+  }
+
+  return bad;
+}
+
+/* Memory around the partition, left erased and never erased */
+static void CheckOutside(void)
+{
+  const uint8_t *image = MX25LM51245G_SIM_GetImage();
+  uint32_t       i, bad = 0U;
+
+  for (i = 0U; i < UTIL_NOR_FTL_BLOCK_SIZE; i++)
+  {
+    bad += (image[PARTITION - 1U - i] != 0xFFU) ? 1U : 0U;
+    bad += (image[PARTITION + (BLOCKS * UTIL_NOR_FTL_BLOCK_SIZE) + i] != 0xFFU) ? 1U : 0U;
+  }
+  TEST_CHECK_EQ(bad, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(PARTITION - UTIL_NOR_FTL_BLOCK_SIZE), 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_GetEraseCount(PARTITION + (BLOCKS * UTIL_NOR_FTL_BLOCK_SIZE)), 0U);
+}
+
+static void Setup(void)
+{
+  TEST_CHECK_EQ(MX25LM51245G_SIM_Init(NULL), MX25LM51245G_OK);
+  TEST_CHECK_EQ(EnterDOPIMode(), FLASH_OK);
+  (void)memset(Version, 0, sizeof(Version));
+
+  Init.pFlash       = &Flash;
+  Init.Instance     = 0U;
+  Init.Address      = PARTITION;
+  Init.BlockCount   = BLOCKS;
+  Init.LogicalPages = CAPACITY;
+  Init.pMap         = Map;
+  Init.pBlocks      = Blocks;
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Format(), UTIL_NOR_FTL_OK);
+}
+
+/* Random writes with background steps, then a remount and a power cycle */
+static void TestWriteMount(void)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t n, page, block, erases = 0U, ver = 1U;
+  UTIL_NOR_FTL_Stats_t     stats;
+  MX25LM51245G_SIM_Stats_t sim;
+
+  srand(1U);
+  Setup();
+  MX25LM51245G_SIM_ResetStats();
+  UTIL_NOR_FTL_ResetStats();
+  for (n = 0U; (n < WRITES) && (TestFailures == 0U); n++)
+  {
+    /* 90% of the writes on 10% of the pages */
+    page = (((uint32_t)rand() % 10U) != 0U) ? ((uint32_t)rand() % (CAPACITY / 10U)) : ((uint32_t)rand() % CAPACITY);
+    FillPage(data, page, ver);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Write(page, data), UTIL_NOR_FTL_OK);
+    Version[page] = ver;
+    ver++;
+    if ((n % 8U) == 0U)
+    {
+      while (UTIL_NOR_FTL_Background() == UTIL_NOR_FTL_OK)
+      {
+      }
+    }
+  }
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+
+  /* Every command decoded, every erase a 4K subsector erase of the partition */
+  UTIL_NOR_FTL_GetStats(&stats);
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(sim.Erases4K, stats.Erases);
+  TEST_CHECK_EQ(sim.Erases64K + sim.ChipErases, 0U);
+  TEST_CHECK(sim.Programs >= stats.FlashWrites);
+  TEST_CHECK(stats.Erases > BLOCKS);
+  for (block = 0U; block < BLOCKS; block++)
+  {
+    erases += MX25LM51245G_SIM_GetEraseCount(PARTITION + (block * UTIL_NOR_FTL_BLOCK_SIZE));
+  }
+  TEST_CHECK_EQ(erases, stats.Erases + BLOCKS);
+  CheckOutside();
+
+  /* Remount, then after a power cycle */
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Mount(), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+  MX25LM51245G_SIM_PowerOn();
+  TEST_CHECK_EQ(EnterDOPIMode(), FLASH_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(UTIL_NOR_FTL_Mount(), UTIL_NOR_FTL_OK);
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+
+  MX25LM51245G_SIM_GetStats(&sim);
+  TEST_CHECK_EQ(sim.Ignored, 0U);
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+/*
+ * Fill the volume, then repeat: lose the power at a random program or erase
+ * while writing random pages, power on, remount, check the content, and
+ * check that the volume takes WRITES_ON more writes.
+ */
+static void TestPowerLosses(uint32_t Seed)
+{
+  uint8_t  data[UTIL_NOR_FTL_PAGE_SIZE];
+  uint32_t cut, n, page, ver = 1U, pending = 0U;
+  int32_t  ret;
+
+  srand(Seed);
+  Setup();
+  for (page = 0U; page < CAPACITY; page++)
+  {
+    FillPage(data, page, ver);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Write(page, data), UTIL_NOR_FTL_OK);
+    Version[page] = ver;
+    ver++;
+  }
+
+  for (cut = 0U; (cut < POWER_CUTS) && (TestFailures == 0U); cut++)
+  {
+    /* Writes until the power loss */
+    TEST_CHECK_EQ(MX25LM51245G_SIM_InjectFault(MX25LM51245G_SIM_FAULT_POWER_LOSS, 1U + ((uint32_t)rand() % 40U)),
+                  MX25LM51245G_OK);
+    do
+    {
+      page    = (uint32_t)rand() % CAPACITY;
+      pending = ver;
+      ver++;
+      FillPage(data, page, pending);
+      ret = UTIL_NOR_FTL_Write(page, data);
+      if (ret == UTIL_NOR_FTL_OK)
+      {
+        Version[page] = pending;
+        if ((((uint32_t)rand() % 4U) == 0U) && (UTIL_NOR_FTL_Background() == UTIL_NOR_FTL_ERROR))
+        {
+          page = NO_PAGE;
+          ret  = UTIL_NOR_FTL_ERROR;
+        }
+      }
+    } while (ret == UTIL_NOR_FTL_OK);
+
+    /* Power back, in SPI mode */
+    MX25LM51245G_SIM_PowerOn();
+    TEST_CHECK_EQ(EnterDOPIMode(), FLASH_OK);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Init(&Init), UTIL_NOR_FTL_OK);
+    TEST_CHECK_EQ(UTIL_NOR_FTL_Mount(), UTIL_NOR_FTL_OK);
+    TEST_CHECK_EQ(CheckContent(page, pending), 0U);
+
+    /* Still writable */
+    for (n = 0U; (n < WRITES_ON) && (TestFailures == 0U); n++)
+    {
+      page = (uint32_t)rand() % CAPACITY;
+      FillPage(data, page, ver);
+      TEST_CHECK_EQ(UTIL_NOR_FTL_Write(page, data), UTIL_NOR_FTL_OK);
+      Version[page] = ver;
+      ver++;
+    }
+  }
+
+  TEST_CHECK_EQ(CheckContent(NO_PAGE, 0U), 0U);
+  CheckOutside();
+  TEST_CHECK_EQ(MX25LM51245G_SIM_DeInit(), MX25LM51245G_OK);
+}
+
+int main(void)
+{
+  uint32_t seed;
+
+  TestWriteMount();
+  for (seed = 1U; seed <= 3U; seed++)
+  {
+    TestPowerLosses(seed);
+  }
+
+  return TEST_RESULT("test_nor_ftl_ospi");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
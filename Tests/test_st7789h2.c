@@ -0,0 +1,550 @@
+/**
+  ******************************************************************************
+  * @file    test_st7789h2.c
+  * @author  MCD Application Team
+  * @brief   Golden image test of the ST7789H2 driver and of stm32_lcd.c over
+  *          the simulated ST7789H2 bus. The reference scenes are drawn in the
+  *          4 orientations and compared with the images stored in golden/,
+  *          rotated accordingly. Mismatching images are written in build/.
+  *          Run with -u, from this directory, to rewrite the golden images
+  *          after an intended rendering change. Lines ending on the last
+  *          column and row are also checked pixel by pixel in each
+  *          orientation, and text console lines against the same text
+  *          drawn with UTIL_LCD_DisplayStringAt().
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test.h"
+#include "stm32_lcd.h"
+#include "st7789h2_sim.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define SIZE            240U  /* ST7789H2_WIDTH = ST7789H2_HEIGHT */
+#define BITMAP_WIDTH    20U
+#define BITMAP_HEIGHT   30U
+#define BITMAP_OFFSET   54U
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  const char *pName;
+  void      (*Draw)(void);
+} Scene_t;
+
+typedef struct
+{
+  uint32_t Xpos;
+  uint32_t Ypos;
+  uint32_t Length;
+  uint32_t Vertical;
+} Line_t;
+
+/* Private variables ---------------------------------------------------------*/
+TEST_MAIN;
+
+static ST7789H2_Object_t Lcd;
+static uint16_t Image[SIZE * SIZE];
+static uint16_t Golden[SIZE * SIZE];
+static uint8_t  Bitmap[BITMAP_OFFSET + (BITMAP_WIDTH * BITMAP_HEIGHT * 2U)];
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  (void)Instance;
+  return ST7789H2_DrawBitmap(&Lcd, Xpos, Ypos, pBmp);
+}
+
+static int32_t FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  (void)Instance;
+  return ST7789H2_FillRGBRect(&Lcd, Xpos, Ypos, pData, Width, Height);
+}
+
+static int32_t DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawHLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_DrawVLine(&Lcd, Xpos, Ypos, Length, Color);
+}
+
+static int32_t FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_FillRect(&Lcd, Xpos, Ypos, Width, Height, Color);
+}
+
+static int32_t GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *pColor)
+{
+  (void)Instance;
+  return ST7789H2_GetPixel(&Lcd, Xpos, Ypos, pColor);
+}
+
+static int32_t SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  (void)Instance;
+  return ST7789H2_SetPixel(&Lcd, Xpos, Ypos, Color);
+}
+
+static int32_t GetXSize(uint32_t Instance, uint32_t *pXSize)
+{
+  (void)Instance;
+  return ST7789H2_GetXSize(&Lcd, pXSize);
+}
+
+static int32_t GetYSize(uint32_t Instance, uint32_t *pYSize)
+{
+  (void)Instance;
+  return ST7789H2_GetYSize(&Lcd, pYSize);
+}
+
+static int32_t SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  (void)Instance;
+  (void)Layer;
+  return 0;
+}
+
+static int32_t GetFormat(uint32_t Instance, uint32_t *pFormat)
+{
+  (void)Instance;
+  *pFormat = LCD_PIXEL_FORMAT_RGB565;
+  return 0;
+}
+
+/* Same adaptation of the driver as the BSP LCD_Driver */
+static int32_t SetScrollArea(uint32_t Instance, uint32_t Ypos, uint32_t Height)
+{
+  (void)Instance;
+  return ST7789H2_SetScrollArea(&Lcd, Ypos, Height);
+}
+
+static int32_t SetScrollStart(uint32_t Instance, uint32_t Line)
+{
+  (void)Instance;
+  return ST7789H2_SetScrollStart(&Lcd, Line);
+}
+
+static const UTIL_LCD_ScrollDrv_t ScrollDriver =
+{
+  SetScrollArea,
+  SetScrollStart
+};
+
+static const LCD_UTILS_Drv_t LcdDriver =
+{
+  DrawBitmap,
+  FillRGBRect,
+  DrawHLine,
+  DrawVLine,
+  FillRect,
+  GetPixel,
+  SetPixel,
+  GetXSize,
+  GetYSize,
+  SetLayer,
+  GetFormat
+};
+
+/* 16 bpp bottom-up BMP of a color ramp */
+static void MakeBitmap(void)
+{
+  uint32_t x, y, size = sizeof(Bitmap);
+  uint16_t color;
+
+  (void)memset(Bitmap, 0, BITMAP_OFFSET);
+  Bitmap[0]  = (uint8_t)'B';
+  Bitmap[1]  = (uint8_t)'M';
+  (void)memcpy(&Bitmap[2], &size, 4U);
+  Bitmap[10] = (uint8_t)BITMAP_OFFSET;
+  Bitmap[18] = (uint8_t)BITMAP_WIDTH;
+  Bitmap[22] = (uint8_t)BITMAP_HEIGHT;
+  Bitmap[28] = 16U;
+  for (y = 0U; y < BITMAP_HEIGHT; y++)
+  {
+    for (x = 0U; x < BITMAP_WIDTH; x++)
+    {
+      color = (uint16_t)((x * 2000U) + (y * 37U) + 1U);
+      (void)memcpy(&Bitmap[BITMAP_OFFSET + (((y * BITMAP_WIDTH) + x) * 2U)], &color, 2U);
+    }
+  }
+}
+
+/* Fills, filled shapes, line, bitmap, text and corner pixels */
+static void DrawShapes(void)
+{
+  Point quad[4] = {{10, 100}, {80, 90}, {60, 170}, {5, 150}};
+
+  UTIL_LCD_Clear(0xFF102030U);
+  UTIL_LCD_FillRect(20U, 20U, 100U, 40U, 0xFFFF0000U);
+  UTIL_LCD_FillCircle(150U, 60U, 25U, 0xFF00FF00U);
+  UTIL_LCD_DrawLine(0U, 0U, 239U, 200U, 0xFF0000FFU);
+  UTIL_LCD_FillPolygon(quad, 4U, 0xFF808080U);
+  UTIL_LCD_FillEllipse(120, 200, 50, 20, 0xFFFFFF00U);
+  UTIL_LCD_DrawBitmap(180U, 150U, Bitmap);
+  UTIL_LCD_SetFont(&Font16);
+  UTIL_LCD_SetBackColor(0xFF000000U);
+  UTIL_LCD_SetTextColor(0xFFFFFFFFU);
+  UTIL_LCD_DisplayStringAt(5U, 5U, (uint8_t *)"Hello sim", LEFT_MODE);
+  UTIL_LCD_SetPixel(239U, 239U, 0xFFFFFFFFU);
+  UTIL_LCD_SetPixel(0U, 239U, 0xFFFF00FFU);
+}
+
+/* Outlines, gradients and every font */
+static void DrawText(void)
+{
+  Point star[5] = {{120, 70}, {150, 160}, {75, 105}, {165, 105}, {90, 160}};
+
+  UTIL_LCD_Clear(0xFFFFFFFFU);
+  UTIL_LCD_FillLinearGradient(0U, 180U, 240U, 60U, 0xFF0000FFU, 0xFFFF0000U, UTIL_LCD_GRADIENT_HORIZONTAL);
+  UTIL_LCD_FillRadialGradient(170U, 60U, 60U, 60U, 200, 90, 40U, 0xFFFFFF00U, 0xFF008000U);
+  UTIL_LCD_DrawRect(2U, 2U, 236U, 176U, 0xFF000000U);
+  UTIL_LCD_DrawCircle(40U, 130U, 30U, 0xFFFF0000U);
+  UTIL_LCD_DrawEllipse(200, 140, 30, 15, 0xFF0000FFU);
+  UTIL_LCD_DrawPolygon(star, 5U, 0xFF008080U);
+  UTIL_LCD_SetBackColor(0xFFFFFFFFU);
+  UTIL_LCD_SetTextColor(0xFF000000U);
+  UTIL_LCD_SetFont(&Font8);
+  UTIL_LCD_DisplayStringAt(5U, 5U, (uint8_t *)"Font8 0123456789", LEFT_MODE);
+  UTIL_LCD_SetFont(&Font12);
+  UTIL_LCD_DisplayStringAt(5U, 15U, (uint8_t *)"Font12 right", RIGHT_MODE);
+  UTIL_LCD_SetFont(&Font20);
+  UTIL_LCD_DisplayStringAt(0U, 30U, (uint8_t *)"Font20", CENTER_MODE);
+  UTIL_LCD_SetTextColor(0xFFFFFFFFU);
+  UTIL_LCD_SetBackColor(0xFF800000U);
+  UTIL_LCD_SetFont(&Font24);
+  UTIL_LCD_DisplayStringAt(5U, 190U, (uint8_t *)"Font24", LEFT_MODE);
+  UTIL_LCD_SetPFont(&PFont16);
+  UTIL_LCD_DisplayPStringAt(0U, 215U, (uint8_t *)"Proportional", CENTER_MODE);
+}
+
+/* Displayed panel pixel showing the user pixel (X, Y) in Orientation */
+static uint32_t PanelIndex(uint32_t Orientation, uint32_t X, uint32_t Y)
+{
+  uint32_t index;
+
+  switch (Orientation)
+  {
+    case ST7789H2_ORIENTATION_LANDSCAPE:
+      index = ((SIZE - 1U - X) * SIZE) + Y;
+      break;
+    case ST7789H2_ORIENTATION_PORTRAIT_ROT180:
+      index = ((SIZE - 1U - Y) * SIZE) + (SIZE - 1U - X);
+      break;
+    case ST7789H2_ORIENTATION_LANDSCAPE_ROT180:
+      index = (X * SIZE) + (SIZE - 1U - Y);
+      break;
+    default:
+      index = (Y * SIZE) + X;
+      break;
+  }
+
+  return index;
+}
+
+/* Load a 240 x 240 binary PPM as RGB565 */
+static int32_t LoadGolden(const char *pFileName)
+{
+  int32_t  ret = 0;
+  FILE    *file;
+  uint8_t  rgb[3U * SIZE];
+  unsigned int width = 0U, height = 0U, max = 0U;
+  uint32_t x, y;
+
+  file = fopen(pFileName, "rb");
+  if (file == NULL)
+  {
+    ret = -1;
+  }
+  else
+  {
+    if ((fscanf(file, "P6 %u %u %u", &width, &height, &max) != 3) || (fgetc(file) == EOF) ||
+        (width != SIZE) || (height != SIZE) || (max != 255U))
+    {
+      ret = -1;
+    }
+    for (y = 0U; (y < SIZE) && (ret == 0); y++)
+    {
+      if (fread(rgb, 1U, sizeof(rgb), file) != sizeof(rgb))
+      {
+        ret = -1;
+      }
+      for (x = 0U; (x < SIZE) && (ret == 0); x++)
+      {
+        Golden[(y * SIZE) + x] = (uint16_t)(((uint32_t)(rgb[3U * x] >> 3) << 11) |
+                                            ((uint32_t)(rgb[(3U * x) + 1U] >> 2) << 5) |
+                                             (uint32_t)(rgb[(3U * x) + 2U] >> 3));
+      }
+    }
+    (void)fclose(file);
+  }
+
+  return ret;
+}
+
+static void InitPanel(uint32_t Orientation)
+{
+  ST7789H2_IO_t io;
+
+  (void)memset(&Lcd, 0, sizeof(Lcd));
+  TEST_CHECK_EQ(ST7789H2_SIM_Init(&io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_RegisterBusIO(&Lcd, &io), ST7789H2_OK);
+  TEST_CHECK_EQ(ST7789H2_Init(&Lcd, ST7789H2_FORMAT_RBG565, Orientation), ST7789H2_OK);
+  UTIL_LCD_SetFuncDriver(&LcdDriver);
+}
+
+static void UpdateGolden(const Scene_t *pScene)
+{
+  char name[64];
+
+  InitPanel(ST7789H2_ORIENTATION_PORTRAIT);
+  pScene->Draw();
+  (void)snprintf(name, sizeof(name), "golden/st7789h2_%s.ppm", pScene->pName);
+  TEST_CHECK_EQ(ST7789H2_SIM_DumpPPM(name), ST7789H2_OK);
+  (void)printf("%s written\n", name);
+}
+
+static void TestScene(const Scene_t *pScene)
+{
+  char     name[64];
+  uint32_t orientation, x, y, bad, color;
+
+  (void)snprintf(name, sizeof(name), "golden/st7789h2_%s.ppm", pScene->pName);
+  if (LoadGolden(name) != 0)
+  {
+    (void)printf("%s: cannot be read\n", name);
+    TestFailures++;
+  }
+  else
+  {
+    for (orientation = ST7789H2_ORIENTATION_PORTRAIT; orientation <= ST7789H2_ORIENTATION_LANDSCAPE_ROT180; orientation++)
+    {
+      InitPanel(orientation);
+      pScene->Draw();
+      ST7789H2_SIM_GetImage(Image);
+
+      bad = 0U;
+      for (y = 0U; y < SIZE; y++)
+      {
+        for (x = 0U; x < SIZE; x++)
+        {
+          if (Image[PanelIndex(orientation, x, y)] != Golden[(y * SIZE) + x])
+          {
+            if (bad == 0U)
+            {
+              (void)printf("%s, orientation %u: first mismatch at %u,%u\n", pScene->pName,
+                           (unsigned int)orientation, (unsigned int)x, (unsigned int)y);
+            }
+            bad++;
+          }
+        }
+      }
+      if (bad != 0U)
+      {
+        (void)snprintf(name, sizeof(name), "build/st7789h2_%s_%u.ppm", pScene->pName, (unsigned int)orientation);
+        (void)ST7789H2_SIM_DumpPPM(name);
+        (void)printf("%s, orientation %u: %u pixels differ, image in %s\n", pScene->pName,
+                     (unsigned int)orientation, (unsigned int)bad, name);
+        TestFailures++;
+      }
+
+      /* Read back through the driver */
+      for (y = 0U; y < SIZE; y += 37U)
+      {
+        x = (y * 91U) % SIZE;
+        TEST_CHECK_EQ(ST7789H2_GetPixel(&Lcd, x, y, &color), ST7789H2_OK);
+        TEST_CHECK_EQ(color, Golden[(y * SIZE) + x]);
+      }
+    }
+  }
+}
+
+/*
+ * Lines ending on the last column or row, drawn in each orientation through
+ * the windowed ST7789H2_FillRect(). The baseline ST7789H2_DrawHLine() wrote
+ * the last pixel of lines ending on column 239 a second time; every pixel of
+ * these lines must be on the panel after a single write.
+ */
+static void TestEdges(void)
+{
+  static const Line_t lines[] =
+  {
+    {0U,          SIZE - 1U,   SIZE,  0U},  /* Last row                   */
+    {100U,        SIZE - 2U,   140U,  0U},  /* Ending on the last column  */
+    {SIZE - 1U,   0U,          1U,    0U},  /* Last column pixel          */
+    {SIZE - 1U,   0U,          SIZE,  1U},  /* Last column                */
+    {SIZE - 2U,   100U,        140U,  1U},  /* Ending on the last row     */
+    {0U,          SIZE - 1U,   1U,    1U},  /* Last row pixel             */
+    {SIZE - 3U,   SIZE - 3U,   3U,    0U},  /* Bottom right corner        */
+  };
+  ST7789H2_SIM_Stats_t stats;
+  uint32_t orientation, i, n, x, y, color, bad, pixels;
+
+  for (orientation = ST7789H2_ORIENTATION_PORTRAIT; orientation <= ST7789H2_ORIENTATION_LANDSCAPE_ROT180; orientation++)
+  {
+    InitPanel(orientation);
+    TEST_CHECK_EQ(ST7789H2_FillRect(&Lcd, 0U, 0U, SIZE, SIZE, 0x0000U), ST7789H2_OK);
+    (void)memset(Golden, 0, sizeof(Golden));
+    ST7789H2_SIM_ResetStats();
+
+    pixels = 0U;
+    for (i = 0U; i < (sizeof(lines) / sizeof(lines[0])); i++)
+    {
+      color = 0x1111U * (i + 1U);
+      if (lines[i].Vertical == 0U)
+      {
+        TEST_CHECK_EQ(ST7789H2_DrawHLine(&Lcd, lines[i].Xpos, lines[i].Ypos, lines[i].Length, color), ST7789H2_OK);
+      }
+      else
+      {
+        TEST_CHECK_EQ(ST7789H2_DrawVLine(&Lcd, lines[i].Xpos, lines[i].Ypos, lines[i].Length, color), ST7789H2_OK);
+      }
+      for (n = 0U; n < lines[i].Length; n++)
+      {
+        x = lines[i].Xpos + ((lines[i].Vertical == 0U) ? n : 0U);
+        y = lines[i].Ypos + ((lines[i].Vertical == 0U) ? 0U : n);
+        Golden[(y * SIZE) + x] = (uint16_t)color;
+      }
+      pixels += lines[i].Length;
+    }
+
+    /* Each pixel is written once, none out of the panel memory */
+    ST7789H2_SIM_GetStats(&stats);
+    TEST_CHECK_EQ(stats.Dropped, 0U);
+    TEST_CHECK_EQ(stats.Pixels, pixels);
+
+    ST7789H2_SIM_GetImage(Image);
+    bad = 0U;
+    for (y = 0U; y < SIZE; y++)
+    {
+      for (x = 0U; x < SIZE; x++)
+      {
+        if (Image[PanelIndex(orientation, x, y)] != Golden[(y * SIZE) + x])
+        {
+          if (bad == 0U)
+          {
+            (void)printf("edges, orientation %u: first mismatch at %u,%u\n",
+                         (unsigned int)orientation, (unsigned int)x, (unsigned int)y);
+          }
+          bad++;
+        }
+      }
+    }
+    TEST_CHECK_EQ(bad, 0U);
+  }
+}
+
+/*
+ * Console lines, each filling the display width with glyphs inked up to
+ * their last column, scrolled in over longer lines: the end of line clear
+ * must erase the old text and keep the last glyph column.
+ */
+static void TestConsole(void)
+{
+  static sFONT *const fonts[] = {&Font8, &Font12, &Font16, &Font20, &Font24};
+  static const char   glyphs[] = "_#=WM";
+  uint8_t  text[64];
+  uint32_t f, line, lines, count, i, bad;
+
+  for (f = 0U; f < (sizeof(fonts) / sizeof(fonts[0])); f++)
+  {
+    lines = SIZE / fonts[f]->Height;
+    count = SIZE / fonts[f]->Width;
+
+    /* Console: a full line, then shorter lines over it */
+    InitPanel(ST7789H2_ORIENTATION_PORTRAIT);
+    UTIL_LCD_SetFont(fonts[f]);
+    UTIL_LCD_SetTextColor(0xFFFFFFFFU);
+    UTIL_LCD_SetBackColor(0xFF000080U);
+    UTIL_LCD_ConsoleInit(0U, SIZE, &ScrollDriver);
+    for (line = 0U; line < (2U * lines); line++)
+    {
+      for (i = 0U; i < (count - ((line < lines) ? 0U : (line % 3U))); i++)
+      {
+        text[i] = (uint8_t)glyphs[(line + i) % (sizeof(glyphs) - 1U)];
+      }
+      text[i] = 0U;
+      UTIL_LCD_ConsoleWriteLine(text);
+    }
+    ST7789H2_SIM_GetImage(Image);
+
+    /* Reference: the last screen of lines drawn on a cleared, unscrolled display */
+    InitPanel(ST7789H2_ORIENTATION_PORTRAIT);
+    UTIL_LCD_SetFont(fonts[f]);
+    UTIL_LCD_SetTextColor(0xFFFFFFFFU);
+    UTIL_LCD_SetBackColor(0xFF000080U);
+    UTIL_LCD_Clear(0xFF000080U);
+    for (line = lines; line < (2U * lines); line++)
+    {
+      for (i = 0U; i < (count - (line % 3U)); i++)
+      {
+        text[i] = (uint8_t)glyphs[(line + i) % (sizeof(glyphs) - 1U)];
+      }
+      text[i] = 0U;
+      UTIL_LCD_DisplayStringAt(0U, (line - lines) * fonts[f]->Height, text, LEFT_MODE);
+    }
+    ST7789H2_SIM_GetImage(Golden);
+
+    bad = 0U;
+    for (i = 0U; i < (SIZE * SIZE); i++)
+    {
+      bad += (Image[i] != Golden[i]) ? 1U : 0U;
+    }
+    if (bad != 0U)
+    {
+      (void)printf("console, font %u x %u: %u pixels differ\n", (unsigned int)fonts[f]->Width,
+                   (unsigned int)fonts[f]->Height, (unsigned int)bad);
+      TestFailures++;
+    }
+    UTIL_LCD_ConsoleDeInit();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  static const Scene_t scenes[] =
+  {
+    {"shapes", DrawShapes},
+    {"text",   DrawText},
+  };
+  uint32_t i;
+
+  MakeBitmap();
+  for (i = 0U; i < (sizeof(scenes) / sizeof(scenes[0])); i++)
+  {
+    if ((argc > 1) && (strcmp(argv[1], "-u") == 0))
+    {
+      UpdateGolden(&scenes[i]);
+    }
+    else
+    {
+      TestScene(&scenes[i]);
+    }
+  }
+  if (argc <= 1)
+  {
+    TestEdges();
+    TestConsole();
+  }
+
+  return TEST_RESULT("test_st7789h2");
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -60,6 +60,48 @@ extern sFONT Font20;
 extern sFONT Font16;
 extern sFONT Font12;
 extern sFONT Font8;
+
+/**
+  * @brief  Proportional font glyph descriptor.
+  *         The glyph bitmap is Width x sPFONT.Height pixels, rows from top to
+  *         bottom, encoded at sPFONT.Bpp bits per pixel (0 is background,
+  *         (1 << Bpp) - 1 is full text color).
+  */
+typedef struct
+{
+  uint16_t Offset;   /*!< Offset of the encoded bitmap in the font data         */
+  uint8_t  Width;    /*!< Bitmap width in pixels, 0 for a blank glyph           */
+  int8_t   XOffset;  /*!< Bitmap left column relative to the pen position       */
+  uint8_t  Advance;  /*!< Pen displacement to the next glyph                    */
+} sGLYPH;
+
+/**
+  * @brief  Proportional, compressed font.
+  *         PFONT_ENCODING_PACKED: pixels packed MSB first, no row padding.
+  *         PFONT_ENCODING_RLE: sequence of tokens
+  *           1vnnnnnn : run of nnnnnn + 1 pixels, background (v = 0) or
+  *                      full text color (v = 1)
+  *           0nnnnnnn : nnnnnnn + 1 pixels follow, packed MSB first and
+  *                      padded to a byte
+  */
+typedef struct _tPFont
+{
+  const uint8_t *Data;       /*!< Encoded glyph bitmaps                       */
+  const sGLYPH  *Glyphs;     /*!< Glyph descriptors, FirstChar to LastChar    */
+  uint16_t       Height;     /*!< Line height in pixels                       */
+  uint8_t        FirstChar;
+  uint8_t        LastChar;
+  uint8_t        Bpp;        /*!< 1, 2 or 4 bits per pixel                    */
+  uint8_t        Encoding;   /*!< PFONT_ENCODING_PACKED or PFONT_ENCODING_RLE */
+} sPFONT;
+
+#define PFONT_ENCODING_PACKED  0U
+#define PFONT_ENCODING_RLE     1U
+
+/* Proportional versions of Font16 and Font24, add pfont16.c or pfont24.c
+   to the project to use them */
+extern const sPFONT PFont16;
+extern const sPFONT PFont24;
 /**
   * @}
   */
@@ -0,0 +1,406 @@
+/**
+  ******************************************************************************
+  * @file    pfont16.c
+  * @author  MCD Application Team
+  * @brief   This file provides the PFont16 proportional font generated by
+  *          pfontgen.py from font16.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fonts.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup FONTS
+  * @{
+  */
+
+/** @defgroup FONTS_Private_Variables
+  * @{
+  */
+static const uint8_t PFont16_Data[] =
+{
+  /* @0 '!' */
+  0x3F, 0xFF, 0xCC, 0x00,
+  /* @4 '"' */
+  0x00, 0x03, 0xBF, 0x74, 0x48, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @18 '#' */
+  0x00, 0x36, 0x36, 0x36, 0x36, 0xFF, 0x6C, 0xFF, 0x6C, 0x6C, 0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00,
+  /* @34 '$' */
+  0x10, 0xFF, 0x1E, 0x3E, 0x0F, 0x0F, 0x07, 0xC7, 0x8F, 0xF0, 0x81, 0x00, 0x00, 0x00,
+  /* @48 '%' */
+  0x00, 0x60, 0x90, 0x90, 0x63, 0x1E, 0x78, 0xC6, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @64 '&' */
+  0x00, 0x00, 0xF3, 0x06, 0x0C, 0x0C, 0x3B, 0xDD, 0x99, 0xD8, 0x00, 0x00, 0x00, 0x00,
+  /* @78 ''' */
+  0x03, 0xF4, 0x90, 0x00, 0x00, 0x00,
+  /* @84 '(' */
+  0x03, 0x36, 0xEC, 0xCC, 0xCE, 0x63, 0x30, 0x00,
+  /* @92 ')' */
+  0x0C, 0xC6, 0x33, 0x33, 0x33, 0x6E, 0xC0, 0x00,
+  /* @100 '*' */
+  0x00, 0x18, 0x18, 0xFF, 0xFF, 0x3C, 0x7E, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @116 '+' */
+  0x00, 0x00, 0x00, 0x81, 0x02, 0x3F, 0x88, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @130 ',' */
+  0x00, 0x00, 0x00, 0x0D, 0x69, 0x00,
+  /* @136 '-' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @150 '.' */
+  0x00, 0x00, 0x3C, 0x00,
+  /* @154 '/' */
+  0x03, 0x03, 0x06, 0x06, 0x0C, 0x0C, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+  /* @170 '0' */
+  0x00, 0x71, 0xB6, 0x3C, 0x78, 0xF1, 0xE3, 0xC6, 0xD8, 0xE0, 0x00, 0x00, 0x00, 0x00,
+  /* @184 '1' */
+  0x00, 0x18, 0xF8, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @200 '2' */
+  0x00, 0x79, 0x9E, 0x3C, 0x61, 0x86, 0x18, 0x61, 0x83, 0xF8, 0x00, 0x00, 0x00, 0x00,
+  /* @214 '3' */
+  0x00, 0x7E, 0xC3, 0x03, 0x06, 0x3E, 0x07, 0x03, 0x03, 0xC3, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @230 '4' */
+  0x00, 0x38, 0x71, 0xE2, 0xCD, 0x93, 0x66, 0xFE, 0x18, 0xF8, 0x00, 0x00, 0x00, 0x00,
+  /* @244 '5' */
+  0x00, 0xFD, 0x83, 0x06, 0x0F, 0x91, 0x83, 0x07, 0x0D, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @258 '6' */
+  0x00, 0x3D, 0xC3, 0x0C, 0x1B, 0xB9, 0xE3, 0xC6, 0xCC, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @272 '7' */
+  0x01, 0xFE, 0x18, 0x30, 0xC1, 0x83, 0x06, 0x18, 0x30, 0x60, 0x00, 0x00, 0x00, 0x00,
+  /* @286 '8' */
+  0x00, 0xFB, 0x1E, 0x3C, 0x6F, 0xB1, 0xE3, 0xC7, 0x8D, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @300 '9' */
+  0x00, 0xF3, 0x36, 0x3C, 0x79, 0xDD, 0x83, 0x0C, 0x3B, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  /* @314 ':' */
+  0x00, 0xF0, 0x3C, 0x00,
+  /* @318 ';' */
+  0x00, 0x00, 0x33, 0x00, 0x06, 0x48, 0x80, 0x00,
+  /* @326 '<' */
+  0x00, 0x00, 0x00, 0x60, 0xC0, 0x81, 0x83, 0x00, 0x60, 0x08, 0x03, 0x00, 0x60, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @344 '=' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFC, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @362 '>' */
+  0x00, 0x00, 0x30, 0x06, 0x00, 0x80, 0x30, 0x06, 0x0C, 0x08, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @380 '?' */
+  0x00, 0x01, 0xF6, 0x3C, 0x60, 0xC7, 0x18, 0x30, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  /* @394 '@' */
+  0x00, 0xE4, 0x61, 0x86, 0x7A, 0x69, 0x9E, 0x04, 0x4E, 0x00, 0x00, 0x00,
+  /* @406 'A' */
+  0x00, 0x00, 0x07, 0xE0, 0x78, 0x12, 0x0C, 0xC3, 0x30, 0xFC, 0x61, 0x98, 0x6F, 0x3C, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @426 'B' */
+  0x00, 0x00, 0xFE, 0x63, 0x63, 0x63, 0x7E, 0x63, 0x63, 0x63, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @442 'C' */
+  0x00, 0x00, 0x0F, 0xAC, 0x3C, 0x0E, 0x03, 0x01, 0x80, 0xC0, 0xB0, 0x8F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @460 'D' */
+  0x00, 0x00, 0x3F, 0x8C, 0x66, 0x1B, 0x0D, 0x86, 0xC3, 0x61, 0xB1, 0xBF, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @478 'E' */
+  0x00, 0x00, 0xFF, 0x61, 0x61, 0x64, 0x7C, 0x64, 0x61, 0x61, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @494 'F' */
+  0x00, 0x00, 0x3F, 0xEC, 0x16, 0x0B, 0x21, 0xF0, 0xC8, 0x60, 0x30, 0x3E, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @512 'G' */
+  0x00, 0x00, 0x0F, 0x4C, 0x6C, 0x16, 0x03, 0x01, 0x9F, 0xC3, 0x31, 0x8F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @530 'H' */
+  0x00, 0x00, 0x3D, 0xEC, 0x66, 0x33, 0x19, 0xFC, 0xC6, 0x63, 0x31, 0xBD, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @548 'I' */
+  0x00, 0x00, 0xFF, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @564 'J' */
+  0x00, 0x00, 0x0F, 0xE0, 0xC0, 0x60, 0x30, 0x19, 0x8C, 0xC6, 0x63, 0x1F, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @582 'K' */
+  0x00, 0x00, 0x3D, 0xEC, 0x66, 0x63, 0x61, 0xE0, 0xF8, 0x66, 0x31, 0xBC, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @600 'L' */
+  0x00, 0x00, 0x3F, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x61, 0x30, 0x98, 0x7F, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @618 'M' */
+  0x00, 0x00, 0x03, 0x83, 0xB0, 0x67, 0x1C, 0xF7, 0x9A, 0xB3, 0x76, 0x64, 0xCC, 0x1B, 0xEF, 0x80,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @640 'N' */
+  0x00, 0x00, 0x39, 0xEC, 0x67, 0x33, 0xD9, 0xAC, 0xDE, 0x67, 0x31, 0xBC, 0xC0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @658 'O' */
+  0x00, 0x00, 0x0F, 0x8C, 0x6C, 0x1E, 0x0F, 0x07, 0x83, 0xC1, 0xB1, 0x8F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @676 'P' */
+  0x00, 0x00, 0xFE, 0x63, 0x63, 0x63, 0x63, 0x7E, 0x60, 0x60, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @692 'Q' */
+  0x00, 0x00, 0x0F, 0x8C, 0x6C, 0x1E, 0x0F, 0x07, 0x83, 0xC1, 0xB1, 0x8F, 0x83, 0x33, 0xF0, 0x00,
+  0x00, 0x00,
+  /* @710 'R' */
+  0x00, 0x00, 0x0F, 0xE1, 0x8C, 0x63, 0x18, 0xC7, 0xC1, 0x98, 0x63, 0x18, 0xCF, 0x9C, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @730 'S' */
+  0x00, 0x01, 0xFE, 0x3C, 0x7C, 0x1F, 0x07, 0xC7, 0x8F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @744 'T' */
+  0x00, 0x00, 0xFF, 0x99, 0x99, 0x99, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @760 'U' */
+  0x00, 0x00, 0x3D, 0xEC, 0x66, 0x33, 0x19, 0x8C, 0xC6, 0x63, 0x31, 0x8F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @778 'V' */
+  0x00, 0x00, 0x3D, 0xEC, 0x66, 0x31, 0xB0, 0xD8, 0x6C, 0x14, 0x0E, 0x07, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @796 'W' */
+  0x00, 0x00, 0x03, 0xEF, 0xB0, 0x66, 0x4C, 0xDD, 0x9B, 0xB1, 0x54, 0x3B, 0x87, 0x70, 0xC6, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @818 'X' */
+  0x00, 0x00, 0x3D, 0xEC, 0x63, 0x60, 0xE0, 0x70, 0x38, 0x36, 0x31, 0xBD, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @836 'Y' */
+  0x00, 0x00, 0x0F, 0x3D, 0x86, 0x33, 0x07, 0x80, 0xC0, 0x30, 0x0C, 0x03, 0x03, 0xF0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @856 'Z' */
+  0x00, 0x03, 0xFC, 0x38, 0xC3, 0x04, 0x18, 0x63, 0x87, 0xF8, 0x00, 0x00, 0x00, 0x00,
+  /* @870 '[' */
+  0x0F, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xF0, 0x00,
+  /* @878 '\\' */
+  0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x0C, 0x0C, 0x06, 0x06, 0x03, 0x03, 0x00, 0x00, 0x00,
+  /* @894 ']' */
+  0x0F, 0x33, 0x33, 0x33, 0x33, 0x33, 0xF0, 0x00,
+  /* @902 '^' */
+  0x10, 0x50, 0xA2, 0x28, 0x30, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @916 '_' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x07, 0xFF,
+  /* @938 '`' */
+  0x88, 0x80, 0x00, 0x00, 0x00, 0x00,
+  /* @944 'a' */
+  0x00, 0x00, 0x00, 0x00, 0x7C, 0x06, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @960 'b' */
+  0x00, 0x70, 0x18, 0x0C, 0x06, 0xE3, 0x99, 0x86, 0xC3, 0x61, 0xB9, 0xBB, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @978 'c' */
+  0x00, 0x00, 0x00, 0x00, 0x3D, 0x63, 0xC1, 0xC0, 0xC1, 0x63, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @994 'd' */
+  0x00, 0x03, 0x80, 0xC0, 0x63, 0xB3, 0x3B, 0x0D, 0x86, 0xC3, 0x33, 0x8E, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1012 'e' */
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xE3, 0x1B, 0x07, 0xFF, 0xC0, 0x30, 0xCF, 0xC0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1030 'f' */
+  0x00, 0x0F, 0xCC, 0x06, 0x0F, 0xE1, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x3F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1048 'g' */
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xBB, 0x3B, 0x0D, 0x86, 0xC3, 0x33, 0x8E, 0xC0, 0x60, 0x31, 0xF0,
+  0x00, 0x00,
+  /* @1066 'h' */
+  0x00, 0x70, 0x18, 0x0C, 0x06, 0xE3, 0x99, 0x8C, 0xC6, 0x63, 0x31, 0xBD, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1084 'i' */
+  0x00, 0x18, 0x18, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1100 'j' */
+  0x00, 0x61, 0x80, 0xFC, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x0F, 0xE0, 0x00,
+  /* @1112 'k' */
+  0x00, 0x70, 0x18, 0x0C, 0x06, 0xF3, 0x61, 0xE0, 0xF0, 0x6C, 0x33, 0x3B, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1130 'l' */
+  0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1146 'm' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x1B, 0x66, 0xD9, 0xB6, 0x6D, 0x9B, 0x6E, 0xDC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1166 'n' */
+  0x00, 0x00, 0x00, 0x00, 0x0E, 0xE3, 0x99, 0x8C, 0xC6, 0x63, 0x31, 0xBD, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1184 'o' */
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xE3, 0x1B, 0x07, 0x83, 0xC1, 0xB1, 0x8F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1202 'p' */
+  0x00, 0x00, 0x00, 0x00, 0x0E, 0xE3, 0x99, 0x86, 0xC3, 0x61, 0xB9, 0x9B, 0x8C, 0x06, 0x07, 0xC0,
+  0x00, 0x00,
+  /* @1220 'q' */
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xBB, 0x3B, 0x0D, 0x86, 0xC3, 0x33, 0x8E, 0xC0, 0x60, 0x30, 0x7C,
+  0x00, 0x00,
+  /* @1238 'r' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0x71, 0xCC, 0xC0, 0x60, 0x30, 0x18, 0x3F, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1256 's' */
+  0x00, 0x00, 0x00, 0x07, 0xF8, 0xFC, 0x3E, 0x0F, 0x8F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @1270 't' */
+  0x00, 0x30, 0x30, 0x30, 0xFE, 0x30, 0x30, 0x30, 0x30, 0x31, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1286 'u' */
+  0x00, 0x00, 0x00, 0x00, 0x0E, 0x73, 0x19, 0x8C, 0xC6, 0x63, 0x33, 0x8E, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1304 'v' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0x7B, 0x19, 0x8C, 0x6C, 0x36, 0x0E, 0x07, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1322 'w' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x1E, 0xC1, 0x99, 0x33, 0x76, 0x3B, 0x87, 0x70, 0xC6, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1344 'x' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0x79, 0xB0, 0x70, 0x38, 0x1C, 0x1B, 0x3D, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00,
+  /* @1362 'y' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0xD8, 0x63, 0x30, 0xCC, 0x16, 0x07, 0x80, 0xC0, 0x30, 0x18,
+  0x1F, 0x00, 0x00, 0x00,
+  /* @1382 'z' */
+  0x00, 0x00, 0x00, 0x0F, 0xF0, 0xC3, 0x1C, 0x61, 0x87, 0xF8, 0x00, 0x00, 0x00, 0x00,
+  /* @1396 '{' */
+  0x03, 0x66, 0x66, 0x6C, 0x66, 0x66, 0x30, 0x00,
+  /* @1404 '|' */
+  0x3F, 0xFF, 0xFF, 0xC0,
+  /* @1408 '}' */
+  0x0C, 0x66, 0x66, 0x63, 0x66, 0x66, 0xC0, 0x00,
+  /* @1416 '~' */
+  0x00, 0x00, 0x00, 0x00, 0x0C, 0x24, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const sGLYPH PFont16_Glyphs[] =
+{
+  {    0,   0,    0,   6}, /* ' ' */
+  {    0,   2,    0,   3}, /* '!' */
+  {    4,   7,    0,   8}, /* '"' */
+  {   18,   8,    0,   9}, /* '#' */
+  {   34,   7,    0,   8}, /* '$' */
+  {   48,   8,    0,   9}, /* '%' */
+  {   64,   7,    0,   8}, /* '&' */
+  {   78,   3,    0,   4}, /* ''' */
+  {   84,   4,    0,   5}, /* '(' */
+  {   92,   4,    0,   5}, /* ')' */
+  {  100,   8,    0,   9}, /* '*' */
+  {  116,   7,    0,   8}, /* '+' */
+  {  130,   3,    0,   4}, /* ',' */
+  {  136,   7,    0,   8}, /* '-' */
+  {  150,   2,    0,   3}, /* '.' */
+  {  154,   8,    0,   9}, /* '/' */
+  {  170,   7,    0,   8}, /* '0' */
+  {  184,   8,    0,   9}, /* '1' */
+  {  200,   7,    0,   8}, /* '2' */
+  {  214,   8,    0,   9}, /* '3' */
+  {  230,   7,    0,   8}, /* '4' */
+  {  244,   7,    0,   8}, /* '5' */
+  {  258,   7,    0,   8}, /* '6' */
+  {  272,   7,    0,   8}, /* '7' */
+  {  286,   7,    0,   8}, /* '8' */
+  {  300,   7,    0,   8}, /* '9' */
+  {  314,   2,    0,   3}, /* ':' */
+  {  318,   4,    0,   5}, /* ';' */
+  {  326,   9,    0,  10}, /* '<' */
+  {  344,   9,    0,  10}, /* '=' */
+  {  362,   9,    0,  10}, /* '>' */
+  {  380,   7,    0,   8}, /* '?' */
+  {  394,   6,    0,   7}, /* '@' */
+  {  406,  10,    0,  11}, /* 'A' */
+  {  426,   8,    0,   9}, /* 'B' */
+  {  442,   9,    0,  10}, /* 'C' */
+  {  460,   9,    0,  10}, /* 'D' */
+  {  478,   8,    0,   9}, /* 'E' */
+  {  494,   9,    0,  10}, /* 'F' */
+  {  512,   9,    0,  10}, /* 'G' */
+  {  530,   9,    0,  10}, /* 'H' */
+  {  548,   8,    0,   9}, /* 'I' */
+  {  564,   9,    0,  10}, /* 'J' */
+  {  582,   9,    0,  10}, /* 'K' */
+  {  600,   9,    0,  10}, /* 'L' */
+  {  618,  11,    0,  12}, /* 'M' */
+  {  640,   9,    0,  10}, /* 'N' */
+  {  658,   9,    0,  10}, /* 'O' */
+  {  676,   8,    0,   9}, /* 'P' */
+  {  692,   9,    0,  10}, /* 'Q' */
+  {  710,  10,    0,  11}, /* 'R' */
+  {  730,   7,    0,   8}, /* 'S' */
+  {  744,   8,    0,   9}, /* 'T' */
+  {  760,   9,    0,  10}, /* 'U' */
+  {  778,   9,    0,  10}, /* 'V' */
+  {  796,  11,    0,  12}, /* 'W' */
+  {  818,   9,    0,  10}, /* 'X' */
+  {  836,  10,    0,  11}, /* 'Y' */
+  {  856,   7,    0,   8}, /* 'Z' */
+  {  870,   4,    0,   5}, /* '[' */
+  {  878,   8,    0,   9}, /* '\\' */
+  {  894,   4,    0,   5}, /* ']' */
+  {  902,   7,    0,   8}, /* '^' */
+  {  916,  11,    0,  12}, /* '_' */
+  {  938,   3,    0,   4}, /* '`' */
+  {  944,   8,    0,   9}, /* 'a' */
+  {  960,   9,    0,  10}, /* 'b' */
+  {  978,   8,    0,   9}, /* 'c' */
+  {  994,   9,    0,  10}, /* 'd' */
+  { 1012,   9,    0,  10}, /* 'e' */
+  { 1030,   9,    0,  10}, /* 'f' */
+  { 1048,   9,    0,  10}, /* 'g' */
+  { 1066,   9,    0,  10}, /* 'h' */
+  { 1084,   8,    0,   9}, /* 'i' */
+  { 1100,   6,    0,   7}, /* 'j' */
+  { 1112,   9,    0,  10}, /* 'k' */
+  { 1130,   8,    0,   9}, /* 'l' */
+  { 1146,  10,    0,  11}, /* 'm' */
+  { 1166,   9,    0,  10}, /* 'n' */
+  { 1184,   9,    0,  10}, /* 'o' */
+  { 1202,   9,    0,  10}, /* 'p' */
+  { 1220,   9,    0,  10}, /* 'q' */
+  { 1238,   9,    0,  10}, /* 'r' */
+  { 1256,   7,    0,   8}, /* 's' */
+  { 1270,   8,    0,   9}, /* 't' */
+  { 1286,   9,    0,  10}, /* 'u' */
+  { 1304,   9,    0,  10}, /* 'v' */
+  { 1322,  11,    0,  12}, /* 'w' */
+  { 1344,   9,    0,  10}, /* 'x' */
+  { 1362,  10,    0,  11}, /* 'y' */
+  { 1382,   7,    0,   8}, /* 'z' */
+  { 1396,   4,    0,   5}, /* '{' */
+  { 1404,   2,    0,   3}, /* '|' */
+  { 1408,   4,    0,   5}, /* '}' */
+  { 1416,   7,    0,   8}, /* '~' */
+};
+
+const sPFONT PFont16 =
+{
+  PFont16_Data,
+  PFont16_Glyphs,
+  16,    /* Height */
+  0x20,  /* FirstChar */
+  0x7E,  /* LastChar */
+  1,     /* Bpp */
+  PFONT_ENCODING_PACKED
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,510 @@
+/**
+  ******************************************************************************
+  * @file    pfont24.c
+  * @author  MCD Application Team
+  * @brief   This file provides the PFont24 proportional font generated by
+  *          pfontgen.py from font24.c.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fonts.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup FONTS
+  * @{
+  */
+
+/** @defgroup FONTS_Private_Variables
+  * @{
+  */
+static const uint8_t PFont24_Data[] =
+{
+  /* @0 '!' */
+  0x03, 0xFF, 0xFF, 0xFF, 0xA4, 0x07, 0xE0, 0x00, 0x00,
+  /* @9 '"' */
+  0x00, 0x00, 0x00, 0xE7, 0xE7, 0xE7, 0x42, 0x42, 0x42, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @33 '#' */
+  0x00, 0x00, 0x00, 0x66, 0x0C, 0xC1, 0x98, 0x33, 0x06, 0x67, 0xFF, 0xFF, 0xE3, 0x30, 0xCC, 0x7F,
+  0xFF, 0xFE, 0x66, 0x0C, 0xC1, 0x98, 0x33, 0x06, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @66 '$' */
+  0x00, 0x06, 0x03, 0x07, 0xB7, 0xFE, 0x1F, 0x0F, 0xC0, 0x7C, 0x1F, 0x81, 0xF8, 0x3E, 0x1F, 0x1F,
+  0xFD, 0xBC, 0x0C, 0x06, 0x03, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00,
+  /* @93 '%' */
+  0x00, 0x00, 0x03, 0xC1, 0xF8, 0xE7, 0x30, 0xCC, 0x33, 0x9C, 0x7F, 0xCF, 0xCF, 0xF8, 0xE7, 0x30,
+  0xCC, 0x33, 0x9C, 0x7E, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @123 '&' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xF8, 0x7F, 0x18, 0xC3, 0x00, 0x60, 0x06, 0x00, 0xE0, 0x3E,
+  0x7E, 0xFF, 0x8F, 0x30, 0xE3, 0xFF, 0x3E, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @156 ''' */
+  0x00, 0x7F, 0xD2, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @165 '(' */
+  0x00, 0x00, 0xC7, 0x39, 0xE7, 0x1C, 0xE3, 0x8E, 0x38, 0xE3, 0x87, 0x1C, 0x38, 0xE1, 0xC3, 0x00,
+  0x00, 0x00,
+  /* @183 ')' */
+  0x00, 0x0C, 0x38, 0x71, 0xC3, 0x8E, 0x1C, 0x71, 0xC7, 0x1C, 0x73, 0x8E, 0x79, 0xCE, 0x30, 0x00,
+  0x00, 0x00,
+  /* @201 '*' */
+  0x00, 0x00, 0x00, 0xC0, 0x30, 0x0C, 0x3B, 0x7F, 0xFC, 0xFC, 0x1E, 0x07, 0x83, 0x30, 0xCC, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @231 '+' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x0F, 0xFF, 0xFF,
+  0xF0, 0x60, 0x06, 0x00, 0x60, 0x06, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @267 ',' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE6, 0x73, 0x19, 0x8C, 0x00, 0x00,
+  /* @282 '-' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @312 '.' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xF0, 0x00, 0x00, 0x00,
+  /* @324 '/' */
+  0x00, 0xC0, 0x30, 0x1C, 0x06, 0x03, 0x80, 0xC0, 0x30, 0x18, 0x06, 0x03, 0x00, 0xC0, 0x60, 0x18,
+  0x0C, 0x03, 0x01, 0xC0, 0x60, 0x38, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @354 '0' */
+  0x00, 0x00, 0x01, 0xE0, 0xFC, 0x61, 0x98, 0x6C, 0x0F, 0x03, 0xC0, 0xF0, 0x3C, 0x0F, 0x03, 0xC0,
+  0xD8, 0x66, 0x18, 0xFC, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @384 '1' */
+  0x00, 0x00, 0x00, 0x40, 0xF0, 0xFC, 0x3B, 0x00, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0xC0, 0x30, 0x0C,
+  0x03, 0x00, 0xC3, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @414 '2' */
+  0x00, 0x00, 0x00, 0x7C, 0x3F, 0xEE, 0x0D, 0x80, 0xF0, 0x18, 0x03, 0x00, 0xC0, 0x30, 0x1C, 0x07,
+  0x01, 0x80, 0x60, 0x18, 0x07, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @447 '3' */
+  0x00, 0x00, 0x01, 0xE1, 0xFC, 0x63, 0x80, 0x60, 0x18, 0x0C, 0x1E, 0x07, 0xC0, 0x38, 0x03, 0x00,
+  0xC0, 0x3C, 0x1F, 0xFE, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @477 '4' */
+  0x00, 0x00, 0x00, 0x0E, 0x03, 0xC0, 0x78, 0x1B, 0x06, 0x60, 0xCC, 0x31, 0x86, 0x31, 0x86, 0x60,
+  0xCF, 0xFF, 0xFF, 0xC0, 0x60, 0x7F, 0x0F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @510 '5' */
+  0x00, 0x00, 0x01, 0xFF, 0x3F, 0xE6, 0x00, 0xC0, 0x18, 0x03, 0x78, 0x7F, 0xCE, 0x18, 0x01, 0x80,
+  0x30, 0x06, 0x00, 0xF0, 0x37, 0xFE, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @543 '6' */
+  0x00, 0x00, 0x00, 0x7C, 0x7F, 0x38, 0x1C, 0x06, 0x03, 0x00, 0xDE, 0x3F, 0xEE, 0x1B, 0x03, 0xC0,
+  0xF0, 0x36, 0x1D, 0xFE, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @573 '7' */
+  0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xC0, 0xF0, 0x70, 0x18, 0x06, 0x03, 0x80, 0xC0, 0x30, 0x1C, 0x06,
+  0x01, 0x80, 0xE0, 0x30, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @603 '8' */
+  0x00, 0x00, 0x03, 0xF1, 0xFE, 0xE1, 0xF0, 0x3C, 0x0D, 0x86, 0x3F, 0x0F, 0xC6, 0x1B, 0x03, 0xC0,
+  0xF0, 0x3E, 0x1D, 0xFE, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @633 '9' */
+  0x00, 0x00, 0x03, 0xE1, 0xFE, 0xE1, 0xB0, 0x3C, 0x0F, 0x03, 0x61, 0xDF, 0xF1, 0xEC, 0x03, 0x01,
+  0x80, 0xE0, 0x73, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @663 ':' */
+  0x00, 0x00, 0x00, 0xFF, 0xF0, 0x00, 0x00, 0xFF, 0xF0, 0x00, 0x00, 0x00,
+  /* @675 ';' */
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xCF, 0x3C, 0x00, 0x00, 0x00, 0xE7, 0x18, 0x63, 0x08, 0x00, 0x00,
+  0x00, 0x00,
+  /* @693 '<' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0xF0, 0x0F, 0x00, 0xF0, 0x0F, 0x00,
+  0xF0, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x1C, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @735 '=' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xF8, 0x00,
+  0x00, 0x01, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @774 '>' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0x03, 0xC0,
+  0x03, 0xC0, 0x03, 0xC0, 0x3C, 0x03, 0xC0, 0x3C, 0x03, 0xC0, 0x3C, 0x00, 0xE0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @816 '?' */
+  0x00, 0x00, 0x00, 0x07, 0xC7, 0xF6, 0x1F, 0x07, 0x83, 0x03, 0x83, 0x87, 0x83, 0x81, 0x80, 0x00,
+  0x00, 0x70, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @843 '@' */
+  0x00, 0x00, 0x01, 0xF0, 0xFE, 0x71, 0xD8, 0x3C, 0x3F, 0x1F, 0xCE, 0xF3, 0x3C, 0xCF, 0x33, 0xC7,
+  0xF0, 0xFC, 0x01, 0x80, 0x70, 0xCF, 0xF1, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @873 'A' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x03, 0x60,
+  0x06, 0x30, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8, 0x1F, 0xF8, 0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F,
+  0xFC, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @921 'B' */
+  0x00, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x8F, 0xFE, 0x18, 0x38, 0xC0, 0xC6, 0x06, 0x30, 0x71, 0xFF,
+  0x0F, 0xFC, 0x60, 0x73, 0x01, 0x98, 0x0C, 0xC0, 0x7F, 0xFE, 0xFF, 0xE0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @960 'C' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xFB, 0x3F, 0xF7, 0x07, 0x60, 0x3C, 0x03, 0xC0, 0x0C, 0x00, 0xC0,
+  0x0C, 0x00, 0xC0, 0x06, 0x03, 0x70, 0x73, 0xFE, 0x0F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @996 'D' */
+  0x00, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x0F, 0xFE, 0x18, 0x38, 0xC0, 0xC6, 0x03, 0x30, 0x19, 0x80,
+  0xCC, 0x06, 0x60, 0x33, 0x01, 0x98, 0x18, 0xC1, 0xDF, 0xFC, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1035 'E' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xF3, 0x03, 0x30, 0x33, 0x33, 0x33, 0x03, 0xF0, 0x3F,
+  0x03, 0x30, 0x33, 0x33, 0x03, 0x30, 0x3F, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1071 'F' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xF3, 0x03, 0x30, 0x33, 0x33, 0x33, 0x03, 0xF0, 0x3F,
+  0x03, 0x30, 0x33, 0x03, 0x00, 0x30, 0x0F, 0xF0, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1107 'G' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x63, 0xFF, 0x38, 0x39, 0x80, 0xD8, 0x06, 0xC0, 0x06, 0x00,
+  0x30, 0xFF, 0x87, 0xFC, 0x03, 0x70, 0x19, 0xC1, 0xC7, 0xFE, 0x0F, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1146 'H' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0xFC, 0xFC, 0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30,
+  0xFF, 0xC3, 0xFF, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x3F, 0x3F, 0xFC, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1188 'I' */
+  0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xC3, 0x00, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0xC0, 0x30, 0x0C,
+  0x03, 0x00, 0xC3, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1218 'J' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF1, 0xFF, 0x80, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x06,
+  0x30, 0x31, 0x81, 0x8C, 0x0C, 0x60, 0x63, 0x06, 0x1F, 0xF0, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1257 'K' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xF3, 0xEF, 0xE7, 0xC6, 0x0C, 0x0C, 0x30, 0x18, 0xC0, 0x33,
+  0x00, 0x6E, 0x00, 0xFE, 0x01, 0xCE, 0x03, 0x0E, 0x06, 0x0C, 0x0C, 0x1C, 0x7F, 0x1F, 0xFE, 0x3E,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1302 'L' */
+  0x00, 0x00, 0x00, 0x00, 0x01, 0xFE, 0x0F, 0xF0, 0x0C, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC0,
+  0x06, 0x00, 0x30, 0x31, 0x81, 0x8C, 0x0C, 0x60, 0x7F, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1341 'M' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x0F, 0xF8, 0x1F, 0x38, 0x1C, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x36, 0x6C, 0x36, 0x6C, 0x33, 0xCC, 0x33, 0xCC, 0x31, 0x8C, 0x30, 0x0C, 0x30, 0x0C, 0xFE, 0x7F,
+  0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1389 'N' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x7F, 0xF1, 0xFC, 0xE0, 0xC3, 0xC3, 0x0F, 0x8C, 0x36, 0x30,
+  0xDC, 0xC3, 0x3B, 0x0C, 0x6C, 0x31, 0xF0, 0xC3, 0xC3, 0x07, 0x3F, 0x8C, 0xFE, 0x30, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1431 'O' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0xC7, 0x0E, 0x60, 0x6E, 0x07, 0xC0, 0x3C, 0x03, 0xC0,
+  0x3C, 0x03, 0xE0, 0x76, 0x06, 0x70, 0xE3, 0xFC, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1467 'P' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0xFC, 0xFF, 0xE3, 0x07, 0x30, 0x33, 0x03, 0x30, 0x33, 0x06, 0x3F,
+  0xE3, 0xF8, 0x30, 0x03, 0x00, 0x30, 0x0F, 0xF0, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1503 'Q' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0xC7, 0x0E, 0x60, 0x6E, 0x07, 0xC0, 0x3C, 0x03, 0xC0,
+  0x3C, 0x03, 0xE0, 0x76, 0x06, 0x70, 0xE3, 0xFC, 0x1F, 0x01, 0xF3, 0x3F, 0xF3, 0x0E, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1539 'R' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF0, 0xFF, 0xE0, 0xC1, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x70,
+  0xFF, 0x83, 0xF8, 0x0C, 0x70, 0x30, 0xE0, 0xC1, 0x83, 0x07, 0x3F, 0x8F, 0xFE, 0x1C, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1581 'S' */
+  0x00, 0x00, 0x00, 0x00, 0xFB, 0x7F, 0xF8, 0x7C, 0x0F, 0x03, 0xF0, 0x1F, 0x81, 0xF8, 0x0F, 0xC0,
+  0xF0, 0x3E, 0x1F, 0xFE, 0xDF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1611 'T' */
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFC, 0x63, 0xC6, 0x3C, 0x63, 0xC6, 0x30, 0x60, 0x06,
+  0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x03, 0xFC, 0x3F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @1647 'U' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0xFC, 0xFC, 0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30,
+  0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC1, 0x86, 0x07, 0xF8, 0x07, 0x80, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1689 'V' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xF7, 0xFF, 0xEF, 0xE6, 0x03, 0x06, 0x0C, 0x0C, 0x18, 0x18,
+  0x30, 0x18, 0xC0, 0x31, 0x80, 0x36, 0x00, 0x6C, 0x00, 0xD8, 0x00, 0xE0, 0x01, 0xC0, 0x01, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1734 'W' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xC7, 0xFF, 0xE3, 0xF9, 0x80, 0x30, 0xC0, 0x18, 0x61,
+  0x0C, 0x19, 0xCC, 0x0C, 0xE6, 0x06, 0xDB, 0x03, 0x6D, 0x81, 0xE7, 0xC0, 0x71, 0xC0, 0x38, 0xE0,
+  0x18, 0x30, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00,
+  /* @1785 'X' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0xFC, 0xFC, 0xC0, 0xC1, 0x86, 0x03, 0x30, 0x07, 0x80,
+  0x0C, 0x00, 0x30, 0x01, 0xE0, 0x0C, 0xC0, 0x61, 0x83, 0x03, 0x3F, 0x3F, 0xFC, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1827 'Y' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x3F, 0xF8, 0xFC, 0xC0, 0xC1, 0x86, 0x03, 0x30, 0x0C, 0xC0,
+  0x1E, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x07, 0xF8, 0x1F, 0xE0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1869 'Z' */
+  0x00, 0x00, 0x00, 0x00, 0x3F, 0xF7, 0xFE, 0xC0, 0xD8, 0x33, 0x0C, 0x63, 0x00, 0xC0, 0x30, 0x0C,
+  0x33, 0x06, 0xC0, 0xF0, 0x1F, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @1902 '[' */
+  0x00, 0x3F, 0xFC, 0x63, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xC6, 0x3F, 0xF0, 0x00, 0x00,
+  /* @1917 '\\' */
+  0xC0, 0x30, 0x0E, 0x01, 0x80, 0x70, 0x0C, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0xC0, 0x18, 0x06,
+  0x00, 0xC0, 0x30, 0x0E, 0x01, 0x80, 0x70, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @1947 ']' */
+  0x00, 0x3F, 0xF1, 0x8C, 0x63, 0x18, 0xC6, 0x31, 0x8C, 0x63, 0x18, 0xFF, 0xF0, 0x00, 0x00,
+  /* @1962 '^' */
+  0x00, 0x00, 0x80, 0x38, 0x0F, 0x83, 0xB8, 0x63, 0x18, 0x36, 0x03, 0x80, 0x20, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+  /* @1995 '_' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+  /* @2043 '`' */
+  0x06, 0x38, 0x71, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2058 'a' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x07, 0xF8, 0x00, 0xC0, 0x0C, 0x1F,
+  0xC7, 0xFC, 0xE0, 0xCC, 0x0C, 0xC1, 0xC7, 0xFF, 0x3E, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2094 'b' */
+  0x00, 0x00, 0x00, 0x3C, 0x01, 0xE0, 0x03, 0x00, 0x18, 0x00, 0xDF, 0x07, 0xFE, 0x38, 0x31, 0x80,
+  0xCC, 0x06, 0x60, 0x33, 0x01, 0x98, 0x0C, 0xE0, 0xDF, 0xFE, 0xF7, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2133 'c' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xB3, 0xFF, 0x70, 0x7E, 0x03, 0xC0,
+  0x3C, 0x00, 0xC0, 0x0E, 0x03, 0x70, 0x73, 0xFE, 0x0F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2169 'd' */
+  0x00, 0x00, 0x00, 0x00, 0x78, 0x03, 0xC0, 0x06, 0x00, 0x30, 0x7D, 0x8F, 0xFC, 0x60, 0xE6, 0x03,
+  0x30, 0x19, 0x80, 0xCC, 0x06, 0x60, 0x31, 0x83, 0x8F, 0xFF, 0x1F, 0x78, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2208 'e' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x87, 0xFE, 0x60, 0x6C, 0x03, 0xFF,
+  0xFF, 0xFF, 0xC0, 0x0C, 0x00, 0x60, 0x37, 0xFF, 0x1F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2244 'f' */
+  0x00, 0x00, 0x00, 0x07, 0xF0, 0xFF, 0x18, 0x01, 0x80, 0xFF, 0xEF, 0xFE, 0x18, 0x01, 0x80, 0x18,
+  0x01, 0x80, 0x18, 0x01, 0x80, 0x18, 0x0F, 0xFC, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2280 'g' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7D, 0xEF, 0xFF, 0x60, 0xE6, 0x03,
+  0x30, 0x19, 0x80, 0xCC, 0x06, 0x60, 0x31, 0x83, 0x8F, 0xFC, 0x1F, 0x60, 0x03, 0x00, 0x18, 0x01,
+  0xC3, 0xFC, 0x1F, 0x80, 0x00, 0x00, 0x00,
+  /* @2319 'h' */
+  0x00, 0x00, 0x00, 0x0F, 0x00, 0x3C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x7C, 0x0F, 0xF8, 0x38, 0x70,
+  0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x3F, 0x3F, 0xFC, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2361 'i' */
+  0x00, 0x00, 0x00, 0x06, 0x00, 0x60, 0x00, 0x00, 0x00, 0x7E, 0x07, 0xE0, 0x06, 0x00, 0x60, 0x06,
+  0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x0F, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2397 'j' */
+  0x00, 0x00, 0x01, 0x80, 0xC0, 0x00, 0x03, 0xFF, 0xFF, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x0C,
+  0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x7F, 0xF7, 0xE0, 0x00, 0x00,
+  /* @2424 'k' */
+  0x00, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x30, 0x03, 0x00, 0x33, 0xE3, 0x3E, 0x33, 0x03, 0x60, 0x3E,
+  0x03, 0xC0, 0x3E, 0x03, 0x70, 0x33, 0x8F, 0x1F, 0xF1, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2460 'l' */
+  0x00, 0x00, 0x00, 0x7E, 0x07, 0xE0, 0x06, 0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x00, 0x60, 0x06,
+  0x00, 0x60, 0x06, 0x00, 0x60, 0x06, 0x0F, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2496 'm' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF7, 0x78, 0xFF, 0xFC,
+  0x39, 0xCC, 0x31, 0x8C, 0x31, 0x8C, 0x31, 0x8C, 0x31, 0x8C, 0x31, 0x8C, 0x31, 0x8C, 0xFD, 0xEF,
+  0xFD, 0xEF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2544 'n' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x7C, 0x3F, 0xF8, 0x38, 0x70,
+  0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x3F, 0x3F, 0xFC, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2586 'o' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03, 0xFC, 0x70, 0xEE, 0x07, 0xC0,
+  0x3C, 0x03, 0xC0, 0x3E, 0x07, 0x70, 0xE3, 0xFC, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2622 'p' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xDF, 0x1F, 0xFE, 0x38, 0x31, 0x80,
+  0xCC, 0x06, 0x60, 0x33, 0x01, 0x98, 0x0C, 0xE0, 0xC7, 0xFE, 0x37, 0xC1, 0x80, 0x0C, 0x00, 0x60,
+  0x0F, 0xE0, 0x7F, 0x00, 0x00, 0x00, 0x00,
+  /* @2661 'q' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7D, 0xEF, 0xFF, 0x60, 0xE6, 0x03,
+  0x30, 0x19, 0x80, 0xCC, 0x06, 0x60, 0x31, 0x83, 0x8F, 0xFC, 0x1F, 0x60, 0x03, 0x00, 0x18, 0x00,
+  0xC0, 0x3F, 0x81, 0xFC, 0x00, 0x00, 0x00,
+  /* @2700 'r' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF9, 0xEF, 0xBF, 0x1F, 0x31, 0xC0, 0x18,
+  0x01, 0x80, 0x18, 0x01, 0x80, 0x18, 0x0F, 0xFC, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2736 's' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFD, 0xFF, 0xC0, 0xF0, 0x3F, 0xC1, 0xFE, 0x07,
+  0xF0, 0x3C, 0x1F, 0xFE, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2766 't' */
+  0x00, 0x00, 0x00, 0x30, 0x03, 0x00, 0x30, 0x03, 0x00, 0xFF, 0xCF, 0xFC, 0x30, 0x03, 0x00, 0x30,
+  0x03, 0x00, 0x30, 0x03, 0x00, 0x30, 0x71, 0xFF, 0x0F, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2802 'u' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30,
+  0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x07, 0x07, 0xFF, 0x0F, 0xBC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2844 'v' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x87, 0xFE, 0x1F, 0x30, 0x30,
+  0xC0, 0xC1, 0x86, 0x06, 0x18, 0x0C, 0xC0, 0x33, 0x00, 0xFC, 0x01, 0xE0, 0x07, 0x80, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2886 'w' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC1, 0xFE, 0x0F, 0x62, 0x33, 0x39,
+  0x99, 0xCC, 0x6A, 0xC3, 0xDE, 0x1E, 0xF0, 0xE3, 0x03, 0x18, 0x18, 0xC0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @2925 'x' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF9, 0xFF, 0x9F, 0x30, 0xC1, 0x98, 0x0F,
+  0x00, 0x60, 0x0F, 0x01, 0x98, 0x30, 0xCF, 0x9F, 0xF9, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+  /* @2961 'y' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x0F, 0xFE, 0x1F, 0x30,
+  0x18, 0x30, 0x60, 0x60, 0xC0, 0x63, 0x00, 0xC6, 0x00, 0xD8, 0x01, 0xF0, 0x01, 0xC0, 0x01, 0x80,
+  0x06, 0x00, 0x0C, 0x00, 0x30, 0x07, 0xF8, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00,
+  /* @3006 'z' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xC1, 0xB0, 0xC0, 0x60, 0x30, 0x18,
+  0x0C, 0x36, 0x0F, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  /* @3036 '{' */
+  0x00, 0x01, 0xCF, 0x30, 0xC3, 0x0C, 0x30, 0xC7, 0x38, 0x70, 0xC3, 0x0C, 0x30, 0xC3, 0xC7, 0x00,
+  0x00, 0x00,
+  /* @3054 '|' */
+  0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+  /* @3060 '}' */
+  0x00, 0x0E, 0x3C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0x87, 0x38, 0xC3, 0x0C, 0x30, 0xCF, 0x38, 0x00,
+  0x00, 0x00,
+  /* @3078 '~' */
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x0F, 0x8F, 0xBB, 0xE3,
+  0xE0, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00,
+};
+
+static const sGLYPH PFont24_Glyphs[] =
+{
+  {    0,   0,    0,   9}, /* ' ' */
+  {    0,   3,    0,   4}, /* '!' */
+  {    9,   8,    0,   9}, /* '"' */
+  {   33,  11,    0,  12}, /* '#' */
+  {   66,   9,    0,  10}, /* '$' */
+  {   93,  10,    0,  11}, /* '%' */
+  {  123,  11,    0,  12}, /* '&' */
+  {  156,   3,    0,   4}, /* ''' */
+  {  165,   6,    0,   7}, /* '(' */
+  {  183,   6,    0,   7}, /* ')' */
+  {  201,  10,    0,  11}, /* '*' */
+  {  231,  12,    0,  13}, /* '+' */
+  {  267,   5,    0,   6}, /* ',' */
+  {  282,  10,    0,  11}, /* '-' */
+  {  312,   4,    0,   5}, /* '.' */
+  {  324,  10,    0,  11}, /* '/' */
+  {  354,  10,    0,  11}, /* '0' */
+  {  384,  10,    0,  11}, /* '1' */
+  {  414,  11,    0,  12}, /* '2' */
+  {  447,  10,    0,  11}, /* '3' */
+  {  477,  11,    0,  12}, /* '4' */
+  {  510,  11,    0,  12}, /* '5' */
+  {  543,  10,    0,  11}, /* '6' */
+  {  573,  10,    0,  11}, /* '7' */
+  {  603,  10,    0,  11}, /* '8' */
+  {  633,  10,    0,  11}, /* '9' */
+  {  663,   4,    0,   5}, /* ':' */
+  {  675,   6,    0,   7}, /* ';' */
+  {  693,  14,    0,  15}, /* '<' */
+  {  735,  13,    0,  14}, /* '=' */
+  {  774,  14,    0,  15}, /* '>' */
+  {  816,   9,    0,  10}, /* '?' */
+  {  843,  10,    0,  11}, /* '@' */
+  {  873,  16,    0,  17}, /* 'A' */
+  {  921,  13,    0,  14}, /* 'B' */
+  {  960,  12,    0,  13}, /* 'C' */
+  {  996,  13,    0,  14}, /* 'D' */
+  { 1035,  12,    0,  13}, /* 'E' */
+  { 1071,  12,    0,  13}, /* 'F' */
+  { 1107,  13,    0,  14}, /* 'G' */
+  { 1146,  14,    0,  15}, /* 'H' */
+  { 1188,  10,    0,  11}, /* 'I' */
+  { 1218,  13,    0,  14}, /* 'J' */
+  { 1257,  15,    0,  16}, /* 'K' */
+  { 1302,  13,    0,  14}, /* 'L' */
+  { 1341,  16,    0,  17}, /* 'M' */
+  { 1389,  14,    0,  15}, /* 'N' */
+  { 1431,  12,    0,  13}, /* 'O' */
+  { 1467,  12,    0,  13}, /* 'P' */
+  { 1503,  12,    0,  13}, /* 'Q' */
+  { 1539,  14,    0,  15}, /* 'R' */
+  { 1581,  10,    0,  11}, /* 'S' */
+  { 1611,  12,    0,  13}, /* 'T' */
+  { 1647,  14,    0,  15}, /* 'U' */
+  { 1689,  15,    0,  16}, /* 'V' */
+  { 1734,  17,    0,  18}, /* 'W' */
+  { 1785,  14,    0,  15}, /* 'X' */
+  { 1827,  14,    0,  15}, /* 'Y' */
+  { 1869,  11,    0,  12}, /* 'Z' */
+  { 1902,   5,    0,   6}, /* '[' */
+  { 1917,  10,    0,  11}, /* '\\' */
+  { 1947,   5,    0,   6}, /* ']' */
+  { 1962,  11,    0,  12}, /* '^' */
+  { 1995,  16,    0,  17}, /* '_' */
+  { 2043,   5,    0,   6}, /* '`' */
+  { 2058,  12,    0,  13}, /* 'a' */
+  { 2094,  13,    0,  14}, /* 'b' */
+  { 2133,  12,    0,  13}, /* 'c' */
+  { 2169,  13,    0,  14}, /* 'd' */
+  { 2208,  12,    0,  13}, /* 'e' */
+  { 2244,  12,    0,  13}, /* 'f' */
+  { 2280,  13,    0,  14}, /* 'g' */
+  { 2319,  14,    0,  15}, /* 'h' */
+  { 2361,  12,    0,  13}, /* 'i' */
+  { 2397,   9,    0,  10}, /* 'j' */
+  { 2424,  12,    0,  13}, /* 'k' */
+  { 2460,  12,    0,  13}, /* 'l' */
+  { 2496,  16,    0,  17}, /* 'm' */
+  { 2544,  14,    0,  15}, /* 'n' */
+  { 2586,  12,    0,  13}, /* 'o' */
+  { 2622,  13,    0,  14}, /* 'p' */
+  { 2661,  13,    0,  14}, /* 'q' */
+  { 2700,  12,    0,  13}, /* 'r' */
+  { 2736,  10,    0,  11}, /* 's' */
+  { 2766,  12,    0,  13}, /* 't' */
+  { 2802,  14,    0,  15}, /* 'u' */
+  { 2844,  14,    0,  15}, /* 'v' */
+  { 2886,  13,    0,  14}, /* 'w' */
+  { 2925,  12,    0,  13}, /* 'x' */
+  { 2961,  15,    0,  16}, /* 'y' */
+  { 3006,  10,    0,  11}, /* 'z' */
+  { 3036,   6,    0,   7}, /* '{' */
+  { 3054,   2,    0,   3}, /* '|' */
+  { 3060,   6,    0,   7}, /* '}' */
+  { 3078,  11,    0,  12}, /* '~' */
+};
+
+const sPFONT PFont24 =
+{
+  PFont24_Data,
+  PFont24_Glyphs,
+  24,    /* Height */
+  0x20,  /* FirstChar */
+  0x7E,  /* LastChar */
+  1,     /* Bpp */
+  PFONT_ENCODING_PACKED
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
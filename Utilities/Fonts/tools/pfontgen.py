@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+  @file    pfontgen.py
+  @author  MCD Application Team
+  @brief   Generates proportional, compressed fonts (sPFONT, see fonts.h) for
+           the STM32 LCD utility.
+
+  Copyright (c) 2018 STMicroelectronics.
+  All rights reserved.
+
+  This software component is licensed by ST under BSD 3-Clause license,
+  the "License"; You may not use this file except in compliance with the
+  License. You may obtain a copy of the License at:
+                         opensource.org/licenses/BSD-3-Clause
+
+  Usage:
+    Convert a fixed width sFONT table (glyphs are trimmed to their used
+    columns, 1 bpp):
+      pfontgen.py --sfont ../font16.c --name PFont16 -o pfont16.c
+
+    Convert a TrueType font (requires Pillow), anti-aliased at 2 or 4 bpp:
+      pfontgen.py --ttf DejaVuSans.ttf --size 16 --bpp 4 --name PFontSans16 -o pfontsans16.c
+
+  The encoding (bit-packed or RLE) giving the smallest data is selected
+  unless --encoding is given. Sizes are reported on the standard error.
+"""
+
+import argparse
+import re
+import sys
+
+ENCODING_PACKED = 0
+ENCODING_RLE = 1
+
+RLE_MAX_RUN = 64
+RLE_MAX_LITERAL = 128
+
+
+class Glyph(object):
+    """Glyph bitmap: Width x Height levels, rows from top to bottom."""
+
+    def __init__(self, width, x_offset, advance, levels):
+        self.width = width
+        self.x_offset = x_offset
+        self.advance = advance
+        self.levels = levels
+
+
+def parse_sfont(path):
+    """Read the table, width and height of a fontXX.c sFONT source file."""
+    with open(path, 'r') as f:
+        text = f.read()
+
+    table = re.search(r'const\s+uint8_t\s+\w+\s*\[\s*\]\s*=\s*\{(.*?)\};', text, re.S)
+    sizes = re.search(r'sFONT\s+\w+\s*=\s*\{\s*\w+\s*,\s*(\d+)\s*,[^,]*?(\d+)\s*,', text, re.S)
+    if table is None or sizes is None:
+        sys.exit('%s: sFONT table not found' % path)
+
+    # Drop the comments, they hold the glyph drawings
+    body = re.sub(r'//[^\n]*', '', table.group(1))
+    data = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', body)]
+    return data, int(sizes.group(1)), int(sizes.group(2))
+
+
+def glyphs_from_sfont(path, max_level, spacing):
+    data, width, height = parse_sfont(path)
+    row_bytes = (width + 7) // 8
+    glyph_bytes = row_bytes * height
+    glyphs = []
+
+    for index in range(len(data) // glyph_bytes):
+        base = index * glyph_bytes
+        bitmap = []
+        for y in range(height):
+            row = data[base + (y * row_bytes):base + ((y + 1) * row_bytes)]
+            bitmap.append([(row[x // 8] >> (7 - (x % 8))) & 1 for x in range(width)])
+
+        used = [x for x in range(width) if any(bitmap[y][x] for y in range(height))]
+        if not used:
+            # Blank glyph, keeps the space of half a fixed width character
+            glyphs.append(Glyph(0, 0, (width + 1) // 2, []))
+            continue
+
+        left, right = used[0], used[-1]
+        levels = []
+        for y in range(height):
+            levels.extend(max_level if bitmap[y][x] else 0 for x in range(left, right + 1))
+        glyphs.append(Glyph(right - left + 1, 0, right - left + 1 + spacing, levels))
+
+    return glyphs, height, 0x20, 0x20 + len(glyphs) - 1
+
+
+def glyphs_from_ttf(path, size, max_level, first, last):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit('TTF input requires Pillow (pip install pillow)')
+
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    height = ascent + descent
+    glyphs = []
+
+    for code in range(first, last + 1):
+        char = chr(code)
+        advance = int(round(font.getlength(char)))
+        left, _, right, _ = font.getbbox(char)
+        width = right - left
+        if width <= 0:
+            glyphs.append(Glyph(0, 0, advance, []))
+            continue
+
+        image = Image.new('L', (width, height), 0)
+        ImageDraw.Draw(image).text((-left, 0), char, font=font, fill=255)
+        pixels = list(image.getdata())
+        levels = [(p * max_level + 127) // 255 for p in pixels]
+        glyphs.append(Glyph(width, max(-128, min(127, left)), min(255, advance), levels))
+
+    return glyphs, height, first, last
+
+
+def pack(levels, bpp):
+    """Pack levels MSB first, padded to a byte."""
+    out = []
+    acc = 0
+    bits = 0
+    for level in levels:
+        acc = (acc << bpp) | level
+        bits += bpp
+        if bits == 8:
+            out.append(acc)
+            acc = 0
+            bits = 0
+    if bits != 0:
+        out.append(acc << (8 - bits))
+    return out
+
+
+def encode_rle(levels, bpp):
+    """Runs of background or full color pixels, literal tokens otherwise."""
+    max_level = (1 << bpp) - 1
+    out = []
+    literal = []
+    i = 0
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX_LITERAL]
+            del literal[:RLE_MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(pack(chunk, bpp))
+
+    while i < len(levels):
+        level = levels[i]
+        run = 1
+        while (i + run < len(levels)) and (levels[i + run] == level) and (run < RLE_MAX_RUN):
+            run += 1
+        # A run token costs one byte: worth it from 2 pixels, or 1 when no
+        # literal is pending
+        if level in (0, max_level) and (run >= 2 or not literal):
+            flush_literal()
+            out.append(0x80 | (0x40 if level == max_level else 0) | (run - 1))
+            i += run
+        else:
+            literal.append(level)
+            i += 1
+    flush_literal()
+    return out
+
+
+def encode(glyphs, bpp, encoding):
+    data = []
+    offsets = []
+    for glyph in glyphs:
+        offsets.append(len(data))
+        if glyph.width == 0:
+            continue
+        if encoding == ENCODING_RLE:
+            data.extend(encode_rle(glyph.levels, bpp))
+        else:
+            data.extend(pack(glyph.levels, bpp))
+    return data, offsets
+
+
+def char_comment(code):
+    char = chr(code)
+    return "'\\\\'" if char == '\\' else "'%s'" % char
+
+
+def write_c(out, name, source, glyphs, height, first, last, bpp, encoding, data, offsets):
+    lines = []
+    lines.append('/**')
+    lines.append('  ******************************************************************************')
+    lines.append('  * @file    %s' % out.split('/')[-1])
+    lines.append('  * @author  MCD Application Team')
+    lines.append('  * @brief   This file provides the %s proportional font generated by' % name)
+    lines.append('  *          pfontgen.py from %s.' % source)
+    lines.append('  ******************************************************************************')
+    lines.append('  * @attention')
+    lines.append('  *')
+    lines.append('  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.')
+    lines.append('  * All rights reserved.</center></h2>')
+    lines.append('  *')
+    lines.append('  * This software component is licensed by ST under BSD 3-Clause license,')
+    lines.append('  * the "License"; You may not use this file except in compliance with the')
+    lines.append('  * License. You may obtain a copy of the License at:')
+    lines.append('  *                        opensource.org/licenses/BSD-3-Clause')
+    lines.append('  *')
+    lines.append('  ******************************************************************************')
+    lines.append('  */')
+    lines.append('')
+    lines.append('/* Includes ------------------------------------------------------------------*/')
+    lines.append('#include "fonts.h"')
+    lines.append('')
+    lines.append('/** @addtogroup Utilities')
+    lines.append('  * @{')
+    lines.append('  */')
+    lines.append('')
+    lines.append('/** @addtogroup STM32_EVAL')
+    lines.append('  * @{')
+    lines.append('  */')
+    lines.append('')
+    lines.append('/** @addtogroup Common')
+    lines.append('  * @{')
+    lines.append('  */')
+    lines.append('')
+    lines.append('/** @addtogroup FONTS')
+    lines.append('  * @{')
+    lines.append('  */')
+    lines.append('')
+    lines.append('/** @defgroup FONTS_Private_Variables')
+    lines.append('  * @{')
+    lines.append('  */')
+    lines.append('static const uint8_t %s_Data[] =' % name)
+    lines.append('{')
+    for code, glyph, offset in zip(range(first, last + 1), glyphs, offsets):
+        end = offsets[code - first + 1] if code < last else len(data)
+        if end == offset:
+            continue
+        lines.append('  /* @%d %s */' % (offset, char_comment(code)))
+        chunk = data[offset:end]
+        for i in range(0, len(chunk), 16):
+            lines.append('  ' + ' '.join('0x%02X,' % b for b in chunk[i:i + 16]))
+    if not data:
+        lines.append('  0x00')
+    lines.append('};')
+    lines.append('')
+    lines.append('static const sGLYPH %s_Glyphs[] =' % name)
+    lines.append('{')
+    for code, glyph, offset in zip(range(first, last + 1), glyphs, offsets):
+        lines.append('  {%5d, %3d, %4d, %3d}, /* %s */' % (offset, glyph.width, glyph.x_offset,
+                                                        glyph.advance, char_comment(code)))
+    lines.append('};')
+    lines.append('')
+    lines.append('const sPFONT %s =' % name)
+    lines.append('{')
+    lines.append('  %s_Data,' % name)
+    lines.append('  %s_Glyphs,' % name)
+    lines.append('  %-6s /* Height */' % ('%d,' % height))
+    lines.append('  %-6s /* FirstChar */' % ('0x%02X,' % first))
+    lines.append('  %-6s /* LastChar */' % ('0x%02X,' % last))
+    lines.append('  %-6s /* Bpp */' % ('%d,' % bpp))
+    lines.append('  %s' % ('PFONT_ENCODING_RLE' if encoding == ENCODING_RLE else 'PFONT_ENCODING_PACKED'))
+    lines.append('};')
+    lines.append('')
+    for _ in range(5):
+        lines.append('/**')
+        lines.append('  * @}')
+        lines.append('  */')
+        lines.append('')
+    lines.append('/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/')
+
+    with open(out, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a proportional sPFONT C file.')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--sfont', help='fixed width sFONT C file (fontXX.c)')
+    source.add_argument('--ttf', help='TrueType font file')
+    parser.add_argument('--size', type=int, default=16, help='TTF pixel size')
+    parser.add_argument('--bpp', type=int, choices=(1, 2, 4), default=1, help='bits per pixel')
+    parser.add_argument('--encoding', choices=('auto', 'packed', 'rle'), default='auto')
+    parser.add_argument('--spacing', type=int, default=1, help='sFONT columns added after each glyph')
+    parser.add_argument('--first', type=lambda v: int(v, 0), default=0x20, help='TTF first character')
+    parser.add_argument('--last', type=lambda v: int(v, 0), default=0x7E, help='TTF last character')
+    parser.add_argument('--name', required=True, help='sPFONT variable name')
+    parser.add_argument('-o', '--output', required=True, help='generated C file')
+    args = parser.parse_args()
+
+    max_level = (1 << args.bpp) - 1
+    if args.sfont:
+        glyphs, height, first, last = glyphs_from_sfont(args.sfont, max_level, args.spacing)
+        source = args.sfont.split('/')[-1]
+        _, sfont_width, sfont_height = parse_sfont(args.sfont)
+        original = len(glyphs) * ((sfont_width + 7) // 8) * sfont_height
+    else:
+        glyphs, height, first, last = glyphs_from_ttf(args.ttf, args.size, max_level, args.first, args.last)
+        source = '%s at %d pixels' % (args.ttf.split('/')[-1], args.size)
+        original = None
+
+    candidates = []
+    if args.encoding in ('auto', 'packed'):
+        candidates.append((ENCODING_PACKED,) + encode(glyphs, args.bpp, ENCODING_PACKED))
+    if args.encoding in ('auto', 'rle'):
+        candidates.append((ENCODING_RLE,) + encode(glyphs, args.bpp, ENCODING_RLE))
+    encoding, data, offsets = min(candidates, key=lambda c: len(c[1]))
+    if len(data) > 0xFFFF:
+        sys.exit('%s: %d bytes of glyph data, sGLYPH offsets are limited to 64 KB' % (args.name, len(data)))
+
+    write_c(args.output, args.name, source, glyphs, height, first, last, args.bpp, encoding, data, offsets)
+
+    # sGLYPH is 6 bytes with its padding
+    size = len(data) + (6 * len(glyphs))
+    sys.stderr.write('%s: %s, %d bpp, %d bytes (data %d, glyphs %d)' %
+                     (args.name, 'RLE' if encoding == ENCODING_RLE else 'packed', args.bpp,
+                      size, len(data), 6 * len(glyphs)))
+    if original is not None:
+        sys.stderr.write(', sFONT table %d bytes' % original)
+    sys.stderr.write('\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -46,6 +46,10 @@
          UTIL_LCD_GetBackColor()
          UTIL_LCD_SetFont()
          UTIL_LCD_GetFont()
+         UTIL_LCD_PushClipRect()
+         UTIL_LCD_PopClipRect()
+         UTIL_LCD_ResetClipRect()
+         UTIL_LCD_GetClipRect()
          UTIL_LCD_Clear)
          UTIL_LCD_ClearStringLine()
          UTIL_LCD_DisplayStringAtLine()
@@ -65,7 +69,76 @@
          UTIL_LCD_DrawEllipse()
          UTIL_LCD_FillCircle()
          UTIL_LCD_FillPolygon()
+         UTIL_LCD_FillPolygonEx()
          UTIL_LCD_FillEllipse()
+         UTIL_LCD_FillLinearGradient()
+         UTIL_LCD_FillRadialGradient()
+         UTIL_LCD_FillPattern()
+         UTIL_LCD_ResetGlyphCache()
+         UTIL_LCD_GetGlyphCacheStats()
+         UTIL_LCD_SetPFont()
+         UTIL_LCD_GetPFont()
+         UTIL_LCD_GetPStringWidth()
+         UTIL_LCD_DisplayPStringAt()
+         UTIL_LCD_ConsoleInit()
+         UTIL_LCD_ConsoleDeInit()
+         UTIL_LCD_ConsoleClear()
+         UTIL_LCD_ConsoleWriteLine()
+
+   - In RGB565 format, characters are expanded once into a glyph cache keyed by
+     font, character, text and back colors (LRU eviction in a fixed arena of
+     UTIL_LCD_GLYPH_CACHE_SIZE pixels). UTIL_LCD_DisplayStringAt() composes the
+     glyphs of a string in a text run buffer of UTIL_LCD_TEXT_RUN_SIZE pixels
+     and sends it with a single UTIL_LCD_FillRGBRect() call.
+
+   - The glyph cache arena and the text run buffer take 2 x 8 KB of RAM with
+     the default sizes. Define UTIL_LCD_USE_TEXT_BUFFERS to 0 to remove them:
+     characters and strings are then drawn character by character, proportional
+     strings pixel by pixel and gradient and pattern fills line by line.
+
+   - Proportional fonts (sPFONT, see fonts.h) are generated offline from sFONT
+     tables or TTF files by Utilities/Fonts/tools/pfontgen.py. Select one with
+     UTIL_LCD_SetPFont() and draw with UTIL_LCD_DisplayPStringAt(): glyphs are
+     decoded straight into the text run buffer, anti-aliased levels blended
+     between the text and back colors. RGB565 format only.
+
+   - UTIL_LCD_FillPolygon() and UTIL_LCD_FillPolygonEx() use a scanline fill with
+     an active edge table (even-odd or non-zero rule, polygons of up to
+     UTIL_LCD_POLY_MAX_POINTS points). Larger polygons are filled with the same
+     pixels without the table, scanning all their edges for each crossing.
+     Pixels are filled when their centre is inside the polygon. Polygons, circles and ellipses are filled with one
+     horizontal line per row and interval.
+
+   - Gradient and 8x8 pattern fills compose their RGB565 rows in the text run
+     buffer and send as many rows as fit in it with one UTIL_LCD_FillRGBRect()
+     window. Gradients are interpolated per ARGB8888 channel and converted to
+     RGB565 with a 4x4 ordered dither anchored on the display, so that
+     adjacent fills match and no banding shows. Rows repeating with the dither
+     or pattern period are composed once per fill. In other formats the fills
+     are drawn with one horizontal line per run of same color pixels.
+
+   - The text console writes lines in a band of the display with the current
+     font. Once the band is full, the panel scrolls it by one line (for
+     instance through BSP_LCD_SetScrollArea() and BSP_LCD_SetScrollStart() in
+     a UTIL_LCD_ScrollDrv_t) and only the new line is drawn.
+
+   - Lines, circles and ellipses outlines are drawn with integer algorithms
+     sending consecutive pixels of a row or a column as one horizontal or
+     vertical line. Shapes out of the display are rejected up front, lines
+     are clipped to the display.
+
+   - Drawing is limited to a clipping rectangle, the whole display by default.
+     UTIL_LCD_PushClipRect() saves the current one and intersects it with a
+     widget area, UTIL_LCD_PopClipRect() restores it. Shapes out of the
+     clipping rectangle are rejected before being rasterized and lines,
+     rectangles and RGB buffers are cut to it before reaching the driver, so
+     that no clipped pixel is sent to the panel. A partly visible buffer is
+     sent row by row. UTIL_LCD_DrawBitmap() cuts 16 bpp bitmaps in RGB565
+     format and 32 bpp bitmaps in other formats. Partly visible 16, 24 and
+     32 bpp bitmaps of another depth are converted to RGB565 or ARGB8888 in
+     the text run buffer. Other partly visible bitmaps (palette ones, indexed
+     displays, or any other depth without the text buffers) are not drawn,
+     only the driver drawing whole bitmaps.
 ------------------------------------------------------------------------------*/
 
 /* Includes ------------------------------------------------------------------*/
@@ -96,10 +169,43 @@
   #define UTIL_LCD_MAX_LAYERS_NBR    2U
 #endif
 
+/* Glyph cache arena and text run buffer, 0 to remove them */
+#ifndef UTIL_LCD_USE_TEXT_BUFFERS
+  #define UTIL_LCD_USE_TEXT_BUFFERS     1U
+#endif
+
+/* Glyph cache arena size, in RGB565 pixels */
+#ifndef UTIL_LCD_GLYPH_CACHE_SIZE
+  #define UTIL_LCD_GLYPH_CACHE_SIZE     4096U
+#endif
+
+/* Maximum number of glyphs held by the cache */
+#ifndef UTIL_LCD_GLYPH_CACHE_ENTRIES
+  #define UTIL_LCD_GLYPH_CACHE_ENTRIES  32U
+#endif
+
+/* Text run buffer size, in RGB565 pixels */
+#ifndef UTIL_LCD_TEXT_RUN_SIZE
+  #define UTIL_LCD_TEXT_RUN_SIZE        4096U
+#endif
+
+/* Gradient and pattern fill kinds */
+#define FILL_LINEAR_H                 0U
+#define FILL_LINEAR_V                 1U
+#define FILL_RADIAL                   2U
+#define FILL_PATTERN                  3U
+
+/* Maximum number of points of a filled polygon */
+#ifndef UTIL_LCD_POLY_MAX_POINTS
+  #define UTIL_LCD_POLY_MAX_POINTS      32U
+#endif
+
 /** @defgroup UTIL_LCD_Private_Macros STM32 LCD Utility Private Macros
   * @{
   */
 #define ABS(X)                 ((X) > 0 ? (X) : -(X))
+#define MIN(X, Y)              (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y)              (((X) > (Y)) ? (X) : (Y))
 #define POLY_X(Z)              ((int32_t)((Points + (Z))->X))
 #define POLY_Y(Z)              ((int32_t)((Points + (Z))->Y))
 
@@ -107,6 +213,9 @@
                                      (((((Color & 0xFF00U) >> 8) >>2) & 0x3FU) << 5) |\
                                      (((((Color & 0xFF0000U) >> 16) >>3) & 0x1FU) << 11))
 
+/* Dithering levels: RGB565 fields times 16 spread in 10-bit lanes of a word */
+#define LEVELS_TO_RGB565(Levels)     ((((Levels) >> 13) & 0xF800U) | (((Levels) >> 9) & 0x07E0U) | (((Levels) >> 4) & 0x001FU))
+
 #define CONVERTRGB5652ARGB8888(Color)(((((((Color >> 11) & 0x1FU) * 527) + 23) >> 6) << 16) |\
                                      ((((((Color >> 5) & 0x3FU) * 259) + 33) >> 6) << 8) |\
                                      ((((Color & 0x1FU) * 527) + 23) >> 6) | 0xFF000000)
@@ -120,13 +229,60 @@
   */
 typedef struct
 {
-  uint32_t x1;
-  uint32_t y1;
-  uint32_t x2;
-  uint32_t y2;
-  uint32_t x3;
-  uint32_t y3;
-}Triangle_Positions_t;
+  int32_t YMin;     /* First scanline crossing the edge */
+  int32_t YMax;     /* Scanline after the last one crossing the edge */
+  int32_t XMin;     /* X at YMin */
+  int32_t DeltaX;
+  int32_t Den;      /* 2 * (YMax - YMin) */
+  int32_t Step;     /* Whole pixels per scanline, floor(DeltaX / dy) */
+  int32_t StepRem;  /* 2 * DeltaX - Step * Den */
+  int32_t Winding;  /* 1 downward, -1 upward */
+  int32_t X;        /* First pixel right of the edge on the current scanline */
+  int32_t Rem;      /* Error term, in [0, Den[ */
+}PolyEdge_t;
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+typedef struct
+{
+  const sFONT *pFont;
+  uint32_t     Ascii;
+  uint32_t     TextColor;  /* RGB565 */
+  uint32_t     BackColor;  /* RGB565 */
+  uint32_t     Offset;     /* First pixel in the arena */
+  uint32_t     Size;       /* Pixels, 0 for a free entry */
+  uint32_t     LastUse;
+}GlyphCache_Entry_t;
+
+typedef struct
+{
+  GlyphCache_Entry_t        Entry[UTIL_LCD_GLYPH_CACHE_ENTRIES];
+  uint32_t                  Used;  /* Arena pixels in use */
+  uint32_t                  Tick;
+  UTIL_LCD_GlyphCacheStats_t Stats;
+  uint16_t                  Arena[UTIL_LCD_GLYPH_CACHE_SIZE];
+}GlyphCache_t;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+typedef struct
+{
+  const UTIL_LCD_ScrollDrv_t *pScroll;
+  uint32_t                    Ypos;
+  uint32_t                    LineHeight;
+  uint32_t                    LineCount;
+  uint32_t                    NextLine;   /* Console line written next */
+  uint32_t                    IsFull;     /* All lines written, display scrolls */
+}Console_t;
+
+typedef struct
+{
+  uint32_t       Type;      /* FILL_xxx */
+  uint32_t       Color1;    /* ARGB8888 */
+  uint32_t       Color2;    /* ARGB8888 */
+  int32_t        Xpos;      /* Gradient origin or radial gradient centre */
+  int32_t        Ypos;
+  uint32_t       Length;    /* Gradient length, Color2 reached at Length */
+  const uint8_t *pPattern;  /* 8 rows, most significant bit on the left */
+}Fill_t;
 
 /**
   * @}
@@ -142,6 +298,44 @@ typedef struct
 static UTIL_LCD_Ctx_t DrawProp[UTIL_LCD_MAX_LAYERS_NBR];
 static LCD_UTILS_Drv_t FuncDriver;
 
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+/**
+  * @brief  Expanded glyphs and text run composition buffer
+  */
+static GlyphCache_t GlyphCache;
+static uint16_t     TextRun[UTIL_LCD_TEXT_RUN_SIZE];
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+/**
+  * @brief  Polygon fill edge table and active edges
+  */
+static PolyEdge_t  PolyEdge[UTIL_LCD_POLY_MAX_POINTS];
+static PolyEdge_t *PolyActive[UTIL_LCD_POLY_MAX_POINTS];
+
+/**
+  * @brief  Text console
+  */
+static Console_t Console;
+
+/**
+  * @brief  Gradient or pattern fill in progress
+  */
+static Fill_t Fill;
+
+/**
+  * @brief  4x4 ordered dither thresholds, spread in the three lanes of a
+  *         dithering levels word
+  */
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+static const uint32_t DitherMatrix[16] =
+{
+   0U * 0x100401U,  8U * 0x100401U,  2U * 0x100401U, 10U * 0x100401U,
+  12U * 0x100401U,  4U * 0x100401U, 14U * 0x100401U,  6U * 0x100401U,
+   3U * 0x100401U, 11U * 0x100401U,  1U * 0x100401U,  9U * 0x100401U,
+  15U * 0x100401U,  7U * 0x100401U, 13U * 0x100401U,  5U * 0x100401U
+};
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
 /**
   * @}
   */
@@ -150,7 +344,37 @@ static LCD_UTILS_Drv_t FuncDriver;
   * @{
   */
 static void DrawChar(uint32_t Xpos, uint32_t Ypos, const uint8_t *pData);
-static void FillTriangle(Triangle_Positions_t *Positions, uint32_t Color);
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+static uint16_t *GetGlyph(uint8_t Ascii);
+static void EvictGlyph(uint32_t Index);
+static void DrawTextRun(uint32_t Xpos, uint32_t Ypos, const uint8_t *Text, uint32_t Count);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+static const sGLYPH *GetPGlyph(const sPFONT *pFont, uint8_t Ascii);
+static void DrawPTextRun(uint32_t Xpos, uint32_t Ypos, const uint8_t *Text, uint32_t Count, uint32_t Width);
+static void DecodePGlyph(const sPFONT *pFont, const sGLYPH *pGlyph, int32_t Xpos, uint32_t RunXpos, uint32_t RunYpos,
+                         uint32_t RunWidth, const uint32_t *pPalette);
+static int64_t FloorDiv(int64_t Num, int64_t Den);
+static uint32_t MakeEdge(pPoint Points, uint32_t PointCount, uint32_t Index, PolyEdge_t *pEdge);
+static void StartEdge(PolyEdge_t *pEdge, int32_t Ypos);
+static void FillPolygonLarge(pPoint Points, uint32_t PointCount, uint32_t FillRule, uint32_t Color);
+static void FillSpan(int32_t X1, int32_t X2, int32_t Ypos, uint32_t Color);
+static void FillVSpan(int32_t Xpos, int32_t Y1, int32_t Y2, uint32_t Color);
+static void MirrorHSpan(int32_t Xpos, int32_t Ypos, int32_t X1, int32_t X2, int32_t Dy, uint32_t Color);
+static void MirrorVSpan(int32_t Xpos, int32_t Ypos, int32_t Dx, int32_t Y1, int32_t Y2, uint32_t Color);
+static int32_t EllipseHalfWidth(int32_t HalfWidth, int32_t Dy, int64_t XRad2, int64_t YRad2);
+static uint32_t ClipRect(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height);
+static void DrawFill(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Period);
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+static void ComposeFillRow(uint16_t *pRow, uint32_t Xpos, uint32_t Ypos, uint32_t Width);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+static uint32_t GetFillColor(uint32_t Xpos, uint32_t Ypos);
+static uint32_t GetRadialPos(int32_t Dx, int32_t Dy);
+static uint32_t LerpColor(uint32_t Color1, uint32_t Color2, uint32_t Pos, uint32_t Length);
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+static uint32_t ColorToLevels(uint32_t Color);
+static void ConvertBitmapPixels(uint8_t *pDst, const uint8_t *pSrc, uint32_t Bpp, uint32_t Count);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+static uint32_t IsClipped(int32_t X1, int32_t Y1, int32_t X2, int32_t Y2);
 /**
   * @}
   */
@@ -182,6 +406,7 @@ void UTIL_LCD_SetFuncDriver(const LCD_UTILS_Drv_t *pDrv)
   FuncDriver.GetXSize(0, &DrawProp->LcdXsize);
   FuncDriver.GetYSize(0, &DrawProp->LcdYsize);
   FuncDriver.GetFormat(0, &DrawProp->LcdPixelFormat);
+  UTIL_LCD_ResetClipRect();
 }
 
 /**
@@ -208,6 +433,7 @@ void UTIL_LCD_SetDevice(uint32_t Device)
   DrawProp->LcdDevice = Device;
   FuncDriver.GetXSize(Device, &DrawProp->LcdXsize);
   FuncDriver.GetYSize(Device, &DrawProp->LcdYsize);
+  UTIL_LCD_ResetClipRect();
 }
 
 /**
@@ -264,6 +490,90 @@ sFONT *UTIL_LCD_GetFont(void)
   return DrawProp[DrawProp->LcdLayer].pFont;
 }
 
+/**
+  * @brief  Saves the clipping rectangle of the current layer and intersects it
+  *         with an area, typically a widget or a scroll view.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Area width
+  * @param  Height Area height
+  * @retval UTIL_LCD_OK, UTIL_LCD_ERROR if UTIL_LCD_CLIP_STACK_DEPTH rectangles
+  *         are already saved (the clipping rectangle is then unchanged)
+  */
+int32_t UTIL_LCD_PushClipRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_OK;
+  UTIL_LCD_Ctx_t *ctx = &DrawProp[DrawProp->LcdLayer];
+
+  if(ctx->ClipDepth >= UTIL_LCD_CLIP_STACK_DEPTH)
+  {
+    ret = UTIL_LCD_ERROR;
+  }
+  else
+  {
+    ctx->ClipStack[ctx->ClipDepth] = ctx->Clip;
+    ctx->ClipDepth++;
+
+    if(ClipRect(&Xpos, &Ypos, &Width, &Height) != 0U)
+    {
+      ctx->Clip.X0 = Xpos;
+      ctx->Clip.Y0 = Ypos;
+      ctx->Clip.X1 = Xpos + Width;
+      ctx->Clip.Y1 = Ypos + Height;
+    }
+    else
+    {
+      /* Empty intersection: nothing is drawn until the rectangle is popped */
+      ctx->Clip.X1 = ctx->Clip.X0;
+      ctx->Clip.Y1 = ctx->Clip.Y0;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Restores the clipping rectangle saved by the last
+  *         UTIL_LCD_PushClipRect() on the current layer.
+  */
+void UTIL_LCD_PopClipRect(void)
+{
+  UTIL_LCD_Ctx_t *ctx = &DrawProp[DrawProp->LcdLayer];
+
+  if(ctx->ClipDepth != 0U)
+  {
+    ctx->ClipDepth--;
+    ctx->Clip = ctx->ClipStack[ctx->ClipDepth];
+  }
+}
+
+/**
+  * @brief  Empties the clipping rectangles stack of all layers, drawing is
+  *         clipped to the display.
+  */
+void UTIL_LCD_ResetClipRect(void)
+{
+  uint32_t i;
+
+  for(i = 0; i < UTIL_LCD_MAX_LAYERS_NBR; i++)
+  {
+    DrawProp[i].Clip.X0   = 0;
+    DrawProp[i].Clip.Y0   = 0;
+    DrawProp[i].Clip.X1   = DrawProp->LcdXsize;
+    DrawProp[i].Clip.Y1   = DrawProp->LcdYsize;
+    DrawProp[i].ClipDepth = 0;
+  }
+}
+
+/**
+  * @brief  Gets the clipping rectangle of the current layer.
+  * @param  pClip  Clipping rectangle
+  */
+void UTIL_LCD_GetClipRect(UTIL_LCD_ClipRect_t *pClip)
+{
+  *pClip = DrawProp[DrawProp->LcdLayer].Clip;
+}
+
 /**
   * @brief  Draws a RGB rectangle in currently active layer.
   * @param  pData   Pointer to RGB rectangle data
@@ -273,8 +583,29 @@ sFONT *UTIL_LCD_GetFont(void)
   */
 void UTIL_LCD_FillRGBRect(uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
 {
-  /* Write RGB rectangle data */
-  FuncDriver.FillRGBRect(DrawProp->LcdDevice, Xpos, Ypos, pData, Width, Height);
+  uint32_t x = Xpos, y = Ypos, width = Width, height = Height;
+  uint32_t bytes, j;
+
+  if(ClipRect(&x, &y, &width, &height) != 0U)
+  {
+    /* RGB565 buffers hold 2 bytes per pixel, other formats 4 bytes */
+    bytes = (DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565) ? 2U : 4U;
+    pData = &pData[((((y - Ypos) * Width) + (x - Xpos)) * bytes)];
+
+    if(width == Width)
+    {
+      /* Visible rows are contiguous in the buffer */
+      FuncDriver.FillRGBRect(DrawProp->LcdDevice, x, y, pData, width, height);
+    }
+    else
+    {
+      for(j = 0; j < height; j++)
+      {
+        FuncDriver.FillRGBRect(DrawProp->LcdDevice, x, y + j, pData, width, 1);
+        pData += Width * bytes;
+      }
+    }
+  }
 }
 
 /**
@@ -286,8 +617,14 @@ void UTIL_LCD_FillRGBRect(uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t
   */
 void UTIL_LCD_DrawHLine(uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
 {
+  uint32_t height = 1;
+
   /* Write line */
-  if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  if(ClipRect(&Xpos, &Ypos, &Length, &height) == 0U)
+  {
+    /* Line is clipped */
+  }
+  else if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
   {
     FuncDriver.DrawHLine(DrawProp->LcdDevice, Xpos, Ypos, Length, CONVERTARGB88882RGB565(Color));
   }
@@ -306,8 +643,14 @@ void UTIL_LCD_DrawHLine(uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t
   */
 void UTIL_LCD_DrawVLine(uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
 {
+  uint32_t width = 1;
+
   /* Write line */
-  if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  if(ClipRect(&Xpos, &Ypos, &width, &Length) == 0U)
+  {
+    /* Line is clipped */
+  }
+  else if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
   {
     FuncDriver.DrawVLine(DrawProp->LcdDevice, Xpos, Ypos, Length, CONVERTARGB88882RGB565(Color));
   }
@@ -342,7 +685,11 @@ void UTIL_LCD_GetPixel(uint16_t Xpos, uint16_t Ypos, uint32_t *Color)
 void UTIL_LCD_SetPixel(uint16_t Xpos, uint16_t Ypos, uint32_t Color)
 {
   /* Set Pixel */
-  if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  if(IsClipped(Xpos, Ypos, Xpos, Ypos) != 0U)
+  {
+    /* Pixel is clipped */
+  }
+  else if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
   {
     FuncDriver.SetPixel(DrawProp->LcdDevice, Xpos, Ypos, CONVERTARGB88882RGB565(Color));
   }
@@ -353,7 +700,8 @@ void UTIL_LCD_SetPixel(uint16_t Xpos, uint16_t Ypos, uint32_t Color)
 }
 
 /**
-  * @brief  Clears the whole currently active layer of LTDC.
+  * @brief  Clears the whole currently active layer of LTDC, within the
+  *         clipping rectangle.
   * @param  Color  Color of the background
   */
 void UTIL_LCD_Clear(uint32_t Color)
@@ -381,8 +729,26 @@ void UTIL_LCD_ClearStringLine(uint32_t Line)
   */
 void UTIL_LCD_DisplayChar(uint32_t Xpos, uint32_t Ypos, uint8_t Ascii)
 {
-  DrawChar(Xpos, Ypos, &DrawProp[DrawProp->LcdLayer].pFont->table[(Ascii-' ') *\
-  DrawProp[DrawProp->LcdLayer].pFont->Height * ((DrawProp[DrawProp->LcdLayer].pFont->Width + 7) / 8)]);
+  uint16_t *glyph = NULL;
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  if(DrawProp[DrawProp->LcdLayer].LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  {
+    glyph = GetGlyph(Ascii);
+  }
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+  if(glyph != NULL)
+  {
+    /* Send the cached glyph in one window */
+    UTIL_LCD_FillRGBRect(Xpos, Ypos, (uint8_t*)glyph, DrawProp[DrawProp->LcdLayer].pFont->Width,
+                         DrawProp[DrawProp->LcdLayer].pFont->Height);
+  }
+  else
+  {
+    DrawChar(Xpos, Ypos, &DrawProp[DrawProp->LcdLayer].pFont->table[(Ascii-' ') *\
+    DrawProp[DrawProp->LcdLayer].pFont->Height * ((DrawProp[DrawProp->LcdLayer].pFont->Width + 7) / 8)]);
+  }
 }
 
 /**
@@ -400,6 +766,9 @@ void UTIL_LCD_DisplayStringAt(uint32_t Xpos, uint32_t Ypos, uint8_t *Text, Text_
 {
   uint32_t refcolumn = 1, i = 0;
   uint32_t size = 0, xsize = 0;
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  uint32_t glyph_size, run_max, count;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
   uint8_t  *ptr = Text;
 
   /* Get the text size */
@@ -438,17 +807,44 @@ void UTIL_LCD_DisplayStringAt(uint32_t Xpos, uint32_t Ypos, uint8_t *Text, Text_
     refcolumn = 1;
   }
 
-  /* Send the string character by character on LCD */
-  while ((*Text != 0) & (((DrawProp->LcdXsize - (i*DrawProp[DrawProp->LcdLayer].pFont->Width)) & 0xFFFF) >= DrawProp[DrawProp->LcdLayer].pFont->Width))
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  glyph_size = DrawProp[DrawProp->LcdLayer].pFont->Width * DrawProp[DrawProp->LcdLayer].pFont->Height;
+  run_max    = UTIL_LCD_TEXT_RUN_SIZE / glyph_size;
+
+  if((DrawProp[DrawProp->LcdLayer].LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565) && (run_max != 0U) &&
+     (glyph_size <= UTIL_LCD_GLYPH_CACHE_SIZE))
   {
-    /* Display one character on LCD */
-    UTIL_LCD_DisplayChar(refcolumn, Ypos, *Text);
-    /* Decrement the column position by 16 */
-    refcolumn += DrawProp[DrawProp->LcdLayer].pFont->Width;
+    /* Number of characters fitting in the screen width */
+    while ((Text[i] != 0) & (((DrawProp->LcdXsize - (i*DrawProp[DrawProp->LcdLayer].pFont->Width)) & 0xFFFF) >= DrawProp[DrawProp->LcdLayer].pFont->Width))
+    {
+      i++;
+    }
 
-    /* Point on the next character */
-    Text++;
-    i++;
+    /* Send the string in runs of characters composed in one buffer */
+    while (i != 0U)
+    {
+      count = (i < run_max) ? i : run_max;
+      DrawTextRun(refcolumn, Ypos, Text, count);
+      refcolumn += count * DrawProp[DrawProp->LcdLayer].pFont->Width;
+      Text += count;
+      i -= count;
+    }
+  }
+  else
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+  {
+    /* Send the string character by character on LCD */
+    while ((*Text != 0) & (((DrawProp->LcdXsize - (i*DrawProp[DrawProp->LcdLayer].pFont->Width)) & 0xFFFF) >= DrawProp[DrawProp->LcdLayer].pFont->Width))
+    {
+      /* Display one character on LCD */
+      UTIL_LCD_DisplayChar(refcolumn, Ypos, *Text);
+      /* Decrement the column position by 16 */
+      refcolumn += DrawProp[DrawProp->LcdLayer].pFont->Width;
+
+      /* Point on the next character */
+      Text++;
+      i++;
+    }
   }
 }
 
@@ -463,626 +859,2050 @@ void UTIL_LCD_DisplayStringAtLine(uint32_t Line, uint8_t *ptr)
 }
 
 /**
-  * @brief  Draws an uni-line (between two points) in currently active layer.
-  * @param  Xpos1 Point 1 X position
-  * @param  Ypos1 Point 1 Y position
-  * @param  Xpos2 Point 2 X position
-  * @param  Ypos2 Point 2 Y position
-  * @param  Color Draw color
+  * @brief  Starts a text console in a band of the display.
+  * @note   Lines are written from the top of the band with the current font,
+  *         text and back colors. When the band is full, the display scrolls
+  *         it by one line through pScroll and only the new line is drawn.
+  *         Without pScroll the band is cleared and written again from the top.
+  * @param  Ypos    First row of the console
+  * @param  Height  Rows of the console, rounded down to whole text lines
+  * @param  pScroll Hardware scrolling functions, or NULL
   */
-void UTIL_LCD_DrawLine(uint32_t Xpos1, uint32_t Ypos1, uint32_t Xpos2, uint32_t Ypos2, uint32_t Color)
+void UTIL_LCD_ConsoleInit(uint32_t Ypos, uint32_t Height, const UTIL_LCD_ScrollDrv_t *pScroll)
 {
-  int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0,
-  yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
-  curpixel = 0;
-  int32_t x_diff, y_diff;
+  uint32_t line_height = DrawProp[DrawProp->LcdLayer].pFont->Height;
 
-  x_diff = Xpos2 - Xpos1;
-  y_diff = Ypos2 - Ypos1;
+  Console.pScroll    = pScroll;
+  Console.Ypos       = Ypos;
+  Console.LineHeight = line_height;
+  Console.LineCount  = Height / line_height;
 
-  deltax = ABS(x_diff);         /* The absolute difference between the x's */
-  deltay = ABS(y_diff);         /* The absolute difference between the y's */
-  x = Xpos1;                       /* Start x off at the first pixel */
-  y = Ypos1;                       /* Start y off at the first pixel */
-
-  if (Xpos2 >= Xpos1)                 /* The x-values are increasing */
-  {
-    xinc1 = 1;
-    xinc2 = 1;
-  }
-  else                          /* The x-values are decreasing */
-  {
-    xinc1 = -1;
-    xinc2 = -1;
-  }
-
-  if (Ypos2 >= Ypos1)                 /* The y-values are increasing */
-  {
-    yinc1 = 1;
-    yinc2 = 1;
-  }
-  else                          /* The y-values are decreasing */
+  if(pScroll != NULL)
   {
-    yinc1 = -1;
-    yinc2 = -1;
+    if(pScroll->SetScrollArea(DrawProp->LcdDevice, Ypos, Console.LineCount * line_height) != 0)
+    {
+      /* No hardware scrolling in this orientation */
+      Console.pScroll = NULL;
+    }
   }
 
-  if (deltax >= deltay)         /* There is at least one x-value for every y-value */
-  {
-    xinc1 = 0;                  /* Don't change the x when numerator >= denominator */
-    yinc2 = 0;                  /* Don't change the y for every iteration */
-    den = deltax;
-    num = deltax / 2;
-    numadd = deltay;
-    numpixels = deltax;         /* There are more x-values than y-values */
-  }
-  else                          /* There is at least one y-value for every x-value */
-  {
-    xinc2 = 0;                  /* Don't change the x for every iteration */
-    yinc1 = 0;                  /* Don't change the y when numerator >= denominator */
-    den = deltay;
-    num = deltay / 2;
-    numadd = deltax;
-    numpixels = deltay;         /* There are more y-values than x-values */
-  }
+  UTIL_LCD_ConsoleClear();
+}
 
-  for (curpixel = 0; curpixel <= numpixels; curpixel++)
+/**
+  * @brief  Stops the text console and the display scrolling.
+  */
+void UTIL_LCD_ConsoleDeInit(void)
+{
+  if(Console.pScroll != NULL)
   {
-    UTIL_LCD_SetPixel(x, y, Color);   /* Draw the current pixel */
-    num += numadd;                            /* Increase the numerator by the top of the fraction */
-    if (num >= den)                           /* Check if numerator >= denominator */
-    {
-      num -= den;                             /* Calculate the new numerator value */
-      x += xinc1;                             /* Change the x as appropriate */
-      y += yinc1;                             /* Change the y as appropriate */
-    }
-    x += xinc2;                               /* Change the x as appropriate */
-    y += yinc2;                               /* Change the y as appropriate */
+    (void)Console.pScroll->SetScrollArea(DrawProp->LcdDevice, 0, 0);
   }
+  Console.pScroll   = NULL;
+  Console.LineCount = 0;
 }
 
 /**
-  * @brief  Draws a rectangle in currently active layer.
-  * @param  Xpos X position
-  * @param  Ypos Y position
-  * @param  Width  Rectangle width
-  * @param  Height Rectangle height
-  * @param  Color  Draw color
+  * @brief  Clears the text console, next line is written at its top.
   */
-void UTIL_LCD_DrawRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+void UTIL_LCD_ConsoleClear(void)
 {
-  /* Draw horizontal lines */
-  UTIL_LCD_DrawHLine(Xpos, Ypos, Width, Color);
-  UTIL_LCD_DrawHLine(Xpos, (Ypos+ Height - 1U), Width, Color);
-
-  /* Draw vertical lines */
-  UTIL_LCD_DrawVLine(Xpos, Ypos, Height, Color);
-  UTIL_LCD_DrawVLine((Xpos + Width - 1U), Ypos, Height, Color);
+  if(Console.LineCount != 0U)
+  {
+    if(Console.pScroll != NULL)
+    {
+      (void)Console.pScroll->SetScrollStart(DrawProp->LcdDevice, 0);
+    }
+    UTIL_LCD_FillRect(0, Console.Ypos, DrawProp->LcdXsize, Console.LineCount * Console.LineHeight,
+                      DrawProp[DrawProp->LcdLayer].BackColor);
+  }
+  Console.NextLine = 0;
+  Console.IsFull   = 0;
 }
 
 /**
-  * @brief  Draws a circle in currently active layer.
-  * @param  Xpos    X position
-  * @param  Ypos    Y position
-  * @param  Radius  Circle radius
-  * @param  Color   Draw color
+  * @brief  Writes a line of text at the bottom of the console.
+  * @param  Text  Pointer to string, truncated to the display width
   */
-void UTIL_LCD_DrawCircle(uint32_t Xpos, uint32_t Ypos, uint32_t Radius, uint32_t Color)
+void UTIL_LCD_ConsoleWriteLine(uint8_t *Text)
 {
-  int32_t   decision;  /* Decision Variable */
-  uint32_t  current_x; /* Current X Value */
-  uint32_t  current_y; /* Current Y Value */
+  uint32_t line, ypos, width = 0;
+  uint32_t char_width = DrawProp[DrawProp->LcdLayer].pFont->Width;
 
-  decision = 3 - (Radius << 1);
-  current_x = 0;
-  current_y = Radius;
-
-  while (current_x <= current_y)
+  if(Console.LineCount != 0U)
   {
-    if((Ypos - current_y) < DrawProp->LcdYsize)
+    if((Console.IsFull != 0U) && (Console.pScroll == NULL))
     {
-      if((Xpos + current_x) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos + current_x), (Ypos - current_y), Color);
-      }
-      if((Xpos - current_x) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos - current_x), (Ypos - current_y), Color);
-      }
+      UTIL_LCD_ConsoleClear();
     }
 
-    if((Ypos - current_x) < DrawProp->LcdYsize)
+    line = Console.NextLine;
+    Console.NextLine = (line + 1U) % Console.LineCount;
+
+    if(Console.IsFull != 0U)
     {
-      if((Xpos + current_y) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos + current_y), (Ypos - current_x), Color);
-      }
-      if((Xpos - current_y) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos - current_y), (Ypos - current_x), Color);
-      }
+      /* Oldest line leaves the top, its rows come back at the bottom */
+      (void)Console.pScroll->SetScrollStart(DrawProp->LcdDevice, Console.NextLine * Console.LineHeight);
     }
-
-    if((Ypos + current_y) < DrawProp->LcdYsize)
+    else if(Console.NextLine == 0U)
     {
-      if((Xpos + current_x) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos + current_x), (Ypos + current_y), Color);
-      }
-      if((Xpos - current_x) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos - current_x), (Ypos + current_y), Color);
-      }
+      Console.IsFull = 1;
     }
-
-    if((Ypos + current_x) < DrawProp->LcdYsize)
+    else
     {
-      if((Xpos + current_y) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos + current_y), (Ypos + current_x), Color);
-      }
-      if((Xpos - current_y) < DrawProp->LcdXsize)
-      {
-        UTIL_LCD_SetPixel((Xpos - current_y), (Ypos + current_x), Color);
-      }
+      /* Console not full yet */
     }
 
-    if (decision < 0)
+    /* Draw the line in the rows it uses in display memory */
+    ypos = Console.Ypos + (line * Console.LineHeight);
+    while((Text[width] != 0U) && (((width + 1U) * char_width) <= DrawProp->LcdXsize))
     {
-      decision += (current_x << 2) + 6;
+      width++;
     }
-    else
+    if(width != 0U)
     {
-      decision += ((current_x - current_y) << 2) + 10;
-      current_y--;
+      /* The text starts at column 1, as for any left aligned string */
+      UTIL_LCD_DisplayStringAt(0, ypos, Text, LEFT_MODE);
+      width = (width * char_width) + 1U;
+    }
+    if(width < DrawProp->LcdXsize)
+    {
+      UTIL_LCD_FillRect(width, ypos, DrawProp->LcdXsize - width, Console.LineHeight, DrawProp[DrawProp->LcdLayer].BackColor);
     }
-    current_x++;
   }
 }
 
 /**
-  * @brief  Draws an poly-line (between many points) in currently active layer.
-  * @param  Points      Pointer to the points array
-  * @param  PointCount  Number of points
-  * @param  Color       Draw color
+  * @brief  Sets the LCD proportional text font.
+  * @param  pFont  Layer proportional font to be used
   */
-void UTIL_LCD_DrawPolygon(pPoint Points, uint32_t PointCount, uint32_t Color)
+void UTIL_LCD_SetPFont(const sPFONT *pFont)
 {
-  int16_t x_pos = 0, y_pos = 0;
-
-  if(PointCount < 2)
-  {
-    return;
-  }
-
-  UTIL_LCD_DrawLine(Points->X, Points->Y, (Points+PointCount-1)->X, (Points+PointCount-1)->Y, Color);
-
-  while(--PointCount)
-  {
-    x_pos = Points->X;
-    y_pos = Points->Y;
-    Points++;
-    UTIL_LCD_DrawLine(x_pos, y_pos, Points->X, Points->Y, Color);
-  }
+  DrawProp[DrawProp->LcdLayer].pPFont = pFont;
 }
 
 /**
-  * @brief  Draws an ellipse on LCD in currently active layer.
-  * @param  Xpos    X position
-  * @param  Ypos    Y position
-  * @param  XRadius Ellipse X radius
-  * @param  YRadius Ellipse Y radius
-  * @param  Color   Draw color
+  * @brief  Gets the LCD proportional text font.
+  * @retval Used layer proportional font
   */
-void UTIL_LCD_DrawEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color)
+const sPFONT *UTIL_LCD_GetPFont(void)
 {
-  int x_pos = 0, y_pos = -YRadius, err = 2-2*XRadius, e2;
-  float k = 0, rad1 = 0, rad2 = 0;
-
-  rad1 = XRadius;
-  rad2 = YRadius;
+  return DrawProp[DrawProp->LcdLayer].pPFont;
+}
 
-  k = (float)(rad2/rad1);
+/**
+  * @brief  Gets the width of a string drawn with the proportional font.
+  * @param  Text  Pointer to string
+  * @retval Width in pixels
+  */
+uint32_t UTIL_LCD_GetPStringWidth(const uint8_t *Text)
+{
+  const sPFONT *font = DrawProp[DrawProp->LcdLayer].pPFont;
+  const sGLYPH *glyph;
+  uint32_t width = 0;
 
-  do
+  if(font != NULL)
   {
-    UTIL_LCD_SetPixel((Xpos-(uint32_t)(x_pos/k)), (Ypos + y_pos), Color);
-    UTIL_LCD_SetPixel((Xpos+(uint32_t)(x_pos/k)), (Ypos + y_pos), Color);
-    UTIL_LCD_SetPixel((Xpos+(uint32_t)(x_pos/k)), (Ypos - y_pos), Color);
-    UTIL_LCD_SetPixel((Xpos-(uint32_t)(x_pos/k)), (Ypos - y_pos), Color);
-
-    e2 = err;
-    if (e2 <= x_pos)
+    while(*Text != 0U)
     {
-      err += ++x_pos*2+1;
-      if (-y_pos == x_pos && e2 <= y_pos) e2 = 0;
-    }
-    if (e2 > y_pos)
-    {
-      err += ++y_pos*2+1;
+      glyph = GetPGlyph(font, *Text);
+      if(glyph != NULL)
+      {
+        width += glyph->Advance;
+      }
+      Text++;
     }
-  }while (y_pos <= 0);
-}
+  }
 
-/**
-  * @brief  Draws a bitmap picture loaded in the internal Flash (32 bpp) in currently active layer.
-  * @param  Xpos  Bmp X position in the LCD
-  * @param  Ypos  Bmp Y position in the LCD
-  * @param  pData Pointer to Bmp picture address in the internal Flash
-  */
-void UTIL_LCD_DrawBitmap(uint32_t Xpos, uint32_t Ypos, uint8_t *pData)
-{
-  FuncDriver.DrawBitmap(DrawProp->LcdDevice, Xpos, Ypos, pData);
+  return width;
 }
 
 /**
-  * @brief  Draws a full rectangle in currently active layer.
-  * @param  Xpos   X position
-  * @param  Ypos   Y position
-  * @param  Width  Rectangle width
-  * @param  Height Rectangle height
-  * @param  Color  Draw color
+  * @brief  Displays characters with the proportional font in currently active
+  *         layer. Characters not fitting in the screen width are not drawn.
+  * @param  Xpos X position (in pixel)
+  * @param  Ypos Y position (in pixel)
+  * @param  Text Pointer to string to display on LCD
+  * @param  Mode Display mode
+  *          This parameter can be one of the following values:
+  *            @arg  CENTER_MODE
+  *            @arg  RIGHT_MODE
+  *            @arg  LEFT_MODE
   */
-void UTIL_LCD_FillRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+void UTIL_LCD_DisplayPStringAt(uint32_t Xpos, uint32_t Ypos, uint8_t *Text, Text_AlignModeTypdef Mode)
 {
-  /* Fill the rectangle */
-  if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  const sPFONT *font = DrawProp[DrawProp->LcdLayer].pPFont;
+  const sGLYPH *glyph;
+  uint32_t refcolumn, width, advance, count;
+  uint32_t end = 0;
+
+  if((font != NULL) && (DrawProp[DrawProp->LcdLayer].LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565))
   {
-    FuncDriver.FillRect(DrawProp->LcdDevice, Xpos, Ypos, Width, Height, CONVERTARGB88882RGB565(Color));
+    width = UTIL_LCD_GetPStringWidth(Text);
+
+    switch (Mode)
+    {
+    case CENTER_MODE:
+      refcolumn = (DrawProp->LcdXsize > width) ? (Xpos + ((DrawProp->LcdXsize - width) / 2U)) : Xpos;
+      break;
+    case RIGHT_MODE:
+      refcolumn = (DrawProp->LcdXsize > (width + Xpos)) ? (DrawProp->LcdXsize - width - Xpos) : 0U;
+      break;
+    case LEFT_MODE:
+    default:
+      refcolumn = Xpos;
+      break;
+    }
+
+    /* Send the string in runs fitting in the text run buffer */
+    while((*Text != 0U) && (end == 0U))
+    {
+      count = 0;
+      width = 0;
+      while((Text[count] != 0U) && (end == 0U))
+      {
+        glyph   = GetPGlyph(font, Text[count]);
+        advance = (glyph != NULL) ? glyph->Advance : 0U;
+        if((refcolumn + width + advance) > DrawProp->LcdXsize)
+        {
+          end = 1U;
+        }
+        else if(((width + advance) * font->Height) > UTIL_LCD_TEXT_RUN_SIZE)
+        {
+          break;
+        }
+        else
+        {
+          width += advance;
+          count++;
+        }
+      }
+
+      if(count == 0U)
+      {
+        /* Next character does not fit in the text run buffer */
+        end = 1U;
+      }
+      else
+      {
+        if(width != 0U)
+        {
+          DrawPTextRun(refcolumn, Ypos, Text, count, width);
+        }
+        refcolumn += width;
+        Text += count;
+      }
+    }
   }
-  else
+}
+
+/**
+  * @brief  Empties the glyph cache and resets its statistics.
+  */
+void UTIL_LCD_ResetGlyphCache(void)
+{
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  uint32_t i;
+
+  for(i = 0; i < UTIL_LCD_GLYPH_CACHE_ENTRIES; i++)
   {
-    FuncDriver.FillRect(DrawProp->LcdDevice, Xpos, Ypos, Width, Height, Color);
+    GlyphCache.Entry[i].Size = 0;
   }
+  GlyphCache.Used            = 0;
+  GlyphCache.Tick            = 0;
+  GlyphCache.Stats.Hits      = 0;
+  GlyphCache.Stats.Misses    = 0;
+  GlyphCache.Stats.Evictions = 0;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
 }
 
 /**
-  * @brief  Draws a full circle in currently active layer.
-  * @param  Xpos   X position
-  * @param  Ypos   Y position
-  * @param  Radius Circle radius
-  * @param  Color  Draw color
+  * @brief  Gets the glyph cache statistics.
+  * @param  pStats  Glyph cache statistics, all 0 without UTIL_LCD_USE_TEXT_BUFFERS
   */
-void UTIL_LCD_FillCircle(uint32_t Xpos, uint32_t Ypos, uint32_t Radius, uint32_t Color)
+void UTIL_LCD_GetGlyphCacheStats(UTIL_LCD_GlyphCacheStats_t *pStats)
+{
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  *pStats = GlyphCache.Stats;
+#else
+  pStats->Hits      = 0;
+  pStats->Misses    = 0;
+  pStats->Evictions = 0;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+}
+
+/**
+  * @brief  Draws an uni-line (between two points) in currently active layer.
+  * @param  Xpos1 Point 1 X position
+  * @param  Ypos1 Point 1 Y position
+  * @param  Xpos2 Point 2 X position
+  * @param  Ypos2 Point 2 Y position
+  * @param  Color Draw color
+  */
+void UTIL_LCD_DrawLine(uint32_t Xpos1, uint32_t Ypos1, uint32_t Xpos2, uint32_t Ypos2, uint32_t Color)
 {
-  int32_t   decision;  /* Decision Variable */
-  uint32_t  current_x; /* Current X Value */
-  uint32_t  current_y; /* Current Y Value */
+  int32_t x_pos, y_pos, x_end, y_end, deltax, deltay, xinc, yinc, num, run_start, curpixel;
 
-  decision = 3 - (Radius << 1);
+  x_pos = (int32_t)Xpos1;
+  y_pos = (int32_t)Ypos1;
+  x_end = (int32_t)Xpos2;
+  y_end = (int32_t)Ypos2;
 
-  current_x = 0;
-  current_y = Radius;
+  /* Nothing to draw when the line is out of the clipping rectangle */
+  if(IsClipped(MIN(x_pos, x_end), MIN(y_pos, y_end), MAX(x_pos, x_end), MAX(y_pos, y_end)) != 0U)
+  {
+    return;
+  }
 
-  while (current_x <= current_y)
+  deltax = ABS(x_end - x_pos);         /* The absolute difference between the x's */
+  deltay = ABS(y_end - y_pos);         /* The absolute difference between the y's */
+  xinc = (x_end >= x_pos) ? 1 : -1;
+  yinc = (y_end >= y_pos) ? 1 : -1;
+
+  if (deltax >= deltay)         /* There is at least one x-value for every y-value */
   {
-    if(current_y > 0)
+    /* Pixels sharing a row are drawn as one horizontal line */
+    num = deltax / 2;
+    run_start = x_pos;
+    for (curpixel = 0; curpixel < deltax; curpixel++)
     {
-      if(current_y >= Xpos)
-      {
-        UTIL_LCD_DrawHLine(0, Ypos + current_x, 2*current_y - (current_y - Xpos), Color);
-        UTIL_LCD_DrawHLine(0, Ypos - current_x, 2*current_y - (current_y - Xpos), Color);
-      }
-      else
+      num += deltay;
+      if (num >= deltax)        /* The next pixel is on the next row */
       {
-        UTIL_LCD_DrawHLine(Xpos - current_y, Ypos + current_x, 2*current_y, Color);
-        UTIL_LCD_DrawHLine(Xpos - current_y, Ypos - current_x, 2*current_y, Color);
+        num -= deltax;
+        FillSpan(MIN(run_start, x_pos), MAX(run_start, x_pos) + 1, y_pos, Color);
+        y_pos += yinc;
+        run_start = x_pos + xinc;
       }
+      x_pos += xinc;
     }
-
-    if(current_x > 0)
+    FillSpan(MIN(run_start, x_pos), MAX(run_start, x_pos) + 1, y_pos, Color);
+  }
+  else                          /* There is at least one y-value for every x-value */
+  {
+    /* Pixels sharing a column are drawn as one vertical line */
+    num = deltay / 2;
+    run_start = y_pos;
+    for (curpixel = 0; curpixel < deltay; curpixel++)
     {
-      if(current_x >= Xpos)
-      {
-        UTIL_LCD_DrawHLine(0, Ypos - current_y, 2*current_x - (current_x - Xpos), Color);
-        UTIL_LCD_DrawHLine(0, Ypos + current_y, 2*current_x - (current_x - Xpos), Color);
-      }
-      else
+      num += deltax;
+      if (num >= deltay)        /* The next pixel is on the next column */
       {
-        UTIL_LCD_DrawHLine(Xpos - current_x, Ypos - current_y, 2*current_x, Color);
-        UTIL_LCD_DrawHLine(Xpos - current_x, Ypos + current_y, 2*current_x, Color);
+        num -= deltay;
+        FillVSpan(x_pos, MIN(run_start, y_pos), MAX(run_start, y_pos) + 1, Color);
+        x_pos += xinc;
+        run_start = y_pos + yinc;
       }
+      y_pos += yinc;
     }
-    if (decision < 0)
-    {
-      decision += (current_x << 2) + 6;
-    }
-    else
-    {
-      decision += ((current_x - current_y) << 2) + 10;
-      current_y--;
-    }
-    current_x++;
+    FillVSpan(x_pos, MIN(run_start, y_pos), MAX(run_start, y_pos) + 1, Color);
   }
+}
+
+/**
+  * @brief  Draws a rectangle in currently active layer.
+  * @param  Xpos X position
+  * @param  Ypos Y position
+  * @param  Width  Rectangle width
+  * @param  Height Rectangle height
+  * @param  Color  Draw color
+  */
+void UTIL_LCD_DrawRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  /* Draw horizontal lines */
+  UTIL_LCD_DrawHLine(Xpos, Ypos, Width, Color);
+  UTIL_LCD_DrawHLine(Xpos, (Ypos+ Height - 1U), Width, Color);
 
-  UTIL_LCD_DrawCircle(Xpos, Ypos, Radius, Color);
+  /* Draw vertical lines */
+  UTIL_LCD_DrawVLine(Xpos, Ypos, Height, Color);
+  UTIL_LCD_DrawVLine((Xpos + Width - 1U), Ypos, Height, Color);
 }
 
 /**
-  * @brief  Draws a full poly-line (between many points) in currently active layer.
-  * @param  Points     Pointer to the points array
-  * @param  PointCount Number of points
-  * @param  Color      Draw color
+  * @brief  Draws a circle in currently active layer.
+  * @param  Xpos    X position
+  * @param  Ypos    Y position
+  * @param  Radius  Circle radius
+  * @param  Color   Draw color
   */
-void UTIL_LCD_FillPolygon(pPoint Points, uint32_t PointCount, uint32_t Color)
+void UTIL_LCD_DrawCircle(uint32_t Xpos, uint32_t Ypos, uint32_t Radius, uint32_t Color)
 {
-  int16_t X = 0, Y = 0, X2 = 0, Y2 = 0, x_center = 0, y_center = 0, x_first = 0, y_first = 0, pixel_x = 0, pixel_y = 0, counter = 0;
-  uint32_t  image_left = 0, image_right = 0, image_top = 0, image_bottom = 0;
-  Triangle_Positions_t positions;
+  int32_t decision;  /* Decision Variable */
+  int32_t current_x; /* Current X Value */
+  int32_t current_y; /* Current Y Value */
+  int32_t run_start; /* First X Value of the current row */
+  int32_t x_pos = (int32_t)Xpos, y_pos = (int32_t)Ypos, radius = (int32_t)Radius;
+
+  /* Nothing to draw when the circle is out of the clipping rectangle */
+  if(IsClipped(x_pos - radius, y_pos - radius, x_pos + radius, y_pos + radius) != 0U)
+  {
+    return;
+  }
 
-  image_left = image_right = Points->X;
-  image_top= image_bottom = Points->Y;
+  decision = 3 - (radius << 1);
+  current_x = 0;
+  current_y = radius;
+  run_start = 0;
 
-  for(counter = 1; counter < PointCount; counter++)
+  /* Each octant pixel run sharing current_y is one line: horizontal at rows
+     Ypos +/- current_y, vertical at columns Xpos +/- current_y. The 45 degree
+     pixel is only drawn by the horizontal one. */
+  while (current_x <= current_y)
   {
-    pixel_x = POLY_X(counter);
-    if(pixel_x < image_left)
+    if (decision < 0)
     {
-      image_left = pixel_x;
+      decision += (current_x << 2) + 6;
     }
-    if(pixel_x > image_right)
+    else
     {
-      image_right = pixel_x;
+      MirrorHSpan(x_pos, y_pos, run_start, current_x, current_y, Color);
+      MirrorVSpan(x_pos, y_pos, current_y, run_start, (current_x == current_y) ? (current_x - 1) : current_x, Color);
+      decision += ((current_x - current_y) * 4) + 10;
+      current_y--;
+      run_start = current_x + 1;
     }
+    current_x++;
+  }
 
-    pixel_y = POLY_Y(counter);
-    if(pixel_y < image_top)
-    {
-      image_top = pixel_y;
-    }
-    if(pixel_y > image_bottom)
-    {
-      image_bottom = pixel_y;
-    }
+  if (run_start < current_x)
+  {
+    current_x--;
+    MirrorHSpan(x_pos, y_pos, run_start, current_x, current_y, Color);
+    MirrorVSpan(x_pos, y_pos, current_y, run_start, (current_x == current_y) ? (current_x - 1) : current_x, Color);
   }
+}
+
+/**
+  * @brief  Draws an poly-line (between many points) in currently active layer.
+  * @param  Points      Pointer to the points array
+  * @param  PointCount  Number of points
+  * @param  Color       Draw color
+  */
+void UTIL_LCD_DrawPolygon(pPoint Points, uint32_t PointCount, uint32_t Color)
+{
+  int16_t x_pos = 0, y_pos = 0;
 
   if(PointCount < 2)
   {
     return;
   }
 
-  x_center = (image_left + image_right)/2;
-  y_center = (image_bottom + image_top)/2;
-
-  x_first = Points->X;
-  y_first = Points->Y;
+  UTIL_LCD_DrawLine(Points->X, Points->Y, (Points+PointCount-1)->X, (Points+PointCount-1)->Y, Color);
 
   while(--PointCount)
   {
-    X = Points->X;
-    Y = Points->Y;
+    x_pos = Points->X;
+    y_pos = Points->Y;
     Points++;
-    X2 = Points->X;
-    Y2 = Points->Y;
-    positions.x1 = X;
-    positions.y1 = Y;
-    positions.x2 = X2;
-    positions.y2 = Y2;
-    positions.x3 = x_center;
-    positions.y3 = y_center;
-    FillTriangle(&positions, Color);
-
-    positions.x2 = x_center;
-    positions.y2 = y_center;
-    positions.x3 = X2;
-    positions.y3 = Y2;
-    FillTriangle(&positions, Color);
-
-    positions.x1 = x_center;
-    positions.y1 = y_center;
-    positions.x2 = X2;
-    positions.y2 = Y2;
-    positions.x3 = X;
-    positions.y3 = Y;
-    FillTriangle(&positions, Color);
-  }
-
-    positions.x1 = x_first;
-    positions.y1 = y_first;
-    positions.x2 = X2;
-    positions.y2 = Y2;
-    positions.x3 = x_center;
-    positions.y3 = y_center;
-    FillTriangle(&positions, Color);
-
-    positions.x2 = x_center;
-    positions.y2 = y_center;
-    positions.x3 = X2;
-    positions.y3 = Y2;
-    FillTriangle(&positions, Color);
-
-    positions.x1 = x_center;
-    positions.y1 = y_center;
-    positions.x2 = X2;
-    positions.y2 = Y2;
-    positions.x3 = x_first;
-    positions.y3 = y_first;
-    FillTriangle(&positions, Color);
+    UTIL_LCD_DrawLine(x_pos, y_pos, Points->X, Points->Y, Color);
+  }
 }
 
 /**
-  * @brief  Draws a full ellipse in currently active layer.
+  * @brief  Draws an ellipse on LCD in currently active layer.
   * @param  Xpos    X position
   * @param  Ypos    Y position
   * @param  XRadius Ellipse X radius
   * @param  YRadius Ellipse Y radius
   * @param  Color   Draw color
   */
-void UTIL_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color)
+void UTIL_LCD_DrawEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color)
 {
-  int x_pos = 0, y_pos = -YRadius, err = 2-2*XRadius, e2;
-  float k = 0, rad1 = 0, rad2 = 0;
-
-  rad1 = XRadius;
-  rad2 = YRadius;
-
-  k = (float)(rad2/rad1);
+  int64_t x_rad2, y_rad2;
+  int32_t y_pos, half_width, next_width, run_start, column = -1, column_start = 0;
 
-  do
+  /* Nothing to draw when the ellipse is out of the clipping rectangle */
+  if((XRadius < 0) || (YRadius < 0) ||
+     (IsClipped(Xpos - XRadius, Ypos - YRadius, Xpos + XRadius, Ypos + YRadius) != 0U))
   {
-    UTIL_LCD_DrawHLine((Xpos-(uint32_t)(x_pos/k)), (Ypos + y_pos), (2*(uint32_t)(x_pos/k) + 1), Color);
-    UTIL_LCD_DrawHLine((Xpos-(uint32_t)(x_pos/k)), (Ypos - y_pos), (2*(uint32_t)(x_pos/k) + 1), Color);
-
-    e2 = err;
-    if (e2 <= x_pos)
-    {
-      err += ++x_pos*2+1;
-      if (-y_pos == x_pos && e2 <= y_pos) e2 = 0;
-    }
-    if (e2 > y_pos) err += ++y_pos*2+1;
+    return;
   }
-  while (y_pos <= 0);
-}
-
-/**
-  * @brief  Draws a character on LCD.
-  * @param  Xpos  Line where to display the character shape
-  * @param  Ypos  Start column address
-  * @param  pData Pointer to the character data
-  */
-static void DrawChar(uint32_t Xpos, uint32_t Ypos, const uint8_t *pData)
-{
-  uint32_t i = 0, j = 0, offset;
-  uint32_t height, width;
-  uint8_t  *pchar;
-  uint32_t line;
-
-  height = DrawProp[DrawProp->LcdLayer].pFont->Height;
-  width  = DrawProp[DrawProp->LcdLayer].pFont->Width;
-  uint16_t rgb565[24];
-  uint32_t argb8888[24];
 
-  offset =  8 *((width + 7)/8) -  width ;
+  x_rad2 = (int64_t)XRadius * XRadius;
+  y_rad2 = (int64_t)YRadius * YRadius;
+  half_width = XRadius;
 
-  for(i = 0; i < height; i++)
+  /* The outline is the border of UTIL_LCD_FillEllipse() area: on each row of a
+     quadrant, the pixels not covered by the next row outward. Single pixel
+     rows on the same column are merged in one vertical line. */
+  for(y_pos = 0; y_pos <= YRadius; y_pos++)
   {
-    pchar = ((uint8_t *)pData + (width + 7)/8 * i);
-
-    switch(((width + 7)/8))
-    {
-
-    case 1:
-      line =  pchar[0];
-      break;
-
-    case 2:
-      line =  (pchar[0]<< 8) | pchar[1];
-      break;
-
-    case 3:
-    default:
-      line =  (pchar[0]<< 16) | (pchar[1]<< 8) | pchar[2];
-      break;
-    }
+    next_width = (y_pos == YRadius) ? -1 : EllipseHalfWidth(half_width, y_pos + 1, x_rad2, y_rad2);
+    run_start  = MIN(next_width + 1, half_width);
 
-    if(DrawProp[DrawProp->LcdLayer].LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+    if(run_start == half_width)
     {
-      for (j = 0; j < width; j++)
+      if(column != half_width)
       {
-        if(line & (1 << (width- j + offset- 1)))
-        {
-          rgb565[j] = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].TextColor);
-        }
-        else
+        if(column >= 0)
         {
-          rgb565[j] = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].BackColor);
+          MirrorVSpan(Xpos, Ypos, column, column_start, y_pos - 1, Color);
         }
+        column = half_width;
+        column_start = y_pos;
       }
-      UTIL_LCD_FillRGBRect(Xpos,  Ypos++, (uint8_t*)&rgb565[0], width, 1);
     }
     else
     {
-      for (j = 0; j < width; j++)
+      if(column >= 0)
       {
-        if(line & (1 << (width- j + offset- 1)))
-        {
-          argb8888[j] = DrawProp[DrawProp->LcdLayer].TextColor;
-        }
-        else
-        {
-          argb8888[j] = DrawProp[DrawProp->LcdLayer].BackColor;
-        }
+        MirrorVSpan(Xpos, Ypos, column, column_start, y_pos - 1, Color);
+        column = -1;
       }
-      UTIL_LCD_FillRGBRect(Xpos,  Ypos++, (uint8_t*)&argb8888[0], width, 1);
+      MirrorHSpan(Xpos, Ypos, run_start, half_width, y_pos, Color);
     }
+    half_width = next_width;
+  }
+
+  if(column >= 0)
+  {
+    MirrorVSpan(Xpos, Ypos, column, column_start, YRadius, Color);
   }
 }
 
 /**
-  * @brief  Fills a triangle (between 3 points).
-  * @param  Positions  pointer to riangle coordinates
-  * @param  Color      Draw color
+  * @brief  Draws a bitmap picture loaded in the internal Flash (32 bpp) in currently active layer.
+  * @note   A partly visible bitmap is sent to the driver as RGB rectangles. 16,
+  *         24 and 32 bpp bitmaps of another depth than the display are
+  *         converted in the text run buffer, except on indexed displays.
+  *         Other partly visible bitmaps are not drawn.
+  * @param  Xpos  Bmp X position in the LCD
+  * @param  Ypos  Bmp Y position in the LCD
+  * @param  pData Pointer to Bmp picture address in the internal Flash
   */
-static void FillTriangle(Triangle_Positions_t *Positions, uint32_t Color)
+void UTIL_LCD_DrawBitmap(uint32_t Xpos, uint32_t Ypos, uint8_t *pData)
 {
-  int16_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0,
-  yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0,
-  curpixel = 0;
-  int32_t x_diff, y_diff;
-
-  x_diff = Positions->x2 - Positions->x1;
-  y_diff = Positions->y2 - Positions->y1;
-
-  deltax = ABS(x_diff);         /* The absolute difference between the x's */
-  deltay = ABS(y_diff);         /* The absolute difference between the y's */
-  x = Positions->x1;                       /* Start x off at the first pixel */
-  y = Positions->y1;                       /* Start y off at the first pixel */
-
-  if (Positions->x2 >= Positions->x1)                 /* The x-values are increasing */
-  {
-    xinc1 = 1;
-    xinc2 = 1;
-  }
-  else                          /* The x-values are decreasing */
+  uint32_t index, width, height, bpp, stride, bytes, src_row, j;
+  uint32_t x = Xpos, y = Ypos, w, h;
+  uint32_t top_down = 0;
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  uint32_t out, chunk, rows = 1, count, i, k;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+  /* Get bitmap data address offset, size and bits per pixel */
+  index  = ((uint32_t)pData[13] << 24) | ((uint32_t)pData[12] << 16) | ((uint32_t)pData[11] << 8) | (uint32_t)pData[10];
+  width  = ((uint32_t)pData[21] << 24) | ((uint32_t)pData[20] << 16) | ((uint32_t)pData[19] << 8) | (uint32_t)pData[18];
+  height = ((uint32_t)pData[25] << 24) | ((uint32_t)pData[24] << 16) | ((uint32_t)pData[23] << 8) | (uint32_t)pData[22];
+  bpp    = ((uint32_t)pData[29] << 8) | (uint32_t)pData[28];
+
+  if((height & 0x80000000U) != 0U)
   {
-    xinc1 = -1;
-    xinc2 = -1;
+    height   = (uint32_t)(-(int32_t)height);
+    top_down = 1;
   }
+  w = width;
+  h = height;
 
-  if (Positions->y2 >= Positions->y1)                 /* The y-values are increasing */
-  {
-    yinc1 = 1;
-    yinc2 = 1;
-  }
-  else                          /* The y-values are decreasing */
-  {
-    yinc1 = -1;
-    yinc2 = -1;
-  }
+  /* BMP rows are padded to 32-bit */
+  bytes  = bpp / 8U;
+  stride = ((width * bytes) + 3U) & ~3U;
 
-  if (deltax >= deltay)         /* There is at least one x-value for every y-value */
+  if(ClipRect(&x, &y, &w, &h) == 0U)
   {
-    xinc1 = 0;                  /* Don't change the x when numerator >= denominator */
-    yinc2 = 0;                  /* Don't change the y for every iteration */
-    den = deltax;
-    num = deltax / 2;
-    numadd = deltay;
-    numpixels = deltax;         /* There are more x-values than y-values */
+    /* Bitmap is clipped */
   }
-  else                          /* There is at least one y-value for every x-value */
+  else if((w == width) && (h == height))
   {
-    xinc2 = 0;                  /* Don't change the x for every iteration */
-    yinc1 = 0;                  /* Don't change the y when numerator >= denominator */
-    den = deltay;
-    num = deltay / 2;
-    numadd = deltax;
-    numpixels = deltay;         /* There are more y-values than x-values */
+    FuncDriver.DrawBitmap(DrawProp->LcdDevice, Xpos, Ypos, pData);
   }
-
-  for (curpixel = 0; curpixel <= numpixels; curpixel++)
+  else if(((bpp == 16U) && (DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)) ||
+          ((bpp == 32U) && (DrawProp->LcdPixelFormat != LCD_PIXEL_FORMAT_RGB565)))
   {
-    UTIL_LCD_DrawLine(x, y, Positions->x3, Positions->y3, Color);
-
-    num += numadd;              /* Increase the numerator by the top of the fraction */
-    if (num >= den)             /* Check if numerator >= denominator */
+    /* Send the visible part of the rows */
+    for(j = 0; j < h; j++)
     {
-      num -= den;               /* Calculate the new numerator value */
-      x += xinc1;               /* Change the x as appropriate */
-      y += yinc1;               /* Change the y as appropriate */
+      src_row = (y + j) - Ypos;
+      if(top_down == 0U)
+      {
+        src_row = height - 1U - src_row;
+      }
+      FuncDriver.FillRGBRect(DrawProp->LcdDevice, x, y + j, &pData[index + (src_row * stride) + ((x - Xpos) * bytes)], w, 1);
     }
-    x += xinc2;                 /* Change the x as appropriate */
-    y += yinc2;                 /* Change the y as appropriate */
   }
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  else if(((bpp == 16U) || (bpp == 24U) || (bpp == 32U)) &&
+          (DrawProp->LcdPixelFormat != LCD_PIXEL_FORMAT_L8) && (DrawProp->LcdPixelFormat != LCD_PIXEL_FORMAT_AL44))
+  {
+    /* Convert the visible part of the rows in the text run buffer, as many
+       rows as fit in it or pieces of a wider row */
+    out   = (DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565) ? 2U : 4U;
+    chunk = (UTIL_LCD_TEXT_RUN_SIZE * 2U) / out;
+    for(j = 0; j < h; j += rows)
+    {
+      rows = (w <= chunk) ? MIN(chunk / w, h - j) : 1U;
+      for(i = 0; i < w; i += count)
+      {
+        count = MIN(chunk, w - i);
+        for(k = 0; k < rows; k++)
+        {
+          src_row = (y + j + k) - Ypos;
+          if(top_down == 0U)
+          {
+            src_row = height - 1U - src_row;
+          }
+          ConvertBitmapPixels(&((uint8_t*)TextRun)[k * count * out],
+                              &pData[index + (src_row * stride) + ((x + i - Xpos) * bytes)], bpp, count);
+        }
+        FuncDriver.FillRGBRect(DrawProp->LcdDevice, x + i, y + j, (uint8_t*)TextRun, count, rows);
+      }
+    }
+  }
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+  else
+  {
+    /* Partly visible bitmap of another depth: not drawn */
+  }
+}
+
+/**
+  * @brief  Draws a full rectangle in currently active layer.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Rectangle width
+  * @param  Height Rectangle height
+  * @param  Color  Draw color
+  */
+void UTIL_LCD_FillRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  /* Fill the rectangle */
+  if(ClipRect(&Xpos, &Ypos, &Width, &Height) == 0U)
+  {
+    /* Rectangle is clipped */
+  }
+  else if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+  {
+    FuncDriver.FillRect(DrawProp->LcdDevice, Xpos, Ypos, Width, Height, CONVERTARGB88882RGB565(Color));
+  }
+  else
+  {
+    FuncDriver.FillRect(DrawProp->LcdDevice, Xpos, Ypos, Width, Height, Color);
+  }
+}
+
+/**
+  * @brief  Draws a full circle in currently active layer.
+  * @note   The circle is filled with one horizontal span per row, each span
+  *         covering the pixels of UTIL_LCD_DrawCircle() outline on that row.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Radius Circle radius
+  * @param  Color  Draw color
+  */
+void UTIL_LCD_FillCircle(uint32_t Xpos, uint32_t Ypos, uint32_t Radius, uint32_t Color)
+{
+  int32_t decision;  /* Decision Variable */
+  int32_t current_x; /* Current X Value */
+  int32_t current_y; /* Current Y Value */
+
+  /* Nothing to draw when the circle is out of the clipping rectangle */
+  if(IsClipped((int32_t)Xpos - (int32_t)Radius, (int32_t)Ypos - (int32_t)Radius,
+               (int32_t)Xpos + (int32_t)Radius, (int32_t)Ypos + (int32_t)Radius) != 0U)
+  {
+    return;
+  }
+
+  decision = 3 - ((int32_t)Radius << 1);
+  current_x = 0;
+  current_y = (int32_t)Radius;
+
+  while (current_x <= current_y)
+  {
+    /* Rows Ypos +/- current_x are crossed by the outline at +/- current_y */
+    MirrorHSpan((int32_t)Xpos, (int32_t)Ypos, 0, current_y, current_x, Color);
+
+    if (decision < 0)
+    {
+      decision += (current_x << 2) + 6;
+    }
+    else
+    {
+      /* Rows Ypos +/- current_y are complete, unless already drawn above */
+      if(current_y != current_x)
+      {
+        MirrorHSpan((int32_t)Xpos, (int32_t)Ypos, 0, current_x, current_y, Color);
+      }
+      decision += ((current_x - current_y) * 4) + 10;
+      current_y--;
+    }
+    current_x++;
+  }
+}
+
+/**
+  * @brief  Draws a full poly-line (between many points) in currently active layer.
+  * @note   Same as UTIL_LCD_FillPolygonEx() with the non-zero winding rule.
+  * @param  Points     Pointer to the points array
+  * @param  PointCount Number of points
+  * @param  Color      Draw color
+  */
+void UTIL_LCD_FillPolygon(pPoint Points, uint32_t PointCount, uint32_t Color)
+{
+  UTIL_LCD_FillPolygonEx(Points, PointCount, UTIL_LCD_FILL_RULE_NONZERO, Color);
+}
+
+/**
+  * @brief  Draws a full poly-line (between many points) in currently active layer
+  *         with the given fill rule.
+  * @note   Scanline fill with an active edge table: a pixel is filled when its
+  *         centre is inside the polygon, so that polygons sharing an edge do
+  *         not overlap. One horizontal line is drawn per scanline and interval.
+  *         Polygons of more than UTIL_LCD_POLY_MAX_POINTS points are filled
+  *         with the same pixels by a slower fill without edge table.
+  * @param  Points     Pointer to the points array
+  * @param  PointCount Number of points
+  * @param  FillRule   Fill rule
+  *         This parameter can be one of the following values:
+  *           @arg  UTIL_LCD_FILL_RULE_EVENODD
+  *           @arg  UTIL_LCD_FILL_RULE_NONZERO
+  * @param  Color      Draw color
+  */
+void UTIL_LCD_FillPolygonEx(pPoint Points, uint32_t PointCount, uint32_t FillRule, uint32_t Color)
+{
+  PolyEdge_t  new_edge;
+  PolyEdge_t *edge;
+  uint32_t edge_count = 0, active_count = 0, next_edge = 0, pending = 0, counter, index;
+  int32_t  y_pos, y_end, x_start = 0, x_end = 0, winding, inside, was_inside;
+
+  if(PointCount < 3U)
+  {
+    return;
+  }
+
+  if(PointCount > UTIL_LCD_POLY_MAX_POINTS)
+  {
+    FillPolygonLarge(Points, PointCount, FillRule, Color);
+    return;
+  }
+
+  /* Build the edge table sorted on the first scanline, horizontal edges never
+     cross a pixel centre */
+  y_end = 0;
+  for(counter = 0; counter < PointCount; counter++)
+  {
+    if(MakeEdge(Points, PointCount, counter, &new_edge) != 0U)
+    {
+      if(new_edge.YMax > y_end)
+      {
+        y_end = new_edge.YMax;
+      }
+
+      for(index = edge_count; (index > 0U) && (PolyEdge[index - 1U].YMin > new_edge.YMin); index--)
+      {
+        PolyEdge[index] = PolyEdge[index - 1U];
+      }
+      PolyEdge[index] = new_edge;
+      edge_count++;
+    }
+  }
+
+  if(edge_count == 0U)
+  {
+    return;
+  }
+
+  /* Scanlines out of the clipping rectangle are skipped */
+  y_pos = PolyEdge[0].YMin;
+  if(y_pos < (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y0)
+  {
+    y_pos = (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y0;
+  }
+  if(y_end > (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y1)
+  {
+    y_end = (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y1;
+  }
+
+  for(; y_pos < y_end; y_pos++)
+  {
+    /* Retire the edges ending above this scanline */
+    index = 0;
+    for(counter = 0; counter < active_count; counter++)
+    {
+      if(PolyActive[counter]->YMax > y_pos)
+      {
+        PolyActive[index] = PolyActive[counter];
+        index++;
+      }
+    }
+    active_count = index;
+
+    /* Activate the edges starting on this scanline */
+    while((next_edge < edge_count) && (PolyEdge[next_edge].YMin <= y_pos))
+    {
+      edge = &PolyEdge[next_edge];
+      if(edge->YMax > y_pos)
+      {
+        StartEdge(edge, y_pos);
+        PolyActive[active_count] = edge;
+        active_count++;
+      }
+      next_edge++;
+    }
+
+    /* Sort the active edges on X, the order mostly holds from one scanline
+       to the next */
+    for(counter = 1; counter < active_count; counter++)
+    {
+      edge = PolyActive[counter];
+      for(index = counter; (index > 0U) && (PolyActive[index - 1U]->X > edge->X); index--)
+      {
+        PolyActive[index] = PolyActive[index - 1U];
+      }
+      PolyActive[index] = edge;
+    }
+
+    /* Draw one span per inside interval and step the edges */
+    winding = 0;
+    inside  = 0;
+    for(counter = 0; counter < active_count; counter++)
+    {
+      edge = PolyActive[counter];
+      was_inside = inside;
+      if(FillRule == UTIL_LCD_FILL_RULE_EVENODD)
+      {
+        winding ^= 1;
+      }
+      else
+      {
+        winding += edge->Winding;
+      }
+      inside = (winding != 0) ? 1 : 0;
+
+      if((was_inside == 0) && (inside != 0))
+      {
+        /* Intervals touching each other are drawn as one span */
+        if((pending == 0U) || (edge->X != x_end))
+        {
+          if(pending != 0U)
+          {
+            FillSpan(x_start, x_end, y_pos, Color);
+          }
+          x_start = edge->X;
+        }
+        pending = 0U;
+      }
+      else if((was_inside != 0) && (inside == 0))
+      {
+        x_end   = edge->X;
+        pending = 1U;
+      }
+      else
+      {
+        /* Crossing inside the same interval */
+      }
+
+      edge->X   += edge->Step;
+      edge->Rem -= edge->StepRem;
+      if(edge->Rem < 0)
+      {
+        edge->X++;
+        edge->Rem += edge->Den;
+      }
+    }
+
+    if(pending != 0U)
+    {
+      FillSpan(x_start, x_end, y_pos, Color);
+      pending = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Draws a full ellipse in currently active layer.
+  * @note   The ellipse is filled with one horizontal span per row, covering
+  *         the pixels whose centre is inside the ellipse.
+  * @param  Xpos    X position
+  * @param  Ypos    Y position
+  * @param  XRadius Ellipse X radius
+  * @param  YRadius Ellipse Y radius
+  * @param  Color   Draw color
+  */
+void UTIL_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color)
+{
+  int64_t x_rad2, y_rad2;
+  int32_t y_pos, half_width;
+
+  if((XRadius >= 0) && (YRadius >= 0) &&
+     (IsClipped(Xpos - XRadius, Ypos - YRadius, Xpos + XRadius, Ypos + YRadius) == 0U))
+  {
+    x_rad2 = (int64_t)XRadius * XRadius;
+    y_rad2 = (int64_t)YRadius * YRadius;
+    half_width = XRadius;
+
+    for(y_pos = 0; y_pos <= YRadius; y_pos++)
+    {
+      half_width = EllipseHalfWidth(half_width, y_pos, x_rad2, y_rad2);
+      MirrorHSpan(Xpos, Ypos, 0, half_width, y_pos, Color);
+    }
+  }
+}
+
+/**
+  * @brief  Fills a rectangle with a linear gradient in currently active layer.
+  * @param  Xpos      X position
+  * @param  Ypos      Y position
+  * @param  Width     Rectangle width
+  * @param  Height    Rectangle height
+  * @param  Color1    Color of the first column or row
+  * @param  Color2    Color of the last column or row
+  * @param  Direction Gradient direction
+  *         This parameter can be one of the following values:
+  *           @arg  UTIL_LCD_GRADIENT_HORIZONTAL
+  *           @arg  UTIL_LCD_GRADIENT_VERTICAL
+  */
+void UTIL_LCD_FillLinearGradient(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                                 uint32_t Color1, uint32_t Color2, uint32_t Direction)
+{
+  Fill.Color1 = Color1;
+  Fill.Color2 = Color2;
+  Fill.Xpos   = (int32_t)Xpos;
+  Fill.Ypos   = (int32_t)Ypos;
+
+  if(Direction == UTIL_LCD_GRADIENT_HORIZONTAL)
+  {
+    /* Rows only differ by the dither */
+    Fill.Type   = FILL_LINEAR_H;
+    Fill.Length = (Width != 0U) ? (Width - 1U) : 0U;
+    DrawFill(Xpos, Ypos, Width, Height, 4U);
+  }
+  else
+  {
+    Fill.Type   = FILL_LINEAR_V;
+    Fill.Length = (Height != 0U) ? (Height - 1U) : 0U;
+    DrawFill(Xpos, Ypos, Width, Height, 0U);
+  }
+}
+
+/**
+  * @brief  Fills a rectangle with a radial gradient in currently active layer.
+  * @param  Xpos    X position
+  * @param  Ypos    Y position
+  * @param  Width   Rectangle width
+  * @param  Height  Rectangle height
+  * @param  Xcenter Gradient centre X position, may be out of the rectangle
+  * @param  Ycenter Gradient centre Y position, may be out of the rectangle
+  * @param  Radius  Distance to the centre where Color2 is reached
+  * @param  Color1  Color at the centre
+  * @param  Color2  Color at Radius and beyond
+  */
+void UTIL_LCD_FillRadialGradient(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                                 int32_t Xcenter, int32_t Ycenter, uint32_t Radius, uint32_t Color1, uint32_t Color2)
+{
+  Fill.Type   = FILL_RADIAL;
+  Fill.Color1 = Color1;
+  Fill.Color2 = Color2;
+  Fill.Xpos   = Xcenter;
+  Fill.Ypos   = Ycenter;
+  Fill.Length = Radius;
+
+  DrawFill(Xpos, Ypos, Width, Height, 0U);
+}
+
+/**
+  * @brief  Fills a rectangle with a 8x8 two colors pattern in currently
+  *         active layer. The pattern is anchored on the display origin, so
+  *         that adjacent fills join seamlessly.
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Rectangle width
+  * @param  Height   Rectangle height
+  * @param  pPattern 8 bytes, one per row, most significant bit on the left
+  * @param  Color1   Color of the set bits
+  * @param  Color2   Color of the cleared bits
+  */
+void UTIL_LCD_FillPattern(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                          const uint8_t *pPattern, uint32_t Color1, uint32_t Color2)
+{
+  Fill.Type     = FILL_PATTERN;
+  Fill.Color1   = Color1;
+  Fill.Color2   = Color2;
+  Fill.pPattern = pPattern;
+
+  DrawFill(Xpos, Ypos, Width, Height, 8U);
+}
+
+/**
+  * @brief  Draws a character on LCD.
+  * @param  Xpos  Line where to display the character shape
+  * @param  Ypos  Start column address
+  * @param  pData Pointer to the character data
+  */
+static void DrawChar(uint32_t Xpos, uint32_t Ypos, const uint8_t *pData)
+{
+  uint32_t i = 0, j = 0, offset;
+  uint32_t height, width;
+  uint8_t  *pchar;
+  uint32_t line;
+
+  height = DrawProp[DrawProp->LcdLayer].pFont->Height;
+  width  = DrawProp[DrawProp->LcdLayer].pFont->Width;
+  uint16_t rgb565[24];
+  uint32_t argb8888[24];
+
+  offset =  8 *((width + 7)/8) -  width ;
+
+  for(i = 0; i < height; i++)
+  {
+    pchar = ((uint8_t *)pData + (width + 7)/8 * i);
+
+    switch(((width + 7)/8))
+    {
+
+    case 1:
+      line =  pchar[0];
+      break;
+
+    case 2:
+      line =  (pchar[0]<< 8) | pchar[1];
+      break;
+
+    case 3:
+    default:
+      line =  (pchar[0]<< 16) | (pchar[1]<< 8) | pchar[2];
+      break;
+    }
+
+    if(DrawProp[DrawProp->LcdLayer].LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+    {
+      for (j = 0; j < width; j++)
+      {
+        if(line & (1 << (width- j + offset- 1)))
+        {
+          rgb565[j] = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].TextColor);
+        }
+        else
+        {
+          rgb565[j] = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].BackColor);
+        }
+      }
+      UTIL_LCD_FillRGBRect(Xpos,  Ypos++, (uint8_t*)&rgb565[0], width, 1);
+    }
+    else
+    {
+      for (j = 0; j < width; j++)
+      {
+        if(line & (1 << (width- j + offset- 1)))
+        {
+          argb8888[j] = DrawProp[DrawProp->LcdLayer].TextColor;
+        }
+        else
+        {
+          argb8888[j] = DrawProp[DrawProp->LcdLayer].BackColor;
+        }
+      }
+      UTIL_LCD_FillRGBRect(Xpos,  Ypos++, (uint8_t*)&argb8888[0], width, 1);
+    }
+  }
+}
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+/**
+  * @brief  Gets a character of the current font expanded in RGB565 with the
+  *         current text and back colors, from the glyph cache.
+  * @param  Ascii Character ascii code
+  * @retval Pointer to the expanded glyph, NULL if it does not fit in the cache
+  */
+static uint16_t *GetGlyph(uint8_t Ascii)
+{
+  GlyphCache_Entry_t *entry;
+  const sFONT *font = DrawProp[DrawProp->LcdLayer].pFont;
+  const uint8_t *pchar;
+  uint16_t *glyph = NULL;
+  uint32_t text_color, back_color;
+  uint32_t size, i, j, free_idx, lru_idx;
+
+  size       = (uint32_t)font->Width * font->Height;
+  text_color = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].TextColor);
+  back_color = CONVERTARGB88882RGB565(DrawProp[DrawProp->LcdLayer].BackColor);
+
+  if(size <= UTIL_LCD_GLYPH_CACHE_SIZE)
+  {
+    GlyphCache.Tick++;
+
+    /* Look for the glyph in the cache */
+    for(i = 0; (i < UTIL_LCD_GLYPH_CACHE_ENTRIES) && (glyph == NULL); i++)
+    {
+      entry = &GlyphCache.Entry[i];
+      if((entry->Size != 0U) && (entry->pFont == font) && (entry->Ascii == Ascii) &&
+         (entry->TextColor == text_color) && (entry->BackColor == back_color))
+      {
+        entry->LastUse = GlyphCache.Tick;
+        glyph = &GlyphCache.Arena[entry->Offset];
+        GlyphCache.Stats.Hits++;
+      }
+    }
+
+    if(glyph == NULL)
+    {
+      GlyphCache.Stats.Misses++;
+
+      /* Evict least recently used glyphs until an entry and room are free */
+      do
+      {
+        free_idx = UTIL_LCD_GLYPH_CACHE_ENTRIES;
+        lru_idx  = UTIL_LCD_GLYPH_CACHE_ENTRIES;
+        for(i = 0; i < UTIL_LCD_GLYPH_CACHE_ENTRIES; i++)
+        {
+          if(GlyphCache.Entry[i].Size == 0U)
+          {
+            free_idx = i;
+          }
+          else if((lru_idx == UTIL_LCD_GLYPH_CACHE_ENTRIES) ||
+                  (GlyphCache.Entry[i].LastUse < GlyphCache.Entry[lru_idx].LastUse))
+          {
+            lru_idx = i;
+          }
+          else
+          {
+            /* Entry more recently used */
+          }
+        }
+
+        if((free_idx == UTIL_LCD_GLYPH_CACHE_ENTRIES) || ((GlyphCache.Used + size) > UTIL_LCD_GLYPH_CACHE_SIZE))
+        {
+          EvictGlyph(lru_idx);
+          free_idx = UTIL_LCD_GLYPH_CACHE_ENTRIES;
+        }
+      } while(free_idx == UTIL_LCD_GLYPH_CACHE_ENTRIES);
+
+      entry            = &GlyphCache.Entry[free_idx];
+      entry->pFont     = font;
+      entry->Ascii     = Ascii;
+      entry->TextColor = text_color;
+      entry->BackColor = back_color;
+      entry->Offset    = GlyphCache.Used;
+      entry->Size      = size;
+      entry->LastUse   = GlyphCache.Tick;
+      GlyphCache.Used += size;
+
+      /* Expand the 1bpp font table, MSB first, rows padded to a byte */
+      glyph = &GlyphCache.Arena[entry->Offset];
+      pchar = &font->table[(Ascii-' ') * font->Height * ((font->Width + 7U) / 8U)];
+      for(j = 0; j < font->Height; j++)
+      {
+        for(i = 0; i < font->Width; i++)
+        {
+          glyph[(j * font->Width) + i] = ((pchar[i / 8U] & (0x80U >> (i % 8U))) != 0U) ? (uint16_t)text_color : (uint16_t)back_color;
+        }
+        pchar += (font->Width + 7U) / 8U;
+      }
+    }
+  }
+
+  return glyph;
+}
+
+/**
+  * @brief  Removes a glyph from the cache and compacts the arena.
+  * @param  Index  Cache entry
+  */
+static void EvictGlyph(uint32_t Index)
+{
+  GlyphCache_Entry_t *entry = &GlyphCache.Entry[Index];
+  uint32_t end = entry->Offset + entry->Size;
+  uint32_t i;
+
+  for(i = end; i < GlyphCache.Used; i++)
+  {
+    GlyphCache.Arena[i - entry->Size] = GlyphCache.Arena[i];
+  }
+  for(i = 0; i < UTIL_LCD_GLYPH_CACHE_ENTRIES; i++)
+  {
+    if((GlyphCache.Entry[i].Size != 0U) && (GlyphCache.Entry[i].Offset >= end))
+    {
+      GlyphCache.Entry[i].Offset -= entry->Size;
+    }
+  }
+
+  GlyphCache.Used -= entry->Size;
+  entry->Size = 0;
+  GlyphCache.Stats.Evictions++;
+}
+
+/**
+  * @brief  Draws a run of characters composed in the text run buffer with a
+  *         single RGB565 rectangle.
+  * @param  Xpos   X position of the first character
+  * @param  Ypos   Y position
+  * @param  Text   Pointer to the characters
+  * @param  Count  Number of characters, fitting in UTIL_LCD_TEXT_RUN_SIZE
+  */
+static void DrawTextRun(uint32_t Xpos, uint32_t Ypos, const uint8_t *Text, uint32_t Count)
+{
+  uint32_t width  = DrawProp[DrawProp->LcdLayer].pFont->Width;
+  uint32_t height = DrawProp[DrawProp->LcdLayer].pFont->Height;
+  uint32_t run_width = Count * width;
+  uint32_t i, j, k;
+  uint16_t *glyph;
+  uint16_t *dst;
+
+  /* Nothing to compose when the run is out of the clipping rectangle */
+  if(IsClipped((int32_t)Xpos, (int32_t)Ypos, (int32_t)(Xpos + run_width - 1U), (int32_t)(Ypos + height - 1U)) != 0U)
+  {
+    return;
+  }
+
+  for(k = 0; k < Count; k++)
+  {
+    glyph = GetGlyph(Text[k]);
+    dst   = &TextRun[k * width];
+    for(j = 0; j < height; j++)
+    {
+      for(i = 0; i < width; i++)
+      {
+        dst[i] = glyph[i];
+      }
+      glyph += width;
+      dst   += run_width;
+    }
+  }
+
+  UTIL_LCD_FillRGBRect(Xpos, Ypos, (uint8_t*)TextRun, run_width, height);
+}
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+/**
+  * @brief  Gets the descriptor of a proportional font character.
+  * @param  pFont  Proportional font
+  * @param  Ascii  Character ascii code
+  * @retval Glyph descriptor, NULL if the character is not in the font
+  */
+static const sGLYPH *GetPGlyph(const sPFONT *pFont, uint8_t Ascii)
+{
+  const sGLYPH *glyph = NULL;
+
+  if((Ascii >= pFont->FirstChar) && (Ascii <= pFont->LastChar))
+  {
+    glyph = &pFont->Glyphs[Ascii - pFont->FirstChar];
+  }
+
+  return glyph;
+}
+
+/**
+  * @brief  Draws a run of proportional font characters composed in the text
+  *         run buffer with a single RGB565 rectangle. Without
+  *         UTIL_LCD_USE_TEXT_BUFFERS, the run is filled with the back color
+  *         and the glyph pixels are drawn one by one.
+  * @param  Xpos   X position of the first character
+  * @param  Ypos   Y position
+  * @param  Text   Pointer to the characters
+  * @param  Count  Number of characters
+  * @param  Width  Sum of the characters advance, fitting in UTIL_LCD_TEXT_RUN_SIZE
+  */
+static void DrawPTextRun(uint32_t Xpos, uint32_t Ypos, const uint8_t *Text, uint32_t Count, uint32_t Width)
+{
+  const sPFONT *font = DrawProp[DrawProp->LcdLayer].pPFont;
+  const sGLYPH *glyph;
+  uint32_t palette[16];
+  uint32_t text_color = DrawProp[DrawProp->LcdLayer].TextColor;
+  uint32_t back_color = DrawProp[DrawProp->LcdLayer].BackColor;
+  uint32_t max_level  = (1U << font->Bpp) - 1U;
+  uint32_t color, level, shift, i;
+  int32_t  pen = 0;
+
+  /* Nothing to compose when the run is out of the clipping rectangle */
+  if(IsClipped((int32_t)Xpos, (int32_t)Ypos, (int32_t)(Xpos + Width - 1U), (int32_t)(Ypos + font->Height - 1U)) != 0U)
+  {
+    return;
+  }
+
+  /* Colors of the anti-aliasing levels, blended per ARGB8888 channel */
+  for(level = 0; level <= max_level; level++)
+  {
+    color = 0xFF000000U;
+    for(shift = 0; shift < 24U; shift += 8U)
+    {
+      color |= (((((back_color >> shift) & 0xFFU) * (max_level - level)) +
+                 (((text_color >> shift) & 0xFFU) * level)) / max_level) << shift;
+    }
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+    palette[level] = CONVERTARGB88882RGB565(color);
+#else
+    palette[level] = color;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+  }
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  for(i = 0; i < (Width * font->Height); i++)
+  {
+    TextRun[i] = (uint16_t)palette[0];
+  }
+#else
+  UTIL_LCD_FillRect(Xpos, Ypos, Width, font->Height, palette[0]);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+  for(i = 0; i < Count; i++)
+  {
+    glyph = GetPGlyph(font, Text[i]);
+    if(glyph != NULL)
+    {
+      DecodePGlyph(font, glyph, pen + glyph->XOffset, Xpos, Ypos, Width, palette);
+      pen += (int32_t)glyph->Advance;
+    }
+  }
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  UTIL_LCD_FillRGBRect(Xpos, Ypos, (uint8_t*)TextRun, Width, font->Height);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+}
+
+/**
+  * @brief  Decodes a proportional font glyph in the text run buffer, or on
+  *         the display without UTIL_LCD_USE_TEXT_BUFFERS.
+  *         Background pixels are left untouched, pixels outside of the run
+  *         are clipped.
+  * @param  pFont     Proportional font
+  * @param  pGlyph    Glyph descriptor
+  * @param  Xpos      Bitmap left column in the run, may be negative
+  * @param  RunXpos   Run X position on the display
+  * @param  RunYpos   Run Y position on the display
+  * @param  RunWidth  Text run width
+  * @param  pPalette  Color of each level, RGB565 in the text run buffer,
+  *                   ARGB8888 on the display
+  */
+static void DecodePGlyph(const sPFONT *pFont, const sGLYPH *pGlyph, int32_t Xpos, uint32_t RunXpos, uint32_t RunYpos,
+                         uint32_t RunWidth, const uint32_t *pPalette)
+{
+  const uint8_t *src = &pFont->Data[pGlyph->Offset];
+  uint32_t total = (uint32_t)pGlyph->Width * pFont->Height;
+  uint32_t max_level = (1U << pFont->Bpp) - 1U;
+  uint32_t pos = 0, bit = 0, count = 0, literal = 0, level = 0;
+  int32_t  x;
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  (void)RunXpos;
+  (void)RunYpos;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+  while(pos < total)
+  {
+    if(pFont->Encoding == PFONT_ENCODING_PACKED)
+    {
+      level = ((uint32_t)src[bit / 8U] >> (8U - pFont->Bpp - (bit % 8U))) & max_level;
+      bit  += pFont->Bpp;
+    }
+    else if(count != 0U)
+    {
+      /* Inside a run or a literal token */
+      if(literal != 0U)
+      {
+        level = ((uint32_t)src[bit / 8U] >> (8U - pFont->Bpp - (bit % 8U))) & max_level;
+        bit  += pFont->Bpp;
+      }
+      count--;
+    }
+    else
+    {
+      /* Skip the bytes of the previous literal token and read the next token */
+      src    += (bit + 7U) / 8U;
+      bit     = 0;
+      literal = ((*src & 0x80U) == 0U) ? 1U : 0U;
+      count   = (literal != 0U) ? ((uint32_t)*src & 0x7FU) : ((uint32_t)*src & 0x3FU);
+      level   = ((*src & 0xC0U) == 0xC0U) ? max_level : 0U;
+      src++;
+      if(literal != 0U)
+      {
+        level = ((uint32_t)src[0] >> (8U - pFont->Bpp)) & max_level;
+        bit   = pFont->Bpp;
+      }
+    }
+
+    if(level != 0U)
+    {
+      x = Xpos + (int32_t)(pos % pGlyph->Width);
+      if((x >= 0) && (x < (int32_t)RunWidth))
+      {
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+        TextRun[((pos / pGlyph->Width) * RunWidth) + (uint32_t)x] = (uint16_t)pPalette[level];
+#else
+        UTIL_LCD_SetPixel((uint16_t)(RunXpos + (uint32_t)x), (uint16_t)(RunYpos + (pos / pGlyph->Width)), pPalette[level]);
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+      }
+    }
+    pos++;
+  }
+}
+
+/**
+  * @brief  Floor division.
+  * @param  Num  Numerator
+  * @param  Den  Denominator, strictly positive
+  * @retval Largest integer not above Num / Den
+  */
+static int64_t FloorDiv(int64_t Num, int64_t Den)
+{
+  int64_t quotient = Num / Den;
+
+  if(((Num % Den) != 0) && (Num < 0))
+  {
+    quotient--;
+  }
+
+  return quotient;
+}
+
+/**
+  * @brief  Builds the polygon edge from a point to the next one.
+  * @param  Points     Pointer to the points array
+  * @param  PointCount Number of points
+  * @param  Index      First point of the edge, the last point joins the first
+  * @param  pEdge      Edge, oriented downward
+  * @retval 0 for a horizontal edge, which never crosses a pixel centre
+  */
+static uint32_t MakeEdge(pPoint Points, uint32_t PointCount, uint32_t Index, PolyEdge_t *pEdge)
+{
+  uint32_t next = ((Index + 1U) == PointCount) ? 0U : (Index + 1U);
+  uint32_t ret = 0;
+  int32_t  x1 = POLY_X(Index), y1 = POLY_Y(Index), x2 = POLY_X(next), y2 = POLY_Y(next);
+
+  if(y1 != y2)
+  {
+    pEdge->Winding = 1;
+    if(y1 > y2)
+    {
+      pEdge->Winding = -1;
+      x1 = POLY_X(next);
+      y1 = POLY_Y(next);
+      x2 = POLY_X(Index);
+      y2 = POLY_Y(Index);
+    }
+    pEdge->YMin    = y1;
+    pEdge->YMax    = y2;
+    pEdge->XMin    = x1;
+    pEdge->DeltaX  = x2 - x1;
+    pEdge->Den     = 2 * (y2 - y1);
+    pEdge->Step    = (int32_t)FloorDiv(2 * (int64_t)pEdge->DeltaX, pEdge->Den);
+    pEdge->StepRem = (2 * pEdge->DeltaX) - (pEdge->Step * pEdge->Den);
+    ret = 1;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Places a polygon edge on its first drawn scanline.
+  * @note   Ypos is sampled at the pixel centre, X is the first pixel whose
+  *         centre is on or right of the edge:
+  *         X = XMin + ceil((DeltaX * (2 * k + 1) - dy) / (2 * dy)) with k = Ypos - YMin,
+  *         Rem is X * Den minus the exact numerator.
+  * @param  pEdge  Edge
+  * @param  Ypos   Scanline
+  */
+static void StartEdge(PolyEdge_t *pEdge, int32_t Ypos)
+{
+  int64_t num;
+  int64_t quotient;
+
+  num = ((int64_t)pEdge->DeltaX * ((2 * (int64_t)(Ypos - pEdge->YMin)) + 1)) - (pEdge->Den / 2);
+  quotient = -FloorDiv(-num, pEdge->Den);
+
+  pEdge->X   = pEdge->XMin + (int32_t)quotient;
+  pEdge->Rem = (int32_t)((quotient * pEdge->Den) - num);
+}
+
+/**
+  * @brief  Fills a polygon of more than UTIL_LCD_POLY_MAX_POINTS points.
+  * @note   Same pixels as the active edge table fill, without the table: the
+  *         crossings of each scanline are found in X order by scanning all the
+  *         edges for each of them. Crossings on the same pixel are taken
+  *         together, so that touching intervals are drawn as one span.
+  * @param  Points     Pointer to the points array
+  * @param  PointCount Number of points
+  * @param  FillRule   UTIL_LCD_FILL_RULE_EVENODD or UTIL_LCD_FILL_RULE_NONZERO
+  * @param  Color      Draw color
+  */
+static void FillPolygonLarge(pPoint Points, uint32_t PointCount, uint32_t FillRule, uint32_t Color)
+{
+  PolyEdge_t edge;
+  uint32_t counter, crossings;
+  int32_t  y_pos, y_end, x_pos, x_next, x_start = 0, winding, delta, was_inside;
+
+  /* Scanlines of the polygon within the clipping rectangle */
+  y_pos = POLY_Y(0);
+  y_end = POLY_Y(0);
+  for(counter = 1; counter < PointCount; counter++)
+  {
+    y_pos = MIN(y_pos, POLY_Y(counter));
+    y_end = MAX(y_end, POLY_Y(counter));
+  }
+  if(y_pos < (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y0)
+  {
+    y_pos = (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y0;
+  }
+  if(y_end > (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y1)
+  {
+    y_end = (int32_t)DrawProp[DrawProp->LcdLayer].Clip.Y1;
+  }
+
+  for(; y_pos < y_end; y_pos++)
+  {
+    winding = 0;
+    x_pos   = INT32_MIN;
+    do
+    {
+      /* Next crossing right of the previous one */
+      x_next    = INT32_MAX;
+      delta     = 0;
+      crossings = 0;
+      for(counter = 0; counter < PointCount; counter++)
+      {
+        if((MakeEdge(Points, PointCount, counter, &edge) != 0U) && (edge.YMin <= y_pos) && (edge.YMax > y_pos))
+        {
+          StartEdge(&edge, y_pos);
+          if((edge.X > x_pos) && (edge.X <= x_next))
+          {
+            if(edge.X < x_next)
+            {
+              x_next    = edge.X;
+              delta     = 0;
+              crossings = 0;
+            }
+            delta += edge.Winding;
+            crossings++;
+          }
+        }
+      }
+
+      if(crossings != 0U)
+      {
+        was_inside = (winding != 0) ? 1 : 0;
+        if(FillRule == UTIL_LCD_FILL_RULE_EVENODD)
+        {
+          winding ^= (int32_t)(crossings & 1U);
+        }
+        else
+        {
+          winding += delta;
+        }
+
+        if((was_inside == 0) && (winding != 0))
+        {
+          x_start = x_next;
+        }
+        else if((was_inside != 0) && (winding == 0))
+        {
+          FillSpan(x_start, x_next, y_pos, Color);
+        }
+        else
+        {
+          /* Crossing inside the same interval */
+        }
+        x_pos = x_next;
+      }
+    } while(crossings != 0U);
+  }
+}
+
+/**
+  * @brief  Draws the pixels [X1, X2[ of a row, clipped to the clipping rectangle.
+  * @param  X1     First pixel
+  * @param  X2     Pixel after the last one
+  * @param  Ypos   Row
+  * @param  Color  Draw color
+  */
+static void FillSpan(int32_t X1, int32_t X2, int32_t Ypos, uint32_t Color)
+{
+  const UTIL_LCD_ClipRect_t *clip = &DrawProp[DrawProp->LcdLayer].Clip;
+
+  if(X1 < (int32_t)clip->X0)
+  {
+    X1 = (int32_t)clip->X0;
+  }
+  if(X2 > (int32_t)clip->X1)
+  {
+    X2 = (int32_t)clip->X1;
+  }
+
+  if((X1 < X2) && (Ypos >= (int32_t)clip->Y0) && (Ypos < (int32_t)clip->Y1))
+  {
+    UTIL_LCD_DrawHLine((uint32_t)X1, (uint32_t)Ypos, (uint32_t)(X2 - X1), Color);
+  }
+}
+
+/**
+  * @brief  Draws the pixels [Y1, Y2[ of a column, clipped to the clipping rectangle.
+  * @param  Xpos   Column
+  * @param  Y1     First pixel
+  * @param  Y2     Pixel after the last one
+  * @param  Color  Draw color
+  */
+static void FillVSpan(int32_t Xpos, int32_t Y1, int32_t Y2, uint32_t Color)
+{
+  const UTIL_LCD_ClipRect_t *clip = &DrawProp[DrawProp->LcdLayer].Clip;
+
+  if(Y1 < (int32_t)clip->Y0)
+  {
+    Y1 = (int32_t)clip->Y0;
+  }
+  if(Y2 > (int32_t)clip->Y1)
+  {
+    Y2 = (int32_t)clip->Y1;
+  }
+
+  if((Y1 < Y2) && (Xpos >= (int32_t)clip->X0) && (Xpos < (int32_t)clip->X1))
+  {
+    UTIL_LCD_DrawVLine((uint32_t)Xpos, (uint32_t)Y1, (uint32_t)(Y2 - Y1), Color);
+  }
+}
+
+/**
+  * @brief  Draws the pixels X1 to X2 right and left of Xpos on the rows Ypos - Dy
+  *         and Ypos + Dy of a shape symmetric about (Xpos, Ypos). Mirrored
+  *         pixels are drawn once.
+  * @param  Xpos   Centre X position
+  * @param  Ypos   Centre Y position
+  * @param  X1     First pixel distance to Xpos, X1 >= 0
+  * @param  X2     Last pixel distance to Xpos
+  * @param  Dy     Row distance to Ypos, Dy >= 0
+  * @param  Color  Draw color
+  */
+static void MirrorHSpan(int32_t Xpos, int32_t Ypos, int32_t X1, int32_t X2, int32_t Dy, uint32_t Color)
+{
+  int32_t y_pos, side;
+
+  for(side = (Dy != 0) ? -1 : 1; (side <= 1) && (X1 <= X2); side += 2)
+  {
+    y_pos = Ypos + (side * Dy);
+    if(X1 == 0)
+    {
+      FillSpan(Xpos - X2, Xpos + X2 + 1, y_pos, Color);
+    }
+    else
+    {
+      FillSpan(Xpos - X2, Xpos - X1 + 1, y_pos, Color);
+      FillSpan(Xpos + X1, Xpos + X2 + 1, y_pos, Color);
+    }
+  }
+}
+
+/**
+  * @brief  Draws the pixels Y1 to Y2 above and below Ypos on the columns
+  *         Xpos - Dx and Xpos + Dx of a shape symmetric about (Xpos, Ypos).
+  *         Mirrored pixels are drawn once.
+  * @param  Xpos   Centre X position
+  * @param  Ypos   Centre Y position
+  * @param  Dx     Column distance to Xpos, Dx >= 0
+  * @param  Y1     First pixel distance to Ypos, Y1 >= 0
+  * @param  Y2     Last pixel distance to Ypos
+  * @param  Color  Draw color
+  */
+static void MirrorVSpan(int32_t Xpos, int32_t Ypos, int32_t Dx, int32_t Y1, int32_t Y2, uint32_t Color)
+{
+  int32_t x_pos, side;
+
+  for(side = (Dx != 0) ? -1 : 1; (side <= 1) && (Y1 <= Y2); side += 2)
+  {
+    x_pos = Xpos + (side * Dx);
+    if(Y1 == 0)
+    {
+      FillVSpan(x_pos, Ypos - Y2, Ypos + Y2 + 1, Color);
+    }
+    else
+    {
+      FillVSpan(x_pos, Ypos - Y2, Ypos - Y1 + 1, Color);
+      FillVSpan(x_pos, Ypos + Y1, Ypos + Y2 + 1, Color);
+    }
+  }
+}
+
+/**
+  * @brief  Ellipse half width on a row.
+  * @param  HalfWidth  Half width on a row closer to the centre
+  * @param  Dy         Row distance to the centre
+  * @param  XRad2      Square of the X radius
+  * @param  YRad2      Square of the Y radius
+  * @retval Largest X not above HalfWidth with X^2 * YRad2 + Dy^2 * XRad2 <= XRad2 * YRad2
+  */
+static int32_t EllipseHalfWidth(int32_t HalfWidth, int32_t Dy, int64_t XRad2, int64_t YRad2)
+{
+  int64_t limit = (XRad2 * YRad2) - ((int64_t)Dy * Dy * XRad2);
+
+  while((HalfWidth > 0) && (((int64_t)HalfWidth * HalfWidth * YRad2) > limit))
+  {
+    HalfWidth--;
+  }
+
+  return HalfWidth;
+}
+
+/**
+  * @brief  Draws the visible part of a rectangle with the fill in progress.
+  * @note   In RGB565 format, rows are composed in the text run buffer and sent
+  *         as many at once as fit in it. Fills whose rows repeat every Period
+  *         rows compose them once. In other formats, each row is drawn with
+  *         one horizontal line per run of same color pixels.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Rectangle width
+  * @param  Height Rectangle height
+  * @param  Period Rows period of the fill, 0 when rows do not repeat
+  */
+static void DrawFill(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Period)
+{
+  uint32_t i, j, run_start, color, next;
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+  uint32_t rows = 0, count, composed = 0, k;
+#else
+  (void)Period;
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+  if(ClipRect(&Xpos, &Ypos, &Width, &Height) != 0U)
+  {
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+    if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+    {
+      rows = UTIL_LCD_TEXT_RUN_SIZE / Width;
+    }
+
+    if(rows != 0U)
+    {
+      if((Period != 0U) && (rows >= Period))
+      {
+        rows -= rows % Period;
+      }
+      else
+      {
+        Period = 0;
+      }
+
+      for(j = 0; j < Height; j += count)
+      {
+        count = MIN(rows, Height - j);
+
+        /* Periodic rows are composed once, the block is then sent again */
+        if((Period == 0U) || (composed < count))
+        {
+          for(i = composed; i < count; i++)
+          {
+            if((Period != 0U) && (i >= Period))
+            {
+              for(k = 0; k < Width; k++)
+              {
+                TextRun[(i * Width) + k] = TextRun[((i - Period) * Width) + k];
+              }
+            }
+            else
+            {
+              ComposeFillRow(&TextRun[i * Width], Xpos, Ypos + j + i, Width);
+            }
+          }
+          composed = (Period != 0U) ? count : 0U;
+        }
+
+        FuncDriver.FillRGBRect(DrawProp->LcdDevice, Xpos, Ypos + j, (uint8_t*)TextRun, Width, count);
+      }
+    }
+    else
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+    {
+      for(j = 0; j < Height; j++)
+      {
+        run_start = 0;
+        color     = GetFillColor(Xpos, Ypos + j);
+        for(i = 1; i <= Width; i++)
+        {
+          next = (i < Width) ? GetFillColor(Xpos + i, Ypos + j) : ~color;
+          if(next != color)
+          {
+            UTIL_LCD_DrawHLine(Xpos + run_start, Ypos + j, i - run_start, color);
+            run_start = i;
+            color     = next;
+          }
+        }
+      }
+    }
+  }
+}
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+/**
+  * @brief  Composes a row of the fill in progress in RGB565, dithered.
+  * @param  pRow   RGB565 pixels
+  * @param  Xpos   X position of the first pixel
+  * @param  Ypos   Row
+  * @param  Width  Number of pixels
+  */
+static void ComposeFillRow(uint16_t *pRow, uint32_t Xpos, uint32_t Ypos, uint32_t Width)
+{
+  const uint32_t *dither = &DitherMatrix[(Ypos & 3U) * 4U];
+  uint32_t i, pos, last_pos, levels, color1, color2, bits;
+  int32_t  dx, dy;
+
+  switch(Fill.Type)
+  {
+  case FILL_LINEAR_H:
+    for(i = 0; i < Width; i++)
+    {
+      dx     = (int32_t)(Xpos + i) - Fill.Xpos;
+      pos    = (dx < 0) ? 0U : MIN((uint32_t)dx, Fill.Length);
+      levels = ColorToLevels(LerpColor(Fill.Color1, Fill.Color2, pos, Fill.Length));
+      pRow[i] = (uint16_t)LEVELS_TO_RGB565(levels + dither[(Xpos + i) & 3U]);
+    }
+    break;
+
+  case FILL_LINEAR_V:
+    /* One color per row, the dither repeats every 4 pixels */
+    dy     = (int32_t)Ypos - Fill.Ypos;
+    pos    = (dy < 0) ? 0U : MIN((uint32_t)dy, Fill.Length);
+    levels = ColorToLevels(LerpColor(Fill.Color1, Fill.Color2, pos, Fill.Length));
+    for(i = 0; i < Width; i++)
+    {
+      pRow[i] = (i < 4U) ? (uint16_t)LEVELS_TO_RGB565(levels + dither[(Xpos + i) & 3U]) : pRow[i - 4U];
+    }
+    break;
+
+  case FILL_RADIAL:
+    /* Pixels at the same whole distance from the centre share their color */
+    dy       = (int32_t)Ypos - Fill.Ypos;
+    last_pos = 0xFFFFFFFFU;
+    levels   = 0;
+    for(i = 0; i < Width; i++)
+    {
+      pos = GetRadialPos((int32_t)(Xpos + i) - Fill.Xpos, dy);
+      if(pos != last_pos)
+      {
+        levels   = ColorToLevels(LerpColor(Fill.Color1, Fill.Color2, pos, Fill.Length));
+        last_pos = pos;
+      }
+      pRow[i] = (uint16_t)LEVELS_TO_RGB565(levels + dither[(Xpos + i) & 3U]);
+    }
+    break;
+
+  case FILL_PATTERN:
+  default:
+    color1 = CONVERTARGB88882RGB565(Fill.Color1);
+    color2 = CONVERTARGB88882RGB565(Fill.Color2);
+    bits   = Fill.pPattern[Ypos & 7U];
+    for(i = 0; i < Width; i++)
+    {
+      pRow[i] = (uint16_t)((((bits << ((Xpos + i) & 7U)) & 0x80U) != 0U) ? color1 : color2);
+    }
+    break;
+  }
+}
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+/**
+  * @brief  Gets the undithered ARGB8888 color of a pixel of the fill in progress.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @retval Color
+  */
+static uint32_t GetFillColor(uint32_t Xpos, uint32_t Ypos)
+{
+  uint32_t color;
+  int32_t  delta;
+
+  switch(Fill.Type)
+  {
+  case FILL_LINEAR_H:
+    delta = (int32_t)Xpos - Fill.Xpos;
+    color = LerpColor(Fill.Color1, Fill.Color2, (delta < 0) ? 0U : MIN((uint32_t)delta, Fill.Length), Fill.Length);
+    break;
+
+  case FILL_LINEAR_V:
+    delta = (int32_t)Ypos - Fill.Ypos;
+    color = LerpColor(Fill.Color1, Fill.Color2, (delta < 0) ? 0U : MIN((uint32_t)delta, Fill.Length), Fill.Length);
+    break;
+
+  case FILL_RADIAL:
+    color = LerpColor(Fill.Color1, Fill.Color2,
+                      GetRadialPos((int32_t)Xpos - Fill.Xpos, (int32_t)Ypos - Fill.Ypos), Fill.Length);
+    break;
+
+  case FILL_PATTERN:
+  default:
+    color = (((Fill.pPattern[Ypos & 7U] << (Xpos & 7U)) & 0x80U) != 0U) ? Fill.Color1 : Fill.Color2;
+    break;
+  }
+
+  return color;
+}
+
+/**
+  * @brief  Radial gradient position of a pixel.
+  * @param  Dx  X distance to the centre
+  * @param  Dy  Y distance to the centre
+  * @retval Whole distance to the centre, rounded to nearest, at most Fill.Length
+  */
+static uint32_t GetRadialPos(int32_t Dx, int32_t Dy)
+{
+  uint64_t dist2 = ((uint64_t)((int64_t)Dx * Dx) + (uint64_t)((int64_t)Dy * Dy));
+  uint64_t root = 0, bit = 1ULL << 62;
+  uint64_t limit = (uint64_t)Fill.Length * Fill.Length;
+  uint32_t pos;
+
+  if(dist2 >= limit)
+  {
+    pos = Fill.Length;
+  }
+  else
+  {
+    /* Bitwise integer square root */
+    while(bit > dist2)
+    {
+      bit >>= 2;
+    }
+    while(bit != 0U)
+    {
+      if(dist2 >= (root + bit))
+      {
+        dist2 -= root + bit;
+        root   = (root >> 1) + bit;
+      }
+      else
+      {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    /* Round to nearest: dist2 now holds the remainder */
+    pos = (uint32_t)root + ((dist2 > root) ? 1U : 0U);
+  }
+
+  return pos;
+}
+
+/**
+  * @brief  Interpolates two ARGB8888 colors per channel.
+  * @param  Color1  Color at position 0
+  * @param  Color2  Color at position Length
+  * @param  Pos     Position, at most Length
+  * @param  Length  Gradient length, 0 for Color1
+  * @retval Color
+  */
+static uint32_t LerpColor(uint32_t Color1, uint32_t Color2, uint32_t Pos, uint32_t Length)
+{
+  uint32_t color = Color1, shift;
+  int32_t  c1, c2;
+
+  if(Length != 0U)
+  {
+    color = 0;
+    for(shift = 0; shift < 32U; shift += 8U)
+    {
+      c1 = (int32_t)((Color1 >> shift) & 0xFFU);
+      c2 = (int32_t)((Color2 >> shift) & 0xFFU);
+      color |= (uint32_t)(c1 + (int32_t)((((int64_t)(c2 - c1) * Pos) + ((c2 >= c1) ? (int64_t)(Length / 2U) : -(int64_t)(Length / 2U))) /
+                                         (int64_t)Length)) << shift;
+    }
+  }
+
+  return color;
+}
+
+#if (UTIL_LCD_USE_TEXT_BUFFERS == 1U)
+/**
+  * @brief  Converts an ARGB8888 color to RGB565 dithering levels: each field
+  *         scaled to 16 times its RGB565 range, in 10-bit lanes (R at bit 20,
+  *         G at bit 10, B at bit 0). Adding a DitherMatrix threshold and
+  *         dropping 4 bits of each lane gives the dithered pixel.
+  * @param  Color  ARGB8888 color
+  * @retval Dithering levels
+  */
+static uint32_t ColorToLevels(uint32_t Color)
+{
+  uint32_t red   = (((((Color >> 16) & 0xFFU) * 31U * 16U) + 127U) / 255U);
+  uint32_t green = (((((Color >> 8) & 0xFFU) * 63U * 16U) + 127U) / 255U);
+  uint32_t blue  = ((((Color & 0xFFU) * 31U * 16U) + 127U) / 255U);
+
+  return (red << 20) | (green << 10) | blue;
+}
+
+/**
+  * @brief  Converts BMP pixels to the current display format: RGB565, or
+  *         ARGB8888 colors in other formats, as sent to FillRGBRect.
+  * @param  pDst   Converted pixels
+  * @param  pSrc   BMP pixels
+  * @param  Bpp    BMP bits per pixel: 16, 24 or 32
+  * @param  Count  Number of pixels
+  */
+static void ConvertBitmapPixels(uint8_t *pDst, const uint8_t *pSrc, uint32_t Bpp, uint32_t Count)
+{
+  uint32_t i, color;
+
+  for(i = 0; i < Count; i++)
+  {
+    if(Bpp == 16U)
+    {
+      color = (uint32_t)pSrc[2U * i] | ((uint32_t)pSrc[(2U * i) + 1U] << 8);
+      color = CONVERTRGB5652ARGB8888(color);
+    }
+    else if(Bpp == 24U)
+    {
+      color = 0xFF000000U | ((uint32_t)pSrc[(3U * i) + 2U] << 16) | ((uint32_t)pSrc[(3U * i) + 1U] << 8) |
+              (uint32_t)pSrc[3U * i];
+    }
+    else
+    {
+      color = ((uint32_t)pSrc[(4U * i) + 3U] << 24) | ((uint32_t)pSrc[(4U * i) + 2U] << 16) |
+              ((uint32_t)pSrc[(4U * i) + 1U] << 8) | (uint32_t)pSrc[4U * i];
+    }
+
+    if(DrawProp->LcdPixelFormat == LCD_PIXEL_FORMAT_RGB565)
+    {
+      color = CONVERTARGB88882RGB565(color);
+      pDst[2U * i]        = (uint8_t)color;
+      pDst[(2U * i) + 1U] = (uint8_t)(color >> 8);
+    }
+    else
+    {
+      pDst[4U * i]        = (uint8_t)color;
+      pDst[(4U * i) + 1U] = (uint8_t)(color >> 8);
+      pDst[(4U * i) + 2U] = (uint8_t)(color >> 16);
+      pDst[(4U * i) + 3U] = (uint8_t)(color >> 24);
+    }
+  }
+}
+#endif /* UTIL_LCD_USE_TEXT_BUFFERS == 1U */
+
+/**
+  * @brief  Clips a rectangle to the clipping rectangle of the current layer.
+  * @param  Xpos   X position, replaced by the first visible column
+  * @param  Ypos   Y position, replaced by the first visible row
+  * @param  Width  Width, replaced by the visible width
+  * @param  Height Height, replaced by the visible height
+  * @retval 1 if part of the rectangle is visible, 0 otherwise
+  */
+static uint32_t ClipRect(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height)
+{
+  const UTIL_LCD_ClipRect_t *clip = &DrawProp[DrawProp->LcdLayer].Clip;
+  uint32_t visible = 0, x1, y1;
+
+  if((*Width != 0U) && (*Height != 0U) && (*Xpos < clip->X1) && (*Ypos < clip->Y1))
+  {
+    x1 = (*Width > (clip->X1 - *Xpos)) ? clip->X1 : (*Xpos + *Width);
+    y1 = (*Height > (clip->Y1 - *Ypos)) ? clip->Y1 : (*Ypos + *Height);
+
+    if((x1 > clip->X0) && (y1 > clip->Y0))
+    {
+      *Xpos   = MAX(*Xpos, clip->X0);
+      *Ypos   = MAX(*Ypos, clip->Y0);
+      *Width  = x1 - *Xpos;
+      *Height = y1 - *Ypos;
+      visible = 1;
+    }
+  }
+
+  return visible;
+}
+
+/**
+  * @brief  Tells whether a bounding box is out of the clipping rectangle of
+  *         the current layer.
+  * @param  X1  Left column
+  * @param  Y1  Top row
+  * @param  X2  Right column (included)
+  * @param  Y2  Bottom row (included)
+  * @retval 1 if no pixel of the box is visible, 0 otherwise
+  */
+static uint32_t IsClipped(int32_t X1, int32_t Y1, int32_t X2, int32_t Y2)
+{
+  const UTIL_LCD_ClipRect_t *clip = &DrawProp[DrawProp->LcdLayer].Clip;
+
+  return ((X2 < (int32_t)clip->X0) || (Y2 < (int32_t)clip->Y0) ||
+          (X1 >= (int32_t)clip->X1) || (Y1 >= (int32_t)clip->Y1)) ? 1U : 0U;
 }
 
 /**
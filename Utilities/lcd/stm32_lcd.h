@@ -50,6 +50,12 @@
 /** @defgroup UTIL_LCD_Exported_Constants STM32 LCD Utility Exported Constants
   * @{
   */
+/**
+  * @brief  LCD Utility status
+  */
+#define UTIL_LCD_OK                  0
+#define UTIL_LCD_ERROR             (-1)
+
 /**
   * @brief  LCD Utility color definitions values
   */
@@ -93,11 +99,30 @@
 #define UTIL_LCD_COLOR_ST_GRAY        0xFF90989EUL
 #define UTIL_LCD_COLOR_ST_GRAY_LIGHT  0xFFB9C4CAUL
 
+/**
+  * @brief LCD Utility polygon fill rules
+  */
+#define UTIL_LCD_FILL_RULE_EVENODD   0U
+#define UTIL_LCD_FILL_RULE_NONZERO   1U
+
+/**
+  * @brief LCD Utility linear gradient directions
+  */
+#define UTIL_LCD_GRADIENT_HORIZONTAL 0U  /*!< From Color1 on the left to Color2 on the right */
+#define UTIL_LCD_GRADIENT_VERTICAL   1U  /*!< From Color1 on the top to Color2 on the bottom */
+
 /**
   * @brief LCD Utility default font
   */
 #define UTIL_LCD_DEFAULT_FONT        Font24
 
+/**
+  * @brief LCD Utility clipping rectangles saved by UTIL_LCD_PushClipRect()
+  */
+#ifndef UTIL_LCD_CLIP_STACK_DEPTH
+  #define UTIL_LCD_CLIP_STACK_DEPTH  4U
+#endif
+
 /**
   * @}
   */
@@ -114,6 +139,17 @@
   * @{
   */
 
+/**
+  * @brief  LCD Utility clipping rectangle, X1 and Y1 excluded
+  */
+typedef struct
+{
+  uint32_t X0;
+  uint32_t Y0;
+  uint32_t X1;
+  uint32_t Y1;
+} UTIL_LCD_ClipRect_t;
+
 /**
   * @brief  LCD Utility Drawing main properties
   */
@@ -122,11 +158,15 @@ typedef struct
   uint32_t  TextColor; /*!< Specifies the color of text */
   uint32_t  BackColor; /*!< Specifies the background color below the text */
   sFONT    *pFont;     /*!< Specifies the font used for the text */
+  const sPFONT *pPFont; /*!< Specifies the proportional font used for the text */
   uint32_t  LcdLayer;
   uint32_t  LcdDevice;
   uint32_t  LcdXsize;
   uint32_t  LcdYsize;
   uint32_t  LcdPixelFormat;
+  UTIL_LCD_ClipRect_t Clip;                                 /*!< Pixels drawn by the primitives */
+  UTIL_LCD_ClipRect_t ClipStack[UTIL_LCD_CLIP_STACK_DEPTH]; /*!< Clipping rectangles saved by UTIL_LCD_PushClipRect() */
+  uint32_t  ClipDepth;
 } UTIL_LCD_Ctx_t;
 
 /**
@@ -153,6 +193,26 @@ typedef enum
   LEFT_MODE               = 0x03     /*!< Left mode   */
 } Text_AlignModeTypdef;
 
+/**
+  * @brief  LCD Utility hardware scrolling functions used by the text console,
+  *         BSP_LCD_SetScrollArea() and BSP_LCD_SetScrollStart() signatures
+  */
+typedef struct
+{
+  int32_t ( *SetScrollArea   ) (uint32_t, uint32_t, uint32_t);
+  int32_t ( *SetScrollStart  ) (uint32_t, uint32_t);
+} UTIL_LCD_ScrollDrv_t;
+
+/**
+  * @brief  LCD Utility glyph cache statistics
+  */
+typedef struct
+{
+  uint32_t Hits;      /*!< Characters found expanded in the cache  */
+  uint32_t Misses;    /*!< Characters expanded in the cache        */
+  uint32_t Evictions; /*!< Glyphs evicted to make room             */
+} UTIL_LCD_GlyphCacheStats_t;
+
 /**
   * @}
   */
@@ -172,6 +232,11 @@ uint32_t UTIL_LCD_GetBackColor(void);
 void     UTIL_LCD_SetFont(sFONT *fonts);
 sFONT    *UTIL_LCD_GetFont(void);
 
+int32_t  UTIL_LCD_PushClipRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+void     UTIL_LCD_PopClipRect(void);
+void     UTIL_LCD_ResetClipRect(void);
+void     UTIL_LCD_GetClipRect(UTIL_LCD_ClipRect_t *pClip);
+
 void     UTIL_LCD_Clear(uint32_t Color);
 void     UTIL_LCD_ClearStringLine(uint32_t Line);
 void     UTIL_LCD_DisplayStringAtLine(uint32_t Line, uint8_t *ptr);
@@ -191,7 +256,27 @@ void     UTIL_LCD_DrawPolygon(pPoint Points, uint32_t PointCount, uint32_t Color
 void     UTIL_LCD_DrawEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color);
 void     UTIL_LCD_FillCircle(uint32_t Xpos, uint32_t Ypos, uint32_t Radius, uint32_t Color);
 void     UTIL_LCD_FillPolygon(pPoint Points, uint32_t PointCount, uint32_t Color);
+void     UTIL_LCD_FillPolygonEx(pPoint Points, uint32_t PointCount, uint32_t FillRule, uint32_t Color);
 void     UTIL_LCD_FillEllipse(int Xpos, int Ypos, int XRadius, int YRadius, uint32_t Color);
+void     UTIL_LCD_FillLinearGradient(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                                     uint32_t Color1, uint32_t Color2, uint32_t Direction);
+void     UTIL_LCD_FillRadialGradient(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                                     int32_t Xcenter, int32_t Ycenter, uint32_t Radius, uint32_t Color1, uint32_t Color2);
+void     UTIL_LCD_FillPattern(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height,
+                              const uint8_t *pPattern, uint32_t Color1, uint32_t Color2);
+
+void     UTIL_LCD_SetPFont(const sPFONT *pFont);
+const sPFONT *UTIL_LCD_GetPFont(void);
+uint32_t UTIL_LCD_GetPStringWidth(const uint8_t *Text);
+void     UTIL_LCD_DisplayPStringAt(uint32_t Xpos, uint32_t Ypos, uint8_t *Text, Text_AlignModeTypdef Mode);
+
+void     UTIL_LCD_ConsoleInit(uint32_t Ypos, uint32_t Height, const UTIL_LCD_ScrollDrv_t *pScroll);
+void     UTIL_LCD_ConsoleDeInit(void);
+void     UTIL_LCD_ConsoleClear(void);
+void     UTIL_LCD_ConsoleWriteLine(uint8_t *Text);
+
+void     UTIL_LCD_ResetGlyphCache(void);
+void     UTIL_LCD_GetGlyphCacheStats(UTIL_LCD_GlyphCacheStats_t *pStats);
 
 /**
   * @}
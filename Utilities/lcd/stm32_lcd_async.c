@@ -0,0 +1,868 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_async.c
+  * @author  MCD Application Team
+  * @brief   This file includes an asynchronous transfer queue sending
+  *          rectangles and bitmaps to the LCD with a DMA engine.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver queues RGB565 rectangle, solid fill and bitmap jobs and sends
+     them to the LCD with a transfer engine (typically a memory-to-memory DMA
+     writing the LCD data address) while the CPU keeps running.
+
+   - Jobs are sent one after the other, in submission order: a job starts
+     only once the previous one is completed, so overlapping jobs are drawn
+     in the order they were queued. Each job is split in transfers of at most
+     UTIL_LCD_ASYNC_MAX_TRANSFER pixels, one transfer per row when the rows
+     are not contiguous in memory.
+
+   - Call UTIL_LCD_ASYNC_Init() with the engine, e.g. built on
+     BSP_LCD_DMA_SetWindow() and BSP_LCD_DMA_Transfer(), and call
+     UTIL_LCD_ASYNC_TransferCplt() / UTIL_LCD_ASYNC_TransferError() from the
+     engine completion interrupt.
+
+   - Each submission returns a fence. The source buffer of a job must not be
+     modified before its fence is reached, see UTIL_LCD_ASYNC_IsComplete(),
+     UTIL_LCD_ASYNC_Wait() and UTIL_LCD_ASYNC_WaitAll(), or before its
+     completion callback is called. Submissions return UTIL_LCD_ASYNC_BUSY
+     when the queue is full.
+
+   - UTIL_LCD_ASYNC_SimEngine is a simulated engine writing into a RAM image.
+     Transfers complete one by one on UTIL_LCD_ASYNC_SimStep() calls, or while
+     waiting for a fence, so that ordering can be checked on a host. A
+     transfer can be made to fail like a DMA transfer error, to check the
+     error paths:
+         UTIL_LCD_ASYNC_SimInit()
+         UTIL_LCD_ASYNC_SimStep()
+         UTIL_LCD_ASYNC_SimInjectError()
+         UTIL_LCD_ASYNC_SimGetStats()
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_async.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_ASYNC STM32 LCD Asynchronous Transfer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Private_Types STM32 LCD Asynchronous Transfer Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t                   Xpos;
+  uint32_t                   Ypos;
+  uint32_t                   Width;
+  uint32_t                   Height;
+  uint8_t                   *pData;      /* First row sent, NULL for a solid fill       */
+  int32_t                    Pitch;      /* Bytes from a sent row to the next one       */
+  uint32_t                   RowLength;  /* Pixels per sent row                         */
+  uint32_t                   RowCount;   /* Number of sent rows                         */
+  uint16_t                   Color;      /* Solid fill color, DMA source of fill jobs   */
+  UTIL_LCD_ASYNC_Callback_t  pCallback;
+  void                      *pContext;
+  uint32_t                   Fence;
+} ASYNC_Job_t;
+
+typedef struct
+{
+  const UTIL_LCD_ASYNC_Engine_t *pEngine;
+  uint32_t                       Instance;
+  ASYNC_Job_t                    Queue[UTIL_LCD_ASYNC_QUEUE_SIZE];
+  volatile uint32_t              Head;       /* Running job, incremented on completion  */
+  volatile uint32_t              Tail;       /* Incremented on submission               */
+  volatile uint32_t              Busy;       /* A job is running on the engine          */
+  uint32_t                       Row;        /* Rows of the running job already sent    */
+  uint32_t                       Offset;     /* Pixels of the current row already sent  */
+  uint32_t                       Length;     /* Pixels of the transfer in progress      */
+  uint32_t                       Submitted;  /* Fence of the last submitted job         */
+  volatile uint32_t              Completed;  /* Fence of the last completed job         */
+  volatile uint32_t              Error;      /* A job failed since the last wait        */
+  UTIL_LCD_ASYNC_Stats_t         Stats;
+} ASYNC_Ctx_t;
+
+typedef struct
+{
+  uint16_t               *pImage;
+  uint32_t                Width;
+  uint32_t                Height;
+  uint32_t                WinXpos;
+  uint32_t                WinYpos;
+  uint32_t                WinWidth;
+  uint32_t                WinHeight;
+  uint32_t                Cursor;
+  uint8_t                *pData;
+  uint32_t                Length;
+  uint32_t                Increment;
+  uint32_t                Pending;
+  uint32_t                ErrorIn;    /* Transfers to start before the failing one */
+  uint32_t                Fail;       /* Transfer in progress ends with an error   */
+  UTIL_LCD_ASYNC_Stats_t  Stats;
+} ASYNC_SimCtx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Private_FunctionPrototypes STM32 LCD Asynchronous Transfer Utility Private FunctionPrototypes
+  * @{
+  */
+static int32_t ASYNC_Submit(const ASYNC_Job_t *pJob, uint32_t *pFence);
+static void    ASYNC_StartJob(void);
+static int32_t ASYNC_StartTransfer(void);
+static void    ASYNC_EndJob(int32_t Status);
+static int32_t ASYNC_SimSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static int32_t ASYNC_SimStartTransfer(uint32_t Instance, uint8_t *pData, uint32_t Length, uint32_t Increment);
+static void    ASYNC_SimIdle(uint32_t Instance);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Private_Variables STM32 LCD Asynchronous Transfer Utility Private Variables
+  * @{
+  */
+static ASYNC_Ctx_t    AsyncCtx;
+static ASYNC_SimCtx_t AsyncSimCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Exported_Variables STM32 LCD Asynchronous Transfer Utility Exported Variables
+  * @{
+  */
+const UTIL_LCD_ASYNC_Engine_t UTIL_LCD_ASYNC_SimEngine =
+{
+  ASYNC_SimSetWindow,
+  ASYNC_SimStartTransfer,
+  NULL,
+  NULL,
+  ASYNC_SimIdle
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Exported_Functions STM32 LCD Asynchronous Transfer Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the transfer queue.
+  * @param  Instance LCD Instance passed to the engine
+  * @param  pEngine  Transfer engine
+  * @retval UTIL_LCD_ASYNC status
+  */
+int32_t UTIL_LCD_ASYNC_Init(uint32_t Instance, const UTIL_LCD_ASYNC_Engine_t *pEngine)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  if ((pEngine == NULL) || (pEngine->SetWindow == NULL) || (pEngine->StartTransfer == NULL))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else if (AsyncCtx.Busy != 0U)
+  {
+    ret = UTIL_LCD_ASYNC_BUSY;
+  }
+  else
+  {
+    AsyncCtx.pEngine   = pEngine;
+    AsyncCtx.Instance  = Instance;
+    AsyncCtx.Head      = 0U;
+    AsyncCtx.Tail      = 0U;
+    AsyncCtx.Submitted = 0U;
+    AsyncCtx.Completed = 0U;
+    AsyncCtx.Error     = 0U;
+    UTIL_LCD_ASYNC_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Queue the copy of a RGB565 buffer in a rectangle of the LCD.
+  * @param  Xpos      X position
+  * @param  Ypos      Y position
+  * @param  pData     Pointer on RGB565 pixels buffer, kept until completion
+  * @param  Width     Width of the rectangle
+  * @param  Height    Height of the rectangle
+  * @param  pCallback Completion callback, may be NULL
+  * @param  pContext  Parameter passed to the completion callback
+  * @param  pFence    Fence of the job, may be NULL
+  * @retval UTIL_LCD_ASYNC status
+  */
+int32_t UTIL_LCD_ASYNC_FillRGBRect(uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height,
+                                   UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence)
+{
+  int32_t     ret;
+  ASYNC_Job_t job;
+
+  if ((pData == NULL) || (Width == 0U) || (Height == 0U))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    job.Xpos      = Xpos;
+    job.Ypos      = Ypos;
+    job.Width     = Width;
+    job.Height    = Height;
+    job.pData     = pData;
+    job.Pitch     = 0;
+    job.RowLength = Width * Height;
+    job.RowCount  = 1U;
+    job.Color     = 0U;
+    job.pCallback = pCallback;
+    job.pContext  = pContext;
+    ret = ASYNC_Submit(&job, pFence);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Queue the fill of a rectangle of the LCD with a RGB565 color.
+  * @param  Xpos      X position
+  * @param  Ypos      Y position
+  * @param  Width     Width of the rectangle
+  * @param  Height    Height of the rectangle
+  * @param  Color     RGB565 color
+  * @param  pCallback Completion callback, may be NULL
+  * @param  pContext  Parameter passed to the completion callback
+  * @param  pFence    Fence of the job, may be NULL
+  * @retval UTIL_LCD_ASYNC status
+  */
+int32_t UTIL_LCD_ASYNC_FillRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color,
+                                UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence)
+{
+  int32_t     ret;
+  ASYNC_Job_t job;
+
+  if ((Width == 0U) || (Height == 0U))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    job.Xpos      = Xpos;
+    job.Ypos      = Ypos;
+    job.Width     = Width;
+    job.Height    = Height;
+    job.pData     = NULL;
+    job.Pitch     = 0;
+    job.RowLength = Width * Height;
+    job.RowCount  = 1U;
+    job.Color     = (uint16_t)Color;
+    job.pCallback = pCallback;
+    job.pContext  = pContext;
+    ret = ASYNC_Submit(&job, pFence);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Queue the display of a 16bpp bitmap picture.
+  *         Bottom-up or padded bitmaps are sent one row per transfer.
+  * @param  Xpos      Bmp X position in the LCD
+  * @param  Ypos      Bmp Y position in the LCD
+  * @param  pBmp      Pointer to Bmp picture address, kept until completion
+  * @param  pCallback Completion callback, may be NULL
+  * @param  pContext  Parameter passed to the completion callback
+  * @param  pFence    Fence of the job, may be NULL
+  * @retval UTIL_LCD_ASYNC status
+  */
+int32_t UTIL_LCD_ASYNC_DrawBitmap(uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp,
+                                  UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence)
+{
+  int32_t     ret;
+  uint32_t    index, width, height, stride, bpp;
+  uint32_t    top_down = 0U;
+  ASYNC_Job_t job;
+
+  /* Get bitmap data address offset */
+  index  = ((uint32_t)pBmp[13] << 24) | ((uint32_t)pBmp[12] << 16) | ((uint32_t)pBmp[11] << 8) | (uint32_t)pBmp[10];
+  /* Get image width */
+  width  = ((uint32_t)pBmp[21] << 24) | ((uint32_t)pBmp[20] << 16) | ((uint32_t)pBmp[19] << 8) | (uint32_t)pBmp[18];
+  /* Get image height, negative for top-down bitmaps */
+  height = ((uint32_t)pBmp[25] << 24) | ((uint32_t)pBmp[24] << 16) | ((uint32_t)pBmp[23] << 8) | (uint32_t)pBmp[22];
+  /* Get bits per pixel */
+  bpp    = ((uint32_t)pBmp[29] << 8) | (uint32_t)pBmp[28];
+
+  if ((height & 0x80000000U) != 0U)
+  {
+    height   = (uint32_t)(-(int32_t)height);
+    top_down = 1U;
+  }
+  /* BMP rows are padded to 32-bit */
+  stride = ((width * 2U) + 3U) & ~3U;
+
+  if ((bpp != 16U) || (width == 0U) || (height == 0U))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    job.Xpos      = Xpos;
+    job.Ypos      = Ypos;
+    job.Width     = width;
+    job.Height    = height;
+    job.Color     = 0U;
+    job.pCallback = pCallback;
+    job.pContext  = pContext;
+    if ((top_down != 0U) && (stride == (width * 2U)))
+    {
+      /* Rows are contiguous in display order */
+      job.pData     = &pBmp[index];
+      job.Pitch     = 0;
+      job.RowLength = width * height;
+      job.RowCount  = 1U;
+    }
+    else if (top_down != 0U)
+    {
+      job.pData     = &pBmp[index];
+      job.Pitch     = (int32_t)stride;
+      job.RowLength = width;
+      job.RowCount  = height;
+    }
+    else
+    {
+      /* Top display row is the last row of the file */
+      job.pData     = &pBmp[index + ((height - 1U) * stride)];
+      job.Pitch     = -(int32_t)stride;
+      job.RowLength = width;
+      job.RowCount  = height;
+    }
+    ret = ASYNC_Submit(&job, pFence);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Check whether a job is completed.
+  * @param  Fence Fence of the job
+  * @retval 1 if the job and all the jobs queued before it are completed
+  */
+uint32_t UTIL_LCD_ASYNC_IsComplete(uint32_t Fence)
+{
+  return ((int32_t)(AsyncCtx.Completed - Fence) >= 0) ? 1U : 0U;
+}
+
+/**
+  * @brief  Wait until a job is completed, calling the engine Idle hook.
+  * @param  Fence Fence of the job
+  * @retval UTIL_LCD_ASYNC_ERROR if a job failed since the previous wait
+  */
+int32_t UTIL_LCD_ASYNC_Wait(uint32_t Fence)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  if ((AsyncCtx.pEngine == NULL) || ((int32_t)(Fence - AsyncCtx.Submitted) > 0))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    while (UTIL_LCD_ASYNC_IsComplete(Fence) == 0U)
+    {
+      if (AsyncCtx.pEngine->Idle != NULL)
+      {
+        AsyncCtx.pEngine->Idle(AsyncCtx.Instance);
+      }
+    }
+
+    if (AsyncCtx.Error != 0U)
+    {
+      AsyncCtx.Error = 0U;
+      ret = UTIL_LCD_ASYNC_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Wait until all the queued jobs are completed.
+  * @retval UTIL_LCD_ASYNC_ERROR if a job failed since the previous wait
+  */
+int32_t UTIL_LCD_ASYNC_WaitAll(void)
+{
+  return UTIL_LCD_ASYNC_Wait(AsyncCtx.Submitted);
+}
+
+/**
+  * @brief  Transfer completion, to be called by the engine.
+  *         Starts the next transfer of the running job or the next job.
+  */
+void UTIL_LCD_ASYNC_TransferCplt(void)
+{
+  const ASYNC_Job_t *job;
+
+  if (AsyncCtx.Busy != 0U)
+  {
+    job = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_LCD_ASYNC_QUEUE_SIZE];
+
+    AsyncCtx.Offset += AsyncCtx.Length;
+    if (AsyncCtx.Offset >= job->RowLength)
+    {
+      AsyncCtx.Offset = 0U;
+      AsyncCtx.Row++;
+    }
+
+    if (AsyncCtx.Row < job->RowCount)
+    {
+      if (ASYNC_StartTransfer() != UTIL_LCD_ASYNC_OK)
+      {
+        ASYNC_EndJob(UTIL_LCD_ASYNC_ERROR);
+        ASYNC_StartJob();
+      }
+    }
+    else
+    {
+      ASYNC_EndJob(UTIL_LCD_ASYNC_OK);
+      ASYNC_StartJob();
+    }
+  }
+}
+
+/**
+  * @brief  Transfer error, to be called by the engine.
+  *         The running job is completed with an error and the next job starts.
+  */
+void UTIL_LCD_ASYNC_TransferError(void)
+{
+  if (AsyncCtx.Busy != 0U)
+  {
+    ASYNC_EndJob(UTIL_LCD_ASYNC_ERROR);
+    ASYNC_StartJob();
+  }
+}
+
+/**
+  * @brief  Get the transfer statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_LCD_ASYNC_GetStats(UTIL_LCD_ASYNC_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = AsyncCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the transfer statistics.
+  */
+void UTIL_LCD_ASYNC_ResetStats(void)
+{
+  AsyncCtx.Stats.JobCount      = 0U;
+  AsyncCtx.Stats.TransferCount = 0U;
+  AsyncCtx.Stats.PixelCount    = 0U;
+  AsyncCtx.Stats.ErrorCount    = 0U;
+}
+
+/**
+  * @brief  Initialize the simulated engine.
+  * @param  pImage RGB565 image of Width x Height pixels written by the engine
+  * @param  Width  Image width
+  * @param  Height Image height
+  * @retval UTIL_LCD_ASYNC status
+  */
+int32_t UTIL_LCD_ASYNC_SimInit(uint16_t *pImage, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  if ((pImage == NULL) || (Width == 0U) || (Height == 0U))
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    AsyncSimCtx.pImage              = pImage;
+    AsyncSimCtx.Width               = Width;
+    AsyncSimCtx.Height              = Height;
+    AsyncSimCtx.WinXpos             = 0U;
+    AsyncSimCtx.WinYpos             = 0U;
+    AsyncSimCtx.WinWidth            = Width;
+    AsyncSimCtx.WinHeight           = Height;
+    AsyncSimCtx.Cursor              = 0U;
+    AsyncSimCtx.Pending             = 0U;
+    AsyncSimCtx.ErrorIn             = 0U;
+    AsyncSimCtx.Fail                = 0U;
+    AsyncSimCtx.Stats.JobCount      = 0U;
+    AsyncSimCtx.Stats.TransferCount = 0U;
+    AsyncSimCtx.Stats.PixelCount    = 0U;
+    AsyncSimCtx.Stats.ErrorCount    = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Complete the transfer in progress on the simulated engine.
+  *         The pixels are read from the source buffer at completion time.
+  *         A failing transfer writes no pixel and reports a transfer error.
+  * @retval 1 if a transfer was completed, 0 if the engine was idle
+  */
+uint32_t UTIL_LCD_ASYNC_SimStep(void)
+{
+  uint32_t  i, pos;
+  uint32_t  done = 0U;
+  uint8_t  *src;
+
+  if ((AsyncSimCtx.Pending != 0U) && (AsyncSimCtx.Fail != 0U))
+  {
+    AsyncSimCtx.Pending = 0U;
+    AsyncSimCtx.Fail    = 0U;
+    AsyncSimCtx.Stats.ErrorCount++;
+    done = 1U;
+
+    UTIL_LCD_ASYNC_TransferError();
+  }
+  else if (AsyncSimCtx.Pending != 0U)
+  {
+    src = AsyncSimCtx.pData;
+    for (i = 0U; i < AsyncSimCtx.Length; i++)
+    {
+      pos = ((AsyncSimCtx.WinYpos + (AsyncSimCtx.Cursor / AsyncSimCtx.WinWidth)) * AsyncSimCtx.Width) +
+            AsyncSimCtx.WinXpos + (AsyncSimCtx.Cursor % AsyncSimCtx.WinWidth);
+      AsyncSimCtx.pImage[pos] = (uint16_t)((uint32_t)src[0] | ((uint32_t)src[1] << 8));
+      if (AsyncSimCtx.Increment != 0U)
+      {
+        src = &src[2];
+      }
+      /* Memory write wraps at the end of the window */
+      AsyncSimCtx.Cursor = (AsyncSimCtx.Cursor + 1U) % (AsyncSimCtx.WinWidth * AsyncSimCtx.WinHeight);
+    }
+    AsyncSimCtx.Pending = 0U;
+    done = 1U;
+
+    UTIL_LCD_ASYNC_TransferCplt();
+  }
+
+  return done;
+}
+
+/**
+  * @brief  Make a transfer of the simulated engine fail.
+  * @param  Transfer Rank of the failing transfer among the transfers started
+  *                  after this call, 1 for the next one, 0 to cancel
+  */
+void UTIL_LCD_ASYNC_SimInjectError(uint32_t Transfer)
+{
+  AsyncSimCtx.ErrorIn = Transfer;
+}
+
+/**
+  * @brief  Get the commands received by the simulated engine.
+  * @param  pStats JobCount counts SetWindow calls, ErrorCount the rejected
+  *         commands and the failed transfers
+  */
+void UTIL_LCD_ASYNC_SimGetStats(UTIL_LCD_ASYNC_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = AsyncSimCtx.Stats;
+  }
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Private_Functions STM32 LCD Asynchronous Transfer Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Add a job to the queue and start it if the engine is idle.
+  * @param  pJob   Job to copy in the queue
+  * @param  pFence Fence of the job, may be NULL
+  * @retval UTIL_LCD_ASYNC status
+  */
+static int32_t ASYNC_Submit(const ASYNC_Job_t *pJob, uint32_t *pFence)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  if (AsyncCtx.pEngine == NULL)
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    if (AsyncCtx.pEngine->Lock != NULL)
+    {
+      AsyncCtx.pEngine->Lock(AsyncCtx.Instance);
+    }
+
+    if ((AsyncCtx.Tail - AsyncCtx.Head) >= UTIL_LCD_ASYNC_QUEUE_SIZE)
+    {
+      ret = UTIL_LCD_ASYNC_BUSY;
+    }
+    else
+    {
+      AsyncCtx.Submitted++;
+      AsyncCtx.Queue[AsyncCtx.Tail % UTIL_LCD_ASYNC_QUEUE_SIZE]       = *pJob;
+      AsyncCtx.Queue[AsyncCtx.Tail % UTIL_LCD_ASYNC_QUEUE_SIZE].Fence = AsyncCtx.Submitted;
+      if (pFence != NULL)
+      {
+        *pFence = AsyncCtx.Submitted;
+      }
+      /* Publish the job before checking the engine state: a completion
+         interrupt in between sees it and starts it */
+      AsyncCtx.Tail++;
+
+      if (AsyncCtx.Busy == 0U)
+      {
+        ASYNC_StartJob();
+      }
+    }
+
+    if (AsyncCtx.pEngine->Unlock != NULL)
+    {
+      AsyncCtx.pEngine->Unlock(AsyncCtx.Instance);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start the oldest queued job, jobs failing to start are completed
+  *         with an error.
+  */
+static void ASYNC_StartJob(void)
+{
+  const ASYNC_Job_t *job;
+  uint32_t           started = 0U;
+
+  while ((started == 0U) && (AsyncCtx.Head != AsyncCtx.Tail))
+  {
+    job = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_LCD_ASYNC_QUEUE_SIZE];
+
+    /* Set busy first, the transfer may complete before StartTransfer returns */
+    AsyncCtx.Busy   = 1U;
+    AsyncCtx.Row    = 0U;
+    AsyncCtx.Offset = 0U;
+    if (AsyncCtx.pEngine->SetWindow(AsyncCtx.Instance, job->Xpos, job->Ypos, job->Width, job->Height) != 0)
+    {
+      ASYNC_EndJob(UTIL_LCD_ASYNC_ERROR);
+    }
+    else if (ASYNC_StartTransfer() != UTIL_LCD_ASYNC_OK)
+    {
+      ASYNC_EndJob(UTIL_LCD_ASYNC_ERROR);
+    }
+    else
+    {
+      started = 1U;
+    }
+  }
+
+  if (started == 0U)
+  {
+    AsyncCtx.Busy = 0U;
+  }
+}
+
+/**
+  * @brief  Start the next transfer of the running job.
+  * @retval UTIL_LCD_ASYNC status
+  */
+static int32_t ASYNC_StartTransfer(void)
+{
+  int32_t            ret = UTIL_LCD_ASYNC_OK;
+  const ASYNC_Job_t *job;
+  uint8_t           *src;
+  uint32_t           length;
+
+  job    = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_LCD_ASYNC_QUEUE_SIZE];
+  length = job->RowLength - AsyncCtx.Offset;
+  if (length > UTIL_LCD_ASYNC_MAX_TRANSFER)
+  {
+    length = UTIL_LCD_ASYNC_MAX_TRANSFER;
+  }
+
+  if (job->pData != NULL)
+  {
+    src = &job->pData[((int32_t)AsyncCtx.Row * job->Pitch) + (int32_t)(2U * AsyncCtx.Offset)];
+  }
+  else
+  {
+    src = (uint8_t *)&job->Color;
+  }
+
+  AsyncCtx.Length = length;
+  AsyncCtx.Stats.TransferCount++;
+  AsyncCtx.Stats.PixelCount += length;
+  if (AsyncCtx.pEngine->StartTransfer(AsyncCtx.Instance, src, length, (job->pData != NULL) ? 1U : 0U) != 0)
+  {
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Complete the running job and call its callback.
+  * @param  Status Job status
+  */
+static void ASYNC_EndJob(int32_t Status)
+{
+  const ASYNC_Job_t        *job;
+  UTIL_LCD_ASYNC_Callback_t callback;
+  void                     *context;
+  uint32_t                  fence;
+
+  job      = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_LCD_ASYNC_QUEUE_SIZE];
+  callback = job->pCallback;
+  context  = job->pContext;
+  fence    = job->Fence;
+
+  if (Status != UTIL_LCD_ASYNC_OK)
+  {
+    AsyncCtx.Error = 1U;
+    AsyncCtx.Stats.ErrorCount++;
+  }
+  AsyncCtx.Stats.JobCount++;
+
+  /* Release the slot before the callback so that it can queue a new job */
+  AsyncCtx.Completed = fence;
+  AsyncCtx.Head++;
+
+  if (callback != NULL)
+  {
+    callback(fence, Status, context);
+  }
+}
+
+/**
+  * @brief  Open a window in the image of the simulated engine.
+  * @param  Instance Unused
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Window width
+  * @param  Height   Window height
+  * @retval UTIL_LCD_ASYNC status
+  */
+static int32_t ASYNC_SimSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  (void)Instance;
+
+  if ((AsyncSimCtx.pImage == NULL) || (AsyncSimCtx.Pending != 0U) || (Width == 0U) || (Height == 0U) ||
+      (Xpos >= AsyncSimCtx.Width) || (Width > (AsyncSimCtx.Width - Xpos)) ||
+      (Ypos >= AsyncSimCtx.Height) || (Height > (AsyncSimCtx.Height - Ypos)))
+  {
+    AsyncSimCtx.Stats.ErrorCount++;
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    AsyncSimCtx.WinXpos   = Xpos;
+    AsyncSimCtx.WinYpos   = Ypos;
+    AsyncSimCtx.WinWidth  = Width;
+    AsyncSimCtx.WinHeight = Height;
+    AsyncSimCtx.Cursor    = 0U;
+    AsyncSimCtx.Stats.JobCount++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start a transfer on the simulated engine.
+  *         It completes on the next UTIL_LCD_ASYNC_SimStep() call.
+  * @param  Instance  Unused
+  * @param  pData     Pointer on RGB565 pixels
+  * @param  Length    Number of pixels
+  * @param  Increment 0 to repeat the first pixel
+  * @retval UTIL_LCD_ASYNC status
+  */
+static int32_t ASYNC_SimStartTransfer(uint32_t Instance, uint8_t *pData, uint32_t Length, uint32_t Increment)
+{
+  int32_t ret = UTIL_LCD_ASYNC_OK;
+
+  (void)Instance;
+
+  /* A transfer started before the previous one completed is a queue bug */
+  if ((AsyncSimCtx.pImage == NULL) || (AsyncSimCtx.Pending != 0U) || (pData == NULL) ||
+      (Length == 0U) || (Length > UTIL_LCD_ASYNC_MAX_TRANSFER))
+  {
+    AsyncSimCtx.Stats.ErrorCount++;
+    ret = UTIL_LCD_ASYNC_ERROR;
+  }
+  else
+  {
+    AsyncSimCtx.pData     = pData;
+    AsyncSimCtx.Length    = Length;
+    AsyncSimCtx.Increment = Increment;
+    AsyncSimCtx.Pending   = 1U;
+    if (AsyncSimCtx.ErrorIn != 0U)
+    {
+      AsyncSimCtx.ErrorIn--;
+      AsyncSimCtx.Fail = (AsyncSimCtx.ErrorIn == 0U) ? 1U : 0U;
+    }
+    AsyncSimCtx.Stats.TransferCount++;
+    AsyncSimCtx.Stats.PixelCount += Length;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Simulated engine idle hook: let the transfer in progress complete.
+  * @param  Instance Unused
+  */
+static void ASYNC_SimIdle(uint32_t Instance)
+{
+  (void)Instance;
+
+  (void)UTIL_LCD_ASYNC_SimStep();
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_async.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_async.c asynchronous LCD transfer queue.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_ASYNC_H
+#define STM32_LCD_ASYNC_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_ASYNC STM32 LCD Asynchronous Transfer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Exported_Constants STM32 LCD Asynchronous Transfer Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_ASYNC_OK                0
+#define UTIL_LCD_ASYNC_ERROR           (-1)
+#define UTIL_LCD_ASYNC_BUSY            (-2)
+
+/**
+  * @brief  Number of jobs the transfer queue can hold
+  */
+#ifndef UTIL_LCD_ASYNC_QUEUE_SIZE
+  #define UTIL_LCD_ASYNC_QUEUE_SIZE      8U
+#endif
+
+/**
+  * @brief  Maximum number of pixels of one transfer, bounded by the DMA
+  *         16-bit data counter
+  */
+#ifndef UTIL_LCD_ASYNC_MAX_TRANSFER
+  #define UTIL_LCD_ASYNC_MAX_TRANSFER    65535U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Exported_Types STM32 LCD Asynchronous Transfer Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Job completion callback, called from the transfer completion context
+  *         with UTIL_LCD_ASYNC_OK or UTIL_LCD_ASYNC_ERROR.
+  */
+typedef void (*UTIL_LCD_ASYNC_Callback_t)(uint32_t Fence, int32_t Status, void *pContext);
+
+/**
+  * @brief  Transfer engine.
+  *         SetWindow opens a display window and starts a memory write in it.
+  *         StartTransfer starts sending Length RGB565 pixels to the display and
+  *         returns immediately. When Increment is 0 the first pixel is repeated.
+  *         The engine reports the end of the transfer by calling
+  *         UTIL_LCD_ASYNC_TransferCplt() or UTIL_LCD_ASYNC_TransferError().
+  *         Lock/Unlock mask the completion interrupt, they are only needed when
+  *         several threads submit jobs. Idle is called while waiting for a
+  *         fence. Lock, Unlock and Idle may be NULL.
+  */
+typedef struct
+{
+  int32_t ( *SetWindow       ) (uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+  int32_t ( *StartTransfer   ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  void    ( *Lock            ) (uint32_t);
+  void    ( *Unlock          ) (uint32_t);
+  void    ( *Idle            ) (uint32_t);
+} UTIL_LCD_ASYNC_Engine_t;
+
+/**
+  * @brief  Transfer statistics
+  */
+typedef struct
+{
+  uint32_t JobCount;      /*!< Number of jobs completed                 */
+  uint32_t TransferCount; /*!< Number of transfers started              */
+  uint32_t PixelCount;    /*!< Number of pixels sent                    */
+  uint32_t ErrorCount;    /*!< Number of jobs completed with an error   */
+} UTIL_LCD_ASYNC_Stats_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_ASYNC_Exported_Variables STM32 LCD Asynchronous Transfer Utility Exported Variables
+  * @{
+  */
+extern const UTIL_LCD_ASYNC_Engine_t UTIL_LCD_ASYNC_SimEngine;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_ASYNC_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_LCD_ASYNC_Init(uint32_t Instance, const UTIL_LCD_ASYNC_Engine_t *pEngine);
+int32_t  UTIL_LCD_ASYNC_FillRGBRect(uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height,
+                                    UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence);
+int32_t  UTIL_LCD_ASYNC_FillRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color,
+                                 UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence);
+int32_t  UTIL_LCD_ASYNC_DrawBitmap(uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp,
+                                   UTIL_LCD_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence);
+uint32_t UTIL_LCD_ASYNC_IsComplete(uint32_t Fence);
+int32_t  UTIL_LCD_ASYNC_Wait(uint32_t Fence);
+int32_t  UTIL_LCD_ASYNC_WaitAll(void);
+void     UTIL_LCD_ASYNC_TransferCplt(void);
+void     UTIL_LCD_ASYNC_TransferError(void);
+void     UTIL_LCD_ASYNC_GetStats(UTIL_LCD_ASYNC_Stats_t *pStats);
+void     UTIL_LCD_ASYNC_ResetStats(void);
+
+/* Simulated transfer engine */
+int32_t  UTIL_LCD_ASYNC_SimInit(uint16_t *pImage, uint32_t Width, uint32_t Height);
+uint32_t UTIL_LCD_ASYNC_SimStep(void);
+void     UTIL_LCD_ASYNC_SimInjectError(uint32_t Transfer);
+void     UTIL_LCD_ASYNC_SimGetStats(UTIL_LCD_ASYNC_Stats_t *pStats);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_ASYNC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,600 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_bench.c
+  * @author  MCD Application Team
+  * @brief   This file includes a micro-benchmark of the STM32 LCD utility
+  *          primitives, with a bus cost model.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - UTIL_LCD_BENCH_Run() drives every UTIL_LCD_* drawing primitive through
+     the driver under test, for each orientation:
+       o shapes (rectangles, lines, circles, ellipses, polygons) and bitmaps
+         for sizes of 8, 32, 96 and 200 pixels (bitmaps up to
+         UTIL_LCD_BENCH_BITMAP_MAX),
+       o characters and strings for Font8 to Font24,
+       o clear, single pixel write and read.
+     Driver calls are counted by the benchmark; bus words are read from the
+     GetBus service and CPU time from the GetTime service when provided.
+
+   - Results are sent to the Output service as CSV lines, after a header:
+         orientation,primitive,size,font,iterations,calls,commands,
+         data_writes,data_reads,bytes,cpu_us,bus_us
+     Values are averaged over Iterations runs. bus_us estimates the on-target
+     bus time from the bus words, the bus clock and the cycles per write and
+     read access.
+
+   - On a host, the ST7789H2 driver on the ST7789H2_SIM bus provides every
+     counter: pDrv wraps the ST7789H2_Driver functions, SetOrientation calls
+     ST7789H2_SetOrientation(), GetBus copies the Commands, DataWrites and
+     DataReads fields of ST7789H2_SIM_GetStats() and GetTime reads the
+     process CPU time. On target, BSP_LCD_Driver can be used with GetTime
+     built on the DWT cycle counter.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_BENCH STM32 LCD Benchmark Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Private_Defines STM32 LCD Benchmark Utility Private Defines
+  * @{
+  */
+/* Test kinds */
+#define BENCH_KIND_SHAPE     0U  /* Run for each size                        */
+#define BENCH_KIND_BITMAP    1U  /* Run for each size up to BITMAP_MAX        */
+#define BENCH_KIND_TEXT      2U  /* Run for each font                         */
+#define BENCH_KIND_SINGLE    3U  /* Run once                                  */
+
+#define BENCH_TEXT           "UTIL_LCD benchmark 0123"
+#define BENCH_COLOR          0xFF2060C0U
+
+/* BMP file header and RGB565 pixels of the largest bitmap */
+#define BENCH_BMP_HEADER     54U
+#define BENCH_BMP_SIZE       (BENCH_BMP_HEADER + (2U * UTIL_LCD_BENCH_BITMAP_MAX * UTIL_LCD_BENCH_BITMAP_MAX))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Private_Types STM32 LCD Benchmark Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  const char *pName;
+  uint32_t    Kind;
+  void      ( *Run ) (uint32_t Size);
+} BENCH_Test_t;
+
+typedef struct
+{
+  const UTIL_LCD_BENCH_Init_t *pInit;
+  uint32_t                     Calls;   /* Driver calls */
+  uint32_t                     XSize;
+  uint32_t                     YSize;
+} BENCH_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Private_FunctionPrototypes STM32 LCD Benchmark Utility Private FunctionPrototypes
+  * @{
+  */
+static int32_t  BENCH_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
+static int32_t  BENCH_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
+static int32_t  BENCH_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+static int32_t  BENCH_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+static int32_t  BENCH_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+static int32_t  BENCH_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
+static int32_t  BENCH_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
+static int32_t  BENCH_GetXSize(uint32_t Instance, uint32_t *XSize);
+static int32_t  BENCH_GetYSize(uint32_t Instance, uint32_t *YSize);
+static int32_t  BENCH_SetLayer(uint32_t Instance, uint32_t Layer);
+static int32_t  BENCH_GetFormat(uint32_t Instance, uint32_t *Format);
+static void     BENCH_OpClear(uint32_t Size);
+static void     BENCH_OpFillRect(uint32_t Size);
+static void     BENCH_OpDrawRect(uint32_t Size);
+static void     BENCH_OpHLine(uint32_t Size);
+static void     BENCH_OpVLine(uint32_t Size);
+static void     BENCH_OpLine(uint32_t Size);
+static void     BENCH_OpDrawCircle(uint32_t Size);
+static void     BENCH_OpFillCircle(uint32_t Size);
+static void     BENCH_OpDrawEllipse(uint32_t Size);
+static void     BENCH_OpFillEllipse(uint32_t Size);
+static void     BENCH_Polygon(uint32_t Size, uint32_t Fill);
+static void     BENCH_OpDrawPolygon(uint32_t Size);
+static void     BENCH_OpFillPolygon(uint32_t Size);
+static void     BENCH_OpBitmap(uint32_t Size);
+static void     BENCH_OpRGBRect(uint32_t Size);
+static void     BENCH_OpChar(uint32_t Size);
+static void     BENCH_OpString(uint32_t Size);
+static void     BENCH_OpSetPixel(uint32_t Size);
+static void     BENCH_OpGetPixel(uint32_t Size);
+static void     BENCH_MakeBitmap(uint32_t Size);
+static void     BENCH_Measure(uint32_t Orientation, const BENCH_Test_t *pTest, uint32_t Size, const char *pFont);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Private_Variables STM32 LCD Benchmark Utility Private Variables
+  * @{
+  */
+static BENCH_Ctx_t BenchCtx;
+static uint8_t     BenchBmp[BENCH_BMP_SIZE];
+
+/* Counting driver forwarding to the driver under test */
+static const LCD_UTILS_Drv_t BenchDriver =
+{
+  BENCH_DrawBitmap,
+  BENCH_FillRGBRect,
+  BENCH_DrawHLine,
+  BENCH_DrawVLine,
+  BENCH_FillRect,
+  BENCH_GetPixel,
+  BENCH_SetPixel,
+  BENCH_GetXSize,
+  BENCH_GetYSize,
+  BENCH_SetLayer,
+  BENCH_GetFormat
+};
+
+static const BENCH_Test_t BenchTests[] =
+{
+  {"Clear",           BENCH_KIND_SINGLE, BENCH_OpClear      },
+  {"FillRect",        BENCH_KIND_SHAPE,  BENCH_OpFillRect   },
+  {"DrawRect",        BENCH_KIND_SHAPE,  BENCH_OpDrawRect   },
+  {"DrawHLine",       BENCH_KIND_SHAPE,  BENCH_OpHLine      },
+  {"DrawVLine",       BENCH_KIND_SHAPE,  BENCH_OpVLine      },
+  {"DrawLine",        BENCH_KIND_SHAPE,  BENCH_OpLine       },
+  {"DrawCircle",      BENCH_KIND_SHAPE,  BENCH_OpDrawCircle },
+  {"FillCircle",      BENCH_KIND_SHAPE,  BENCH_OpFillCircle },
+  {"DrawEllipse",     BENCH_KIND_SHAPE,  BENCH_OpDrawEllipse},
+  {"FillEllipse",     BENCH_KIND_SHAPE,  BENCH_OpFillEllipse},
+  {"DrawPolygon",     BENCH_KIND_SHAPE,  BENCH_OpDrawPolygon},
+  {"FillPolygon",     BENCH_KIND_SHAPE,  BENCH_OpFillPolygon},
+  {"DrawBitmap",      BENCH_KIND_BITMAP, BENCH_OpBitmap     },
+  {"FillRGBRect",     BENCH_KIND_BITMAP, BENCH_OpRGBRect    },
+  {"DisplayChar",     BENCH_KIND_TEXT,   BENCH_OpChar       },
+  {"DisplayStringAt", BENCH_KIND_TEXT,   BENCH_OpString     },
+  {"SetPixel",        BENCH_KIND_SINGLE, BENCH_OpSetPixel   },
+  {"GetPixel",        BENCH_KIND_SINGLE, BENCH_OpGetPixel   }
+};
+
+static const uint32_t BenchSizes[] = {8U, 32U, 96U, 200U};
+
+static sFONT *const BenchFonts[] = {&Font8, &Font12, &Font16, &Font20, &Font24};
+static const char *const BenchFontNames[] = {"Font8", "Font12", "Font16", "Font20", "Font24"};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Exported_Functions STM32 LCD Benchmark Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Run the benchmark. The STM32 LCD utility is left linked to the
+  *         benchmark driver and should be linked back by the caller.
+  * @param  pInit Benchmark configuration
+  * @retval UTIL_LCD_BENCH status
+  */
+int32_t UTIL_LCD_BENCH_Run(const UTIL_LCD_BENCH_Init_t *pInit)
+{
+  int32_t  ret = UTIL_LCD_BENCH_OK;
+  uint32_t orientation, orientations, test, i;
+
+  if ((pInit == NULL) || (pInit->pDrv == NULL) || (pInit->Output == NULL))
+  {
+    ret = UTIL_LCD_BENCH_ERROR;
+  }
+  else
+  {
+    BenchCtx.pInit = pInit;
+    orientations   = (pInit->SetOrientation != NULL) ? pInit->Orientations : 1U;
+
+    pInit->Output("orientation,primitive,size,font,iterations,calls,commands,data_writes,data_reads,bytes,cpu_us,bus_us\n");
+
+    for (orientation = 0U; (orientation < orientations) && (ret == UTIL_LCD_BENCH_OK); orientation++)
+    {
+      if ((pInit->SetOrientation != NULL) && (pInit->SetOrientation(orientation) != 0))
+      {
+        ret = UTIL_LCD_BENCH_ERROR;
+      }
+      else
+      {
+        /* Display size may depend on the orientation */
+        UTIL_LCD_SetFuncDriver(&BenchDriver);
+        (void)pInit->pDrv->GetXSize(0U, &BenchCtx.XSize);
+        (void)pInit->pDrv->GetYSize(0U, &BenchCtx.YSize);
+        UTIL_LCD_SetBackColor(UTIL_LCD_COLOR_BLACK);
+        UTIL_LCD_SetTextColor(UTIL_LCD_COLOR_WHITE);
+
+        for (test = 0U; test < (sizeof(BenchTests) / sizeof(BenchTests[0])); test++)
+        {
+          switch (BenchTests[test].Kind)
+          {
+            case BENCH_KIND_SHAPE:
+            case BENCH_KIND_BITMAP:
+              for (i = 0U; i < (sizeof(BenchSizes) / sizeof(BenchSizes[0])); i++)
+              {
+                if ((BenchTests[test].Kind == BENCH_KIND_SHAPE) || (BenchSizes[i] <= UTIL_LCD_BENCH_BITMAP_MAX))
+                {
+                  BENCH_Measure(orientation, &BenchTests[test], BenchSizes[i], "-");
+                }
+              }
+              break;
+
+            case BENCH_KIND_TEXT:
+              for (i = 0U; i < (sizeof(BenchFonts) / sizeof(BenchFonts[0])); i++)
+              {
+                UTIL_LCD_SetFont(BenchFonts[i]);
+                BENCH_Measure(orientation, &BenchTests[test], BenchFonts[i]->Height, BenchFontNames[i]);
+              }
+              break;
+
+            case BENCH_KIND_SINGLE:
+            default:
+              BENCH_Measure(orientation, &BenchTests[test], 1U, "-");
+              break;
+          }
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Private_Functions STM32 LCD Benchmark Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Counting driver services, forwarding to the driver under test.
+  */
+static int32_t BENCH_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->DrawBitmap(Instance, Xpos, Ypos, pBmp);
+}
+
+static int32_t BENCH_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->FillRGBRect(Instance, Xpos, Ypos, pData, Width, Height);
+}
+
+static int32_t BENCH_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->DrawHLine(Instance, Xpos, Ypos, Length, Color);
+}
+
+static int32_t BENCH_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->DrawVLine(Instance, Xpos, Ypos, Length, Color);
+}
+
+static int32_t BENCH_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->FillRect(Instance, Xpos, Ypos, Width, Height, Color);
+}
+
+static int32_t BENCH_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->GetPixel(Instance, Xpos, Ypos, Color);
+}
+
+static int32_t BENCH_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  BenchCtx.Calls++;
+  return BenchCtx.pInit->pDrv->SetPixel(Instance, Xpos, Ypos, Color);
+}
+
+static int32_t BENCH_GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  return BenchCtx.pInit->pDrv->GetXSize(Instance, XSize);
+}
+
+static int32_t BENCH_GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  return BenchCtx.pInit->pDrv->GetYSize(Instance, YSize);
+}
+
+static int32_t BENCH_SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  return BenchCtx.pInit->pDrv->SetLayer(Instance, Layer);
+}
+
+static int32_t BENCH_GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  return BenchCtx.pInit->pDrv->GetFormat(Instance, Format);
+}
+
+/**
+  * @brief  Benchmarked operations. Shapes of Size pixels are centered on the
+  *         display.
+  * @param  Size Size in pixels, or font height for text
+  */
+static void BENCH_OpClear(uint32_t Size)
+{
+  (void)Size;
+  UTIL_LCD_Clear(BENCH_COLOR);
+}
+
+static void BENCH_OpFillRect(uint32_t Size)
+{
+  UTIL_LCD_FillRect((BenchCtx.XSize - Size) / 2U, (BenchCtx.YSize - Size) / 2U, Size, Size, BENCH_COLOR);
+}
+
+static void BENCH_OpDrawRect(uint32_t Size)
+{
+  UTIL_LCD_DrawRect((BenchCtx.XSize - Size) / 2U, (BenchCtx.YSize - Size) / 2U, Size, Size, BENCH_COLOR);
+}
+
+static void BENCH_OpHLine(uint32_t Size)
+{
+  UTIL_LCD_DrawHLine((BenchCtx.XSize - Size) / 2U, BenchCtx.YSize / 2U, Size, BENCH_COLOR);
+}
+
+static void BENCH_OpVLine(uint32_t Size)
+{
+  UTIL_LCD_DrawVLine(BenchCtx.XSize / 2U, (BenchCtx.YSize - Size) / 2U, Size, BENCH_COLOR);
+}
+
+static void BENCH_OpLine(uint32_t Size)
+{
+  /* Diagonal with a 2:1 slope */
+  UTIL_LCD_DrawLine((BenchCtx.XSize - Size) / 2U, (BenchCtx.YSize - (Size / 2U)) / 2U,
+                    ((BenchCtx.XSize + Size) / 2U) - 1U, ((BenchCtx.YSize + (Size / 2U)) / 2U) - 1U, BENCH_COLOR);
+}
+
+static void BENCH_OpDrawCircle(uint32_t Size)
+{
+  UTIL_LCD_DrawCircle(BenchCtx.XSize / 2U, BenchCtx.YSize / 2U, (Size / 2U) - 1U, BENCH_COLOR);
+}
+
+static void BENCH_OpFillCircle(uint32_t Size)
+{
+  UTIL_LCD_FillCircle(BenchCtx.XSize / 2U, BenchCtx.YSize / 2U, (Size / 2U) - 1U, BENCH_COLOR);
+}
+
+static void BENCH_OpDrawEllipse(uint32_t Size)
+{
+  UTIL_LCD_DrawEllipse((int)BenchCtx.XSize / 2, (int)BenchCtx.YSize / 2, ((int)Size / 2) - 1, (int)Size / 4, BENCH_COLOR);
+}
+
+static void BENCH_OpFillEllipse(uint32_t Size)
+{
+  UTIL_LCD_FillEllipse((int)BenchCtx.XSize / 2, (int)BenchCtx.YSize / 2, ((int)Size / 2) - 1, (int)Size / 4, BENCH_COLOR);
+}
+
+static void BENCH_OpDrawPolygon(uint32_t Size)
+{
+  BENCH_Polygon(Size, 0U);
+}
+
+static void BENCH_OpFillPolygon(uint32_t Size)
+{
+  BENCH_Polygon(Size, 1U);
+}
+
+static void BENCH_OpBitmap(uint32_t Size)
+{
+  UTIL_LCD_DrawBitmap((BenchCtx.XSize - Size) / 2U, (BenchCtx.YSize - Size) / 2U, BenchBmp);
+}
+
+static void BENCH_OpRGBRect(uint32_t Size)
+{
+  UTIL_LCD_FillRGBRect((BenchCtx.XSize - Size) / 2U, (BenchCtx.YSize - Size) / 2U, &BenchBmp[BENCH_BMP_HEADER], Size, Size);
+}
+
+static void BENCH_OpChar(uint32_t Size)
+{
+  (void)Size;
+  UTIL_LCD_DisplayChar(BenchCtx.XSize / 2U, BenchCtx.YSize / 2U, (uint8_t)'A');
+}
+
+static void BENCH_OpString(uint32_t Size)
+{
+  (void)Size;
+  UTIL_LCD_DisplayStringAt(0U, BenchCtx.YSize / 2U, (uint8_t *)BENCH_TEXT, LEFT_MODE);
+}
+
+static void BENCH_OpSetPixel(uint32_t Size)
+{
+  (void)Size;
+  UTIL_LCD_SetPixel((uint16_t)(BenchCtx.XSize / 2U), (uint16_t)(BenchCtx.YSize / 2U), BENCH_COLOR);
+}
+
+static void BENCH_OpGetPixel(uint32_t Size)
+{
+  uint32_t color;
+
+  (void)Size;
+  UTIL_LCD_GetPixel((uint16_t)(BenchCtx.XSize / 2U), (uint16_t)(BenchCtx.YSize / 2U), &color);
+}
+
+/**
+  * @brief  Draw a concave pentagon of Size pixels centered on the display.
+  * @param  Size Size in pixels
+  * @param  Fill 1 to fill the polygon, 0 to draw its outline
+  */
+static void BENCH_Polygon(uint32_t Size, uint32_t Fill)
+{
+  Point    points[5];
+  int16_t  x = (int16_t)(BenchCtx.XSize / 2U);
+  int16_t  y = (int16_t)(BenchCtx.YSize / 2U);
+  int16_t  r = (int16_t)((Size / 2U) - 1U);
+
+  points[0].X = x;
+  points[0].Y = (int16_t)(y - r);
+  points[1].X = (int16_t)(x + r);
+  points[1].Y = (int16_t)(y + r);
+  points[2].X = x;
+  points[2].Y = (int16_t)(y + (r / 3));
+  points[3].X = (int16_t)(x - r);
+  points[3].Y = (int16_t)(y + r);
+  points[4].X = (int16_t)(x - ((2 * r) / 3));
+  points[4].Y = (int16_t)(y - (r / 3));
+
+  if (Fill != 0U)
+  {
+    UTIL_LCD_FillPolygon(points, 5U, BENCH_COLOR);
+  }
+  else
+  {
+    UTIL_LCD_DrawPolygon(points, 5U, BENCH_COLOR);
+  }
+}
+
+/**
+  * @brief  Build a bottom-up RGB565 BMP file of Size x Size pixels.
+  * @param  Size Size in pixels, even and up to UTIL_LCD_BENCH_BITMAP_MAX
+  */
+static void BENCH_MakeBitmap(uint32_t Size)
+{
+  uint32_t data = 2U * Size * Size;
+  uint32_t file = BENCH_BMP_HEADER + data;
+  uint32_t i;
+
+  (void)memset(BenchBmp, 0, BENCH_BMP_HEADER);
+  BenchBmp[0]  = (uint8_t)'B';
+  BenchBmp[1]  = (uint8_t)'M';
+  BenchBmp[2]  = (uint8_t)file;
+  BenchBmp[3]  = (uint8_t)(file >> 8);
+  BenchBmp[4]  = (uint8_t)(file >> 16);
+  BenchBmp[10] = (uint8_t)BENCH_BMP_HEADER;
+  BenchBmp[14] = 40U;
+  BenchBmp[18] = (uint8_t)Size;
+  BenchBmp[22] = (uint8_t)Size;
+  BenchBmp[26] = 1U;
+  BenchBmp[28] = 16U;
+  for (i = 0U; i < (data / 2U); i++)
+  {
+    /* Varying pixels: no run of identical colors */
+    BenchBmp[BENCH_BMP_HEADER + (2U * i)]      = (uint8_t)(i * 7U);
+    BenchBmp[BENCH_BMP_HEADER + (2U * i) + 1U] = (uint8_t)(i >> 3);
+  }
+}
+
+/**
+  * @brief  Run a test and output its CSV line.
+  * @param  Orientation Orientation index
+  * @param  pTest       Test
+  * @param  Size        Test size
+  * @param  pFont       Font name
+  */
+static void BENCH_Measure(uint32_t Orientation, const BENCH_Test_t *pTest, uint32_t Size, const char *pFont)
+{
+  const UTIL_LCD_BENCH_Init_t *init = BenchCtx.pInit;
+  UTIL_LCD_BENCH_Bus_t bus_start = {0U, 0U, 0U};
+  UTIL_LCD_BENCH_Bus_t bus_end   = {0U, 0U, 0U};
+  uint32_t iterations = (init->Iterations != 0U) ? init->Iterations : 1U;
+  uint32_t clock      = (init->BusClock != 0U) ? init->BusClock : UTIL_LCD_BENCH_BUS_CLOCK;
+  uint32_t write      = (init->WriteCycles != 0U) ? init->WriteCycles : UTIL_LCD_BENCH_WRITE_CYCLES;
+  uint32_t read       = (init->ReadCycles != 0U) ? init->ReadCycles : UTIL_LCD_BENCH_READ_CYCLES;
+  uint32_t time_start = 0U, time_end = 0U;
+  uint32_t commands, writes, reads, i;
+  uint64_t cycles;
+  char     line[160];
+
+  if (pTest->Kind == BENCH_KIND_BITMAP)
+  {
+    /* Bitmap built out of the measure */
+    BENCH_MakeBitmap(Size);
+  }
+
+  BenchCtx.Calls = 0U;
+  if (init->GetBus != NULL)
+  {
+    init->GetBus(&bus_start);
+  }
+  if (init->GetTime != NULL)
+  {
+    time_start = init->GetTime();
+  }
+
+  for (i = 0U; i < iterations; i++)
+  {
+    pTest->Run(Size);
+  }
+
+  if (init->GetTime != NULL)
+  {
+    time_end = init->GetTime();
+  }
+  if (init->GetBus != NULL)
+  {
+    init->GetBus(&bus_end);
+  }
+
+  commands = (bus_end.Commands - bus_start.Commands) / iterations;
+  writes   = (bus_end.DataWrites - bus_start.DataWrites) / iterations;
+  reads    = (bus_end.DataReads - bus_start.DataReads) / iterations;
+  cycles   = ((uint64_t)(commands + writes) * write) + ((uint64_t)reads * read);
+
+  (void)snprintf(line, sizeof(line), "%lu,%s,%lu,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                 (unsigned long)Orientation, pTest->pName, (unsigned long)Size, pFont, (unsigned long)iterations,
+                 (unsigned long)(BenchCtx.Calls / iterations), (unsigned long)commands, (unsigned long)writes,
+                 (unsigned long)reads, (unsigned long)(2U * (commands + writes + reads)),
+                 (unsigned long)((time_end - time_start) / iterations),
+                 (unsigned long)((cycles * 1000000U) / clock));
+  init->Output(line);
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_bench.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_bench.c rendering benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_BENCH_H
+#define STM32_LCD_BENCH_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_BENCH STM32 LCD Benchmark Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Exported_Constants STM32 LCD Benchmark Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_BENCH_OK                0
+#define UTIL_LCD_BENCH_ERROR           (-1)
+
+/**
+  * @brief  Largest bitmap benchmarked, in pixels per side
+  */
+#ifndef UTIL_LCD_BENCH_BITMAP_MAX
+  #define UTIL_LCD_BENCH_BITMAP_MAX      64U
+#endif
+
+/**
+  * @brief  Default bus model: FMC kernel clock and clock cycles per 16-bit
+  *         access, as set by MX_FMC_BANK1_Init() for the ST7789H2
+  */
+#ifndef UTIL_LCD_BENCH_BUS_CLOCK
+  #define UTIL_LCD_BENCH_BUS_CLOCK       110000000U
+#endif
+#ifndef UTIL_LCD_BENCH_WRITE_CYCLES
+  #define UTIL_LCD_BENCH_WRITE_CYCLES    10U
+#endif
+#ifndef UTIL_LCD_BENCH_READ_CYCLES
+  #define UTIL_LCD_BENCH_READ_CYCLES     34U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_BENCH_Exported_Types STM32 LCD Benchmark Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Bus traffic counters
+  */
+typedef struct
+{
+  uint32_t Commands;    /*!< Command words written */
+  uint32_t DataWrites;  /*!< Data words written    */
+  uint32_t DataReads;   /*!< Data words read       */
+} UTIL_LCD_BENCH_Bus_t;
+
+/**
+  * @brief  Benchmark configuration
+  */
+typedef struct
+{
+  const LCD_UTILS_Drv_t *pDrv;                             /*!< Driver under test                                       */
+  uint32_t               Orientations;                     /*!< Number of orientations benchmarked                      */
+  int32_t              (*SetOrientation)(uint32_t);        /*!< Select orientation 0 to Orientations - 1, may be NULL   */
+  void                 (*GetBus)(UTIL_LCD_BENCH_Bus_t *);  /*!< Running bus counters, may be NULL                       */
+  uint32_t             (*GetTime)(void);                   /*!< Running CPU time in microseconds, may be NULL           */
+  void                 (*Output)(const char *);            /*!< Receives each CSV line                                  */
+  uint32_t               Iterations;                       /*!< Runs per test, results are averaged                     */
+  uint32_t               BusClock;                         /*!< Bus clock in Hz, 0 for UTIL_LCD_BENCH_BUS_CLOCK         */
+  uint32_t               WriteCycles;                      /*!< Bus cycles per write, 0 for UTIL_LCD_BENCH_WRITE_CYCLES */
+  uint32_t               ReadCycles;                       /*!< Bus cycles per read, 0 for UTIL_LCD_BENCH_READ_CYCLES   */
+} UTIL_LCD_BENCH_Init_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_BENCH_Exported_Functions
+  * @{
+  */
+int32_t UTIL_LCD_BENCH_Run(const UTIL_LCD_BENCH_Init_t *pInit);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_BENCH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,1457 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_dl.c
+  * @author  MCD Application Team
+  * @brief   This file includes a display list recorder for the STM32 LCD
+  *          utility: drawing commands are recorded in a compact byte code,
+  *          replayed, compared and rasterized once for static content.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver records the primitives issued by the STM32 LCD utility in a
+     display list instead of drawing them. The list is replayed later on any
+     LCD_UTILS_Drv_t driver (panel, UTIL_LCD_FB frame buffer...), as a whole or
+     clipped to a rectangle.
+
+   - Record a scene:
+         UTIL_LCD_DL_Init()      : command buffer and display geometry
+         UTIL_LCD_DL_Begin()     : empty the list and record in it
+         UTIL_LCD_SetFuncDriver(&UTIL_LCD_DL_Driver)
+         UTIL_LCD_* drawing services
+         UTIL_LCD_DL_End()       : returns an error if the buffer overflowed
+     then link the utility back to the display driver and call
+     UTIL_LCD_DL_Replay().
+
+   - Commands are coded on one byte followed by 16-bit fields. RGB rectangles
+     (e.g. text) are stored run length encoded; bitmaps are referenced, not
+     copied, so they must stay in place as long as the list is used. Colors
+     are recorded in RGB565.
+
+   - UTIL_LCD_DL_Diff() compares two recordings of a scene, e.g. consecutive
+     frames: the commands shared at the beginning and at the end of both lists
+     are skipped and the areas drawn by the other ones are returned as a small
+     set of rectangles. Replaying the new list clipped to each rectangle
+     updates the display. The scene is expected to paint every area it may
+     change, e.g. starting with a background fill; a change of the content of
+     a referenced bitmap is not detected.
+
+   - A static list can be rasterized once in a RAM buffer of
+     UTIL_LCD_DL_GetCacheSize() bytes with UTIL_LCD_DL_Cache(). It is then
+     replayed as RGB rectangles, with a single one when the commands cover
+     their whole bounding box, instead of being executed command by command.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_dl.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_DL STM32 LCD Display List Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_Defines STM32 LCD Display List Utility Private Defines
+  * @{
+  */
+/* Command op codes */
+#define DL_OP_FILL_RECT   0x01U  /* X, Y, Width, Height, Color            */
+#define DL_OP_HLINE       0x02U  /* X, Y, Length, Color                   */
+#define DL_OP_VLINE       0x03U  /* X, Y, Length, Color                   */
+#define DL_OP_PIXEL       0x04U  /* X, Y, Color                           */
+#define DL_OP_RGB_RECT    0x05U  /* X, Y, Width, Height, 32-bit size, RLE */
+#define DL_OP_BITMAP      0x06U  /* X, Y, Width, Height, BMP file address */
+
+/* Largest command header: op code, 4 fields and a 32-bit size or an address */
+#define DL_HEADER_MAX     (1U + 8U + ((sizeof(uint8_t *) > 4U) ? sizeof(uint8_t *) : 4U))
+
+/* RLE control byte: a run of (n & 0x7F) + 1 copies of the next pixel when
+   bit 7 is set, n + 1 literal pixels otherwise */
+#define DL_RLE_REPEAT     0x80U
+#define DL_RLE_MAX_RUN    128U
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_Macros STM32 LCD Display List Utility Private Macros
+  * @{
+  */
+#define MIN(X, Y)         (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y)         (((X) > (Y)) ? (X) : (Y))
+
+#define DL_GET16(p)       ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8))
+#define DL_GET32(p)       (DL_GET16(p) | (DL_GET16(&(p)[2]) << 16))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_Types STM32 LCD Display List Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t X0;  /* Left column            */
+  uint32_t Y0;  /* Top row                */
+  uint32_t X1;  /* Right column (excluded) */
+  uint32_t Y1;  /* Bottom row (excluded)  */
+} DL_Box_t;
+
+typedef struct
+{
+  uint32_t       Op;
+  uint32_t       Color;
+  DL_Box_t       Box;    /* Area drawn, before clipping        */
+  const uint8_t *pData;  /* RLE pixels or BMP file             */
+  uint32_t       Next;   /* Offset of the next command         */
+} DL_Cmd_t;
+
+typedef struct
+{
+  const DL_Cmd_t *pCmd;
+  const uint8_t  *pRle;     /* Next RLE byte                        */
+  uint32_t        Pos;      /* Index of the next pixel decoded       */
+  uint32_t        Left;     /* Pixels left in the current run        */
+  uint32_t        Repeat;   /* Current run repeats Color             */
+  uint16_t        Color;
+  uint32_t        Index;    /* BMP pixel data offset                 */
+  uint32_t        Stride;   /* BMP row size in bytes                 */
+  uint32_t        Height;   /* BMP height                            */
+  uint32_t        TopDown;  /* BMP rows are stored from the top      */
+} DL_Source_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_FunctionPrototypes STM32 LCD Display List Utility Private FunctionPrototypes
+  * @{
+  */
+static uint32_t DL_Intersect(DL_Box_t *pBox, const DL_Box_t *pOther);
+static void     DL_Union(DL_Box_t *pBox, const DL_Box_t *pOther);
+static uint32_t DL_Area(const DL_Box_t *pBox);
+static void     DL_RectToBox(const UTIL_LCD_DL_Rect_t *pRect, DL_Box_t *pBox);
+static void     DL_BoxToRect(const DL_Box_t *pBox, UTIL_LCD_DL_Rect_t *pRect);
+static uint32_t DL_BmpHeader(const uint8_t *pBmp, uint32_t *pIndex, uint32_t *pWidth, uint32_t *pHeight, uint32_t *pTopDown);
+static uint32_t DL_Put(const uint8_t *pData, uint32_t Length);
+static int32_t  DL_Record(uint32_t Op, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color,
+                          const uint8_t *pData);
+static uint32_t DL_Encode(const uint8_t *pData, uint32_t Length);
+static uint32_t DL_Decode(const UTIL_LCD_DL_t *pList, uint32_t Offset, DL_Cmd_t *pCmd);
+static void     DL_SourceInit(DL_Source_t *pSrc, const DL_Cmd_t *pCmd);
+static void     DL_SourceRead(DL_Source_t *pSrc, uint32_t Row, uint32_t Column, uint16_t *pDst, uint32_t Length);
+static int32_t  DL_DrawPixels(const DL_Cmd_t *pCmd, const DL_Box_t *pBox, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance);
+static int32_t  DL_Draw(const DL_Cmd_t *pCmd, const DL_Box_t *pClip, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance);
+static int32_t  DL_ReplayCache(const UTIL_LCD_DL_t *pList, const DL_Box_t *pClip, const LCD_UTILS_Drv_t *pDrv,
+                               uint32_t Instance);
+static void     DL_CacheCmd(const UTIL_LCD_DL_t *pList, const DL_Cmd_t *pCmd);
+static void     DL_AddRect(UTIL_LCD_DL_Rect_t *pRects, uint32_t *pCount, uint32_t MaxRects, const DL_Box_t *pBox);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_Variables STM32 LCD Display List Utility Private Variables
+  * @{
+  */
+static UTIL_LCD_DL_t *DlRecord;
+static uint16_t       DlPixels[UTIL_LCD_DL_PIXEL_BUFFER_SIZE];
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Exported_Variables STM32 LCD Display List Utility Exported Variables
+  * @{
+  */
+const LCD_UTILS_Drv_t UTIL_LCD_DL_Driver =
+{
+  UTIL_LCD_DL_DrawBitmap,
+  UTIL_LCD_DL_FillRGBRect,
+  UTIL_LCD_DL_DrawHLine,
+  UTIL_LCD_DL_DrawVLine,
+  UTIL_LCD_DL_FillRect,
+  UTIL_LCD_DL_GetPixel,
+  UTIL_LCD_DL_SetPixel,
+  UTIL_LCD_DL_GetXSize,
+  UTIL_LCD_DL_GetYSize,
+  UTIL_LCD_DL_SetLayer,
+  UTIL_LCD_DL_GetFormat
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Exported_Functions STM32 LCD Display List Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize an empty display list.
+  * @param  pList   Display list
+  * @param  pBuffer Command buffer
+  * @param  Size    Command buffer size in bytes
+  * @param  Width   Display width reported to the utility while recording
+  * @param  Height  Display height reported to the utility while recording
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_Init(UTIL_LCD_DL_t *pList, uint8_t *pBuffer, uint32_t Size, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_DL_OK;
+
+  if ((pList == NULL) || (pBuffer == NULL) || (Width > 0xFFFFU) || (Height > 0xFFFFU))
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else
+  {
+    (void)memset(pList, 0, sizeof(UTIL_LCD_DL_t));
+    pList->pBuffer = pBuffer;
+    pList->Size    = Size;
+    pList->Width   = Width;
+    pList->Height  = Height;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Empty a display list and record the next UTIL_LCD_DL_Driver
+  *         commands in it. The list cache is dropped.
+  * @param  pList Display list
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_Begin(UTIL_LCD_DL_t *pList)
+{
+  int32_t ret = UTIL_LCD_DL_OK;
+
+  if ((pList == NULL) || (pList->pBuffer == NULL))
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else
+  {
+    pList->Length = 0U;
+    pList->Count  = 0U;
+    pList->Error  = 0U;
+    (void)memset(&pList->Bounds, 0, sizeof(UTIL_LCD_DL_Rect_t));
+    UTIL_LCD_DL_Uncache(pList);
+    DlRecord = pList;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Stop recording.
+  * @retval UTIL_LCD_DL status, UTIL_LCD_DL_ERROR if a command could not be
+  *         recorded
+  */
+int32_t UTIL_LCD_DL_End(void)
+{
+  int32_t ret = UTIL_LCD_DL_OK;
+
+  if ((DlRecord == NULL) || (DlRecord->Error != 0U))
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  DlRecord = NULL;
+
+  return ret;
+}
+
+/**
+  * @brief  Replay a display list.
+  * @param  pList    Display list
+  * @param  pDrv     Driver executing the commands
+  * @param  Instance Instance passed to the driver
+  * @param  pClip    Rectangle the drawing is clipped to, NULL for none
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_Replay(const UTIL_LCD_DL_t *pList, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance,
+                           const UTIL_LCD_DL_Rect_t *pClip)
+{
+  int32_t  ret = UTIL_LCD_DL_OK;
+  uint32_t offset = 0U;
+  DL_Box_t clip;
+  DL_Cmd_t cmd;
+
+  if ((pList == NULL) || (pDrv == NULL) || (pList->Error != 0U))
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else
+  {
+    if (pClip != NULL)
+    {
+      DL_RectToBox(pClip, &clip);
+    }
+    else
+    {
+      clip.X0 = 0U;
+      clip.Y0 = 0U;
+      clip.X1 = 0xFFFFFFFFU;
+      clip.Y1 = 0xFFFFFFFFU;
+    }
+
+    if (pList->pCache != NULL)
+    {
+      ret = DL_ReplayCache(pList, &clip, pDrv, Instance);
+    }
+    else
+    {
+      while (offset < pList->Length)
+      {
+        offset = DL_Decode(pList, offset, &cmd);
+        if (DL_Draw(&cmd, &clip, pDrv, Instance) != UTIL_LCD_DL_OK)
+        {
+          ret = UTIL_LCD_DL_ERROR;
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the display areas that differ between two recordings of a
+  *         scene.
+  * @param  pOld     Display list currently displayed
+  * @param  pNew     Display list to display
+  * @param  pRects   Rectangles to redraw from the new list
+  * @param  MaxRects Size of pRects, at least 1. Areas are merged to fit.
+  * @retval Number of rectangles, 0 when both lists draw the same image
+  */
+uint32_t UTIL_LCD_DL_Diff(const UTIL_LCD_DL_t *pOld, const UTIL_LCD_DL_t *pNew, UTIL_LCD_DL_Rect_t *pRects,
+                          uint32_t MaxRects)
+{
+  uint32_t count = 0U;
+  uint32_t old_start = 0U, new_start = 0U;
+  uint32_t old_end, new_end, old_left, new_left;
+  uint32_t suffix = 0U, limit;
+  DL_Box_t box, display;
+  DL_Cmd_t old_cmd, new_cmd;
+
+  if ((pOld == NULL) || (pNew == NULL) || (pRects == NULL) || (MaxRects == 0U))
+  {
+    /* Nothing can be reported */
+  }
+  else
+  {
+    display.X0 = 0U;
+    display.Y0 = 0U;
+    display.X1 = pNew->Width;
+    display.Y1 = pNew->Height;
+
+    if ((pOld->Error != 0U) || (pNew->Error != 0U) || (pOld->Width != pNew->Width) || (pOld->Height != pNew->Height))
+    {
+      /* Lists cannot be compared: redraw everything */
+      DL_AddRect(pRects, &count, MaxRects, &display);
+    }
+    else
+    {
+      /* Skip the common leading commands */
+      while ((old_start < pOld->Length) && (new_start < pNew->Length))
+      {
+        old_end = DL_Decode(pOld, old_start, &old_cmd);
+        new_end = DL_Decode(pNew, new_start, &new_cmd);
+        if (((old_end - old_start) != (new_end - new_start)) ||
+            (memcmp(&pOld->pBuffer[old_start], &pNew->pBuffer[new_start], old_end - old_start) != 0))
+        {
+          break;
+        }
+        old_start = old_end;
+        new_start = new_end;
+      }
+
+      /* Common trailing bytes, then the last command boundary shared by both
+         lists within them */
+      limit = MIN(pOld->Length - old_start, pNew->Length - new_start);
+      while ((suffix < limit) &&
+             (pOld->pBuffer[pOld->Length - 1U - suffix] == pNew->pBuffer[pNew->Length - 1U - suffix]))
+      {
+        suffix++;
+      }
+      old_end  = old_start;
+      new_end  = new_start;
+      old_left = pOld->Length - old_end;
+      new_left = pNew->Length - new_end;
+      while ((old_left != new_left) || (old_left > suffix))
+      {
+        if ((old_left > suffix) || (old_left > new_left))
+        {
+          old_end  = DL_Decode(pOld, old_end, &old_cmd);
+          old_left = pOld->Length - old_end;
+        }
+        else
+        {
+          new_end  = DL_Decode(pNew, new_end, &new_cmd);
+          new_left = pNew->Length - new_end;
+        }
+      }
+
+      /* Areas drawn by the remaining commands of both lists */
+      while (old_start < old_end)
+      {
+        old_start = DL_Decode(pOld, old_start, &old_cmd);
+        box = old_cmd.Box;
+        if (DL_Intersect(&box, &display) != 0U)
+        {
+          DL_AddRect(pRects, &count, MaxRects, &box);
+        }
+      }
+      while (new_start < new_end)
+      {
+        new_start = DL_Decode(pNew, new_start, &new_cmd);
+        box = new_cmd.Box;
+        if (DL_Intersect(&box, &display) != 0U)
+        {
+          DL_AddRect(pRects, &count, MaxRects, &box);
+        }
+      }
+    }
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Get the RAM size needed to cache a display list.
+  * @param  pList Display list
+  * @retval Size in bytes: RGB565 pixels and a coverage bit per pixel of the
+  *         list bounding box
+  */
+uint32_t UTIL_LCD_DL_GetCacheSize(const UTIL_LCD_DL_t *pList)
+{
+  uint32_t size = 0U;
+  uint32_t pixels;
+
+  if (pList != NULL)
+  {
+    pixels = pList->Bounds.Width * pList->Bounds.Height;
+    size   = (2U * pixels) + ((pixels + 7U) / 8U);
+  }
+
+  return size;
+}
+
+/**
+  * @brief  Rasterize a display list in a cache, used by the next replays
+  *         until the list is recorded again or uncached.
+  * @param  pList  Display list
+  * @param  pCache Cache buffer, 16-bit aligned
+  * @param  Size   Cache buffer size, at least UTIL_LCD_DL_GetCacheSize()
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_Cache(UTIL_LCD_DL_t *pList, uint8_t *pCache, uint32_t Size)
+{
+  int32_t  ret = UTIL_LCD_DL_OK;
+  uint32_t offset = 0U;
+  uint32_t pixels, i;
+  DL_Cmd_t cmd;
+
+  if ((pList == NULL) || (pCache == NULL) || (pList->Error != 0U) || (((uintptr_t)pCache & 1U) != 0U) ||
+      (Size < UTIL_LCD_DL_GetCacheSize(pList)))
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else
+  {
+    pixels = pList->Bounds.Width * pList->Bounds.Height;
+    pList->pCache     = (uint16_t *)(void *)pCache;
+    pList->pCacheMask = &pCache[2U * pixels];
+    (void)memset(pList->pCacheMask, 0, (pixels + 7U) / 8U);
+
+    while (offset < pList->Length)
+    {
+      offset = DL_Decode(pList, offset, &cmd);
+      DL_CacheCmd(pList, &cmd);
+    }
+
+    pList->CacheFull = 1U;
+    for (i = 0U; (i < pixels) && (pList->CacheFull != 0U); i++)
+    {
+      if ((pList->pCacheMask[i / 8U] & (1U << (i % 8U))) == 0U)
+      {
+        pList->CacheFull = 0U;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Drop the cache of a display list: next replays execute the
+  *         commands.
+  * @param  pList Display list
+  */
+void UTIL_LCD_DL_Uncache(UTIL_LCD_DL_t *pList)
+{
+  if (pList != NULL)
+  {
+    pList->pCache     = NULL;
+    pList->pCacheMask = NULL;
+    pList->CacheFull  = 0U;
+  }
+}
+
+/**
+  * @brief  Record a RGB565 bitmap (BMP file). The bitmap is referenced.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pBmp     Pointer to BMP file
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  int32_t  ret = UTIL_LCD_DL_ERROR;
+  uint32_t index, width, height, top_down;
+
+  (void)Instance;
+
+  if (DL_BmpHeader(pBmp, &index, &width, &height, &top_down) != 0U)
+  {
+    ret = DL_Record(DL_OP_BITMAP, Xpos, Ypos, width, height, 0U, pBmp);
+  }
+  else if (DlRecord != NULL)
+  {
+    /* Only RGB565 bitmaps can be clipped and cached */
+    DlRecord->Error = 1U;
+  }
+  else
+  {
+    /* Not recording */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Record a RGB565 buffer copied in a rectangle. The pixels are
+  *         stored run length encoded.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pData    Pointer on RGB565 pixels buffer
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  (void)Instance;
+
+  return DL_Record(DL_OP_RGB_RECT, Xpos, Ypos, Width, Height, 0U, pData);
+}
+
+/**
+  * @brief  Record an horizontal line.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    RGB565 color of the line
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+
+  return DL_Record(DL_OP_HLINE, Xpos, Ypos, Length, 1U, Color, NULL);
+}
+
+/**
+  * @brief  Record a vertical line.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    RGB565 color of the line
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  (void)Instance;
+
+  return DL_Record(DL_OP_VLINE, Xpos, Ypos, 1U, Length, Color, NULL);
+}
+
+/**
+  * @brief  Record a filled rectangle.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @param  Color    RGB565 color of the rectangle
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  (void)Instance;
+
+  return DL_Record(DL_OP_FILL_RECT, Xpos, Ypos, Width, Height, Color, NULL);
+}
+
+/**
+  * @brief  Pixels cannot be read back while recording.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    Pixel color
+  * @retval UTIL_LCD_DL_ERROR
+  */
+int32_t UTIL_LCD_DL_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  (void)Instance;
+  (void)Xpos;
+  (void)Ypos;
+
+  *Color = 0U;
+
+  return UTIL_LCD_DL_ERROR;
+}
+
+/**
+  * @brief  Record a pixel.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    RGB565 pixel color
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  (void)Instance;
+
+  return DL_Record(DL_OP_PIXEL, Xpos, Ypos, 1U, 1U, Color, NULL);
+}
+
+/**
+  * @brief  Get the X size of the display recorded.
+  * @param  Instance LCD Instance
+  * @param  XSize    X size in pixels
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  int32_t ret = UTIL_LCD_DL_OK;
+
+  (void)Instance;
+
+  if (DlRecord != NULL)
+  {
+    *XSize = DlRecord->Width;
+  }
+  else
+  {
+    *XSize = 0U;
+    ret    = UTIL_LCD_DL_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the Y size of the display recorded.
+  * @param  Instance LCD Instance
+  * @param  YSize    Y size in pixels
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  int32_t ret = UTIL_LCD_DL_OK;
+
+  (void)Instance;
+
+  if (DlRecord != NULL)
+  {
+    *YSize = DlRecord->Height;
+  }
+  else
+  {
+    *YSize = 0U;
+    ret    = UTIL_LCD_DL_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Set the layer recorded.
+  * @param  Instance LCD Instance
+  * @param  Layer    Layer
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  /* Single layer recording: nothing to do */
+  (void)Instance;
+  (void)Layer;
+
+  return UTIL_LCD_DL_OK;
+}
+
+/**
+  * @brief  Get the pixel format recorded.
+  * @param  Instance LCD Instance
+  * @param  Format   Pixel format
+  * @retval UTIL_LCD_DL status
+  */
+int32_t UTIL_LCD_DL_GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  (void)Instance;
+
+  *Format = LCD_PIXEL_FORMAT_RGB565;
+
+  return UTIL_LCD_DL_OK;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Private_Functions STM32 LCD Display List Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Intersect a box with another one.
+  * @param  pBox   Box, updated
+  * @param  pOther Other box
+  * @retval 1 if the intersection is not empty, 0 otherwise
+  */
+static uint32_t DL_Intersect(DL_Box_t *pBox, const DL_Box_t *pOther)
+{
+  pBox->X0 = MAX(pBox->X0, pOther->X0);
+  pBox->Y0 = MAX(pBox->Y0, pOther->Y0);
+  pBox->X1 = MIN(pBox->X1, pOther->X1);
+  pBox->Y1 = MIN(pBox->Y1, pOther->Y1);
+
+  return ((pBox->X0 < pBox->X1) && (pBox->Y0 < pBox->Y1)) ? 1U : 0U;
+}
+
+/**
+  * @brief  Extend a box to contain another one.
+  * @param  pBox   Box, updated
+  * @param  pOther Other box
+  */
+static void DL_Union(DL_Box_t *pBox, const DL_Box_t *pOther)
+{
+  pBox->X0 = MIN(pBox->X0, pOther->X0);
+  pBox->Y0 = MIN(pBox->Y0, pOther->Y0);
+  pBox->X1 = MAX(pBox->X1, pOther->X1);
+  pBox->Y1 = MAX(pBox->Y1, pOther->Y1);
+}
+
+/**
+  * @brief  Get the area of a box.
+  * @param  pBox Box
+  * @retval Area in pixels
+  */
+static uint32_t DL_Area(const DL_Box_t *pBox)
+{
+  return (pBox->X1 - pBox->X0) * (pBox->Y1 - pBox->Y0);
+}
+
+/**
+  * @brief  Convert a rectangle to a box.
+  * @param  pRect Rectangle
+  * @param  pBox  Box
+  */
+static void DL_RectToBox(const UTIL_LCD_DL_Rect_t *pRect, DL_Box_t *pBox)
+{
+  pBox->X0 = pRect->Xpos;
+  pBox->Y0 = pRect->Ypos;
+  pBox->X1 = pRect->Xpos + pRect->Width;
+  pBox->Y1 = pRect->Ypos + pRect->Height;
+}
+
+/**
+  * @brief  Convert a box to a rectangle.
+  * @param  pBox  Box
+  * @param  pRect Rectangle
+  */
+static void DL_BoxToRect(const DL_Box_t *pBox, UTIL_LCD_DL_Rect_t *pRect)
+{
+  pRect->Xpos   = pBox->X0;
+  pRect->Ypos   = pBox->Y0;
+  pRect->Width  = pBox->X1 - pBox->X0;
+  pRect->Height = pBox->Y1 - pBox->Y0;
+}
+
+/**
+  * @brief  Parse the header of a RGB565 BMP file.
+  * @param  pBmp     Pointer to BMP file
+  * @param  pIndex   Pixel data offset
+  * @param  pWidth   Image width
+  * @param  pHeight  Image height
+  * @param  pTopDown 1 if rows are stored from the top of the image
+  * @retval 1 for a 16 bpp bitmap, 0 otherwise
+  */
+static uint32_t DL_BmpHeader(const uint8_t *pBmp, uint32_t *pIndex, uint32_t *pWidth, uint32_t *pHeight, uint32_t *pTopDown)
+{
+  uint32_t height;
+
+  *pIndex   = DL_GET32(&pBmp[10]);
+  *pWidth   = DL_GET32(&pBmp[18]);
+  height    = DL_GET32(&pBmp[22]);
+  *pTopDown = 0U;
+  if ((height & 0x80000000U) != 0U)
+  {
+    height    = (uint32_t)(-(int32_t)height);
+    *pTopDown = 1U;
+  }
+  *pHeight  = height;
+
+  return (DL_GET16(&pBmp[28]) == 16U) ? 1U : 0U;
+}
+
+/**
+  * @brief  Append bytes to the list being recorded.
+  * @param  pData  Bytes
+  * @param  Length Number of bytes
+  * @retval 1 if appended, 0 if the buffer is full
+  */
+static uint32_t DL_Put(const uint8_t *pData, uint32_t Length)
+{
+  uint32_t ret = 0U;
+
+  if (Length <= (DlRecord->Size - DlRecord->Length))
+  {
+    (void)memcpy(&DlRecord->pBuffer[DlRecord->Length], pData, Length);
+    DlRecord->Length += Length;
+    ret = 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Record a command in the list being recorded.
+  * @param  Op     Command op code
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Width of the area drawn
+  * @param  Height Height of the area drawn
+  * @param  Color  RGB565 color
+  * @param  pData  RGB565 pixels or BMP file
+  * @retval UTIL_LCD_DL status
+  */
+static int32_t DL_Record(uint32_t Op, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color,
+                         const uint8_t *pData)
+{
+  int32_t  ret = UTIL_LCD_DL_OK;
+  uint8_t  header[DL_HEADER_MAX];
+  uint32_t fields[5];
+  uint32_t count = 0U, length, start, size, i;
+  DL_Box_t box, display;
+
+  if (DlRecord == NULL)
+  {
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else if (DlRecord->Error != 0U)
+  {
+    /* List is already incomplete */
+    ret = UTIL_LCD_DL_ERROR;
+  }
+  else if ((Width == 0U) || (Height == 0U))
+  {
+    /* Nothing drawn */
+  }
+  else
+  {
+    fields[count++] = Xpos;
+    fields[count++] = Ypos;
+    if (Op != DL_OP_PIXEL)
+    {
+      fields[count++] = (Op == DL_OP_VLINE) ? Height : Width;
+    }
+    if ((Op == DL_OP_FILL_RECT) || (Op == DL_OP_RGB_RECT) || (Op == DL_OP_BITMAP))
+    {
+      fields[count++] = Height;
+    }
+    if ((Op != DL_OP_RGB_RECT) && (Op != DL_OP_BITMAP))
+    {
+      fields[count++] = Color & 0xFFFFU;
+    }
+
+    header[0] = (uint8_t)Op;
+    length    = 1U;
+    for (i = 0U; i < count; i++)
+    {
+      if (fields[i] > 0xFFFFU)
+      {
+        ret = UTIL_LCD_DL_ERROR;
+      }
+      header[length++] = (uint8_t)fields[i];
+      header[length++] = (uint8_t)(fields[i] >> 8);
+    }
+    if (Op == DL_OP_BITMAP)
+    {
+      (void)memcpy(&header[length], (const void *)&pData, sizeof(pData));
+      length += sizeof(uint8_t *);
+    }
+    else if (Op == DL_OP_RGB_RECT)
+    {
+      /* RLE size, set once encoded */
+      length += 4U;
+    }
+    else
+    {
+      /* No payload */
+    }
+
+    start = DlRecord->Length;
+    if ((ret != UTIL_LCD_DL_OK) || (DL_Put(header, length) == 0U))
+    {
+      ret = UTIL_LCD_DL_ERROR;
+    }
+    else if ((Op == DL_OP_RGB_RECT) && (DL_Encode(pData, Width * Height) == 0U))
+    {
+      ret = UTIL_LCD_DL_ERROR;
+    }
+    else
+    {
+      if (Op == DL_OP_RGB_RECT)
+      {
+        size = DlRecord->Length - (start + length);
+        DlRecord->pBuffer[start + length - 4U] = (uint8_t)size;
+        DlRecord->pBuffer[start + length - 3U] = (uint8_t)(size >> 8);
+        DlRecord->pBuffer[start + length - 2U] = (uint8_t)(size >> 16);
+        DlRecord->pBuffer[start + length - 1U] = (uint8_t)(size >> 24);
+      }
+
+      /* Extend the bounding box with the area drawn on the display */
+      box.X0 = Xpos;
+      box.Y0 = Ypos;
+      box.X1 = Xpos + Width;
+      box.Y1 = Ypos + Height;
+      display.X0 = 0U;
+      display.Y0 = 0U;
+      display.X1 = DlRecord->Width;
+      display.Y1 = DlRecord->Height;
+      if (DL_Intersect(&box, &display) != 0U)
+      {
+        if ((DlRecord->Bounds.Width == 0U) || (DlRecord->Bounds.Height == 0U))
+        {
+          DL_BoxToRect(&box, &DlRecord->Bounds);
+        }
+        else
+        {
+          DL_RectToBox(&DlRecord->Bounds, &display);
+          DL_Union(&display, &box);
+          DL_BoxToRect(&display, &DlRecord->Bounds);
+        }
+      }
+      DlRecord->Count++;
+    }
+
+    if (ret != UTIL_LCD_DL_OK)
+    {
+      /* Drop the partial command */
+      DlRecord->Length = start;
+      DlRecord->Error  = 1U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Append RGB565 pixels run length encoded to the list being recorded.
+  * @param  pData  RGB565 pixels
+  * @param  Length Number of pixels
+  * @retval 1 if appended, 0 if the buffer is full
+  */
+static uint32_t DL_Encode(const uint8_t *pData, uint32_t Length)
+{
+  uint32_t ret = 1U;
+  uint32_t i = 0U, run;
+  uint8_t  control;
+
+  while ((i < Length) && (ret != 0U))
+  {
+    /* Identical pixels from i */
+    run = 1U;
+    while (((i + run) < Length) && (run < DL_RLE_MAX_RUN) &&
+           (DL_GET16(&pData[2U * (i + run)]) == DL_GET16(&pData[2U * i])))
+    {
+      run++;
+    }
+
+    if (run > 1U)
+    {
+      control = (uint8_t)(DL_RLE_REPEAT | (run - 1U));
+      ret     = DL_Put(&control, 1U) & DL_Put(&pData[2U * i], 2U);
+    }
+    else
+    {
+      /* Literal pixels up to the next repeated one */
+      while (((i + run) < Length) && (run < DL_RLE_MAX_RUN) &&
+             (((i + run + 1U) >= Length) ||
+              (DL_GET16(&pData[2U * (i + run)]) != DL_GET16(&pData[2U * (i + run + 1U)]))))
+      {
+        run++;
+      }
+      control = (uint8_t)(run - 1U);
+      ret     = DL_Put(&control, 1U) & DL_Put(&pData[2U * i], 2U * run);
+    }
+    i += run;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Decode a command.
+  * @param  pList  Display list
+  * @param  Offset Offset of the command
+  * @param  pCmd   Decoded command
+  * @retval Offset of the next command
+  */
+static uint32_t DL_Decode(const UTIL_LCD_DL_t *pList, uint32_t Offset, DL_Cmd_t *pCmd)
+{
+  const uint8_t *p = &pList->pBuffer[Offset];
+  uint32_t       x = DL_GET16(&p[1]);
+  uint32_t       y = DL_GET16(&p[3]);
+  uint32_t       w = 1U, h = 1U;
+  uint32_t       length;
+
+  pCmd->Op    = p[0];
+  pCmd->Color = 0U;
+  pCmd->pData = NULL;
+
+  switch (pCmd->Op)
+  {
+    case DL_OP_FILL_RECT:
+      w = DL_GET16(&p[5]);
+      h = DL_GET16(&p[7]);
+      pCmd->Color = DL_GET16(&p[9]);
+      length = 11U;
+      break;
+
+    case DL_OP_HLINE:
+      w = DL_GET16(&p[5]);
+      pCmd->Color = DL_GET16(&p[7]);
+      length = 9U;
+      break;
+
+    case DL_OP_VLINE:
+      h = DL_GET16(&p[5]);
+      pCmd->Color = DL_GET16(&p[7]);
+      length = 9U;
+      break;
+
+    case DL_OP_PIXEL:
+      pCmd->Color = DL_GET16(&p[5]);
+      length = 7U;
+      break;
+
+    case DL_OP_RGB_RECT:
+      w = DL_GET16(&p[5]);
+      h = DL_GET16(&p[7]);
+      pCmd->pData = &p[13];
+      length = 13U + DL_GET32(&p[9]);
+      break;
+
+    case DL_OP_BITMAP:
+    default:
+      w = DL_GET16(&p[5]);
+      h = DL_GET16(&p[7]);
+      (void)memcpy((void *)&pCmd->pData, &p[9], sizeof(pCmd->pData));
+      length = 9U + sizeof(uint8_t *);
+      break;
+  }
+
+  pCmd->Box.X0 = x;
+  pCmd->Box.Y0 = y;
+  pCmd->Box.X1 = x + w;
+  pCmd->Box.Y1 = y + h;
+  pCmd->Next   = Offset + length;
+
+  return pCmd->Next;
+}
+
+/**
+  * @brief  Prepare the reading of the pixels of a RGB rectangle or bitmap
+  *         command.
+  * @param  pSrc Pixel source
+  * @param  pCmd Command
+  */
+static void DL_SourceInit(DL_Source_t *pSrc, const DL_Cmd_t *pCmd)
+{
+  uint32_t width;
+
+  pSrc->pCmd   = pCmd;
+  pSrc->pRle   = pCmd->pData;
+  pSrc->Pos    = 0U;
+  pSrc->Left   = 0U;
+  pSrc->Repeat = 0U;
+  pSrc->Color  = 0U;
+  if (pCmd->Op == DL_OP_BITMAP)
+  {
+    (void)DL_BmpHeader(pCmd->pData, &pSrc->Index, &width, &pSrc->Height, &pSrc->TopDown);
+    /* BMP rows are padded to 32-bit */
+    pSrc->Stride = ((width * 2U) + 3U) & ~3U;
+  }
+}
+
+/**
+  * @brief  Read pixels of a RGB rectangle or bitmap command. RGB rectangle
+  *         pixels are read in increasing order.
+  * @param  pSrc   Pixel source
+  * @param  Row    Row in the command area
+  * @param  Column First column in the command area
+  * @param  pDst   RGB565 pixels read
+  * @param  Length Number of pixels
+  */
+static void DL_SourceRead(DL_Source_t *pSrc, uint32_t Row, uint32_t Column, uint16_t *pDst, uint32_t Length)
+{
+  const uint8_t *src;
+  uint32_t       target, end, n, i;
+  uint32_t       done = 0U;
+
+  if (pSrc->pCmd->Op == DL_OP_BITMAP)
+  {
+    if (pSrc->TopDown == 0U)
+    {
+      Row = pSrc->Height - 1U - Row;
+    }
+    src = &pSrc->pCmd->pData[pSrc->Index + (Row * pSrc->Stride) + (2U * Column)];
+    for (i = 0U; i < Length; i++)
+    {
+      pDst[i] = (uint16_t)DL_GET16(&src[2U * i]);
+    }
+  }
+  else
+  {
+    target = (Row * (pSrc->pCmd->Box.X1 - pSrc->pCmd->Box.X0)) + Column;
+    end    = target + Length;
+    while (pSrc->Pos < end)
+    {
+      if (pSrc->Left == 0U)
+      {
+        /* Next run */
+        if ((pSrc->pRle[0] & DL_RLE_REPEAT) != 0U)
+        {
+          pSrc->Repeat = 1U;
+          pSrc->Left   = ((uint32_t)pSrc->pRle[0] & 0x7FU) + 1U;
+          pSrc->Color  = (uint16_t)DL_GET16(&pSrc->pRle[1]);
+          pSrc->pRle   = &pSrc->pRle[3];
+        }
+        else
+        {
+          pSrc->Repeat = 0U;
+          pSrc->Left   = (uint32_t)pSrc->pRle[0] + 1U;
+          pSrc->pRle   = &pSrc->pRle[1];
+        }
+      }
+
+      if (pSrc->Pos < target)
+      {
+        /* Skip pixels before the ones read */
+        n = MIN(pSrc->Left, target - pSrc->Pos);
+      }
+      else
+      {
+        n = MIN(pSrc->Left, end - pSrc->Pos);
+        for (i = 0U; i < n; i++)
+        {
+          pDst[done + i] = (pSrc->Repeat != 0U) ? pSrc->Color : (uint16_t)DL_GET16(&pSrc->pRle[2U * i]);
+        }
+        done += n;
+      }
+
+      if (pSrc->Repeat == 0U)
+      {
+        pSrc->pRle = &pSrc->pRle[2U * n];
+      }
+      pSrc->Left -= n;
+      pSrc->Pos  += n;
+    }
+  }
+}
+
+/**
+  * @brief  Draw the pixels of a RGB rectangle or bitmap command in a box, as
+  *         RGB rectangles of up to UTIL_LCD_DL_PIXEL_BUFFER_SIZE pixels.
+  * @param  pCmd     Command
+  * @param  pBox     Box drawn, inside the command area
+  * @param  pDrv     Driver
+  * @param  Instance Driver instance
+  * @retval UTIL_LCD_DL status
+  */
+static int32_t DL_DrawPixels(const DL_Cmd_t *pCmd, const DL_Box_t *pBox, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance)
+{
+  int32_t     ret = UTIL_LCD_DL_OK;
+  uint32_t    width  = pBox->X1 - pBox->X0;
+  uint32_t    height = pBox->Y1 - pBox->Y0;
+  uint32_t    chunk  = MIN(width, UTIL_LCD_DL_PIXEL_BUFFER_SIZE);
+  uint32_t    rows   = UTIL_LCD_DL_PIXEL_BUFFER_SIZE / chunk;
+  uint32_t    x, y, w, h, i;
+  DL_Source_t src;
+
+  DL_SourceInit(&src, pCmd);
+
+  for (y = 0U; y < height; y += h)
+  {
+    h = MIN(rows, height - y);
+    for (x = 0U; x < width; x += w)
+    {
+      w = MIN(chunk, width - x);
+      for (i = 0U; i < h; i++)
+      {
+        DL_SourceRead(&src, (pBox->Y0 - pCmd->Box.Y0) + y + i, (pBox->X0 - pCmd->Box.X0) + x, &DlPixels[i * w], w);
+      }
+      if (pDrv->FillRGBRect(Instance, pBox->X0 + x, pBox->Y0 + y, (uint8_t *)DlPixels, w, h) != 0)
+      {
+        ret = UTIL_LCD_DL_ERROR;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Execute a command clipped to a box.
+  * @param  pCmd     Command
+  * @param  pClip    Clipping box
+  * @param  pDrv     Driver
+  * @param  Instance Driver instance
+  * @retval UTIL_LCD_DL status
+  */
+static int32_t DL_Draw(const DL_Cmd_t *pCmd, const DL_Box_t *pClip, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance)
+{
+  int32_t  status = 0;
+  DL_Box_t box = pCmd->Box;
+
+  if (DL_Intersect(&box, pClip) != 0U)
+  {
+    switch (pCmd->Op)
+    {
+      case DL_OP_FILL_RECT:
+        status = pDrv->FillRect(Instance, box.X0, box.Y0, box.X1 - box.X0, box.Y1 - box.Y0, pCmd->Color);
+        break;
+
+      case DL_OP_HLINE:
+        status = pDrv->DrawHLine(Instance, box.X0, box.Y0, box.X1 - box.X0, pCmd->Color);
+        break;
+
+      case DL_OP_VLINE:
+        status = pDrv->DrawVLine(Instance, box.X0, box.Y0, box.Y1 - box.Y0, pCmd->Color);
+        break;
+
+      case DL_OP_PIXEL:
+        status = pDrv->SetPixel(Instance, box.X0, box.Y0, pCmd->Color);
+        break;
+
+      case DL_OP_BITMAP:
+        if (memcmp(&box, &pCmd->Box, sizeof(DL_Box_t)) == 0)
+        {
+          /* Whole bitmap: let the driver handle it */
+          status = pDrv->DrawBitmap(Instance, box.X0, box.Y0, (uint8_t *)pCmd->pData);
+        }
+        else
+        {
+          status = DL_DrawPixels(pCmd, &box, pDrv, Instance);
+        }
+        break;
+
+      case DL_OP_RGB_RECT:
+      default:
+        status = DL_DrawPixels(pCmd, &box, pDrv, Instance);
+        break;
+    }
+  }
+
+  return (status == 0) ? UTIL_LCD_DL_OK : UTIL_LCD_DL_ERROR;
+}
+
+/**
+  * @brief  Replay a display list from its cache.
+  * @param  pList    Display list
+  * @param  pClip    Clipping box
+  * @param  pDrv     Driver
+  * @param  Instance Driver instance
+  * @retval UTIL_LCD_DL status
+  */
+static int32_t DL_ReplayCache(const UTIL_LCD_DL_t *pList, const DL_Box_t *pClip, const LCD_UTILS_Drv_t *pDrv,
+                              uint32_t Instance)
+{
+  int32_t   status = 0;
+  uint32_t  width = pList->Bounds.Width;
+  uint32_t  x, y, start, pos;
+  DL_Box_t  box;
+  uint16_t *row;
+
+  DL_RectToBox(&pList->Bounds, &box);
+
+  if (DL_Intersect(&box, pClip) == 0U)
+  {
+    /* Nothing cached in the clipping box */
+  }
+  else if ((pList->CacheFull != 0U) && ((box.X1 - box.X0) == width))
+  {
+    /* Whole rows of a fully covered area: a single rectangle */
+    row    = &pList->pCache[(box.Y0 - pList->Bounds.Ypos) * width];
+    status = pDrv->FillRGBRect(Instance, box.X0, box.Y0, (uint8_t *)row, width, box.Y1 - box.Y0);
+  }
+  else
+  {
+    /* One rectangle per run of covered pixels */
+    for (y = box.Y0; y < box.Y1; y++)
+    {
+      row = &pList->pCache[(y - pList->Bounds.Ypos) * width];
+      x   = box.X0;
+      while (x < box.X1)
+      {
+        pos = ((y - pList->Bounds.Ypos) * width) + (x - pList->Bounds.Xpos);
+        if ((pList->pCacheMask[pos / 8U] & (1U << (pos % 8U))) == 0U)
+        {
+          x++;
+        }
+        else
+        {
+          start = x;
+          while ((x < box.X1) && ((pList->pCacheMask[pos / 8U] & (1U << (pos % 8U))) != 0U))
+          {
+            x++;
+            pos++;
+          }
+          status |= pDrv->FillRGBRect(Instance, start, y, (uint8_t *)&row[start - pList->Bounds.Xpos], x - start, 1U);
+        }
+      }
+    }
+  }
+
+  return (status == 0) ? UTIL_LCD_DL_OK : UTIL_LCD_DL_ERROR;
+}
+
+/**
+  * @brief  Rasterize a command in the cache of a display list.
+  * @param  pList Display list
+  * @param  pCmd  Command
+  */
+static void DL_CacheCmd(const UTIL_LCD_DL_t *pList, const DL_Cmd_t *pCmd)
+{
+  uint32_t    width = pList->Bounds.Width;
+  uint32_t    x, y, pos;
+  uint16_t   *row;
+  DL_Box_t    box = pCmd->Box;
+  DL_Box_t    bounds;
+  DL_Source_t src;
+
+  DL_RectToBox(&pList->Bounds, &bounds);
+
+  if (DL_Intersect(&box, &bounds) != 0U)
+  {
+    DL_SourceInit(&src, pCmd);
+    for (y = box.Y0; y < box.Y1; y++)
+    {
+      row = &pList->pCache[((y - bounds.Y0) * width) + (box.X0 - bounds.X0)];
+      if ((pCmd->Op == DL_OP_RGB_RECT) || (pCmd->Op == DL_OP_BITMAP))
+      {
+        DL_SourceRead(&src, y - pCmd->Box.Y0, box.X0 - pCmd->Box.X0, row, box.X1 - box.X0);
+      }
+      else
+      {
+        for (x = 0U; x < (box.X1 - box.X0); x++)
+        {
+          row[x] = (uint16_t)pCmd->Color;
+        }
+      }
+      pos = ((y - bounds.Y0) * width) + (box.X0 - bounds.X0);
+      for (x = box.X0; x < box.X1; x++)
+      {
+        pList->pCacheMask[pos / 8U] |= (uint8_t)(1U << (pos % 8U));
+        pos++;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Add an area to a set of rectangles, merging it with the
+  *         rectangle it grows the least when the set is full.
+  * @param  pRects   Rectangles
+  * @param  pCount   Number of rectangles, updated
+  * @param  MaxRects Size of pRects
+  * @param  pBox     Area
+  */
+static void DL_AddRect(UTIL_LCD_DL_Rect_t *pRects, uint32_t *pCount, uint32_t MaxRects, const DL_Box_t *pBox)
+{
+  uint32_t i, growth;
+  uint32_t best = 0U, best_growth = 0xFFFFFFFFU;
+  DL_Box_t box;
+
+  for (i = 0U; i < *pCount; i++)
+  {
+    DL_RectToBox(&pRects[i], &box);
+    growth = DL_Area(&box);
+    DL_Union(&box, pBox);
+    growth = DL_Area(&box) - growth;
+    if (growth < best_growth)
+    {
+      best        = i;
+      best_growth = growth;
+    }
+  }
+
+  if ((best_growth == 0U) || (*pCount == MaxRects))
+  {
+    /* Already covered, or no room left */
+    DL_RectToBox(&pRects[best], &box);
+    DL_Union(&box, pBox);
+    DL_BoxToRect(&box, &pRects[best]);
+  }
+  else
+  {
+    DL_BoxToRect(pBox, &pRects[*pCount]);
+    (*pCount)++;
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
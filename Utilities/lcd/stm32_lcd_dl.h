@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_dl.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_dl.c display list recorder.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_DL_H
+#define STM32_LCD_DL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "lcd.h"
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_DL STM32 LCD Display List Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_DL_Exported_Constants STM32 LCD Display List Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_DL_OK                0
+#define UTIL_LCD_DL_ERROR           (-1)
+
+/**
+  * @brief  Number of RGB565 pixels decoded at once when replaying recorded
+  *         RGB rectangles and clipped bitmaps
+  */
+#ifndef UTIL_LCD_DL_PIXEL_BUFFER_SIZE
+  #define UTIL_LCD_DL_PIXEL_BUFFER_SIZE  2048U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Exported_Types STM32 LCD Display List Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Display list rectangle
+  */
+typedef struct
+{
+  uint32_t Xpos;
+  uint32_t Ypos;
+  uint32_t Width;
+  uint32_t Height;
+} UTIL_LCD_DL_Rect_t;
+
+/**
+  * @brief  Display list. Fields are maintained by the UTIL_LCD_DL services.
+  */
+typedef struct
+{
+  uint8_t            *pBuffer;    /*!< Command buffer                                  */
+  uint32_t            Size;       /*!< Command buffer size in bytes                    */
+  uint32_t            Length;     /*!< Bytes recorded                                  */
+  uint32_t            Count;      /*!< Commands recorded                               */
+  uint32_t            Width;      /*!< Display width reported while recording          */
+  uint32_t            Height;     /*!< Display height reported while recording         */
+  uint32_t            Error;      /*!< A command could not be recorded                 */
+  UTIL_LCD_DL_Rect_t  Bounds;     /*!< Display area drawn by the commands              */
+  uint16_t           *pCache;     /*!< Rasterized Bounds, NULL when not cached         */
+  uint8_t            *pCacheMask; /*!< Pixels of Bounds drawn by the commands, 1 bit each */
+  uint32_t            CacheFull;  /*!< Every pixel of Bounds is drawn                  */
+} UTIL_LCD_DL_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_DL_Exported_Variables STM32 LCD Display List Utility Exported Variables
+  * @{
+  */
+extern const LCD_UTILS_Drv_t UTIL_LCD_DL_Driver;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_DL_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_LCD_DL_Init(UTIL_LCD_DL_t *pList, uint8_t *pBuffer, uint32_t Size, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_DL_Begin(UTIL_LCD_DL_t *pList);
+int32_t  UTIL_LCD_DL_End(void);
+int32_t  UTIL_LCD_DL_Replay(const UTIL_LCD_DL_t *pList, const LCD_UTILS_Drv_t *pDrv, uint32_t Instance,
+                            const UTIL_LCD_DL_Rect_t *pClip);
+uint32_t UTIL_LCD_DL_Diff(const UTIL_LCD_DL_t *pOld, const UTIL_LCD_DL_t *pNew, UTIL_LCD_DL_Rect_t *pRects,
+                          uint32_t MaxRects);
+uint32_t UTIL_LCD_DL_GetCacheSize(const UTIL_LCD_DL_t *pList);
+int32_t  UTIL_LCD_DL_Cache(UTIL_LCD_DL_t *pList, uint8_t *pCache, uint32_t Size);
+void     UTIL_LCD_DL_Uncache(UTIL_LCD_DL_t *pList);
+
+/* LCD_UTILS_Drv_t interface, recording in the list selected by UTIL_LCD_DL_Begin() */
+int32_t  UTIL_LCD_DL_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
+int32_t  UTIL_LCD_DL_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_DL_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_DL_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_DL_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+int32_t  UTIL_LCD_DL_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
+int32_t  UTIL_LCD_DL_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
+int32_t  UTIL_LCD_DL_GetXSize(uint32_t Instance, uint32_t *XSize);
+int32_t  UTIL_LCD_DL_GetYSize(uint32_t Instance, uint32_t *YSize);
+int32_t  UTIL_LCD_DL_SetLayer(uint32_t Instance, uint32_t Layer);
+int32_t  UTIL_LCD_DL_GetFormat(uint32_t Instance, uint32_t *Format);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_DL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,1110 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_fb.c
+  * @author  MCD Application Team
+  * @brief   This file includes an off-screen RGB565 frame buffer driver for the
+  *          STM32 LCD utility, with dirty rectangle tracking.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver renders the STM32 LCD utility primitives into a RAM buffer
+     instead of sending every pixel to the panel. Touched areas are recorded
+     as dirty rectangles, merged together when it saves bus commands, and
+     sent to the panel by UTIL_LCD_FB_Flush() with one window per region.
+
+   - Fill a UTIL_LCD_FB_Init_t structure with:
+         pBuffer    : RGB565 buffer of Width x BandHeight pixels
+         BandHeight : Height for a full frame buffer, or a smaller number of
+                      rows for a banded buffer
+         pTarget    : flush target providing SetWindow/WritePixels
+     then call:
+         UTIL_LCD_FB_Init()
+         UTIL_LCD_SetFuncDriver(&UTIL_LCD_FB_Driver)
+
+   - Draw with the UTIL_LCD_* services and call UTIL_LCD_FB_Flush() once per
+     frame. With a banded buffer, select each band with UTIL_LCD_FB_SetBand(),
+     redraw the scene (primitives are clipped to the band) and flush it.
+
+   - The frame buffer content can be composited with ARGB8888 sources, without
+     reading pixels back from the panel:
+         UTIL_LCD_FB_BlendRect()   : translucent color over a rectangle
+         UTIL_LCD_FB_BlendBitmap() : ARGB8888 image with per-pixel alpha
+         UTIL_LCD_FB_BlendMask()   : color through an A8 coverage mask
+     Alpha is quantized to 33 levels and blending is done on RGB565 fields
+     spread in 32-bit words, two pixels per word for uniform alpha.
+
+   - UTIL_LCD_FB_MemTarget is a flush target writing into a RAM image. It lets
+     the rendering and the number of target commands be checked on a host:
+         UTIL_LCD_FB_MemTargetInit()
+         UTIL_LCD_FB_MemTargetGetStats()
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_fb.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_FB STM32 LCD Frame Buffer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_FB_Private_Macros STM32 LCD Frame Buffer Utility Private Macros
+  * @{
+  */
+#define FB_ARGB8888_TO_RGB565(Color) ((((Color) >> 8) & 0xF800U) | (((Color) >> 5) & 0x07E0U) | (((Color) >> 3) & 0x001FU))
+
+/* 8-bit alpha to the 0..32 range used by the blending */
+#define FB_ALPHA5(Alpha)             ((((uint32_t)(Alpha)) + 4U) >> 3)
+
+/* RGB565 fields spread with 5 free bits above each of them: one pixel
+   (G moved to the upper half word), or B and R of the low pixel with G of
+   the high pixel of a pixel pair */
+#define FB_SPREAD_MASK               0x07E0F81FU
+
+/* Other fields of a pixel pair shifted right by 5: G of the low pixel, B and
+   R of the high pixel */
+#define FB_SPREAD_MASK_ODD           0x07C0F83FU
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Private_Types STM32 LCD Frame Buffer Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t X0;  /* Left column                      */
+  uint32_t Y0;  /* Top row, relative to the band    */
+  uint32_t X1;  /* Right column (excluded)          */
+  uint32_t Y1;  /* Bottom row (excluded)            */
+} FB_Box_t;
+
+typedef struct
+{
+  uint16_t                   *pBuffer;
+  uint32_t                    Width;
+  uint32_t                    Height;
+  uint32_t                    BandHeight;
+  uint32_t                    BandYpos;
+  uint32_t                    Instance;
+  const UTIL_LCD_FB_Target_t *pTarget;
+  FB_Box_t                    Dirty[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+  uint32_t                    DirtyNbr;
+  UTIL_LCD_FB_Stats_t         Stats;
+} FB_Ctx_t;
+
+typedef struct
+{
+  uint16_t            *pImage;
+  uint32_t             Width;
+  uint32_t             Height;
+  uint32_t             WinXpos;
+  uint32_t             WinYpos;
+  uint32_t             WinWidth;
+  uint32_t             WinHeight;
+  uint32_t             Cursor;
+  UTIL_LCD_FB_Stats_t  Stats;
+} FB_MemCtx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Private_FunctionPrototypes STM32 LCD Frame Buffer Utility Private FunctionPrototypes
+  * @{
+  */
+static uint32_t FB_Clip(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height);
+static uint32_t FB_Area(const FB_Box_t *Box);
+static void     FB_Union(FB_Box_t *Box, const FB_Box_t *Other);
+static void     FB_AddDirty(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static int32_t  FB_MemSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static int32_t  FB_MemWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length);
+static uint16_t FB_BlendPixel(uint32_t Bg, uint32_t Fg, uint32_t Alpha);
+static void     FB_BlendRow(uint16_t *pDst, uint32_t Length, uint32_t Fg, uint32_t Alpha);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Private_Variables STM32 LCD Frame Buffer Utility Private Variables
+  * @{
+  */
+static FB_Ctx_t    FbCtx;
+static FB_MemCtx_t FbMemCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Exported_Variables STM32 LCD Frame Buffer Utility Exported Variables
+  * @{
+  */
+const LCD_UTILS_Drv_t UTIL_LCD_FB_Driver =
+{
+  UTIL_LCD_FB_DrawBitmap,
+  UTIL_LCD_FB_FillRGBRect,
+  UTIL_LCD_FB_DrawHLine,
+  UTIL_LCD_FB_DrawVLine,
+  UTIL_LCD_FB_FillRect,
+  UTIL_LCD_FB_GetPixel,
+  UTIL_LCD_FB_SetPixel,
+  UTIL_LCD_FB_GetXSize,
+  UTIL_LCD_FB_GetYSize,
+  UTIL_LCD_FB_SetLayer,
+  UTIL_LCD_FB_GetFormat
+};
+
+const UTIL_LCD_FB_Target_t UTIL_LCD_FB_MemTarget =
+{
+  FB_MemSetWindow,
+  FB_MemWritePixels
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Exported_Functions STM32 LCD Frame Buffer Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the frame buffer.
+  * @param  pInit Frame buffer configuration
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_Init(const UTIL_LCD_FB_Init_t *pInit)
+{
+  int32_t ret = UTIL_LCD_FB_OK;
+
+  if ((pInit == NULL) || (pInit->pBuffer == NULL) || (pInit->Width == 0U) || (pInit->Height == 0U) ||
+      (pInit->BandHeight == 0U) || (pInit->BandHeight > pInit->Height))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    FbCtx.pBuffer    = pInit->pBuffer;
+    FbCtx.Width      = pInit->Width;
+    FbCtx.Height     = pInit->Height;
+    FbCtx.BandHeight = pInit->BandHeight;
+    FbCtx.BandYpos   = 0U;
+    FbCtx.Instance   = pInit->Instance;
+    FbCtx.pTarget    = pInit->pTarget;
+    FbCtx.DirtyNbr   = 0U;
+    UTIL_LCD_FB_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Select the display rows held by a banded frame buffer.
+  *         Pending dirty regions of the previous band are flushed first.
+  * @param  Ypos First display row of the band
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_SetBand(uint32_t Ypos)
+{
+  int32_t ret = UTIL_LCD_FB_OK;
+
+  if ((FbCtx.pBuffer == NULL) || (Ypos >= FbCtx.Height))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    if (FbCtx.DirtyNbr != 0U)
+    {
+      ret = UTIL_LCD_FB_Flush();
+    }
+    FbCtx.BandYpos = Ypos;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Mark a display area as dirty so that it is sent on next flush.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Area width
+  * @param  Height Area height
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_Invalidate(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  if (FB_Clip(&Xpos, &Ypos, &Width, &Height) != 0U)
+  {
+    FB_AddDirty(Xpos, Ypos, Width, Height);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Send the dirty regions of the frame buffer to the flush target.
+  *         Each region is sent in one window, full width regions in one write.
+  *         The regions are only cleared when all of them have been sent.
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_Flush(void)
+{
+  int32_t   ret = UTIL_LCD_FB_OK;
+  uint32_t  i, row;
+  uint32_t  width, height;
+  uint16_t *pixels;
+
+  if ((FbCtx.pBuffer == NULL) || (FbCtx.pTarget == NULL))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    for (i = 0U; (i < FbCtx.DirtyNbr) && (ret == UTIL_LCD_FB_OK); i++)
+    {
+      width  = FbCtx.Dirty[i].X1 - FbCtx.Dirty[i].X0;
+      height = FbCtx.Dirty[i].Y1 - FbCtx.Dirty[i].Y0;
+      pixels = &FbCtx.pBuffer[(FbCtx.Dirty[i].Y0 * FbCtx.Width) + FbCtx.Dirty[i].X0];
+
+      if (FbCtx.pTarget->SetWindow(FbCtx.Instance, FbCtx.Dirty[i].X0, FbCtx.BandYpos + FbCtx.Dirty[i].Y0,
+                                   width, height) != 0)
+      {
+        ret = UTIL_LCD_FB_ERROR;
+      }
+      else if (width == FbCtx.Width)
+      {
+        /* Rows are contiguous in the buffer: send the region at once */
+        if (FbCtx.pTarget->WritePixels(FbCtx.Instance, (uint8_t *)pixels, width * height) != 0)
+        {
+          ret = UTIL_LCD_FB_ERROR;
+        }
+        FbCtx.Stats.WriteCount++;
+      }
+      else
+      {
+        for (row = 0U; (row < height) && (ret == UTIL_LCD_FB_OK); row++)
+        {
+          if (FbCtx.pTarget->WritePixels(FbCtx.Instance, (uint8_t *)pixels, width) != 0)
+          {
+            ret = UTIL_LCD_FB_ERROR;
+          }
+          pixels += FbCtx.Width;
+          FbCtx.Stats.WriteCount++;
+        }
+      }
+
+      FbCtx.Stats.RegionCount++;
+      FbCtx.Stats.PixelCount += width * height;
+    }
+
+    /* On error the regions stay pending, to be sent again by the next flush */
+    if (ret == UTIL_LCD_FB_OK)
+    {
+      FbCtx.DirtyNbr = 0U;
+    }
+    FbCtx.Stats.FlushCount++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the pending dirty regions in display coordinates.
+  * @param  pRects   Array receiving the regions
+  * @param  MaxRects Size of pRects array
+  * @retval Number of pending dirty regions
+  */
+uint32_t UTIL_LCD_FB_GetDirtyRects(UTIL_LCD_FB_Rect_t *pRects, uint32_t MaxRects)
+{
+  uint32_t i;
+
+  for (i = 0U; (i < FbCtx.DirtyNbr) && (i < MaxRects) && (pRects != NULL); i++)
+  {
+    pRects[i].Xpos   = FbCtx.Dirty[i].X0;
+    pRects[i].Ypos   = FbCtx.BandYpos + FbCtx.Dirty[i].Y0;
+    pRects[i].Width  = FbCtx.Dirty[i].X1 - FbCtx.Dirty[i].X0;
+    pRects[i].Height = FbCtx.Dirty[i].Y1 - FbCtx.Dirty[i].Y0;
+  }
+
+  return FbCtx.DirtyNbr;
+}
+
+/**
+  * @brief  Get the flush statistics.
+  * @param  pStats Pointer to statistics structure
+  */
+void UTIL_LCD_FB_GetStats(UTIL_LCD_FB_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = FbCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the flush statistics.
+  */
+void UTIL_LCD_FB_ResetStats(void)
+{
+  FbCtx.Stats.FlushCount  = 0U;
+  FbCtx.Stats.RegionCount = 0U;
+  FbCtx.Stats.WriteCount  = 0U;
+  FbCtx.Stats.PixelCount  = 0U;
+}
+
+/**
+  * @brief  Blend a color over a rectangle of the frame buffer.
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @param  Color    ARGB8888 color, blended with its alpha
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_BlendRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  uint32_t  j;
+  uint32_t  alpha = FB_ALPHA5(Color >> 24);
+
+  if ((alpha != 0U) && (FB_Clip(&Xpos, &Ypos, &Width, &Height) != 0U))
+  {
+    for (j = 0U; j < Height; j++)
+    {
+      FB_BlendRow(&FbCtx.pBuffer[((Ypos + j) * FbCtx.Width) + Xpos], Width, FB_ARGB8888_TO_RGB565(Color), alpha);
+    }
+    FB_AddDirty(Xpos, Ypos, Width, Height);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Blend an ARGB8888 buffer with per-pixel alpha over a rectangle of
+  *         the frame buffer.
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pData    Pointer on ARGB8888 pixels buffer, 4 bytes per pixel in
+  *                  little endian order (B, G, R, A)
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_BlendBitmap(uint32_t Xpos, uint32_t Ypos, const uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  uint32_t       x = Xpos, y = Ypos, w = Width, h = Height;
+  uint32_t       i, j, color;
+  const uint8_t *src;
+  uint16_t      *dst;
+
+  if (FB_Clip(&x, &y, &w, &h) != 0U)
+  {
+    for (j = 0U; j < h; j++)
+    {
+      src = &pData[4U * ((((FbCtx.BandYpos + y + j) - Ypos) * Width) + (x - Xpos))];
+      dst = &FbCtx.pBuffer[((y + j) * FbCtx.Width) + x];
+      for (i = 0U; i < w; i++)
+      {
+        color = (uint32_t)src[4U * i] | ((uint32_t)src[(4U * i) + 1U] << 8) |
+                ((uint32_t)src[(4U * i) + 2U] << 16);
+        dst[i] = FB_BlendPixel(dst[i], FB_ARGB8888_TO_RGB565(color), FB_ALPHA5(src[(4U * i) + 3U]));
+      }
+    }
+    FB_AddDirty(x, y, w, h);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Blend a color through an A8 coverage mask over a rectangle of the
+  *         frame buffer, typically for anti-aliased glyphs.
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pMask    Pointer on the mask, one coverage byte per pixel
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @param  Color    ARGB8888 color, its alpha scales the mask
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_BlendMask(uint32_t Xpos, uint32_t Ypos, const uint8_t *pMask, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  uint32_t       x = Xpos, y = Ypos, w = Width, h = Height;
+  uint32_t       i, j, run, coverage;
+  uint32_t       alpha = Color >> 24;
+  uint32_t       rgb565 = FB_ARGB8888_TO_RGB565(Color);
+  const uint8_t *src;
+  uint16_t      *dst;
+
+  if ((alpha != 0U) && (FB_Clip(&x, &y, &w, &h) != 0U))
+  {
+    for (j = 0U; j < h; j++)
+    {
+      src = &pMask[(((FbCtx.BandYpos + y + j) - Ypos) * Width) + (x - Xpos)];
+      dst = &FbCtx.pBuffer[((y + j) * FbCtx.Width) + x];
+      i = 0U;
+      while (i < w)
+      {
+        /* Runs of equal coverage, mostly empty or full, are blended two pixels at a time */
+        coverage = src[i];
+        for (run = 1U; ((i + run) < w) && (src[i + run] == coverage); run++)
+        {
+        }
+        coverage = FB_ALPHA5(((coverage * alpha) + 255U) >> 8);
+        if (coverage != 0U)
+        {
+          FB_BlendRow(&dst[i], run, rgb565, coverage);
+        }
+        i += run;
+      }
+    }
+    FB_AddDirty(x, y, w, h);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Draw a RGB565 bitmap (BMP file) in the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pBmp     Pointer to BMP file
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  int32_t   ret = UTIL_LCD_FB_OK;
+  uint32_t  index, width, height, stride, bpp;
+  uint32_t  x, y, w, h, i, j, src_row;
+  uint32_t  top_down = 0U;
+  uint8_t  *src;
+  uint16_t *dst;
+
+  (void)Instance;
+
+  /* Get bitmap data address offset */
+  index  = ((uint32_t)pBmp[13] << 24) | ((uint32_t)pBmp[12] << 16) | ((uint32_t)pBmp[11] << 8) | (uint32_t)pBmp[10];
+  /* Get image width */
+  width  = ((uint32_t)pBmp[21] << 24) | ((uint32_t)pBmp[20] << 16) | ((uint32_t)pBmp[19] << 8) | (uint32_t)pBmp[18];
+  /* Get image height, negative for top-down bitmaps */
+  height = ((uint32_t)pBmp[25] << 24) | ((uint32_t)pBmp[24] << 16) | ((uint32_t)pBmp[23] << 8) | (uint32_t)pBmp[22];
+  /* Get bits per pixel */
+  bpp    = ((uint32_t)pBmp[29] << 8) | (uint32_t)pBmp[28];
+
+  if ((height & 0x80000000U) != 0U)
+  {
+    height   = (uint32_t)(-(int32_t)height);
+    top_down = 1U;
+  }
+  /* BMP rows are padded to 32-bit */
+  stride = ((width * 2U) + 3U) & ~3U;
+
+  x = Xpos;
+  y = Ypos;
+  w = width;
+  h = height;
+  if (bpp != 16U)
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else if (FB_Clip(&x, &y, &w, &h) != 0U)
+  {
+    for (j = 0U; j < h; j++)
+    {
+      /* Image row displayed on band row y + j */
+      src_row = (FbCtx.BandYpos + y + j) - Ypos;
+      if (top_down == 0U)
+      {
+        src_row = height - 1U - src_row;
+      }
+      src = &pBmp[index + (src_row * stride)];
+      dst = &FbCtx.pBuffer[((y + j) * FbCtx.Width) + x];
+      for (i = 0U; i < w; i++)
+      {
+        dst[i] = (uint16_t)((uint32_t)src[2U * i] | ((uint32_t)src[(2U * i) + 1U] << 8));
+      }
+    }
+    FB_AddDirty(x, y, w, h);
+  }
+  else
+  {
+    /* Bitmap is outside of the frame buffer */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Copy a RGB565 buffer in a rectangle of the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pData    Pointer on RGB565 pixels buffer
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  uint32_t  x = Xpos, y = Ypos, w = Width, h = Height;
+  uint32_t  i, j;
+  uint8_t  *src;
+  uint16_t *dst;
+
+  (void)Instance;
+
+  if (FB_Clip(&x, &y, &w, &h) != 0U)
+  {
+    for (j = 0U; j < h; j++)
+    {
+      src = &pData[2U * ((((FbCtx.BandYpos + y + j) - Ypos) * Width) + (x - Xpos))];
+      dst = &FbCtx.pBuffer[((y + j) * FbCtx.Width) + x];
+      for (i = 0U; i < w; i++)
+      {
+        dst[i] = (uint16_t)((uint32_t)src[2U * i] | ((uint32_t)src[(2U * i) + 1U] << 8));
+      }
+    }
+    FB_AddDirty(x, y, w, h);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Draw a horizontal line in the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    RGB565 color of the line
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return UTIL_LCD_FB_FillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+/**
+  * @brief  Draw a vertical line in the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    RGB565 color of the line
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return UTIL_LCD_FB_FillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+}
+
+/**
+  * @brief  Fill a rectangle of the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @param  Color    RGB565 color of the rectangle
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  uint32_t  i, j;
+  uint16_t *dst;
+
+  (void)Instance;
+
+  if (FB_Clip(&Xpos, &Ypos, &Width, &Height) != 0U)
+  {
+    for (j = 0U; j < Height; j++)
+    {
+      dst = &FbCtx.pBuffer[((Ypos + j) * FbCtx.Width) + Xpos];
+      for (i = 0U; i < Width; i++)
+      {
+        dst[i] = (uint16_t)Color;
+      }
+    }
+    FB_AddDirty(Xpos, Ypos, Width, Height);
+  }
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Read a pixel of the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    RGB565 pixel color
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  int32_t  ret = UTIL_LCD_FB_OK;
+  uint32_t width = 1U, height = 1U;
+
+  (void)Instance;
+
+  if (FB_Clip(&Xpos, &Ypos, &width, &height) != 0U)
+  {
+    *Color = FbCtx.pBuffer[(Ypos * FbCtx.Width) + Xpos];
+  }
+  else
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write a pixel of the frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    RGB565 pixel color
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return UTIL_LCD_FB_FillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+/**
+  * @brief  Get the frame buffer X size.
+  * @param  Instance LCD Instance
+  * @param  XSize    X size in pixels
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  (void)Instance;
+
+  *XSize = FbCtx.Width;
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Get the frame buffer Y size.
+  * @param  Instance LCD Instance
+  * @param  YSize    Y size in pixels
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  (void)Instance;
+
+  *YSize = FbCtx.Height;
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Set the active layer.
+  * @param  Instance LCD Instance
+  * @param  Layer    Layer index
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  /* Single layer frame buffer: nothing to do */
+  (void)Instance;
+  (void)Layer;
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Get the frame buffer pixel format.
+  * @param  Instance LCD Instance
+  * @param  Format   Pixel format
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  (void)Instance;
+
+  *Format = LCD_PIXEL_FORMAT_RGB565;
+
+  return UTIL_LCD_FB_OK;
+}
+
+/**
+  * @brief  Initialize the memory flush target.
+  * @param  pImage RGB565 image of Width x Height pixels receiving the flushed regions
+  * @param  Width  Image width
+  * @param  Height Image height
+  * @retval UTIL_LCD_FB status
+  */
+int32_t UTIL_LCD_FB_MemTargetInit(uint16_t *pImage, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_FB_OK;
+
+  if ((pImage == NULL) || (Width == 0U) || (Height == 0U))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    FbMemCtx.pImage            = pImage;
+    FbMemCtx.Width             = Width;
+    FbMemCtx.Height            = Height;
+    FbMemCtx.WinXpos           = 0U;
+    FbMemCtx.WinYpos           = 0U;
+    FbMemCtx.WinWidth          = Width;
+    FbMemCtx.WinHeight         = Height;
+    FbMemCtx.Cursor            = 0U;
+    FbMemCtx.Stats.FlushCount  = 0U;
+    FbMemCtx.Stats.RegionCount = 0U;
+    FbMemCtx.Stats.WriteCount  = 0U;
+    FbMemCtx.Stats.PixelCount  = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the commands received by the memory flush target.
+  * @param  pStats RegionCount counts SetWindow calls, FlushCount is unused
+  */
+void UTIL_LCD_FB_MemTargetGetStats(UTIL_LCD_FB_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = FbMemCtx.Stats;
+  }
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Private_Functions STM32 LCD Frame Buffer Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Clip a rectangle to the current band, within the display.
+  * @param  Xpos   X position, unchanged
+  * @param  Ypos   Display Y position, replaced by the clipped row in the band
+  * @param  Width  Width, replaced by the clipped width
+  * @param  Height Height, replaced by the clipped height
+  * @retval 1 if part of the rectangle is visible, 0 otherwise
+  */
+static uint32_t FB_Clip(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height)
+{
+  uint32_t visible = 0U;
+  uint32_t band_end;
+  uint32_t y0, y1;
+
+  /* The last band may run past the bottom of the display */
+  band_end = FbCtx.BandYpos + FbCtx.BandHeight;
+  if (band_end > FbCtx.Height)
+  {
+    band_end = FbCtx.Height;
+  }
+
+  if ((FbCtx.pBuffer != NULL) && (*Width != 0U) && (*Height != 0U) &&
+      (*Xpos < FbCtx.Width) && (*Ypos < band_end))
+  {
+    y0 = *Ypos;
+    y1 = (*Height > (band_end - y0)) ? band_end : (y0 + *Height);
+
+    if (y1 > FbCtx.BandYpos)
+    {
+      if (y0 < FbCtx.BandYpos)
+      {
+        y0 = FbCtx.BandYpos;
+      }
+      if (*Width > (FbCtx.Width - *Xpos))
+      {
+        *Width = FbCtx.Width - *Xpos;
+      }
+      *Ypos   = y0 - FbCtx.BandYpos;
+      *Height = y1 - y0;
+      visible = 1U;
+    }
+  }
+
+  return visible;
+}
+
+/**
+  * @brief  Blend a RGB565 color over a RGB565 pixel.
+  * @note   The three fields are spread in one 32-bit word and blended with
+  *         two multiplications: (Fg * Alpha + Bg * (32 - Alpha)) / 32.
+  * @param  Bg     Background pixel
+  * @param  Fg     Foreground color
+  * @param  Alpha  Foreground weight, 0 to 32
+  * @retval Blended pixel
+  */
+static uint16_t FB_BlendPixel(uint32_t Bg, uint32_t Fg, uint32_t Alpha)
+{
+  uint32_t bg = (Bg | (Bg << 16)) & FB_SPREAD_MASK;
+  uint32_t fg = (Fg | (Fg << 16)) & FB_SPREAD_MASK;
+  uint32_t result;
+
+  result = (((fg * Alpha) + (bg * (32U - Alpha))) >> 5) & FB_SPREAD_MASK;
+
+  return (uint16_t)(result | (result >> 16));
+}
+
+/**
+  * @brief  Blend a RGB565 color over a row of pixels.
+  * @note   Pixel pairs are blended as 32-bit words, the even fields and the
+  *         odd fields of the pair each taking two multiplications. The words
+  *         are loaded and stored with memcpy(), which compiles to single
+  *         word accesses without breaking the uint16_t buffer aliasing rules.
+  * @param  pDst   First pixel
+  * @param  Length Number of pixels
+  * @param  Fg     Foreground color
+  * @param  Alpha  Foreground weight, 1 to 32
+  */
+static void FB_BlendRow(uint16_t *pDst, uint32_t Length, uint32_t Fg, uint32_t Alpha)
+{
+  uint32_t fg_even, fg_odd, bg_alpha, bg, even, odd, i;
+
+  if (Alpha >= 32U)
+  {
+    for (i = 0U; i < Length; i++)
+    {
+      pDst[i] = (uint16_t)Fg;
+    }
+  }
+  else
+  {
+    /* Leading pixel up to a 32-bit boundary */
+    if ((Length != 0U) && ((((uintptr_t)pDst) & 3U) != 0U))
+    {
+      *pDst = FB_BlendPixel(*pDst, Fg, Alpha);
+      pDst++;
+      Length--;
+    }
+
+    fg_even  = ((Fg | (Fg << 16)) & FB_SPREAD_MASK) * Alpha;
+    fg_odd   = (((Fg | (Fg << 16)) >> 5) & FB_SPREAD_MASK_ODD) * Alpha;
+    bg_alpha = 32U - Alpha;
+
+    for (i = 0U; i < (Length & ~1U); i += 2U)
+    {
+      (void)memcpy(&bg, &pDst[i], sizeof(bg));
+      even = ((fg_even + ((bg & FB_SPREAD_MASK) * bg_alpha)) >> 5) & FB_SPREAD_MASK;
+      odd  = ((fg_odd + (((bg >> 5) & FB_SPREAD_MASK_ODD) * bg_alpha)) >> 5) & FB_SPREAD_MASK_ODD;
+      bg   = even | (odd << 5);
+      (void)memcpy(&pDst[i], &bg, sizeof(bg));
+    }
+
+    /* Trailing pixel */
+    if ((Length & 1U) != 0U)
+    {
+      pDst[Length - 1U] = FB_BlendPixel(pDst[Length - 1U], Fg, Alpha);
+    }
+  }
+}
+
+/**
+  * @brief  Compute the area of a box.
+  * @param  Box Box
+  * @retval Area in pixels
+  */
+static uint32_t FB_Area(const FB_Box_t *Box)
+{
+  return (Box->X1 - Box->X0) * (Box->Y1 - Box->Y0);
+}
+
+/**
+  * @brief  Grow a box to the bounding box of itself and another one.
+  * @param  Box   Box to grow
+  * @param  Other Other box
+  */
+static void FB_Union(FB_Box_t *Box, const FB_Box_t *Other)
+{
+  Box->X0 = (Other->X0 < Box->X0) ? Other->X0 : Box->X0;
+  Box->Y0 = (Other->Y0 < Box->Y0) ? Other->Y0 : Box->Y0;
+  Box->X1 = (Other->X1 > Box->X1) ? Other->X1 : Box->X1;
+  Box->Y1 = (Other->Y1 > Box->Y1) ? Other->Y1 : Box->Y1;
+}
+
+/**
+  * @brief  Add a clipped rectangle to the dirty list.
+  *         Regions are merged when the merged window sends at most
+  *         UTIL_LCD_FB_MERGE_THRESHOLD redundant pixels, or when the list is full.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position in the band
+  * @param  Width  Width
+  * @param  Height Height
+  */
+static void FB_AddDirty(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  FB_Box_t box, merged;
+  uint32_t i, found, cost, best_cost;
+  uint32_t retry;
+
+  box.X0 = Xpos;
+  box.Y0 = Ypos;
+  box.X1 = Xpos + Width;
+  box.Y1 = Ypos + Height;
+
+  do
+  {
+    found = FbCtx.DirtyNbr;
+
+    /* Look for a region which can be merged at low cost */
+    for (i = 0U; (i < FbCtx.DirtyNbr) && (found == FbCtx.DirtyNbr); i++)
+    {
+      merged = box;
+      FB_Union(&merged, &FbCtx.Dirty[i]);
+      if (FB_Area(&merged) <= (FB_Area(&box) + FB_Area(&FbCtx.Dirty[i]) + UTIL_LCD_FB_MERGE_THRESHOLD))
+      {
+        found = i;
+      }
+    }
+
+    /* List is full: merge with the region growing the least */
+    if ((found == FbCtx.DirtyNbr) && (FbCtx.DirtyNbr == UTIL_LCD_FB_MAX_DIRTY_RECTS))
+    {
+      best_cost = 0xFFFFFFFFU;
+      for (i = 0U; i < FbCtx.DirtyNbr; i++)
+      {
+        merged = box;
+        FB_Union(&merged, &FbCtx.Dirty[i]);
+        cost = FB_Area(&merged) - FB_Area(&FbCtx.Dirty[i]);
+        if (cost < best_cost)
+        {
+          best_cost = cost;
+          found     = i;
+        }
+      }
+    }
+
+    retry = 0U;
+    if (found != FbCtx.DirtyNbr)
+    {
+      /* Remove the region from the list and retry with the grown box */
+      FB_Union(&box, &FbCtx.Dirty[found]);
+      FbCtx.DirtyNbr--;
+      FbCtx.Dirty[found] = FbCtx.Dirty[FbCtx.DirtyNbr];
+      retry = 1U;
+    }
+  } while (retry != 0U);
+
+  FbCtx.Dirty[FbCtx.DirtyNbr] = box;
+  FbCtx.DirtyNbr++;
+}
+
+/**
+  * @brief  Open a window in the memory flush target.
+  * @param  Instance Unused
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Window width
+  * @param  Height   Window height
+  * @retval UTIL_LCD_FB status
+  */
+static int32_t FB_MemSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = UTIL_LCD_FB_OK;
+
+  (void)Instance;
+
+  if ((FbMemCtx.pImage == NULL) || (Width == 0U) || (Height == 0U) ||
+      (Xpos >= FbMemCtx.Width) || (Width > (FbMemCtx.Width - Xpos)) ||
+      (Ypos >= FbMemCtx.Height) || (Height > (FbMemCtx.Height - Ypos)))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    FbMemCtx.WinXpos   = Xpos;
+    FbMemCtx.WinYpos   = Ypos;
+    FbMemCtx.WinWidth  = Width;
+    FbMemCtx.WinHeight = Height;
+    FbMemCtx.Cursor    = 0U;
+    FbMemCtx.Stats.RegionCount++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write pixels in the current window of the memory flush target.
+  *         Like the panel, the write position wraps at the end of the window.
+  * @param  Instance Unused
+  * @param  pData    RGB565 pixels
+  * @param  Length   Number of pixels
+  * @retval UTIL_LCD_FB status
+  */
+static int32_t FB_MemWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  int32_t  ret = UTIL_LCD_FB_OK;
+  uint32_t i, x, y;
+
+  (void)Instance;
+
+  if ((FbMemCtx.pImage == NULL) || (pData == NULL))
+  {
+    ret = UTIL_LCD_FB_ERROR;
+  }
+  else
+  {
+    for (i = 0U; i < Length; i++)
+    {
+      x = FbMemCtx.WinXpos + (FbMemCtx.Cursor % FbMemCtx.WinWidth);
+      y = FbMemCtx.WinYpos + (FbMemCtx.Cursor / FbMemCtx.WinWidth);
+      FbMemCtx.pImage[(y * FbMemCtx.Width) + x] = (uint16_t)((uint32_t)pData[2U * i] | ((uint32_t)pData[(2U * i) + 1U] << 8));
+
+      FbMemCtx.Cursor++;
+      if (FbMemCtx.Cursor == (FbMemCtx.WinWidth * FbMemCtx.WinHeight))
+      {
+        FbMemCtx.Cursor = 0U;
+      }
+    }
+    FbMemCtx.Stats.WriteCount++;
+    FbMemCtx.Stats.PixelCount += Length;
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,193 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_fb.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_fb.c off-screen frame buffer driver.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_FB_H
+#define STM32_LCD_FB_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "lcd.h"
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_FB STM32 LCD Frame Buffer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_FB_Exported_Constants STM32 LCD Frame Buffer Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_FB_OK                0
+#define UTIL_LCD_FB_ERROR           (-1)
+
+/**
+  * @brief  Maximum number of dirty rectangles tracked between two flushes
+  */
+#ifndef UTIL_LCD_FB_MAX_DIRTY_RECTS
+  #define UTIL_LCD_FB_MAX_DIRTY_RECTS  8U
+#endif
+
+/**
+  * @brief  Number of redundant pixels accepted to merge two dirty rectangles
+  *         into a single flushed window
+  */
+#ifndef UTIL_LCD_FB_MERGE_THRESHOLD
+  #define UTIL_LCD_FB_MERGE_THRESHOLD  64U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Exported_Types STM32 LCD Frame Buffer Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Flush target: the frame buffer opens one window per dirty region and
+  *         streams the pixels of the region into it, row after row.
+  *         WritePixels Length is expressed in RGB565 pixels.
+  */
+typedef struct
+{
+  int32_t ( *SetWindow       ) (uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+  int32_t ( *WritePixels     ) (uint32_t, uint8_t *, uint32_t);
+} UTIL_LCD_FB_Target_t;
+
+/**
+  * @brief  Frame buffer configuration
+  */
+typedef struct
+{
+  uint16_t                   *pBuffer;    /*!< RGB565 buffer of Width x BandHeight pixels        */
+  uint32_t                    Width;      /*!< Display width in pixels                           */
+  uint32_t                    Height;     /*!< Display height in pixels                          */
+  uint32_t                    BandHeight; /*!< Rows held by pBuffer, Height for a full buffer    */
+  uint32_t                    Instance;   /*!< Target instance passed to the flush target        */
+  const UTIL_LCD_FB_Target_t *pTarget;    /*!< Flush target                                      */
+} UTIL_LCD_FB_Init_t;
+
+/**
+  * @brief  Frame buffer rectangle
+  */
+typedef struct
+{
+  uint32_t Xpos;
+  uint32_t Ypos;
+  uint32_t Width;
+  uint32_t Height;
+} UTIL_LCD_FB_Rect_t;
+
+/**
+  * @brief  Flush statistics
+  */
+typedef struct
+{
+  uint32_t FlushCount;  /*!< Number of UTIL_LCD_FB_Flush() calls     */
+  uint32_t RegionCount; /*!< Number of windows opened on the target  */
+  uint32_t WriteCount;  /*!< Number of WritePixels calls             */
+  uint32_t PixelCount;  /*!< Number of pixels sent to the target     */
+} UTIL_LCD_FB_Stats_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_FB_Exported_Variables STM32 LCD Frame Buffer Utility Exported Variables
+  * @{
+  */
+extern const LCD_UTILS_Drv_t      UTIL_LCD_FB_Driver;
+extern const UTIL_LCD_FB_Target_t UTIL_LCD_FB_MemTarget;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_FB_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_LCD_FB_Init(const UTIL_LCD_FB_Init_t *pInit);
+int32_t  UTIL_LCD_FB_SetBand(uint32_t Ypos);
+int32_t  UTIL_LCD_FB_Invalidate(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_FB_Flush(void);
+uint32_t UTIL_LCD_FB_GetDirtyRects(UTIL_LCD_FB_Rect_t *pRects, uint32_t MaxRects);
+void     UTIL_LCD_FB_GetStats(UTIL_LCD_FB_Stats_t *pStats);
+void     UTIL_LCD_FB_ResetStats(void);
+
+/* Compositing */
+int32_t  UTIL_LCD_FB_BlendRect(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+int32_t  UTIL_LCD_FB_BlendBitmap(uint32_t Xpos, uint32_t Ypos, const uint8_t *pData, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_FB_BlendMask(uint32_t Xpos, uint32_t Ypos, const uint8_t *pMask, uint32_t Width, uint32_t Height, uint32_t Color);
+
+/* LCD_UTILS_Drv_t interface */
+int32_t  UTIL_LCD_FB_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
+int32_t  UTIL_LCD_FB_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_FB_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_FB_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_FB_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+int32_t  UTIL_LCD_FB_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
+int32_t  UTIL_LCD_FB_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
+int32_t  UTIL_LCD_FB_GetXSize(uint32_t Instance, uint32_t *XSize);
+int32_t  UTIL_LCD_FB_GetYSize(uint32_t Instance, uint32_t *YSize);
+int32_t  UTIL_LCD_FB_SetLayer(uint32_t Instance, uint32_t Layer);
+int32_t  UTIL_LCD_FB_GetFormat(uint32_t Instance, uint32_t *Format);
+
+/* Memory flush target */
+int32_t  UTIL_LCD_FB_MemTargetInit(uint16_t *pImage, uint32_t Width, uint32_t Height);
+void     UTIL_LCD_FB_MemTargetGetStats(UTIL_LCD_FB_Stats_t *pStats);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_FB_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,742 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_idx.c
+  * @author  MCD Application Team
+  * @brief   This file includes an off-screen palette-indexed frame buffer
+  *          driver for the STM32 LCD utility, expanded to RGB565 on flush.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver renders the STM32 LCD utility primitives into a one byte per
+     pixel RAM buffer holding color indexes. A full 240x240 frame takes 57600
+     bytes instead of 115200 bytes for the RGB565 frame buffer. The pixels are
+     expanded to RGB565 through a lookup table when they are flushed.
+
+   - Two formats are supported:
+         LCD_PIXEL_FORMAT_L8   : 8-bit index in a 256 entries CLUT
+         LCD_PIXEL_FORMAT_AL44 : 4-bit alpha (high nibble) and 4-bit index in
+                                 a 16 entries CLUT (low nibble). The entry is
+                                 blended with the alpha over CLUT entry 0, the
+                                 background, which gives 16 levels of
+                                 anti-aliasing for text and shapes.
+
+   - Fill a UTIL_LCD_IDX_Init_t structure with:
+         pBuffer    : Width x Height bytes
+         Format     : LCD_PIXEL_FORMAT_L8 or LCD_PIXEL_FORMAT_AL44
+         pTarget    : flush target providing SetWindow/WritePixels, such as a
+                      panel adapter or UTIL_LCD_FB_MemTarget
+     then call:
+         UTIL_LCD_IDX_Init()
+         UTIL_LCD_IDX_SetClut()           (gray levels after init)
+         UTIL_LCD_SetFuncDriver(&UTIL_LCD_IDX_Driver)
+
+   - The driver reports its format to the LCD utility, which then passes the
+     colors as they are given: the low byte of each color is the value written
+     in the buffer, for instance UTIL_LCD_SetTextColor(3U) draws the text with
+     CLUT entry 3. UTIL_LCD_DrawBitmap() takes 8 bpp BMP files, their pixel
+     values are copied and their palette is ignored.
+
+   - Draw with the UTIL_LCD_* services and call UTIL_LCD_IDX_Flush() once per
+     frame. The touched area is tracked as one dirty rectangle, expanded in
+     UTIL_LCD_IDX_LINE_SIZE pixels chunks and streamed into a single window.
+     UTIL_LCD_IDX_SetClut() redraws the whole screen on next flush, so palette
+     animations cost no rendering.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_idx.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_IDX STM32 LCD Indexed Frame Buffer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_IDX_Private_Macros STM32 LCD Indexed Frame Buffer Utility Private Macros
+  * @{
+  */
+#define IDX_ARGB8888_TO_RGB565(Color) ((uint16_t)((((Color) >> 8) & 0xF800U) | (((Color) >> 5) & 0x07E0U) | (((Color) >> 3) & 0x001FU)))
+
+/* Blend one RGB565 field (5 or 6 bits at Shift) of Fg over Bg, Alpha being 0 to 15 */
+#define IDX_BLEND_FIELD(Fg, Bg, Shift, Mask, Alpha) \
+  ((((((Fg) >> (Shift)) & (Mask)) * (Alpha)) + ((((Bg) >> (Shift)) & (Mask)) * (15U - (Alpha))) + 7U) / 15U << (Shift))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Private_Types STM32 LCD Indexed Frame Buffer Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint8_t                    *pBuffer;
+  uint32_t                    Width;
+  uint32_t                    Height;
+  uint32_t                    Format;
+  uint32_t                    Instance;
+  const UTIL_LCD_FB_Target_t *pTarget;
+  uint32_t                    X0;       /* Dirty rectangle, empty when X1 is 0 */
+  uint32_t                    Y0;
+  uint32_t                    X1;
+  uint32_t                    Y1;
+  uint16_t                    Clut[UTIL_LCD_IDX_CLUT_SIZE];
+  uint16_t                    Lut[UTIL_LCD_IDX_CLUT_SIZE];
+  UTIL_LCD_FB_Stats_t         Stats;
+} IDX_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Private_FunctionPrototypes STM32 LCD Indexed Frame Buffer Utility Private FunctionPrototypes
+  * @{
+  */
+static uint32_t IDX_Clip(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height);
+static void     IDX_AddDirty(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static void     IDX_BuildLut(void);
+static void     IDX_Expand(uint16_t *pDst, const uint8_t *pSrc, uint32_t Length);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Private_Variables STM32 LCD Indexed Frame Buffer Utility Private Variables
+  * @{
+  */
+static IDX_Ctx_t IdxCtx;
+static uint16_t  IdxLine[UTIL_LCD_IDX_LINE_SIZE];
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Exported_Variables STM32 LCD Indexed Frame Buffer Utility Exported Variables
+  * @{
+  */
+const LCD_UTILS_Drv_t UTIL_LCD_IDX_Driver =
+{
+  UTIL_LCD_IDX_DrawBitmap,
+  UTIL_LCD_IDX_FillRGBRect,
+  UTIL_LCD_IDX_DrawHLine,
+  UTIL_LCD_IDX_DrawVLine,
+  UTIL_LCD_IDX_FillRect,
+  UTIL_LCD_IDX_GetPixel,
+  UTIL_LCD_IDX_SetPixel,
+  UTIL_LCD_IDX_GetXSize,
+  UTIL_LCD_IDX_GetYSize,
+  UTIL_LCD_IDX_SetLayer,
+  UTIL_LCD_IDX_GetFormat
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Exported_Functions STM32 LCD Indexed Frame Buffer Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the indexed frame buffer. The CLUT is set to gray levels.
+  * @param  pInit Indexed frame buffer configuration
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_Init(const UTIL_LCD_IDX_Init_t *pInit)
+{
+  int32_t  ret = UTIL_LCD_IDX_OK;
+  uint32_t i, gray;
+
+  if ((pInit == NULL) || (pInit->pBuffer == NULL) || (pInit->Width == 0U) || (pInit->Height == 0U) ||
+      ((pInit->Format != LCD_PIXEL_FORMAT_L8) && (pInit->Format != LCD_PIXEL_FORMAT_AL44)))
+  {
+    ret = UTIL_LCD_IDX_ERROR;
+  }
+  else
+  {
+    IdxCtx.pBuffer  = pInit->pBuffer;
+    IdxCtx.Width    = pInit->Width;
+    IdxCtx.Height   = pInit->Height;
+    IdxCtx.Format   = pInit->Format;
+    IdxCtx.Instance = pInit->Instance;
+    IdxCtx.pTarget  = pInit->pTarget;
+    IdxCtx.X1       = 0U;
+
+    for (i = 0U; i < UTIL_LCD_IDX_CLUT_SIZE; i++)
+    {
+      gray = (IdxCtx.Format == LCD_PIXEL_FORMAT_L8) ? i : ((i & 0x0FU) * 0x11U);
+      IdxCtx.Clut[i] = IDX_ARGB8888_TO_RGB565(gray * 0x010101U);
+    }
+    IDX_BuildLut();
+    UTIL_LCD_IDX_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Load CLUT entries. The whole screen is sent on next flush.
+  * @param  pClut  ARGB8888 colors, alpha is ignored
+  * @param  Offset First entry to load
+  * @param  Count  Number of entries to load
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_SetClut(const uint32_t *pClut, uint32_t Offset, uint32_t Count)
+{
+  int32_t  ret = UTIL_LCD_IDX_OK;
+  uint32_t i;
+
+  if ((IdxCtx.pBuffer == NULL) || (pClut == NULL) || (Offset >= UTIL_LCD_IDX_CLUT_SIZE) ||
+      (Count > (UTIL_LCD_IDX_CLUT_SIZE - Offset)))
+  {
+    ret = UTIL_LCD_IDX_ERROR;
+  }
+  else
+  {
+    for (i = 0U; i < Count; i++)
+    {
+      IdxCtx.Clut[Offset + i] = IDX_ARGB8888_TO_RGB565(pClut[i]);
+    }
+    IDX_BuildLut();
+    IDX_AddDirty(0U, 0U, IdxCtx.Width, IdxCtx.Height);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Mark a display area as dirty so that it is sent on next flush.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Area width
+  * @param  Height Area height
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_Invalidate(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  if (IDX_Clip(&Xpos, &Ypos, &Width, &Height) != 0U)
+  {
+    IDX_AddDirty(Xpos, Ypos, Width, Height);
+  }
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Expand the dirty rectangle to RGB565 and send it to the flush target.
+  *         The rows are streamed in one window, UTIL_LCD_IDX_LINE_SIZE pixels
+  *         per write whatever the rectangle width.
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_Flush(void)
+{
+  int32_t        ret = UTIL_LCD_IDX_OK;
+  uint32_t       row, width, height, left, length, count = 0U;
+  const uint8_t *src;
+
+  if ((IdxCtx.pBuffer == NULL) || (IdxCtx.pTarget == NULL))
+  {
+    ret = UTIL_LCD_IDX_ERROR;
+  }
+  else if (IdxCtx.X1 != 0U)
+  {
+    width  = IdxCtx.X1 - IdxCtx.X0;
+    height = IdxCtx.Y1 - IdxCtx.Y0;
+
+    if (IdxCtx.pTarget->SetWindow(IdxCtx.Instance, IdxCtx.X0, IdxCtx.Y0, width, height) != 0)
+    {
+      ret = UTIL_LCD_IDX_ERROR;
+    }
+
+    for (row = IdxCtx.Y0; (row < IdxCtx.Y1) && (ret == UTIL_LCD_IDX_OK); row++)
+    {
+      src  = &IdxCtx.pBuffer[(row * IdxCtx.Width) + IdxCtx.X0];
+      left = width;
+      while ((left != 0U) && (ret == UTIL_LCD_IDX_OK))
+      {
+        length = ((UTIL_LCD_IDX_LINE_SIZE - count) < left) ? (UTIL_LCD_IDX_LINE_SIZE - count) : left;
+        IDX_Expand(&IdxLine[count], src, length);
+        src   += length;
+        left  -= length;
+        count += length;
+
+        if (count == UTIL_LCD_IDX_LINE_SIZE)
+        {
+          if (IdxCtx.pTarget->WritePixels(IdxCtx.Instance, (uint8_t *)IdxLine, count) != 0)
+          {
+            ret = UTIL_LCD_IDX_ERROR;
+          }
+          IdxCtx.Stats.WriteCount++;
+          count = 0U;
+        }
+      }
+    }
+
+    if ((count != 0U) && (ret == UTIL_LCD_IDX_OK))
+    {
+      if (IdxCtx.pTarget->WritePixels(IdxCtx.Instance, (uint8_t *)IdxLine, count) != 0)
+      {
+        ret = UTIL_LCD_IDX_ERROR;
+      }
+      IdxCtx.Stats.WriteCount++;
+    }
+
+    IdxCtx.Stats.RegionCount++;
+    IdxCtx.Stats.PixelCount += width * height;
+    IdxCtx.Stats.FlushCount++;
+    IdxCtx.X1 = 0U;
+  }
+  else
+  {
+    IdxCtx.Stats.FlushCount++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the flush statistics.
+  * @param  pStats Pointer to statistics structure
+  */
+void UTIL_LCD_IDX_GetStats(UTIL_LCD_FB_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = IdxCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the flush statistics.
+  */
+void UTIL_LCD_IDX_ResetStats(void)
+{
+  IdxCtx.Stats.FlushCount  = 0U;
+  IdxCtx.Stats.RegionCount = 0U;
+  IdxCtx.Stats.WriteCount  = 0U;
+  IdxCtx.Stats.PixelCount  = 0U;
+}
+
+/**
+  * @brief  Draw a 8 bpp bitmap (BMP file) in the indexed frame buffer.
+  *         The pixel values are copied, the BMP palette is ignored.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pBmp     Pointer to BMP file
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp)
+{
+  int32_t   ret = UTIL_LCD_IDX_OK;
+  uint32_t  index, width, height, stride, bpp;
+  uint32_t  x, y, w, h, i, j, src_row;
+  uint32_t  top_down = 0U;
+  uint8_t  *src;
+  uint8_t  *dst;
+
+  (void)Instance;
+
+  /* Get bitmap data address offset */
+  index  = ((uint32_t)pBmp[13] << 24) | ((uint32_t)pBmp[12] << 16) | ((uint32_t)pBmp[11] << 8) | (uint32_t)pBmp[10];
+  /* Get image width */
+  width  = ((uint32_t)pBmp[21] << 24) | ((uint32_t)pBmp[20] << 16) | ((uint32_t)pBmp[19] << 8) | (uint32_t)pBmp[18];
+  /* Get image height, negative for top-down bitmaps */
+  height = ((uint32_t)pBmp[25] << 24) | ((uint32_t)pBmp[24] << 16) | ((uint32_t)pBmp[23] << 8) | (uint32_t)pBmp[22];
+  /* Get bits per pixel */
+  bpp    = ((uint32_t)pBmp[29] << 8) | (uint32_t)pBmp[28];
+
+  if ((height & 0x80000000U) != 0U)
+  {
+    height   = (uint32_t)(-(int32_t)height);
+    top_down = 1U;
+  }
+  /* BMP rows are padded to 32-bit */
+  stride = (width + 3U) & ~3U;
+
+  x = Xpos;
+  y = Ypos;
+  w = width;
+  h = height;
+  if (bpp != 8U)
+  {
+    ret = UTIL_LCD_IDX_ERROR;
+  }
+  else if (IDX_Clip(&x, &y, &w, &h) != 0U)
+  {
+    for (j = 0U; j < h; j++)
+    {
+      src_row = (y + j) - Ypos;
+      if (top_down == 0U)
+      {
+        src_row = height - 1U - src_row;
+      }
+      src = &pBmp[index + (src_row * stride)];
+      dst = &IdxCtx.pBuffer[((y + j) * IdxCtx.Width) + x];
+      for (i = 0U; i < w; i++)
+      {
+        dst[i] = src[i];
+      }
+    }
+    IDX_AddDirty(x, y, w, h);
+  }
+  else
+  {
+    /* Bitmap is outside of the frame buffer */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Copy a buffer of colors in a rectangle of the indexed frame buffer.
+  * @note   The LCD utility passes the colors of an indexed target unconverted,
+  *         4 bytes per pixel: the low byte of each one is written.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  pData    Pointer on 32-bit colors buffer
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height)
+{
+  uint32_t  x = Xpos, y = Ypos, w = Width, h = Height;
+  uint32_t  i, j;
+  uint8_t  *src;
+  uint8_t  *dst;
+
+  (void)Instance;
+
+  if (IDX_Clip(&x, &y, &w, &h) != 0U)
+  {
+    for (j = 0U; j < h; j++)
+    {
+      src = &pData[4U * ((((y + j) - Ypos) * Width) + (x - Xpos))];
+      dst = &IdxCtx.pBuffer[((y + j) * IdxCtx.Width) + x];
+      for (i = 0U; i < w; i++)
+      {
+        dst[i] = src[4U * i];
+      }
+    }
+    IDX_AddDirty(x, y, w, h);
+  }
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Draw a horizontal line in the indexed frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    Color, the low byte is written
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return UTIL_LCD_IDX_FillRect(Instance, Xpos, Ypos, Length, 1U, Color);
+}
+
+/**
+  * @brief  Draw a vertical line in the indexed frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Length   Length of the line
+  * @param  Color    Color, the low byte is written
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color)
+{
+  return UTIL_LCD_IDX_FillRect(Instance, Xpos, Ypos, 1U, Length, Color);
+}
+
+/**
+  * @brief  Fill a rectangle of the indexed frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Width of the rectangle
+  * @param  Height   Height of the rectangle
+  * @param  Color    Color, the low byte is written
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color)
+{
+  uint32_t  i, j;
+  uint8_t  *dst;
+
+  (void)Instance;
+
+  if (IDX_Clip(&Xpos, &Ypos, &Width, &Height) != 0U)
+  {
+    for (j = 0U; j < Height; j++)
+    {
+      dst = &IdxCtx.pBuffer[((Ypos + j) * IdxCtx.Width) + Xpos];
+      for (i = 0U; i < Width; i++)
+      {
+        dst[i] = (uint8_t)Color;
+      }
+    }
+    IDX_AddDirty(Xpos, Ypos, Width, Height);
+  }
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Read a pixel of the indexed frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    Pixel value
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color)
+{
+  int32_t  ret = UTIL_LCD_IDX_OK;
+  uint32_t width = 1U, height = 1U;
+
+  (void)Instance;
+
+  if (IDX_Clip(&Xpos, &Ypos, &width, &height) != 0U)
+  {
+    *Color = IdxCtx.pBuffer[(Ypos * IdxCtx.Width) + Xpos];
+  }
+  else
+  {
+    ret = UTIL_LCD_IDX_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write a pixel of the indexed frame buffer.
+  * @param  Instance LCD Instance
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Color    Color, the low byte is written
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color)
+{
+  return UTIL_LCD_IDX_FillRect(Instance, Xpos, Ypos, 1U, 1U, Color);
+}
+
+/**
+  * @brief  Get the indexed frame buffer X size.
+  * @param  Instance LCD Instance
+  * @param  XSize    X size in pixels
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_GetXSize(uint32_t Instance, uint32_t *XSize)
+{
+  (void)Instance;
+
+  *XSize = IdxCtx.Width;
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Get the indexed frame buffer Y size.
+  * @param  Instance LCD Instance
+  * @param  YSize    Y size in pixels
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_GetYSize(uint32_t Instance, uint32_t *YSize)
+{
+  (void)Instance;
+
+  *YSize = IdxCtx.Height;
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Set the active layer.
+  * @param  Instance LCD Instance
+  * @param  Layer    Layer index
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_SetLayer(uint32_t Instance, uint32_t Layer)
+{
+  /* Single layer frame buffer: nothing to do */
+  (void)Instance;
+  (void)Layer;
+
+  return UTIL_LCD_IDX_OK;
+}
+
+/**
+  * @brief  Get the indexed frame buffer pixel format.
+  * @param  Instance LCD Instance
+  * @param  Format   LCD_PIXEL_FORMAT_L8 or LCD_PIXEL_FORMAT_AL44
+  * @retval UTIL_LCD_IDX status
+  */
+int32_t UTIL_LCD_IDX_GetFormat(uint32_t Instance, uint32_t *Format)
+{
+  (void)Instance;
+
+  *Format = IdxCtx.Format;
+
+  return UTIL_LCD_IDX_OK;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Private_Functions STM32 LCD Indexed Frame Buffer Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Clip a rectangle to the indexed frame buffer.
+  * @param  Xpos   X position, unchanged
+  * @param  Ypos   Y position, unchanged
+  * @param  Width  Width, replaced by the clipped width
+  * @param  Height Height, replaced by the clipped height
+  * @retval 1 if part of the rectangle is visible, 0 otherwise
+  */
+static uint32_t IDX_Clip(uint32_t *Xpos, uint32_t *Ypos, uint32_t *Width, uint32_t *Height)
+{
+  uint32_t visible = 0U;
+
+  if ((IdxCtx.pBuffer != NULL) && (*Width != 0U) && (*Height != 0U) &&
+      (*Xpos < IdxCtx.Width) && (*Ypos < IdxCtx.Height))
+  {
+    if (*Width > (IdxCtx.Width - *Xpos))
+    {
+      *Width = IdxCtx.Width - *Xpos;
+    }
+    if (*Height > (IdxCtx.Height - *Ypos))
+    {
+      *Height = IdxCtx.Height - *Ypos;
+    }
+    visible = 1U;
+  }
+
+  return visible;
+}
+
+/**
+  * @brief  Grow the dirty rectangle to include a clipped area.
+  * @param  Xpos   X position
+  * @param  Ypos   Y position
+  * @param  Width  Width
+  * @param  Height Height
+  */
+static void IDX_AddDirty(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  if (IdxCtx.X1 == 0U)
+  {
+    IdxCtx.X0 = Xpos;
+    IdxCtx.Y0 = Ypos;
+    IdxCtx.X1 = Xpos + Width;
+    IdxCtx.Y1 = Ypos + Height;
+  }
+  else
+  {
+    IdxCtx.X0 = (Xpos < IdxCtx.X0) ? Xpos : IdxCtx.X0;
+    IdxCtx.Y0 = (Ypos < IdxCtx.Y0) ? Ypos : IdxCtx.Y0;
+    IdxCtx.X1 = ((Xpos + Width) > IdxCtx.X1) ? (Xpos + Width) : IdxCtx.X1;
+    IdxCtx.Y1 = ((Ypos + Height) > IdxCtx.Y1) ? (Ypos + Height) : IdxCtx.Y1;
+  }
+}
+
+/**
+  * @brief  Build the RGB565 expansion table of the 256 pixel values from the CLUT.
+  *         For AL44 each value holds the blend of its entry over entry 0.
+  */
+static void IDX_BuildLut(void)
+{
+  uint32_t i, fg, bg, alpha;
+
+  if (IdxCtx.Format == LCD_PIXEL_FORMAT_L8)
+  {
+    for (i = 0U; i < UTIL_LCD_IDX_CLUT_SIZE; i++)
+    {
+      IdxCtx.Lut[i] = IdxCtx.Clut[i];
+    }
+  }
+  else
+  {
+    bg = IdxCtx.Clut[0];
+    for (i = 0U; i < UTIL_LCD_IDX_CLUT_SIZE; i++)
+    {
+      fg    = IdxCtx.Clut[i & 0x0FU];
+      alpha = i >> 4;
+      IdxCtx.Lut[i] = (uint16_t)(IDX_BLEND_FIELD(fg, bg, 11U, 0x1FU, alpha) |
+                                 IDX_BLEND_FIELD(fg, bg, 5U, 0x3FU, alpha) |
+                                 IDX_BLEND_FIELD(fg, bg, 0U, 0x1FU, alpha));
+    }
+  }
+}
+
+/**
+  * @brief  Expand pixel values to RGB565 through the lookup table.
+  * @param  pDst   RGB565 pixels
+  * @param  pSrc   Pixel values
+  * @param  Length Number of pixels
+  */
+static void IDX_Expand(uint16_t *pDst, const uint8_t *pSrc, uint32_t Length)
+{
+  const uint16_t *lut = IdxCtx.Lut;
+  uint32_t        i;
+
+  /* Four pixels per iteration, the table lookups being independent */
+  for (i = 0U; (i + 4U) <= Length; i += 4U)
+  {
+    pDst[i]      = lut[pSrc[i]];
+    pDst[i + 1U] = lut[pSrc[i + 1U]];
+    pDst[i + 2U] = lut[pSrc[i + 2U]];
+    pDst[i + 3U] = lut[pSrc[i + 3U]];
+  }
+  for (; i < Length; i++)
+  {
+    pDst[i] = lut[pSrc[i]];
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_idx.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_idx.c palette-indexed frame buffer driver.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_IDX_H
+#define STM32_LCD_IDX_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_fb.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_IDX STM32 LCD Indexed Frame Buffer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_IDX_Exported_Constants STM32 LCD Indexed Frame Buffer Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_IDX_OK                0
+#define UTIL_LCD_IDX_ERROR           (-1)
+
+/**
+  * @brief  RGB565 pixels expanded at once during a flush. Full width regions
+  *         are sent with as many rows per write as fit in it.
+  */
+#ifndef UTIL_LCD_IDX_LINE_SIZE
+  #define UTIL_LCD_IDX_LINE_SIZE       480U
+#endif
+
+/**
+  * @brief  Number of CLUT entries
+  */
+#define UTIL_LCD_IDX_CLUT_SIZE         256U
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Exported_Types STM32 LCD Indexed Frame Buffer Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Indexed frame buffer configuration
+  */
+typedef struct
+{
+  uint8_t                    *pBuffer;    /*!< Width x Height pixels of one byte                  */
+  uint32_t                    Width;      /*!< Display width in pixels                            */
+  uint32_t                    Height;     /*!< Display height in pixels                           */
+  uint32_t                    Format;     /*!< LCD_PIXEL_FORMAT_L8 or LCD_PIXEL_FORMAT_AL44       */
+  uint32_t                    Instance;   /*!< Target instance passed to the flush target         */
+  const UTIL_LCD_FB_Target_t *pTarget;    /*!< Flush target, see UTIL_LCD_FB_Target_t             */
+} UTIL_LCD_IDX_Init_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IDX_Exported_Variables STM32 LCD Indexed Frame Buffer Utility Exported Variables
+  * @{
+  */
+extern const LCD_UTILS_Drv_t UTIL_LCD_IDX_Driver;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_IDX_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_LCD_IDX_Init(const UTIL_LCD_IDX_Init_t *pInit);
+int32_t  UTIL_LCD_IDX_SetClut(const uint32_t *pClut, uint32_t Offset, uint32_t Count);
+int32_t  UTIL_LCD_IDX_Invalidate(uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_IDX_Flush(void);
+void     UTIL_LCD_IDX_GetStats(UTIL_LCD_FB_Stats_t *pStats);
+void     UTIL_LCD_IDX_ResetStats(void);
+
+/* LCD_UTILS_Drv_t interface */
+int32_t  UTIL_LCD_IDX_DrawBitmap(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pBmp);
+int32_t  UTIL_LCD_IDX_FillRGBRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint8_t *pData, uint32_t Width, uint32_t Height);
+int32_t  UTIL_LCD_IDX_DrawHLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_IDX_DrawVLine(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Length, uint32_t Color);
+int32_t  UTIL_LCD_IDX_FillRect(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height, uint32_t Color);
+int32_t  UTIL_LCD_IDX_GetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t *Color);
+int32_t  UTIL_LCD_IDX_SetPixel(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Color);
+int32_t  UTIL_LCD_IDX_GetXSize(uint32_t Instance, uint32_t *XSize);
+int32_t  UTIL_LCD_IDX_GetYSize(uint32_t Instance, uint32_t *YSize);
+int32_t  UTIL_LCD_IDX_SetLayer(uint32_t Instance, uint32_t Layer);
+int32_t  UTIL_LCD_IDX_GetFormat(uint32_t Instance, uint32_t *Format);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_IDX_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,691 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_img.c
+  * @author  MCD Application Team
+  * @brief   This file includes a streaming image decoder for the STM32 LCD
+  *          utility: BMP images are read in chunks from any memory, e.g. an
+  *          external flash, and drawn band by band with a bounded RAM usage.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver draws BMP images with the STM32 LCD utility without needing
+     the whole image in addressable memory. The image is read by chunks of
+     UTIL_LCD_IMG_CHUNK_SIZE bytes through a reader with the
+     BSP_OSPI_NOR_Read() signature, or copied from memory (internal flash,
+     RAM or memory-mapped external flash) when no reader is given:
+         UTIL_LCD_IMG_Source_t src = {BSP_OSPI_NOR_Read, 0, SPLASH_ADDRESS, NULL};
+         UTIL_LCD_IMG_Draw(&src, Xpos, Ypos);
+
+   - Supported images:
+       o 1, 4 and 8 bits per pixel with a palette, uncompressed or run length
+         encoded (BI_RLE4, BI_RLE8),
+       o 16 bits per pixel, RGB565 (BI_RGB as written by UTIL_LCD_DrawBitmap()
+         users, or BI_BITFIELDS) and RGB555 (BI_BITFIELDS),
+       o 24 and 32 bits per pixel BGR,
+       o bottom-up and, when uncompressed, top-down row orders.
+     Pixels are converted to RGB565 on the fly. Pixels skipped by a RLE
+     delta or end of line code are drawn with the first palette color.
+
+   - Decoded rows are gathered in a buffer of UTIL_LCD_IMG_BUFFER_SIZE pixels
+     and sent with one UTIL_LCD_FillRGBRect() call per band of rows. Images
+     wider than the buffer are not supported. The image is not clipped: it
+     must fit in the display.
+
+   - UTIL_LCD_IMG_GetInfo() only reads the image headers, e.g. to center an
+     image before drawing it.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_img.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_IMG STM32 LCD Image Decoder Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_Defines STM32 LCD Image Decoder Utility Private Defines
+  * @{
+  */
+#define IMG_SIGNATURE       0x4D42U  /* "BM"                                */
+#define IMG_FILE_HEADER     14U      /* BITMAPFILEHEADER size               */
+#define IMG_INFO_HEADER     40U      /* Smallest BITMAPINFOHEADER supported */
+#define IMG_PALETTE_MAX     256U
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_Macros STM32 LCD Image Decoder Utility Private Macros
+  * @{
+  */
+#define MIN(X, Y)           (((X) < (Y)) ? (X) : (Y))
+
+#define IMG_RGB565(R, G, B) ((uint16_t)((((uint32_t)(R) & 0xF8U) << 8) | (((uint32_t)(G) & 0xFCU) << 3) | \
+                                        ((uint32_t)(B) >> 3)))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_Types STM32 LCD Image Decoder Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  const UTIL_LCD_IMG_Source_t *pSrc;
+  uint32_t Start;    /* Image offset of the first byte of Chunk */
+  uint32_t Length;   /* Bytes held by Chunk                      */
+  uint32_t Pos;      /* Image offset of the next byte            */
+  uint32_t End;      /* Image size                               */
+  int32_t  Error;    /* Read error or read beyond the image end  */
+  uint8_t  Chunk[UTIL_LCD_IMG_CHUNK_SIZE];
+} IMG_Stream_t;
+
+typedef struct
+{
+  UTIL_LCD_IMG_Info_t Info;
+  uint32_t Offset;   /* Pixel data offset                        */
+  uint32_t Stride;   /* Uncompressed row size in bytes           */
+  uint32_t TopDown;  /* Rows are stored from the top             */
+  uint32_t Rgb555;   /* 16-bit pixels are RGB555                 */
+  uint32_t RleX;     /* Column where the next RLE row resumes    */
+  uint32_t RleSkip;  /* RLE rows skipped by a delta code         */
+  uint32_t RleEnd;   /* RLE end of bitmap code reached           */
+} IMG_Image_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_FunctionPrototypes STM32 LCD Image Decoder Utility Private FunctionPrototypes
+  * @{
+  */
+static int32_t  IMG_Open(const UTIL_LCD_IMG_Source_t *pSrc);
+static void     IMG_Fill(void);
+static uint32_t IMG_GetByte(void);
+static uint32_t IMG_Get16(void);
+static uint32_t IMG_Get32(void);
+static void     IMG_Seek(uint32_t Offset);
+static void     IMG_DecodeRow(uint16_t *pRow);
+static void     IMG_DecodeRleRow(uint16_t *pRow);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_Variables STM32 LCD Image Decoder Utility Private Variables
+  * @{
+  */
+static IMG_Stream_t ImgStream;
+static IMG_Image_t  ImgImage;
+static uint16_t     ImgPalette[IMG_PALETTE_MAX];
+static uint16_t     ImgRows[UTIL_LCD_IMG_BUFFER_SIZE];
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Exported_Functions STM32 LCD Image Decoder Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Read the properties of an image.
+  * @param  pSrc  Image source
+  * @param  pInfo Image properties
+  * @retval UTIL_LCD_IMG_OK, UTIL_LCD_IMG_ERROR or UTIL_LCD_IMG_NOT_SUPPORTED
+  */
+int32_t UTIL_LCD_IMG_GetInfo(const UTIL_LCD_IMG_Source_t *pSrc, UTIL_LCD_IMG_Info_t *pInfo)
+{
+  int32_t ret = IMG_Open(pSrc);
+
+  if (ret == UTIL_LCD_IMG_OK)
+  {
+    *pInfo = ImgImage.Info;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Draw an image.
+  * @param  pSrc Image source
+  * @param  Xpos X position of the image top left corner
+  * @param  Ypos Y position of the image top left corner
+  * @retval UTIL_LCD_IMG_OK, UTIL_LCD_IMG_ERROR or UTIL_LCD_IMG_NOT_SUPPORTED
+  */
+int32_t UTIL_LCD_IMG_Draw(const UTIL_LCD_IMG_Source_t *pSrc, uint32_t Xpos, uint32_t Ypos)
+{
+  int32_t  ret = IMG_Open(pSrc);
+  uint32_t width, height, band, row, count, i, slot, y;
+
+  if (ret == UTIL_LCD_IMG_OK)
+  {
+    width  = ImgImage.Info.Width;
+    height = ImgImage.Info.Height;
+
+    if (width > UTIL_LCD_IMG_BUFFER_SIZE)
+    {
+      ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+    }
+    else
+    {
+      band = UTIL_LCD_IMG_BUFFER_SIZE / width;
+      IMG_Seek(ImgImage.Offset);
+
+      for (row = 0U; (row < height) && (ret == UTIL_LCD_IMG_OK); row += count)
+      {
+        /* Decode a band of rows, in display order in the buffer */
+        count = MIN(band, (height - row));
+        for (i = 0U; i < count; i++)
+        {
+          slot = (ImgImage.TopDown != 0U) ? i : (count - 1U - i);
+          IMG_DecodeRow(&ImgRows[slot * width]);
+        }
+
+        if (ImgStream.Error != UTIL_LCD_IMG_OK)
+        {
+          ret = UTIL_LCD_IMG_ERROR;
+        }
+        else
+        {
+          y = (ImgImage.TopDown != 0U) ? row : (height - row - count);
+          UTIL_LCD_FillRGBRect(Xpos, (Ypos + y), (uint8_t *)ImgRows, width, count);
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Private_Functions STM32 LCD Image Decoder Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Read and check the image headers, load the palette.
+  * @param  pSrc Image source
+  * @retval UTIL_LCD_IMG_OK, UTIL_LCD_IMG_ERROR or UTIL_LCD_IMG_NOT_SUPPORTED
+  */
+static int32_t IMG_Open(const UTIL_LCD_IMG_Source_t *pSrc)
+{
+  int32_t  ret = UTIL_LCD_IMG_OK;
+  uint32_t file_size, header_size, image_size, planes, entries, i, b, g, r;
+  uint32_t masks[3];
+  int32_t  width, height;
+
+  (void)memset(&ImgImage, 0, sizeof(ImgImage));
+  ImgStream.pSrc   = pSrc;
+  ImgStream.Start  = 0U;
+  ImgStream.Length = 0U;
+  ImgStream.Pos    = 0U;
+  ImgStream.End    = IMG_FILE_HEADER + IMG_INFO_HEADER;
+  ImgStream.Error  = UTIL_LCD_IMG_OK;
+
+  if ((pSrc == NULL) || ((pSrc->Read == NULL) && (pSrc->pData == NULL)))
+  {
+    ret = UTIL_LCD_IMG_ERROR;
+  }
+  else if (IMG_Get16() != IMG_SIGNATURE)
+  {
+    /* A failed read is not a foreign image */
+    ret = (ImgStream.Error != UTIL_LCD_IMG_OK) ? UTIL_LCD_IMG_ERROR : UTIL_LCD_IMG_NOT_SUPPORTED;
+  }
+  else
+  {
+    /* BITMAPFILEHEADER */
+    file_size = IMG_Get32();
+    (void)IMG_Get32();
+    ImgImage.Offset = IMG_Get32();
+
+    /* BITMAPINFOHEADER, the fields added by later versions are ignored */
+    header_size = IMG_Get32();
+    width       = (int32_t)IMG_Get32();
+    height      = (int32_t)IMG_Get32();
+    planes      = IMG_Get16();
+    ImgImage.Info.BitCount    = IMG_Get16();
+    ImgImage.Info.Compression = IMG_Get32();
+    image_size  = IMG_Get32();
+    (void)IMG_Get32();
+    (void)IMG_Get32();
+    entries     = IMG_Get32();
+    (void)IMG_Get32();
+
+    if (height < 0)
+    {
+      ImgImage.TopDown = 1U;
+      height           = -height;
+    }
+    ImgImage.Info.Width  = (uint32_t)width;
+    ImgImage.Info.Height = (uint32_t)height;
+    ImgImage.Stride      = ((((uint32_t)width * ImgImage.Info.BitCount) + 31U) / 32U) * 4U;
+
+    if (ImgStream.Error != UTIL_LCD_IMG_OK)
+    {
+      ret = UTIL_LCD_IMG_ERROR;
+    }
+    else if ((header_size < IMG_INFO_HEADER) || (planes != 1U) || (width <= 0) || (height == 0))
+    {
+      ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+    }
+    else if ((file_size != 0U) && (file_size <= ImgImage.Offset))
+    {
+      ret = UTIL_LCD_IMG_ERROR;
+    }
+    else
+    {
+      /* Image end: file size, else end of the pixel data */
+      if (image_size == 0U)
+      {
+        image_size = ImgImage.Stride * ImgImage.Info.Height;
+      }
+      ImgStream.End = (file_size != 0U) ? file_size : (ImgImage.Offset + image_size);
+
+      switch (ImgImage.Info.Compression)
+      {
+        case UTIL_LCD_IMG_BI_RGB:
+          if ((ImgImage.Info.BitCount != 1U) && (ImgImage.Info.BitCount != 4U) && (ImgImage.Info.BitCount != 8U) &&
+              (ImgImage.Info.BitCount != 16U) && (ImgImage.Info.BitCount != 24U) && (ImgImage.Info.BitCount != 32U))
+          {
+            ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+          }
+          break;
+
+        case UTIL_LCD_IMG_BI_RLE8:
+        case UTIL_LCD_IMG_BI_RLE4:
+          if ((ImgImage.Info.BitCount != ((ImgImage.Info.Compression == UTIL_LCD_IMG_BI_RLE8) ? 8U : 4U)) ||
+              (ImgImage.TopDown != 0U))
+          {
+            ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+          }
+          break;
+
+        case UTIL_LCD_IMG_BI_BITFIELDS:
+          /* Red, green and blue masks follow the 40 bytes header */
+          masks[0] = IMG_Get32();
+          masks[1] = IMG_Get32();
+          masks[2] = IMG_Get32();
+          if ((ImgImage.Info.BitCount == 16U) && (masks[0] == 0xF800U) && (masks[1] == 0x07E0U) && (masks[2] == 0x001FU))
+          {
+            ImgImage.Rgb555 = 0U;
+          }
+          else if ((ImgImage.Info.BitCount == 16U) && (masks[0] == 0x7C00U) && (masks[1] == 0x03E0U) && (masks[2] == 0x001FU))
+          {
+            ImgImage.Rgb555 = 1U;
+          }
+          else if ((ImgImage.Info.BitCount == 32U) && (masks[0] == 0xFF0000U) && (masks[1] == 0xFF00U) && (masks[2] == 0xFFU))
+          {
+            /* Same layout as BI_RGB */
+          }
+          else
+          {
+            ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+          }
+          break;
+
+        default:
+          ret = UTIL_LCD_IMG_NOT_SUPPORTED;
+          break;
+      }
+    }
+
+    if ((ret == UTIL_LCD_IMG_OK) && (ImgImage.Info.BitCount <= 8U))
+    {
+      /* Palette, converted to RGB565 */
+      if ((entries == 0U) || (entries > (1UL << ImgImage.Info.BitCount)))
+      {
+        entries = 1UL << ImgImage.Info.BitCount;
+      }
+      ImgImage.Info.PaletteSize = entries;
+
+      (void)memset(ImgPalette, 0, sizeof(ImgPalette));
+      IMG_Seek(IMG_FILE_HEADER + header_size);
+      for (i = 0U; i < entries; i++)
+      {
+        b = IMG_GetByte();
+        g = IMG_GetByte();
+        r = IMG_GetByte();
+        (void)IMG_GetByte();
+        ImgPalette[i] = IMG_RGB565(r, g, b);
+      }
+    }
+
+    if ((ret == UTIL_LCD_IMG_OK) && (ImgStream.Error != UTIL_LCD_IMG_OK))
+    {
+      ret = UTIL_LCD_IMG_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read the chunk holding the next byte.
+  */
+static void IMG_Fill(void)
+{
+  uint32_t size = 0U;
+
+  if (ImgStream.Pos >= ImgStream.End)
+  {
+    ImgStream.Error = UTIL_LCD_IMG_ERROR;
+  }
+  else
+  {
+    size = MIN((ImgStream.End - ImgStream.Pos), UTIL_LCD_IMG_CHUNK_SIZE);
+
+    if (ImgStream.pSrc->Read == NULL)
+    {
+      (void)memcpy(ImgStream.Chunk, &ImgStream.pSrc->pData[ImgStream.Pos], size);
+    }
+    else if (ImgStream.pSrc->Read(ImgStream.pSrc->Instance, ImgStream.Chunk, (ImgStream.pSrc->Address + ImgStream.Pos),
+                                  size) != 0)
+    {
+      ImgStream.Error = UTIL_LCD_IMG_ERROR;
+      size            = 0U;
+    }
+    else
+    {
+      /* Chunk read */
+    }
+  }
+
+  ImgStream.Start  = ImgStream.Pos;
+  ImgStream.Length = size;
+}
+
+/**
+  * @brief  Read the next byte of the image.
+  * @retval Byte read, 0 after an error
+  */
+static uint32_t IMG_GetByte(void)
+{
+  uint32_t value = 0U;
+
+  if ((ImgStream.Pos - ImgStream.Start) >= ImgStream.Length)
+  {
+    IMG_Fill();
+  }
+
+  if (ImgStream.Error == UTIL_LCD_IMG_OK)
+  {
+    value = ImgStream.Chunk[ImgStream.Pos - ImgStream.Start];
+    ImgStream.Pos++;
+  }
+
+  return value;
+}
+
+/**
+  * @brief  Read the next little endian 16-bit value of the image.
+  * @retval Value read
+  */
+static uint32_t IMG_Get16(void)
+{
+  uint32_t value = IMG_GetByte();
+
+  return value | (IMG_GetByte() << 8);
+}
+
+/**
+  * @brief  Read the next little endian 32-bit value of the image.
+  * @retval Value read
+  */
+static uint32_t IMG_Get32(void)
+{
+  uint32_t value = IMG_Get16();
+
+  return value | (IMG_Get16() << 16);
+}
+
+/**
+  * @brief  Move to an image offset, the chunk is kept when it holds it.
+  * @param  Offset Image offset of the next byte read
+  */
+static void IMG_Seek(uint32_t Offset)
+{
+  if (Offset < ImgStream.Start)
+  {
+    /* Force a reload, the unsigned distance to the chunk start is large */
+    ImgStream.Length = 0U;
+  }
+  ImgStream.Pos = Offset;
+}
+
+/**
+  * @brief  Decode the next row of the image in RGB565.
+  * @param  pRow Row of Info.Width pixels
+  */
+static void IMG_DecodeRow(uint16_t *pRow)
+{
+  uint32_t x, start, value = 0U, b, g, r;
+  uint32_t width = ImgImage.Info.Width;
+
+  if ((ImgImage.Info.Compression == UTIL_LCD_IMG_BI_RLE8) || (ImgImage.Info.Compression == UTIL_LCD_IMG_BI_RLE4))
+  {
+    IMG_DecodeRleRow(pRow);
+  }
+  else
+  {
+    start = ImgStream.Pos;
+
+    switch (ImgImage.Info.BitCount)
+    {
+      case 1U:
+        for (x = 0U; x < width; x++)
+        {
+          if ((x & 7U) == 0U)
+          {
+            value = IMG_GetByte();
+          }
+          pRow[x] = ImgPalette[(value >> (7U - (x & 7U))) & 1U];
+        }
+        break;
+
+      case 4U:
+        for (x = 0U; x < width; x++)
+        {
+          if ((x & 1U) == 0U)
+          {
+            value = IMG_GetByte();
+            pRow[x] = ImgPalette[value >> 4];
+          }
+          else
+          {
+            pRow[x] = ImgPalette[value & 0x0FU];
+          }
+        }
+        break;
+
+      case 8U:
+        for (x = 0U; x < width; x++)
+        {
+          pRow[x] = ImgPalette[IMG_GetByte()];
+        }
+        break;
+
+      case 16U:
+        for (x = 0U; x < width; x++)
+        {
+          value = IMG_Get16();
+          if (ImgImage.Rgb555 != 0U)
+          {
+            /* Extend the 5-bit green to 6 bits */
+            value = ((value & 0x7FE0U) << 1) | ((value >> 4) & 0x0020U) | (value & 0x001FU);
+          }
+          pRow[x] = (uint16_t)value;
+        }
+        break;
+
+      default:
+        /* 24 and 32 bits per pixel, BGR order */
+        for (x = 0U; x < width; x++)
+        {
+          b = IMG_GetByte();
+          g = IMG_GetByte();
+          r = IMG_GetByte();
+          if (ImgImage.Info.BitCount == 32U)
+          {
+            (void)IMG_GetByte();
+          }
+          pRow[x] = IMG_RGB565(r, g, b);
+        }
+        break;
+    }
+
+    /* Skip the row padding */
+    IMG_Seek(start + ImgImage.Stride);
+  }
+}
+
+/**
+  * @brief  Decode the next row of a RLE4 or RLE8 image in RGB565.
+  * @param  pRow Row of Info.Width pixels
+  */
+static void IMG_DecodeRleRow(uint16_t *pRow)
+{
+  uint32_t x, i, count, value, index = 0U, size, data = 0U, done = 0U;
+  uint32_t width = ImgImage.Info.Width;
+  uint32_t rle4  = (ImgImage.Info.Compression == UTIL_LCD_IMG_BI_RLE4) ? 1U : 0U;
+
+  /* Pixels not coded keep the first palette color */
+  for (x = 0U; x < width; x++)
+  {
+    pRow[x] = ImgPalette[0];
+  }
+  x = 0U;
+
+  if (ImgImage.RleEnd != 0U)
+  {
+    done = 1U;
+  }
+  else if (ImgImage.RleSkip != 0U)
+  {
+    ImgImage.RleSkip--;
+    done = 1U;
+  }
+  else
+  {
+    /* Decode from the column reached by the last delta code */
+    x = ImgImage.RleX;
+    ImgImage.RleX = 0U;
+  }
+
+  while ((done == 0U) && (ImgStream.Error == UTIL_LCD_IMG_OK))
+  {
+    count = IMG_GetByte();
+    value = IMG_GetByte();
+
+    if (count != 0U)
+    {
+      /* Encoded run: count pixels, 4-bit indexes alternate */
+      for (i = 0U; i < count; i++)
+      {
+        index = (rle4 == 0U) ? value : (((i & 1U) == 0U) ? (value >> 4) : (value & 0x0FU));
+        if (x < width)
+        {
+          pRow[x] = ImgPalette[index];
+        }
+        x++;
+      }
+    }
+    else if (value == 0U)
+    {
+      /* End of line */
+      done = 1U;
+    }
+    else if (value == 1U)
+    {
+      /* End of bitmap */
+      ImgImage.RleEnd = 1U;
+      done = 1U;
+    }
+    else if (value == 2U)
+    {
+      /* Delta: move right and down */
+      x    += IMG_GetByte();
+      count = IMG_GetByte();
+      if (count != 0U)
+      {
+        ImgImage.RleSkip = count - 1U;
+        ImgImage.RleX    = x;
+        done = 1U;
+      }
+    }
+    else
+    {
+      /* Absolute run: value indexes, padded to 16 bits */
+      size = (rle4 == 0U) ? value : ((value + 1U) / 2U);
+      for (i = 0U; i < value; i++)
+      {
+        if (rle4 == 0U)
+        {
+          index = IMG_GetByte();
+        }
+        else if ((i & 1U) == 0U)
+        {
+          data  = IMG_GetByte();
+          index = data >> 4;
+        }
+        else
+        {
+          index = data & 0x0FU;
+        }
+        if (x < width)
+        {
+          pRow[x] = ImgPalette[index];
+        }
+        x++;
+      }
+      if ((size & 1U) != 0U)
+      {
+        (void)IMG_GetByte();
+      }
+    }
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
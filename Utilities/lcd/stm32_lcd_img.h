@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_img.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_img.c streaming image decoder.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_IMG_H
+#define STM32_LCD_IMG_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_IMG STM32 LCD Image Decoder Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_IMG_Exported_Constants STM32 LCD Image Decoder Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_IMG_OK                  0
+#define UTIL_LCD_IMG_ERROR             (-1)
+#define UTIL_LCD_IMG_NOT_SUPPORTED     (-2)
+
+/**
+  * @brief  Bytes read from the image source at once
+  */
+#ifndef UTIL_LCD_IMG_CHUNK_SIZE
+  #define UTIL_LCD_IMG_CHUNK_SIZE        256U
+#endif
+
+/**
+  * @brief  Pixels of the decoded rows buffer, also the widest image supported
+  */
+#ifndef UTIL_LCD_IMG_BUFFER_SIZE
+  #define UTIL_LCD_IMG_BUFFER_SIZE       640U
+#endif
+
+/**
+  * @brief  BMP compression methods
+  */
+#define UTIL_LCD_IMG_BI_RGB              0U
+#define UTIL_LCD_IMG_BI_RLE8             1U
+#define UTIL_LCD_IMG_BI_RLE4             2U
+#define UTIL_LCD_IMG_BI_BITFIELDS        3U
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_IMG_Exported_Types STM32 LCD Image Decoder Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Image reader, with the BSP_OSPI_NOR_Read() signature:
+  *         Instance, destination buffer, source address and size in bytes.
+  */
+typedef int32_t (*UTIL_LCD_IMG_Read_Func)(uint32_t, uint8_t *, uint32_t, uint32_t);
+
+/**
+  * @brief  Image source
+  */
+typedef struct
+{
+  UTIL_LCD_IMG_Read_Func Read;     /*!< Reader, NULL for an image in addressable memory */
+  uint32_t               Instance; /*!< Reader instance                                 */
+  uint32_t               Address;  /*!< Image address given to the reader               */
+  const uint8_t         *pData;    /*!< Image in memory, used when Read is NULL         */
+} UTIL_LCD_IMG_Source_t;
+
+/**
+  * @brief  Image properties
+  */
+typedef struct
+{
+  uint32_t Width;        /*!< Width in pixels                             */
+  uint32_t Height;       /*!< Height in pixels                            */
+  uint32_t BitCount;     /*!< Bits per pixel: 1, 4, 8, 16, 24 or 32       */
+  uint32_t Compression;  /*!< UTIL_LCD_IMG_BI_xxx compression method      */
+  uint32_t PaletteSize;  /*!< Palette entries, 0 for direct color images  */
+} UTIL_LCD_IMG_Info_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_IMG_Exported_Functions
+  * @{
+  */
+int32_t UTIL_LCD_IMG_GetInfo(const UTIL_LCD_IMG_Source_t *pSrc, UTIL_LCD_IMG_Info_t *pInfo);
+int32_t UTIL_LCD_IMG_Draw(const UTIL_LCD_IMG_Source_t *pSrc, uint32_t Xpos, uint32_t Ypos);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_IMG_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,845 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_present.c
+  * @author  MCD Application Team
+  * @brief   This file includes a frame presenter flushing the LCD frame buffer
+  *          in step with the panel refresh, using its tearing effect signal.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver sends the dirty regions of the UTIL_LCD_FB frame buffer to
+     the panel so that each frame is displayed as a whole by one refresh of
+     the panel, instead of being torn between two refreshes.
+
+   - The panel reads its memory line after line, LinesPerFrame lines per
+     refresh period, and pulses its tearing effect (TE) line when it enters
+     the vertical blanking. On each UTIL_LCD_PRESENT_Frame() call, the
+     presenter waits for the TE edge, predicts when every line of the dirty
+     regions is written from the bus cost estimate, and starts the flush:
+       o at once if the writes stay ahead of the scan line, so that the frame
+         is displayed by the coming refresh,
+       o otherwise once the scan line has passed the dirty regions, so that
+         the frame is displayed by the next refresh,
+       o otherwise at once: the flush is too slow to avoid tearing and the
+         frame is counted in TornFrames.
+     The refresh period is measured on the TE line and the bus cost estimate
+     is updated after each flush.
+
+   - Fill a UTIL_LCD_PRESENT_Init_t structure with the display geometry, the
+     panel scan parameters, an initial bus cost and the synchronization
+     services, e.g. built on BSP_LCD_TE_Wait() and BSP_LCD_TE_GetTick(), then
+     call UTIL_LCD_PRESENT_Init(). Draw each frame with the UTIL_LCD_* services
+     into the frame buffer and call UTIL_LCD_PRESENT_Frame() in place of
+     UTIL_LCD_FB_Flush().
+
+   - With the ST7789H2 default setting (320 gate lines, 12 lines front and back
+     porches), LinesPerFrame is 344 and FirstLine is 24. The scan order is
+     UTIL_LCD_PRESENT_SCAN_TOP_DOWN in portrait, BOTTOM_UP in portrait rotated
+     by 180 degrees, RIGHT_LEFT in landscape and LEFT_RIGHT in landscape
+     rotated by 180 degrees.
+
+   - UTIL_LCD_PRESENT_GetStats() reports the frame timing: frames presented,
+     refresh periods missed, delayed and torn flushes, measured period and
+     flush durations.
+
+   - UTIL_LCD_PRESENT_SimSync and UTIL_LCD_PRESENT_SimTarget simulate the TE
+     signal and a bus of configurable bandwidth, so that the scheduling can
+     be checked on a host. The simulated panel reports the flushes that were
+     actually displayed torn:
+         UTIL_LCD_PRESENT_SimInit()
+         UTIL_LCD_PRESENT_SimAdvance()
+         UTIL_LCD_PRESENT_SimGetStats()
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_present.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_PRESENT STM32 LCD Frame Presenter Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_Defines STM32 LCD Frame Presenter Utility Private Defines
+  * @{
+  */
+#define PRESENT_SCHEDULE_AHEAD   0U  /* Flush ahead of the scan line, displayed by the coming refresh */
+#define PRESENT_SCHEDULE_BEHIND  1U  /* Flush behind the scan line, displayed by the next refresh    */
+#define PRESENT_SCHEDULE_TORN    2U  /* No tear free schedule                                        */
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_Macros STM32 LCD Frame Presenter Utility Private Macros
+  * @{
+  */
+#define MIN(X, Y)                (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y)                (((X) > (Y)) ? (X) : (Y))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_Types STM32 LCD Frame Presenter Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  const UTIL_LCD_PRESENT_Sync_t *pSync;
+  uint32_t                       Instance;
+  uint32_t                       Width;
+  uint32_t                       Height;
+  uint32_t                       ScanOrder;
+  uint32_t                       LinesPerFrame;
+  uint32_t                       FirstLine;
+  uint32_t                       WindowCost;
+  uint32_t                       LastTE;     /* Tick of the last TE edge waited for        */
+  UTIL_LCD_PRESENT_Stats_t       Stats;
+} PRESENT_Ctx_t;
+
+typedef struct
+{
+  int64_t Lo[2];  /* Earliest flush start, in 1/256 tick from the TE edge, for refresh 0 or 1 */
+  int64_t Hi[2];  /* Latest flush start, in 1/256 tick from the TE edge, for refresh 0 or 1   */
+} PRESENT_Window_t;
+
+typedef struct
+{
+  uint16_t                    *pImage;
+  uint32_t                     Width;
+  uint32_t                     Height;
+  uint32_t                     ScanOrder;
+  uint32_t                     Period;
+  uint32_t                     LinesPerFrame;
+  uint32_t                     FirstLine;
+  uint32_t                     PixelCost;
+  uint32_t                     WindowCost;
+  uint64_t                     Time;       /* Current time, in 1/256 tick                 */
+  uint32_t                     WinXpos;
+  uint32_t                     WinYpos;
+  uint32_t                     WinWidth;
+  uint32_t                     WinHeight;
+  uint32_t                     Cursor;
+  uint32_t                     Pending;    /* Pixels written since the last TE wait       */
+  uint64_t                     FirstScan;  /* Refresh displaying the first pixel written  */
+  uint32_t                     IsTorn;     /* Pixels written are displayed by several refreshes */
+  UTIL_LCD_PRESENT_SimStats_t  Stats;
+} PRESENT_SimCtx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_FunctionPrototypes STM32 LCD Frame Presenter Utility Private FunctionPrototypes
+  * @{
+  */
+static uint32_t PRESENT_Line(uint32_t ScanOrder, uint32_t Width, uint32_t Height, uint32_t Xpos, uint32_t Ypos);
+static int64_t  PRESENT_ScanTime(uint32_t Line);
+static void     PRESENT_Constrain(PRESENT_Window_t *pWindow, uint32_t Line, int64_t First, int64_t Last);
+static uint32_t PRESENT_Schedule(const UTIL_LCD_FB_Rect_t *pRects, uint32_t Count, uint32_t Elapsed, uint32_t *pStart);
+static void     PRESENT_WaitTick(uint32_t Tick);
+static void     PRESENT_Learn(const UTIL_LCD_FB_Rect_t *pRects, uint32_t Count, uint32_t Duration);
+static int32_t  PRESENT_SimWaitTE(uint32_t Instance);
+static uint32_t PRESENT_SimGetTick(uint32_t Instance);
+static void     PRESENT_SimWaitTick(uint32_t Instance, uint32_t Tick);
+static int32_t  PRESENT_SimSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height);
+static int32_t  PRESENT_SimWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length);
+static void     PRESENT_SimEndFlush(void);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_Variables STM32 LCD Frame Presenter Utility Private Variables
+  * @{
+  */
+static PRESENT_Ctx_t    PresentCtx;
+static PRESENT_SimCtx_t PresentSimCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Exported_Variables STM32 LCD Frame Presenter Utility Exported Variables
+  * @{
+  */
+const UTIL_LCD_PRESENT_Sync_t UTIL_LCD_PRESENT_SimSync =
+{
+  PRESENT_SimWaitTE,
+  PRESENT_SimGetTick,
+  PRESENT_SimWaitTick
+};
+
+const UTIL_LCD_FB_Target_t UTIL_LCD_PRESENT_SimTarget =
+{
+  PRESENT_SimSetWindow,
+  PRESENT_SimWritePixels
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Exported_Functions STM32 LCD Frame Presenter Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the presenter and measure the refresh period.
+  *         Two TE edges are waited for.
+  * @param  pInit Presenter configuration
+  * @retval UTIL_LCD_PRESENT status
+  */
+int32_t UTIL_LCD_PRESENT_Init(const UTIL_LCD_PRESENT_Init_t *pInit)
+{
+  int32_t  ret = UTIL_LCD_PRESENT_OK;
+  uint32_t lines = 0U;
+  uint32_t tick;
+
+  if ((pInit != NULL) && (pInit->ScanOrder <= UTIL_LCD_PRESENT_SCAN_BOTTOM_UP))
+  {
+    lines = pInit->Height;
+  }
+  else if ((pInit != NULL) && (pInit->ScanOrder <= UTIL_LCD_PRESENT_SCAN_RIGHT_LEFT))
+  {
+    lines = pInit->Width;
+  }
+  else
+  {
+    /* Invalid scan order */
+  }
+
+  if ((pInit == NULL) || (pInit->pSync == NULL) || (pInit->pSync->WaitTE == NULL) ||
+      (pInit->pSync->GetTick == NULL) || (pInit->Width == 0U) || (pInit->Height == 0U) || (lines == 0U) ||
+      ((pInit->FirstLine + lines) > pInit->LinesPerFrame))
+  {
+    ret = UTIL_LCD_PRESENT_ERROR;
+  }
+  else
+  {
+    PresentCtx.pSync         = pInit->pSync;
+    PresentCtx.Instance      = pInit->Instance;
+    PresentCtx.Width         = pInit->Width;
+    PresentCtx.Height        = pInit->Height;
+    PresentCtx.ScanOrder     = pInit->ScanOrder;
+    PresentCtx.LinesPerFrame = pInit->LinesPerFrame;
+    PresentCtx.FirstLine     = pInit->FirstLine;
+    PresentCtx.WindowCost    = pInit->WindowCost;
+    UTIL_LCD_PRESENT_ResetStats();
+    PresentCtx.Stats.PixelCost = pInit->PixelCost;
+
+    /* Measure the refresh period between two TE edges */
+    if (PresentCtx.pSync->WaitTE(PresentCtx.Instance) != 0)
+    {
+      ret = UTIL_LCD_PRESENT_ERROR;
+    }
+    else
+    {
+      tick = PresentCtx.pSync->GetTick(PresentCtx.Instance);
+      if (PresentCtx.pSync->WaitTE(PresentCtx.Instance) != 0)
+      {
+        ret = UTIL_LCD_PRESENT_ERROR;
+      }
+      else
+      {
+        PresentCtx.LastTE       = PresentCtx.pSync->GetTick(PresentCtx.Instance);
+        PresentCtx.Stats.Period = PresentCtx.LastTE - tick;
+        if (PresentCtx.Stats.Period == 0U)
+        {
+          ret = UTIL_LCD_PRESENT_ERROR;
+        }
+      }
+    }
+
+    if (ret != UTIL_LCD_PRESENT_OK)
+    {
+      PresentCtx.pSync = NULL;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Present the frame drawn in the frame buffer: wait for the next TE
+  *         edge and flush the dirty regions when they can be written without
+  *         tearing.
+  * @retval UTIL_LCD_PRESENT status
+  */
+int32_t UTIL_LCD_PRESENT_Frame(void)
+{
+  int32_t            ret = UTIL_LCD_PRESENT_OK;
+  UTIL_LCD_FB_Rect_t rects[UTIL_LCD_FB_MAX_DIRTY_RECTS];
+  uint32_t           count, te, start, duration, periods, schedule;
+
+  if (PresentCtx.pSync == NULL)
+  {
+    ret = UTIL_LCD_PRESENT_ERROR;
+  }
+  else
+  {
+    count = UTIL_LCD_FB_GetDirtyRects(rects, UTIL_LCD_FB_MAX_DIRTY_RECTS);
+
+    if (PresentCtx.pSync->WaitTE(PresentCtx.Instance) != 0)
+    {
+      ret = UTIL_LCD_PRESENT_ERROR;
+    }
+    else
+    {
+      te = PresentCtx.pSync->GetTick(PresentCtx.Instance);
+
+      /* Refresh periods elapsed since the previous frame */
+      periods = ((te - PresentCtx.LastTE) + (PresentCtx.Stats.Period / 2U)) / PresentCtx.Stats.Period;
+      if (periods == 1U)
+      {
+        PresentCtx.Stats.Period = ((3U * PresentCtx.Stats.Period) + (te - PresentCtx.LastTE) + 2U) / 4U;
+      }
+      else if ((periods > 1U) && (PresentCtx.Stats.FrameCount != 0U))
+      {
+        PresentCtx.Stats.MissedFrames += periods - 1U;
+      }
+      else
+      {
+        /* First frame */
+      }
+      PresentCtx.LastTE = te;
+
+      if (count != 0U)
+      {
+        schedule = PRESENT_Schedule(rects, count, PresentCtx.pSync->GetTick(PresentCtx.Instance) - te, &start);
+        if (schedule == PRESENT_SCHEDULE_BEHIND)
+        {
+          PresentCtx.Stats.DelayedFlushes++;
+        }
+        else if (schedule == PRESENT_SCHEDULE_TORN)
+        {
+          PresentCtx.Stats.TornFrames++;
+        }
+        else
+        {
+          /* Flush at once */
+        }
+        PRESENT_WaitTick(te + start);
+
+        start = PresentCtx.pSync->GetTick(PresentCtx.Instance);
+        if (UTIL_LCD_FB_Flush() != UTIL_LCD_FB_OK)
+        {
+          ret = UTIL_LCD_PRESENT_ERROR;
+        }
+        duration = PresentCtx.pSync->GetTick(PresentCtx.Instance) - start;
+
+        PresentCtx.Stats.LastFlushTime = duration;
+        if (duration > PresentCtx.Stats.MaxFlushTime)
+        {
+          PresentCtx.Stats.MaxFlushTime = duration;
+        }
+
+        /* A failed flush stopped part way: its duration does not give the bus cost */
+        if (ret == UTIL_LCD_PRESENT_OK)
+        {
+          PRESENT_Learn(rects, count, duration);
+        }
+      }
+
+      PresentCtx.Stats.FrameCount++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the frame timing statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_LCD_PRESENT_GetStats(UTIL_LCD_PRESENT_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = PresentCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the frame timing counters, the measured period and the bus
+  *         cost estimate are kept.
+  */
+void UTIL_LCD_PRESENT_ResetStats(void)
+{
+  PresentCtx.Stats.FrameCount     = 0U;
+  PresentCtx.Stats.MissedFrames   = 0U;
+  PresentCtx.Stats.DelayedFlushes = 0U;
+  PresentCtx.Stats.TornFrames     = 0U;
+  PresentCtx.Stats.LastFlushTime  = 0U;
+  PresentCtx.Stats.MaxFlushTime   = 0U;
+}
+
+/**
+  * @brief  Initialize the simulated panel and bus. The simulated time starts
+  *         on a TE edge.
+  * @param  pInit Simulated panel and bus configuration
+  * @retval UTIL_LCD_PRESENT status
+  */
+int32_t UTIL_LCD_PRESENT_SimInit(const UTIL_LCD_PRESENT_SimInit_t *pInit)
+{
+  int32_t ret = UTIL_LCD_PRESENT_OK;
+
+  if ((pInit == NULL) || (pInit->Width == 0U) || (pInit->Height == 0U) ||
+      (pInit->ScanOrder > UTIL_LCD_PRESENT_SCAN_RIGHT_LEFT) || (pInit->Period == 0U) ||
+      (pInit->LinesPerFrame == 0U))
+  {
+    ret = UTIL_LCD_PRESENT_ERROR;
+  }
+  else
+  {
+    PresentSimCtx.pImage            = pInit->pImage;
+    PresentSimCtx.Width             = pInit->Width;
+    PresentSimCtx.Height            = pInit->Height;
+    PresentSimCtx.ScanOrder         = pInit->ScanOrder;
+    PresentSimCtx.Period            = pInit->Period;
+    PresentSimCtx.LinesPerFrame     = pInit->LinesPerFrame;
+    PresentSimCtx.FirstLine         = pInit->FirstLine;
+    PresentSimCtx.PixelCost         = pInit->PixelCost;
+    PresentSimCtx.WindowCost        = pInit->WindowCost;
+    PresentSimCtx.Time              = 0U;
+    PresentSimCtx.WinXpos           = 0U;
+    PresentSimCtx.WinYpos           = 0U;
+    PresentSimCtx.WinWidth          = pInit->Width;
+    PresentSimCtx.WinHeight         = pInit->Height;
+    PresentSimCtx.Cursor            = 0U;
+    PresentSimCtx.Pending           = 0U;
+    PresentSimCtx.Stats.Time        = 0U;
+    PresentSimCtx.Stats.TECount     = 0U;
+    PresentSimCtx.Stats.WindowCount = 0U;
+    PresentSimCtx.Stats.PixelCount  = 0U;
+    PresentSimCtx.Stats.FlushCount  = 0U;
+    PresentSimCtx.Stats.TornFlushes = 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Let the simulated time run, e.g. to model the rendering of a frame.
+  * @param  Ticks Number of ticks
+  */
+void UTIL_LCD_PRESENT_SimAdvance(uint32_t Ticks)
+{
+  PresentSimCtx.Time += (uint64_t)Ticks << 8;
+}
+
+/**
+  * @brief  Get the simulated panel statistics. The pixels written since the
+  *         last TE wait are accounted as a flush.
+  * @param  pStats Statistics
+  */
+void UTIL_LCD_PRESENT_SimGetStats(UTIL_LCD_PRESENT_SimStats_t *pStats)
+{
+  PRESENT_SimEndFlush();
+
+  if (pStats != NULL)
+  {
+    PresentSimCtx.Stats.Time = (uint32_t)(PresentSimCtx.Time >> 8);
+    *pStats = PresentSimCtx.Stats;
+  }
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Private_Functions STM32 LCD Frame Presenter Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Get the panel line scanning a pixel.
+  * @param  ScanOrder UTIL_LCD_PRESENT_SCAN_xxx
+  * @param  Width     Display width
+  * @param  Height    Display height
+  * @param  Xpos      X position
+  * @param  Ypos      Y position
+  * @retval Line index, 0 for the first line scanned
+  */
+static uint32_t PRESENT_Line(uint32_t ScanOrder, uint32_t Width, uint32_t Height, uint32_t Xpos, uint32_t Ypos)
+{
+  uint32_t line;
+
+  switch (ScanOrder)
+  {
+    case UTIL_LCD_PRESENT_SCAN_TOP_DOWN:
+      line = Ypos;
+      break;
+    case UTIL_LCD_PRESENT_SCAN_BOTTOM_UP:
+      line = Height - 1U - Ypos;
+      break;
+    case UTIL_LCD_PRESENT_SCAN_LEFT_RIGHT:
+      line = Xpos;
+      break;
+    default:
+      line = Width - 1U - Xpos;
+      break;
+  }
+
+  return line;
+}
+
+/**
+  * @brief  Get the time the panel reads a line, from the TE edge.
+  * @param  Line Line index
+  * @retval Time in 1/256 tick
+  */
+static int64_t PRESENT_ScanTime(uint32_t Line)
+{
+  return (int64_t)((((uint64_t)PresentCtx.FirstLine + Line) * PresentCtx.Stats.Period * 256U) /
+                   PresentCtx.LinesPerFrame);
+}
+
+/**
+  * @brief  Restrict the flush start so that a line is written between two
+  *         reads of the panel: before the coming read to be displayed by the
+  *         coming refresh, or between the coming read and the next one.
+  * @param  pWindow Flush start windows
+  * @param  Line    Line index
+  * @param  First   Earliest write of the line, in 1/256 tick from the flush start
+  * @param  Last    Latest write of the line, in 1/256 tick from the flush start
+  */
+static void PRESENT_Constrain(PRESENT_Window_t *pWindow, uint32_t Line, int64_t First, int64_t Last)
+{
+  int64_t scan   = PRESENT_ScanTime(Line);
+  int64_t period = (int64_t)PresentCtx.Stats.Period * 256;
+
+  pWindow->Lo[0] = MAX(pWindow->Lo[0], (scan - period) - First + 1);
+  pWindow->Hi[0] = MIN(pWindow->Hi[0], scan - Last);
+  pWindow->Lo[1] = MAX(pWindow->Lo[1], scan - First + 1);
+  pWindow->Hi[1] = MIN(pWindow->Hi[1], (scan + period) - Last);
+}
+
+/**
+  * @brief  Choose the flush start of the dirty regions.
+  *         Regions are flushed in order, one window each, row after row.
+  *         The write time of a line changes linearly along a region, so only
+  *         its first and last lines are checked. Earliest writes are predicted
+  *         with a bus faster than the estimate and latest writes with a bus
+  *         slower than the estimate, by UTIL_LCD_PRESENT_MARGIN percent.
+  * @param  pRects  Dirty regions
+  * @param  Count   Number of dirty regions
+  * @param  Elapsed Ticks elapsed since the TE edge
+  * @param  pStart  Flush start, in ticks from the TE edge
+  * @retval PRESENT_SCHEDULE_AHEAD, PRESENT_SCHEDULE_BEHIND or PRESENT_SCHEDULE_TORN
+  */
+static uint32_t PRESENT_Schedule(const UTIL_LCD_FB_Rect_t *pRects, uint32_t Count, uint32_t Elapsed, uint32_t *pStart)
+{
+  PRESENT_Window_t window;
+  uint32_t         i, x0, y0, x1, y1;
+  uint32_t         schedule = PRESENT_SCHEDULE_TORN;
+  int64_t          fast_pixel, slow_pixel, fast_window, slow_window;
+  int64_t          fast_row, slow_row, fast, slow;
+  int64_t          start;
+
+  fast_pixel  = ((int64_t)PresentCtx.Stats.PixelCost * (100 - (int64_t)UTIL_LCD_PRESENT_MARGIN)) / 100;
+  slow_pixel  = (((int64_t)PresentCtx.Stats.PixelCost * (100 + (int64_t)UTIL_LCD_PRESENT_MARGIN)) / 100) + 1;
+  fast_window = ((int64_t)PresentCtx.WindowCost * 256 * (100 - (int64_t)UTIL_LCD_PRESENT_MARGIN)) / 100;
+  slow_window = ((int64_t)PresentCtx.WindowCost * 256 * (100 + (int64_t)UTIL_LCD_PRESENT_MARGIN)) / 100;
+
+  window.Lo[0] = (int64_t)Elapsed * 256;
+  window.Lo[1] = window.Lo[0];
+  window.Hi[0] = INT64_MAX;
+  window.Hi[1] = INT64_MAX;
+
+  fast = 0;
+  slow = 0;
+  for (i = 0U; i < Count; i++)
+  {
+    x0 = pRects[i].Xpos;
+    y0 = pRects[i].Ypos;
+    x1 = x0 + pRects[i].Width - 1U;
+    y1 = y0 + pRects[i].Height - 1U;
+
+    fast    += fast_window;
+    slow    += slow_window;
+    fast_row = fast_pixel * pRects[i].Width;
+    slow_row = slow_pixel * pRects[i].Width;
+
+    if (PresentCtx.ScanOrder <= UTIL_LCD_PRESENT_SCAN_BOTTOM_UP)
+    {
+      /* A line is a row of the region */
+      PRESENT_Constrain(&window, PRESENT_Line(PresentCtx.ScanOrder, PresentCtx.Width, PresentCtx.Height, x0, y0),
+                        fast, slow + slow_row);
+      PRESENT_Constrain(&window, PRESENT_Line(PresentCtx.ScanOrder, PresentCtx.Width, PresentCtx.Height, x0, y1),
+                        fast + (fast_row * (int64_t)(pRects[i].Height - 1U)), slow + (slow_row * pRects[i].Height));
+    }
+    else
+    {
+      /* A line is a column of the region, written by every row */
+      PRESENT_Constrain(&window, PRESENT_Line(PresentCtx.ScanOrder, PresentCtx.Width, PresentCtx.Height, x0, y0),
+                        fast, slow + (slow_row * (int64_t)(pRects[i].Height - 1U)) + slow_pixel);
+      PRESENT_Constrain(&window, PRESENT_Line(PresentCtx.ScanOrder, PresentCtx.Width, PresentCtx.Height, x1, y0),
+                        fast + (fast_pixel * (int64_t)(pRects[i].Width - 1U)), slow + (slow_row * pRects[i].Height));
+    }
+
+    fast += fast_row * pRects[i].Height;
+    slow += slow_row * pRects[i].Height;
+  }
+
+  /* Flush starts are rounded up to a tick */
+  start = (window.Lo[0] + 255) & ~(int64_t)255;
+  if (start <= window.Hi[0])
+  {
+    schedule = PRESENT_SCHEDULE_AHEAD;
+  }
+  else
+  {
+    start = (window.Lo[1] + 255) & ~(int64_t)255;
+    if (start <= window.Hi[1])
+    {
+      schedule = PRESENT_SCHEDULE_BEHIND;
+    }
+    else
+    {
+      start = (int64_t)Elapsed * 256;
+    }
+  }
+
+  *pStart = (uint32_t)(start >> 8);
+
+  return schedule;
+}
+
+/**
+  * @brief  Wait until the tick counter reaches a tick.
+  * @param  Tick Tick to wait for
+  */
+static void PRESENT_WaitTick(uint32_t Tick)
+{
+  if (PresentCtx.pSync->WaitTick != NULL)
+  {
+    PresentCtx.pSync->WaitTick(PresentCtx.Instance, Tick);
+  }
+  else
+  {
+    while ((int32_t)(Tick - PresentCtx.pSync->GetTick(PresentCtx.Instance)) > 0)
+    {
+    }
+  }
+}
+
+/**
+  * @brief  Update the bus cost estimate from a flush duration.
+  * @param  pRects   Dirty regions flushed
+  * @param  Count    Number of dirty regions
+  * @param  Duration Flush duration in ticks
+  */
+static void PRESENT_Learn(const UTIL_LCD_FB_Rect_t *pRects, uint32_t Count, uint32_t Duration)
+{
+  uint32_t i;
+  uint64_t pixels = 0U;
+  uint64_t windows = (uint64_t)Count * PresentCtx.WindowCost;
+  uint64_t cost;
+
+  for (i = 0U; i < Count; i++)
+  {
+    pixels += (uint64_t)pRects[i].Width * pRects[i].Height;
+  }
+
+  if ((pixels != 0U) && (Duration > windows))
+  {
+    cost = (((uint64_t)Duration - windows) << 8) / pixels;
+    PresentCtx.Stats.PixelCost = (uint32_t)(((3U * (uint64_t)PresentCtx.Stats.PixelCost) + cost + 2U) / 4U);
+  }
+}
+
+/**
+  * @brief  Simulated TE wait: end the flush in progress and run to the next
+  *         TE edge.
+  * @param  Instance Unused
+  * @retval 0
+  */
+static int32_t PRESENT_SimWaitTE(uint32_t Instance)
+{
+  uint64_t period = (uint64_t)PresentSimCtx.Period << 8;
+
+  (void)Instance;
+
+  PRESENT_SimEndFlush();
+
+  PresentSimCtx.Time = ((PresentSimCtx.Time / period) + 1U) * period;
+  PresentSimCtx.Stats.TECount++;
+
+  return 0;
+}
+
+/**
+  * @brief  Simulated tick counter.
+  * @param  Instance Unused
+  * @retval Current tick
+  */
+static uint32_t PRESENT_SimGetTick(uint32_t Instance)
+{
+  (void)Instance;
+
+  return (uint32_t)(PresentSimCtx.Time >> 8);
+}
+
+/**
+  * @brief  Simulated wait: run to a tick.
+  * @param  Instance Unused
+  * @param  Tick     Tick to wait for
+  */
+static void PRESENT_SimWaitTick(uint32_t Instance, uint32_t Tick)
+{
+  uint32_t now = (uint32_t)(PresentSimCtx.Time >> 8);
+
+  (void)Instance;
+
+  if ((int32_t)(Tick - now) > 0)
+  {
+    PresentSimCtx.Time = ((PresentSimCtx.Time >> 8) + (Tick - now)) << 8;
+  }
+}
+
+/**
+  * @brief  Simulated bus: open a window.
+  * @param  Instance Unused
+  * @param  Xpos     X position
+  * @param  Ypos     Y position
+  * @param  Width    Window width
+  * @param  Height   Window height
+  * @retval 0 if the window fits in the display, -1 otherwise
+  */
+static int32_t PRESENT_SimSetWindow(uint32_t Instance, uint32_t Xpos, uint32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t ret = 0;
+
+  (void)Instance;
+
+  if ((Width == 0U) || (Height == 0U) ||
+      (Xpos >= PresentSimCtx.Width) || (Width > (PresentSimCtx.Width - Xpos)) ||
+      (Ypos >= PresentSimCtx.Height) || (Height > (PresentSimCtx.Height - Ypos)))
+  {
+    ret = -1;
+  }
+  else
+  {
+    PresentSimCtx.WinXpos   = Xpos;
+    PresentSimCtx.WinYpos   = Ypos;
+    PresentSimCtx.WinWidth  = Width;
+    PresentSimCtx.WinHeight = Height;
+    PresentSimCtx.Cursor    = 0U;
+    PresentSimCtx.Time     += (uint64_t)PresentSimCtx.WindowCost << 8;
+    PresentSimCtx.Stats.WindowCount++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Simulated bus: write pixels in the window. Each pixel takes
+  *         PixelCost and is displayed by the first refresh reading its line
+  *         after it is written.
+  * @param  Instance Unused
+  * @param  pData    RGB565 pixels
+  * @param  Length   Number of pixels
+  * @retval 0
+  */
+static int32_t PRESENT_SimWritePixels(uint32_t Instance, uint8_t *pData, uint32_t Length)
+{
+  uint32_t i, x, y, line;
+  uint64_t period = (uint64_t)PresentSimCtx.Period << 8;
+  uint64_t scan, refresh;
+
+  (void)Instance;
+
+  for (i = 0U; i < Length; i++)
+  {
+    x = PresentSimCtx.WinXpos + (PresentSimCtx.Cursor % PresentSimCtx.WinWidth);
+    y = PresentSimCtx.WinYpos + (PresentSimCtx.Cursor / PresentSimCtx.WinWidth);
+
+    PresentSimCtx.Time += PresentSimCtx.PixelCost;
+    if (PresentSimCtx.pImage != NULL)
+    {
+      PresentSimCtx.pImage[(y * PresentSimCtx.Width) + x] = (uint16_t)((uint32_t)pData[2U * i] |
+                                                                       ((uint32_t)pData[(2U * i) + 1U] << 8));
+    }
+
+    /* First refresh reading the line at or after the write */
+    line = PRESENT_Line(PresentSimCtx.ScanOrder, PresentSimCtx.Width, PresentSimCtx.Height, x, y);
+    scan = ((((uint64_t)PresentSimCtx.FirstLine + line) * period) / PresentSimCtx.LinesPerFrame);
+    refresh = (PresentSimCtx.Time <= scan) ? 0U : (((PresentSimCtx.Time - scan) + period - 1U) / period);
+
+    if (PresentSimCtx.Pending == 0U)
+    {
+      PresentSimCtx.FirstScan = refresh;
+      PresentSimCtx.IsTorn    = 0U;
+    }
+    else if (refresh != PresentSimCtx.FirstScan)
+    {
+      PresentSimCtx.IsTorn = 1U;
+    }
+    else
+    {
+      /* Displayed by the same refresh */
+    }
+    PresentSimCtx.Pending++;
+
+    /* Memory write wraps at the end of the window */
+    PresentSimCtx.Cursor = (PresentSimCtx.Cursor + 1U) % (PresentSimCtx.WinWidth * PresentSimCtx.WinHeight);
+  }
+  PresentSimCtx.Stats.PixelCount += Length;
+
+  return 0;
+}
+
+/**
+  * @brief  Account the pixels written since the last TE wait as a flush.
+  */
+static void PRESENT_SimEndFlush(void)
+{
+  if (PresentSimCtx.Pending != 0U)
+  {
+    PresentSimCtx.Stats.FlushCount++;
+    if (PresentSimCtx.IsTorn != 0U)
+    {
+      PresentSimCtx.Stats.TornFlushes++;
+    }
+    PresentSimCtx.Pending = 0U;
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,199 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_present.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_present.c tearing effect synchronized presenter.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_PRESENT_H
+#define STM32_LCD_PRESENT_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_fb.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_PRESENT STM32 LCD Frame Presenter Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Exported_Constants STM32 LCD Frame Presenter Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_PRESENT_OK                0
+#define UTIL_LCD_PRESENT_ERROR           (-1)
+
+/* Order in which the panel scans the display */
+#define UTIL_LCD_PRESENT_SCAN_TOP_DOWN     0U  /* Rows, from Y = 0          */
+#define UTIL_LCD_PRESENT_SCAN_BOTTOM_UP    1U  /* Rows, from Y = Height - 1 */
+#define UTIL_LCD_PRESENT_SCAN_LEFT_RIGHT   2U  /* Columns, from X = 0       */
+#define UTIL_LCD_PRESENT_SCAN_RIGHT_LEFT   3U  /* Columns, from X = Width-1 */
+
+/**
+  * @brief  Margin applied to the predicted flush timings, in percent of the
+  *         estimated bus cost
+  */
+#ifndef UTIL_LCD_PRESENT_MARGIN
+  #define UTIL_LCD_PRESENT_MARGIN          10U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Exported_Types STM32 LCD Frame Presenter Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Synchronization services.
+  *         WaitTE returns on the next tearing effect rising edge, i.e. at the
+  *         beginning of the vertical blanking. GetTick returns a free running
+  *         32-bit tick counter. WaitTick waits until GetTick reaches the given
+  *         tick; when NULL, GetTick is polled.
+  */
+typedef struct
+{
+  int32_t  ( *WaitTE          ) (uint32_t);
+  uint32_t ( *GetTick         ) (uint32_t);
+  void     ( *WaitTick        ) (uint32_t, uint32_t);
+} UTIL_LCD_PRESENT_Sync_t;
+
+/**
+  * @brief  Presenter configuration
+  */
+typedef struct
+{
+  uint32_t                       Instance;      /*!< Instance passed to the synchronization services        */
+  uint32_t                       Width;         /*!< Display width in pixels                                */
+  uint32_t                       Height;        /*!< Display height in pixels                               */
+  uint32_t                       ScanOrder;     /*!< UTIL_LCD_PRESENT_SCAN_xxx                              */
+  uint32_t                       LinesPerFrame; /*!< Lines scanned per refresh period, blanking included    */
+  uint32_t                       FirstLine;     /*!< Lines scanned from the TE rising edge to the display   */
+  uint32_t                       PixelCost;     /*!< Initial bus cost estimate, in 1/256 tick per pixel     */
+  uint32_t                       WindowCost;    /*!< Bus cost of opening a window, in ticks                 */
+  const UTIL_LCD_PRESENT_Sync_t *pSync;         /*!< Synchronization services                               */
+} UTIL_LCD_PRESENT_Init_t;
+
+/**
+  * @brief  Frame timing statistics
+  */
+typedef struct
+{
+  uint32_t FrameCount;     /*!< Frames presented                                       */
+  uint32_t MissedFrames;   /*!< Refresh periods elapsed without a new frame presented  */
+  uint32_t DelayedFlushes; /*!< Flushes started behind the scan line                   */
+  uint32_t TornFrames;     /*!< Flushes that could not be scheduled without tearing    */
+  uint32_t Period;         /*!< Measured refresh period, in ticks                      */
+  uint32_t LastFlushTime;  /*!< Duration of the last flush, in ticks                   */
+  uint32_t MaxFlushTime;   /*!< Longest flush duration, in ticks                       */
+  uint32_t PixelCost;      /*!< Bus cost estimate, in 1/256 tick per pixel             */
+} UTIL_LCD_PRESENT_Stats_t;
+
+/**
+  * @brief  Simulated panel and bus configuration
+  */
+typedef struct
+{
+  uint16_t *pImage;        /*!< RGB565 image of the panel, may be NULL     */
+  uint32_t  Width;         /*!< Display width in pixels                     */
+  uint32_t  Height;        /*!< Display height in pixels                    */
+  uint32_t  ScanOrder;     /*!< UTIL_LCD_PRESENT_SCAN_xxx                   */
+  uint32_t  Period;        /*!< Refresh period, in ticks                    */
+  uint32_t  LinesPerFrame; /*!< Lines scanned per refresh period            */
+  uint32_t  FirstLine;     /*!< Lines scanned from the TE edge to the display */
+  uint32_t  PixelCost;     /*!< Bus cost, in 1/256 tick per pixel           */
+  uint32_t  WindowCost;    /*!< Bus cost of opening a window, in ticks      */
+} UTIL_LCD_PRESENT_SimInit_t;
+
+/**
+  * @brief  Simulated panel statistics
+  */
+typedef struct
+{
+  uint32_t Time;           /*!< Current time, in ticks                               */
+  uint32_t TECount;        /*!< TE edges waited for                                  */
+  uint32_t WindowCount;    /*!< Windows opened                                       */
+  uint32_t PixelCount;     /*!< Pixels written                                       */
+  uint32_t FlushCount;     /*!< Flushes, i.e. writes between two TE waits            */
+  uint32_t TornFlushes;    /*!< Flushes not displayed as a whole in a single refresh */
+} UTIL_LCD_PRESENT_SimStats_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_PRESENT_Exported_Variables STM32 LCD Frame Presenter Utility Exported Variables
+  * @{
+  */
+extern const UTIL_LCD_PRESENT_Sync_t UTIL_LCD_PRESENT_SimSync;
+extern const UTIL_LCD_FB_Target_t    UTIL_LCD_PRESENT_SimTarget;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_PRESENT_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_LCD_PRESENT_Init(const UTIL_LCD_PRESENT_Init_t *pInit);
+int32_t  UTIL_LCD_PRESENT_Frame(void);
+void     UTIL_LCD_PRESENT_GetStats(UTIL_LCD_PRESENT_Stats_t *pStats);
+void     UTIL_LCD_PRESENT_ResetStats(void);
+
+/* Simulated panel and bus */
+int32_t  UTIL_LCD_PRESENT_SimInit(const UTIL_LCD_PRESENT_SimInit_t *pInit);
+void     UTIL_LCD_PRESENT_SimAdvance(uint32_t Ticks);
+void     UTIL_LCD_PRESENT_SimGetStats(UTIL_LCD_PRESENT_SimStats_t *pStats);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_PRESENT_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
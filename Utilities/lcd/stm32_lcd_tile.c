@@ -0,0 +1,490 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_tile.c
+  * @author  MCD Application Team
+  * @brief   This file includes a tile map and sprite engine for the STM32 LCD
+  *          utility: only the tiles changed or touched by a sprite since the
+  *          last render are sent to the display.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - A map is a grid of Columns x Rows cells, each one showing a tile of the
+     tile cache. Tiles are TileWidth x TileHeight RGB565 pixels, copied once
+     in the cache with UTIL_LCD_TILE_LoadTile(). Sprites are RGB565 images
+     with a transparent color key, drawn over the tiles.
+
+   - Set up a map:
+         fill Xpos, Ypos, TileWidth, TileHeight, Columns, Rows, pCells (the
+         tile indexes), pTiles and TileCount of a UTIL_LCD_TILE_Map_t
+         UTIL_LCD_TILE_Init()
+         UTIL_LCD_TILE_LoadTile() for each tile
+         UTIL_LCD_TILE_SetSprite() for each sprite
+     then draw a frame with UTIL_LCD_TILE_SetCell(), UTIL_LCD_TILE_MoveSprite(),
+     UTIL_LCD_TILE_ShowSprite() and UTIL_LCD_TILE_Render().
+
+   - The cells changed and the cells covered by a sprite before and after a
+     change are marked dirty (bit 15 of the cell). UTIL_LCD_TILE_Render()
+     composes the dirty cells only, tile then sprites, and sends adjacent
+     dirty cells of a row in one UTIL_LCD_FillRGBRect() call while they fit
+     in UTIL_LCD_TILE_BUFFER_SIZE pixels. A moving 16x16 sprite costs at
+     most a few tiles per frame instead of a repaint of the whole area.
+
+   - UTIL_LCD_TILE_Invalidate() marks the whole map dirty, e.g. after the
+     display was drawn over by other services.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd_tile.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_LCD_TILE STM32 LCD Tile Map Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_TILE_Private_Defines STM32 LCD Tile Map Utility Private Defines
+  * @{
+  */
+#define TILE_DIRTY        0x8000U  /* Cell to be drawn by the next render */
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Private_Macros STM32 LCD Tile Map Utility Private Macros
+  * @{
+  */
+#define MIN(X, Y)         (((X) < (Y)) ? (X) : (Y))
+#define MAX(X, Y)         (((X) > (Y)) ? (X) : (Y))
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Private_FunctionPrototypes STM32 LCD Tile Map Utility Private FunctionPrototypes
+  * @{
+  */
+static void TILE_MarkArea(UTIL_LCD_TILE_Map_t *pMap, int32_t Xpos, int32_t Ypos, uint32_t Width, uint32_t Height);
+static void TILE_MarkSprite(UTIL_LCD_TILE_Map_t *pMap, const UTIL_LCD_TILE_Sprite_t *pSprite);
+static void TILE_Compose(const UTIL_LCD_TILE_Map_t *pMap, uint32_t Column, uint32_t Row, uint16_t *pDst,
+                         uint32_t Stride);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Private_Variables STM32 LCD Tile Map Utility Private Variables
+  * @{
+  */
+static uint16_t TileBuffer[UTIL_LCD_TILE_BUFFER_SIZE];
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Exported_Functions STM32 LCD Tile Map Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Check the map configuration, remove the sprites and mark the whole
+  *         map dirty.
+  * @param  pMap Map, configuration fields set
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_Init(UTIL_LCD_TILE_Map_t *pMap)
+{
+  int32_t  ret = UTIL_LCD_TILE_OK;
+  uint32_t i;
+
+  if ((pMap == NULL) || (pMap->pCells == NULL) || (pMap->pTiles == NULL) || (pMap->TileCount == 0U) ||
+      (pMap->TileCount > (UTIL_LCD_TILE_MAX_INDEX + 1U)) || (pMap->Columns == 0U) || (pMap->Rows == 0U) ||
+      (pMap->TileWidth == 0U) || (pMap->TileHeight == 0U) ||
+      ((pMap->TileWidth * pMap->TileHeight) > UTIL_LCD_TILE_BUFFER_SIZE))
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    (void)memset(pMap->Sprites, 0, sizeof(pMap->Sprites));
+    pMap->TilesDrawn = 0U;
+    pMap->Writes     = 0U;
+
+    for (i = 0U; i < (pMap->Columns * pMap->Rows); i++)
+    {
+      pMap->pCells[i] &= (uint16_t)~TILE_DIRTY;
+      if (pMap->pCells[i] >= pMap->TileCount)
+      {
+        ret = UTIL_LCD_TILE_ERROR;
+      }
+      pMap->pCells[i] |= (uint16_t)TILE_DIRTY;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Copy a tile in the tile cache, the cells showing it are marked
+  *         dirty.
+  * @param  pMap  Map
+  * @param  Index Tile index
+  * @param  pData TileWidth x TileHeight RGB565 pixels
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_LoadTile(UTIL_LCD_TILE_Map_t *pMap, uint32_t Index, const uint16_t *pData)
+{
+  int32_t  ret = UTIL_LCD_TILE_OK;
+  uint32_t size = pMap->TileWidth * pMap->TileHeight;
+  uint32_t i;
+
+  if ((Index >= pMap->TileCount) || (pData == NULL))
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    (void)memcpy(&pMap->pTiles[Index * size], pData, size * sizeof(uint16_t));
+
+    for (i = 0U; i < (pMap->Columns * pMap->Rows); i++)
+    {
+      if ((pMap->pCells[i] & (uint16_t)~TILE_DIRTY) == Index)
+      {
+        pMap->pCells[i] |= (uint16_t)TILE_DIRTY;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Set the tile shown by a cell.
+  * @param  pMap   Map
+  * @param  Column Cell column
+  * @param  Row    Cell row
+  * @param  Index  Tile index
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_SetCell(UTIL_LCD_TILE_Map_t *pMap, uint32_t Column, uint32_t Row, uint32_t Index)
+{
+  int32_t   ret = UTIL_LCD_TILE_OK;
+  uint16_t *pCell;
+
+  if ((Column >= pMap->Columns) || (Row >= pMap->Rows) || (Index >= pMap->TileCount))
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    pCell = &pMap->pCells[(Row * pMap->Columns) + Column];
+    if ((*pCell & (uint16_t)~TILE_DIRTY) != Index)
+    {
+      *pCell = (uint16_t)(Index | TILE_DIRTY);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Set the image of a sprite, its position and visibility are kept.
+  * @param  pMap     Map
+  * @param  Id       Sprite index, lower than UTIL_LCD_TILE_MAX_SPRITES
+  * @param  pData    Width x Height RGB565 pixels
+  * @param  Width    Sprite width
+  * @param  Height   Sprite height
+  * @param  ColorKey Transparent color
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_SetSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, const uint16_t *pData, uint32_t Width,
+                                uint32_t Height, uint16_t ColorKey)
+{
+  int32_t                 ret = UTIL_LCD_TILE_OK;
+  UTIL_LCD_TILE_Sprite_t *pSprite;
+
+  if ((Id >= UTIL_LCD_TILE_MAX_SPRITES) || (pData == NULL))
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    pSprite = &pMap->Sprites[Id];
+
+    TILE_MarkSprite(pMap, pSprite);
+    pSprite->pData    = pData;
+    pSprite->Width    = Width;
+    pSprite->Height   = Height;
+    pSprite->ColorKey = ColorKey;
+    TILE_MarkSprite(pMap, pSprite);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Move a sprite.
+  * @param  pMap Map
+  * @param  Id   Sprite index
+  * @param  X    X position, relative to the map, may be negative
+  * @param  Y    Y position, relative to the map, may be negative
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_MoveSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, int32_t X, int32_t Y)
+{
+  int32_t                 ret = UTIL_LCD_TILE_OK;
+  UTIL_LCD_TILE_Sprite_t *pSprite;
+
+  if (Id >= UTIL_LCD_TILE_MAX_SPRITES)
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    pSprite = &pMap->Sprites[Id];
+
+    if ((pSprite->X != X) || (pSprite->Y != Y))
+    {
+      TILE_MarkSprite(pMap, pSprite);
+      pSprite->X = X;
+      pSprite->Y = Y;
+      TILE_MarkSprite(pMap, pSprite);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Show or hide a sprite.
+  * @param  pMap    Map
+  * @param  Id      Sprite index
+  * @param  Visible 1 to show the sprite, 0 to hide it
+  * @retval UTIL_LCD_TILE_OK or UTIL_LCD_TILE_ERROR
+  */
+int32_t UTIL_LCD_TILE_ShowSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, uint32_t Visible)
+{
+  int32_t                 ret = UTIL_LCD_TILE_OK;
+  UTIL_LCD_TILE_Sprite_t *pSprite;
+  uint8_t                 visible = (Visible != 0U) ? 1U : 0U;
+
+  if ((Id >= UTIL_LCD_TILE_MAX_SPRITES) || (pMap->Sprites[Id].pData == NULL))
+  {
+    ret = UTIL_LCD_TILE_ERROR;
+  }
+  else
+  {
+    pSprite = &pMap->Sprites[Id];
+
+    if (pSprite->Visible != visible)
+    {
+      /* Mark the area while the sprite is visible */
+      pSprite->Visible = 1U;
+      TILE_MarkSprite(pMap, pSprite);
+      pSprite->Visible = visible;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Mark the whole map dirty.
+  * @param  pMap Map
+  */
+void UTIL_LCD_TILE_Invalidate(UTIL_LCD_TILE_Map_t *pMap)
+{
+  TILE_MarkArea(pMap, 0, 0, (pMap->Columns * pMap->TileWidth), (pMap->Rows * pMap->TileHeight));
+}
+
+/**
+  * @brief  Draw the dirty cells of a map with the current UTIL_LCD driver.
+  * @param  pMap Map
+  */
+void UTIL_LCD_TILE_Render(UTIL_LCD_TILE_Map_t *pMap)
+{
+  uint32_t  row, column, count, i, run_max;
+  uint16_t *pCells;
+
+  pMap->TilesDrawn = 0U;
+  pMap->Writes     = 0U;
+  run_max = UTIL_LCD_TILE_BUFFER_SIZE / (pMap->TileWidth * pMap->TileHeight);
+
+  for (row = 0U; row < pMap->Rows; row++)
+  {
+    pCells = &pMap->pCells[row * pMap->Columns];
+    column = 0U;
+
+    while (column < pMap->Columns)
+    {
+      /* Run of adjacent dirty cells fitting in the buffer */
+      count = 0U;
+      while (((column + count) < pMap->Columns) && (count < run_max) &&
+             ((pCells[column + count] & TILE_DIRTY) != 0U))
+      {
+        count++;
+      }
+
+      if (count == 0U)
+      {
+        column++;
+      }
+      else
+      {
+        for (i = 0U; i < count; i++)
+        {
+          TILE_Compose(pMap, (column + i), row, &TileBuffer[i * pMap->TileWidth], (count * pMap->TileWidth));
+          pCells[column + i] &= (uint16_t)~TILE_DIRTY;
+        }
+
+        UTIL_LCD_FillRGBRect((pMap->Xpos + (column * pMap->TileWidth)), (pMap->Ypos + (row * pMap->TileHeight)),
+                             (uint8_t *)TileBuffer, (count * pMap->TileWidth), pMap->TileHeight);
+
+        pMap->TilesDrawn += count;
+        pMap->Writes++;
+        column += count;
+      }
+    }
+  }
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Private_Functions STM32 LCD Tile Map Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Mark dirty the cells covering an area of the map.
+  * @param  pMap   Map
+  * @param  Xpos   X position of the area, relative to the map
+  * @param  Ypos   Y position of the area, relative to the map
+  * @param  Width  Area width
+  * @param  Height Area height
+  */
+static void TILE_MarkArea(UTIL_LCD_TILE_Map_t *pMap, int32_t Xpos, int32_t Ypos, uint32_t Width, uint32_t Height)
+{
+  int32_t  x0 = MAX(Xpos, 0);
+  int32_t  y0 = MAX(Ypos, 0);
+  int32_t  x1 = MIN((Xpos + (int32_t)Width), (int32_t)(pMap->Columns * pMap->TileWidth));
+  int32_t  y1 = MIN((Ypos + (int32_t)Height), (int32_t)(pMap->Rows * pMap->TileHeight));
+  uint32_t row, column;
+
+  if ((x0 < x1) && (y0 < y1))
+  {
+    for (row = (uint32_t)y0 / pMap->TileHeight; row <= ((uint32_t)y1 - 1U) / pMap->TileHeight; row++)
+    {
+      for (column = (uint32_t)x0 / pMap->TileWidth; column <= ((uint32_t)x1 - 1U) / pMap->TileWidth; column++)
+      {
+        pMap->pCells[(row * pMap->Columns) + column] |= (uint16_t)TILE_DIRTY;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Mark dirty the cells covered by a sprite, if visible.
+  * @param  pMap    Map
+  * @param  pSprite Sprite
+  */
+static void TILE_MarkSprite(UTIL_LCD_TILE_Map_t *pMap, const UTIL_LCD_TILE_Sprite_t *pSprite)
+{
+  if ((pSprite->Visible != 0U) && (pSprite->pData != NULL))
+  {
+    TILE_MarkArea(pMap, pSprite->X, pSprite->Y, pSprite->Width, pSprite->Height);
+  }
+}
+
+/**
+  * @brief  Compose a cell: its tile and the visible sprites over it.
+  * @param  pMap   Map
+  * @param  Column Cell column
+  * @param  Row    Cell row
+  * @param  pDst   First pixel of the cell in the composition buffer
+  * @param  Stride Composition buffer width in pixels
+  */
+static void TILE_Compose(const UTIL_LCD_TILE_Map_t *pMap, uint32_t Column, uint32_t Row, uint16_t *pDst,
+                         uint32_t Stride)
+{
+  const UTIL_LCD_TILE_Sprite_t *pSprite;
+  const uint16_t *pSrc;
+  uint32_t id, x, y;
+  int32_t  tx = (int32_t)(Column * pMap->TileWidth);
+  int32_t  ty = (int32_t)(Row * pMap->TileHeight);
+  int32_t  x0, y0, x1, y1;
+
+  /* Tile */
+  pSrc = &pMap->pTiles[(uint32_t)(pMap->pCells[(Row * pMap->Columns) + Column] & (uint16_t)~TILE_DIRTY) *
+                       pMap->TileWidth * pMap->TileHeight];
+  for (y = 0U; y < pMap->TileHeight; y++)
+  {
+    (void)memcpy(&pDst[y * Stride], &pSrc[y * pMap->TileWidth], pMap->TileWidth * sizeof(uint16_t));
+  }
+
+  /* Sprites overlapping the cell, color key pixels excluded */
+  for (id = 0U; id < UTIL_LCD_TILE_MAX_SPRITES; id++)
+  {
+    pSprite = &pMap->Sprites[id];
+    if ((pSprite->Visible != 0U) && (pSprite->pData != NULL))
+    {
+      x0 = MAX(pSprite->X, tx);
+      y0 = MAX(pSprite->Y, ty);
+      x1 = MIN((pSprite->X + (int32_t)pSprite->Width), (tx + (int32_t)pMap->TileWidth));
+      y1 = MIN((pSprite->Y + (int32_t)pSprite->Height), (ty + (int32_t)pMap->TileHeight));
+
+      for (y = (uint32_t)y0; (int32_t)y < y1; y++)
+      {
+        pSrc = &pSprite->pData[(((int32_t)y - pSprite->Y) * (int32_t)pSprite->Width) + (x0 - pSprite->X)];
+        for (x = 0U; (x0 + (int32_t)x) < x1; x++)
+        {
+          if (pSrc[x] != pSprite->ColorKey)
+          {
+            pDst[(((int32_t)y - ty) * (int32_t)Stride) + (x0 - tx) + (int32_t)x] = pSrc[x];
+          }
+        }
+      }
+    }
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    stm32_lcd_tile.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_lcd_tile.c tile map and sprite engine.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_LCD_TILE_H
+#define STM32_LCD_TILE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_lcd.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_LCD_TILE STM32 LCD Tile Map Utility
+  * @{
+  */
+
+/** @defgroup UTIL_LCD_TILE_Exported_Constants STM32 LCD Tile Map Utility Exported Constants
+  * @{
+  */
+#define UTIL_LCD_TILE_OK                 0
+#define UTIL_LCD_TILE_ERROR            (-1)
+
+/**
+  * @brief  Number of sprites of a map
+  */
+#ifndef UTIL_LCD_TILE_MAX_SPRITES
+  #define UTIL_LCD_TILE_MAX_SPRITES      8U
+#endif
+
+/**
+  * @brief  Pixels of the composition buffer, at least one tile. Adjacent
+  *         tiles of a row are sent together while they fit in it.
+  */
+#ifndef UTIL_LCD_TILE_BUFFER_SIZE
+  #define UTIL_LCD_TILE_BUFFER_SIZE      1024U
+#endif
+
+/**
+  * @brief  Largest tile index
+  */
+#define UTIL_LCD_TILE_MAX_INDEX          0x7FFFU
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_LCD_TILE_Exported_Types STM32 LCD Tile Map Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Sprite
+  */
+typedef struct
+{
+  const uint16_t *pData;     /*!< Width x Height RGB565 pixels                 */
+  int32_t         X;         /*!< X position, relative to the map              */
+  int32_t         Y;         /*!< Y position, relative to the map              */
+  uint32_t        Width;     /*!< Width in pixels                              */
+  uint32_t        Height;    /*!< Height in pixels                             */
+  uint16_t        ColorKey;  /*!< Transparent color                            */
+  uint8_t         Visible;   /*!< Drawn when not 0                             */
+} UTIL_LCD_TILE_Sprite_t;
+
+/**
+  * @brief  Tile map. The configuration fields are set before
+  *         UTIL_LCD_TILE_Init(), the other ones are managed by the utility.
+  */
+typedef struct
+{
+  uint32_t               Xpos;        /*!< Display X position of the map                          */
+  uint32_t               Ypos;        /*!< Display Y position of the map                          */
+  uint32_t               TileWidth;   /*!< Tile width in pixels                                   */
+  uint32_t               TileHeight;  /*!< Tile height in pixels                                  */
+  uint32_t               Columns;     /*!< Map width in tiles                                     */
+  uint32_t               Rows;        /*!< Map height in tiles                                    */
+  uint16_t              *pCells;      /*!< Columns x Rows tile indexes, row by row                */
+  uint16_t              *pTiles;      /*!< Tile cache: TileCount tiles of RGB565 pixels           */
+  uint32_t               TileCount;   /*!< Tiles held by the tile cache                           */
+  UTIL_LCD_TILE_Sprite_t Sprites[UTIL_LCD_TILE_MAX_SPRITES]; /*!< Sprites, drawn in index order   */
+  uint32_t               TilesDrawn;  /*!< Tiles sent by the last UTIL_LCD_TILE_Render()          */
+  uint32_t               Writes;      /*!< Rectangles sent by the last UTIL_LCD_TILE_Render()     */
+} UTIL_LCD_TILE_Map_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_LCD_TILE_Exported_Functions
+  * @{
+  */
+int32_t UTIL_LCD_TILE_Init(UTIL_LCD_TILE_Map_t *pMap);
+int32_t UTIL_LCD_TILE_LoadTile(UTIL_LCD_TILE_Map_t *pMap, uint32_t Index, const uint16_t *pData);
+int32_t UTIL_LCD_TILE_SetCell(UTIL_LCD_TILE_Map_t *pMap, uint32_t Column, uint32_t Row, uint32_t Index);
+int32_t UTIL_LCD_TILE_SetSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, const uint16_t *pData, uint32_t Width,
+                                uint32_t Height, uint16_t ColorKey);
+int32_t UTIL_LCD_TILE_MoveSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, int32_t X, int32_t Y);
+int32_t UTIL_LCD_TILE_ShowSprite(UTIL_LCD_TILE_Map_t *pMap, uint32_t Id, uint32_t Visible);
+void    UTIL_LCD_TILE_Invalidate(UTIL_LCD_TILE_Map_t *pMap);
+void    UTIL_LCD_TILE_Render(UTIL_LCD_TILE_Map_t *pMap);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LCD_TILE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
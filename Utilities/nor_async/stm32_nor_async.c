@@ -0,0 +1,608 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_async.c
+  * @author  MCD Application Team
+  * @brief   This file includes an asynchronous write queue programming a NOR
+  *          flash page by page, with reads served by suspending the program
+  *          in progress.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver queues write jobs to a NOR flash, e.g. the MX25LM51245G, and
+     programs them page by page while the CPU keeps running: the end of each
+     page program is detected by the OSPI status match interrupt, whose
+     handler starts the next page, instead of polling the memory.
+
+   - Jobs are programmed one after the other, in submission order. Each job
+     is split in page programs as BSP_OSPI_NOR_Write() does. The memory must
+     have been erased: programs only clear bits.
+
+   - Call UTIL_NOR_ASYNC_Init() with the engine, built on the BSP services:
+         Read       BSP_OSPI_NOR_Read
+         StartWrite BSP_OSPI_NOR_Write_IT
+         Suspend    BSP_OSPI_NOR_SuspendWrite
+         Resume     BSP_OSPI_NOR_ResumeWrite
+         Lock       disables the OCTOSPI1 interrupt
+         Unlock     enables the OCTOSPI1 interrupt
+     then call BSP_OSPI_NOR_IT_Init(), and UTIL_NOR_ASYNC_WriteCplt() /
+     UTIL_NOR_ASYNC_WriteError() from the BSP_OSPI_NOR_WriteCpltCallback() /
+     BSP_OSPI_NOR_ErrorCallback() callbacks.
+
+   - Each submission returns a fence. The source buffer of a job must not be
+     modified before its fence is reached, see UTIL_NOR_ASYNC_IsComplete(),
+     UTIL_NOR_ASYNC_Wait() and UTIL_NOR_ASYNC_WaitAll(), or before its
+     completion callback is called. Submissions return UTIL_NOR_ASYNC_BUSY
+     when the queue is full.
+
+   - UTIL_NOR_ASYNC_Read() does not wait for the queued writes: a page
+     program in progress is suspended, the memory is read, and the program
+     is resumed. The read latency is then the suspend latency (20 us max on
+     the MX25LM51245G) and the read itself, instead of up to a page program
+     time per queued page. Data of the queued writes not programmed yet are
+     merged in the result, so that reads return what the memory will hold.
+     After UTIL_NOR_ASYNC_MAX_SUSPENDS reads during the same page program,
+     reads wait for its end, so that the writes keep progressing.
+
+   - The other BSP_OSPI_NOR services must not be called while jobs are
+     queued: the OSPI is busy with the status polling.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_async.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_NOR_ASYNC STM32 NOR Flash Asynchronous Write Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Private_Types STM32 NOR Flash Asynchronous Write Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t                   Address;
+  const uint8_t             *pData;
+  uint32_t                   Size;
+  UTIL_NOR_ASYNC_Callback_t  pCallback;
+  void                      *pContext;
+  uint32_t                   Fence;
+} ASYNC_Job_t;
+
+typedef struct
+{
+  const UTIL_NOR_ASYNC_Engine_t *pEngine;
+  uint32_t                       Instance;
+  ASYNC_Job_t                    Queue[UTIL_NOR_ASYNC_QUEUE_SIZE];
+  volatile uint32_t              Head;       /* Running job, incremented on completion  */
+  volatile uint32_t              Tail;       /* Incremented on submission               */
+  volatile uint32_t              Busy;       /* A page program is in progress           */
+  uint32_t                       Offset;     /* Bytes of the running job programmed     */
+  uint32_t                       Length;     /* Bytes of the page program in progress   */
+  volatile uint32_t              PageSeq;    /* Incremented at the end of each program  */
+  uint32_t                       Suspends;   /* Reads during the program in progress    */
+  uint32_t                       Submitted;  /* Fence of the last submitted job         */
+  volatile uint32_t              Completed;  /* Fence of the last completed job         */
+  volatile uint32_t              Error;      /* A job failed since the last wait        */
+  UTIL_NOR_ASYNC_Stats_t         Stats;
+} ASYNC_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Private_FunctionPrototypes STM32 NOR Flash Asynchronous Write Utility Private FunctionPrototypes
+  * @{
+  */
+static void     ASYNC_Lock(void);
+static void     ASYNC_Unlock(void);
+static void     ASYNC_StartJob(void);
+static int32_t  ASYNC_StartPage(void);
+static void     ASYNC_EndJob(int32_t Status);
+static uint32_t ASYNC_Merge(uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Private_Variables STM32 NOR Flash Asynchronous Write Utility Private Variables
+  * @{
+  */
+static ASYNC_Ctx_t AsyncCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Exported_Functions STM32 NOR Flash Asynchronous Write Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the write queue.
+  * @param  Instance OSPI Instance passed to the engine
+  * @param  pEngine  Write engine
+  * @retval UTIL_NOR_ASYNC status
+  */
+int32_t UTIL_NOR_ASYNC_Init(uint32_t Instance, const UTIL_NOR_ASYNC_Engine_t *pEngine)
+{
+  int32_t ret = UTIL_NOR_ASYNC_OK;
+
+  if ((pEngine == NULL) || (pEngine->Read == NULL) || (pEngine->StartWrite == NULL) ||
+      (pEngine->Suspend == NULL) || (pEngine->Resume == NULL))
+  {
+    ret = UTIL_NOR_ASYNC_ERROR;
+  }
+  else if (AsyncCtx.Busy != 0U)
+  {
+    ret = UTIL_NOR_ASYNC_BUSY;
+  }
+  else
+  {
+    AsyncCtx.pEngine   = pEngine;
+    AsyncCtx.Instance  = Instance;
+    AsyncCtx.Head      = 0U;
+    AsyncCtx.Tail      = 0U;
+    AsyncCtx.Submitted = 0U;
+    AsyncCtx.Completed = 0U;
+    AsyncCtx.Error     = 0U;
+    AsyncCtx.Suspends  = 0U;
+    UTIL_NOR_ASYNC_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Queue a write to the NOR flash.
+  * @param  WriteAddr Flash address
+  * @param  pData     Data, kept until completion
+  * @param  Size      Number of bytes
+  * @param  pCallback Completion callback, may be NULL
+  * @param  pContext  Parameter passed to the completion callback
+  * @param  pFence    Fence of the job, may be NULL
+  * @retval UTIL_NOR_ASYNC status
+  */
+int32_t UTIL_NOR_ASYNC_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size,
+                             UTIL_NOR_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence)
+{
+  int32_t      ret = UTIL_NOR_ASYNC_OK;
+  ASYNC_Job_t *job;
+
+  if ((AsyncCtx.pEngine == NULL) || (pData == NULL) || (Size == 0U))
+  {
+    ret = UTIL_NOR_ASYNC_ERROR;
+  }
+  else
+  {
+    ASYNC_Lock();
+
+    if ((AsyncCtx.Tail - AsyncCtx.Head) >= UTIL_NOR_ASYNC_QUEUE_SIZE)
+    {
+      ret = UTIL_NOR_ASYNC_BUSY;
+    }
+    else
+    {
+      AsyncCtx.Submitted++;
+      job            = &AsyncCtx.Queue[AsyncCtx.Tail % UTIL_NOR_ASYNC_QUEUE_SIZE];
+      job->Address   = WriteAddr;
+      job->pData     = pData;
+      job->Size      = Size;
+      job->pCallback = pCallback;
+      job->pContext  = pContext;
+      job->Fence     = AsyncCtx.Submitted;
+      if (pFence != NULL)
+      {
+        *pFence = AsyncCtx.Submitted;
+      }
+      AsyncCtx.Tail++;
+
+      if (AsyncCtx.Busy == 0U)
+      {
+        ASYNC_StartJob();
+      }
+    }
+
+    ASYNC_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read the NOR flash without waiting for the queued writes. A page
+  *         program in progress is suspended during the read.
+  * @param  ReadAddr Flash address
+  * @param  pData    Destination
+  * @param  Size     Number of bytes
+  * @retval UTIL_NOR_ASYNC status
+  */
+int32_t UTIL_NOR_ASYNC_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
+{
+  int32_t  ret = UTIL_NOR_ASYNC_OK;
+  uint32_t suspended = 0U;
+  uint32_t waited = 0U;
+  uint32_t page;
+
+  if ((AsyncCtx.pEngine == NULL) || (pData == NULL))
+  {
+    ret = UTIL_NOR_ASYNC_ERROR;
+  }
+  else
+  {
+    ASYNC_Lock();
+
+    /* Past the suspend limit, let the page program complete */
+    while ((AsyncCtx.Busy != 0U) && (AsyncCtx.Suspends >= UTIL_NOR_ASYNC_MAX_SUSPENDS))
+    {
+      waited = 1U;
+      page   = AsyncCtx.PageSeq;
+      ASYNC_Unlock();
+      while (AsyncCtx.PageSeq == page)
+      {
+        if (AsyncCtx.pEngine->Idle != NULL)
+        {
+          AsyncCtx.pEngine->Idle(AsyncCtx.Instance);
+        }
+      }
+      ASYNC_Lock();
+    }
+    AsyncCtx.Stats.WaitCount += waited;
+
+    if (AsyncCtx.Busy != 0U)
+    {
+      suspended = 1U;
+      AsyncCtx.Suspends++;
+      AsyncCtx.Stats.SuspendCount++;
+      if (AsyncCtx.pEngine->Suspend(AsyncCtx.Instance) != 0)
+      {
+        ret = UTIL_NOR_ASYNC_ERROR;
+      }
+    }
+
+    if ((ret == UTIL_NOR_ASYNC_OK) && (AsyncCtx.pEngine->Read(AsyncCtx.Instance, pData, ReadAddr, Size) != 0))
+    {
+      ret = UTIL_NOR_ASYNC_ERROR;
+    }
+
+    if ((ret == UTIL_NOR_ASYNC_OK) && (ASYNC_Merge(ReadAddr, pData, Size) != 0U))
+    {
+      AsyncCtx.Stats.MergeCount++;
+    }
+    AsyncCtx.Stats.ReadCount++;
+
+    /* The state of a page program which cannot be resumed is unknown */
+    if ((suspended != 0U) && (AsyncCtx.pEngine->Resume(AsyncCtx.Instance) != 0))
+    {
+      ASYNC_EndJob(UTIL_NOR_ASYNC_ERROR);
+      ASYNC_StartJob();
+    }
+
+    ASYNC_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Check whether a write job is completed.
+  * @param  Fence Fence of the job
+  * @retval 1 if the job and all the jobs queued before it are completed
+  */
+uint32_t UTIL_NOR_ASYNC_IsComplete(uint32_t Fence)
+{
+  return ((int32_t)(AsyncCtx.Completed - Fence) >= 0) ? 1U : 0U;
+}
+
+/**
+  * @brief  Wait until a write job is completed, calling the engine Idle hook.
+  * @param  Fence Fence of the job
+  * @retval UTIL_NOR_ASYNC_ERROR if a job failed since the previous wait
+  */
+int32_t UTIL_NOR_ASYNC_Wait(uint32_t Fence)
+{
+  int32_t ret = UTIL_NOR_ASYNC_OK;
+
+  if ((AsyncCtx.pEngine == NULL) || ((int32_t)(Fence - AsyncCtx.Submitted) > 0))
+  {
+    ret = UTIL_NOR_ASYNC_ERROR;
+  }
+  else
+  {
+    while (UTIL_NOR_ASYNC_IsComplete(Fence) == 0U)
+    {
+      if (AsyncCtx.pEngine->Idle != NULL)
+      {
+        AsyncCtx.pEngine->Idle(AsyncCtx.Instance);
+      }
+    }
+
+    if (AsyncCtx.Error != 0U)
+    {
+      AsyncCtx.Error = 0U;
+      ret = UTIL_NOR_ASYNC_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Wait until all the queued write jobs are completed.
+  * @retval UTIL_NOR_ASYNC_ERROR if a job failed since the previous wait
+  */
+int32_t UTIL_NOR_ASYNC_WaitAll(void)
+{
+  return UTIL_NOR_ASYNC_Wait(AsyncCtx.Submitted);
+}
+
+/**
+  * @brief  Page program completion, to be called by the engine.
+  *         Starts the next page of the running job or the next job.
+  */
+void UTIL_NOR_ASYNC_WriteCplt(void)
+{
+  const ASYNC_Job_t *job;
+
+  if (AsyncCtx.Busy != 0U)
+  {
+    job = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_NOR_ASYNC_QUEUE_SIZE];
+
+    AsyncCtx.Offset  += AsyncCtx.Length;
+    AsyncCtx.Suspends = 0U;
+    AsyncCtx.PageSeq++;
+
+    if (AsyncCtx.Offset < job->Size)
+    {
+      if (ASYNC_StartPage() != UTIL_NOR_ASYNC_OK)
+      {
+        ASYNC_EndJob(UTIL_NOR_ASYNC_ERROR);
+        ASYNC_StartJob();
+      }
+    }
+    else
+    {
+      ASYNC_EndJob(UTIL_NOR_ASYNC_OK);
+      ASYNC_StartJob();
+    }
+  }
+}
+
+/**
+  * @brief  Page program error, to be called by the engine.
+  *         The running job is completed with an error and the next job starts.
+  */
+void UTIL_NOR_ASYNC_WriteError(void)
+{
+  if (AsyncCtx.Busy != 0U)
+  {
+    AsyncCtx.Suspends = 0U;
+    AsyncCtx.PageSeq++;
+    ASYNC_EndJob(UTIL_NOR_ASYNC_ERROR);
+    ASYNC_StartJob();
+  }
+}
+
+/**
+  * @brief  Get the statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_NOR_ASYNC_GetStats(UTIL_NOR_ASYNC_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats = AsyncCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the statistics.
+  */
+void UTIL_NOR_ASYNC_ResetStats(void)
+{
+  AsyncCtx.Stats.JobCount     = 0U;
+  AsyncCtx.Stats.PageCount    = 0U;
+  AsyncCtx.Stats.ByteCount    = 0U;
+  AsyncCtx.Stats.ErrorCount   = 0U;
+  AsyncCtx.Stats.ReadCount    = 0U;
+  AsyncCtx.Stats.SuspendCount = 0U;
+  AsyncCtx.Stats.WaitCount    = 0U;
+  AsyncCtx.Stats.MergeCount   = 0U;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Private_Functions STM32 NOR Flash Asynchronous Write Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Mask the completion interrupt.
+  */
+static void ASYNC_Lock(void)
+{
+  if (AsyncCtx.pEngine->Lock != NULL)
+  {
+    AsyncCtx.pEngine->Lock(AsyncCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Unmask the completion interrupt.
+  */
+static void ASYNC_Unlock(void)
+{
+  if (AsyncCtx.pEngine->Unlock != NULL)
+  {
+    AsyncCtx.pEngine->Unlock(AsyncCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Start the oldest queued job, jobs failing to start are completed
+  *         with an error.
+  */
+static void ASYNC_StartJob(void)
+{
+  uint32_t started = 0U;
+
+  while ((started == 0U) && (AsyncCtx.Head != AsyncCtx.Tail))
+  {
+    /* Set busy first, the program may complete before StartWrite returns */
+    AsyncCtx.Busy   = 1U;
+    AsyncCtx.Offset = 0U;
+    if (ASYNC_StartPage() != UTIL_NOR_ASYNC_OK)
+    {
+      ASYNC_EndJob(UTIL_NOR_ASYNC_ERROR);
+    }
+    else
+    {
+      started = 1U;
+    }
+  }
+
+  if (started == 0U)
+  {
+    AsyncCtx.Busy = 0U;
+  }
+}
+
+/**
+  * @brief  Start the next page program of the running job, up to the end of
+  *         the page.
+  * @retval UTIL_NOR_ASYNC status
+  */
+static int32_t ASYNC_StartPage(void)
+{
+  int32_t            ret = UTIL_NOR_ASYNC_OK;
+  const ASYNC_Job_t *job;
+  uint32_t           address;
+  uint32_t           length;
+
+  job     = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_NOR_ASYNC_QUEUE_SIZE];
+  address = job->Address + AsyncCtx.Offset;
+  length  = UTIL_NOR_ASYNC_PAGE_SIZE - (address % UTIL_NOR_ASYNC_PAGE_SIZE);
+  if (length > (job->Size - AsyncCtx.Offset))
+  {
+    length = job->Size - AsyncCtx.Offset;
+  }
+
+  AsyncCtx.Length = length;
+  AsyncCtx.Stats.PageCount++;
+  AsyncCtx.Stats.ByteCount += length;
+  if (AsyncCtx.pEngine->StartWrite(AsyncCtx.Instance, (uint8_t *)&job->pData[AsyncCtx.Offset], address, length) != 0)
+  {
+    ret = UTIL_NOR_ASYNC_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Complete the running job and call its callback.
+  * @param  Status Job status
+  */
+static void ASYNC_EndJob(int32_t Status)
+{
+  const ASYNC_Job_t        *job;
+  UTIL_NOR_ASYNC_Callback_t callback;
+  void                     *context;
+  uint32_t                  fence;
+
+  job      = &AsyncCtx.Queue[AsyncCtx.Head % UTIL_NOR_ASYNC_QUEUE_SIZE];
+  callback = job->pCallback;
+  context  = job->pContext;
+  fence    = job->Fence;
+
+  if (Status != UTIL_NOR_ASYNC_OK)
+  {
+    AsyncCtx.Error = 1U;
+    AsyncCtx.Stats.ErrorCount++;
+  }
+  AsyncCtx.Stats.JobCount++;
+
+  /* Release the slot before the callback so that it can queue a new job */
+  AsyncCtx.Completed = fence;
+  AsyncCtx.Head++;
+
+  if (callback != NULL)
+  {
+    callback(fence, Status, context);
+  }
+}
+
+/**
+  * @brief  Merge the data of the queued jobs in a read buffer. Programs only
+  *         clear bits, so the data are ANDed: parts already programmed are
+  *         left unchanged.
+  * @param  ReadAddr Flash address of the buffer
+  * @param  pData    Read buffer
+  * @param  Size     Number of bytes
+  * @retval 1 if queued data overlap the buffer
+  */
+static uint32_t ASYNC_Merge(uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
+{
+  const ASYNC_Job_t *job;
+  uint32_t           index;
+  uint32_t           start;
+  uint32_t           end;
+  uint32_t           address;
+  uint32_t           ret = 0U;
+
+  for (index = AsyncCtx.Head; index != AsyncCtx.Tail; index++)
+  {
+    job   = &AsyncCtx.Queue[index % UTIL_NOR_ASYNC_QUEUE_SIZE];
+    start = (job->Address > ReadAddr) ? job->Address : ReadAddr;
+    end   = ((job->Address + job->Size) < (ReadAddr + Size)) ? (job->Address + job->Size) : (ReadAddr + Size);
+
+    for (address = start; address < end; address++)
+    {
+      pData[address - ReadAddr] &= job->pData[address - job->Address];
+      ret = 1U;
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_async.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_nor_async.c NOR flash asynchronous write utility.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_NOR_ASYNC_H
+#define STM32_NOR_ASYNC_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_NOR_ASYNC STM32 NOR Flash Asynchronous Write Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Exported_Constants STM32 NOR Flash Asynchronous Write Utility Exported Constants
+  * @{
+  */
+#define UTIL_NOR_ASYNC_OK                 0
+#define UTIL_NOR_ASYNC_ERROR            (-1)
+#define UTIL_NOR_ASYNC_BUSY             (-2)
+
+/**
+  * @brief  Number of write jobs the queue can hold
+  */
+#ifndef UTIL_NOR_ASYNC_QUEUE_SIZE
+  #define UTIL_NOR_ASYNC_QUEUE_SIZE       8U
+#endif
+
+/**
+  * @brief  Program page size in bytes, MX25LM51245G_PAGE_SIZE
+  */
+#ifndef UTIL_NOR_ASYNC_PAGE_SIZE
+  #define UTIL_NOR_ASYNC_PAGE_SIZE        256U
+#endif
+
+/**
+  * @brief  Reads allowed to suspend the same page program. Further reads wait
+  *         for the end of the page, so that back to back reads cannot stall
+  *         the writes.
+  */
+#ifndef UTIL_NOR_ASYNC_MAX_SUSPENDS
+  #define UTIL_NOR_ASYNC_MAX_SUSPENDS     8U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ASYNC_Exported_Types STM32 NOR Flash Asynchronous Write Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Write job completion callback, called from the write completion
+  *         context with UTIL_NOR_ASYNC_OK or UTIL_NOR_ASYNC_ERROR.
+  */
+typedef void (*UTIL_NOR_ASYNC_Callback_t)(uint32_t Fence, int32_t Status, void *pContext);
+
+/**
+  * @brief  Write engine, with the BSP_OSPI_NOR service signatures.
+  *         Read reads the memory, which is ready (BSP_OSPI_NOR_Read).
+  *         StartWrite programs data within one page and returns immediately,
+  *         the engine reports the end of programming by calling
+  *         UTIL_NOR_ASYNC_WriteCplt() or UTIL_NOR_ASYNC_WriteError()
+  *         (BSP_OSPI_NOR_Write_IT).
+  *         Suspend stops the completion detection and suspends the program in
+  *         progress, if any, so that the memory can be read
+  *         (BSP_OSPI_NOR_SuspendWrite). Resume resumes it and restarts the
+  *         completion detection (BSP_OSPI_NOR_ResumeWrite).
+  *         Lock/Unlock mask the completion interrupt. Idle is called while
+  *         waiting. Lock, Unlock and Idle may be NULL.
+  */
+typedef struct
+{
+  int32_t ( *Read            ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *StartWrite      ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *Suspend         ) (uint32_t);
+  int32_t ( *Resume          ) (uint32_t);
+  void    ( *Lock            ) (uint32_t);
+  void    ( *Unlock          ) (uint32_t);
+  void    ( *Idle            ) (uint32_t);
+} UTIL_NOR_ASYNC_Engine_t;
+
+/**
+  * @brief  Statistics
+  */
+typedef struct
+{
+  uint32_t JobCount;      /*!< Write jobs completed                                  */
+  uint32_t PageCount;     /*!< Page programs started                                 */
+  uint32_t ByteCount;     /*!< Bytes programmed                                      */
+  uint32_t ErrorCount;    /*!< Write jobs completed with an error                    */
+  uint32_t ReadCount;     /*!< Reads                                                 */
+  uint32_t SuspendCount;  /*!< Reads done by suspending a page program               */
+  uint32_t WaitCount;     /*!< Reads waiting for the end of a page program           */
+  uint32_t MergeCount;    /*!< Reads completed with data of queued writes            */
+} UTIL_NOR_ASYNC_Stats_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_NOR_ASYNC_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_NOR_ASYNC_Init(uint32_t Instance, const UTIL_NOR_ASYNC_Engine_t *pEngine);
+int32_t  UTIL_NOR_ASYNC_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size,
+                              UTIL_NOR_ASYNC_Callback_t pCallback, void *pContext, uint32_t *pFence);
+int32_t  UTIL_NOR_ASYNC_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
+uint32_t UTIL_NOR_ASYNC_IsComplete(uint32_t Fence);
+int32_t  UTIL_NOR_ASYNC_Wait(uint32_t Fence);
+int32_t  UTIL_NOR_ASYNC_WaitAll(void);
+void     UTIL_NOR_ASYNC_WriteCplt(void);
+void     UTIL_NOR_ASYNC_WriteError(void);
+void     UTIL_NOR_ASYNC_GetStats(UTIL_NOR_ASYNC_Stats_t *pStats);
+void     UTIL_NOR_ASYNC_ResetStats(void);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_NOR_ASYNC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
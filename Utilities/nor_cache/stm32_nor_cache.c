@@ -0,0 +1,583 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_cache.c
+  * @author  MCD Application Team
+  * @brief   This file includes a NOR flash read path using memory-mapped mode
+  *          while no program is in progress, fronted by a set-associative
+  *          RAM cache for small reads.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver serves the reads of a NOR flash, e.g. the MX25LM51245G,
+     for applications reading the same small data again and again (font
+     tables, configuration records), while the memory is still written.
+
+   - Call UTIL_NOR_CACHE_Init() with the flash services, built on the BSP
+     services (see UTIL_NOR_CACHE_Flash_t), the memory being in indirect
+     mode. Then access the memory with UTIL_NOR_CACHE_Read(),
+     UTIL_NOR_CACHE_Write() and UTIL_NOR_CACHE_Erase() only, until
+     UTIL_NOR_CACHE_DeInit() which returns to indirect mode.
+
+   - Reads enter memory-mapped mode and stay in it: the following reads are
+     plain memory copies instead of a command sent by the HAL for each read.
+     Writes and erases go back to indirect mode, which memory-mapped mode
+     does not allow; the next read enters memory-mapped mode again, after
+     the end of the erase in progress if any.
+
+   - Reads up to UTIL_NOR_CACHE_MAX_READ bytes go through a cache of
+     UTIL_NOR_CACHE_SETS sets of UTIL_NOR_CACHE_WAYS lines of
+     UTIL_NOR_CACHE_LINE_SIZE bytes, with least recently used replacement.
+     Larger reads are copied directly, so that they do not evict the hot
+     data. Writes and erases invalidate the lines they overlap;
+     UTIL_NOR_CACHE_Invalidate() invalidates the whole cache after the
+     memory was modified without this driver.
+
+   - UTIL_NOR_CACHE_GetStats() returns the cache hits and misses with the
+     hit rate, and the reads done in each mode.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_cache.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_NOR_CACHE STM32 NOR Flash Read Cache Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Private_Types STM32 NOR Flash Read Cache Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t Tag;                               /* Line address, CACHE_INVALID if none */
+  uint32_t Age;                               /* Last use, 0 if invalid              */
+  uint8_t  Data[UTIL_NOR_CACHE_LINE_SIZE];
+} CACHE_Line_t;
+
+typedef struct
+{
+  const UTIL_NOR_CACHE_Flash_t *pFlash;
+  uint32_t                      Instance;
+  uint32_t                      Mapped;       /* Memory-mapped mode enabled          */
+  uint32_t                      Pending;      /* An erase may be in progress         */
+  uint32_t                      Clock;        /* Incremented on each line lookup     */
+  CACHE_Line_t                  Lines[UTIL_NOR_CACHE_SETS][UTIL_NOR_CACHE_WAYS];
+  UTIL_NOR_CACHE_Stats_t        Stats;
+} CACHE_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Private_Defines STM32 NOR Flash Read Cache Utility Private Defines
+  * @{
+  */
+#define CACHE_INVALID   0xFFFFFFFFU   /* Never a line address */
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Private_FunctionPrototypes STM32 NOR Flash Read Cache Utility Private FunctionPrototypes
+  * @{
+  */
+static void          CACHE_Lock(void);
+static void          CACHE_Unlock(void);
+static int32_t       CACHE_Fetch(uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
+static int32_t       CACHE_Indirect(void);
+static CACHE_Line_t *CACHE_Lookup(uint32_t Address);
+static void          CACHE_InvalidateRange(uint32_t Address, uint32_t Size);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Private_Variables STM32 NOR Flash Read Cache Utility Private Variables
+  * @{
+  */
+static CACHE_Ctx_t CacheCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Exported_Functions STM32 NOR Flash Read Cache Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the read path. The memory must be in indirect mode.
+  * @param  Instance Flash instance passed to the flash services
+  * @param  pFlash   Flash services
+  * @retval UTIL_NOR_CACHE status
+  */
+int32_t UTIL_NOR_CACHE_Init(uint32_t Instance, const UTIL_NOR_CACHE_Flash_t *pFlash)
+{
+  int32_t ret = UTIL_NOR_CACHE_OK;
+
+  if ((pFlash == NULL) || (pFlash->Read == NULL) || (pFlash->Write == NULL) || (pFlash->Erase == NULL) ||
+      (pFlash->GetStatus == NULL))
+  {
+    ret = UTIL_NOR_CACHE_ERROR;
+  }
+  else
+  {
+    CacheCtx.pFlash   = pFlash;
+    CacheCtx.Instance = Instance;
+    CacheCtx.Mapped   = 0U;
+    CacheCtx.Pending  = 0U;
+    CacheCtx.Clock    = 0U;
+    UTIL_NOR_CACHE_Invalidate();
+    UTIL_NOR_CACHE_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  De-initialize the read path, the memory is left in indirect mode.
+  * @retval UTIL_NOR_CACHE status
+  */
+int32_t UTIL_NOR_CACHE_DeInit(void)
+{
+  int32_t ret;
+
+  if (CacheCtx.pFlash == NULL)
+  {
+    ret = UTIL_NOR_CACHE_ERROR;
+  }
+  else
+  {
+    CACHE_Lock();
+    ret = CACHE_Indirect();
+    CACHE_Unlock();
+
+    if (ret == UTIL_NOR_CACHE_OK)
+    {
+      CacheCtx.pFlash = NULL;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read the memory, through the cache for small reads.
+  * @param  ReadAddr Flash address
+  * @param  pData    Destination
+  * @param  Size     Number of bytes
+  * @retval UTIL_NOR_CACHE status
+  */
+int32_t UTIL_NOR_CACHE_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
+{
+  int32_t       ret = UTIL_NOR_CACHE_OK;
+  CACHE_Line_t *line;
+  uint32_t      address;
+  uint32_t      base;
+  uint32_t      next;
+
+  if ((CacheCtx.pFlash == NULL) || (pData == NULL))
+  {
+    ret = UTIL_NOR_CACHE_ERROR;
+  }
+  else
+  {
+    CACHE_Lock();
+
+    CacheCtx.Stats.Reads++;
+
+    if (Size > UTIL_NOR_CACHE_MAX_READ)
+    {
+      CacheCtx.Stats.Bypasses++;
+      ret = CACHE_Fetch(ReadAddr, pData, Size);
+    }
+    else
+    {
+      for (address = ReadAddr; (ret == UTIL_NOR_CACHE_OK) && (address < (ReadAddr + Size)); address = next)
+      {
+        base = address - (address % UTIL_NOR_CACHE_LINE_SIZE);
+        next = base + UTIL_NOR_CACHE_LINE_SIZE;
+        if (next > (ReadAddr + Size))
+        {
+          next = ReadAddr + Size;
+        }
+
+        line = CACHE_Lookup(base);
+        if (line == NULL)
+        {
+          ret = UTIL_NOR_CACHE_ERROR;
+        }
+        else
+        {
+          (void)memcpy(&pData[address - ReadAddr], &line->Data[address - base], next - address);
+        }
+      }
+    }
+
+    CACHE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Program the memory in indirect mode and invalidate the cache lines
+  *         written.
+  * @param  WriteAddr Flash address
+  * @param  pData     Data
+  * @param  Size      Number of bytes
+  * @retval UTIL_NOR_CACHE status
+  */
+int32_t UTIL_NOR_CACHE_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size)
+{
+  int32_t ret;
+
+  if ((CacheCtx.pFlash == NULL) || (pData == NULL))
+  {
+    ret = UTIL_NOR_CACHE_ERROR;
+  }
+  else
+  {
+    CACHE_Lock();
+
+    CacheCtx.Stats.Writes++;
+
+    ret = CACHE_Indirect();
+    if ((ret == UTIL_NOR_CACHE_OK) &&
+        (CacheCtx.pFlash->Write(CacheCtx.Instance, (uint8_t *)pData, WriteAddr, Size) != 0))
+    {
+      ret = UTIL_NOR_CACHE_ERROR;
+    }
+
+    /* Partly written on error */
+    CACHE_InvalidateRange(WriteAddr, Size);
+
+    CACHE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start an erase in indirect mode and invalidate the cache lines
+  *         erased. The next read waits for the end of the erase.
+  * @param  BlockAddress Flash address
+  * @param  BlockSize    Number of bytes, as given to the Erase service
+  * @retval UTIL_NOR_CACHE status
+  */
+int32_t UTIL_NOR_CACHE_Erase(uint32_t BlockAddress, uint32_t BlockSize)
+{
+  int32_t ret;
+
+  if (CacheCtx.pFlash == NULL)
+  {
+    ret = UTIL_NOR_CACHE_ERROR;
+  }
+  else
+  {
+    CACHE_Lock();
+
+    CacheCtx.Stats.Writes++;
+
+    ret = CACHE_Indirect();
+    if (ret == UTIL_NOR_CACHE_OK)
+    {
+      if (CacheCtx.pFlash->Erase(CacheCtx.Instance, BlockAddress, BlockSize) != 0)
+      {
+        ret = UTIL_NOR_CACHE_ERROR;
+      }
+      else
+      {
+        CacheCtx.Pending = 1U;
+      }
+    }
+
+    CACHE_InvalidateRange(BlockAddress, BlockSize);
+
+    CACHE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Invalidate the whole cache.
+  */
+void UTIL_NOR_CACHE_Invalidate(void)
+{
+  uint32_t set;
+  uint32_t way;
+
+  for (set = 0U; set < UTIL_NOR_CACHE_SETS; set++)
+  {
+    for (way = 0U; way < UTIL_NOR_CACHE_WAYS; way++)
+    {
+      CacheCtx.Lines[set][way].Tag = CACHE_INVALID;
+      CacheCtx.Lines[set][way].Age = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Get the statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_NOR_CACHE_GetStats(UTIL_NOR_CACHE_Stats_t *pStats)
+{
+  uint32_t lookups;
+
+  if (pStats != NULL)
+  {
+    *pStats = CacheCtx.Stats;
+    lookups = CacheCtx.Stats.Hits + CacheCtx.Stats.Misses;
+    pStats->HitRate = (lookups == 0U) ? 0U : (uint32_t)(((uint64_t)CacheCtx.Stats.Hits * 1000U) / lookups);
+  }
+}
+
+/**
+  * @brief  Reset the statistics.
+  */
+void UTIL_NOR_CACHE_ResetStats(void)
+{
+  (void)memset(&CacheCtx.Stats, 0, sizeof(CacheCtx.Stats));
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Private_Functions STM32 NOR Flash Read Cache Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Serialize the accesses to the memory and to the cache.
+  */
+static void CACHE_Lock(void)
+{
+  if (CacheCtx.pFlash->Lock != NULL)
+  {
+    CacheCtx.pFlash->Lock(CacheCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Release the lock.
+  */
+static void CACHE_Unlock(void)
+{
+  if (CacheCtx.pFlash->Unlock != NULL)
+  {
+    CacheCtx.pFlash->Unlock(CacheCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Read the memory, in memory-mapped mode when available.
+  * @param  ReadAddr Flash address
+  * @param  pData    Destination
+  * @param  Size     Number of bytes
+  * @retval UTIL_NOR_CACHE status
+  */
+static int32_t CACHE_Fetch(uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
+{
+  int32_t ret = UTIL_NOR_CACHE_OK;
+  int32_t status;
+
+  /* The memory cannot be read during an erase */
+  while (CacheCtx.Pending != 0U)
+  {
+    status = CacheCtx.pFlash->GetStatus(CacheCtx.Instance);
+    if (status != UTIL_NOR_CACHE_FLASH_BUSY)
+    {
+      CacheCtx.Pending = 0U;
+      if (status != 0)
+      {
+        ret = UTIL_NOR_CACHE_ERROR;
+      }
+    }
+  }
+
+  if ((ret == UTIL_NOR_CACHE_OK) && (CacheCtx.Mapped == 0U) && (CacheCtx.pFlash->EnableMapped != NULL) &&
+      (CacheCtx.pFlash->ReadMapped != NULL))
+  {
+    /* Stay in indirect mode if memory-mapped mode cannot be entered */
+    if (CacheCtx.pFlash->EnableMapped(CacheCtx.Instance) == 0)
+    {
+      CacheCtx.Mapped = 1U;
+      CacheCtx.Stats.ModeSwitches++;
+    }
+  }
+
+  if (ret == UTIL_NOR_CACHE_OK)
+  {
+    if (CacheCtx.Mapped != 0U)
+    {
+      CacheCtx.Stats.MappedReads++;
+      if (CacheCtx.pFlash->ReadMapped(CacheCtx.Instance, pData, ReadAddr, Size) != 0)
+      {
+        ret = UTIL_NOR_CACHE_ERROR;
+      }
+    }
+    else
+    {
+      CacheCtx.Stats.IndirectReads++;
+      if (CacheCtx.pFlash->Read(CacheCtx.Instance, pData, ReadAddr, Size) != 0)
+      {
+        ret = UTIL_NOR_CACHE_ERROR;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Leave memory-mapped mode before a command.
+  * @retval UTIL_NOR_CACHE status
+  */
+static int32_t CACHE_Indirect(void)
+{
+  int32_t ret = UTIL_NOR_CACHE_OK;
+
+  if (CacheCtx.Mapped != 0U)
+  {
+    if ((CacheCtx.pFlash->DisableMapped == NULL) || (CacheCtx.pFlash->DisableMapped(CacheCtx.Instance) != 0))
+    {
+      ret = UTIL_NOR_CACHE_ERROR;
+    }
+    else
+    {
+      CacheCtx.Mapped = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Find a line in the cache, or read it from the memory in place of
+  *         the least recently used line of its set.
+  * @param  Address Line address
+  * @retval Cache line, NULL on read error
+  */
+static CACHE_Line_t *CACHE_Lookup(uint32_t Address)
+{
+  CACHE_Line_t *set;
+  CACHE_Line_t *line = NULL;
+  CACHE_Line_t *victim;
+  uint32_t      way;
+
+  set    = CacheCtx.Lines[(Address / UTIL_NOR_CACHE_LINE_SIZE) % UTIL_NOR_CACHE_SETS];
+  victim = &set[0];
+  CacheCtx.Clock++;
+
+  for (way = 0U; (way < UTIL_NOR_CACHE_WAYS) && (line == NULL); way++)
+  {
+    if (set[way].Tag == Address)
+    {
+      line = &set[way];
+    }
+    else if (set[way].Age < victim->Age)
+    {
+      victim = &set[way];
+    }
+    else
+    {
+      /* Used more recently */
+    }
+  }
+
+  if (line != NULL)
+  {
+    CacheCtx.Stats.Hits++;
+    line->Age = CacheCtx.Clock;
+  }
+  else
+  {
+    CacheCtx.Stats.Misses++;
+    if (CACHE_Fetch(Address, victim->Data, UTIL_NOR_CACHE_LINE_SIZE) != UTIL_NOR_CACHE_OK)
+    {
+      victim->Tag = CACHE_INVALID;
+      victim->Age = 0U;
+    }
+    else
+    {
+      victim->Tag = Address;
+      victim->Age = CacheCtx.Clock;
+      line        = victim;
+    }
+  }
+
+  return line;
+}
+
+/**
+  * @brief  Invalidate the cache lines overlapping a memory range.
+  * @param  Address Flash address
+  * @param  Size    Number of bytes
+  */
+static void CACHE_InvalidateRange(uint32_t Address, uint32_t Size)
+{
+  CACHE_Line_t *line;
+  uint32_t      start;
+  uint32_t      set;
+  uint32_t      way;
+
+  start = Address - (Address % UTIL_NOR_CACHE_LINE_SIZE);
+
+  for (set = 0U; set < UTIL_NOR_CACHE_SETS; set++)
+  {
+    for (way = 0U; way < UTIL_NOR_CACHE_WAYS; way++)
+    {
+      line = &CacheCtx.Lines[set][way];
+      if ((line->Tag != CACHE_INVALID) && (line->Tag >= start) && (line->Tag < (Address + Size)))
+      {
+        line->Tag = CACHE_INVALID;
+        line->Age = 0U;
+        CacheCtx.Stats.Invalidations++;
+      }
+    }
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_cache.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_nor_cache.c NOR flash read cache utility.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_NOR_CACHE_H
+#define STM32_NOR_CACHE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_NOR_CACHE STM32 NOR Flash Read Cache Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Exported_Constants STM32 NOR Flash Read Cache Utility Exported Constants
+  * @{
+  */
+#define UTIL_NOR_CACHE_OK                 0
+#define UTIL_NOR_CACHE_ERROR            (-1)
+
+/**
+  * @brief  Cache line size in bytes, power of 2
+  */
+#ifndef UTIL_NOR_CACHE_LINE_SIZE
+  #define UTIL_NOR_CACHE_LINE_SIZE        32U
+#endif
+
+/**
+  * @brief  Number of sets, power of 2
+  */
+#ifndef UTIL_NOR_CACHE_SETS
+  #define UTIL_NOR_CACHE_SETS             32U
+#endif
+
+/**
+  * @brief  Lines per set
+  */
+#ifndef UTIL_NOR_CACHE_WAYS
+  #define UTIL_NOR_CACHE_WAYS             4U
+#endif
+
+/**
+  * @brief  Reads larger than this size in bytes are not cached, so that bulk
+  *         reads do not evict the small hot data
+  */
+#ifndef UTIL_NOR_CACHE_MAX_READ
+  #define UTIL_NOR_CACHE_MAX_READ         128U
+#endif
+
+/**
+  * @brief  Status returned by the GetStatus flash service while an erase is
+  *         in progress, BSP_ERROR_BUSY
+  */
+#ifndef UTIL_NOR_CACHE_FLASH_BUSY
+  #define UTIL_NOR_CACHE_FLASH_BUSY       (-3)
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_Exported_Types STM32 NOR Flash Read Cache Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Flash services, with the BSP_OSPI_NOR service signatures.
+  *         Read, Write, GetStatus are BSP_OSPI_NOR_Read, BSP_OSPI_NOR_Write
+  *         and BSP_OSPI_NOR_GetStatus. Erase starts the erase of the given
+  *         size in bytes, 4096 or 65536, at the given address: it wraps
+  *         BSP_OSPI_NOR_Erase_Block, which takes an erase type instead:
+  *           int32_t Erase(uint32_t Instance, uint32_t Address, uint32_t Size)
+  *           {
+  *             return BSP_OSPI_NOR_Erase_Block(Instance, Address,
+  *                      (Size == 65536U) ? BSP_OSPI_NOR_ERASE_64K : BSP_OSPI_NOR_ERASE_4K);
+  *           }
+  *         EnableMapped and DisableMapped enter and leave memory-mapped mode
+  *         (BSP_OSPI_NOR_EnableMemoryMappedMode,
+  *         BSP_OSPI_NOR_DisableMemoryMappedMode). ReadMapped copies data from
+  *         the memory-mapped area, e.g. memcpy() from OCTOSPI1_BASE + address.
+  *         Lock/Unlock serialize the accesses of several threads.
+  *         EnableMapped, DisableMapped, ReadMapped, Lock and Unlock may be
+  *         NULL: reads are then always done in indirect mode.
+  */
+typedef struct
+{
+  int32_t ( *Read            ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *Write           ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *Erase           ) (uint32_t, uint32_t, uint32_t);
+  int32_t ( *GetStatus       ) (uint32_t);
+  int32_t ( *EnableMapped    ) (uint32_t);
+  int32_t ( *DisableMapped   ) (uint32_t);
+  int32_t ( *ReadMapped      ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  void    ( *Lock            ) (uint32_t);
+  void    ( *Unlock          ) (uint32_t);
+} UTIL_NOR_CACHE_Flash_t;
+
+/**
+  * @brief  Statistics. The hit rate is Hits / (Hits + Misses).
+  */
+typedef struct
+{
+  uint32_t Reads;          /*!< UTIL_NOR_CACHE_Read() calls                               */
+  uint32_t Hits;           /*!< Cache lines found in the cache                            */
+  uint32_t Misses;         /*!< Cache lines read from the memory                          */
+  uint32_t Bypasses;       /*!< Reads larger than UTIL_NOR_CACHE_MAX_READ                 */
+  uint32_t MappedReads;    /*!< Memory reads done in memory-mapped mode                   */
+  uint32_t IndirectReads;  /*!< Memory reads done in indirect mode                        */
+  uint32_t Writes;         /*!< UTIL_NOR_CACHE_Write() and UTIL_NOR_CACHE_Erase() calls   */
+  uint32_t Invalidations;  /*!< Cache lines invalidated by writes and erases              */
+  uint32_t ModeSwitches;   /*!< Memory-mapped mode entries                                */
+  uint32_t HitRate;        /*!< Hits per thousand cache line lookups                      */
+} UTIL_NOR_CACHE_Stats_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_NOR_CACHE_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_NOR_CACHE_Init(uint32_t Instance, const UTIL_NOR_CACHE_Flash_t *pFlash);
+int32_t  UTIL_NOR_CACHE_DeInit(void);
+int32_t  UTIL_NOR_CACHE_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
+int32_t  UTIL_NOR_CACHE_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size);
+int32_t  UTIL_NOR_CACHE_Erase(uint32_t BlockAddress, uint32_t BlockSize);
+void     UTIL_NOR_CACHE_Invalidate(void);
+void     UTIL_NOR_CACHE_GetStats(UTIL_NOR_CACHE_Stats_t *pStats);
+void     UTIL_NOR_CACHE_ResetStats(void);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_NOR_CACHE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,369 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_cache_bench.c
+  * @author  MCD Application Team
+  * @brief   This file includes a benchmark of the stm32_nor_cache.c read path
+  *          against direct indirect-mode reads.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - UTIL_NOR_CACHE_BENCH_Run() erases the benchmark area, writes a font
+     table and configuration records in it, and runs each workload twice:
+     with the Read service of the flash services (BSP_OSPI_NOR_Read, one
+     indirect command per read), then with UTIL_NOR_CACHE_Read():
+       o font:   24 bytes glyphs read in a 2280 bytes table,
+       o config: 32 bytes records among 16,
+       o scan:   1 KB sequential reads over the area, not cached,
+       o mixed:  glyph reads with a 256 bytes record written every 64 reads.
+     The data of the cached reads are checked.
+
+   - Results are sent to the Output service as CSV lines, after a header:
+         workload,path,reads,bytes,hits,misses,hit_rate,mapped_reads,
+         indirect_reads,mode_switches,time_us,read_ns
+     hit_rate is in hits per thousand line lookups, time_us is read from the
+     GetTime service and read_ns is the average time per read.
+
+   - On a host, the flash services are built on the mx25lm51245g_sim.c
+     simulated memory: ReadMapped calls MX25LM51245G_SIM_ReadMemoryMapped(),
+     DisableMapped calls MX25LM51245G_SIM_Abort() and GetTime returns
+     MX25LM51245G_SIM_GetTime() in us, i.e. the memory bus time. On target,
+     GetTime built on the DWT cycle counter also accounts the CPU time of the
+     HAL commands saved by memory-mapped mode.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_cache_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_NOR_CACHE_BENCH STM32 NOR Flash Read Cache Benchmark Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Private_Defines STM32 NOR Flash Read Cache Benchmark Utility Private Defines
+  * @{
+  */
+/* Workloads */
+#define BENCH_FONT            0U
+#define BENCH_CONFIG          1U
+#define BENCH_SCAN            2U
+#define BENCH_MIXED           3U
+#define BENCH_WORKLOADS       4U
+
+/* Area layout */
+#define BENCH_FONT_OFFSET     0x0000U
+#define BENCH_FONT_GLYPH      24U
+#define BENCH_FONT_GLYPHS     95U
+#define BENCH_CONFIG_OFFSET   0x1000U
+#define BENCH_CONFIG_RECORD   32U
+#define BENCH_CONFIG_RECORDS  16U
+#define BENCH_DATA_SIZE       0x2000U   /* Font table and records, written at start */
+#define BENCH_LOG_OFFSET      0x8000U   /* Records written by the mixed workload    */
+#define BENCH_LOG_RECORD      256U
+#define BENCH_SCAN_SIZE       1024U
+#define BENCH_WRITE_PERIOD    64U
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Private_Variables STM32 NOR Flash Read Cache Benchmark Utility Private Variables
+  * @{
+  */
+static const char *const BenchNames[BENCH_WORKLOADS] = {"font", "config", "scan", "mixed"};
+static uint8_t BenchBuffer[BENCH_SCAN_SIZE];
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Private_FunctionPrototypes STM32 NOR Flash Read Cache Benchmark Utility Private FunctionPrototypes
+  * @{
+  */
+static uint8_t BENCH_Pattern(uint32_t Offset);
+static int32_t BENCH_Prepare(const UTIL_NOR_CACHE_BENCH_Init_t *pInit);
+static int32_t BENCH_Run(const UTIL_NOR_CACHE_BENCH_Init_t *pInit, uint32_t Workload, uint32_t Cached);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Exported_Functions STM32 NOR Flash Read Cache Benchmark Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Run the benchmark. The STM32 NOR cache utility is left
+  *         de-initialized, the memory in indirect mode.
+  * @param  pInit Benchmark configuration
+  * @retval UTIL_NOR_CACHE_BENCH status
+  */
+int32_t UTIL_NOR_CACHE_BENCH_Run(const UTIL_NOR_CACHE_BENCH_Init_t *pInit)
+{
+  int32_t  ret = UTIL_NOR_CACHE_BENCH_OK;
+  uint32_t workload;
+  uint32_t cached;
+
+  if ((pInit == NULL) || (pInit->pFlash == NULL) || (pInit->Output == NULL) ||
+      ((pInit->Address % UTIL_NOR_CACHE_BENCH_AREA_SIZE) != 0U))
+  {
+    ret = UTIL_NOR_CACHE_BENCH_ERROR;
+  }
+  else
+  {
+    pInit->Output("workload,path,reads,bytes,hits,misses,hit_rate,mapped_reads,indirect_reads,mode_switches,time_us,read_ns\n");
+
+    for (workload = 0U; (workload < BENCH_WORKLOADS) && (ret == UTIL_NOR_CACHE_BENCH_OK); workload++)
+    {
+      for (cached = 0U; (cached < 2U) && (ret == UTIL_NOR_CACHE_BENCH_OK); cached++)
+      {
+        ret = BENCH_Run(pInit, workload, cached);
+      }
+    }
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Private_Functions STM32 NOR Flash Read Cache Benchmark Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Data written at an offset of the area.
+  * @param  Offset Offset in the area
+  * @retval Data byte
+  */
+static uint8_t BENCH_Pattern(uint32_t Offset)
+{
+  return (uint8_t)((Offset * 7U) + (Offset >> 8));
+}
+
+/**
+  * @brief  Erase the area and write the font table and the records, in
+  *         indirect mode.
+  * @param  pInit Benchmark configuration
+  * @retval UTIL_NOR_CACHE_BENCH status
+  */
+static int32_t BENCH_Prepare(const UTIL_NOR_CACHE_BENCH_Init_t *pInit)
+{
+  int32_t  ret = UTIL_NOR_CACHE_BENCH_OK;
+  int32_t  status;
+  uint32_t offset;
+  uint32_t i;
+
+  if (pInit->pFlash->Erase(pInit->Instance, pInit->Address, UTIL_NOR_CACHE_BENCH_AREA_SIZE) != 0)
+  {
+    ret = UTIL_NOR_CACHE_BENCH_ERROR;
+  }
+  else
+  {
+    do
+    {
+      status = pInit->pFlash->GetStatus(pInit->Instance);
+    } while (status == UTIL_NOR_CACHE_FLASH_BUSY);
+
+    if (status != 0)
+    {
+      ret = UTIL_NOR_CACHE_BENCH_ERROR;
+    }
+  }
+
+  for (offset = 0U; (offset < BENCH_DATA_SIZE) && (ret == UTIL_NOR_CACHE_BENCH_OK); offset += BENCH_LOG_RECORD)
+  {
+    for (i = 0U; i < BENCH_LOG_RECORD; i++)
+    {
+      BenchBuffer[i] = BENCH_Pattern(offset + i);
+    }
+    if (pInit->pFlash->Write(pInit->Instance, BenchBuffer, pInit->Address + offset, BENCH_LOG_RECORD) != 0)
+    {
+      ret = UTIL_NOR_CACHE_BENCH_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Run a workload and output its results.
+  * @param  pInit    Benchmark configuration
+  * @param  Workload Workload
+  * @param  Cached   0 for the Read service, 1 for UTIL_NOR_CACHE_Read()
+  * @retval UTIL_NOR_CACHE_BENCH status
+  */
+static int32_t BENCH_Run(const UTIL_NOR_CACHE_BENCH_Init_t *pInit, uint32_t Workload, uint32_t Cached)
+{
+  UTIL_NOR_CACHE_Stats_t stats;
+  int32_t  ret;
+  uint32_t iterations = (pInit->Iterations != 0U) ? pInit->Iterations : UTIL_NOR_CACHE_BENCH_ITERATIONS;
+  uint32_t seed = 1U;
+  uint32_t log = BENCH_LOG_OFFSET;
+  uint32_t bytes = 0U;
+  uint32_t reads = 0U;
+  uint32_t time_start = 0U;
+  uint32_t time_end = 0U;
+  uint32_t offset;
+  uint32_t size;
+  uint32_t i;
+  uint32_t j;
+  char     line[160];
+
+  (void)memset(&stats, 0, sizeof(stats));
+
+  ret = BENCH_Prepare(pInit);
+  if ((ret == UTIL_NOR_CACHE_BENCH_OK) && (Cached != 0U) &&
+      (UTIL_NOR_CACHE_Init(pInit->Instance, pInit->pFlash) != UTIL_NOR_CACHE_OK))
+  {
+    ret = UTIL_NOR_CACHE_BENCH_ERROR;
+  }
+
+  if (pInit->GetTime != NULL)
+  {
+    time_start = pInit->GetTime();
+  }
+
+  for (i = 0U; (i < iterations) && (ret == UTIL_NOR_CACHE_BENCH_OK); i++)
+  {
+    seed = (seed * 1103515245U) + 12345U;
+
+    if ((Workload == BENCH_MIXED) && ((i % BENCH_WRITE_PERIOD) == (BENCH_WRITE_PERIOD - 1U)))
+    {
+      /* Record written to the log, wrapping over the first records */
+      if ((log + BENCH_LOG_RECORD) > UTIL_NOR_CACHE_BENCH_AREA_SIZE)
+      {
+        log = BENCH_LOG_OFFSET;
+      }
+      (void)memset(BenchBuffer, (int32_t)(i & 0xFFU), BENCH_LOG_RECORD);
+      if (Cached != 0U)
+      {
+        ret = (UTIL_NOR_CACHE_Write(pInit->Address + log, BenchBuffer, BENCH_LOG_RECORD) == UTIL_NOR_CACHE_OK)
+              ? UTIL_NOR_CACHE_BENCH_OK : UTIL_NOR_CACHE_BENCH_ERROR;
+      }
+      else
+      {
+        ret = (pInit->pFlash->Write(pInit->Instance, BenchBuffer, pInit->Address + log, BENCH_LOG_RECORD) == 0)
+              ? UTIL_NOR_CACHE_BENCH_OK : UTIL_NOR_CACHE_BENCH_ERROR;
+      }
+      log += BENCH_LOG_RECORD;
+    }
+    else
+    {
+      if (Workload == BENCH_CONFIG)
+      {
+        offset = BENCH_CONFIG_OFFSET + (((seed >> 16) % BENCH_CONFIG_RECORDS) * BENCH_CONFIG_RECORD);
+        size   = BENCH_CONFIG_RECORD;
+      }
+      else if (Workload == BENCH_SCAN)
+      {
+        offset = (i * BENCH_SCAN_SIZE) % UTIL_NOR_CACHE_BENCH_AREA_SIZE;
+        size   = BENCH_SCAN_SIZE;
+      }
+      else
+      {
+        offset = BENCH_FONT_OFFSET + (((seed >> 16) % BENCH_FONT_GLYPHS) * BENCH_FONT_GLYPH);
+        size   = BENCH_FONT_GLYPH;
+      }
+
+      if (Cached != 0U)
+      {
+        ret = (UTIL_NOR_CACHE_Read(pInit->Address + offset, BenchBuffer, size) == UTIL_NOR_CACHE_OK)
+              ? UTIL_NOR_CACHE_BENCH_OK : UTIL_NOR_CACHE_BENCH_ERROR;
+      }
+      else
+      {
+        ret = (pInit->pFlash->Read(pInit->Instance, BenchBuffer, pInit->Address + offset, size) == 0)
+              ? UTIL_NOR_CACHE_BENCH_OK : UTIL_NOR_CACHE_BENCH_ERROR;
+      }
+
+      /* Check the data written by BENCH_Prepare() */
+      for (j = 0U; (j < size) && ((offset + j) < BENCH_DATA_SIZE) && (ret == UTIL_NOR_CACHE_BENCH_OK); j++)
+      {
+        if (BenchBuffer[j] != BENCH_Pattern(offset + j))
+        {
+          ret = UTIL_NOR_CACHE_BENCH_ERROR;
+        }
+      }
+
+      reads++;
+      bytes += size;
+    }
+  }
+
+  if (pInit->GetTime != NULL)
+  {
+    time_end = pInit->GetTime();
+  }
+
+  if (Cached != 0U)
+  {
+    UTIL_NOR_CACHE_GetStats(&stats);
+    if (UTIL_NOR_CACHE_DeInit() != UTIL_NOR_CACHE_OK)
+    {
+      ret = UTIL_NOR_CACHE_BENCH_ERROR;
+    }
+  }
+  else
+  {
+    stats.IndirectReads = reads;
+  }
+
+  if (ret == UTIL_NOR_CACHE_BENCH_OK)
+  {
+    (void)snprintf(line, sizeof(line), "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                   BenchNames[Workload], (Cached != 0U) ? "cached" : "indirect", (unsigned long)reads,
+                   (unsigned long)bytes, (unsigned long)stats.Hits, (unsigned long)stats.Misses,
+                   (unsigned long)stats.HitRate, (unsigned long)stats.MappedReads,
+                   (unsigned long)stats.IndirectReads, (unsigned long)stats.ModeSwitches,
+                   (unsigned long)(time_end - time_start),
+                   (unsigned long)((reads == 0U) ? 0U : ((uint64_t)(time_end - time_start) * 1000U) / reads));
+    pInit->Output(line);
+  }
+
+  return ret;
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_cache_bench.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_nor_cache_bench.c NOR flash read cache benchmark.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_NOR_CACHE_BENCH_H
+#define STM32_NOR_CACHE_BENCH_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_cache.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_NOR_CACHE_BENCH STM32 NOR Flash Read Cache Benchmark Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Exported_Constants STM32 NOR Flash Read Cache Benchmark Utility Exported Constants
+  * @{
+  */
+#define UTIL_NOR_CACHE_BENCH_OK                0
+#define UTIL_NOR_CACHE_BENCH_ERROR           (-1)
+
+/**
+  * @brief  Benchmark area size in bytes, erased with one Erase service call
+  */
+#define UTIL_NOR_CACHE_BENCH_AREA_SIZE         65536U
+
+/**
+  * @brief  Default reads per workload
+  */
+#ifndef UTIL_NOR_CACHE_BENCH_ITERATIONS
+  #define UTIL_NOR_CACHE_BENCH_ITERATIONS      2048U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_CACHE_BENCH_Exported_Types STM32 NOR Flash Read Cache Benchmark Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Benchmark configuration
+  */
+typedef struct
+{
+  const UTIL_NOR_CACHE_Flash_t *pFlash;              /*!< Flash services, called directly for the uncached runs         */
+  uint32_t                      Instance;            /*!< Flash instance passed to the flash services                   */
+  uint32_t                      Address;             /*!< Benchmark area, aligned on UTIL_NOR_CACHE_BENCH_AREA_SIZE,
+                                                          erased and written by the benchmark                           */
+  uint32_t                    (*GetTime)(void);      /*!< Running time in microseconds, may be NULL                     */
+  void                        (*Output)(const char *); /*!< Receives each CSV line                                      */
+  uint32_t                      Iterations;          /*!< Reads per workload, 0 for UTIL_NOR_CACHE_BENCH_ITERATIONS     */
+} UTIL_NOR_CACHE_BENCH_Init_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_NOR_CACHE_BENCH_Exported_Functions
+  * @{
+  */
+int32_t UTIL_NOR_CACHE_BENCH_Run(const UTIL_NOR_CACHE_BENCH_Init_t *pInit);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_NOR_CACHE_BENCH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,835 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_erase.c
+  * @author  MCD Application Team
+  * @brief   This file includes a NOR flash erase scheduler keeping a pool of
+  *          erased blocks, erasing in the background and suspending the
+  *          erase in progress for the application reads and writes.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver manages an area of a NOR flash, e.g. the MX25LM51245G, in
+     UTIL_NOR_ERASE_BLOCK_SIZE blocks for applications such as data loggers,
+     which cannot wait for an erase (up to 1 s for 64 KB on the
+     MX25LM51245G) when they need a new block.
+
+   - Call UTIL_NOR_ERASE_Init() with the flash services, built on the BSP
+     services (see UTIL_NOR_ERASE_Flash_t), and the area. All the blocks are
+     then considered as used: their content is kept.
+
+   - UTIL_NOR_ERASE_Free() releases blocks, which are then erased in the
+     background. UTIL_NOR_ERASE_Alloc() returns an erased block, immediately
+     when the pool is not empty; otherwise the allocation stalls until a
+     block is erased.
+
+   - Erases are started and polled by UTIL_NOR_ERASE_Process(). With RTX,
+     run it in a low priority thread, UTIL_NOR_ERASE_Thread(), created with
+     osThreadNew(UTIL_NOR_ERASE_Thread, NULL, &attr) where attr.priority is
+     osPriorityLow, and use a mutex for the Lock/Unlock services. The thread
+     sleeps between two status polls: the CPU is free during the erase.
+     Without RTOS, call UTIL_NOR_ERASE_Process() from the main loop.
+
+   - Blocks are erased until PoolDepth blocks are ready, or all the released
+     blocks are erased when PoolDepth is 0. The erase granularity minimizes
+     the total erase time: a 64 KB aligned sector with no used block is
+     erased at once when its released blocks would take longer to erase one
+     by one (UTIL_NOR_ERASE_4K_TIME and UTIL_NOR_ERASE_64K_TIME). Stalled
+     allocations use 4 KB erases, the shortest wait.
+
+   - The memory must be accessed with UTIL_NOR_ERASE_Read() and
+     UTIL_NOR_ERASE_Write() only: they suspend the erase in progress, if any,
+     access the memory and resume the erase. Writes to the managed area are
+     only allowed in the allocated blocks.
+
+   - UTIL_NOR_ERASE_GetStats() returns the pool depth and its low-water mark,
+     the erases done at each granularity and their time, the reads and
+     writes which suspended an erase, and the stalled allocations.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_erase.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_NOR_ERASE STM32 NOR Flash Background Erase Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Private_Types STM32 NOR Flash Background Erase Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  const UTIL_NOR_ERASE_Flash_t *pFlash;
+  uint32_t                      Instance;
+  uint32_t                      Address;
+  uint32_t                      BlockCount;
+  uint32_t                      PoolDepth;
+  uint8_t                      *pStates;
+  uint32_t                      Erased;       /* Blocks in the pool                       */
+  uint32_t                      Dirty;        /* Blocks to be erased                      */
+  uint32_t                      Erasing;      /* An erase is in progress                  */
+  uint32_t                      EraseBlock;   /* First block of the erase in progress     */
+  uint32_t                      EraseCount;   /* Blocks of the erase in progress          */
+  uint32_t                      EraseTick;    /* Start of the erase in progress           */
+  uint32_t                      EraseCursor;  /* Next block to check for a 4K erase       */
+  uint32_t                      AllocCursor;  /* Next block to check for an allocation    */
+  UTIL_NOR_ERASE_Stats_t        Stats;
+} ERASE_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Private_Defines STM32 NOR Flash Background Erase Utility Private Defines
+  * @{
+  */
+#define ERASE_BLOCKS_PER_SECTOR   (UTIL_NOR_ERASE_SECTOR_SIZE / UTIL_NOR_ERASE_BLOCK_SIZE)
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Private_FunctionPrototypes STM32 NOR Flash Background Erase Utility Private FunctionPrototypes
+  * @{
+  */
+static void     ERASE_Lock(void);
+static void     ERASE_Unlock(void);
+static void     ERASE_Delay(uint32_t Delay);
+static uint32_t ERASE_GetTick(void);
+static void     ERASE_SetState(uint32_t Block, uint8_t State);
+static uint32_t ERASE_Find(uint8_t State, uint32_t Cursor);
+static uint32_t ERASE_FindSector(void);
+static int32_t  ERASE_Start(uint32_t Sector);
+static void     ERASE_End(uint8_t State);
+static void     ERASE_Poll(void);
+static int32_t  ERASE_Suspend(uint32_t *pSuspended);
+static void     ERASE_Resume(uint32_t Suspended);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Private_Variables STM32 NOR Flash Background Erase Utility Private Variables
+  * @{
+  */
+static ERASE_Ctx_t EraseCtx;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Exported_Functions STM32 NOR Flash Background Erase Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the erase scheduler. All the blocks are considered as
+  *         used until released by UTIL_NOR_ERASE_Free().
+  * @param  pInit Configuration
+  * @retval UTIL_NOR_ERASE status
+  */
+int32_t UTIL_NOR_ERASE_Init(const UTIL_NOR_ERASE_Init_t *pInit)
+{
+  int32_t  ret = UTIL_NOR_ERASE_OK;
+  uint32_t block;
+
+  if ((pInit == NULL) || (pInit->pFlash == NULL) || (pInit->pStates == NULL) || (pInit->BlockCount == 0U) ||
+      ((pInit->Address % UTIL_NOR_ERASE_BLOCK_SIZE) != 0U))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else if ((pInit->pFlash->Read == NULL) || (pInit->pFlash->Write == NULL) || (pInit->pFlash->Erase == NULL) ||
+           (pInit->pFlash->GetStatus == NULL) || (pInit->pFlash->Suspend == NULL) || (pInit->pFlash->Resume == NULL))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    EraseCtx.pFlash      = pInit->pFlash;
+    EraseCtx.Instance    = pInit->Instance;
+    EraseCtx.Address     = pInit->Address;
+    EraseCtx.BlockCount  = pInit->BlockCount;
+    EraseCtx.PoolDepth   = pInit->PoolDepth;
+    EraseCtx.pStates     = pInit->pStates;
+    EraseCtx.Erased      = 0U;
+    EraseCtx.Dirty       = 0U;
+    EraseCtx.Erasing     = 0U;
+    EraseCtx.EraseCursor = 0U;
+    EraseCtx.AllocCursor = 0U;
+
+    for (block = 0U; block < EraseCtx.BlockCount; block++)
+    {
+      EraseCtx.pStates[block] = UTIL_NOR_ERASE_USED;
+    }
+
+    UTIL_NOR_ERASE_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Allocate an erased block, waiting for an erase when the pool is
+  *         empty.
+  * @param  pAddress Address of the block
+  * @retval UTIL_NOR_ERASE status, UTIL_NOR_ERASE_ERROR when no block is
+  *         erased or released
+  */
+int32_t UTIL_NOR_ERASE_Alloc(uint32_t *pAddress)
+{
+  int32_t  ret = UTIL_NOR_ERASE_OK;
+  uint32_t stalled = 0U;
+  uint32_t start = 0U;
+  uint32_t elapsed;
+  uint32_t block;
+
+  if ((EraseCtx.pFlash == NULL) || (pAddress == NULL))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    ERASE_Lock();
+
+    /* The erase in progress may be completed */
+    ERASE_Poll();
+
+    while ((ret == UTIL_NOR_ERASE_OK) && (EraseCtx.Erased == 0U))
+    {
+      if (stalled == 0U)
+      {
+        stalled = 1U;
+        start   = ERASE_GetTick();
+        EraseCtx.Stats.Stalls++;
+      }
+
+      /* A 4K erase is the shortest wait */
+      if ((EraseCtx.Erasing == 0U) && (ERASE_Start(0U) != UTIL_NOR_ERASE_OK))
+      {
+        ret = UTIL_NOR_ERASE_ERROR;
+      }
+      else
+      {
+        ERASE_Unlock();
+        ERASE_Delay(UTIL_NOR_ERASE_POLL_PERIOD);
+        ERASE_Lock();
+        ERASE_Poll();
+      }
+    }
+
+    if (ret == UTIL_NOR_ERASE_OK)
+    {
+      block                = ERASE_Find(UTIL_NOR_ERASE_ERASED, EraseCtx.AllocCursor);
+      EraseCtx.AllocCursor = (block + 1U) % EraseCtx.BlockCount;
+      ERASE_SetState(block, UTIL_NOR_ERASE_USED);
+      *pAddress = EraseCtx.Address + (block * UTIL_NOR_ERASE_BLOCK_SIZE);
+
+      EraseCtx.Stats.Allocs++;
+      if (EraseCtx.Erased < EraseCtx.Stats.MinPoolDepth)
+      {
+        EraseCtx.Stats.MinPoolDepth = EraseCtx.Erased;
+      }
+    }
+
+    if (stalled != 0U)
+    {
+      elapsed = ERASE_GetTick() - start;
+      EraseCtx.Stats.StallTime += elapsed;
+      if (elapsed > EraseCtx.Stats.MaxStallTime)
+      {
+        EraseCtx.Stats.MaxStallTime = elapsed;
+      }
+    }
+
+    ERASE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Release used blocks, to be erased in the background.
+  * @param  Address Address, aligned on a block
+  * @param  Size    Size in bytes, multiple of the block size
+  * @retval UTIL_NOR_ERASE status
+  */
+int32_t UTIL_NOR_ERASE_Free(uint32_t Address, uint32_t Size)
+{
+  int32_t  ret = UTIL_NOR_ERASE_OK;
+  uint32_t block;
+  uint32_t end;
+
+  if ((EraseCtx.pFlash == NULL) || (Address < EraseCtx.Address) ||
+      ((Address % UTIL_NOR_ERASE_BLOCK_SIZE) != 0U) || ((Size % UTIL_NOR_ERASE_BLOCK_SIZE) != 0U))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    block = (Address - EraseCtx.Address) / UTIL_NOR_ERASE_BLOCK_SIZE;
+    end   = block + (Size / UTIL_NOR_ERASE_BLOCK_SIZE);
+
+    if ((block >= EraseCtx.BlockCount) || (end > EraseCtx.BlockCount))
+    {
+      ret = UTIL_NOR_ERASE_ERROR;
+    }
+    else
+    {
+      ERASE_Lock();
+
+      for (; block < end; block++)
+      {
+        if (EraseCtx.pStates[block] == UTIL_NOR_ERASE_USED)
+        {
+          ERASE_SetState(block, UTIL_NOR_ERASE_DIRTY);
+        }
+      }
+
+      ERASE_Unlock();
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read the memory, suspending the erase in progress.
+  * @param  ReadAddr Flash address
+  * @param  pData    Destination
+  * @param  Size     Number of bytes
+  * @retval UTIL_NOR_ERASE status
+  */
+int32_t UTIL_NOR_ERASE_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
+{
+  int32_t  ret;
+  uint32_t suspended;
+
+  if ((EraseCtx.pFlash == NULL) || (pData == NULL))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    ERASE_Lock();
+
+    ret = ERASE_Suspend(&suspended);
+    if ((ret == UTIL_NOR_ERASE_OK) && (EraseCtx.pFlash->Read(EraseCtx.Instance, pData, ReadAddr, Size) != 0))
+    {
+      ret = UTIL_NOR_ERASE_ERROR;
+    }
+    ERASE_Resume(suspended);
+
+    ERASE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Program the memory, suspending the erase in progress. Within the
+  *         managed area, only allocated blocks can be written.
+  * @param  WriteAddr Flash address
+  * @param  pData     Data
+  * @param  Size      Number of bytes
+  * @retval UTIL_NOR_ERASE status
+  */
+int32_t UTIL_NOR_ERASE_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size)
+{
+  int32_t  ret = UTIL_NOR_ERASE_OK;
+  uint32_t suspended;
+  uint32_t address;
+  uint32_t block;
+
+  if ((EraseCtx.pFlash == NULL) || (pData == NULL) || (Size == 0U))
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    ERASE_Lock();
+
+    for (address = WriteAddr - (WriteAddr % UTIL_NOR_ERASE_BLOCK_SIZE); address < (WriteAddr + Size);
+         address += UTIL_NOR_ERASE_BLOCK_SIZE)
+    {
+      block = (address - EraseCtx.Address) / UTIL_NOR_ERASE_BLOCK_SIZE;
+      if ((address >= EraseCtx.Address) && (block < EraseCtx.BlockCount) &&
+          (EraseCtx.pStates[block] != UTIL_NOR_ERASE_USED))
+      {
+        ret = UTIL_NOR_ERASE_ERROR;
+      }
+    }
+
+    if (ret == UTIL_NOR_ERASE_OK)
+    {
+      ret = ERASE_Suspend(&suspended);
+      if ((ret == UTIL_NOR_ERASE_OK) && (EraseCtx.pFlash->Write(EraseCtx.Instance, (uint8_t *)pData, WriteAddr, Size) != 0))
+      {
+        ret = UTIL_NOR_ERASE_ERROR;
+      }
+      ERASE_Resume(suspended);
+    }
+
+    ERASE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Background processing: check the end of the erase in progress and
+  *         start the next erase while the pool is below its depth.
+  * @retval UTIL_NOR_ERASE_OK while an erase is in progress,
+  *         UTIL_NOR_ERASE_IDLE when there is nothing to erase
+  */
+int32_t UTIL_NOR_ERASE_Process(void)
+{
+  int32_t ret = UTIL_NOR_ERASE_IDLE;
+
+  if (EraseCtx.pFlash == NULL)
+  {
+    ret = UTIL_NOR_ERASE_ERROR;
+  }
+  else
+  {
+    ERASE_Lock();
+
+    ERASE_Poll();
+
+    if (EraseCtx.Erasing != 0U)
+    {
+      ret = UTIL_NOR_ERASE_OK;
+    }
+    else if ((EraseCtx.PoolDepth == 0U) || (EraseCtx.Erased < EraseCtx.PoolDepth))
+    {
+      ret = ERASE_Start(1U);
+    }
+    else
+    {
+      /* The pool is full */
+    }
+
+    ERASE_Unlock();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Erase thread body, for osThreadNew(). Never returns.
+  * @param  argument Not used
+  */
+void UTIL_NOR_ERASE_Thread(void *argument)
+{
+  (void)argument;
+
+  for (;;)
+  {
+    if (UTIL_NOR_ERASE_Process() == UTIL_NOR_ERASE_OK)
+    {
+      ERASE_Delay(UTIL_NOR_ERASE_POLL_PERIOD);
+    }
+    else
+    {
+      ERASE_Delay(UTIL_NOR_ERASE_IDLE_PERIOD);
+    }
+  }
+}
+
+/**
+  * @brief  Get the statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_NOR_ERASE_GetStats(UTIL_NOR_ERASE_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    *pStats             = EraseCtx.Stats;
+    pStats->PoolDepth   = EraseCtx.Erased;
+    pStats->DirtyBlocks = EraseCtx.Dirty;
+  }
+}
+
+/**
+  * @brief  Reset the statistics. The pool low-water mark restarts from the
+  *         current pool depth.
+  */
+void UTIL_NOR_ERASE_ResetStats(void)
+{
+  EraseCtx.Stats.PoolDepth    = 0U;
+  EraseCtx.Stats.MinPoolDepth = EraseCtx.Erased;
+  EraseCtx.Stats.DirtyBlocks  = 0U;
+  EraseCtx.Stats.Allocs       = 0U;
+  EraseCtx.Stats.Erases4K     = 0U;
+  EraseCtx.Stats.Erases64K    = 0U;
+  EraseCtx.Stats.EraseErrors  = 0U;
+  EraseCtx.Stats.EraseTime    = 0U;
+  EraseCtx.Stats.Suspends     = 0U;
+  EraseCtx.Stats.Stalls       = 0U;
+  EraseCtx.Stats.StallTime    = 0U;
+  EraseCtx.Stats.MaxStallTime = 0U;
+}
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Private_Functions STM32 NOR Flash Background Erase Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Serialize the accesses to the memory and to the block states.
+  */
+static void ERASE_Lock(void)
+{
+  if (EraseCtx.pFlash->Lock != NULL)
+  {
+    EraseCtx.pFlash->Lock(EraseCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Release the lock.
+  */
+static void ERASE_Unlock(void)
+{
+  if (EraseCtx.pFlash->Unlock != NULL)
+  {
+    EraseCtx.pFlash->Unlock(EraseCtx.Instance);
+  }
+}
+
+/**
+  * @brief  Sleep, called without the lock.
+  * @param  Delay Delay in ms
+  */
+static void ERASE_Delay(uint32_t Delay)
+{
+  if (EraseCtx.pFlash->Delay != NULL)
+  {
+    EraseCtx.pFlash->Delay(Delay);
+  }
+}
+
+/**
+  * @brief  Get the tick for the statistics.
+  * @retval Tick, 0 without GetTick service
+  */
+static uint32_t ERASE_GetTick(void)
+{
+  uint32_t tick = 0U;
+
+  if (EraseCtx.pFlash->GetTick != NULL)
+  {
+    tick = EraseCtx.pFlash->GetTick();
+  }
+
+  return tick;
+}
+
+/**
+  * @brief  Set the state of a block, keeping the pool and dirty counts.
+  * @param  Block Block index
+  * @param  State New state
+  */
+static void ERASE_SetState(uint32_t Block, uint8_t State)
+{
+  if (EraseCtx.pStates[Block] == UTIL_NOR_ERASE_ERASED)
+  {
+    EraseCtx.Erased--;
+  }
+  else if (EraseCtx.pStates[Block] == UTIL_NOR_ERASE_DIRTY)
+  {
+    EraseCtx.Dirty--;
+  }
+  else
+  {
+    /* Not counted */
+  }
+
+  if (State == UTIL_NOR_ERASE_ERASED)
+  {
+    EraseCtx.Erased++;
+  }
+  else if (State == UTIL_NOR_ERASE_DIRTY)
+  {
+    EraseCtx.Dirty++;
+  }
+  else
+  {
+    /* Not counted */
+  }
+
+  EraseCtx.pStates[Block] = State;
+}
+
+/**
+  * @brief  Find a block in a given state, round robin from a cursor so that
+  *         the wear is spread over the area.
+  * @param  State  Block state
+  * @param  Cursor First block to check
+  * @retval Block index, BlockCount if none
+  */
+static uint32_t ERASE_Find(uint8_t State, uint32_t Cursor)
+{
+  uint32_t ret = EraseCtx.BlockCount;
+  uint32_t index;
+  uint32_t block;
+
+  for (index = 0U; (index < EraseCtx.BlockCount) && (ret == EraseCtx.BlockCount); index++)
+  {
+    block = (Cursor + index) % EraseCtx.BlockCount;
+    if (EraseCtx.pStates[block] == State)
+    {
+      ret = block;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Find the 64K sector with the most released blocks, among the
+  *         sectors with no used block where one 64K erase is shorter than
+  *         the 4K erases of the released blocks.
+  * @retval Index of the first block of the sector, BlockCount if none
+  */
+static uint32_t ERASE_FindSector(void)
+{
+  uint32_t ret = EraseCtx.BlockCount;
+  uint32_t best = 0U;
+  uint32_t first;
+  uint32_t dirty;
+  uint32_t usable;
+  uint32_t index;
+  uint8_t  state;
+
+  /* First block aligned on a sector */
+  first = ((UTIL_NOR_ERASE_SECTOR_SIZE - (EraseCtx.Address % UTIL_NOR_ERASE_SECTOR_SIZE)) %
+           UTIL_NOR_ERASE_SECTOR_SIZE) / UTIL_NOR_ERASE_BLOCK_SIZE;
+
+  for (; (first + ERASE_BLOCKS_PER_SECTOR) <= EraseCtx.BlockCount; first += ERASE_BLOCKS_PER_SECTOR)
+  {
+    dirty  = 0U;
+    usable = 1U;
+    for (index = 0U; index < ERASE_BLOCKS_PER_SECTOR; index++)
+    {
+      state = EraseCtx.pStates[first + index];
+      if (state == UTIL_NOR_ERASE_DIRTY)
+      {
+        dirty++;
+      }
+      else if (state != UTIL_NOR_ERASE_ERASED)
+      {
+        usable = 0U;
+      }
+      else
+      {
+        /* Erased again with the sector */
+      }
+    }
+
+    if ((usable != 0U) && (dirty > best) &&
+        ((dirty * UTIL_NOR_ERASE_4K_TIME) > UTIL_NOR_ERASE_64K_TIME))
+    {
+      best = dirty;
+      ret  = first;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Start an erase of released blocks.
+  * @param  Sector 1 to allow a 64K erase, 0 for a 4K erase
+  * @retval UTIL_NOR_ERASE status, UTIL_NOR_ERASE_IDLE when nothing is released
+  */
+static int32_t ERASE_Start(uint32_t Sector)
+{
+  int32_t  ret = UTIL_NOR_ERASE_IDLE;
+  uint32_t block = EraseCtx.BlockCount;
+  uint32_t count = 1U;
+  uint32_t index;
+
+  if (Sector != 0U)
+  {
+    block = ERASE_FindSector();
+  }
+
+  if (block < EraseCtx.BlockCount)
+  {
+    count = ERASE_BLOCKS_PER_SECTOR;
+  }
+  else if (EraseCtx.Dirty != 0U)
+  {
+    block                = ERASE_Find(UTIL_NOR_ERASE_DIRTY, EraseCtx.EraseCursor);
+    EraseCtx.EraseCursor = (block + 1U) % EraseCtx.BlockCount;
+  }
+  else
+  {
+    /* Nothing to erase */
+  }
+
+  if (block < EraseCtx.BlockCount)
+  {
+    for (index = 0U; index < count; index++)
+    {
+      ERASE_SetState(block + index, UTIL_NOR_ERASE_ERASING);
+    }
+    EraseCtx.Erasing    = 1U;
+    EraseCtx.EraseBlock = block;
+    EraseCtx.EraseCount = count;
+    EraseCtx.EraseTick  = ERASE_GetTick();
+
+    if (EraseCtx.pFlash->Erase(EraseCtx.Instance, EraseCtx.Address + (block * UTIL_NOR_ERASE_BLOCK_SIZE),
+                               count * UTIL_NOR_ERASE_BLOCK_SIZE) != 0)
+    {
+      EraseCtx.Stats.EraseErrors++;
+      ERASE_End(UTIL_NOR_ERASE_DIRTY);
+      ret = UTIL_NOR_ERASE_ERROR;
+    }
+    else
+    {
+      if (count == 1U)
+      {
+        EraseCtx.Stats.Erases4K++;
+      }
+      else
+      {
+        EraseCtx.Stats.Erases64K++;
+      }
+      ret = UTIL_NOR_ERASE_OK;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  End the erase in progress.
+  * @param  State New state of the erased blocks
+  */
+static void ERASE_End(uint8_t State)
+{
+  uint32_t index;
+
+  for (index = 0U; index < EraseCtx.EraseCount; index++)
+  {
+    ERASE_SetState(EraseCtx.EraseBlock + index, State);
+  }
+  EraseCtx.Erasing          = 0U;
+  EraseCtx.Stats.EraseTime += ERASE_GetTick() - EraseCtx.EraseTick;
+}
+
+/**
+  * @brief  Check the end of the erase in progress.
+  */
+static void ERASE_Poll(void)
+{
+  int32_t status;
+
+  if (EraseCtx.Erasing != 0U)
+  {
+    status = EraseCtx.pFlash->GetStatus(EraseCtx.Instance);
+    if (status == 0)
+    {
+      ERASE_End(UTIL_NOR_ERASE_ERASED);
+    }
+    else if (status != UTIL_NOR_ERASE_FLASH_BUSY)
+    {
+      EraseCtx.Stats.EraseErrors++;
+      ERASE_End(UTIL_NOR_ERASE_BAD);
+    }
+    else
+    {
+      /* Still erasing */
+    }
+  }
+}
+
+/**
+  * @brief  Suspend the erase in progress before a memory access.
+  * @param  pSuspended Set to 1 if the erase was suspended
+  * @retval UTIL_NOR_ERASE status
+  */
+static int32_t ERASE_Suspend(uint32_t *pSuspended)
+{
+  int32_t ret = UTIL_NOR_ERASE_OK;
+
+  *pSuspended = 0U;
+
+  if (EraseCtx.Erasing != 0U)
+  {
+    if (EraseCtx.pFlash->Suspend(EraseCtx.Instance) == 0)
+    {
+      *pSuspended = 1U;
+      EraseCtx.Stats.Suspends++;
+    }
+    else
+    {
+      /* The erase may have completed before the suspend */
+      ERASE_Poll();
+      if (EraseCtx.Erasing != 0U)
+      {
+        ret = UTIL_NOR_ERASE_ERROR;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Resume the erase suspended by ERASE_Suspend().
+  * @param  Suspended 1 if the erase was suspended
+  */
+static void ERASE_Resume(uint32_t Suspended)
+{
+  /* An erase which cannot be resumed is done again */
+  if ((Suspended != 0U) && (EraseCtx.pFlash->Resume(EraseCtx.Instance) != 0))
+  {
+    EraseCtx.Stats.EraseErrors++;
+    ERASE_End(UTIL_NOR_ERASE_DIRTY);
+  }
+}
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
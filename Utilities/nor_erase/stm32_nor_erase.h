@@ -0,0 +1,224 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_erase.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_nor_erase.c NOR flash background erase utility.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_NOR_ERASE_H
+#define STM32_NOR_ERASE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_NOR_ERASE STM32 NOR Flash Background Erase Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Exported_Constants STM32 NOR Flash Background Erase Utility Exported Constants
+  * @{
+  */
+#define UTIL_NOR_ERASE_OK                 0
+#define UTIL_NOR_ERASE_ERROR            (-1)
+#define UTIL_NOR_ERASE_IDLE               1   /* UTIL_NOR_ERASE_Process(): nothing to do */
+
+/**
+  * @brief  Block states
+  */
+#define UTIL_NOR_ERASE_USED               0U  /* Allocated, or content to be kept      */
+#define UTIL_NOR_ERASE_DIRTY              1U  /* Released, to be erased                */
+#define UTIL_NOR_ERASE_ERASING            2U  /* Erase in progress                     */
+#define UTIL_NOR_ERASE_ERASED             3U  /* In the pool                           */
+#define UTIL_NOR_ERASE_BAD                4U  /* Erase failed, not used any more       */
+
+/**
+  * @brief  Block size in bytes: allocation unit and small erase granularity
+  */
+#define UTIL_NOR_ERASE_BLOCK_SIZE         4096U
+
+/**
+  * @brief  Large erase granularity in bytes
+  */
+#define UTIL_NOR_ERASE_SECTOR_SIZE        65536U
+
+/**
+  * @brief  Status returned by the GetStatus flash service while an erase is
+  *         in progress, BSP_ERROR_BUSY
+  */
+#ifndef UTIL_NOR_ERASE_FLASH_BUSY
+  #define UTIL_NOR_ERASE_FLASH_BUSY       (-3)
+#endif
+
+/**
+  * @brief  Erase times in ms, used to choose between 4K and 64K erases:
+  *         MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME and
+  *         MX25LM51245G_SECTOR_ERASE_MAX_TIME
+  */
+#ifndef UTIL_NOR_ERASE_4K_TIME
+  #define UTIL_NOR_ERASE_4K_TIME          400U
+#endif
+#ifndef UTIL_NOR_ERASE_64K_TIME
+  #define UTIL_NOR_ERASE_64K_TIME         1000U
+#endif
+
+/**
+  * @brief  Delays in ms of UTIL_NOR_ERASE_Thread() between two status polls
+  *         of the erase in progress, and when there is nothing to erase
+  */
+#ifndef UTIL_NOR_ERASE_POLL_PERIOD
+  #define UTIL_NOR_ERASE_POLL_PERIOD      2U
+#endif
+#ifndef UTIL_NOR_ERASE_IDLE_PERIOD
+  #define UTIL_NOR_ERASE_IDLE_PERIOD      100U
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_ERASE_Exported_Types STM32 NOR Flash Background Erase Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Flash services, with the BSP_OSPI_NOR service signatures.
+  *         Read and Write are BSP_OSPI_NOR_Read and BSP_OSPI_NOR_Write.
+  *         Erase starts the erase of the UTIL_NOR_ERASE_BLOCK_SIZE or
+  *         UTIL_NOR_ERASE_SECTOR_SIZE bytes at the given address and returns.
+  *         BSP_OSPI_NOR_Erase_Block takes an erase type instead of a size,
+  *         so it needs a wrapper:
+  *           int32_t Erase(uint32_t Instance, uint32_t Address, uint32_t Size)
+  *           {
+  *             return BSP_OSPI_NOR_Erase_Block(Instance, Address,
+  *                      (Size == UTIL_NOR_ERASE_SECTOR_SIZE) ? BSP_OSPI_NOR_ERASE_64K : BSP_OSPI_NOR_ERASE_4K);
+  *           }
+  *         GetStatus returns 0 when the memory is
+  *         ready and UTIL_NOR_ERASE_FLASH_BUSY during the erase
+  *         (BSP_OSPI_NOR_GetStatus). Suspend and Resume suspend the erase in
+  *         progress so that the memory can be accessed, and resume it
+  *         (BSP_OSPI_NOR_SuspendErase, BSP_OSPI_NOR_ResumeErase).
+  *         Lock/Unlock serialize the accesses of the erase thread and of the
+  *         application threads (osMutexAcquire/osMutexRelease). Delay sleeps
+  *         for the given ms (osDelay). GetTick returns a ms tick
+  *         (osKernelGetTickCount), for the statistics only.
+  *         Lock, Unlock, Delay and GetTick may be NULL.
+  */
+typedef struct
+{
+  int32_t  ( *Read            ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t  ( *Write           ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t  ( *Erase           ) (uint32_t, uint32_t, uint32_t);
+  int32_t  ( *GetStatus       ) (uint32_t);
+  int32_t  ( *Suspend         ) (uint32_t);
+  int32_t  ( *Resume          ) (uint32_t);
+  void     ( *Lock            ) (uint32_t);
+  void     ( *Unlock          ) (uint32_t);
+  void     ( *Delay           ) (uint32_t);
+  uint32_t ( *GetTick         ) (void);
+} UTIL_NOR_ERASE_Flash_t;
+
+/**
+  * @brief  Erase scheduler configuration
+  */
+typedef struct
+{
+  const UTIL_NOR_ERASE_Flash_t *pFlash;     /*!< Flash services                                      */
+  uint32_t                      Instance;   /*!< Flash instance passed to the flash services         */
+  uint32_t                      Address;    /*!< Managed area address, aligned on a block            */
+  uint32_t                      BlockCount; /*!< Managed area size in blocks                         */
+  uint32_t                      PoolDepth;  /*!< Erased blocks kept ready, 0 to erase all the
+                                                 released blocks                                     */
+  uint8_t                      *pStates;    /*!< BlockCount entries, block states                    */
+} UTIL_NOR_ERASE_Init_t;
+
+/**
+  * @brief  Statistics. Times are in GetTick units.
+  */
+typedef struct
+{
+  uint32_t PoolDepth;      /*!< Erased blocks ready for UTIL_NOR_ERASE_Alloc()             */
+  uint32_t MinPoolDepth;   /*!< Lowest pool depth left by UTIL_NOR_ERASE_Alloc()           */
+  uint32_t DirtyBlocks;    /*!< Released blocks waiting for an erase                      */
+  uint32_t Allocs;         /*!< Blocks allocated                                          */
+  uint32_t Erases4K;       /*!< 4K erases                                                 */
+  uint32_t Erases64K;      /*!< 64K erases                                                */
+  uint32_t EraseErrors;    /*!< Erases failed or interrupted                              */
+  uint32_t EraseTime;      /*!< Time from the start to the end of the erases              */
+  uint32_t Suspends;       /*!< Reads and writes done by suspending an erase              */
+  uint32_t Stalls;         /*!< Allocations which found the pool empty                    */
+  uint32_t StallTime;      /*!< Time spent by the stalled allocations                     */
+  uint32_t MaxStallTime;   /*!< Longest stalled allocation                                */
+} UTIL_NOR_ERASE_Stats_t;
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_NOR_ERASE_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_NOR_ERASE_Init(const UTIL_NOR_ERASE_Init_t *pInit);
+int32_t  UTIL_NOR_ERASE_Alloc(uint32_t *pAddress);
+int32_t  UTIL_NOR_ERASE_Free(uint32_t Address, uint32_t Size);
+int32_t  UTIL_NOR_ERASE_Read(uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
+int32_t  UTIL_NOR_ERASE_Write(uint32_t WriteAddr, const uint8_t *pData, uint32_t Size);
+int32_t  UTIL_NOR_ERASE_Process(void);
+void     UTIL_NOR_ERASE_Thread(void *argument);
+void     UTIL_NOR_ERASE_GetStats(UTIL_NOR_ERASE_Stats_t *pStats);
+void     UTIL_NOR_ERASE_ResetStats(void);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_NOR_ERASE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
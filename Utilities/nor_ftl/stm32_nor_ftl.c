@@ -0,0 +1,1126 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_ftl.c
+  * @author  MCD Application Team
+  * @brief   This file includes a log-structured flash translation layer for
+  *          NOR flash memories, with wear leveling and garbage collection.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* File Info: ------------------------------------------------------------------
+                                   User NOTES
+1. How To use this driver:
+--------------------------
+   - This driver stores fixed size logical pages in a partition of a NOR
+     flash, e.g. the MX25LM51245G through the BSP_OSPI_NOR services. A page
+     is never rewritten in place: each write programs the next free physical
+     page and remaps the logical page, so that small updates cost a page
+     program instead of a block erase.
+
+   - Fill a UTIL_NOR_FTL_Flash_t structure with the flash services. The BSP
+     read and write services can be used as is, the erase needs a wrapper:
+         int32_t Erase(uint32_t Instance, uint32_t Address)
+         {
+           return BSP_OSPI_NOR_Erase_Block(Instance, Address, BSP_OSPI_NOR_ERASE_4K);
+         }
+     then fill a UTIL_NOR_FTL_Init_t structure with the partition and the RAM
+     tables (4 bytes per logical page, 8 bytes per block) and call:
+         UTIL_NOR_FTL_Init()
+         UTIL_NOR_FTL_Mount(), or UTIL_NOR_FTL_Format() for a new partition
+         UTIL_NOR_FTL_Read() / UTIL_NOR_FTL_Write()
+
+   - Block layout: the first page of a block holds a header with the block
+     erase count, then one tag per data page with the logical page number,
+     a sequence number and the CRC of the data. A page is written before its
+     tag, so a tag with a valid CRC always describes a complete page. Mount
+     scans the tags and keeps the copy with the highest sequence number of
+     each logical page: an interrupted write, garbage collection or erase
+     leaves the previous copy in place. The tags of the pages moved by the
+     garbage collection are flagged, so that mount resumes both partially
+     written head blocks instead of leaving their free pages unused.
+
+   - Wear leveling:
+       (++) Dynamic: host writes go to the free block with the lowest erase
+            count.
+       (++) Static: when the erase count spread exceeds
+            UTIL_NOR_FTL_WL_THRESHOLD, the data of the least worn block is
+            moved so that the block returns to the free pool.
+     Data moved by the garbage collection is written in a second write head,
+     opened on the most worn free block, which keeps cold data away from the
+     host writes.
+
+   - UTIL_NOR_FTL_Background() performs one step of pending work (erase of an
+     interrupted block, garbage collection below UTIL_NOR_FTL_GC_THRESHOLD
+     free blocks, static wear leveling) and returns UTIL_NOR_FTL_IDLE when
+     there is none. It is meant to be called from an idle loop or a low
+     priority task, writes collect on their own only when the last free
+     block is reached. The last free block is reserved for the garbage
+     collection: host writes never open it, so that a collection interrupted
+     by a power loss can always be completed after the next mount.
+
+   - UTIL_NOR_FTL_GetStats() reports host and flash writes (their ratio is
+     the write amplification), erases and the erase count spread.
+------------------------------------------------------------------------------*/
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_nor_ftl.h"
+#include <string.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @defgroup STM32_NOR_FTL STM32 NOR Flash Translation Layer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_Defines STM32 NOR Flash Translation Layer Utility Private Defines
+  * @{
+  */
+#define FTL_MAGIC             0x4C54464EU  /* "NFTL" */
+#define FTL_HEADER_SIZE       16U          /* Magic, erase count, geometry, CRC          */
+#define FTL_TAG_SIZE          16U          /* Logical page, sequence, data CRC, tag CRC  */
+#define FTL_GEOMETRY          (UTIL_NOR_FTL_PAGE_SIZE | (UTIL_NOR_FTL_PAGES_PER_BLOCK << 16))
+#define FTL_NONE              0xFFFFFFFFU  /* No physical page, block or erase count     */
+#define FTL_TAG_GC            0x80000000U  /* Logical page flag of the moved pages       */
+#define FTL_GC_RESERVE        1U           /* Free blocks only the collection may open   */
+
+/* Write heads */
+#define FTL_HEAD_HOST         0U
+#define FTL_HEAD_GC           1U
+#define FTL_HEAD_NBR          2U
+
+/* Block states */
+#define FTL_BLOCK_FREE        0U
+#define FTL_BLOCK_HEAD        1U
+#define FTL_BLOCK_USED        2U
+#define FTL_BLOCK_DIRTY       3U
+
+/* Block flags */
+#define FTL_FLAG_UNCHECKED    0x01U  /* Free since mount, blank state not verified */
+
+#if (((UTIL_NOR_FTL_PAGES_PER_BLOCK * FTL_TAG_SIZE) + FTL_HEADER_SIZE) > UTIL_NOR_FTL_PAGE_SIZE)
+  #error "UTIL_NOR_FTL_PAGE_SIZE too small for the tags of a block"
+#endif
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_Macros STM32 NOR Flash Translation Layer Utility Private Macros
+  * @{
+  */
+#define FTL_BLOCK_ADDRESS(Block)      (FtlCtx.Address + ((Block) * UTIL_NOR_FTL_BLOCK_SIZE))
+#define FTL_PAGE_ADDRESS(Page)        (FTL_BLOCK_ADDRESS((Page) / UTIL_NOR_FTL_PAGES_PER_BLOCK) + \
+                                       ((((Page) % UTIL_NOR_FTL_PAGES_PER_BLOCK) + 1U) * UTIL_NOR_FTL_PAGE_SIZE))
+#define FTL_TAG_ADDRESS(Page)         (FTL_BLOCK_ADDRESS((Page) / UTIL_NOR_FTL_PAGES_PER_BLOCK) + FTL_HEADER_SIZE + \
+                                       (((Page) % UTIL_NOR_FTL_PAGES_PER_BLOCK) * FTL_TAG_SIZE))
+#define FTL_TAG_PAGE(pTag)            ((pTag)[0] & ~FTL_TAG_GC)
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_Types STM32 NOR Flash Translation Layer Utility Private Types
+  * @{
+  */
+typedef struct
+{
+  const UTIL_NOR_FTL_Flash_t *pFlash;
+  uint32_t                    Instance;
+  uint32_t                    Address;
+  uint32_t                    BlockCount;
+  uint32_t                    LogicalPages;
+  uint32_t                   *pMap;
+  UTIL_NOR_FTL_Block_t       *pBlocks;
+  uint32_t                    Mounted;
+  uint32_t                    Sequence;          /* Sequence number of the next page written */
+  uint32_t                    FreeCount;
+  uint32_t                    Head[FTL_HEAD_NBR];
+  uint32_t                    NextPage[FTL_HEAD_NBR];
+  UTIL_NOR_FTL_Stats_t        Stats;
+} FTL_Ctx_t;
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_FunctionPrototypes STM32 NOR Flash Translation Layer Utility Private FunctionPrototypes
+  * @{
+  */
+static uint32_t FTL_Crc(uint32_t Crc, const uint8_t *pData, uint32_t Size);
+static uint32_t FTL_IsErased(const uint8_t *pData, uint32_t Size);
+static uint32_t FTL_IsHeader(const uint32_t *pHeader);
+static uint32_t FTL_IsTag(const uint32_t *pTag);
+static void     FTL_SetState(uint32_t Block, uint32_t State);
+static int32_t  FTL_WriteHeader(uint32_t Block);
+static int32_t  FTL_EraseBlock(uint32_t Block);
+static int32_t  FTL_PrepareBlock(uint32_t Block);
+static int32_t  FTL_OpenHead(uint32_t Head);
+static int32_t  FTL_ResumeHead(uint32_t Head, uint32_t Block);
+static int32_t  FTL_Program(uint32_t Head, uint32_t LogicalPage, const uint8_t *pData, uint32_t DataCrc);
+static int32_t  FTL_MapPage(uint32_t LogicalPage, uint32_t Page, uint32_t Sequence);
+static int32_t  FTL_Relocate(uint32_t Block);
+static uint32_t FTL_SelectVictim(void);
+static int32_t  FTL_Collect(void);
+static void     FTL_GetWear(uint32_t *pMin, uint32_t *pMax);
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_Variables STM32 NOR Flash Translation Layer Utility Private Variables
+  * @{
+  */
+static FTL_Ctx_t    FtlCtx;
+
+/* Tag page of the block being scanned or collected */
+static uint32_t     FtlTags[UTIL_NOR_FTL_PAGE_SIZE / 4U];
+
+/* Data page being moved, or checked blank */
+static uint32_t     FtlPage[UTIL_NOR_FTL_PAGE_SIZE / 4U];
+
+/* CRC-32 (IEEE 802.3), one nibble at a time */
+static const uint32_t FtlCrcTable[16] =
+{
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Exported_Functions STM32 NOR Flash Translation Layer Utility Exported Functions
+  * @{
+  */
+/**
+  * @brief  Initialize the flash translation layer. UTIL_NOR_FTL_Mount() or
+  *         UTIL_NOR_FTL_Format() must be called before any page access.
+  * @param  pInit Flash translation layer configuration
+  * @retval UTIL_NOR_FTL status
+  */
+int32_t UTIL_NOR_FTL_Init(const UTIL_NOR_FTL_Init_t *pInit)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+
+  if ((pInit == NULL) || (pInit->pFlash == NULL) || (pInit->pMap == NULL) || (pInit->pBlocks == NULL) ||
+      ((pInit->Address % UTIL_NOR_FTL_BLOCK_SIZE) != 0U) || (pInit->BlockCount <= UTIL_NOR_FTL_SPARE_BLOCKS) ||
+      (pInit->LogicalPages == 0U) || (pInit->LogicalPages > UTIL_NOR_FTL_CAPACITY(pInit->BlockCount)))
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    FtlCtx.pFlash       = pInit->pFlash;
+    FtlCtx.Instance     = pInit->Instance;
+    FtlCtx.Address      = pInit->Address;
+    FtlCtx.BlockCount   = pInit->BlockCount;
+    FtlCtx.LogicalPages = pInit->LogicalPages;
+    FtlCtx.pMap         = pInit->pMap;
+    FtlCtx.pBlocks      = pInit->pBlocks;
+    FtlCtx.Mounted      = 0U;
+    UTIL_NOR_FTL_ResetStats();
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Erase the partition. Erase counts found in valid block headers
+  *         are kept.
+  * @retval UTIL_NOR_FTL status
+  */
+int32_t UTIL_NOR_FTL_Format(void)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t block;
+  uint32_t page;
+
+  if (FtlCtx.pFlash == NULL)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    FtlCtx.Mounted   = 0U;
+    FtlCtx.FreeCount = 0U;
+    for (block = 0U; (block < FtlCtx.BlockCount) && (ret == UTIL_NOR_FTL_OK); block++)
+    {
+      FtlCtx.pBlocks[block].State      = (uint8_t)FTL_BLOCK_DIRTY;
+      FtlCtx.pBlocks[block].Flags      = 0U;
+      FtlCtx.pBlocks[block].ValidPages = 0U;
+      FtlCtx.pBlocks[block].EraseCount = 0U;
+      if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlTags, FTL_BLOCK_ADDRESS(block), FTL_HEADER_SIZE) != 0)
+      {
+        ret = UTIL_NOR_FTL_ERROR;
+      }
+      else
+      {
+        if (FTL_IsHeader(FtlTags) != 0U)
+        {
+          FtlCtx.pBlocks[block].EraseCount = FtlTags[1];
+        }
+        ret = FTL_EraseBlock(block);
+      }
+    }
+
+    for (page = 0U; page < FtlCtx.LogicalPages; page++)
+    {
+      FtlCtx.pMap[page] = FTL_NONE;
+    }
+    FtlCtx.Sequence                  = 1U;
+    FtlCtx.Head[FTL_HEAD_HOST]       = FTL_NONE;
+    FtlCtx.Head[FTL_HEAD_GC]         = FTL_NONE;
+    FtlCtx.Mounted                   = (ret == UTIL_NOR_FTL_OK) ? 1U : 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Rebuild the page map and the block states from the flash content.
+  *         The last partially written block of each write head is resumed.
+  * @retval UTIL_NOR_FTL status
+  */
+int32_t UTIL_NOR_FTL_Mount(void)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t block;
+  uint32_t slot;
+  uint32_t used;
+  uint32_t head;
+  uint32_t newest;
+  uint32_t sum = 0U;
+  uint32_t known = 0U;
+  uint32_t last = 0U;
+  uint32_t partial[FTL_HEAD_NBR] = {FTL_NONE, FTL_NONE};
+  uint32_t sequence[FTL_HEAD_NBR] = {0U, 0U};
+  const uint32_t *tag;
+
+  if (FtlCtx.pFlash == NULL)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    FtlCtx.Mounted   = 0U;
+    FtlCtx.FreeCount = 0U;
+    for (slot = 0U; slot < FtlCtx.LogicalPages; slot++)
+    {
+      FtlCtx.pMap[slot] = FTL_NONE;
+    }
+    for (block = 0U; block < FtlCtx.BlockCount; block++)
+    {
+      FtlCtx.pBlocks[block].ValidPages = 0U;
+    }
+
+    for (block = 0U; (block < FtlCtx.BlockCount) && (ret == UTIL_NOR_FTL_OK); block++)
+    {
+      FtlCtx.pBlocks[block].Flags = 0U;
+      if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlTags, FTL_BLOCK_ADDRESS(block), UTIL_NOR_FTL_PAGE_SIZE) != 0)
+      {
+        ret = UTIL_NOR_FTL_ERROR;
+      }
+      else if (FTL_IsHeader(FtlTags) == 0U)
+      {
+        /* Interrupted erase: blank blocks get their header when first used */
+        FtlCtx.pBlocks[block].EraseCount = FTL_NONE;
+        if (FTL_IsErased((const uint8_t *)FtlTags, UTIL_NOR_FTL_PAGE_SIZE) != 0U)
+        {
+          FtlCtx.pBlocks[block].State = (uint8_t)FTL_BLOCK_FREE;
+          FtlCtx.pBlocks[block].Flags = (uint8_t)FTL_FLAG_UNCHECKED;
+          FtlCtx.FreeCount++;
+        }
+        else
+        {
+          FtlCtx.pBlocks[block].State = (uint8_t)FTL_BLOCK_DIRTY;
+        }
+      }
+      else
+      {
+        FtlCtx.pBlocks[block].EraseCount = FtlTags[1];
+        sum += FtlTags[1];
+        known++;
+
+        used   = 0U;
+        head   = FTL_NONE;
+        newest = 0U;
+        for (slot = 0U; (slot < UTIL_NOR_FTL_PAGES_PER_BLOCK) && (ret == UTIL_NOR_FTL_OK); slot++)
+        {
+          tag = &FtlTags[(FTL_HEADER_SIZE + (slot * FTL_TAG_SIZE)) / 4U];
+          if (FTL_IsErased((const uint8_t *)tag, FTL_TAG_SIZE) == 0U)
+          {
+            /* Torn tags still take their slot */
+            used = slot + 1U;
+            if ((FTL_IsTag(tag) != 0U) && (FTL_TAG_PAGE(tag) < FtlCtx.LogicalPages))
+            {
+              head   = ((tag[0] & FTL_TAG_GC) != 0U) ? FTL_HEAD_GC : FTL_HEAD_HOST;
+              newest = tag[1];
+              last   = (tag[1] > last) ? tag[1] : last;
+              ret = FTL_MapPage(FTL_TAG_PAGE(tag), (block * UTIL_NOR_FTL_PAGES_PER_BLOCK) + slot, tag[1]);
+            }
+          }
+        }
+
+        if (used != 0U)
+        {
+          FtlCtx.pBlocks[block].State = (uint8_t)FTL_BLOCK_USED;
+          if ((head != FTL_NONE) && (used < UTIL_NOR_FTL_PAGES_PER_BLOCK) && (newest >= sequence[head]))
+          {
+            partial[head]  = block;
+            sequence[head] = newest;
+          }
+        }
+        else
+        {
+          FtlCtx.pBlocks[block].State = (uint8_t)FTL_BLOCK_FREE;
+          FtlCtx.pBlocks[block].Flags = (uint8_t)FTL_FLAG_UNCHECKED;
+          FtlCtx.FreeCount++;
+        }
+      }
+    }
+
+    /* Blocks without header are given the mean erase count */
+    for (block = 0U; block < FtlCtx.BlockCount; block++)
+    {
+      if (FtlCtx.pBlocks[block].EraseCount == FTL_NONE)
+      {
+        FtlCtx.pBlocks[block].EraseCount = (known != 0U) ? (sum / known) : 0U;
+      }
+    }
+
+    FtlCtx.Sequence            = last + 1U;
+    FtlCtx.Head[FTL_HEAD_HOST] = FTL_NONE;
+    FtlCtx.Head[FTL_HEAD_GC]   = FTL_NONE;
+    for (head = 0U; (head < FTL_HEAD_NBR) && (ret == UTIL_NOR_FTL_OK); head++)
+    {
+      if (partial[head] != FTL_NONE)
+      {
+        ret = FTL_ResumeHead(head, partial[head]);
+      }
+    }
+    FtlCtx.Mounted = (ret == UTIL_NOR_FTL_OK) ? 1U : 0U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read a logical page. A page never written reads as erased.
+  * @param  LogicalPage Logical page number
+  * @param  pData       UTIL_NOR_FTL_PAGE_SIZE bytes buffer
+  * @retval UTIL_NOR_FTL status, UTIL_NOR_FTL_ERROR on a CRC mismatch
+  */
+int32_t UTIL_NOR_FTL_Read(uint32_t LogicalPage, uint8_t *pData)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t page;
+  uint32_t tag[FTL_TAG_SIZE / 4U];
+
+  if ((FtlCtx.Mounted == 0U) || (LogicalPage >= FtlCtx.LogicalPages) || (pData == NULL))
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    page = FtlCtx.pMap[LogicalPage];
+    if (page == FTL_NONE)
+    {
+      (void)memset(pData, 0xFF, UTIL_NOR_FTL_PAGE_SIZE);
+    }
+    else if ((FtlCtx.pFlash->Read(FtlCtx.Instance, pData, FTL_PAGE_ADDRESS(page), UTIL_NOR_FTL_PAGE_SIZE) != 0) ||
+             (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)tag, FTL_TAG_ADDRESS(page), FTL_TAG_SIZE) != 0) ||
+             (FTL_Crc(0U, pData, UTIL_NOR_FTL_PAGE_SIZE) != tag[2]))
+    {
+      ret = UTIL_NOR_FTL_ERROR;
+    }
+    else
+    {
+      /* Data and tag match */
+    }
+    FtlCtx.Stats.HostReads++;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Write a logical page. Garbage is collected first when the last
+  *         free block is reached.
+  * @param  LogicalPage Logical page number
+  * @param  pData       UTIL_NOR_FTL_PAGE_SIZE bytes
+  * @retval UTIL_NOR_FTL status
+  */
+int32_t UTIL_NOR_FTL_Write(uint32_t LogicalPage, const uint8_t *pData)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t retry = 0U;
+
+  if ((FtlCtx.Mounted == 0U) || (LogicalPage >= FtlCtx.LogicalPages) || (pData == NULL))
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    /* The last free block is kept for the garbage collection */
+    if ((FtlCtx.Head[FTL_HEAD_HOST] == FTL_NONE) || (FtlCtx.NextPage[FTL_HEAD_HOST] == UTIL_NOR_FTL_PAGES_PER_BLOCK))
+    {
+      while ((FtlCtx.FreeCount <= FTL_GC_RESERVE) && (ret == UTIL_NOR_FTL_OK))
+      {
+        ret = (retry < (FtlCtx.BlockCount * UTIL_NOR_FTL_PAGES_PER_BLOCK)) ? FTL_Collect() : UTIL_NOR_FTL_ERROR;
+        retry++;
+      }
+    }
+
+    if (ret == UTIL_NOR_FTL_OK)
+    {
+      ret = FTL_Program(FTL_HEAD_HOST, LogicalPage, pData, FTL_Crc(0U, pData, UTIL_NOR_FTL_PAGE_SIZE));
+      FtlCtx.Stats.HostWrites++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Perform one step of background work: erase of a block left dirty
+  *         at mount, garbage collection or static wear leveling.
+  * @retval UTIL_NOR_FTL_OK when a step was done, UTIL_NOR_FTL_IDLE when there
+  *         was nothing to do, UTIL_NOR_FTL_ERROR
+  */
+int32_t UTIL_NOR_FTL_Background(void)
+{
+  int32_t ret = UTIL_NOR_FTL_IDLE;
+  uint32_t block;
+  uint32_t cold = FTL_NONE;
+  uint32_t min;
+  uint32_t max;
+
+  if (FtlCtx.Mounted == 0U)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    for (block = 0U; (block < FtlCtx.BlockCount) && (ret == UTIL_NOR_FTL_IDLE); block++)
+    {
+      if (FtlCtx.pBlocks[block].State == FTL_BLOCK_DIRTY)
+      {
+        ret = FTL_EraseBlock(block);
+      }
+    }
+
+    if ((ret == UTIL_NOR_FTL_IDLE) && (FtlCtx.FreeCount < UTIL_NOR_FTL_GC_THRESHOLD) && (FTL_SelectVictim() != FTL_NONE))
+    {
+      ret = FTL_Collect();
+    }
+
+    /* Static wear leveling: move the data of the least worn used block */
+    if ((ret == UTIL_NOR_FTL_IDLE) && (FtlCtx.FreeCount > FTL_GC_RESERVE))
+    {
+      FTL_GetWear(&min, &max);
+      for (block = 0U; block < FtlCtx.BlockCount; block++)
+      {
+        if ((FtlCtx.pBlocks[block].State == FTL_BLOCK_USED) &&
+            ((cold == FTL_NONE) || (FtlCtx.pBlocks[block].EraseCount < FtlCtx.pBlocks[cold].EraseCount)))
+        {
+          cold = block;
+        }
+      }
+      if ((cold != FTL_NONE) && ((max - FtlCtx.pBlocks[cold].EraseCount) > UTIL_NOR_FTL_WL_THRESHOLD))
+      {
+        ret = FTL_Relocate(cold);
+        FtlCtx.Stats.WlRuns++;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the statistics.
+  * @param  pStats Statistics
+  */
+void UTIL_NOR_FTL_GetStats(UTIL_NOR_FTL_Stats_t *pStats)
+{
+  if (pStats != NULL)
+  {
+    FtlCtx.Stats.FreeBlocks = FtlCtx.FreeCount;
+    FTL_GetWear(&FtlCtx.Stats.MinEraseCount, &FtlCtx.Stats.MaxEraseCount);
+    *pStats = FtlCtx.Stats;
+  }
+}
+
+/**
+  * @brief  Reset the statistics counters.
+  */
+void UTIL_NOR_FTL_ResetStats(void)
+{
+  (void)memset(&FtlCtx.Stats, 0, sizeof(FtlCtx.Stats));
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Private_Functions STM32 NOR Flash Translation Layer Utility Private Functions
+  * @{
+  */
+/**
+  * @brief  Update a CRC-32.
+  * @param  Crc   CRC of the previous bytes, 0 for the first ones
+  * @param  pData Bytes
+  * @param  Size  Number of bytes
+  * @retval CRC
+  */
+static uint32_t FTL_Crc(uint32_t Crc, const uint8_t *pData, uint32_t Size)
+{
+  uint32_t crc = ~Crc;
+  uint32_t i;
+
+  for (i = 0U; i < Size; i++)
+  {
+    crc ^= pData[i];
+    crc = (crc >> 4) ^ FtlCrcTable[crc & 0x0FU];
+    crc = (crc >> 4) ^ FtlCrcTable[crc & 0x0FU];
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  Check that bytes are erased.
+  * @param  pData Bytes
+  * @param  Size  Number of bytes
+  * @retval 1 when all bytes are 0xFF
+  */
+static uint32_t FTL_IsErased(const uint8_t *pData, uint32_t Size)
+{
+  uint32_t i = 0U;
+
+  while ((i < Size) && (pData[i] == 0xFFU))
+  {
+    i++;
+  }
+
+  return (i == Size) ? 1U : 0U;
+}
+
+/**
+  * @brief  Check a block header.
+  * @param  pHeader Header words
+  * @retval 1 when the header is valid
+  */
+static uint32_t FTL_IsHeader(const uint32_t *pHeader)
+{
+  return ((pHeader[0] == FTL_MAGIC) && (pHeader[2] == FTL_GEOMETRY) &&
+          (pHeader[3] == FTL_Crc(0U, (const uint8_t *)pHeader, FTL_HEADER_SIZE - 4U))) ? 1U : 0U;
+}
+
+/**
+  * @brief  Check a page tag.
+  * @param  pTag Tag words
+  * @retval 1 when the tag was completely written
+  */
+static uint32_t FTL_IsTag(const uint32_t *pTag)
+{
+  return (pTag[3] == FTL_Crc(0U, (const uint8_t *)pTag, FTL_TAG_SIZE - 4U)) ? 1U : 0U;
+}
+
+/**
+  * @brief  Change the state of a block, keeping the free block count.
+  * @param  Block Block index
+  * @param  State New state
+  */
+static void FTL_SetState(uint32_t Block, uint32_t State)
+{
+  if (FtlCtx.pBlocks[Block].State == FTL_BLOCK_FREE)
+  {
+    FtlCtx.FreeCount--;
+  }
+  if (State == FTL_BLOCK_FREE)
+  {
+    FtlCtx.FreeCount++;
+  }
+  FtlCtx.pBlocks[Block].State = (uint8_t)State;
+}
+
+/**
+  * @brief  Write the header of an erased block.
+  * @param  Block Block index
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_WriteHeader(uint32_t Block)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t header[FTL_HEADER_SIZE / 4U];
+
+  header[0] = FTL_MAGIC;
+  header[1] = FtlCtx.pBlocks[Block].EraseCount;
+  header[2] = FTL_GEOMETRY;
+  header[3] = FTL_Crc(0U, (const uint8_t *)header, FTL_HEADER_SIZE - 4U);
+
+  if (FtlCtx.pFlash->Write(FtlCtx.Instance, (uint8_t *)header, FTL_BLOCK_ADDRESS(Block), FTL_HEADER_SIZE) != 0)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Erase a block and write its header. The block becomes free.
+  * @param  Block Block index
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_EraseBlock(uint32_t Block)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+
+  FTL_SetState(Block, FTL_BLOCK_DIRTY);
+  if (FtlCtx.pFlash->Erase(FtlCtx.Instance, FTL_BLOCK_ADDRESS(Block)) != 0)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    FtlCtx.pBlocks[Block].EraseCount++;
+    FtlCtx.Stats.Erases++;
+    ret = FTL_WriteHeader(Block);
+    if (ret == UTIL_NOR_FTL_OK)
+    {
+      FtlCtx.pBlocks[Block].ValidPages = 0U;
+      FtlCtx.pBlocks[Block].Flags      = 0U;
+      FTL_SetState(Block, FTL_BLOCK_FREE);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Verify that a block found free at mount is blank. It is erased
+  *         again if an interrupted operation left data in it.
+  * @param  Block Block index
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_PrepareBlock(uint32_t Block)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t page;
+  uint32_t header;
+  uint32_t blank;
+
+  if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlPage, FTL_BLOCK_ADDRESS(Block), UTIL_NOR_FTL_PAGE_SIZE) != 0)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    header = FTL_IsHeader(FtlPage);
+    blank  = FTL_IsErased(&((const uint8_t *)FtlPage)[FTL_HEADER_SIZE], UTIL_NOR_FTL_PAGE_SIZE - FTL_HEADER_SIZE);
+    if ((header == 0U) && (FTL_IsErased((const uint8_t *)FtlPage, FTL_HEADER_SIZE) == 0U))
+    {
+      blank = 0U;
+    }
+    for (page = 1U; (page <= UTIL_NOR_FTL_PAGES_PER_BLOCK) && (blank != 0U) && (ret == UTIL_NOR_FTL_OK); page++)
+    {
+      if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlPage, FTL_BLOCK_ADDRESS(Block) + (page * UTIL_NOR_FTL_PAGE_SIZE),
+                              UTIL_NOR_FTL_PAGE_SIZE) != 0)
+      {
+        ret = UTIL_NOR_FTL_ERROR;
+      }
+      else
+      {
+        blank = FTL_IsErased((const uint8_t *)FtlPage, UTIL_NOR_FTL_PAGE_SIZE);
+      }
+    }
+
+    if (ret == UTIL_NOR_FTL_OK)
+    {
+      if (blank == 0U)
+      {
+        ret = FTL_EraseBlock(Block);
+      }
+      else if (header == 0U)
+      {
+        ret = FTL_WriteHeader(Block);
+      }
+      else
+      {
+        /* Blank block with its header */
+      }
+    }
+    if (ret == UTIL_NOR_FTL_OK)
+    {
+      FtlCtx.pBlocks[Block].Flags = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Open a free block on a write head: the least worn one for the host
+  *         writes, the most worn one for the data moved by the collection.
+  *         The host head is not given the last FTL_GC_RESERVE free blocks.
+  * @param  Head Write head
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_OpenHead(uint32_t Head)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t block;
+  uint32_t best = FTL_NONE;
+  uint32_t count;
+
+  for (block = 0U; block < FtlCtx.BlockCount; block++)
+  {
+    if (FtlCtx.pBlocks[block].State == FTL_BLOCK_FREE)
+    {
+      count = FtlCtx.pBlocks[block].EraseCount;
+      if ((best == FTL_NONE) ||
+          ((Head == FTL_HEAD_HOST) && (count < FtlCtx.pBlocks[best].EraseCount)) ||
+          ((Head == FTL_HEAD_GC) && (count > FtlCtx.pBlocks[best].EraseCount)))
+      {
+        best = block;
+      }
+    }
+  }
+
+  if ((best == FTL_NONE) || ((Head == FTL_HEAD_HOST) && (FtlCtx.FreeCount <= FTL_GC_RESERVE)))
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    if ((FtlCtx.pBlocks[best].Flags & FTL_FLAG_UNCHECKED) != 0U)
+    {
+      ret = FTL_PrepareBlock(best);
+    }
+    if (ret == UTIL_NOR_FTL_OK)
+    {
+      if (FtlCtx.Head[Head] != FTL_NONE)
+      {
+        FTL_SetState(FtlCtx.Head[Head], FTL_BLOCK_USED);
+      }
+      FTL_SetState(best, FTL_BLOCK_HEAD);
+      FtlCtx.Head[Head]     = best;
+      FtlCtx.NextPage[Head] = 0U;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Resume a write head on a block partially written before mount,
+  *         after its last used tag and any page programmed without its tag.
+  *         The block stays used if it has no erased page left.
+  * @param  Head  Write head
+  * @param  Block Block index
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_ResumeHead(uint32_t Head, uint32_t Block)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t slot;
+  uint32_t next = 0U;
+  uint32_t blank = 0U;
+
+  if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlTags, FTL_BLOCK_ADDRESS(Block), UTIL_NOR_FTL_PAGE_SIZE) != 0)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else
+  {
+    for (slot = 0U; slot < UTIL_NOR_FTL_PAGES_PER_BLOCK; slot++)
+    {
+      if (FTL_IsErased((const uint8_t *)&FtlTags[(FTL_HEADER_SIZE + (slot * FTL_TAG_SIZE)) / 4U], FTL_TAG_SIZE) == 0U)
+      {
+        next = slot + 1U;
+      }
+    }
+  }
+
+  /* An interrupted write may have programmed the data page but not its tag */
+  while ((next < UTIL_NOR_FTL_PAGES_PER_BLOCK) && (blank == 0U) && (ret == UTIL_NOR_FTL_OK))
+  {
+    if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlPage, FTL_PAGE_ADDRESS((Block * UTIL_NOR_FTL_PAGES_PER_BLOCK) + next),
+                            UTIL_NOR_FTL_PAGE_SIZE) != 0)
+    {
+      ret = UTIL_NOR_FTL_ERROR;
+    }
+    else
+    {
+      blank = FTL_IsErased((const uint8_t *)FtlPage, UTIL_NOR_FTL_PAGE_SIZE);
+      next += (blank != 0U) ? 0U : 1U;
+    }
+  }
+
+  if ((ret == UTIL_NOR_FTL_OK) && (blank != 0U))
+  {
+    FTL_SetState(Block, FTL_BLOCK_HEAD);
+    FtlCtx.Head[Head]     = Block;
+    FtlCtx.NextPage[Head] = next;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Program a page on a write head and map it: data first, then the
+  *         tag committing it.
+  * @param  Head        Write head
+  * @param  LogicalPage Logical page number
+  * @param  pData       UTIL_NOR_FTL_PAGE_SIZE bytes
+  * @param  DataCrc     CRC of the data
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_Program(uint32_t Head, uint32_t LogicalPage, const uint8_t *pData, uint32_t DataCrc)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t page;
+  uint32_t old;
+  uint32_t tag[FTL_TAG_SIZE / 4U];
+
+  if ((FtlCtx.Head[Head] == FTL_NONE) || (FtlCtx.NextPage[Head] == UTIL_NOR_FTL_PAGES_PER_BLOCK))
+  {
+    ret = FTL_OpenHead(Head);
+  }
+
+  if (ret == UTIL_NOR_FTL_OK)
+  {
+    page = (FtlCtx.Head[Head] * UTIL_NOR_FTL_PAGES_PER_BLOCK) + FtlCtx.NextPage[Head];
+    FtlCtx.NextPage[Head]++;
+
+    tag[0] = (Head == FTL_HEAD_GC) ? (LogicalPage | FTL_TAG_GC) : LogicalPage;
+    tag[1] = FtlCtx.Sequence;
+    tag[2] = DataCrc;
+    tag[3] = FTL_Crc(0U, (const uint8_t *)tag, FTL_TAG_SIZE - 4U);
+    FtlCtx.Sequence++;
+
+    if ((FtlCtx.pFlash->Write(FtlCtx.Instance, (uint8_t *)pData, FTL_PAGE_ADDRESS(page), UTIL_NOR_FTL_PAGE_SIZE) != 0) ||
+        (FtlCtx.pFlash->Write(FtlCtx.Instance, (uint8_t *)tag, FTL_TAG_ADDRESS(page), FTL_TAG_SIZE) != 0))
+    {
+      ret = UTIL_NOR_FTL_ERROR;
+    }
+    else
+    {
+      old = FtlCtx.pMap[LogicalPage];
+      if (old != FTL_NONE)
+      {
+        FtlCtx.pBlocks[old / UTIL_NOR_FTL_PAGES_PER_BLOCK].ValidPages--;
+      }
+      FtlCtx.pMap[LogicalPage] = page;
+      FtlCtx.pBlocks[FtlCtx.Head[Head]].ValidPages++;
+      FtlCtx.Stats.FlashWrites++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Map a page found at mount, unless a newer copy is already mapped.
+  * @param  LogicalPage Logical page number
+  * @param  Page        Physical page
+  * @param  Sequence    Sequence number of the physical page
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_MapPage(uint32_t LogicalPage, uint32_t Page, uint32_t Sequence)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t old = FtlCtx.pMap[LogicalPage];
+  uint32_t tag[FTL_TAG_SIZE / 4U];
+
+  if (old == FTL_NONE)
+  {
+    FtlCtx.pMap[LogicalPage] = Page;
+    FtlCtx.pBlocks[Page / UTIL_NOR_FTL_PAGES_PER_BLOCK].ValidPages++;
+  }
+  else if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)tag, FTL_TAG_ADDRESS(old), FTL_TAG_SIZE) != 0)
+  {
+    ret = UTIL_NOR_FTL_ERROR;
+  }
+  else if (Sequence > tag[1])
+  {
+    FtlCtx.pBlocks[old / UTIL_NOR_FTL_PAGES_PER_BLOCK].ValidPages--;
+    FtlCtx.pMap[LogicalPage] = Page;
+    FtlCtx.pBlocks[Page / UTIL_NOR_FTL_PAGES_PER_BLOCK].ValidPages++;
+  }
+  else
+  {
+    /* Older copy */
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Move the valid pages of a block to the collection write head, then
+  *         erase it.
+  * @param  Block Block index
+  * @retval UTIL_NOR_FTL status
+  */
+static int32_t FTL_Relocate(uint32_t Block)
+{
+  int32_t ret = UTIL_NOR_FTL_OK;
+  uint32_t slot;
+  uint32_t page;
+  const uint32_t *tag;
+
+  if (FtlCtx.pBlocks[Block].ValidPages != 0U)
+  {
+    if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlTags, FTL_BLOCK_ADDRESS(Block), UTIL_NOR_FTL_PAGE_SIZE) != 0)
+    {
+      ret = UTIL_NOR_FTL_ERROR;
+    }
+
+    for (slot = 0U; (slot < UTIL_NOR_FTL_PAGES_PER_BLOCK) && (ret == UTIL_NOR_FTL_OK); slot++)
+    {
+      tag  = &FtlTags[(FTL_HEADER_SIZE + (slot * FTL_TAG_SIZE)) / 4U];
+      page = (Block * UTIL_NOR_FTL_PAGES_PER_BLOCK) + slot;
+      if ((FTL_IsTag(tag) != 0U) && (FTL_TAG_PAGE(tag) < FtlCtx.LogicalPages) && (FtlCtx.pMap[FTL_TAG_PAGE(tag)] == page))
+      {
+        /* Open the head first: checking a block blank uses the page buffer */
+        if ((FtlCtx.Head[FTL_HEAD_GC] == FTL_NONE) || (FtlCtx.NextPage[FTL_HEAD_GC] == UTIL_NOR_FTL_PAGES_PER_BLOCK))
+        {
+          ret = FTL_OpenHead(FTL_HEAD_GC);
+        }
+        if (ret == UTIL_NOR_FTL_OK)
+        {
+          if (FtlCtx.pFlash->Read(FtlCtx.Instance, (uint8_t *)FtlPage, FTL_PAGE_ADDRESS(page), UTIL_NOR_FTL_PAGE_SIZE) != 0)
+          {
+            ret = UTIL_NOR_FTL_ERROR;
+          }
+          else
+          {
+            ret = FTL_Program(FTL_HEAD_GC, FTL_TAG_PAGE(tag), (const uint8_t *)FtlPage, tag[2]);
+          }
+        }
+      }
+    }
+  }
+
+  if (ret == UTIL_NOR_FTL_OK)
+  {
+    ret = FTL_EraseBlock(Block);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Select the used block with the fewest valid pages. A block without
+  *         valid page is erased without the collection head, which may have
+  *         no free block left to open after a power loss.
+  * @retval Block index, FTL_NONE when no block has invalid pages
+  */
+static uint32_t FTL_SelectVictim(void)
+{
+  uint32_t block;
+  uint32_t victim = FTL_NONE;
+  uint32_t valid = UTIL_NOR_FTL_PAGES_PER_BLOCK;
+
+  for (block = 0U; (block < FtlCtx.BlockCount) && (valid != 0U); block++)
+  {
+    if ((FtlCtx.pBlocks[block].State == FTL_BLOCK_USED) && (FtlCtx.pBlocks[block].ValidPages < valid))
+    {
+      valid  = FtlCtx.pBlocks[block].ValidPages;
+      victim = block;
+    }
+  }
+
+  return victim;
+}
+
+/**
+  * @brief  Reclaim one block: a dirty one if any, else the used block with the
+  *         fewest valid pages.
+  * @retval UTIL_NOR_FTL status, UTIL_NOR_FTL_ERROR when the partition is full
+  */
+static int32_t FTL_Collect(void)
+{
+  int32_t ret = UTIL_NOR_FTL_ERROR;
+  uint32_t block;
+
+  for (block = 0U; (block < FtlCtx.BlockCount) && (ret == UTIL_NOR_FTL_ERROR); block++)
+  {
+    if (FtlCtx.pBlocks[block].State == FTL_BLOCK_DIRTY)
+    {
+      ret = FTL_EraseBlock(block);
+    }
+  }
+
+  if (ret == UTIL_NOR_FTL_ERROR)
+  {
+    block = FTL_SelectVictim();
+    if (block != FTL_NONE)
+    {
+      ret = FTL_Relocate(block);
+      FtlCtx.Stats.GcRuns++;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Get the lowest and highest erase counts.
+  * @param  pMin Lowest erase count
+  * @param  pMax Highest erase count
+  */
+static void FTL_GetWear(uint32_t *pMin, uint32_t *pMax)
+{
+  uint32_t block;
+  uint32_t min = FTL_NONE;
+  uint32_t max = 0U;
+
+  for (block = 0U; block < FtlCtx.BlockCount; block++)
+  {
+    min = (FtlCtx.pBlocks[block].EraseCount < min) ? FtlCtx.pBlocks[block].EraseCount : min;
+    max = (FtlCtx.pBlocks[block].EraseCount > max) ? FtlCtx.pBlocks[block].EraseCount : max;
+  }
+
+  *pMin = (min == FTL_NONE) ? 0U : min;
+  *pMax = max;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,207 @@
+/**
+  ******************************************************************************
+  * @file    stm32_nor_ftl.h
+  * @author  MCD Application Team
+  * @brief   This file contains the common defines and functions prototypes for
+  *          the stm32_nor_ftl.c NOR flash translation layer.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32_NOR_FTL_H
+#define STM32_NOR_FTL_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/** @addtogroup STM32_EVAL
+  * @{
+  */
+
+/** @addtogroup Common
+  * @{
+  */
+
+/** @addtogroup STM32_NOR_FTL STM32 NOR Flash Translation Layer Utility
+  * @{
+  */
+
+/** @defgroup UTIL_NOR_FTL_Exported_Constants STM32 NOR Flash Translation Layer Utility Exported Constants
+  * @{
+  */
+#define UTIL_NOR_FTL_OK                 0
+#define UTIL_NOR_FTL_ERROR            (-1)
+#define UTIL_NOR_FTL_IDLE               1   /* UTIL_NOR_FTL_Background(): nothing to do */
+
+/**
+  * @brief  Logical page size in bytes. The first page of each block holds the
+  *         block header and the page tags, the other ones hold data.
+  */
+#ifndef UTIL_NOR_FTL_PAGE_SIZE
+  #define UTIL_NOR_FTL_PAGE_SIZE        256U
+#endif
+
+/**
+  * @brief  Erase block size in bytes, BSP_OSPI_NOR_BLOCK_4K on the MX25LM51245G
+  */
+#ifndef UTIL_NOR_FTL_BLOCK_SIZE
+  #define UTIL_NOR_FTL_BLOCK_SIZE       4096U
+#endif
+
+/**
+  * @brief  Blocks kept out of the logical capacity: the two write heads and
+  *         the free blocks needed by the garbage collection
+  */
+#ifndef UTIL_NOR_FTL_SPARE_BLOCKS
+  #define UTIL_NOR_FTL_SPARE_BLOCKS     4U
+#endif
+
+/**
+  * @brief  Free blocks below which UTIL_NOR_FTL_Background() collects garbage.
+  *         Writes collect on their own when a single free block is left.
+  */
+#ifndef UTIL_NOR_FTL_GC_THRESHOLD
+  #define UTIL_NOR_FTL_GC_THRESHOLD     3U
+#endif
+
+/**
+  * @brief  Erase count spread above which UTIL_NOR_FTL_Background() moves the
+  *         data of the least worn block (static wear leveling)
+  */
+#ifndef UTIL_NOR_FTL_WL_THRESHOLD
+  #define UTIL_NOR_FTL_WL_THRESHOLD     64U
+#endif
+
+/**
+  * @brief  Data pages per block
+  */
+#define UTIL_NOR_FTL_PAGES_PER_BLOCK    ((UTIL_NOR_FTL_BLOCK_SIZE / UTIL_NOR_FTL_PAGE_SIZE) - 1U)
+
+/**
+  * @brief  Logical pages of a partition of BlockCount blocks
+  */
+#define UTIL_NOR_FTL_CAPACITY(BlockCount) (((BlockCount) - UTIL_NOR_FTL_SPARE_BLOCKS) * UTIL_NOR_FTL_PAGES_PER_BLOCK)
+/**
+  * @}
+  */
+
+/** @defgroup UTIL_NOR_FTL_Exported_Types STM32 NOR Flash Translation Layer Utility Exported Types
+  * @{
+  */
+
+/**
+  * @brief  Flash services, with the BSP_OSPI_NOR_Read/BSP_OSPI_NOR_Write
+  *         signatures. Erase erases the UTIL_NOR_FTL_BLOCK_SIZE block at the
+  *         given address.
+  */
+typedef struct
+{
+  int32_t ( *Read            ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *Write           ) (uint32_t, uint8_t *, uint32_t, uint32_t);
+  int32_t ( *Erase           ) (uint32_t, uint32_t);
+} UTIL_NOR_FTL_Flash_t;
+
+/**
+  * @brief  Block state, managed by the utility
+  */
+typedef struct
+{
+  uint32_t EraseCount;  /*!< Erase cycles of the block                        */
+  uint16_t ValidPages;  /*!< Pages holding the current copy of a logical page  */
+  uint8_t  State;       /*!< Free, write head, used or to be erased            */
+  uint8_t  Flags;       /*!< Content to be checked before use                  */
+} UTIL_NOR_FTL_Block_t;
+
+/**
+  * @brief  Flash translation layer configuration
+  */
+typedef struct
+{
+  const UTIL_NOR_FTL_Flash_t *pFlash;       /*!< Flash services                                     */
+  uint32_t                    Instance;     /*!< Flash instance passed to the flash services        */
+  uint32_t                    Address;      /*!< Partition address, aligned on a block              */
+  uint32_t                    BlockCount;   /*!< Partition size in blocks                           */
+  uint32_t                    LogicalPages; /*!< Up to UTIL_NOR_FTL_CAPACITY(BlockCount)            */
+  uint32_t                   *pMap;         /*!< LogicalPages entries: logical to physical pages    */
+  UTIL_NOR_FTL_Block_t       *pBlocks;      /*!< BlockCount entries                                 */
+} UTIL_NOR_FTL_Init_t;
+
+/**
+  * @brief  Statistics. Write amplification is FlashWrites / HostWrites.
+  */
+typedef struct
+{
+  uint32_t HostWrites;     /*!< Pages written by UTIL_NOR_FTL_Write()               */
+  uint32_t HostReads;      /*!< Pages read by UTIL_NOR_FTL_Read()                   */
+  uint32_t FlashWrites;    /*!< Pages programmed: host writes and relocations       */
+  uint32_t Erases;         /*!< Blocks erased                                       */
+  uint32_t GcRuns;         /*!< Blocks reclaimed by the garbage collection          */
+  uint32_t WlRuns;         /*!< Blocks moved by the static wear leveling            */
+  uint32_t FreeBlocks;     /*!< Erased blocks available                             */
+  uint32_t MinEraseCount;  /*!< Erase count of the least worn block                 */
+  uint32_t MaxEraseCount;  /*!< Erase count of the most worn block                  */
+} UTIL_NOR_FTL_Stats_t;
+
+/**
+  * @}
+  */
+
+/** @addtogroup UTIL_NOR_FTL_Exported_Functions
+  * @{
+  */
+int32_t  UTIL_NOR_FTL_Init(const UTIL_NOR_FTL_Init_t *pInit);
+int32_t  UTIL_NOR_FTL_Format(void);
+int32_t  UTIL_NOR_FTL_Mount(void);
+int32_t  UTIL_NOR_FTL_Read(uint32_t LogicalPage, uint8_t *pData);
+int32_t  UTIL_NOR_FTL_Write(uint32_t LogicalPage, const uint8_t *pData);
+int32_t  UTIL_NOR_FTL_Background(void);
+void     UTIL_NOR_FTL_GetStats(UTIL_NOR_FTL_Stats_t *pStats);
+void     UTIL_NOR_FTL_ResetStats(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_NOR_FTL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/